@@ -24,6 +24,7 @@ DEFAULT_ACCELEROMETER_INTERRUPT_IGNORE_DURATION_MS = 5000
 
 DEFAULT_BATTERY_SAMPLING_PERIOD_MS = 60000
 
+DEFAULT_BULK_EXPORT_CHECKPOINT_INTERVAL = 16
 
 
 DEFAULT_MICROPHONE_STREAM_SAMPLING_PERIOD_MS = 50
@@ -46,6 +47,17 @@ DEFAULT_ACCELEROMETER_INTERRUPT_STREAM_IGNORE_DURATION_MS = 1000
 DEFAULT_BATTERY_STREAM_SAMPLING_PERIOD_MS = 5000
 
 from badge_protocol import *
+import compression
+try:
+	import badge_protocol_fast	# Optional C++ decoder of the responses (build it with: python setup.py build_ext --inplace)
+except ImportError:
+	badge_protocol_fast = None
+
+# Flag in the length header of a response, if the response is compressed
+RESPONSE_LENGTH_HEADER_COMPRESSED_FLAG = 0x8000
+# Flag in the length header of a request/response, if a request-id byte follows the length header
+LENGTH_HEADER_REQUEST_ID_FLAG = 0x4000
+LENGTH_HEADER_LEN_MASK = 0x3FFF
 
 logger = logging.getLogger(__name__)
 
@@ -54,6 +66,19 @@ logger = logging.getLogger(__name__)
 # We generally define timestamp_seconds to be in number of seconds since UTC epoch
 # and timestamp_miliseconds to be the miliseconds portion of that UTC timestamp.
 
+# Decodes a serialized response into a Response(), with badge_protocol_fast if it is built.
+def decode_response(serialized_response):
+	if badge_protocol_fast is not None:
+		return badge_protocol_fast.decode_response(serialized_response)
+	return Response.decode(serialized_response)
+
+# Decodes a list of serialized responses (e.g. all responses of a badge dump, stored by the hub) at once.
+#   Returns a list of Response().
+def decode_responses(serialized_responses):
+	if badge_protocol_fast is not None:
+		return badge_protocol_fast.decode_responses(serialized_responses)
+	return [Response.decode(serialized_response) for serialized_response in serialized_responses]
+
 # Returns the current timestamp as two parts - seconds and milliseconds
 def get_timestamps():
 	return get_timestamps_from_time(time.time())
@@ -89,7 +114,16 @@ class OpenBadge(object):
 		self.accelerometer_interrupt_data_response_queue = Queue.Queue()
 		self.battery_data_response_queue = Queue.Queue()
 		self.test_response_queue = Queue.Queue()
+		self.diagnostics_response_queue = Queue.Queue()
 		self.stream_response_queue = Queue.Queue()
+		self.bulk_export_checkpoint_response_queue = Queue.Queue()
+		self.set_compression_response_queue = Queue.Queue()
+		self.set_overflow_policy_response_queue = Queue.Queue()
+		# The cursor of the last received bulk export checkpoint (to resume an interrupted bulk export)
+		self.bulk_export_cursor = None
+		# The request-id of the next pipelined request, and the responses to the pipelined requests (by request-id)
+		self.next_request_id = 0
+		self.pipelined_responses = {}
 
 	# Helper function to send a BadgeMessage `command_message` to a device, expecting a response
 	# of class `response_type` that is a subclass of BadgeMessage, or None if no response is expected.
@@ -109,25 +143,56 @@ class OpenBadge(object):
 			return True
 	
 	
-	def send_request(self, request_message):
+	def send_request(self, request_message, request_id=None):
 		serialized_request = request_message.encode()
 		
-		# Adding length header:
-		serialized_request_len = struct.pack('>H', len(serialized_request))
+		# Adding length header (and the request-id):
+		if request_id is None:
+			serialized_request_len = struct.pack('>H', len(serialized_request))
+		else:
+			serialized_request_len = struct.pack('>HB', len(serialized_request) | LENGTH_HEADER_REQUEST_ID_FLAG, request_id)
 		serialized_request = serialized_request_len + serialized_request
 	
 		logger.debug("Sending: {}, Raw: {}".format(request_message, serialized_request.encode("hex")))
 		
 		self.connection.send(serialized_request, response_len = 0)
-		
+	
+	# Sends a request with a request-id without waiting for the response, so that several requests
+	#   could be in flight at the same time. Returns the request-id to pass to wait_for_response().
+	def send_pipelined_request(self, request_message):
+		request_id = self.next_request_id
+		self.next_request_id = (self.next_request_id + 1) % 256
+		self.pipelined_responses[request_id] = []
+		self.send_request(request_message, request_id)
+		return request_id
+	
+	# Receives responses until a response to the pipelined request with the request-id was received.
+	#   Responses to other requests are put into their queues as usual.
+	#   Returns the response (e.g. a StatusResponse()).
+	def wait_for_response(self, request_id):
+		while(len(self.pipelined_responses[request_id]) == 0):
+			self.receive_response()
+		response = self.pipelined_responses[request_id].pop(0)
+		return response
+	
+	# Stops collecting the responses of the pipelined request with the request-id.
+	def finish_pipelined_request(self, request_id):
+		self.pipelined_responses.pop(request_id, None)
 		
 	
 	def receive_response(self):
 		response_len = struct.unpack('>H', self.connection.await_data(2))[0]
+		compressed = (response_len & RESPONSE_LENGTH_HEADER_COMPRESSED_FLAG) != 0
+		request_id = None
+		if response_len & LENGTH_HEADER_REQUEST_ID_FLAG:
+			request_id = struct.unpack('>B', self.connection.await_data(1))[0]
+		response_len &= LENGTH_HEADER_LEN_MASK
 		print("Wait response len: " + str(response_len))
 		serialized_response = self.connection.await_data(response_len)
+		if compressed:
+			serialized_response = compression.decompress(serialized_response)
 		
-		response_message = Response.decode(serialized_response)
+		response_message = decode_response(serialized_response)
 		
 		queue_options = {
 			Response_status_response_tag: self.status_response_queue,
@@ -142,7 +207,11 @@ class OpenBadge(object):
 			Response_accelerometer_interrupt_data_response_tag: self.accelerometer_interrupt_data_response_queue,
 			Response_battery_data_response_tag: self.battery_data_response_queue,
 			Response_test_response_tag: self.test_response_queue,
+			Response_diagnostics_response_tag: self.diagnostics_response_queue,
 			Response_stream_response_tag: self.stream_response_queue,
+			Response_bulk_export_checkpoint_response_tag: self.bulk_export_checkpoint_response_queue,
+			Response_set_compression_response_tag: self.set_compression_response_queue,
+			Response_set_overflow_policy_response_tag: self.set_overflow_policy_response_queue,
 		}
 		response_options = {
 			Response_status_response_tag: response_message.type.status_response,
@@ -157,9 +226,16 @@ class OpenBadge(object):
 			Response_accelerometer_interrupt_data_response_tag: response_message.type.accelerometer_interrupt_data_response,
 			Response_battery_data_response_tag: response_message.type.battery_data_response,
 			Response_test_response_tag: response_message.type.test_response,
+			Response_diagnostics_response_tag: response_message.type.diagnostics_response,
 			Response_stream_response_tag: response_message.type.stream_response,
+			Response_bulk_export_checkpoint_response_tag: response_message.type.bulk_export_checkpoint_response,
+			Response_set_compression_response_tag: response_message.type.set_compression_response,
+			Response_set_overflow_policy_response_tag: response_message.type.set_overflow_policy_response,
 		}
-		queue_options[response_message.type.which].put(response_options[response_message.type.which])
+		if request_id in self.pipelined_responses:
+			self.pipelined_responses[request_id].append(response_options[response_message.type.which])
+		else:
+			queue_options[response_message.type.which].put(response_options[response_message.type.which])
 		
 		
 		
@@ -469,6 +545,67 @@ class OpenBadge(object):
 		
 		return True
 	
+	# Negotiates the compression of the responses (PROTOCOL_COMPRESSION_LZSS or PROTOCOL_COMPRESSION_NONE) for this connection.
+	#   Compressed responses are decompressed in receive_response(), so nothing else changes for the caller.
+	# Returns the compression that the badge uses from now on.
+	def set_compression(self, compression=PROTOCOL_COMPRESSION_LZSS):
+	
+		request = Request()
+		request.type.which = Request_set_compression_request_tag
+		request.type.set_compression_request = SetCompressionRequest()
+		request.type.set_compression_request.compression = compression
+		
+		with self.set_compression_response_queue.mutex:
+			self.set_compression_response_queue.queue.clear()
+		
+		self.send_request(request)
+		
+		while(self.set_compression_response_queue.empty()):
+			self.receive_response()
+			
+		return self.set_compression_response_queue.get().compression
+	
+	# Sends a diagnostics request to this Badge.
+	#   If reset is True, the badge resets its counters after responding.
+	# Returns a DiagnosticsResponse() with the dropped chunks and high-water marks of the chunk-fifos.
+	def get_diagnostics(self, reset=False):
+	
+		request = Request()
+		request.type.which = Request_diagnostics_request_tag
+		request.type.diagnostics_request = DiagnosticsRequest()
+		request.type.diagnostics_request.reset_chunk_fifo_status = 1 if reset else 0
+		
+		self.send_request(request)
+		
+		with self.diagnostics_response_queue.mutex:
+			self.diagnostics_response_queue.queue.clear()
+			
+		while(self.diagnostics_response_queue.empty()):
+			self.receive_response()
+			
+		return self.diagnostics_response_queue.get()
+	
+	# Sets what the badge does when the chunks of a data-source (PROTOCOL_DATA_SOURCE_*) could not be stored fast enough:
+	#   PROTOCOL_OVERFLOW_POLICY_DROP_NEWEST, PROTOCOL_OVERFLOW_POLICY_DROP_OLDEST or PROTOCOL_OVERFLOW_POLICY_DEGRADE_RATE.
+	# Returns the overflow policy that the data-source uses from now on (unchanged if the policy is not supported by the data-source).
+	def set_overflow_policy(self, data_source, overflow_policy):
+	
+		request = Request()
+		request.type.which = Request_set_overflow_policy_request_tag
+		request.type.set_overflow_policy_request = SetOverflowPolicyRequest()
+		request.type.set_overflow_policy_request.data_source = data_source
+		request.type.set_overflow_policy_request.overflow_policy = overflow_policy
+		
+		with self.set_overflow_policy_response_queue.mutex:
+			self.set_overflow_policy_response_queue.queue.clear()
+		
+		self.send_request(request)
+		
+		while(self.set_overflow_policy_response_queue.empty()):
+			self.receive_response()
+			
+		return self.set_overflow_policy_response_queue.get().overflow_policy
+	
 
 	# Send a request to the badge for recorded microphone data starting at the given timestamp.
 	# Returns a list of tuples of (MicrophoneDataHeader(), microphone_sample_chunk_data), where each tuple
@@ -641,6 +778,91 @@ class OpenBadge(object):
 	
 		return battery_chunks
 	
+	# Sends a bulk export request to the badge, that exports the recorded data of all sensors in one response stream.
+	#   cursor is the ExportCursor of a former bulk export (only newer data are exported), or None to export all data.
+	#   Every checkpoint_interval chunks, the badge sends a checkpoint with the current cursor. Chunks are only
+	#   returned, if a checkpoint confirmed them. So if the connection drops, the export could be resumed 
+	#   with self.bulk_export_cursor, and no chunk is lost or received twice.
+	# Returns a tuple of (dict of the chunk lists, with the keys 'microphone', 'scan', 'accelerometer', 
+	#   'accelerometer_interrupt' and 'battery', the final ExportCursor).
+	def get_bulk_export(self, cursor=None, checkpoint_interval=DEFAULT_BULK_EXPORT_CHECKPOINT_INTERVAL):
+		request = Request()
+		request.type.which = Request_bulk_export_request_tag
+		request.type.bulk_export_request = BulkExportRequest()
+		request.type.bulk_export_request.checkpoint_interval = checkpoint_interval
+		if cursor is not None:
+			request.type.bulk_export_request.has_cursor = 1
+			request.type.bulk_export_request.cursor = cursor
+		
+		return self.receive_bulk_export(request, cursor)
+	
+	# Sends a bulk export (or pull new data) request and receives the checkpointed response stream (see get_bulk_export()).
+	def receive_bulk_export(self, request, cursor=None):
+		self.bulk_export_cursor = cursor
+		
+		data_queues = {
+			'microphone': self.microphone_data_response_queue,
+			'scan': self.scan_data_response_queue,
+			'accelerometer': self.accelerometer_data_response_queue,
+			'accelerometer_interrupt': self.accelerometer_interrupt_data_response_queue,
+			'battery': self.battery_data_response_queue,
+		}
+		
+		# Clear the queues before receiving
+		for queue in list(data_queues.values()) + [self.bulk_export_checkpoint_response_queue]:
+			with queue.mutex:
+				queue.queue.clear()
+		
+		self.send_request(request)
+		
+		chunks = dict((key, []) for key in data_queues)
+		pending_chunks = dict((key, []) for key in data_queues)
+		
+		while True:
+			self.receive_response()
+			for key, queue in data_queues.items():
+				while(not queue.empty()):
+					pending_chunks[key].append(queue.get())
+			if(not self.bulk_export_checkpoint_response_queue.empty()):
+				checkpoint = self.bulk_export_checkpoint_response_queue.get()
+				# The checkpoint confirms all chunks received since the last checkpoint
+				for key in data_queues:
+					chunks[key] += pending_chunks[key]
+					pending_chunks[key] = []
+				self.bulk_export_cursor = checkpoint.cursor
+				if(checkpoint.last_response):
+					break;
+		
+		return (chunks, self.bulk_export_cursor)
+	
+	# Sends a pull new data request to the badge: like get_bulk_export(), but the badge starts directly at the 
+	#   download cursor it stores for the hub (hub_id is a 16 bit identifier of this hub), or at the oldest data 
+	#   if the hub is unknown. The final cursor is acknowledged, so the next call only returns newer data.
+	#   If the connection drops, the received data could be acknowledged with acknowledge_data(hub_id, self.bulk_export_cursor).
+	# Returns a tuple of (dict of the chunk lists, the final ExportCursor), like get_bulk_export().
+	def pull_new_data(self, hub_id, checkpoint_interval=DEFAULT_BULK_EXPORT_CHECKPOINT_INTERVAL):
+		request = Request()
+		request.type.which = Request_pull_new_data_request_tag
+		request.type.pull_new_data_request = PullNewDataRequest()
+		request.type.pull_new_data_request.hub_id = hub_id
+		request.type.pull_new_data_request.checkpoint_interval = checkpoint_interval
+		
+		(chunks, cursor) = self.receive_bulk_export(request)
+		
+		self.acknowledge_data(hub_id, cursor)
+		
+		return (chunks, cursor)
+	
+	# Sends an acknowledge data request to the badge, that stores the ExportCursor as download cursor of the hub.
+	def acknowledge_data(self, hub_id, cursor):
+		request = Request()
+		request.type.which = Request_acknowledge_data_request_tag
+		request.type.acknowledge_data_request = AcknowledgeDataRequest()
+		request.type.acknowledge_data_request.hub_id = hub_id
+		request.type.acknowledge_data_request.cursor = cursor
+		
+		self.send_request(request)
+	
 	
 	
 	
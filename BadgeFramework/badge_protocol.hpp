@@ -0,0 +1,2967 @@
+#ifndef __BADGE_PROTOCOL_HPP
+#define __BADGE_PROTOCOL_HPP
+
+#include <stdint.h>
+#include "tinybuf.hpp"
+
+#define PROTOCOL_MICROPHONE_DATA_SIZE 114
+#define PROTOCOL_SCAN_DATA_SIZE 29
+#define PROTOCOL_ACCELEROMETER_DATA_SIZE 100
+#define PROTOCOL_COMPRESSION_NONE 0
+#define PROTOCOL_COMPRESSION_LZSS 1
+#define PROTOCOL_DATA_SOURCE_MICROPHONE 0
+#define PROTOCOL_DATA_SOURCE_SCAN 1
+#define PROTOCOL_DATA_SOURCE_ACCELEROMETER 2
+#define PROTOCOL_DATA_SOURCE_ACCELEROMETER_INTERRUPT 3
+#define PROTOCOL_DATA_SOURCE_BATTERY 4
+#define PROTOCOL_OVERFLOW_POLICY_DROP_NEWEST 0
+#define PROTOCOL_OVERFLOW_POLICY_DROP_OLDEST 1
+#define PROTOCOL_OVERFLOW_POLICY_DEGRADE_RATE 2
+#define PROTOCOL_MICROPHONE_STREAM_SIZE 10
+#define PROTOCOL_SCAN_STREAM_SIZE 10
+#define PROTOCOL_ACCELEROMETER_STREAM_SIZE 10
+#define PROTOCOL_ACCELEROMETER_INTERRUPT_STREAM_SIZE 10
+#define PROTOCOL_BATTERY_STREAM_SIZE 10
+
+#define Request_status_request_tag 1
+#define Request_start_microphone_request_tag 2
+#define Request_stop_microphone_request_tag 3
+#define Request_start_scan_request_tag 4
+#define Request_stop_scan_request_tag 5
+#define Request_start_accelerometer_request_tag 6
+#define Request_stop_accelerometer_request_tag 7
+#define Request_start_accelerometer_interrupt_request_tag 8
+#define Request_stop_accelerometer_interrupt_request_tag 9
+#define Request_start_battery_request_tag 10
+#define Request_stop_battery_request_tag 11
+#define Request_microphone_data_request_tag 12
+#define Request_scan_data_request_tag 13
+#define Request_accelerometer_data_request_tag 14
+#define Request_accelerometer_interrupt_data_request_tag 15
+#define Request_battery_data_request_tag 16
+#define Request_start_microphone_stream_request_tag 17
+#define Request_stop_microphone_stream_request_tag 18
+#define Request_start_scan_stream_request_tag 19
+#define Request_stop_scan_stream_request_tag 20
+#define Request_start_accelerometer_stream_request_tag 21
+#define Request_stop_accelerometer_stream_request_tag 22
+#define Request_start_accelerometer_interrupt_stream_request_tag 23
+#define Request_stop_accelerometer_interrupt_stream_request_tag 24
+#define Request_start_battery_stream_request_tag 25
+#define Request_stop_battery_stream_request_tag 26
+#define Request_identify_request_tag 27
+#define Request_test_request_tag 28
+#define Request_restart_request_tag 29
+#define Request_diagnostics_request_tag 30
+#define Request_bulk_export_request_tag 31
+#define Request_pull_new_data_request_tag 32
+#define Request_acknowledge_data_request_tag 33
+#define Request_set_compression_request_tag 34
+#define Request_set_overflow_policy_request_tag 35
+#define Response_status_response_tag 1
+#define Response_start_microphone_response_tag 2
+#define Response_start_scan_response_tag 3
+#define Response_start_accelerometer_response_tag 4
+#define Response_start_accelerometer_interrupt_response_tag 5
+#define Response_start_battery_response_tag 6
+#define Response_microphone_data_response_tag 7
+#define Response_scan_data_response_tag 8
+#define Response_accelerometer_data_response_tag 9
+#define Response_accelerometer_interrupt_data_response_tag 10
+#define Response_battery_data_response_tag 11
+#define Response_stream_response_tag 12
+#define Response_test_response_tag 13
+#define Response_diagnostics_response_tag 14
+#define Response_bulk_export_checkpoint_response_tag 15
+#define Response_set_compression_response_tag 16
+#define Response_set_overflow_policy_response_tag 17
+
+namespace tinybuf {
+
+typedef struct {
+	uint32_t seconds;
+	uint16_t ms;
+} Timestamp;
+
+template<>
+struct MessageTraits<Timestamp> {
+	static constexpr const char* name() { return "Timestamp"; }
+	static constexpr uint32_t max_encoded_len() { return 4 + 2; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const Timestamp& message) {
+		if(!ostream.write(message.seconds))
+			return false;
+		if(!ostream.write(message.ms))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, Timestamp& message) {
+		if(!istream.read(message.seconds))
+			return false;
+		if(!istream.read(message.ms))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const Timestamp& message) {
+		visitor.field("seconds", message.seconds);
+		visitor.field("ms", message.ms);
+	}
+};
+
+typedef struct {
+	uint16_t ID;
+	uint8_t group;
+} BadgeAssignement;
+
+template<>
+struct MessageTraits<BadgeAssignement> {
+	static constexpr const char* name() { return "BadgeAssignement"; }
+	static constexpr uint32_t max_encoded_len() { return 2 + 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const BadgeAssignement& message) {
+		if(!ostream.write(message.ID))
+			return false;
+		if(!ostream.write(message.group))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, BadgeAssignement& message) {
+		if(!istream.read(message.ID))
+			return false;
+		if(!istream.read(message.group))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const BadgeAssignement& message) {
+		visitor.field("ID", message.ID);
+		visitor.field("group", message.group);
+	}
+};
+
+typedef struct {
+	float voltage;
+} BatteryData;
+
+template<>
+struct MessageTraits<BatteryData> {
+	static constexpr const char* name() { return "BatteryData"; }
+	static constexpr uint32_t max_encoded_len() { return 4; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const BatteryData& message) {
+		if(!ostream.write(message.voltage))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, BatteryData& message) {
+		if(!istream.read(message.voltage))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const BatteryData& message) {
+		visitor.field("voltage", message.voltage);
+	}
+};
+
+typedef struct {
+	uint8_t value;
+} MicrophoneData;
+
+template<>
+struct MessageTraits<MicrophoneData> {
+	static constexpr const char* name() { return "MicrophoneData"; }
+	static constexpr uint32_t max_encoded_len() { return 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const MicrophoneData& message) {
+		if(!ostream.write(message.value))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, MicrophoneData& message) {
+		if(!istream.read(message.value))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const MicrophoneData& message) {
+		visitor.field("value", message.value);
+	}
+};
+
+typedef struct {
+	uint16_t ID;
+	int8_t rssi;
+} ScanDevice;
+
+template<>
+struct MessageTraits<ScanDevice> {
+	static constexpr const char* name() { return "ScanDevice"; }
+	static constexpr uint32_t max_encoded_len() { return 2 + 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const ScanDevice& message) {
+		if(!ostream.write(message.ID))
+			return false;
+		if(!ostream.write(message.rssi))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, ScanDevice& message) {
+		if(!istream.read(message.ID))
+			return false;
+		if(!istream.read(message.rssi))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const ScanDevice& message) {
+		visitor.field("ID", message.ID);
+		visitor.field("rssi", message.rssi);
+	}
+};
+
+typedef struct {
+	ScanDevice scan_device;
+	uint8_t count;
+} ScanResultData;
+
+template<>
+struct MessageTraits<ScanResultData> {
+	static constexpr const char* name() { return "ScanResultData"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<ScanDevice>::max_encoded_len() + 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const ScanResultData& message) {
+		if(!MessageTraits<ScanDevice>::encode(ostream, message.scan_device))
+			return false;
+		if(!ostream.write(message.count))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, ScanResultData& message) {
+		if(!MessageTraits<ScanDevice>::decode(istream, message.scan_device))
+			return false;
+		if(!istream.read(message.count))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const ScanResultData& message) {
+		visitor.field("scan_device", message.scan_device);
+		visitor.field("count", message.count);
+	}
+};
+
+typedef struct {
+	uint16_t acceleration;
+} AccelerometerData;
+
+template<>
+struct MessageTraits<AccelerometerData> {
+	static constexpr const char* name() { return "AccelerometerData"; }
+	static constexpr uint32_t max_encoded_len() { return 2; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const AccelerometerData& message) {
+		if(!ostream.write(message.acceleration))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, AccelerometerData& message) {
+		if(!istream.read(message.acceleration))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const AccelerometerData& message) {
+		visitor.field("acceleration", message.acceleration);
+	}
+};
+
+typedef struct {
+	int16_t raw_acceleration[3];
+} AccelerometerRawData;
+
+template<>
+struct MessageTraits<AccelerometerRawData> {
+	static constexpr const char* name() { return "AccelerometerRawData"; }
+	static constexpr uint32_t max_encoded_len() { return 3*2; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const AccelerometerRawData& message) {
+		if(!ostream.write_array(message.raw_acceleration, 3))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, AccelerometerRawData& message) {
+		if(!istream.read_array(message.raw_acceleration, 3))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const AccelerometerRawData& message) {
+		visitor.repeated("raw_acceleration", message.raw_acceleration, (uint32_t) 3);
+	}
+};
+
+typedef struct {
+	BatteryData battery_data;
+} BatteryStream;
+
+template<>
+struct MessageTraits<BatteryStream> {
+	static constexpr const char* name() { return "BatteryStream"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<BatteryData>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const BatteryStream& message) {
+		if(!MessageTraits<BatteryData>::encode(ostream, message.battery_data))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, BatteryStream& message) {
+		if(!MessageTraits<BatteryData>::decode(istream, message.battery_data))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const BatteryStream& message) {
+		visitor.field("battery_data", message.battery_data);
+	}
+};
+
+typedef struct {
+	MicrophoneData microphone_data;
+} MicrophoneStream;
+
+template<>
+struct MessageTraits<MicrophoneStream> {
+	static constexpr const char* name() { return "MicrophoneStream"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<MicrophoneData>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const MicrophoneStream& message) {
+		if(!MessageTraits<MicrophoneData>::encode(ostream, message.microphone_data))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, MicrophoneStream& message) {
+		if(!MessageTraits<MicrophoneData>::decode(istream, message.microphone_data))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const MicrophoneStream& message) {
+		visitor.field("microphone_data", message.microphone_data);
+	}
+};
+
+typedef struct {
+	ScanDevice scan_device;
+} ScanStream;
+
+template<>
+struct MessageTraits<ScanStream> {
+	static constexpr const char* name() { return "ScanStream"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<ScanDevice>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const ScanStream& message) {
+		if(!MessageTraits<ScanDevice>::encode(ostream, message.scan_device))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, ScanStream& message) {
+		if(!MessageTraits<ScanDevice>::decode(istream, message.scan_device))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const ScanStream& message) {
+		visitor.field("scan_device", message.scan_device);
+	}
+};
+
+typedef struct {
+	AccelerometerRawData accelerometer_raw_data;
+} AccelerometerStream;
+
+template<>
+struct MessageTraits<AccelerometerStream> {
+	static constexpr const char* name() { return "AccelerometerStream"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<AccelerometerRawData>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const AccelerometerStream& message) {
+		if(!MessageTraits<AccelerometerRawData>::encode(ostream, message.accelerometer_raw_data))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, AccelerometerStream& message) {
+		if(!MessageTraits<AccelerometerRawData>::decode(istream, message.accelerometer_raw_data))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const AccelerometerStream& message) {
+		visitor.field("accelerometer_raw_data", message.accelerometer_raw_data);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+} AccelerometerInterruptStream;
+
+template<>
+struct MessageTraits<AccelerometerInterruptStream> {
+	static constexpr const char* name() { return "AccelerometerInterruptStream"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const AccelerometerInterruptStream& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, AccelerometerInterruptStream& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const AccelerometerInterruptStream& message) {
+		visitor.field("timestamp", message.timestamp);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+	uint8_t has_badge_assignement;
+	BadgeAssignement badge_assignement;
+} StatusRequest;
+
+template<>
+struct MessageTraits<StatusRequest> {
+	static constexpr const char* name() { return "StatusRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len() + 1 + MessageTraits<BadgeAssignement>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StatusRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!ostream.write(message.has_badge_assignement))
+			return false;
+		if(message.has_badge_assignement && !MessageTraits<BadgeAssignement>::encode(ostream, message.badge_assignement))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StatusRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.has_badge_assignement))
+			return false;
+		if(message.has_badge_assignement && !MessageTraits<BadgeAssignement>::decode(istream, message.badge_assignement))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StatusRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+		visitor.optional("badge_assignement", message.has_badge_assignement, message.badge_assignement);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+	uint16_t timeout;
+	uint16_t period_ms;
+} StartMicrophoneRequest;
+
+template<>
+struct MessageTraits<StartMicrophoneRequest> {
+	static constexpr const char* name() { return "StartMicrophoneRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len() + 2 + 2; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartMicrophoneRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!ostream.write(message.timeout))
+			return false;
+		if(!ostream.write(message.period_ms))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartMicrophoneRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.timeout))
+			return false;
+		if(!istream.read(message.period_ms))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartMicrophoneRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("timeout", message.timeout);
+		visitor.field("period_ms", message.period_ms);
+	}
+};
+
+typedef struct {
+} StopMicrophoneRequest;
+
+template<>
+struct MessageTraits<StopMicrophoneRequest> {
+	static constexpr const char* name() { return "StopMicrophoneRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StopMicrophoneRequest& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StopMicrophoneRequest& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StopMicrophoneRequest& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+	uint16_t timeout;
+	uint16_t window;
+	uint16_t interval;
+	uint16_t duration;
+	uint16_t period;
+	uint8_t aggregation_type;
+} StartScanRequest;
+
+template<>
+struct MessageTraits<StartScanRequest> {
+	static constexpr const char* name() { return "StartScanRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len() + 2 + 2 + 2 + 2 + 2 + 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartScanRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!ostream.write(message.timeout))
+			return false;
+		if(!ostream.write(message.window))
+			return false;
+		if(!ostream.write(message.interval))
+			return false;
+		if(!ostream.write(message.duration))
+			return false;
+		if(!ostream.write(message.period))
+			return false;
+		if(!ostream.write(message.aggregation_type))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartScanRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.timeout))
+			return false;
+		if(!istream.read(message.window))
+			return false;
+		if(!istream.read(message.interval))
+			return false;
+		if(!istream.read(message.duration))
+			return false;
+		if(!istream.read(message.period))
+			return false;
+		if(!istream.read(message.aggregation_type))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartScanRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("timeout", message.timeout);
+		visitor.field("window", message.window);
+		visitor.field("interval", message.interval);
+		visitor.field("duration", message.duration);
+		visitor.field("period", message.period);
+		visitor.field("aggregation_type", message.aggregation_type);
+	}
+};
+
+typedef struct {
+} StopScanRequest;
+
+template<>
+struct MessageTraits<StopScanRequest> {
+	static constexpr const char* name() { return "StopScanRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StopScanRequest& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StopScanRequest& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StopScanRequest& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+	uint16_t timeout;
+	uint8_t operating_mode;
+	uint8_t full_scale;
+	uint16_t datarate;
+	uint16_t fifo_sampling_period_ms;
+} StartAccelerometerRequest;
+
+template<>
+struct MessageTraits<StartAccelerometerRequest> {
+	static constexpr const char* name() { return "StartAccelerometerRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len() + 2 + 1 + 1 + 2 + 2; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartAccelerometerRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!ostream.write(message.timeout))
+			return false;
+		if(!ostream.write(message.operating_mode))
+			return false;
+		if(!ostream.write(message.full_scale))
+			return false;
+		if(!ostream.write(message.datarate))
+			return false;
+		if(!ostream.write(message.fifo_sampling_period_ms))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartAccelerometerRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.timeout))
+			return false;
+		if(!istream.read(message.operating_mode))
+			return false;
+		if(!istream.read(message.full_scale))
+			return false;
+		if(!istream.read(message.datarate))
+			return false;
+		if(!istream.read(message.fifo_sampling_period_ms))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartAccelerometerRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("timeout", message.timeout);
+		visitor.field("operating_mode", message.operating_mode);
+		visitor.field("full_scale", message.full_scale);
+		visitor.field("datarate", message.datarate);
+		visitor.field("fifo_sampling_period_ms", message.fifo_sampling_period_ms);
+	}
+};
+
+typedef struct {
+} StopAccelerometerRequest;
+
+template<>
+struct MessageTraits<StopAccelerometerRequest> {
+	static constexpr const char* name() { return "StopAccelerometerRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StopAccelerometerRequest& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StopAccelerometerRequest& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StopAccelerometerRequest& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+	uint16_t timeout;
+	uint16_t threshold_mg;
+	uint16_t minimal_duration_ms;
+	uint32_t ignore_duration_ms;
+} StartAccelerometerInterruptRequest;
+
+template<>
+struct MessageTraits<StartAccelerometerInterruptRequest> {
+	static constexpr const char* name() { return "StartAccelerometerInterruptRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len() + 2 + 2 + 2 + 4; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartAccelerometerInterruptRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!ostream.write(message.timeout))
+			return false;
+		if(!ostream.write(message.threshold_mg))
+			return false;
+		if(!ostream.write(message.minimal_duration_ms))
+			return false;
+		if(!ostream.write(message.ignore_duration_ms))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartAccelerometerInterruptRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.timeout))
+			return false;
+		if(!istream.read(message.threshold_mg))
+			return false;
+		if(!istream.read(message.minimal_duration_ms))
+			return false;
+		if(!istream.read(message.ignore_duration_ms))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartAccelerometerInterruptRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("timeout", message.timeout);
+		visitor.field("threshold_mg", message.threshold_mg);
+		visitor.field("minimal_duration_ms", message.minimal_duration_ms);
+		visitor.field("ignore_duration_ms", message.ignore_duration_ms);
+	}
+};
+
+typedef struct {
+} StopAccelerometerInterruptRequest;
+
+template<>
+struct MessageTraits<StopAccelerometerInterruptRequest> {
+	static constexpr const char* name() { return "StopAccelerometerInterruptRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StopAccelerometerInterruptRequest& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StopAccelerometerInterruptRequest& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StopAccelerometerInterruptRequest& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+	uint16_t timeout;
+	uint32_t period_ms;
+} StartBatteryRequest;
+
+template<>
+struct MessageTraits<StartBatteryRequest> {
+	static constexpr const char* name() { return "StartBatteryRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len() + 2 + 4; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartBatteryRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!ostream.write(message.timeout))
+			return false;
+		if(!ostream.write(message.period_ms))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartBatteryRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.timeout))
+			return false;
+		if(!istream.read(message.period_ms))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartBatteryRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("timeout", message.timeout);
+		visitor.field("period_ms", message.period_ms);
+	}
+};
+
+typedef struct {
+} StopBatteryRequest;
+
+template<>
+struct MessageTraits<StopBatteryRequest> {
+	static constexpr const char* name() { return "StopBatteryRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StopBatteryRequest& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StopBatteryRequest& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StopBatteryRequest& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+} MicrophoneDataRequest;
+
+template<>
+struct MessageTraits<MicrophoneDataRequest> {
+	static constexpr const char* name() { return "MicrophoneDataRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const MicrophoneDataRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, MicrophoneDataRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const MicrophoneDataRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+} ScanDataRequest;
+
+template<>
+struct MessageTraits<ScanDataRequest> {
+	static constexpr const char* name() { return "ScanDataRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const ScanDataRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, ScanDataRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const ScanDataRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+} AccelerometerDataRequest;
+
+template<>
+struct MessageTraits<AccelerometerDataRequest> {
+	static constexpr const char* name() { return "AccelerometerDataRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const AccelerometerDataRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, AccelerometerDataRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const AccelerometerDataRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+} AccelerometerInterruptDataRequest;
+
+template<>
+struct MessageTraits<AccelerometerInterruptDataRequest> {
+	static constexpr const char* name() { return "AccelerometerInterruptDataRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const AccelerometerInterruptDataRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, AccelerometerInterruptDataRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const AccelerometerInterruptDataRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+} BatteryDataRequest;
+
+template<>
+struct MessageTraits<BatteryDataRequest> {
+	static constexpr const char* name() { return "BatteryDataRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const BatteryDataRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, BatteryDataRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const BatteryDataRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+	}
+};
+
+typedef struct {
+	uint16_t microphone_record_id;
+	uint16_t scan_record_id;
+	uint16_t accelerometer_record_id;
+	uint16_t accelerometer_interrupt_record_id;
+	uint16_t battery_record_id;
+} ExportCursor;
+
+template<>
+struct MessageTraits<ExportCursor> {
+	static constexpr const char* name() { return "ExportCursor"; }
+	static constexpr uint32_t max_encoded_len() { return 2 + 2 + 2 + 2 + 2; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const ExportCursor& message) {
+		if(!ostream.write(message.microphone_record_id))
+			return false;
+		if(!ostream.write(message.scan_record_id))
+			return false;
+		if(!ostream.write(message.accelerometer_record_id))
+			return false;
+		if(!ostream.write(message.accelerometer_interrupt_record_id))
+			return false;
+		if(!ostream.write(message.battery_record_id))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, ExportCursor& message) {
+		if(!istream.read(message.microphone_record_id))
+			return false;
+		if(!istream.read(message.scan_record_id))
+			return false;
+		if(!istream.read(message.accelerometer_record_id))
+			return false;
+		if(!istream.read(message.accelerometer_interrupt_record_id))
+			return false;
+		if(!istream.read(message.battery_record_id))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const ExportCursor& message) {
+		visitor.field("microphone_record_id", message.microphone_record_id);
+		visitor.field("scan_record_id", message.scan_record_id);
+		visitor.field("accelerometer_record_id", message.accelerometer_record_id);
+		visitor.field("accelerometer_interrupt_record_id", message.accelerometer_interrupt_record_id);
+		visitor.field("battery_record_id", message.battery_record_id);
+	}
+};
+
+typedef struct {
+	uint16_t checkpoint_interval;
+	uint8_t has_cursor;
+	ExportCursor cursor;
+} BulkExportRequest;
+
+template<>
+struct MessageTraits<BulkExportRequest> {
+	static constexpr const char* name() { return "BulkExportRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 2 + 1 + MessageTraits<ExportCursor>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const BulkExportRequest& message) {
+		if(!ostream.write(message.checkpoint_interval))
+			return false;
+		if(!ostream.write(message.has_cursor))
+			return false;
+		if(message.has_cursor && !MessageTraits<ExportCursor>::encode(ostream, message.cursor))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, BulkExportRequest& message) {
+		if(!istream.read(message.checkpoint_interval))
+			return false;
+		if(!istream.read(message.has_cursor))
+			return false;
+		if(message.has_cursor && !MessageTraits<ExportCursor>::decode(istream, message.cursor))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const BulkExportRequest& message) {
+		visitor.field("checkpoint_interval", message.checkpoint_interval);
+		visitor.optional("cursor", message.has_cursor, message.cursor);
+	}
+};
+
+typedef struct {
+	uint16_t hub_id;
+	uint16_t checkpoint_interval;
+} PullNewDataRequest;
+
+template<>
+struct MessageTraits<PullNewDataRequest> {
+	static constexpr const char* name() { return "PullNewDataRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 2 + 2; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const PullNewDataRequest& message) {
+		if(!ostream.write(message.hub_id))
+			return false;
+		if(!ostream.write(message.checkpoint_interval))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, PullNewDataRequest& message) {
+		if(!istream.read(message.hub_id))
+			return false;
+		if(!istream.read(message.checkpoint_interval))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const PullNewDataRequest& message) {
+		visitor.field("hub_id", message.hub_id);
+		visitor.field("checkpoint_interval", message.checkpoint_interval);
+	}
+};
+
+typedef struct {
+	uint16_t hub_id;
+	ExportCursor cursor;
+} AcknowledgeDataRequest;
+
+template<>
+struct MessageTraits<AcknowledgeDataRequest> {
+	static constexpr const char* name() { return "AcknowledgeDataRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 2 + MessageTraits<ExportCursor>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const AcknowledgeDataRequest& message) {
+		if(!ostream.write(message.hub_id))
+			return false;
+		if(!MessageTraits<ExportCursor>::encode(ostream, message.cursor))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, AcknowledgeDataRequest& message) {
+		if(!istream.read(message.hub_id))
+			return false;
+		if(!MessageTraits<ExportCursor>::decode(istream, message.cursor))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const AcknowledgeDataRequest& message) {
+		visitor.field("hub_id", message.hub_id);
+		visitor.field("cursor", message.cursor);
+	}
+};
+
+typedef struct {
+	uint8_t compression;
+} SetCompressionRequest;
+
+template<>
+struct MessageTraits<SetCompressionRequest> {
+	static constexpr const char* name() { return "SetCompressionRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const SetCompressionRequest& message) {
+		if(!ostream.write(message.compression))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, SetCompressionRequest& message) {
+		if(!istream.read(message.compression))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const SetCompressionRequest& message) {
+		visitor.field("compression", message.compression);
+	}
+};
+
+typedef struct {
+	uint8_t data_source;
+	uint8_t overflow_policy;
+} SetOverflowPolicyRequest;
+
+template<>
+struct MessageTraits<SetOverflowPolicyRequest> {
+	static constexpr const char* name() { return "SetOverflowPolicyRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 1 + 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const SetOverflowPolicyRequest& message) {
+		if(!ostream.write(message.data_source))
+			return false;
+		if(!ostream.write(message.overflow_policy))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, SetOverflowPolicyRequest& message) {
+		if(!istream.read(message.data_source))
+			return false;
+		if(!istream.read(message.overflow_policy))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const SetOverflowPolicyRequest& message) {
+		visitor.field("data_source", message.data_source);
+		visitor.field("overflow_policy", message.overflow_policy);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+	uint16_t timeout;
+	uint16_t period_ms;
+} StartMicrophoneStreamRequest;
+
+template<>
+struct MessageTraits<StartMicrophoneStreamRequest> {
+	static constexpr const char* name() { return "StartMicrophoneStreamRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len() + 2 + 2; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartMicrophoneStreamRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!ostream.write(message.timeout))
+			return false;
+		if(!ostream.write(message.period_ms))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartMicrophoneStreamRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.timeout))
+			return false;
+		if(!istream.read(message.period_ms))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartMicrophoneStreamRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("timeout", message.timeout);
+		visitor.field("period_ms", message.period_ms);
+	}
+};
+
+typedef struct {
+} StopMicrophoneStreamRequest;
+
+template<>
+struct MessageTraits<StopMicrophoneStreamRequest> {
+	static constexpr const char* name() { return "StopMicrophoneStreamRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StopMicrophoneStreamRequest& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StopMicrophoneStreamRequest& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StopMicrophoneStreamRequest& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+	uint16_t timeout;
+	uint16_t window;
+	uint16_t interval;
+	uint16_t duration;
+	uint16_t period;
+	uint8_t aggregation_type;
+} StartScanStreamRequest;
+
+template<>
+struct MessageTraits<StartScanStreamRequest> {
+	static constexpr const char* name() { return "StartScanStreamRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len() + 2 + 2 + 2 + 2 + 2 + 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartScanStreamRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!ostream.write(message.timeout))
+			return false;
+		if(!ostream.write(message.window))
+			return false;
+		if(!ostream.write(message.interval))
+			return false;
+		if(!ostream.write(message.duration))
+			return false;
+		if(!ostream.write(message.period))
+			return false;
+		if(!ostream.write(message.aggregation_type))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartScanStreamRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.timeout))
+			return false;
+		if(!istream.read(message.window))
+			return false;
+		if(!istream.read(message.interval))
+			return false;
+		if(!istream.read(message.duration))
+			return false;
+		if(!istream.read(message.period))
+			return false;
+		if(!istream.read(message.aggregation_type))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartScanStreamRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("timeout", message.timeout);
+		visitor.field("window", message.window);
+		visitor.field("interval", message.interval);
+		visitor.field("duration", message.duration);
+		visitor.field("period", message.period);
+		visitor.field("aggregation_type", message.aggregation_type);
+	}
+};
+
+typedef struct {
+} StopScanStreamRequest;
+
+template<>
+struct MessageTraits<StopScanStreamRequest> {
+	static constexpr const char* name() { return "StopScanStreamRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StopScanStreamRequest& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StopScanStreamRequest& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StopScanStreamRequest& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+	uint16_t timeout;
+	uint8_t operating_mode;
+	uint8_t full_scale;
+	uint16_t datarate;
+	uint16_t fifo_sampling_period_ms;
+} StartAccelerometerStreamRequest;
+
+template<>
+struct MessageTraits<StartAccelerometerStreamRequest> {
+	static constexpr const char* name() { return "StartAccelerometerStreamRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len() + 2 + 1 + 1 + 2 + 2; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartAccelerometerStreamRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!ostream.write(message.timeout))
+			return false;
+		if(!ostream.write(message.operating_mode))
+			return false;
+		if(!ostream.write(message.full_scale))
+			return false;
+		if(!ostream.write(message.datarate))
+			return false;
+		if(!ostream.write(message.fifo_sampling_period_ms))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartAccelerometerStreamRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.timeout))
+			return false;
+		if(!istream.read(message.operating_mode))
+			return false;
+		if(!istream.read(message.full_scale))
+			return false;
+		if(!istream.read(message.datarate))
+			return false;
+		if(!istream.read(message.fifo_sampling_period_ms))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartAccelerometerStreamRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("timeout", message.timeout);
+		visitor.field("operating_mode", message.operating_mode);
+		visitor.field("full_scale", message.full_scale);
+		visitor.field("datarate", message.datarate);
+		visitor.field("fifo_sampling_period_ms", message.fifo_sampling_period_ms);
+	}
+};
+
+typedef struct {
+} StopAccelerometerStreamRequest;
+
+template<>
+struct MessageTraits<StopAccelerometerStreamRequest> {
+	static constexpr const char* name() { return "StopAccelerometerStreamRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StopAccelerometerStreamRequest& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StopAccelerometerStreamRequest& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StopAccelerometerStreamRequest& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+	uint16_t timeout;
+	uint16_t threshold_mg;
+	uint16_t minimal_duration_ms;
+	uint32_t ignore_duration_ms;
+} StartAccelerometerInterruptStreamRequest;
+
+template<>
+struct MessageTraits<StartAccelerometerInterruptStreamRequest> {
+	static constexpr const char* name() { return "StartAccelerometerInterruptStreamRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len() + 2 + 2 + 2 + 4; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartAccelerometerInterruptStreamRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!ostream.write(message.timeout))
+			return false;
+		if(!ostream.write(message.threshold_mg))
+			return false;
+		if(!ostream.write(message.minimal_duration_ms))
+			return false;
+		if(!ostream.write(message.ignore_duration_ms))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartAccelerometerInterruptStreamRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.timeout))
+			return false;
+		if(!istream.read(message.threshold_mg))
+			return false;
+		if(!istream.read(message.minimal_duration_ms))
+			return false;
+		if(!istream.read(message.ignore_duration_ms))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartAccelerometerInterruptStreamRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("timeout", message.timeout);
+		visitor.field("threshold_mg", message.threshold_mg);
+		visitor.field("minimal_duration_ms", message.minimal_duration_ms);
+		visitor.field("ignore_duration_ms", message.ignore_duration_ms);
+	}
+};
+
+typedef struct {
+} StopAccelerometerInterruptStreamRequest;
+
+template<>
+struct MessageTraits<StopAccelerometerInterruptStreamRequest> {
+	static constexpr const char* name() { return "StopAccelerometerInterruptStreamRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StopAccelerometerInterruptStreamRequest& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StopAccelerometerInterruptStreamRequest& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StopAccelerometerInterruptStreamRequest& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+	uint16_t timeout;
+	uint32_t period_ms;
+} StartBatteryStreamRequest;
+
+template<>
+struct MessageTraits<StartBatteryStreamRequest> {
+	static constexpr const char* name() { return "StartBatteryStreamRequest"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len() + 2 + 4; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartBatteryStreamRequest& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!ostream.write(message.timeout))
+			return false;
+		if(!ostream.write(message.period_ms))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartBatteryStreamRequest& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.timeout))
+			return false;
+		if(!istream.read(message.period_ms))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartBatteryStreamRequest& message) {
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("timeout", message.timeout);
+		visitor.field("period_ms", message.period_ms);
+	}
+};
+
+typedef struct {
+} StopBatteryStreamRequest;
+
+template<>
+struct MessageTraits<StopBatteryStreamRequest> {
+	static constexpr const char* name() { return "StopBatteryStreamRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StopBatteryStreamRequest& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StopBatteryStreamRequest& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StopBatteryStreamRequest& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+typedef struct {
+	uint16_t timeout;
+} IdentifyRequest;
+
+template<>
+struct MessageTraits<IdentifyRequest> {
+	static constexpr const char* name() { return "IdentifyRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 2; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const IdentifyRequest& message) {
+		if(!ostream.write(message.timeout))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, IdentifyRequest& message) {
+		if(!istream.read(message.timeout))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const IdentifyRequest& message) {
+		visitor.field("timeout", message.timeout);
+	}
+};
+
+typedef struct {
+} TestRequest;
+
+template<>
+struct MessageTraits<TestRequest> {
+	static constexpr const char* name() { return "TestRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const TestRequest& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, TestRequest& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const TestRequest& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+typedef struct {
+} RestartRequest;
+
+template<>
+struct MessageTraits<RestartRequest> {
+	static constexpr const char* name() { return "RestartRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const RestartRequest& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, RestartRequest& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const RestartRequest& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+typedef struct {
+	uint8_t reset_chunk_fifo_status;
+} DiagnosticsRequest;
+
+template<>
+struct MessageTraits<DiagnosticsRequest> {
+	static constexpr const char* name() { return "DiagnosticsRequest"; }
+	static constexpr uint32_t max_encoded_len() { return 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const DiagnosticsRequest& message) {
+		if(!ostream.write(message.reset_chunk_fifo_status))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, DiagnosticsRequest& message) {
+		if(!istream.read(message.reset_chunk_fifo_status))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const DiagnosticsRequest& message) {
+		visitor.field("reset_chunk_fifo_status", message.reset_chunk_fifo_status);
+	}
+};
+
+typedef struct {
+	uint8_t which_type;
+	union {
+		StatusRequest status_request;
+		StartMicrophoneRequest start_microphone_request;
+		StopMicrophoneRequest stop_microphone_request;
+		StartScanRequest start_scan_request;
+		StopScanRequest stop_scan_request;
+		StartAccelerometerRequest start_accelerometer_request;
+		StopAccelerometerRequest stop_accelerometer_request;
+		StartAccelerometerInterruptRequest start_accelerometer_interrupt_request;
+		StopAccelerometerInterruptRequest stop_accelerometer_interrupt_request;
+		StartBatteryRequest start_battery_request;
+		StopBatteryRequest stop_battery_request;
+		MicrophoneDataRequest microphone_data_request;
+		ScanDataRequest scan_data_request;
+		AccelerometerDataRequest accelerometer_data_request;
+		AccelerometerInterruptDataRequest accelerometer_interrupt_data_request;
+		BatteryDataRequest battery_data_request;
+		StartMicrophoneStreamRequest start_microphone_stream_request;
+		StopMicrophoneStreamRequest stop_microphone_stream_request;
+		StartScanStreamRequest start_scan_stream_request;
+		StopScanStreamRequest stop_scan_stream_request;
+		StartAccelerometerStreamRequest start_accelerometer_stream_request;
+		StopAccelerometerStreamRequest stop_accelerometer_stream_request;
+		StartAccelerometerInterruptStreamRequest start_accelerometer_interrupt_stream_request;
+		StopAccelerometerInterruptStreamRequest stop_accelerometer_interrupt_stream_request;
+		StartBatteryStreamRequest start_battery_stream_request;
+		StopBatteryStreamRequest stop_battery_stream_request;
+		IdentifyRequest identify_request;
+		TestRequest test_request;
+		RestartRequest restart_request;
+		DiagnosticsRequest diagnostics_request;
+		BulkExportRequest bulk_export_request;
+		PullNewDataRequest pull_new_data_request;
+		AcknowledgeDataRequest acknowledge_data_request;
+		SetCompressionRequest set_compression_request;
+		SetOverflowPolicyRequest set_overflow_policy_request;
+	} type;
+} Request;
+
+template<>
+struct MessageTraits<Request> {
+	static constexpr const char* name() { return "Request"; }
+	static constexpr uint32_t max_encoded_len() { return 1 + max_len(MessageTraits<StatusRequest>::max_encoded_len(), max_len(MessageTraits<StartMicrophoneRequest>::max_encoded_len(), max_len(MessageTraits<StopMicrophoneRequest>::max_encoded_len(), max_len(MessageTraits<StartScanRequest>::max_encoded_len(), max_len(MessageTraits<StopScanRequest>::max_encoded_len(), max_len(MessageTraits<StartAccelerometerRequest>::max_encoded_len(), max_len(MessageTraits<StopAccelerometerRequest>::max_encoded_len(), max_len(MessageTraits<StartAccelerometerInterruptRequest>::max_encoded_len(), max_len(MessageTraits<StopAccelerometerInterruptRequest>::max_encoded_len(), max_len(MessageTraits<StartBatteryRequest>::max_encoded_len(), max_len(MessageTraits<StopBatteryRequest>::max_encoded_len(), max_len(MessageTraits<MicrophoneDataRequest>::max_encoded_len(), max_len(MessageTraits<ScanDataRequest>::max_encoded_len(), max_len(MessageTraits<AccelerometerDataRequest>::max_encoded_len(), max_len(MessageTraits<AccelerometerInterruptDataRequest>::max_encoded_len(), max_len(MessageTraits<BatteryDataRequest>::max_encoded_len(), max_len(MessageTraits<StartMicrophoneStreamRequest>::max_encoded_len(), max_len(MessageTraits<StopMicrophoneStreamRequest>::max_encoded_len(), max_len(MessageTraits<StartScanStreamRequest>::max_encoded_len(), max_len(MessageTraits<StopScanStreamRequest>::max_encoded_len(), max_len(MessageTraits<StartAccelerometerStreamRequest>::max_encoded_len(), max_len(MessageTraits<StopAccelerometerStreamRequest>::max_encoded_len(), max_len(MessageTraits<StartAccelerometerInterruptStreamRequest>::max_encoded_len(), max_len(MessageTraits<StopAccelerometerInterruptStreamRequest>::max_encoded_len(), max_len(MessageTraits<StartBatteryStreamRequest>::max_encoded_len(), max_len(MessageTraits<StopBatteryStreamRequest>::max_encoded_len(), max_len(MessageTraits<IdentifyRequest>::max_encoded_len(), max_len(MessageTraits<TestRequest>::max_encoded_len(), max_len(MessageTraits<RestartRequest>::max_encoded_len(), max_len(MessageTraits<DiagnosticsRequest>::max_encoded_len(), max_len(MessageTraits<BulkExportRequest>::max_encoded_len(), max_len(MessageTraits<PullNewDataRequest>::max_encoded_len(), max_len(MessageTraits<AcknowledgeDataRequest>::max_encoded_len(), max_len(MessageTraits<SetCompressionRequest>::max_encoded_len(), MessageTraits<SetOverflowPolicyRequest>::max_encoded_len())))))))))))))))))))))))))))))))))); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const Request& message) {
+		if(!ostream.write(message.which_type))
+			return false;
+		switch(message.which_type) {
+			case 1:
+				if(!MessageTraits<StatusRequest>::encode(ostream, message.type.status_request))
+					return false;
+				break;
+			case 2:
+				if(!MessageTraits<StartMicrophoneRequest>::encode(ostream, message.type.start_microphone_request))
+					return false;
+				break;
+			case 3:
+				if(!MessageTraits<StopMicrophoneRequest>::encode(ostream, message.type.stop_microphone_request))
+					return false;
+				break;
+			case 4:
+				if(!MessageTraits<StartScanRequest>::encode(ostream, message.type.start_scan_request))
+					return false;
+				break;
+			case 5:
+				if(!MessageTraits<StopScanRequest>::encode(ostream, message.type.stop_scan_request))
+					return false;
+				break;
+			case 6:
+				if(!MessageTraits<StartAccelerometerRequest>::encode(ostream, message.type.start_accelerometer_request))
+					return false;
+				break;
+			case 7:
+				if(!MessageTraits<StopAccelerometerRequest>::encode(ostream, message.type.stop_accelerometer_request))
+					return false;
+				break;
+			case 8:
+				if(!MessageTraits<StartAccelerometerInterruptRequest>::encode(ostream, message.type.start_accelerometer_interrupt_request))
+					return false;
+				break;
+			case 9:
+				if(!MessageTraits<StopAccelerometerInterruptRequest>::encode(ostream, message.type.stop_accelerometer_interrupt_request))
+					return false;
+				break;
+			case 10:
+				if(!MessageTraits<StartBatteryRequest>::encode(ostream, message.type.start_battery_request))
+					return false;
+				break;
+			case 11:
+				if(!MessageTraits<StopBatteryRequest>::encode(ostream, message.type.stop_battery_request))
+					return false;
+				break;
+			case 12:
+				if(!MessageTraits<MicrophoneDataRequest>::encode(ostream, message.type.microphone_data_request))
+					return false;
+				break;
+			case 13:
+				if(!MessageTraits<ScanDataRequest>::encode(ostream, message.type.scan_data_request))
+					return false;
+				break;
+			case 14:
+				if(!MessageTraits<AccelerometerDataRequest>::encode(ostream, message.type.accelerometer_data_request))
+					return false;
+				break;
+			case 15:
+				if(!MessageTraits<AccelerometerInterruptDataRequest>::encode(ostream, message.type.accelerometer_interrupt_data_request))
+					return false;
+				break;
+			case 16:
+				if(!MessageTraits<BatteryDataRequest>::encode(ostream, message.type.battery_data_request))
+					return false;
+				break;
+			case 17:
+				if(!MessageTraits<StartMicrophoneStreamRequest>::encode(ostream, message.type.start_microphone_stream_request))
+					return false;
+				break;
+			case 18:
+				if(!MessageTraits<StopMicrophoneStreamRequest>::encode(ostream, message.type.stop_microphone_stream_request))
+					return false;
+				break;
+			case 19:
+				if(!MessageTraits<StartScanStreamRequest>::encode(ostream, message.type.start_scan_stream_request))
+					return false;
+				break;
+			case 20:
+				if(!MessageTraits<StopScanStreamRequest>::encode(ostream, message.type.stop_scan_stream_request))
+					return false;
+				break;
+			case 21:
+				if(!MessageTraits<StartAccelerometerStreamRequest>::encode(ostream, message.type.start_accelerometer_stream_request))
+					return false;
+				break;
+			case 22:
+				if(!MessageTraits<StopAccelerometerStreamRequest>::encode(ostream, message.type.stop_accelerometer_stream_request))
+					return false;
+				break;
+			case 23:
+				if(!MessageTraits<StartAccelerometerInterruptStreamRequest>::encode(ostream, message.type.start_accelerometer_interrupt_stream_request))
+					return false;
+				break;
+			case 24:
+				if(!MessageTraits<StopAccelerometerInterruptStreamRequest>::encode(ostream, message.type.stop_accelerometer_interrupt_stream_request))
+					return false;
+				break;
+			case 25:
+				if(!MessageTraits<StartBatteryStreamRequest>::encode(ostream, message.type.start_battery_stream_request))
+					return false;
+				break;
+			case 26:
+				if(!MessageTraits<StopBatteryStreamRequest>::encode(ostream, message.type.stop_battery_stream_request))
+					return false;
+				break;
+			case 27:
+				if(!MessageTraits<IdentifyRequest>::encode(ostream, message.type.identify_request))
+					return false;
+				break;
+			case 28:
+				if(!MessageTraits<TestRequest>::encode(ostream, message.type.test_request))
+					return false;
+				break;
+			case 29:
+				if(!MessageTraits<RestartRequest>::encode(ostream, message.type.restart_request))
+					return false;
+				break;
+			case 30:
+				if(!MessageTraits<DiagnosticsRequest>::encode(ostream, message.type.diagnostics_request))
+					return false;
+				break;
+			case 31:
+				if(!MessageTraits<BulkExportRequest>::encode(ostream, message.type.bulk_export_request))
+					return false;
+				break;
+			case 32:
+				if(!MessageTraits<PullNewDataRequest>::encode(ostream, message.type.pull_new_data_request))
+					return false;
+				break;
+			case 33:
+				if(!MessageTraits<AcknowledgeDataRequest>::encode(ostream, message.type.acknowledge_data_request))
+					return false;
+				break;
+			case 34:
+				if(!MessageTraits<SetCompressionRequest>::encode(ostream, message.type.set_compression_request))
+					return false;
+				break;
+			case 35:
+				if(!MessageTraits<SetOverflowPolicyRequest>::encode(ostream, message.type.set_overflow_policy_request))
+					return false;
+				break;
+			default:
+				return false;
+		}
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, Request& message) {
+		if(!istream.read(message.which_type))
+			return false;
+		switch(message.which_type) {
+			case 1:
+				if(!MessageTraits<StatusRequest>::decode(istream, message.type.status_request))
+					return false;
+				break;
+			case 2:
+				if(!MessageTraits<StartMicrophoneRequest>::decode(istream, message.type.start_microphone_request))
+					return false;
+				break;
+			case 3:
+				if(!MessageTraits<StopMicrophoneRequest>::decode(istream, message.type.stop_microphone_request))
+					return false;
+				break;
+			case 4:
+				if(!MessageTraits<StartScanRequest>::decode(istream, message.type.start_scan_request))
+					return false;
+				break;
+			case 5:
+				if(!MessageTraits<StopScanRequest>::decode(istream, message.type.stop_scan_request))
+					return false;
+				break;
+			case 6:
+				if(!MessageTraits<StartAccelerometerRequest>::decode(istream, message.type.start_accelerometer_request))
+					return false;
+				break;
+			case 7:
+				if(!MessageTraits<StopAccelerometerRequest>::decode(istream, message.type.stop_accelerometer_request))
+					return false;
+				break;
+			case 8:
+				if(!MessageTraits<StartAccelerometerInterruptRequest>::decode(istream, message.type.start_accelerometer_interrupt_request))
+					return false;
+				break;
+			case 9:
+				if(!MessageTraits<StopAccelerometerInterruptRequest>::decode(istream, message.type.stop_accelerometer_interrupt_request))
+					return false;
+				break;
+			case 10:
+				if(!MessageTraits<StartBatteryRequest>::decode(istream, message.type.start_battery_request))
+					return false;
+				break;
+			case 11:
+				if(!MessageTraits<StopBatteryRequest>::decode(istream, message.type.stop_battery_request))
+					return false;
+				break;
+			case 12:
+				if(!MessageTraits<MicrophoneDataRequest>::decode(istream, message.type.microphone_data_request))
+					return false;
+				break;
+			case 13:
+				if(!MessageTraits<ScanDataRequest>::decode(istream, message.type.scan_data_request))
+					return false;
+				break;
+			case 14:
+				if(!MessageTraits<AccelerometerDataRequest>::decode(istream, message.type.accelerometer_data_request))
+					return false;
+				break;
+			case 15:
+				if(!MessageTraits<AccelerometerInterruptDataRequest>::decode(istream, message.type.accelerometer_interrupt_data_request))
+					return false;
+				break;
+			case 16:
+				if(!MessageTraits<BatteryDataRequest>::decode(istream, message.type.battery_data_request))
+					return false;
+				break;
+			case 17:
+				if(!MessageTraits<StartMicrophoneStreamRequest>::decode(istream, message.type.start_microphone_stream_request))
+					return false;
+				break;
+			case 18:
+				if(!MessageTraits<StopMicrophoneStreamRequest>::decode(istream, message.type.stop_microphone_stream_request))
+					return false;
+				break;
+			case 19:
+				if(!MessageTraits<StartScanStreamRequest>::decode(istream, message.type.start_scan_stream_request))
+					return false;
+				break;
+			case 20:
+				if(!MessageTraits<StopScanStreamRequest>::decode(istream, message.type.stop_scan_stream_request))
+					return false;
+				break;
+			case 21:
+				if(!MessageTraits<StartAccelerometerStreamRequest>::decode(istream, message.type.start_accelerometer_stream_request))
+					return false;
+				break;
+			case 22:
+				if(!MessageTraits<StopAccelerometerStreamRequest>::decode(istream, message.type.stop_accelerometer_stream_request))
+					return false;
+				break;
+			case 23:
+				if(!MessageTraits<StartAccelerometerInterruptStreamRequest>::decode(istream, message.type.start_accelerometer_interrupt_stream_request))
+					return false;
+				break;
+			case 24:
+				if(!MessageTraits<StopAccelerometerInterruptStreamRequest>::decode(istream, message.type.stop_accelerometer_interrupt_stream_request))
+					return false;
+				break;
+			case 25:
+				if(!MessageTraits<StartBatteryStreamRequest>::decode(istream, message.type.start_battery_stream_request))
+					return false;
+				break;
+			case 26:
+				if(!MessageTraits<StopBatteryStreamRequest>::decode(istream, message.type.stop_battery_stream_request))
+					return false;
+				break;
+			case 27:
+				if(!MessageTraits<IdentifyRequest>::decode(istream, message.type.identify_request))
+					return false;
+				break;
+			case 28:
+				if(!MessageTraits<TestRequest>::decode(istream, message.type.test_request))
+					return false;
+				break;
+			case 29:
+				if(!MessageTraits<RestartRequest>::decode(istream, message.type.restart_request))
+					return false;
+				break;
+			case 30:
+				if(!MessageTraits<DiagnosticsRequest>::decode(istream, message.type.diagnostics_request))
+					return false;
+				break;
+			case 31:
+				if(!MessageTraits<BulkExportRequest>::decode(istream, message.type.bulk_export_request))
+					return false;
+				break;
+			case 32:
+				if(!MessageTraits<PullNewDataRequest>::decode(istream, message.type.pull_new_data_request))
+					return false;
+				break;
+			case 33:
+				if(!MessageTraits<AcknowledgeDataRequest>::decode(istream, message.type.acknowledge_data_request))
+					return false;
+				break;
+			case 34:
+				if(!MessageTraits<SetCompressionRequest>::decode(istream, message.type.set_compression_request))
+					return false;
+				break;
+			case 35:
+				if(!MessageTraits<SetOverflowPolicyRequest>::decode(istream, message.type.set_overflow_policy_request))
+					return false;
+				break;
+			default:
+				return false;
+		}
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const Request& message) {
+		visitor.begin_oneof("type", message.which_type);
+		visitor.oneof_member("status_request", message.which_type == 1, message.type.status_request);
+		visitor.oneof_member("start_microphone_request", message.which_type == 2, message.type.start_microphone_request);
+		visitor.oneof_member("stop_microphone_request", message.which_type == 3, message.type.stop_microphone_request);
+		visitor.oneof_member("start_scan_request", message.which_type == 4, message.type.start_scan_request);
+		visitor.oneof_member("stop_scan_request", message.which_type == 5, message.type.stop_scan_request);
+		visitor.oneof_member("start_accelerometer_request", message.which_type == 6, message.type.start_accelerometer_request);
+		visitor.oneof_member("stop_accelerometer_request", message.which_type == 7, message.type.stop_accelerometer_request);
+		visitor.oneof_member("start_accelerometer_interrupt_request", message.which_type == 8, message.type.start_accelerometer_interrupt_request);
+		visitor.oneof_member("stop_accelerometer_interrupt_request", message.which_type == 9, message.type.stop_accelerometer_interrupt_request);
+		visitor.oneof_member("start_battery_request", message.which_type == 10, message.type.start_battery_request);
+		visitor.oneof_member("stop_battery_request", message.which_type == 11, message.type.stop_battery_request);
+		visitor.oneof_member("microphone_data_request", message.which_type == 12, message.type.microphone_data_request);
+		visitor.oneof_member("scan_data_request", message.which_type == 13, message.type.scan_data_request);
+		visitor.oneof_member("accelerometer_data_request", message.which_type == 14, message.type.accelerometer_data_request);
+		visitor.oneof_member("accelerometer_interrupt_data_request", message.which_type == 15, message.type.accelerometer_interrupt_data_request);
+		visitor.oneof_member("battery_data_request", message.which_type == 16, message.type.battery_data_request);
+		visitor.oneof_member("start_microphone_stream_request", message.which_type == 17, message.type.start_microphone_stream_request);
+		visitor.oneof_member("stop_microphone_stream_request", message.which_type == 18, message.type.stop_microphone_stream_request);
+		visitor.oneof_member("start_scan_stream_request", message.which_type == 19, message.type.start_scan_stream_request);
+		visitor.oneof_member("stop_scan_stream_request", message.which_type == 20, message.type.stop_scan_stream_request);
+		visitor.oneof_member("start_accelerometer_stream_request", message.which_type == 21, message.type.start_accelerometer_stream_request);
+		visitor.oneof_member("stop_accelerometer_stream_request", message.which_type == 22, message.type.stop_accelerometer_stream_request);
+		visitor.oneof_member("start_accelerometer_interrupt_stream_request", message.which_type == 23, message.type.start_accelerometer_interrupt_stream_request);
+		visitor.oneof_member("stop_accelerometer_interrupt_stream_request", message.which_type == 24, message.type.stop_accelerometer_interrupt_stream_request);
+		visitor.oneof_member("start_battery_stream_request", message.which_type == 25, message.type.start_battery_stream_request);
+		visitor.oneof_member("stop_battery_stream_request", message.which_type == 26, message.type.stop_battery_stream_request);
+		visitor.oneof_member("identify_request", message.which_type == 27, message.type.identify_request);
+		visitor.oneof_member("test_request", message.which_type == 28, message.type.test_request);
+		visitor.oneof_member("restart_request", message.which_type == 29, message.type.restart_request);
+		visitor.oneof_member("diagnostics_request", message.which_type == 30, message.type.diagnostics_request);
+		visitor.oneof_member("bulk_export_request", message.which_type == 31, message.type.bulk_export_request);
+		visitor.oneof_member("pull_new_data_request", message.which_type == 32, message.type.pull_new_data_request);
+		visitor.oneof_member("acknowledge_data_request", message.which_type == 33, message.type.acknowledge_data_request);
+		visitor.oneof_member("set_compression_request", message.which_type == 34, message.type.set_compression_request);
+		visitor.oneof_member("set_overflow_policy_request", message.which_type == 35, message.type.set_overflow_policy_request);
+		visitor.end_oneof();
+	}
+};
+
+typedef struct {
+	uint8_t clock_status;
+	uint8_t microphone_status;
+	uint8_t scan_status;
+	uint8_t accelerometer_status;
+	uint8_t accelerometer_interrupt_status;
+	uint8_t battery_status;
+	Timestamp timestamp;
+	BatteryData battery_data;
+	uint16_t dropped_chunks;
+} StatusResponse;
+
+template<>
+struct MessageTraits<StatusResponse> {
+	static constexpr const char* name() { return "StatusResponse"; }
+	static constexpr uint32_t max_encoded_len() { return 1 + 1 + 1 + 1 + 1 + 1 + MessageTraits<Timestamp>::max_encoded_len() + MessageTraits<BatteryData>::max_encoded_len() + 2; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StatusResponse& message) {
+		if(!ostream.write(message.clock_status))
+			return false;
+		if(!ostream.write(message.microphone_status))
+			return false;
+		if(!ostream.write(message.scan_status))
+			return false;
+		if(!ostream.write(message.accelerometer_status))
+			return false;
+		if(!ostream.write(message.accelerometer_interrupt_status))
+			return false;
+		if(!ostream.write(message.battery_status))
+			return false;
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!MessageTraits<BatteryData>::encode(ostream, message.battery_data))
+			return false;
+		if(!ostream.write(message.dropped_chunks))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StatusResponse& message) {
+		if(!istream.read(message.clock_status))
+			return false;
+		if(!istream.read(message.microphone_status))
+			return false;
+		if(!istream.read(message.scan_status))
+			return false;
+		if(!istream.read(message.accelerometer_status))
+			return false;
+		if(!istream.read(message.accelerometer_interrupt_status))
+			return false;
+		if(!istream.read(message.battery_status))
+			return false;
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!MessageTraits<BatteryData>::decode(istream, message.battery_data))
+			return false;
+		if(!istream.read(message.dropped_chunks))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StatusResponse& message) {
+		visitor.field("clock_status", message.clock_status);
+		visitor.field("microphone_status", message.microphone_status);
+		visitor.field("scan_status", message.scan_status);
+		visitor.field("accelerometer_status", message.accelerometer_status);
+		visitor.field("accelerometer_interrupt_status", message.accelerometer_interrupt_status);
+		visitor.field("battery_status", message.battery_status);
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("battery_data", message.battery_data);
+		visitor.field("dropped_chunks", message.dropped_chunks);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+} StartMicrophoneResponse;
+
+template<>
+struct MessageTraits<StartMicrophoneResponse> {
+	static constexpr const char* name() { return "StartMicrophoneResponse"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartMicrophoneResponse& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartMicrophoneResponse& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartMicrophoneResponse& message) {
+		visitor.field("timestamp", message.timestamp);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+} StartScanResponse;
+
+template<>
+struct MessageTraits<StartScanResponse> {
+	static constexpr const char* name() { return "StartScanResponse"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartScanResponse& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartScanResponse& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartScanResponse& message) {
+		visitor.field("timestamp", message.timestamp);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+} StartAccelerometerResponse;
+
+template<>
+struct MessageTraits<StartAccelerometerResponse> {
+	static constexpr const char* name() { return "StartAccelerometerResponse"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartAccelerometerResponse& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartAccelerometerResponse& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartAccelerometerResponse& message) {
+		visitor.field("timestamp", message.timestamp);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+} StartAccelerometerInterruptResponse;
+
+template<>
+struct MessageTraits<StartAccelerometerInterruptResponse> {
+	static constexpr const char* name() { return "StartAccelerometerInterruptResponse"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartAccelerometerInterruptResponse& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartAccelerometerInterruptResponse& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartAccelerometerInterruptResponse& message) {
+		visitor.field("timestamp", message.timestamp);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+} StartBatteryResponse;
+
+template<>
+struct MessageTraits<StartBatteryResponse> {
+	static constexpr const char* name() { return "StartBatteryResponse"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StartBatteryResponse& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StartBatteryResponse& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StartBatteryResponse& message) {
+		visitor.field("timestamp", message.timestamp);
+	}
+};
+
+typedef struct {
+	uint8_t last_response;
+	Timestamp timestamp;
+	uint16_t sample_period_ms;
+	uint8_t microphone_data_count;
+	MicrophoneData microphone_data[114];
+} MicrophoneDataResponse;
+
+template<>
+struct MessageTraits<MicrophoneDataResponse> {
+	static constexpr const char* name() { return "MicrophoneDataResponse"; }
+	static constexpr uint32_t max_encoded_len() { return 1 + MessageTraits<Timestamp>::max_encoded_len() + 2 + 1 + 114*MessageTraits<MicrophoneData>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const MicrophoneDataResponse& message) {
+		if(!ostream.write(message.last_response))
+			return false;
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!ostream.write(message.sample_period_ms))
+			return false;
+		if(message.microphone_data_count > 114)
+			return false;
+		if(!ostream.write(message.microphone_data_count))
+			return false;
+		for(uint32_t i = 0; i < message.microphone_data_count; i++)
+			if(!MessageTraits<MicrophoneData>::encode(ostream, message.microphone_data[i]))
+				return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, MicrophoneDataResponse& message) {
+		if(!istream.read(message.last_response))
+			return false;
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.sample_period_ms))
+			return false;
+		if(!istream.read(message.microphone_data_count))
+			return false;
+		if(message.microphone_data_count > 114)
+			return false;
+		for(uint32_t i = 0; i < message.microphone_data_count; i++)
+			if(!MessageTraits<MicrophoneData>::decode(istream, message.microphone_data[i]))
+				return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const MicrophoneDataResponse& message) {
+		visitor.field("last_response", message.last_response);
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("sample_period_ms", message.sample_period_ms);
+		visitor.repeated("microphone_data", message.microphone_data, (uint32_t) message.microphone_data_count);
+	}
+};
+
+typedef struct {
+	uint8_t last_response;
+	Timestamp timestamp;
+	uint8_t scan_result_data_count;
+	ScanResultData scan_result_data[29];
+} ScanDataResponse;
+
+template<>
+struct MessageTraits<ScanDataResponse> {
+	static constexpr const char* name() { return "ScanDataResponse"; }
+	static constexpr uint32_t max_encoded_len() { return 1 + MessageTraits<Timestamp>::max_encoded_len() + 1 + 29*MessageTraits<ScanResultData>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const ScanDataResponse& message) {
+		if(!ostream.write(message.last_response))
+			return false;
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(message.scan_result_data_count > 29)
+			return false;
+		if(!ostream.write(message.scan_result_data_count))
+			return false;
+		for(uint32_t i = 0; i < message.scan_result_data_count; i++)
+			if(!MessageTraits<ScanResultData>::encode(ostream, message.scan_result_data[i]))
+				return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, ScanDataResponse& message) {
+		if(!istream.read(message.last_response))
+			return false;
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.scan_result_data_count))
+			return false;
+		if(message.scan_result_data_count > 29)
+			return false;
+		for(uint32_t i = 0; i < message.scan_result_data_count; i++)
+			if(!MessageTraits<ScanResultData>::decode(istream, message.scan_result_data[i]))
+				return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const ScanDataResponse& message) {
+		visitor.field("last_response", message.last_response);
+		visitor.field("timestamp", message.timestamp);
+		visitor.repeated("scan_result_data", message.scan_result_data, (uint32_t) message.scan_result_data_count);
+	}
+};
+
+typedef struct {
+	uint8_t last_response;
+	Timestamp timestamp;
+	uint8_t accelerometer_data_count;
+	AccelerometerData accelerometer_data[100];
+} AccelerometerDataResponse;
+
+template<>
+struct MessageTraits<AccelerometerDataResponse> {
+	static constexpr const char* name() { return "AccelerometerDataResponse"; }
+	static constexpr uint32_t max_encoded_len() { return 1 + MessageTraits<Timestamp>::max_encoded_len() + 1 + 100*MessageTraits<AccelerometerData>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const AccelerometerDataResponse& message) {
+		if(!ostream.write(message.last_response))
+			return false;
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(message.accelerometer_data_count > 100)
+			return false;
+		if(!ostream.write(message.accelerometer_data_count))
+			return false;
+		for(uint32_t i = 0; i < message.accelerometer_data_count; i++)
+			if(!MessageTraits<AccelerometerData>::encode(ostream, message.accelerometer_data[i]))
+				return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, AccelerometerDataResponse& message) {
+		if(!istream.read(message.last_response))
+			return false;
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.accelerometer_data_count))
+			return false;
+		if(message.accelerometer_data_count > 100)
+			return false;
+		for(uint32_t i = 0; i < message.accelerometer_data_count; i++)
+			if(!MessageTraits<AccelerometerData>::decode(istream, message.accelerometer_data[i]))
+				return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const AccelerometerDataResponse& message) {
+		visitor.field("last_response", message.last_response);
+		visitor.field("timestamp", message.timestamp);
+		visitor.repeated("accelerometer_data", message.accelerometer_data, (uint32_t) message.accelerometer_data_count);
+	}
+};
+
+typedef struct {
+	uint8_t last_response;
+	Timestamp timestamp;
+} AccelerometerInterruptDataResponse;
+
+template<>
+struct MessageTraits<AccelerometerInterruptDataResponse> {
+	static constexpr const char* name() { return "AccelerometerInterruptDataResponse"; }
+	static constexpr uint32_t max_encoded_len() { return 1 + MessageTraits<Timestamp>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const AccelerometerInterruptDataResponse& message) {
+		if(!ostream.write(message.last_response))
+			return false;
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, AccelerometerInterruptDataResponse& message) {
+		if(!istream.read(message.last_response))
+			return false;
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const AccelerometerInterruptDataResponse& message) {
+		visitor.field("last_response", message.last_response);
+		visitor.field("timestamp", message.timestamp);
+	}
+};
+
+typedef struct {
+	uint8_t last_response;
+	Timestamp timestamp;
+	BatteryData battery_data;
+} BatteryDataResponse;
+
+template<>
+struct MessageTraits<BatteryDataResponse> {
+	static constexpr const char* name() { return "BatteryDataResponse"; }
+	static constexpr uint32_t max_encoded_len() { return 1 + MessageTraits<Timestamp>::max_encoded_len() + MessageTraits<BatteryData>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const BatteryDataResponse& message) {
+		if(!ostream.write(message.last_response))
+			return false;
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(!MessageTraits<BatteryData>::encode(ostream, message.battery_data))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, BatteryDataResponse& message) {
+		if(!istream.read(message.last_response))
+			return false;
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!MessageTraits<BatteryData>::decode(istream, message.battery_data))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const BatteryDataResponse& message) {
+		visitor.field("last_response", message.last_response);
+		visitor.field("timestamp", message.timestamp);
+		visitor.field("battery_data", message.battery_data);
+	}
+};
+
+typedef struct {
+	uint8_t last_response;
+	ExportCursor cursor;
+} BulkExportCheckpointResponse;
+
+template<>
+struct MessageTraits<BulkExportCheckpointResponse> {
+	static constexpr const char* name() { return "BulkExportCheckpointResponse"; }
+	static constexpr uint32_t max_encoded_len() { return 1 + MessageTraits<ExportCursor>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const BulkExportCheckpointResponse& message) {
+		if(!ostream.write(message.last_response))
+			return false;
+		if(!MessageTraits<ExportCursor>::encode(ostream, message.cursor))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, BulkExportCheckpointResponse& message) {
+		if(!istream.read(message.last_response))
+			return false;
+		if(!MessageTraits<ExportCursor>::decode(istream, message.cursor))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const BulkExportCheckpointResponse& message) {
+		visitor.field("last_response", message.last_response);
+		visitor.field("cursor", message.cursor);
+	}
+};
+
+typedef struct {
+	uint8_t compression;
+} SetCompressionResponse;
+
+template<>
+struct MessageTraits<SetCompressionResponse> {
+	static constexpr const char* name() { return "SetCompressionResponse"; }
+	static constexpr uint32_t max_encoded_len() { return 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const SetCompressionResponse& message) {
+		if(!ostream.write(message.compression))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, SetCompressionResponse& message) {
+		if(!istream.read(message.compression))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const SetCompressionResponse& message) {
+		visitor.field("compression", message.compression);
+	}
+};
+
+typedef struct {
+	uint8_t overflow_policy;
+} SetOverflowPolicyResponse;
+
+template<>
+struct MessageTraits<SetOverflowPolicyResponse> {
+	static constexpr const char* name() { return "SetOverflowPolicyResponse"; }
+	static constexpr uint32_t max_encoded_len() { return 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const SetOverflowPolicyResponse& message) {
+		if(!ostream.write(message.overflow_policy))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, SetOverflowPolicyResponse& message) {
+		if(!istream.read(message.overflow_policy))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const SetOverflowPolicyResponse& message) {
+		visitor.field("overflow_policy", message.overflow_policy);
+	}
+};
+
+typedef struct {
+	Timestamp timestamp;
+	uint8_t battery_stream_count;
+	BatteryStream battery_stream[10];
+	uint8_t microphone_stream_count;
+	MicrophoneStream microphone_stream[10];
+	uint8_t scan_stream_count;
+	ScanStream scan_stream[10];
+	uint8_t accelerometer_stream_count;
+	AccelerometerStream accelerometer_stream[10];
+	uint8_t accelerometer_interrupt_stream_count;
+	AccelerometerInterruptStream accelerometer_interrupt_stream[10];
+} StreamResponse;
+
+template<>
+struct MessageTraits<StreamResponse> {
+	static constexpr const char* name() { return "StreamResponse"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<Timestamp>::max_encoded_len() + 1 + 10*MessageTraits<BatteryStream>::max_encoded_len() + 1 + 10*MessageTraits<MicrophoneStream>::max_encoded_len() + 1 + 10*MessageTraits<ScanStream>::max_encoded_len() + 1 + 10*MessageTraits<AccelerometerStream>::max_encoded_len() + 1 + 10*MessageTraits<AccelerometerInterruptStream>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const StreamResponse& message) {
+		if(!MessageTraits<Timestamp>::encode(ostream, message.timestamp))
+			return false;
+		if(message.battery_stream_count > 10)
+			return false;
+		if(!ostream.write(message.battery_stream_count))
+			return false;
+		for(uint32_t i = 0; i < message.battery_stream_count; i++)
+			if(!MessageTraits<BatteryStream>::encode(ostream, message.battery_stream[i]))
+				return false;
+		if(message.microphone_stream_count > 10)
+			return false;
+		if(!ostream.write(message.microphone_stream_count))
+			return false;
+		for(uint32_t i = 0; i < message.microphone_stream_count; i++)
+			if(!MessageTraits<MicrophoneStream>::encode(ostream, message.microphone_stream[i]))
+				return false;
+		if(message.scan_stream_count > 10)
+			return false;
+		if(!ostream.write(message.scan_stream_count))
+			return false;
+		for(uint32_t i = 0; i < message.scan_stream_count; i++)
+			if(!MessageTraits<ScanStream>::encode(ostream, message.scan_stream[i]))
+				return false;
+		if(message.accelerometer_stream_count > 10)
+			return false;
+		if(!ostream.write(message.accelerometer_stream_count))
+			return false;
+		for(uint32_t i = 0; i < message.accelerometer_stream_count; i++)
+			if(!MessageTraits<AccelerometerStream>::encode(ostream, message.accelerometer_stream[i]))
+				return false;
+		if(message.accelerometer_interrupt_stream_count > 10)
+			return false;
+		if(!ostream.write(message.accelerometer_interrupt_stream_count))
+			return false;
+		for(uint32_t i = 0; i < message.accelerometer_interrupt_stream_count; i++)
+			if(!MessageTraits<AccelerometerInterruptStream>::encode(ostream, message.accelerometer_interrupt_stream[i]))
+				return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, StreamResponse& message) {
+		if(!MessageTraits<Timestamp>::decode(istream, message.timestamp))
+			return false;
+		if(!istream.read(message.battery_stream_count))
+			return false;
+		if(message.battery_stream_count > 10)
+			return false;
+		for(uint32_t i = 0; i < message.battery_stream_count; i++)
+			if(!MessageTraits<BatteryStream>::decode(istream, message.battery_stream[i]))
+				return false;
+		if(!istream.read(message.microphone_stream_count))
+			return false;
+		if(message.microphone_stream_count > 10)
+			return false;
+		for(uint32_t i = 0; i < message.microphone_stream_count; i++)
+			if(!MessageTraits<MicrophoneStream>::decode(istream, message.microphone_stream[i]))
+				return false;
+		if(!istream.read(message.scan_stream_count))
+			return false;
+		if(message.scan_stream_count > 10)
+			return false;
+		for(uint32_t i = 0; i < message.scan_stream_count; i++)
+			if(!MessageTraits<ScanStream>::decode(istream, message.scan_stream[i]))
+				return false;
+		if(!istream.read(message.accelerometer_stream_count))
+			return false;
+		if(message.accelerometer_stream_count > 10)
+			return false;
+		for(uint32_t i = 0; i < message.accelerometer_stream_count; i++)
+			if(!MessageTraits<AccelerometerStream>::decode(istream, message.accelerometer_stream[i]))
+				return false;
+		if(!istream.read(message.accelerometer_interrupt_stream_count))
+			return false;
+		if(message.accelerometer_interrupt_stream_count > 10)
+			return false;
+		for(uint32_t i = 0; i < message.accelerometer_interrupt_stream_count; i++)
+			if(!MessageTraits<AccelerometerInterruptStream>::decode(istream, message.accelerometer_interrupt_stream[i]))
+				return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const StreamResponse& message) {
+		visitor.field("timestamp", message.timestamp);
+		visitor.repeated("battery_stream", message.battery_stream, (uint32_t) message.battery_stream_count);
+		visitor.repeated("microphone_stream", message.microphone_stream, (uint32_t) message.microphone_stream_count);
+		visitor.repeated("scan_stream", message.scan_stream, (uint32_t) message.scan_stream_count);
+		visitor.repeated("accelerometer_stream", message.accelerometer_stream, (uint32_t) message.accelerometer_stream_count);
+		visitor.repeated("accelerometer_interrupt_stream", message.accelerometer_interrupt_stream, (uint32_t) message.accelerometer_interrupt_stream_count);
+	}
+};
+
+typedef struct {
+	uint8_t test_failed;
+} TestResponse;
+
+template<>
+struct MessageTraits<TestResponse> {
+	static constexpr const char* name() { return "TestResponse"; }
+	static constexpr uint32_t max_encoded_len() { return 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const TestResponse& message) {
+		if(!ostream.write(message.test_failed))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, TestResponse& message) {
+		if(!istream.read(message.test_failed))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const TestResponse& message) {
+		visitor.field("test_failed", message.test_failed);
+	}
+};
+
+typedef struct {
+	uint16_t dropped_chunks;
+	uint8_t high_water_mark;
+	uint8_t capacity;
+} ChunkFifoStatus;
+
+template<>
+struct MessageTraits<ChunkFifoStatus> {
+	static constexpr const char* name() { return "ChunkFifoStatus"; }
+	static constexpr uint32_t max_encoded_len() { return 2 + 1 + 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const ChunkFifoStatus& message) {
+		if(!ostream.write(message.dropped_chunks))
+			return false;
+		if(!ostream.write(message.high_water_mark))
+			return false;
+		if(!ostream.write(message.capacity))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, ChunkFifoStatus& message) {
+		if(!istream.read(message.dropped_chunks))
+			return false;
+		if(!istream.read(message.high_water_mark))
+			return false;
+		if(!istream.read(message.capacity))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const ChunkFifoStatus& message) {
+		visitor.field("dropped_chunks", message.dropped_chunks);
+		visitor.field("high_water_mark", message.high_water_mark);
+		visitor.field("capacity", message.capacity);
+	}
+};
+
+typedef struct {
+	ChunkFifoStatus microphone_chunk_fifo_status;
+	ChunkFifoStatus scan_chunk_fifo_status;
+	ChunkFifoStatus accelerometer_chunk_fifo_status;
+	ChunkFifoStatus accelerometer_interrupt_chunk_fifo_status;
+	ChunkFifoStatus battery_chunk_fifo_status;
+} DiagnosticsResponse;
+
+template<>
+struct MessageTraits<DiagnosticsResponse> {
+	static constexpr const char* name() { return "DiagnosticsResponse"; }
+	static constexpr uint32_t max_encoded_len() { return MessageTraits<ChunkFifoStatus>::max_encoded_len() + MessageTraits<ChunkFifoStatus>::max_encoded_len() + MessageTraits<ChunkFifoStatus>::max_encoded_len() + MessageTraits<ChunkFifoStatus>::max_encoded_len() + MessageTraits<ChunkFifoStatus>::max_encoded_len(); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const DiagnosticsResponse& message) {
+		if(!MessageTraits<ChunkFifoStatus>::encode(ostream, message.microphone_chunk_fifo_status))
+			return false;
+		if(!MessageTraits<ChunkFifoStatus>::encode(ostream, message.scan_chunk_fifo_status))
+			return false;
+		if(!MessageTraits<ChunkFifoStatus>::encode(ostream, message.accelerometer_chunk_fifo_status))
+			return false;
+		if(!MessageTraits<ChunkFifoStatus>::encode(ostream, message.accelerometer_interrupt_chunk_fifo_status))
+			return false;
+		if(!MessageTraits<ChunkFifoStatus>::encode(ostream, message.battery_chunk_fifo_status))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, DiagnosticsResponse& message) {
+		if(!MessageTraits<ChunkFifoStatus>::decode(istream, message.microphone_chunk_fifo_status))
+			return false;
+		if(!MessageTraits<ChunkFifoStatus>::decode(istream, message.scan_chunk_fifo_status))
+			return false;
+		if(!MessageTraits<ChunkFifoStatus>::decode(istream, message.accelerometer_chunk_fifo_status))
+			return false;
+		if(!MessageTraits<ChunkFifoStatus>::decode(istream, message.accelerometer_interrupt_chunk_fifo_status))
+			return false;
+		if(!MessageTraits<ChunkFifoStatus>::decode(istream, message.battery_chunk_fifo_status))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const DiagnosticsResponse& message) {
+		visitor.field("microphone_chunk_fifo_status", message.microphone_chunk_fifo_status);
+		visitor.field("scan_chunk_fifo_status", message.scan_chunk_fifo_status);
+		visitor.field("accelerometer_chunk_fifo_status", message.accelerometer_chunk_fifo_status);
+		visitor.field("accelerometer_interrupt_chunk_fifo_status", message.accelerometer_interrupt_chunk_fifo_status);
+		visitor.field("battery_chunk_fifo_status", message.battery_chunk_fifo_status);
+	}
+};
+
+typedef struct {
+	uint8_t which_type;
+	union {
+		StatusResponse status_response;
+		StartMicrophoneResponse start_microphone_response;
+		StartScanResponse start_scan_response;
+		StartAccelerometerResponse start_accelerometer_response;
+		StartAccelerometerInterruptResponse start_accelerometer_interrupt_response;
+		StartBatteryResponse start_battery_response;
+		MicrophoneDataResponse microphone_data_response;
+		ScanDataResponse scan_data_response;
+		AccelerometerDataResponse accelerometer_data_response;
+		AccelerometerInterruptDataResponse accelerometer_interrupt_data_response;
+		BatteryDataResponse battery_data_response;
+		StreamResponse stream_response;
+		TestResponse test_response;
+		DiagnosticsResponse diagnostics_response;
+		BulkExportCheckpointResponse bulk_export_checkpoint_response;
+		SetCompressionResponse set_compression_response;
+		SetOverflowPolicyResponse set_overflow_policy_response;
+	} type;
+} Response;
+
+template<>
+struct MessageTraits<Response> {
+	static constexpr const char* name() { return "Response"; }
+	static constexpr uint32_t max_encoded_len() { return 1 + max_len(MessageTraits<StatusResponse>::max_encoded_len(), max_len(MessageTraits<StartMicrophoneResponse>::max_encoded_len(), max_len(MessageTraits<StartScanResponse>::max_encoded_len(), max_len(MessageTraits<StartAccelerometerResponse>::max_encoded_len(), max_len(MessageTraits<StartAccelerometerInterruptResponse>::max_encoded_len(), max_len(MessageTraits<StartBatteryResponse>::max_encoded_len(), max_len(MessageTraits<MicrophoneDataResponse>::max_encoded_len(), max_len(MessageTraits<ScanDataResponse>::max_encoded_len(), max_len(MessageTraits<AccelerometerDataResponse>::max_encoded_len(), max_len(MessageTraits<AccelerometerInterruptDataResponse>::max_encoded_len(), max_len(MessageTraits<BatteryDataResponse>::max_encoded_len(), max_len(MessageTraits<StreamResponse>::max_encoded_len(), max_len(MessageTraits<TestResponse>::max_encoded_len(), max_len(MessageTraits<DiagnosticsResponse>::max_encoded_len(), max_len(MessageTraits<BulkExportCheckpointResponse>::max_encoded_len(), max_len(MessageTraits<SetCompressionResponse>::max_encoded_len(), MessageTraits<SetOverflowPolicyResponse>::max_encoded_len())))))))))))))))); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const Response& message) {
+		if(!ostream.write(message.which_type))
+			return false;
+		switch(message.which_type) {
+			case 1:
+				if(!MessageTraits<StatusResponse>::encode(ostream, message.type.status_response))
+					return false;
+				break;
+			case 2:
+				if(!MessageTraits<StartMicrophoneResponse>::encode(ostream, message.type.start_microphone_response))
+					return false;
+				break;
+			case 3:
+				if(!MessageTraits<StartScanResponse>::encode(ostream, message.type.start_scan_response))
+					return false;
+				break;
+			case 4:
+				if(!MessageTraits<StartAccelerometerResponse>::encode(ostream, message.type.start_accelerometer_response))
+					return false;
+				break;
+			case 5:
+				if(!MessageTraits<StartAccelerometerInterruptResponse>::encode(ostream, message.type.start_accelerometer_interrupt_response))
+					return false;
+				break;
+			case 6:
+				if(!MessageTraits<StartBatteryResponse>::encode(ostream, message.type.start_battery_response))
+					return false;
+				break;
+			case 7:
+				if(!MessageTraits<MicrophoneDataResponse>::encode(ostream, message.type.microphone_data_response))
+					return false;
+				break;
+			case 8:
+				if(!MessageTraits<ScanDataResponse>::encode(ostream, message.type.scan_data_response))
+					return false;
+				break;
+			case 9:
+				if(!MessageTraits<AccelerometerDataResponse>::encode(ostream, message.type.accelerometer_data_response))
+					return false;
+				break;
+			case 10:
+				if(!MessageTraits<AccelerometerInterruptDataResponse>::encode(ostream, message.type.accelerometer_interrupt_data_response))
+					return false;
+				break;
+			case 11:
+				if(!MessageTraits<BatteryDataResponse>::encode(ostream, message.type.battery_data_response))
+					return false;
+				break;
+			case 12:
+				if(!MessageTraits<StreamResponse>::encode(ostream, message.type.stream_response))
+					return false;
+				break;
+			case 13:
+				if(!MessageTraits<TestResponse>::encode(ostream, message.type.test_response))
+					return false;
+				break;
+			case 14:
+				if(!MessageTraits<DiagnosticsResponse>::encode(ostream, message.type.diagnostics_response))
+					return false;
+				break;
+			case 15:
+				if(!MessageTraits<BulkExportCheckpointResponse>::encode(ostream, message.type.bulk_export_checkpoint_response))
+					return false;
+				break;
+			case 16:
+				if(!MessageTraits<SetCompressionResponse>::encode(ostream, message.type.set_compression_response))
+					return false;
+				break;
+			case 17:
+				if(!MessageTraits<SetOverflowPolicyResponse>::encode(ostream, message.type.set_overflow_policy_response))
+					return false;
+				break;
+			default:
+				return false;
+		}
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, Response& message) {
+		if(!istream.read(message.which_type))
+			return false;
+		switch(message.which_type) {
+			case 1:
+				if(!MessageTraits<StatusResponse>::decode(istream, message.type.status_response))
+					return false;
+				break;
+			case 2:
+				if(!MessageTraits<StartMicrophoneResponse>::decode(istream, message.type.start_microphone_response))
+					return false;
+				break;
+			case 3:
+				if(!MessageTraits<StartScanResponse>::decode(istream, message.type.start_scan_response))
+					return false;
+				break;
+			case 4:
+				if(!MessageTraits<StartAccelerometerResponse>::decode(istream, message.type.start_accelerometer_response))
+					return false;
+				break;
+			case 5:
+				if(!MessageTraits<StartAccelerometerInterruptResponse>::decode(istream, message.type.start_accelerometer_interrupt_response))
+					return false;
+				break;
+			case 6:
+				if(!MessageTraits<StartBatteryResponse>::decode(istream, message.type.start_battery_response))
+					return false;
+				break;
+			case 7:
+				if(!MessageTraits<MicrophoneDataResponse>::decode(istream, message.type.microphone_data_response))
+					return false;
+				break;
+			case 8:
+				if(!MessageTraits<ScanDataResponse>::decode(istream, message.type.scan_data_response))
+					return false;
+				break;
+			case 9:
+				if(!MessageTraits<AccelerometerDataResponse>::decode(istream, message.type.accelerometer_data_response))
+					return false;
+				break;
+			case 10:
+				if(!MessageTraits<AccelerometerInterruptDataResponse>::decode(istream, message.type.accelerometer_interrupt_data_response))
+					return false;
+				break;
+			case 11:
+				if(!MessageTraits<BatteryDataResponse>::decode(istream, message.type.battery_data_response))
+					return false;
+				break;
+			case 12:
+				if(!MessageTraits<StreamResponse>::decode(istream, message.type.stream_response))
+					return false;
+				break;
+			case 13:
+				if(!MessageTraits<TestResponse>::decode(istream, message.type.test_response))
+					return false;
+				break;
+			case 14:
+				if(!MessageTraits<DiagnosticsResponse>::decode(istream, message.type.diagnostics_response))
+					return false;
+				break;
+			case 15:
+				if(!MessageTraits<BulkExportCheckpointResponse>::decode(istream, message.type.bulk_export_checkpoint_response))
+					return false;
+				break;
+			case 16:
+				if(!MessageTraits<SetCompressionResponse>::decode(istream, message.type.set_compression_response))
+					return false;
+				break;
+			case 17:
+				if(!MessageTraits<SetOverflowPolicyResponse>::decode(istream, message.type.set_overflow_policy_response))
+					return false;
+				break;
+			default:
+				return false;
+		}
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const Response& message) {
+		visitor.begin_oneof("type", message.which_type);
+		visitor.oneof_member("status_response", message.which_type == 1, message.type.status_response);
+		visitor.oneof_member("start_microphone_response", message.which_type == 2, message.type.start_microphone_response);
+		visitor.oneof_member("start_scan_response", message.which_type == 3, message.type.start_scan_response);
+		visitor.oneof_member("start_accelerometer_response", message.which_type == 4, message.type.start_accelerometer_response);
+		visitor.oneof_member("start_accelerometer_interrupt_response", message.which_type == 5, message.type.start_accelerometer_interrupt_response);
+		visitor.oneof_member("start_battery_response", message.which_type == 6, message.type.start_battery_response);
+		visitor.oneof_member("microphone_data_response", message.which_type == 7, message.type.microphone_data_response);
+		visitor.oneof_member("scan_data_response", message.which_type == 8, message.type.scan_data_response);
+		visitor.oneof_member("accelerometer_data_response", message.which_type == 9, message.type.accelerometer_data_response);
+		visitor.oneof_member("accelerometer_interrupt_data_response", message.which_type == 10, message.type.accelerometer_interrupt_data_response);
+		visitor.oneof_member("battery_data_response", message.which_type == 11, message.type.battery_data_response);
+		visitor.oneof_member("stream_response", message.which_type == 12, message.type.stream_response);
+		visitor.oneof_member("test_response", message.which_type == 13, message.type.test_response);
+		visitor.oneof_member("diagnostics_response", message.which_type == 14, message.type.diagnostics_response);
+		visitor.oneof_member("bulk_export_checkpoint_response", message.which_type == 15, message.type.bulk_export_checkpoint_response);
+		visitor.oneof_member("set_compression_response", message.which_type == 16, message.type.set_compression_response);
+		visitor.oneof_member("set_overflow_policy_response", message.which_type == 17, message.type.set_overflow_policy_response);
+		visitor.end_oneof();
+	}
+};
+
+}	// namespace tinybuf
+
+#endif
@@ -3,6 +3,16 @@ import struct
 PROTOCOL_MICROPHONE_DATA_SIZE = 114
 PROTOCOL_SCAN_DATA_SIZE = 29
 PROTOCOL_ACCELEROMETER_DATA_SIZE = 100
+PROTOCOL_COMPRESSION_NONE = 0
+PROTOCOL_COMPRESSION_LZSS = 1
+PROTOCOL_DATA_SOURCE_MICROPHONE = 0
+PROTOCOL_DATA_SOURCE_SCAN = 1
+PROTOCOL_DATA_SOURCE_ACCELEROMETER = 2
+PROTOCOL_DATA_SOURCE_ACCELEROMETER_INTERRUPT = 3
+PROTOCOL_DATA_SOURCE_BATTERY = 4
+PROTOCOL_OVERFLOW_POLICY_DROP_NEWEST = 0
+PROTOCOL_OVERFLOW_POLICY_DROP_OLDEST = 1
+PROTOCOL_OVERFLOW_POLICY_DEGRADE_RATE = 2
 PROTOCOL_MICROPHONE_STREAM_SIZE = 10
 PROTOCOL_SCAN_STREAM_SIZE = 10
 PROTOCOL_ACCELEROMETER_STREAM_SIZE = 10
@@ -38,6 +48,12 @@ Request_stop_battery_stream_request_tag = 26
 Request_identify_request_tag = 27
 Request_test_request_tag = 28
 Request_restart_request_tag = 29
+Request_diagnostics_request_tag = 30
+Request_bulk_export_request_tag = 31
+Request_pull_new_data_request_tag = 32
+Request_acknowledge_data_request_tag = 33
+Request_set_compression_request_tag = 34
+Request_set_overflow_policy_request_tag = 35
 Response_status_response_tag = 1
 Response_start_microphone_response_tag = 2
 Response_start_scan_response_tag = 3
@@ -51,12 +67,31 @@ Response_accelerometer_interrupt_data_response_tag = 10
 Response_battery_data_response_tag = 11
 Response_stream_response_tag = 12
 Response_test_response_tag = 13
+Response_diagnostics_response_tag = 14
+Response_bulk_export_checkpoint_response_tag = 15
+Response_set_compression_response_tag = 16
+Response_set_overflow_policy_response_tag = 17
 
 class _Ostream:
 	def __init__(self):
 		self.buf = b''
 	def write(self, data):
 		self.buf += data
+	def write_varuint(self, value):
+		while(value >= 0x80):
+			self.buf += struct.pack('B', (value & 0x7F) | 0x80)
+			value >>= 7
+		self.buf += struct.pack('B', value)
+	def write_varint(self, value):
+		self.write_varuint((value << 1) ^ (value >> 63))
+	def write_packed(self, values, bits):
+		packed = 0
+		for i in range(0, len(values)):
+			if(values[i] < 0 or values[i] >> bits):
+				raise Exception("Value does not fit into " + str(bits) + " bits")
+			packed |= values[i] << (i*bits)
+		for i in range(0, (len(values)*bits + 7)//8):
+			self.buf += struct.pack('B', (packed >> (8*i)) & 0xFF)
 
 class _Istream:
 	def __init__(self, buf):
@@ -67,6 +102,25 @@ class _Istream:
 		ret = self.buf[0:l]
 		self.buf = self.buf[l:]
 		return ret
+	def read_varuint(self, size):
+		value = 0
+		for i in range(0, (size*8 + 6)//7):
+			byte = struct.unpack('B', self.read(1))[0]
+			value |= (byte & 0x7F) << (7*i)
+			if(not (byte & 0x80)):
+				if(value >> (size*8)):
+					raise Exception("Varint does not fit into " + str(size) + " bytes")
+				return value
+		raise Exception("Varint is too long")
+	def read_varint(self, size):
+		value = self.read_varuint(size)
+		return (value >> 1) ^ -(value & 1)
+	def read_packed(self, count, bits):
+		data = self.read((count*bits + 7)//8)
+		packed = 0
+		for i in range(0, len(data)):
+			packed |= struct.unpack('B', data[i:i+1])[0] << (8*i)
+		return [(packed >> (i*bits)) & ((1 << bits) - 1) for i in range(0, count)]
 
 class Timestamp:
 
@@ -1426,6 +1480,325 @@ class BatteryDataRequest:
 		self.timestamp.decode_internal(istream)
 
 
+class ExportCursor:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.microphone_record_id = 0
+		self.scan_record_id = 0
+		self.accelerometer_record_id = 0
+		self.accelerometer_interrupt_record_id = 0
+		self.battery_record_id = 0
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_microphone_record_id(ostream)
+		self.encode_scan_record_id(ostream)
+		self.encode_accelerometer_record_id(ostream)
+		self.encode_accelerometer_interrupt_record_id(ostream)
+		self.encode_battery_record_id(ostream)
+		pass
+
+	def encode_microphone_record_id(self, ostream):
+		ostream.write(struct.pack('>H', self.microphone_record_id))
+
+	def encode_scan_record_id(self, ostream):
+		ostream.write(struct.pack('>H', self.scan_record_id))
+
+	def encode_accelerometer_record_id(self, ostream):
+		ostream.write(struct.pack('>H', self.accelerometer_record_id))
+
+	def encode_accelerometer_interrupt_record_id(self, ostream):
+		ostream.write(struct.pack('>H', self.accelerometer_interrupt_record_id))
+
+	def encode_battery_record_id(self, ostream):
+		ostream.write(struct.pack('>H', self.battery_record_id))
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_microphone_record_id(istream)
+		self.decode_scan_record_id(istream)
+		self.decode_accelerometer_record_id(istream)
+		self.decode_accelerometer_interrupt_record_id(istream)
+		self.decode_battery_record_id(istream)
+		pass
+
+	def decode_microphone_record_id(self, istream):
+		self.microphone_record_id= struct.unpack('>H', istream.read(2))[0]
+
+	def decode_scan_record_id(self, istream):
+		self.scan_record_id= struct.unpack('>H', istream.read(2))[0]
+
+	def decode_accelerometer_record_id(self, istream):
+		self.accelerometer_record_id= struct.unpack('>H', istream.read(2))[0]
+
+	def decode_accelerometer_interrupt_record_id(self, istream):
+		self.accelerometer_interrupt_record_id= struct.unpack('>H', istream.read(2))[0]
+
+	def decode_battery_record_id(self, istream):
+		self.battery_record_id= struct.unpack('>H', istream.read(2))[0]
+
+
+class BulkExportRequest:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.checkpoint_interval = 0
+		self.has_cursor = 0
+		self.cursor = None
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_checkpoint_interval(ostream)
+		self.encode_cursor(ostream)
+		pass
+
+	def encode_checkpoint_interval(self, ostream):
+		ostream.write(struct.pack('>H', self.checkpoint_interval))
+
+	def encode_cursor(self, ostream):
+		ostream.write(struct.pack('>B', self.has_cursor))
+		if self.has_cursor:
+			self.cursor.encode_internal(ostream)
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_checkpoint_interval(istream)
+		self.decode_cursor(istream)
+		pass
+
+	def decode_checkpoint_interval(self, istream):
+		self.checkpoint_interval= struct.unpack('>H', istream.read(2))[0]
+
+	def decode_cursor(self, istream):
+		self.has_cursor= struct.unpack('>B', istream.read(1))[0]
+		if self.has_cursor:
+			self.cursor = ExportCursor()
+			self.cursor.decode_internal(istream)
+
+
+class PullNewDataRequest:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.hub_id = 0
+		self.checkpoint_interval = 0
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_hub_id(ostream)
+		self.encode_checkpoint_interval(ostream)
+		pass
+
+	def encode_hub_id(self, ostream):
+		ostream.write(struct.pack('>H', self.hub_id))
+
+	def encode_checkpoint_interval(self, ostream):
+		ostream.write(struct.pack('>H', self.checkpoint_interval))
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_hub_id(istream)
+		self.decode_checkpoint_interval(istream)
+		pass
+
+	def decode_hub_id(self, istream):
+		self.hub_id= struct.unpack('>H', istream.read(2))[0]
+
+	def decode_checkpoint_interval(self, istream):
+		self.checkpoint_interval= struct.unpack('>H', istream.read(2))[0]
+
+
+class AcknowledgeDataRequest:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.hub_id = 0
+		self.cursor = None
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_hub_id(ostream)
+		self.encode_cursor(ostream)
+		pass
+
+	def encode_hub_id(self, ostream):
+		ostream.write(struct.pack('>H', self.hub_id))
+
+	def encode_cursor(self, ostream):
+		self.cursor.encode_internal(ostream)
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_hub_id(istream)
+		self.decode_cursor(istream)
+		pass
+
+	def decode_hub_id(self, istream):
+		self.hub_id= struct.unpack('>H', istream.read(2))[0]
+
+	def decode_cursor(self, istream):
+		self.cursor = ExportCursor()
+		self.cursor.decode_internal(istream)
+
+
+class SetCompressionRequest:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.compression = 0
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_compression(ostream)
+		pass
+
+	def encode_compression(self, ostream):
+		ostream.write(struct.pack('>B', self.compression))
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_compression(istream)
+		pass
+
+	def decode_compression(self, istream):
+		self.compression= struct.unpack('>B', istream.read(1))[0]
+
+
+class SetOverflowPolicyRequest:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.data_source = 0
+		self.overflow_policy = 0
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_data_source(ostream)
+		self.encode_overflow_policy(ostream)
+		pass
+
+	def encode_data_source(self, ostream):
+		ostream.write(struct.pack('>B', self.data_source))
+
+	def encode_overflow_policy(self, ostream):
+		ostream.write(struct.pack('>B', self.overflow_policy))
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_data_source(istream)
+		self.decode_overflow_policy(istream)
+		pass
+
+	def decode_data_source(self, istream):
+		self.data_source= struct.unpack('>B', istream.read(1))[0]
+
+	def decode_overflow_policy(self, istream):
+		self.overflow_policy= struct.unpack('>B', istream.read(1))[0]
+
+
 class StartMicrophoneStreamRequest:
 
 	def __init__(self):
@@ -2059,6 +2432,46 @@ class RestartRequest:
 		pass
 
 
+class DiagnosticsRequest:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.reset_chunk_fifo_status = 0
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_reset_chunk_fifo_status(ostream)
+		pass
+
+	def encode_reset_chunk_fifo_status(self, ostream):
+		ostream.write(struct.pack('>B', self.reset_chunk_fifo_status))
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_reset_chunk_fifo_status(istream)
+		pass
+
+	def decode_reset_chunk_fifo_status(self, istream):
+		self.reset_chunk_fifo_status= struct.unpack('>B', istream.read(1))[0]
+
+
 class Request:
 
 	def __init__(self):
@@ -2131,6 +2544,12 @@ class Request:
 			self.identify_request = None
 			self.test_request = None
 			self.restart_request = None
+			self.diagnostics_request = None
+			self.bulk_export_request = None
+			self.pull_new_data_request = None
+			self.acknowledge_data_request = None
+			self.set_compression_request = None
+			self.set_overflow_policy_request = None
 			pass
 
 		def encode_internal(self, ostream):
@@ -2165,6 +2584,12 @@ class Request:
 				27: self.encode_identify_request,
 				28: self.encode_test_request,
 				29: self.encode_restart_request,
+				30: self.encode_diagnostics_request,
+				31: self.encode_bulk_export_request,
+				32: self.encode_pull_new_data_request,
+				33: self.encode_acknowledge_data_request,
+				34: self.encode_set_compression_request,
+				35: self.encode_set_overflow_policy_request,
 			}
 			options[self.which](ostream)
 			pass
@@ -2256,6 +2681,24 @@ class Request:
 		def encode_restart_request(self, ostream):
 			self.restart_request.encode_internal(ostream)
 
+		def encode_diagnostics_request(self, ostream):
+			self.diagnostics_request.encode_internal(ostream)
+
+		def encode_bulk_export_request(self, ostream):
+			self.bulk_export_request.encode_internal(ostream)
+
+		def encode_pull_new_data_request(self, ostream):
+			self.pull_new_data_request.encode_internal(ostream)
+
+		def encode_acknowledge_data_request(self, ostream):
+			self.acknowledge_data_request.encode_internal(ostream)
+
+		def encode_set_compression_request(self, ostream):
+			self.set_compression_request.encode_internal(ostream)
+
+		def encode_set_overflow_policy_request(self, ostream):
+			self.set_overflow_policy_request.encode_internal(ostream)
+
 
 		def decode_internal(self, istream):
 			self.reset()
@@ -2290,6 +2733,12 @@ class Request:
 				27: self.decode_identify_request,
 				28: self.decode_test_request,
 				29: self.decode_restart_request,
+				30: self.decode_diagnostics_request,
+				31: self.decode_bulk_export_request,
+				32: self.decode_pull_new_data_request,
+				33: self.decode_acknowledge_data_request,
+				34: self.decode_set_compression_request,
+				35: self.decode_set_overflow_policy_request,
 			}
 			options[self.which](istream)
 			pass
@@ -2410,6 +2859,30 @@ class Request:
 			self.restart_request = RestartRequest()
 			self.restart_request.decode_internal(istream)
 
+		def decode_diagnostics_request(self, istream):
+			self.diagnostics_request = DiagnosticsRequest()
+			self.diagnostics_request.decode_internal(istream)
+
+		def decode_bulk_export_request(self, istream):
+			self.bulk_export_request = BulkExportRequest()
+			self.bulk_export_request.decode_internal(istream)
+
+		def decode_pull_new_data_request(self, istream):
+			self.pull_new_data_request = PullNewDataRequest()
+			self.pull_new_data_request.decode_internal(istream)
+
+		def decode_acknowledge_data_request(self, istream):
+			self.acknowledge_data_request = AcknowledgeDataRequest()
+			self.acknowledge_data_request.decode_internal(istream)
+
+		def decode_set_compression_request(self, istream):
+			self.set_compression_request = SetCompressionRequest()
+			self.set_compression_request.decode_internal(istream)
+
+		def decode_set_overflow_policy_request(self, istream):
+			self.set_overflow_policy_request = SetOverflowPolicyRequest()
+			self.set_overflow_policy_request.decode_internal(istream)
+
 
 class StatusResponse:
 
@@ -2428,6 +2901,7 @@ class StatusResponse:
 		self.battery_status = 0
 		self.timestamp = None
 		self.battery_data = None
+		self.dropped_chunks = 0
 		pass
 
 	def encode(self):
@@ -2444,6 +2918,7 @@ class StatusResponse:
 		self.encode_battery_status(ostream)
 		self.encode_timestamp(ostream)
 		self.encode_battery_data(ostream)
+		self.encode_dropped_chunks(ostream)
 		pass
 
 	def encode_clock_status(self, ostream):
@@ -2470,6 +2945,9 @@ class StatusResponse:
 	def encode_battery_data(self, ostream):
 		self.battery_data.encode_internal(ostream)
 
+	def encode_dropped_chunks(self, ostream):
+		ostream.write(struct.pack('>H', self.dropped_chunks))
+
 
 	@classmethod
 	def decode(cls, buf):
@@ -2487,6 +2965,7 @@ class StatusResponse:
 		self.decode_battery_status(istream)
 		self.decode_timestamp(istream)
 		self.decode_battery_data(istream)
+		self.decode_dropped_chunks(istream)
 		pass
 
 	def decode_clock_status(self, istream):
@@ -2515,6 +2994,9 @@ class StatusResponse:
 		self.battery_data = BatteryData()
 		self.battery_data.decode_internal(istream)
 
+	def decode_dropped_chunks(self, istream):
+		self.dropped_chunks= struct.unpack('>H', istream.read(2))[0]
+
 
 class StartMicrophoneResponse:
 
@@ -3038,6 +3520,136 @@ class BatteryDataResponse:
 		self.battery_data.decode_internal(istream)
 
 
+class BulkExportCheckpointResponse:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.last_response = 0
+		self.cursor = None
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_last_response(ostream)
+		self.encode_cursor(ostream)
+		pass
+
+	def encode_last_response(self, ostream):
+		ostream.write(struct.pack('>B', self.last_response))
+
+	def encode_cursor(self, ostream):
+		self.cursor.encode_internal(ostream)
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_last_response(istream)
+		self.decode_cursor(istream)
+		pass
+
+	def decode_last_response(self, istream):
+		self.last_response= struct.unpack('>B', istream.read(1))[0]
+
+	def decode_cursor(self, istream):
+		self.cursor = ExportCursor()
+		self.cursor.decode_internal(istream)
+
+
+class SetCompressionResponse:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.compression = 0
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_compression(ostream)
+		pass
+
+	def encode_compression(self, ostream):
+		ostream.write(struct.pack('>B', self.compression))
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_compression(istream)
+		pass
+
+	def decode_compression(self, istream):
+		self.compression= struct.unpack('>B', istream.read(1))[0]
+
+
+class SetOverflowPolicyResponse:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.overflow_policy = 0
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_overflow_policy(ostream)
+		pass
+
+	def encode_overflow_policy(self, ostream):
+		ostream.write(struct.pack('>B', self.overflow_policy))
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_overflow_policy(istream)
+		pass
+
+	def decode_overflow_policy(self, istream):
+		self.overflow_policy= struct.unpack('>B', istream.read(1))[0]
+
+
 class StreamResponse:
 
 	def __init__(self):
@@ -3199,6 +3811,145 @@ class TestResponse:
 		self.test_failed= struct.unpack('>B', istream.read(1))[0]
 
 
+class ChunkFifoStatus:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.dropped_chunks = 0
+		self.high_water_mark = 0
+		self.capacity = 0
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_dropped_chunks(ostream)
+		self.encode_high_water_mark(ostream)
+		self.encode_capacity(ostream)
+		pass
+
+	def encode_dropped_chunks(self, ostream):
+		ostream.write(struct.pack('>H', self.dropped_chunks))
+
+	def encode_high_water_mark(self, ostream):
+		ostream.write(struct.pack('>B', self.high_water_mark))
+
+	def encode_capacity(self, ostream):
+		ostream.write(struct.pack('>B', self.capacity))
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_dropped_chunks(istream)
+		self.decode_high_water_mark(istream)
+		self.decode_capacity(istream)
+		pass
+
+	def decode_dropped_chunks(self, istream):
+		self.dropped_chunks= struct.unpack('>H', istream.read(2))[0]
+
+	def decode_high_water_mark(self, istream):
+		self.high_water_mark= struct.unpack('>B', istream.read(1))[0]
+
+	def decode_capacity(self, istream):
+		self.capacity= struct.unpack('>B', istream.read(1))[0]
+
+
+class DiagnosticsResponse:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.microphone_chunk_fifo_status = None
+		self.scan_chunk_fifo_status = None
+		self.accelerometer_chunk_fifo_status = None
+		self.accelerometer_interrupt_chunk_fifo_status = None
+		self.battery_chunk_fifo_status = None
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_microphone_chunk_fifo_status(ostream)
+		self.encode_scan_chunk_fifo_status(ostream)
+		self.encode_accelerometer_chunk_fifo_status(ostream)
+		self.encode_accelerometer_interrupt_chunk_fifo_status(ostream)
+		self.encode_battery_chunk_fifo_status(ostream)
+		pass
+
+	def encode_microphone_chunk_fifo_status(self, ostream):
+		self.microphone_chunk_fifo_status.encode_internal(ostream)
+
+	def encode_scan_chunk_fifo_status(self, ostream):
+		self.scan_chunk_fifo_status.encode_internal(ostream)
+
+	def encode_accelerometer_chunk_fifo_status(self, ostream):
+		self.accelerometer_chunk_fifo_status.encode_internal(ostream)
+
+	def encode_accelerometer_interrupt_chunk_fifo_status(self, ostream):
+		self.accelerometer_interrupt_chunk_fifo_status.encode_internal(ostream)
+
+	def encode_battery_chunk_fifo_status(self, ostream):
+		self.battery_chunk_fifo_status.encode_internal(ostream)
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_microphone_chunk_fifo_status(istream)
+		self.decode_scan_chunk_fifo_status(istream)
+		self.decode_accelerometer_chunk_fifo_status(istream)
+		self.decode_accelerometer_interrupt_chunk_fifo_status(istream)
+		self.decode_battery_chunk_fifo_status(istream)
+		pass
+
+	def decode_microphone_chunk_fifo_status(self, istream):
+		self.microphone_chunk_fifo_status = ChunkFifoStatus()
+		self.microphone_chunk_fifo_status.decode_internal(istream)
+
+	def decode_scan_chunk_fifo_status(self, istream):
+		self.scan_chunk_fifo_status = ChunkFifoStatus()
+		self.scan_chunk_fifo_status.decode_internal(istream)
+
+	def decode_accelerometer_chunk_fifo_status(self, istream):
+		self.accelerometer_chunk_fifo_status = ChunkFifoStatus()
+		self.accelerometer_chunk_fifo_status.decode_internal(istream)
+
+	def decode_accelerometer_interrupt_chunk_fifo_status(self, istream):
+		self.accelerometer_interrupt_chunk_fifo_status = ChunkFifoStatus()
+		self.accelerometer_interrupt_chunk_fifo_status.decode_internal(istream)
+
+	def decode_battery_chunk_fifo_status(self, istream):
+		self.battery_chunk_fifo_status = ChunkFifoStatus()
+		self.battery_chunk_fifo_status.decode_internal(istream)
+
+
 class Response:
 
 	def __init__(self):
@@ -3255,6 +4006,10 @@ class Response:
 			self.battery_data_response = None
 			self.stream_response = None
 			self.test_response = None
+			self.diagnostics_response = None
+			self.bulk_export_checkpoint_response = None
+			self.set_compression_response = None
+			self.set_overflow_policy_response = None
 			pass
 
 		def encode_internal(self, ostream):
@@ -3273,6 +4028,10 @@ class Response:
 				11: self.encode_battery_data_response,
 				12: self.encode_stream_response,
 				13: self.encode_test_response,
+				14: self.encode_diagnostics_response,
+				15: self.encode_bulk_export_checkpoint_response,
+				16: self.encode_set_compression_response,
+				17: self.encode_set_overflow_policy_response,
 			}
 			options[self.which](ostream)
 			pass
@@ -3316,6 +4075,18 @@ class Response:
 		def encode_test_response(self, ostream):
 			self.test_response.encode_internal(ostream)
 
+		def encode_diagnostics_response(self, ostream):
+			self.diagnostics_response.encode_internal(ostream)
+
+		def encode_bulk_export_checkpoint_response(self, ostream):
+			self.bulk_export_checkpoint_response.encode_internal(ostream)
+
+		def encode_set_compression_response(self, ostream):
+			self.set_compression_response.encode_internal(ostream)
+
+		def encode_set_overflow_policy_response(self, ostream):
+			self.set_overflow_policy_response.encode_internal(ostream)
+
 
 		def decode_internal(self, istream):
 			self.reset()
@@ -3334,6 +4105,10 @@ class Response:
 				11: self.decode_battery_data_response,
 				12: self.decode_stream_response,
 				13: self.decode_test_response,
+				14: self.decode_diagnostics_response,
+				15: self.decode_bulk_export_checkpoint_response,
+				16: self.decode_set_compression_response,
+				17: self.decode_set_overflow_policy_response,
 			}
 			options[self.which](istream)
 			pass
@@ -3390,4 +4165,20 @@ class Response:
 			self.test_response = TestResponse()
 			self.test_response.decode_internal(istream)
 
+		def decode_diagnostics_response(self, istream):
+			self.diagnostics_response = DiagnosticsResponse()
+			self.diagnostics_response.decode_internal(istream)
+
+		def decode_bulk_export_checkpoint_response(self, istream):
+			self.bulk_export_checkpoint_response = BulkExportCheckpointResponse()
+			self.bulk_export_checkpoint_response.decode_internal(istream)
+
+		def decode_set_compression_response(self, istream):
+			self.set_compression_response = SetCompressionResponse()
+			self.set_compression_response.decode_internal(istream)
+
+		def decode_set_overflow_policy_response(self, istream):
+			self.set_overflow_policy_response = SetOverflowPolicyResponse()
+			self.set_overflow_policy_response.decode_internal(istream)
+
 
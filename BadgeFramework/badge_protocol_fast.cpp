@@ -0,0 +1,294 @@
+/*
+ * Python extension that decodes responses of the badge with the C++ bindings of badge_protocol.tb
+ * (badge_protocol.hpp, created by tinybuf_generator.py with -cpp).
+ *
+ * The decoded responses are instances of the classes of badge_protocol.py with the same attributes
+ * as after Response.decode(), so they can be used instead of them. Only the decoding is done here,
+ * the encoding of the requests stays in badge_protocol.py.
+ *
+ * Build (in this directory): python setup.py build_ext --inplace
+ *
+ * Functions:
+ *   decode_response(serialized_response)     --> Response
+ *   decode_responses(serialized_responses)   --> list of Response (e.g. all responses of a badge dump at once)
+ * A ValueError is raised if a response could not be decoded.
+ */
+
+#include <Python.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "badge_protocol.hpp"
+
+
+#if PY_MAJOR_VERSION >= 3
+#define PyInt_FromLong				PyLong_FromLong
+#define PyInt_FromSize_t			PyLong_FromSize_t
+#define PyString_InternFromString	PyUnicode_InternFromString
+#endif
+
+
+static PyObject* protocol_module = NULL;	/**< The module badge_protocol with the message classes */
+static PyObject* gc_module = NULL;
+static PyObject* empty_tuple = NULL;
+
+
+/**@brief Function to retrieve the interned attribute name prefix + name (borrowed reference).
+ *
+ * @details The names are literals in badge_protocol.hpp, so they are cached by their address.
+ */
+static PyObject* get_attribute_name(const char* prefix, const char* name) {
+	static std::map<std::pair<const char*, const char*>, PyObject*> names;
+	std::pair<const char*, const char*> key(prefix, name);
+	std::map<std::pair<const char*, const char*>, PyObject*>::iterator it = names.find(key);
+	if(it != names.end())
+		return it->second;
+	PyObject* attribute_name = PyString_InternFromString((std::string(prefix) + name).c_str());
+	if(attribute_name != NULL)
+		names[key] = attribute_name;
+	return attribute_name;
+}
+
+/**@brief Function to retrieve the class prefix + name of parent, e.g. Response of badge_protocol or _type of Response (borrowed reference).
+ */
+static PyObject* get_class(PyObject* parent, const char* prefix, const char* name) {
+	static std::map<std::pair<PyObject*, PyObject*>, PyObject*> classes;
+	PyObject* attribute_name = get_attribute_name(prefix, name);
+	if(attribute_name == NULL)
+		return NULL;
+	std::pair<PyObject*, PyObject*> key(parent, attribute_name);
+	std::map<std::pair<PyObject*, PyObject*>, PyObject*>::iterator it = classes.find(key);
+	if(it != classes.end())
+		return it->second;
+	PyObject* cls = PyObject_GetAttr(parent, attribute_name);
+	if(cls != NULL)
+		classes[key] = cls;
+	return cls;
+}
+
+/**@brief Function to create an instance of cls with the attributes of dict, without calling __init__() (new reference).
+ */
+static PyObject* new_instance(PyObject* cls, PyObject* dict) {
+#if PY_MAJOR_VERSION < 3
+	if(PyClass_Check(cls))	// The classes of badge_protocol.py are old-style classes
+		return PyInstance_NewRaw(cls, dict);
+#endif
+	if(!PyType_Check(cls)) {
+		PyErr_SetString(PyExc_TypeError, "Message class expected");
+		return NULL;
+	}
+	PyObject* instance = PyType_GenericNew((PyTypeObject*) cls, empty_tuple, NULL);
+	if(instance != NULL && PyObject_SetAttrString(instance, "__dict__", dict) != 0) {
+		Py_DECREF(instance);
+		return NULL;
+	}
+	return instance;
+}
+
+
+static inline PyObject* to_python(uint8_t value)	{ return PyInt_FromLong(value); }
+static inline PyObject* to_python(int8_t value)	{ return PyInt_FromLong(value); }
+static inline PyObject* to_python(uint16_t value)	{ return PyInt_FromLong(value); }
+static inline PyObject* to_python(int16_t value)	{ return PyInt_FromLong(value); }
+static inline PyObject* to_python(uint32_t value)	{ return PyInt_FromSize_t(value); }
+static inline PyObject* to_python(int32_t value)	{ return PyInt_FromLong(value); }
+static inline PyObject* to_python(uint64_t value)	{ return PyLong_FromUnsignedLongLong(value); }
+static inline PyObject* to_python(int64_t value)	{ return PyLong_FromLongLong(value); }
+static inline PyObject* to_python(float value)		{ return PyFloat_FromDouble(value); }
+static inline PyObject* to_python(double value)	{ return PyFloat_FromDouble(value); }
+template<typename M> static PyObject* to_python(const M& message);
+
+/**@brief Function to retrieve the default value of badge_protocol.py for a field that is not set (0 for numbers, None for messages).
+ */
+template<typename T> static PyObject* default_value(const T&) {
+	if(std::is_arithmetic<T>::value)
+		return PyInt_FromLong(0);
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+
+/**@brief Visitor that collects the fields of a message in the attribute-dictionary of the instance (see tinybuf::MessageTraits<M>::visit()).
+ */
+class InstanceBuilder {
+public:
+	explicit InstanceBuilder(PyObject* cls) : cls_(cls), dict_(PyDict_New()), oneof_cls_(NULL), oneof_name_(NULL), oneof_dict_(NULL), failed_(dict_ == NULL) {}
+
+	~InstanceBuilder() {
+		Py_XDECREF(dict_);
+		Py_XDECREF(oneof_dict_);
+	}
+
+	/**@brief Function to create the instance after the visit (new reference, or NULL on failure).
+	 */
+	PyObject* create_instance() {
+		if(failed_)
+			return NULL;
+		return new_instance(cls_, dict_);
+	}
+
+	template<typename T> void field(const char* name, const T& value) {
+		set(dict_, "", name, to_python(value));
+	}
+
+	template<typename T> void optional(const char* name, uint8_t has, const T& value) {
+		set(dict_, "has_", name, to_python(has));
+		set(dict_, "", name, has ? to_python(value) : default_value(value));
+	}
+
+	template<typename T> void repeated(const char* name, const T* values, uint32_t count) {
+		PyObject* list = PyList_New(count);
+		for(uint32_t i = 0; list != NULL && i < count; i++) {
+			PyObject* value = to_python(values[i]);
+			if(value == NULL) {
+				Py_CLEAR(list);
+				break;
+			}
+			PyList_SET_ITEM(list, i, value);
+		}
+		set(dict_, "", name, list);
+	}
+
+	void begin_oneof(const char* name, uint8_t which) {
+		oneof_name_ = name;
+		oneof_cls_ = get_class(cls_, "_", name);
+		oneof_dict_ = PyDict_New();
+		if(oneof_cls_ == NULL || oneof_dict_ == NULL)
+			failed_ = true;
+		set(oneof_dict_, "", "which", to_python(which));
+	}
+
+	template<typename T> void oneof_member(const char* name, bool is_set, const T& value) {
+		set(oneof_dict_, "", name, is_set ? to_python(value) : default_value(value));
+	}
+
+	void end_oneof() {
+		if(!failed_)
+			set(dict_, "", oneof_name_, new_instance(oneof_cls_, oneof_dict_));
+		Py_CLEAR(oneof_dict_);
+	}
+
+private:
+	/**@brief Function to set an entry of a dictionary (steals the reference of value).
+	 */
+	void set(PyObject* dict, const char* prefix, const char* name, PyObject* value) {
+		if(value == NULL || dict == NULL) {
+			Py_XDECREF(value);
+			failed_ = true;
+			return;
+		}
+		PyObject* attribute_name = get_attribute_name(prefix, name);
+		if(attribute_name == NULL || PyDict_SetItem(dict, attribute_name, value) != 0)
+			failed_ = true;
+		Py_DECREF(value);
+	}
+
+	PyObject* cls_;
+	PyObject* dict_;
+	PyObject* oneof_cls_;
+	const char* oneof_name_;
+	PyObject* oneof_dict_;
+	bool failed_;
+};
+
+template<typename M> static PyObject* to_python(const M& message) {
+	static PyObject* cls = NULL;
+	if(cls == NULL)
+		cls = get_class(protocol_module, "", tinybuf::MessageTraits<M>::name());
+	if(cls == NULL)
+		return NULL;
+	InstanceBuilder builder(cls);
+	tinybuf::MessageTraits<M>::visit(builder, message);
+	return builder.create_instance();
+}
+
+
+/**@brief Function to decode one serialized response into a Response instance (new reference, or NULL with an exception).
+ */
+static PyObject* decode(PyObject* serialized_response) {
+	static tinybuf::Response response;
+	char* buf;
+	Py_ssize_t len;
+	if(PyBytes_AsStringAndSize(serialized_response, &buf, &len) != 0)
+		return NULL;
+	memset(&response, 0, sizeof(response));
+	if(!tinybuf::decode<tinybuf::Endian::big>((const uint8_t*) buf, (size_t) len, response)) {
+		PyErr_SetString(PyExc_ValueError, "Could not decode response");
+		return NULL;
+	}
+	return to_python(response);
+}
+
+static PyObject* decode_response(PyObject* self, PyObject* args) {
+	(void) self;
+	PyObject* serialized_response;
+	if(!PyArg_ParseTuple(args, "O", &serialized_response))
+		return NULL;
+	return decode(serialized_response);
+}
+
+static PyObject* decode_responses(PyObject* self, PyObject* args) {
+	(void) self;
+	PyObject* serialized_responses;
+	if(!PyArg_ParseTuple(args, "O", &serialized_responses))
+		return NULL;
+	PyObject* sequence = PySequence_Fast(serialized_responses, "decode_responses() expects a sequence of serialized responses");
+	if(sequence == NULL)
+		return NULL;
+	// The decoded responses are trees (no reference cycles), but creating their many instances would trigger the cyclic garbage collector again and again
+	PyObject* gc_enabled = PyObject_CallMethod(gc_module, (char*) "isenabled", NULL);
+	if(gc_enabled == NULL) {
+		Py_DECREF(sequence);
+		return NULL;
+	}
+	Py_XDECREF(PyObject_CallMethod(gc_module, (char*) "disable", NULL));
+	
+	Py_ssize_t number = PySequence_Fast_GET_SIZE(sequence);
+	PyObject* responses = PyList_New(number);
+	for(Py_ssize_t i = 0; responses != NULL && i < number; i++) {
+		PyObject* response = decode(PySequence_Fast_GET_ITEM(sequence, i));
+		if(response == NULL)
+			Py_CLEAR(responses);
+		else
+			PyList_SET_ITEM(responses, i, response);
+	}
+	Py_DECREF(sequence);
+	
+	if(PyObject_IsTrue(gc_enabled) == 1)
+		Py_XDECREF(PyObject_CallMethod(gc_module, (char*) "enable", NULL));
+	Py_DECREF(gc_enabled);
+	return responses;
+}
+
+
+static PyMethodDef methods[] = {
+	{"decode_response", decode_response, METH_VARARGS, "Decodes a serialized response into a badge_protocol.Response."},
+	{"decode_responses", decode_responses, METH_VARARGS, "Decodes a sequence of serialized responses into a list of badge_protocol.Response."},
+	{NULL, NULL, 0, NULL}
+};
+
+static bool init_globals(void) {
+	protocol_module = PyImport_ImportModule("badge_protocol");
+	gc_module = PyImport_ImportModule("gc");
+	empty_tuple = PyTuple_New(0);
+	return protocol_module != NULL && gc_module != NULL && empty_tuple != NULL;
+}
+
+#if PY_MAJOR_VERSION >= 3
+static struct PyModuleDef module_definition = {PyModuleDef_HEAD_INIT, "badge_protocol_fast", NULL, -1, methods, NULL, NULL, NULL, NULL};
+
+PyMODINIT_FUNC PyInit_badge_protocol_fast(void) {
+	if(!init_globals())
+		return NULL;
+	return PyModule_Create(&module_definition);
+}
+#else
+PyMODINIT_FUNC initbadge_protocol_fast(void) {
+	if(!init_globals())
+		return;
+	Py_InitModule("badge_protocol_fast", methods);
+}
+#endif
@@ -0,0 +1,56 @@
+from __future__ import division, absolute_import, print_function
+import argparse
+import time
+
+from badge import *
+from socket_badge_connection import *
+
+# Benchmark of the request latency and the pull throughput against the badge simulator
+#   (firmware/nRF_badge/data_collector/unit_test: make badge_03v6 badge_sim, then _build/run_badge_sim --quiet).
+# The latency should be measured with --speed 1 (the simulator polls the socket every millisecond of wall-clock time).
+# All times are converted to the time of the simulated badge with the --speed factor of the simulator,
+#   so the results are comparable to a physical badge (the link is limited like BLE with a 10 ms connection interval).
+
+def percentile(values, p):
+	values = sorted(values)
+	return values[min(len(values) - 1, int(len(values) * p / 100))]
+
+def main():
+	parser = argparse.ArgumentParser(description="Benchmark the request latency and pull throughput of the badge simulator")
+	parser.add_argument('--host', default=DEFAULT_HOST)
+	parser.add_argument('--port', type=int, default=DEFAULT_PORT)
+	parser.add_argument('--unix', default=None, help="UNIX socket path of the simulator (instead of TCP)")
+	parser.add_argument('--speed', type=float, default=1.0, help="The --speed factor the simulator runs with")
+	parser.add_argument('--requests', type=int, default=50, help="Number of status requests for the latency")
+	parser.add_argument('--record-seconds', type=float, default=60.0, help="Seconds (of the badge) of microphone data to pull")
+	args = parser.parse_args()
+
+	connection = SocketBadgeConnection(host=args.host, port=args.port, unix_path=args.unix)
+	connection.connect()
+	badge = OpenBadge(connection)
+
+	latencies = []
+	for i in range(args.requests):
+		start = time.time()
+		badge.get_status()
+		latencies.append((time.time() - start) * args.speed * 1000)
+	print("Status request latency [ms]: mean {:.1f}, p50 {:.1f}, p95 {:.1f}, max {:.1f}".format(
+		sum(latencies) / len(latencies), percentile(latencies, 50), percentile(latencies, 95), max(latencies)))
+
+	badge.start_microphone()
+	time.sleep(args.record_seconds / args.speed)
+	badge.stop_microphone()
+
+	received_bytes = connection.received_bytes
+	start = time.time()
+	(chunks, cursor) = badge.pull_new_data(hub_id=1)
+	duration = (time.time() - start) * args.speed
+	received_bytes = connection.received_bytes - received_bytes
+	number_of_chunks = sum(len(chunk_list) for chunk_list in chunks.values())
+	print("Pull of {} chunks: {} bytes in {:.3f} s, {:.0f} bytes/s".format(
+		number_of_chunks, received_bytes, duration, received_bytes / duration if duration > 0 else 0))
+
+	connection.disconnect()
+
+if __name__ == "__main__":
+	main()
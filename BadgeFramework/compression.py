@@ -0,0 +1,39 @@
+from __future__ import division, absolute_import, print_function
+
+# Decoder for the LZSS compressed responses of the badge (see compression_lib.h of the firmware).
+#   The compressed data consist of groups of up to 8 items, each group is preceded by a flag-byte.
+#   Bit i (LSB first) of the flag-byte describes item i:
+#     0: Literal, one byte that is copied to the output.
+#     1: Match, two bytes: (offset - 1) and (length - COMPRESSION_MIN_MATCH_LEN). length bytes are
+#        copied from offset bytes before the current output position (the areas may overlap).
+
+COMPRESSION_MIN_MATCH_LEN = 3
+
+
+# Returns the decompressed bytes of the compressed bytes.
+#   Raises a ValueError if the compressed data are malformed.
+def decompress(compressed):
+	compressed = bytearray(compressed)
+	data = bytearray()
+	pos = 0
+	while pos < len(compressed):
+		flags = compressed[pos]
+		pos += 1
+		for item in range(8):
+			if pos >= len(compressed):
+				break
+			if flags & (1 << item):
+				if pos + 2 > len(compressed):
+					raise ValueError("Truncated match at position " + str(pos))
+				offset = compressed[pos] + 1
+				length = compressed[pos + 1] + COMPRESSION_MIN_MATCH_LEN
+				pos += 2
+				if offset > len(data):
+					raise ValueError("Match offset " + str(offset) + " before the start of the data")
+				# Byte by byte, because the match may overlap with the bytes it produces
+				for i in range(length):
+					data.append(data[-offset])
+			else:
+				data.append(compressed[pos])
+				pos += 1
+	return bytes(data)
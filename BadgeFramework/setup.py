@@ -0,0 +1,14 @@
+# Builds the C++ decoder of the responses (badge_protocol_fast), that is used by badge.py if it is available:
+#   python setup.py build_ext --inplace
+# badge_protocol.hpp is created with: tinybuf_generator.py -cpp badge_protocol.tb . badge_protocol
+import os
+from distutils.core import setup, Extension
+
+BADGE_FRAMEWORK_DIR = os.path.dirname(os.path.abspath(__file__))
+TINYBUF_DIR = os.path.join(BADGE_FRAMEWORK_DIR, '..', 'firmware', 'nRF_badge', 'data_collector', 'tinybuf', 'incl')
+
+setup(name='badge_protocol_fast',
+	ext_modules=[Extension('badge_protocol_fast',
+		sources=[os.path.join(BADGE_FRAMEWORK_DIR, 'badge_protocol_fast.cpp')],
+		include_dirs=[BADGE_FRAMEWORK_DIR, TINYBUF_DIR],
+		extra_compile_args=['-std=c++11', '-O2'])])
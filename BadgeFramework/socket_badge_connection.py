@@ -0,0 +1,89 @@
+from __future__ import division, absolute_import, print_function
+from badge_connection import *
+
+import logging
+import socket
+
+logger = logging.getLogger(__name__)
+
+DEFAULT_HOST = '127.0.0.1'
+DEFAULT_PORT = 5455
+
+# SocketBadgeConnection represents a connection to a simulated badge (unit_test/_build/run_badge_sim in the firmware),
+#   that exposes the Nordic UART stream of the badge over a local TCP or UNIX socket.
+# This class implements the BadgeConnection interface, so OpenBadge() works with the simulated badge
+#   like with a physical one. E.g. to benchmark the pull throughput and request latency without hardware:
+#     connection = SocketBadgeConnection(port=5455)	# or SocketBadgeConnection(unix_path='/tmp/badge_sim')
+#     connection.connect()
+#     badge = OpenBadge(connection)
+class SocketBadgeConnection(BadgeConnection):
+
+	def __init__(self, host=DEFAULT_HOST, port=DEFAULT_PORT, unix_path=None, timeout_seconds=30.0):
+		self.host = host
+		self.port = port
+		self.unix_path = unix_path
+		self.timeout_seconds = timeout_seconds
+		self.sock = None
+
+		# Contains the bytes recieved from the badge. Held here until an entire message is recieved.
+		self.rx_buffer = b""
+		# Number of bytes received from the badge since connect() (e.g. to compute the throughput)
+		self.received_bytes = 0
+
+		BadgeConnection.__init__(self)
+
+	# Implements BadgeConnection's connect() spec.
+	def connect(self):
+		logger.debug("Connecting...")
+		if self.unix_path is not None:
+			self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+			self.sock.connect(self.unix_path)
+		else:
+			self.sock = socket.create_connection((self.host, self.port))
+			self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+		self.sock.settimeout(self.timeout_seconds)
+		self.rx_buffer = b""
+		self.received_bytes = 0
+		logger.debug("Connected.")
+
+	# Implements BadgeConnections's disconnect() spec.
+	def disconnect(self):
+		if self.sock is not None:
+			self.sock.close()
+		self.sock = None
+		self.rx_buffer = b""
+
+	# Implements BadgeConnection's is_connected() spec.
+	def is_connected(self):
+		return self.sock is not None
+
+	# Implements BadgeConnection's await_data() spec.
+	def await_data(self, data_len):
+		if not self.is_connected():
+			raise RuntimeError("SocketBadgeConnection not connected before await_data()!")
+
+		if data_len <= 0:
+			return None
+
+		while len(self.rx_buffer) < data_len:
+			data = self.sock.recv(max(4096, data_len - len(self.rx_buffer)))
+			if not data:
+				raise RuntimeError("SocketBadgeConnection closed by the badge!")
+			logger.debug("Recieved {}".format(repr(data)))
+			self.rx_buffer += data
+			self.received_bytes += len(data)
+
+		rx_message = self.rx_buffer[:data_len]
+		self.rx_buffer = self.rx_buffer[data_len:]
+		return rx_message
+
+	# Implements BadgeConnection's send() spec.
+	def send(self, message, response_len=0):
+		if not self.is_connected():
+			raise RuntimeError("SocketBadgeConnection not connected before send()!")
+
+		self.sock.sendall(message)
+
+		if response_len > 0:
+			return self.await_data(response_len)
+		return None
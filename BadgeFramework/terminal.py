@@ -52,9 +52,14 @@ def main():
 		print("  get_accelerometer_data [seconds of accelerometer data to request]")
 		print("  get_accelerometer_interrupt_data [seconds of accelerometer interrupt data to request]")
 		print("  get_battery_data [seconds of battery data to request]")
+		print("  bulk_export ['resume']")
+		print("  pull_new_data [hub id]")
 		print("  identify [led duration seconds | 'off']")
 		print("  test")
 		print("  restart")
+		print("  diagnostics ['reset']")
+		print("  compression ['off']")
+		print("  overflow_policy [microphone|scan|accelerometer|accelerometer_interrupt|battery] [drop_newest|drop_oldest|degrade_rate]")
 		print("  help")
 		print("  start_microphone_stream")
 		print("  stop_microphone_stream")
@@ -163,6 +168,22 @@ def main():
 		else:
 			print("Invalid Syntax: get_battery_data [seconds of battery data to request]")
 			
+	def handle_bulk_export(args):
+		if len(args) == 1:
+			print(badge.get_bulk_export())
+		elif len(args) == 2 and args[1] == "resume":
+			print(badge.get_bulk_export(badge.bulk_export_cursor))
+		else:
+			print("Invalid Syntax: bulk_export ['resume']")
+			
+	def handle_pull_new_data(args):
+		if len(args) == 1:
+			print(badge.pull_new_data(0))
+		elif len(args) == 2:
+			print(badge.pull_new_data(int(args[1])))
+		else:
+			print("Invalid Syntax: pull_new_data [hub id]")
+			
 		
 
 	def handle_identify_request(args):
@@ -183,6 +204,35 @@ def main():
 	def handle_restart_request(args):
 		print(badge.restart())
 		
+	def handle_diagnostics_request(args):
+		print(badge.get_diagnostics(reset=(len(args) == 2 and args[1] == "reset")))
+		
+	def handle_compression_request(args):
+		if len(args) == 1:
+			print(badge.set_compression())
+		elif len(args) == 2 and args[1] == "off":
+			print(badge.set_compression(PROTOCOL_COMPRESSION_NONE))
+		else:
+			print("Invalid Syntax: compression ['off']")
+	
+	def handle_overflow_policy_request(args):
+		data_sources = {
+			"microphone": PROTOCOL_DATA_SOURCE_MICROPHONE,
+			"scan": PROTOCOL_DATA_SOURCE_SCAN,
+			"accelerometer": PROTOCOL_DATA_SOURCE_ACCELEROMETER,
+			"accelerometer_interrupt": PROTOCOL_DATA_SOURCE_ACCELEROMETER_INTERRUPT,
+			"battery": PROTOCOL_DATA_SOURCE_BATTERY,
+		}
+		overflow_policies = {
+			"drop_newest": PROTOCOL_OVERFLOW_POLICY_DROP_NEWEST,
+			"drop_oldest": PROTOCOL_OVERFLOW_POLICY_DROP_OLDEST,
+			"degrade_rate": PROTOCOL_OVERFLOW_POLICY_DEGRADE_RATE,
+		}
+		if len(args) == 3 and args[1] in data_sources and args[2] in overflow_policies:
+			print(badge.set_overflow_policy(data_sources[args[1]], overflow_policies[args[2]]))
+		else:
+			print("Invalid Syntax: overflow_policy [microphone|scan|accelerometer|accelerometer_interrupt|battery] [drop_newest|drop_oldest|degrade_rate]")
+		
 		
 		
 	def handle_start_microphone_stream_request(args):
@@ -244,9 +294,14 @@ def main():
 		"get_accelerometer_data": handle_get_accelerometer_data,
 		"get_accelerometer_interrupt_data": handle_get_accelerometer_interrupt_data,
 		"get_battery_data": handle_get_battery_data,
+		"bulk_export": handle_bulk_export,
+		"pull_new_data": handle_pull_new_data,
 		"identify": handle_identify_request,
 		"test": handle_test_request,
 		"restart": handle_restart_request,
+		"diagnostics": handle_diagnostics_request,
+		"compression": handle_compression_request,
+		"overflow_policy": handle_overflow_policy_request,
 		"start_microphone_stream": handle_start_microphone_stream_request,
 		"stop_microphone_stream": handle_stop_microphone_stream_request,
 		"start_scan_stream": handle_start_scan_stream_request,
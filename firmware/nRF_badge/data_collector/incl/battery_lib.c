@@ -3,7 +3,7 @@
 #include "adc_lib.h"
 #include "systick_lib.h" // Needed for battery_selftest()
 #include "app_timer.h"
-#include "app_scheduler.h"
+#include "scheduler_lib.h"
 #include "advertiser_lib.h"
 #include "app_util_platform.h"
 #include "debug_lib.h"
@@ -90,7 +90,7 @@ static void internal_battery_callback(void* p_context) {
 	if(ret != NRF_SUCCESS) return;
 	
 	// Here we want to update the advertising data, but this should be done in main-context not in timer context.
-	app_sched_event_put(NULL, 0, update_advertiser_voltage);
+	scheduler_event_put(SCHEDULER_PRIORITY_HOUSEKEEPING, update_advertiser_voltage);
 }
 
 static void update_advertiser_voltage(void * p_event_data, uint16_t event_size) {
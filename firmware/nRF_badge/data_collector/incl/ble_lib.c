@@ -442,6 +442,9 @@ ble_state_t ble_get_state(void) {
 
 ret_code_t ble_transmit(uint8_t* data, uint16_t len) {
 	ret_code_t ret = ble_nus_string_send(&ble_nus, data, len);
+	// All notification buffers are in use, they are released with the next BLE_EVT_TX_COMPLETE event
+	if(ret == BLE_ERROR_NO_TX_PACKETS)
+		ret = NRF_ERROR_BUSY;
 
 	return ret;
 }
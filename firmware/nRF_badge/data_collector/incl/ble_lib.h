@@ -130,7 +130,11 @@ ble_state_t ble_get_state(void);
 
 /**@brief	Function to transmit data via the established BLE-connection.
  *
- * @retval	NRF_SUCCESS If the data were sent successfully. Otherwise, an error code is returned.
+ * @details	The data are queued as one notification in a buffer of the SoftDevice, and are sent at the next connection event.
+ *
+ * @retval	NRF_SUCCESS 	If the data were queued successfully.
+ * @retval	NRF_ERROR_BUSY	If all notification buffers of the SoftDevice are in use. Wait for the on transmit callback.
+ *			Otherwise, another error code is returned.
  * 
  * @note 	A BLE-connection has to be established before calling this function to work.
  */
@@ -145,6 +149,8 @@ ret_code_t 	ble_transmit(uint8_t* data, uint16_t len);
 void 		ble_set_on_receive_callback(ble_on_receive_callback_t 			ble_on_receive_callback);
 
 /**@brief	Function to set the on transmit callback function.
+ *
+ * @details	The callback is called when queued notifications were sent (and their buffers are free again).
  *
  * @param [in] 	ble_on_transmit_callback		The callback function that should be called.
  */
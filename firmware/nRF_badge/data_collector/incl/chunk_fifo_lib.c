@@ -15,6 +15,9 @@ ret_code_t chunk_fifo_init(chunk_fifo_t* chunk_fifo, uint8_t chunk_num, uint32_t
 	chunk_fifo->chunk_write_pos = 0;
 	chunk_fifo->chunk_open_read = 0;
 	chunk_fifo->chunk_open_write = 0;
+	chunk_fifo->overflow_policy = CHUNK_FIFO_OVERFLOW_DROP_NEWEST;
+	chunk_fifo->chunk_drop_count = 0;
+	chunk_fifo->chunk_high_water_mark = 0;
 
 	return NRF_SUCCESS;	
 }
@@ -23,15 +26,17 @@ ret_code_t chunk_fifo_init(chunk_fifo_t* chunk_fifo, uint8_t chunk_num, uint32_t
 ret_code_t chunk_fifo_read_open(chunk_fifo_t* chunk_fifo, void** p_chunk, void** p_additional_info) {
 	
 	ret_code_t ret;
+	// Mark the read operation before accessing the chunk_read_pos, so a write operation (e.g. in an ISR) won't drop this chunk.
+	chunk_fifo->chunk_open_read = 1;
 	if(chunk_fifo->chunk_read_pos != chunk_fifo->chunk_write_pos) {
 		// New chunks are available
 		*p_chunk = &(chunk_fifo->p_chunk_fifo_buf[(chunk_fifo->chunk_read_pos)*(chunk_fifo->chunk_size + chunk_fifo->additional_info_size)]);
 		if(p_additional_info != NULL)
 			*p_additional_info = &(chunk_fifo->p_chunk_fifo_buf[chunk_fifo->chunk_size + (chunk_fifo->chunk_read_pos)*(chunk_fifo->chunk_size + chunk_fifo->additional_info_size)]);
 		
-		chunk_fifo->chunk_open_read = 1;
 		ret = NRF_SUCCESS;
 	} else {
+		chunk_fifo->chunk_open_read = 0;
 		ret = NRF_ERROR_NOT_FOUND;
 	}
 	return ret;
@@ -42,13 +47,12 @@ void chunk_fifo_read_close(chunk_fifo_t* chunk_fifo) {
 	if(!chunk_fifo->chunk_open_read) 
 		return;
 	
-	chunk_fifo->chunk_open_read = 0;
-	
-	if(chunk_fifo->chunk_read_pos == chunk_fifo->chunk_write_pos)  // This one should actually not happen
-		return;
-	
+	if(chunk_fifo->chunk_read_pos != chunk_fifo->chunk_write_pos) { // The other case should actually not happen
+		chunk_fifo->chunk_read_pos = (chunk_fifo->chunk_read_pos + 1) % (chunk_fifo->chunk_num + 1); 
+	}
 	
-	chunk_fifo->chunk_read_pos = (chunk_fifo->chunk_read_pos + 1) % (chunk_fifo->chunk_num + 1); 
+	// Only reset the flag after the chunk_read_pos has been incremented, so a write operation can't drop a chunk in between
+	chunk_fifo->chunk_open_read = 0;
 	
 	return;
 	
@@ -64,24 +68,38 @@ void chunk_fifo_write_open(chunk_fifo_t* chunk_fifo, void** p_chunk, void** p_ad
 	
 }
 
-void chunk_fifo_write_close(chunk_fifo_t* chunk_fifo) {
+ret_code_t chunk_fifo_write_close(chunk_fifo_t* chunk_fifo) {
 	
 	// Only increment the write-pos if there was a write-open operation before
 	
 	if(!chunk_fifo->chunk_open_write) {
-		return;
+		return NRF_SUCCESS;
 	}
 	
 	chunk_fifo->chunk_open_write = 0;
 	
-	// Only increment the write-pos, if the old chunks (that have not been read yet) were not overwritten
-	if((chunk_fifo->chunk_write_pos + 1) % (chunk_fifo->chunk_num + 1) == chunk_fifo->chunk_read_pos) {
-		return;
+	uint8_t next_write_pos = (chunk_fifo->chunk_write_pos + 1) % (chunk_fifo->chunk_num + 1);
+	if(next_write_pos == chunk_fifo->chunk_read_pos) {
+		// The chunk-fifo is full --> one chunk has to be dropped
+		if(chunk_fifo->chunk_drop_count < 0xFFFF)
+			chunk_fifo->chunk_drop_count++;
+		
+		// The oldest chunk could only be dropped if it is not currently read
+		if(chunk_fifo->overflow_policy == CHUNK_FIFO_OVERFLOW_DROP_OLDEST && !chunk_fifo->chunk_open_read) {
+			chunk_fifo->chunk_read_pos = (chunk_fifo->chunk_read_pos + 1) % (chunk_fifo->chunk_num + 1);
+			chunk_fifo->chunk_write_pos = next_write_pos;
+		}
+		// Otherwise don't increment the write-pos, so the old chunks (that have not been read yet) are not overwritten
+		return NRF_ERROR_NO_MEM;
 	}
 	
-	chunk_fifo->chunk_write_pos = (chunk_fifo->chunk_write_pos + 1) % (chunk_fifo->chunk_num + 1);
+	chunk_fifo->chunk_write_pos = next_write_pos;
 	
-	return;
+	uint8_t num = chunk_fifo_get_number_of_chunks(chunk_fifo);
+	if(num > chunk_fifo->chunk_high_water_mark)
+		chunk_fifo->chunk_high_water_mark = num;
+	
+	return NRF_SUCCESS;
 } 
 
 uint8_t chunk_fifo_get_number_of_chunks(chunk_fifo_t* chunk_fifo) {
@@ -93,3 +111,18 @@ uint8_t chunk_fifo_get_number_of_chunks(chunk_fifo_t* chunk_fifo) {
 	}
 	return num;
 }
+
+void chunk_fifo_set_overflow_policy(chunk_fifo_t* chunk_fifo, chunk_fifo_overflow_policy_t overflow_policy) {
+	chunk_fifo->overflow_policy = overflow_policy;
+}
+
+void chunk_fifo_get_statistics(chunk_fifo_t* chunk_fifo, chunk_fifo_statistics_t* statistics) {
+	statistics->dropped_chunks = chunk_fifo->chunk_drop_count;
+	statistics->high_water_mark = chunk_fifo->chunk_high_water_mark;
+	statistics->chunk_num = chunk_fifo->chunk_num;
+}
+
+void chunk_fifo_reset_statistics(chunk_fifo_t* chunk_fifo) {
+	chunk_fifo->chunk_drop_count = 0;
+	chunk_fifo->chunk_high_water_mark = chunk_fifo_get_number_of_chunks(chunk_fifo);
+}
@@ -15,6 +15,19 @@
 #include "sdk_errors.h"	// Needed for the definition of ret_code_t and the error-codes
 
 
+/**@brief The different policies of a chunk-fifo, when a chunk is written while all the chunks are filled. */
+typedef enum {
+	CHUNK_FIFO_OVERFLOW_DROP_NEWEST	= 0,	/**< The newest chunk is dropped: the next write operation reuses the same chunk (default). */
+	CHUNK_FIFO_OVERFLOW_DROP_OLDEST	= 1,	/**< The oldest unread chunk is dropped (if it is currently not opened for reading, otherwise the newest chunk is dropped). */
+} chunk_fifo_overflow_policy_t;
+
+/**@brief Statistics of a chunk-fifo, to detect that the consumer of the chunks could not keep up. */
+typedef struct {
+	uint16_t	dropped_chunks;		/**< Number of chunks that were dropped because the chunk-fifo was full (saturates at 0xFFFF). */
+	uint8_t		high_water_mark;	/**< Maximum number of finished chunks that were in the chunk-fifo at the same time. */
+	uint8_t		chunk_num;			/**< Number of chunks in chunk-fifo. */
+} chunk_fifo_statistics_t;
+
 /**@brief   A chunk FIFO instance structure.
  * @details Keeps track of which bytes to read and write next.
  *          Also, it keeps the information about which memory is allocated for the buffer
@@ -30,6 +43,9 @@ typedef struct
     volatile uint8_t    chunk_write_pos;       		/**< Next write position in the chunk-fifo buffer. */
 	volatile uint8_t    chunk_open_read;        	/**< Flag if currently there is a chunk read operation in progress. */
     volatile uint8_t    chunk_open_write;       	/**< Flag if currently there is a chunk write operation in progress. */
+	chunk_fifo_overflow_policy_t overflow_policy;	/**< What to do when a chunk is written into the full chunk-fifo. */
+	volatile uint16_t	chunk_drop_count;			/**< Number of chunks that were dropped because the chunk-fifo was full. */
+	volatile uint8_t	chunk_high_water_mark;		/**< Maximum number of finished chunks that were in the chunk-fifo at the same time. */
 } chunk_fifo_t;
 
 
@@ -93,7 +109,7 @@ void 		chunk_fifo_read_close(chunk_fifo_t* chunk_fifo);
  *			To write data (and additional-info) to the FIFO chunk the application needs to provide the address
  *			of a pointer-variable. The data can the be accessed(written via this pointer-variable.
  *			This pointer-variable could be a pointer to a struct.
- *			If all the available chunks are already filled, this functions will always set the pointer variable
+ *			If all the available chunks are already filled (and the overflow-policy is CHUNK_FIFO_OVERFLOW_DROP_NEWEST), this functions will always set the pointer variable
 *			to the same address until a read-operation was perforemed so the other chunks won't be overwritten.
  *
  * @param[in] 	chunk_fifo 			Pointer to chunk-fifo identifier variable.
@@ -107,10 +123,14 @@ void 		chunk_fifo_write_open(chunk_fifo_t* chunk_fifo, void** p_chunk, void** p_
  * @details	This functions closes/finishes the write operation of the currently opened write chunk.
  *			This is equal to the put()-function of a normal FIFO by incrementing the chunk_write_pos, 
  *			except it would reach the chunk_read_pos or there was no write-opening operation (by chunk_fifo_write_open()) before.
+ *			If the chunk-fifo is full, a chunk is dropped according to the overflow-policy and the drop-counter is incremented.
  *
  * @param[in] 	chunk_fifo 			Pointer to chunk-fifo identifier variable.
+ *
+ * @retval 	NRF_SUCCESS					If the chunk was put into the chunk-fifo without dropping a chunk (or there was no opened write operation).
+ * @retval 	NRF_ERROR_NO_MEM 			If the chunk-fifo was full and a chunk has been dropped.
  */
-void 		chunk_fifo_write_close(chunk_fifo_t* chunk_fifo);
+ret_code_t	chunk_fifo_write_close(chunk_fifo_t* chunk_fifo);
 
 /**@brief Function to retrieve the current number of finished chunks in the chunk-FIFO.
  *
@@ -120,4 +140,26 @@ void 		chunk_fifo_write_close(chunk_fifo_t* chunk_fifo);
  */
 uint8_t 	chunk_fifo_get_number_of_chunks(chunk_fifo_t* chunk_fifo);
 
+/**@brief Function to set the overflow-policy of the chunk-fifo (default: CHUNK_FIFO_OVERFLOW_DROP_NEWEST).
+ *
+ * @param[in] chunk_fifo 			Pointer to chunk-fifo identifier variable.
+ * @param[in] overflow_policy		The policy that should be applied when a chunk is written into the full chunk-fifo.
+ */
+void		chunk_fifo_set_overflow_policy(chunk_fifo_t* chunk_fifo, chunk_fifo_overflow_policy_t overflow_policy);
+
+/**@brief Function to retrieve the drop-counter and the high-water mark of the chunk-fifo.
+ *
+ * @param[in]  chunk_fifo 			Pointer to chunk-fifo identifier variable.
+ * @param[out] statistics			Pointer to the statistics structure that should be filled.
+ */
+void		chunk_fifo_get_statistics(chunk_fifo_t* chunk_fifo, chunk_fifo_statistics_t* statistics);
+
+/**@brief Function to reset the drop-counter and the high-water mark of the chunk-fifo.
+ *
+ * @details The high-water mark is reset to the current number of finished chunks.
+ *
+ * @param[in] chunk_fifo 			Pointer to chunk-fifo identifier variable.
+ */
+void		chunk_fifo_reset_statistics(chunk_fifo_t* chunk_fifo);
+
 #endif
\ No newline at end of file
@@ -37,3 +37,204 @@ const tb_field_t AccelerometerInterruptChunk_fields[2] = {
 	TB_LAST_FIELD,
 };
 
+const tb_field_t DownloadCursor_fields[3] = {
+	{65, tb_offsetof(DownloadCursor, hub_id), 0, 0, tb_membersize(DownloadCursor, hub_id), 0, 0, 0, NULL},
+	{72, tb_offsetof(DownloadCursor, record_ids), 0, 0, tb_membersize(DownloadCursor, record_ids[0]), tb_membersize(DownloadCursor, record_ids)/tb_membersize(DownloadCursor, record_ids[0]), 0, 0, NULL},
+	TB_LAST_FIELD,
+};
+
+const tb_field_t DownloadCursorTable_fields[2] = {
+	{516, tb_offsetof(DownloadCursorTable, download_cursors), tb_delta(DownloadCursorTable, download_cursors_count, download_cursors), 1, tb_membersize(DownloadCursorTable, download_cursors[0]), tb_membersize(DownloadCursorTable, download_cursors)/tb_membersize(DownloadCursorTable, download_cursors[0]), 0, 0, &DownloadCursor_fields},
+	TB_LAST_FIELD,
+};
+
+uint8_t BatteryChunk_encode(tb_ostream_t* ostream, const BatteryChunk* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, BatteryChunk_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, BatteryChunk_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BatteryChunk_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t BatteryChunk_decode(tb_istream_t* istream, BatteryChunk* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, BatteryChunk_fields, dst, endianness);
+	p = tb_istream_consume(istream, BatteryChunk_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BatteryChunk_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t MicrophoneChunk_encode(tb_ostream_t* ostream, const MicrophoneChunk* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, MicrophoneChunk_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 8);
+	if(p == NULL) return 0;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	tb_put_16(p + 6, (uint16_t) src->sample_period_ms, endianness);
+	if(src->microphone_data_count > 114) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->microphone_data_count)*1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->microphone_data_count;
+	for(uint32_t i = 0; i < src->microphone_data_count; i++) MicrophoneData_put(p + 1 + i*1, &(src->microphone_data[i]), endianness);
+	return 1;
+}
+
+uint8_t MicrophoneChunk_decode(tb_istream_t* istream, MicrophoneChunk* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, MicrophoneChunk_fields, dst, endianness);
+	p = tb_istream_consume(istream, 9);
+	if(p == NULL) return 0;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->sample_period_ms = (uint16_t) tb_get_16(p + 6, endianness);
+	dst->microphone_data_count = (uint8_t) *(p + 8);
+	if(dst->microphone_data_count > 114) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->microphone_data_count)*1);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->microphone_data_count; i++) MicrophoneData_get(p + i*1, &(dst->microphone_data[i]), endianness);
+	return 1;
+}
+
+uint8_t ScanSamplingChunk_encode(tb_ostream_t* ostream, const ScanSamplingChunk* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, ScanSamplingChunk_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 6);
+	if(p == NULL) return 0;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->scan_result_data_count)*4);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->scan_result_data_count;
+	for(uint32_t i = 0; i < src->scan_result_data_count; i++) ScanResultData_put(p + 1 + i*4, &(src->scan_result_data[i]), endianness);
+	return 1;
+}
+
+uint8_t ScanSamplingChunk_decode(tb_istream_t* istream, ScanSamplingChunk* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, ScanSamplingChunk_fields, dst, endianness);
+	p = tb_istream_consume(istream, 7);
+	if(p == NULL) return 0;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->scan_result_data_count = (uint8_t) *(p + 6);
+	p = tb_istream_consume(istream, ((uint32_t) dst->scan_result_data_count)*4);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->scan_result_data_count; i++) ScanResultData_get(p + i*4, &(dst->scan_result_data[i]), endianness);
+	return 1;
+}
+
+uint8_t ScanChunk_encode(tb_ostream_t* ostream, const ScanChunk* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, ScanChunk_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 6);
+	if(p == NULL) return 0;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	if(src->scan_result_data_count > 29) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->scan_result_data_count)*4);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->scan_result_data_count;
+	for(uint32_t i = 0; i < src->scan_result_data_count; i++) ScanResultData_put(p + 1 + i*4, &(src->scan_result_data[i]), endianness);
+	return 1;
+}
+
+uint8_t ScanChunk_decode(tb_istream_t* istream, ScanChunk* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, ScanChunk_fields, dst, endianness);
+	p = tb_istream_consume(istream, 7);
+	if(p == NULL) return 0;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->scan_result_data_count = (uint8_t) *(p + 6);
+	if(dst->scan_result_data_count > 29) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->scan_result_data_count)*4);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->scan_result_data_count; i++) ScanResultData_get(p + i*4, &(dst->scan_result_data[i]), endianness);
+	return 1;
+}
+
+uint8_t AccelerometerChunk_encode(tb_ostream_t* ostream, const AccelerometerChunk* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, AccelerometerChunk_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 6);
+	if(p == NULL) return 0;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	if(src->accelerometer_data_count > 100) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->accelerometer_data_count)*2);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->accelerometer_data_count;
+	for(uint32_t i = 0; i < src->accelerometer_data_count; i++) AccelerometerData_put(p + 1 + i*2, &(src->accelerometer_data[i]), endianness);
+	return 1;
+}
+
+uint8_t AccelerometerChunk_decode(tb_istream_t* istream, AccelerometerChunk* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, AccelerometerChunk_fields, dst, endianness);
+	p = tb_istream_consume(istream, 7);
+	if(p == NULL) return 0;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->accelerometer_data_count = (uint8_t) *(p + 6);
+	if(dst->accelerometer_data_count > 100) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->accelerometer_data_count)*2);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->accelerometer_data_count; i++) AccelerometerData_get(p + i*2, &(dst->accelerometer_data[i]), endianness);
+	return 1;
+}
+
+uint8_t AccelerometerInterruptChunk_encode(tb_ostream_t* ostream, const AccelerometerInterruptChunk* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, AccelerometerInterruptChunk_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, AccelerometerInterruptChunk_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerInterruptChunk_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerInterruptChunk_decode(tb_istream_t* istream, AccelerometerInterruptChunk* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, AccelerometerInterruptChunk_fields, dst, endianness);
+	p = tb_istream_consume(istream, AccelerometerInterruptChunk_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerInterruptChunk_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t DownloadCursor_encode(tb_ostream_t* ostream, const DownloadCursor* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, DownloadCursor_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, DownloadCursor_ENCODED_LEN);
+	if(p == NULL) return 0;
+	DownloadCursor_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t DownloadCursor_decode(tb_istream_t* istream, DownloadCursor* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, DownloadCursor_fields, dst, endianness);
+	p = tb_istream_consume(istream, DownloadCursor_ENCODED_LEN);
+	if(p == NULL) return 0;
+	DownloadCursor_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t DownloadCursorTable_encode(tb_ostream_t* ostream, const DownloadCursorTable* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, DownloadCursorTable_fields, (void*) src, endianness);
+	if(src->download_cursors_count > 4) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->download_cursors_count)*12);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->download_cursors_count;
+	for(uint32_t i = 0; i < src->download_cursors_count; i++) DownloadCursor_put(p + 1 + i*12, &(src->download_cursors[i]), endianness);
+	return 1;
+}
+
+uint8_t DownloadCursorTable_decode(tb_istream_t* istream, DownloadCursorTable* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, DownloadCursorTable_fields, dst, endianness);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->download_cursors_count = (uint8_t) *(p);
+	if(dst->download_cursors_count > 4) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->download_cursors_count)*12);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->download_cursors_count; i++) DownloadCursor_get(p + i*12, &(dst->download_cursors[i]), endianness);
+	return 1;
+}
+
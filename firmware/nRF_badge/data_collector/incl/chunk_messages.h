@@ -7,6 +7,8 @@
 
 #define MICROPHONE_CHUNK_DATA_SIZE 114
 #define ACCELEROMETER_CHUNK_DATA_SIZE 100
+#define DOWNLOAD_CURSOR_PARTITIONS 5
+#define DOWNLOAD_CURSOR_TABLE_SIZE 4
 #define SCAN_CHUNK_DATA_SIZE 29
 #define SCAN_SAMPLING_CHUNK_DATA_SIZE 255
 #define SCAN_CHUNK_AGGREGATE_TYPE_MAX 0
@@ -47,11 +49,80 @@ typedef struct {
 	Timestamp timestamp;
 } AccelerometerInterruptChunk;
 
+typedef struct {
+	uint16_t hub_id;
+	uint16_t record_ids[5];
+} DownloadCursor;
+
+typedef struct {
+	uint8_t download_cursors_count;
+	DownloadCursor download_cursors[4];
+} DownloadCursorTable;
+
 extern const tb_field_t BatteryChunk_fields[3];
 extern const tb_field_t MicrophoneChunk_fields[4];
 extern const tb_field_t ScanSamplingChunk_fields[3];
 extern const tb_field_t ScanChunk_fields[3];
 extern const tb_field_t AccelerometerChunk_fields[3];
 extern const tb_field_t AccelerometerInterruptChunk_fields[2];
+extern const tb_field_t DownloadCursor_fields[3];
+extern const tb_field_t DownloadCursorTable_fields[2];
+
+/**< Straight-line encode/decode functions (same binary representation as tb_encode()/tb_decode() with the _fields-arrays) */
+#define BatteryChunk_ENCODED_LEN 10
+static inline void BatteryChunk_put(uint8_t* p, const BatteryChunk* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	BatteryData_put(p + 6, &(src->battery_data), endianness);
+}
+static inline void BatteryChunk_get(const uint8_t* p, BatteryChunk* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	BatteryData_get(p + 6, &(dst->battery_data), endianness);
+}
+uint8_t BatteryChunk_encode(tb_ostream_t* ostream, const BatteryChunk* src, tb_endian_t endianness);
+uint8_t BatteryChunk_decode(tb_istream_t* istream, BatteryChunk* dst, tb_endian_t endianness);
+
+uint8_t MicrophoneChunk_encode(tb_ostream_t* ostream, const MicrophoneChunk* src, tb_endian_t endianness);
+uint8_t MicrophoneChunk_decode(tb_istream_t* istream, MicrophoneChunk* dst, tb_endian_t endianness);
+
+uint8_t ScanSamplingChunk_encode(tb_ostream_t* ostream, const ScanSamplingChunk* src, tb_endian_t endianness);
+uint8_t ScanSamplingChunk_decode(tb_istream_t* istream, ScanSamplingChunk* dst, tb_endian_t endianness);
+
+uint8_t ScanChunk_encode(tb_ostream_t* ostream, const ScanChunk* src, tb_endian_t endianness);
+uint8_t ScanChunk_decode(tb_istream_t* istream, ScanChunk* dst, tb_endian_t endianness);
+
+uint8_t AccelerometerChunk_encode(tb_ostream_t* ostream, const AccelerometerChunk* src, tb_endian_t endianness);
+uint8_t AccelerometerChunk_decode(tb_istream_t* istream, AccelerometerChunk* dst, tb_endian_t endianness);
+
+#define AccelerometerInterruptChunk_ENCODED_LEN 6
+static inline void AccelerometerInterruptChunk_put(uint8_t* p, const AccelerometerInterruptChunk* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+}
+static inline void AccelerometerInterruptChunk_get(const uint8_t* p, AccelerometerInterruptChunk* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+}
+uint8_t AccelerometerInterruptChunk_encode(tb_ostream_t* ostream, const AccelerometerInterruptChunk* src, tb_endian_t endianness);
+uint8_t AccelerometerInterruptChunk_decode(tb_istream_t* istream, AccelerometerInterruptChunk* dst, tb_endian_t endianness);
+
+#define DownloadCursor_ENCODED_LEN 12
+static inline void DownloadCursor_put(uint8_t* p, const DownloadCursor* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	tb_put_16(p, (uint16_t) src->hub_id, endianness);
+	for(uint32_t i = 0; i < 5; i++) tb_put_16(p + 2 + i*2, (uint16_t) src->record_ids[i], endianness);
+}
+static inline void DownloadCursor_get(const uint8_t* p, DownloadCursor* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->hub_id = (uint16_t) tb_get_16(p, endianness);
+	for(uint32_t i = 0; i < 5; i++) dst->record_ids[i] = (uint16_t) tb_get_16(p + 2 + i*2, endianness);
+}
+uint8_t DownloadCursor_encode(tb_ostream_t* ostream, const DownloadCursor* src, tb_endian_t endianness);
+uint8_t DownloadCursor_decode(tb_istream_t* istream, DownloadCursor* dst, tb_endian_t endianness);
+
+uint8_t DownloadCursorTable_encode(tb_ostream_t* ostream, const DownloadCursorTable* src, tb_endian_t endianness);
+uint8_t DownloadCursorTable_decode(tb_istream_t* istream, DownloadCursorTable* dst, tb_endian_t endianness);
+
 
 #endif
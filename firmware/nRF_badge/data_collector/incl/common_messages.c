@@ -45,3 +45,147 @@ const tb_field_t AccelerometerRawData_fields[2] = {
 	TB_LAST_FIELD,
 };
 
+uint8_t Timestamp_encode(tb_ostream_t* ostream, const Timestamp* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, Timestamp_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, Timestamp_ENCODED_LEN);
+	if(p == NULL) return 0;
+	Timestamp_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t Timestamp_decode(tb_istream_t* istream, Timestamp* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, Timestamp_fields, dst, endianness);
+	p = tb_istream_consume(istream, Timestamp_ENCODED_LEN);
+	if(p == NULL) return 0;
+	Timestamp_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t BadgeAssignement_encode(tb_ostream_t* ostream, const BadgeAssignement* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, BadgeAssignement_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, BadgeAssignement_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BadgeAssignement_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t BadgeAssignement_decode(tb_istream_t* istream, BadgeAssignement* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, BadgeAssignement_fields, dst, endianness);
+	p = tb_istream_consume(istream, BadgeAssignement_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BadgeAssignement_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t BatteryData_encode(tb_ostream_t* ostream, const BatteryData* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, BatteryData_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, BatteryData_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BatteryData_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t BatteryData_decode(tb_istream_t* istream, BatteryData* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, BatteryData_fields, dst, endianness);
+	p = tb_istream_consume(istream, BatteryData_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BatteryData_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t MicrophoneData_encode(tb_ostream_t* ostream, const MicrophoneData* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, MicrophoneData_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, MicrophoneData_ENCODED_LEN);
+	if(p == NULL) return 0;
+	MicrophoneData_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t MicrophoneData_decode(tb_istream_t* istream, MicrophoneData* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, MicrophoneData_fields, dst, endianness);
+	p = tb_istream_consume(istream, MicrophoneData_ENCODED_LEN);
+	if(p == NULL) return 0;
+	MicrophoneData_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t ScanDevice_encode(tb_ostream_t* ostream, const ScanDevice* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, ScanDevice_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, ScanDevice_ENCODED_LEN);
+	if(p == NULL) return 0;
+	ScanDevice_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t ScanDevice_decode(tb_istream_t* istream, ScanDevice* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, ScanDevice_fields, dst, endianness);
+	p = tb_istream_consume(istream, ScanDevice_ENCODED_LEN);
+	if(p == NULL) return 0;
+	ScanDevice_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t ScanResultData_encode(tb_ostream_t* ostream, const ScanResultData* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, ScanResultData_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, ScanResultData_ENCODED_LEN);
+	if(p == NULL) return 0;
+	ScanResultData_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t ScanResultData_decode(tb_istream_t* istream, ScanResultData* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, ScanResultData_fields, dst, endianness);
+	p = tb_istream_consume(istream, ScanResultData_ENCODED_LEN);
+	if(p == NULL) return 0;
+	ScanResultData_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerData_encode(tb_ostream_t* ostream, const AccelerometerData* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, AccelerometerData_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, AccelerometerData_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerData_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerData_decode(tb_istream_t* istream, AccelerometerData* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, AccelerometerData_fields, dst, endianness);
+	p = tb_istream_consume(istream, AccelerometerData_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerData_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerRawData_encode(tb_ostream_t* ostream, const AccelerometerRawData* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, AccelerometerRawData_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, AccelerometerRawData_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerRawData_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerRawData_decode(tb_istream_t* istream, AccelerometerRawData* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, AccelerometerRawData_fields, dst, endianness);
+	p = tb_istream_consume(istream, AccelerometerRawData_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerRawData_get(p, dst, endianness);
+	return 1;
+}
+
@@ -51,4 +51,110 @@ extern const tb_field_t ScanResultData_fields[3];
 extern const tb_field_t AccelerometerData_fields[2];
 extern const tb_field_t AccelerometerRawData_fields[2];
 
+/**< Straight-line encode/decode functions (same binary representation as tb_encode()/tb_decode() with the _fields-arrays) */
+#define Timestamp_ENCODED_LEN 6
+static inline void Timestamp_put(uint8_t* p, const Timestamp* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	tb_put_32(p, (uint32_t) src->seconds, endianness);
+	tb_put_16(p + 4, (uint16_t) src->ms, endianness);
+}
+static inline void Timestamp_get(const uint8_t* p, Timestamp* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->seconds = (uint32_t) tb_get_32(p, endianness);
+	dst->ms = (uint16_t) tb_get_16(p + 4, endianness);
+}
+uint8_t Timestamp_encode(tb_ostream_t* ostream, const Timestamp* src, tb_endian_t endianness);
+uint8_t Timestamp_decode(tb_istream_t* istream, Timestamp* dst, tb_endian_t endianness);
+
+#define BadgeAssignement_ENCODED_LEN 3
+static inline void BadgeAssignement_put(uint8_t* p, const BadgeAssignement* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	tb_put_16(p, (uint16_t) src->ID, endianness);
+	*(p + 2) = (uint8_t) src->group;
+}
+static inline void BadgeAssignement_get(const uint8_t* p, BadgeAssignement* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->ID = (uint16_t) tb_get_16(p, endianness);
+	dst->group = (uint8_t) *(p + 2);
+}
+uint8_t BadgeAssignement_encode(tb_ostream_t* ostream, const BadgeAssignement* src, tb_endian_t endianness);
+uint8_t BadgeAssignement_decode(tb_istream_t* istream, BadgeAssignement* dst, tb_endian_t endianness);
+
+#define BatteryData_ENCODED_LEN 4
+static inline void BatteryData_put(uint8_t* p, const BatteryData* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	tb_put_float(p, src->voltage, endianness);
+}
+static inline void BatteryData_get(const uint8_t* p, BatteryData* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->voltage = tb_get_float(p, endianness);
+}
+uint8_t BatteryData_encode(tb_ostream_t* ostream, const BatteryData* src, tb_endian_t endianness);
+uint8_t BatteryData_decode(tb_istream_t* istream, BatteryData* dst, tb_endian_t endianness);
+
+#define MicrophoneData_ENCODED_LEN 1
+static inline void MicrophoneData_put(uint8_t* p, const MicrophoneData* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	*(p) = (uint8_t) src->value;
+}
+static inline void MicrophoneData_get(const uint8_t* p, MicrophoneData* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->value = (uint8_t) *(p);
+}
+uint8_t MicrophoneData_encode(tb_ostream_t* ostream, const MicrophoneData* src, tb_endian_t endianness);
+uint8_t MicrophoneData_decode(tb_istream_t* istream, MicrophoneData* dst, tb_endian_t endianness);
+
+#define ScanDevice_ENCODED_LEN 3
+static inline void ScanDevice_put(uint8_t* p, const ScanDevice* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	tb_put_16(p, (uint16_t) src->ID, endianness);
+	*(p + 2) = (uint8_t) src->rssi;
+}
+static inline void ScanDevice_get(const uint8_t* p, ScanDevice* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->ID = (uint16_t) tb_get_16(p, endianness);
+	dst->rssi = (int8_t) *(p + 2);
+}
+uint8_t ScanDevice_encode(tb_ostream_t* ostream, const ScanDevice* src, tb_endian_t endianness);
+uint8_t ScanDevice_decode(tb_istream_t* istream, ScanDevice* dst, tb_endian_t endianness);
+
+#define ScanResultData_ENCODED_LEN 4
+static inline void ScanResultData_put(uint8_t* p, const ScanResultData* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	ScanDevice_put(p, &(src->scan_device), endianness);
+	*(p + 3) = (uint8_t) src->count;
+}
+static inline void ScanResultData_get(const uint8_t* p, ScanResultData* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	ScanDevice_get(p, &(dst->scan_device), endianness);
+	dst->count = (uint8_t) *(p + 3);
+}
+uint8_t ScanResultData_encode(tb_ostream_t* ostream, const ScanResultData* src, tb_endian_t endianness);
+uint8_t ScanResultData_decode(tb_istream_t* istream, ScanResultData* dst, tb_endian_t endianness);
+
+#define AccelerometerData_ENCODED_LEN 2
+static inline void AccelerometerData_put(uint8_t* p, const AccelerometerData* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	tb_put_16(p, (uint16_t) src->acceleration, endianness);
+}
+static inline void AccelerometerData_get(const uint8_t* p, AccelerometerData* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->acceleration = (uint16_t) tb_get_16(p, endianness);
+}
+uint8_t AccelerometerData_encode(tb_ostream_t* ostream, const AccelerometerData* src, tb_endian_t endianness);
+uint8_t AccelerometerData_decode(tb_istream_t* istream, AccelerometerData* dst, tb_endian_t endianness);
+
+#define AccelerometerRawData_ENCODED_LEN 6
+static inline void AccelerometerRawData_put(uint8_t* p, const AccelerometerRawData* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	for(uint32_t i = 0; i < 3; i++) tb_put_16(p + i*2, (uint16_t) src->raw_acceleration[i], endianness);
+}
+static inline void AccelerometerRawData_get(const uint8_t* p, AccelerometerRawData* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	for(uint32_t i = 0; i < 3; i++) dst->raw_acceleration[i] = (int16_t) tb_get_16(p + i*2, endianness);
+}
+uint8_t AccelerometerRawData_encode(tb_ostream_t* ostream, const AccelerometerRawData* src, tb_endian_t endianness);
+uint8_t AccelerometerRawData_decode(tb_istream_t* istream, AccelerometerRawData* dst, tb_endian_t endianness);
+
+
 #endif
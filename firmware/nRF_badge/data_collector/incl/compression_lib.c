@@ -0,0 +1,111 @@
+#include "compression_lib.h"
+
+#include "stdlib.h" // Needed for NULL definition
+
+
+
+/**@brief Function to search the longest match of the bytes at data[pos] in the window before pos.
+ *
+ * @param[in]	data		Pointer to the data.
+ * @param[in]	len			The number of bytes of the data.
+ * @param[in]	pos			The current position in the data.
+ * @param[out]	offset		The offset of the longest match (only valid if the returned length is > 0).
+ *
+ * @retval	The length of the longest match, or 0 if there is no match of at least COMPRESSION_MIN_MATCH_LEN bytes.
+ */
+static uint32_t find_longest_match(const uint8_t* data, uint32_t len, uint32_t pos, uint32_t* offset) {
+	uint32_t max_match_len = len - pos;
+	if(max_match_len > COMPRESSION_MAX_MATCH_LEN)
+		max_match_len = COMPRESSION_MAX_MATCH_LEN;
+	if(max_match_len < COMPRESSION_MIN_MATCH_LEN)
+		return 0;
+
+	uint32_t window_start = (pos > COMPRESSION_WINDOW_SIZE) ? (pos - COMPRESSION_WINDOW_SIZE) : 0;
+	uint32_t best_len = 0;
+	// Search from the nearest position backwards, so that the smallest offset wins on equal lengths
+	for(uint32_t candidate = pos; candidate > window_start; ) {
+		candidate--;
+		// Quick check of the first byte and of the byte that would make the match longer than the current best one
+		if(data[candidate] != data[pos] || data[candidate + best_len] != data[pos + best_len])
+			continue;
+
+		uint32_t match_len = 1;
+		while(match_len < max_match_len && data[candidate + match_len] == data[pos + match_len])
+			match_len++;
+
+		if(match_len > best_len) {
+			best_len = match_len;
+			*offset = pos - candidate;
+			if(best_len >= max_match_len)
+				break;
+		}
+	}
+	return (best_len >= COMPRESSION_MIN_MATCH_LEN) ? best_len : 0;
+}
+
+ret_code_t compression_compress(const uint8_t* data, uint32_t len, uint8_t* compressed, uint32_t max_compressed_len, uint32_t* compressed_len) {
+	uint32_t pos = 0;
+	uint32_t out_pos = 0;
+	uint32_t flag_pos = 0;
+	uint8_t item = 8;	// Number of items in the current group
+
+	while(pos < len) {
+		if(item >= 8) {	// Start a new group with a flag-byte
+			if(out_pos >= max_compressed_len)
+				return NRF_ERROR_NO_MEM;
+			flag_pos = out_pos++;
+			compressed[flag_pos] = 0;
+			item = 0;
+		}
+
+		uint32_t offset = 0;
+		uint32_t match_len = find_longest_match(data, len, pos, &offset);
+		if(match_len > 0) {
+			if(out_pos + 2 > max_compressed_len)
+				return NRF_ERROR_NO_MEM;
+			compressed[flag_pos] |= (uint8_t) (1 << item);
+			compressed[out_pos++] = (uint8_t) (offset - 1);
+			compressed[out_pos++] = (uint8_t) (match_len - COMPRESSION_MIN_MATCH_LEN);
+			pos += match_len;
+		} else {
+			if(out_pos + 1 > max_compressed_len)
+				return NRF_ERROR_NO_MEM;
+			compressed[out_pos++] = data[pos++];
+		}
+		item++;
+	}
+
+	*compressed_len = out_pos;
+	return NRF_SUCCESS;
+}
+
+ret_code_t compression_decompress(const uint8_t* compressed, uint32_t compressed_len, uint8_t* data, uint32_t max_len, uint32_t* len) {
+	uint32_t pos = 0;
+	uint32_t out_pos = 0;
+
+	while(pos < compressed_len) {
+		uint8_t flags = compressed[pos++];
+		for(uint8_t item = 0; item < 8 && pos < compressed_len; item++) {
+			if(flags & (1 << item)) {
+				if(pos + 2 > compressed_len)
+					return NRF_ERROR_INVALID_DATA;
+				uint32_t offset = ((uint32_t) compressed[pos++]) + 1;
+				uint32_t match_len = ((uint32_t) compressed[pos++]) + COMPRESSION_MIN_MATCH_LEN;
+				if(offset > out_pos)
+					return NRF_ERROR_INVALID_DATA;
+				if(out_pos + match_len > max_len)
+					return NRF_ERROR_NO_MEM;
+				// Byte by byte, because the match may overlap with the bytes it produces
+				for(uint32_t i = 0; i < match_len; i++, out_pos++)
+					data[out_pos] = data[out_pos - offset];
+			} else {
+				if(out_pos + 1 > max_len)
+					return NRF_ERROR_NO_MEM;
+				data[out_pos++] = compressed[pos++];
+			}
+		}
+	}
+
+	*len = out_pos;
+	return NRF_SUCCESS;
+}
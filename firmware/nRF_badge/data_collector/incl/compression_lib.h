@@ -0,0 +1,58 @@
+/**@file
+ * @details A small LZSS compressor for the transmitted responses (similar to heatshrink).
+ *			The window is the data buffer itself, so no additional RAM is needed for the compression state.
+ *
+ *			Format: The compressed data consist of groups of up to 8 items, each group is preceded by a flag-byte.
+ *			Bit i (LSB first) of the flag-byte describes item i:
+ *				0: Literal, one byte that is copied to the output.
+ *				1: Match, two bytes: (offset - 1) [1..COMPRESSION_WINDOW_SIZE] and (length - COMPRESSION_MIN_MATCH_LEN).
+ *				   length bytes are copied from offset bytes before the current output position (the areas may overlap).
+ */
+
+#ifndef __COMPRESSION_LIB_H
+#define __COMPRESSION_LIB_H
+
+#include "stdint.h"
+#include "sdk_errors.h"	// Needed for the definition of ret_code_t and the error-codes
+
+
+#define COMPRESSION_WINDOW_SIZE			256		/**< Maximum offset of a match */
+#define COMPRESSION_MIN_MATCH_LEN		3		/**< Minimum length of a match (shorter matches don't save bytes) */
+#define COMPRESSION_MAX_MATCH_LEN		(COMPRESSION_MIN_MATCH_LEN + 255)	/**< Maximum length of a match */
+
+/**< The maximum compressed length of len bytes (if there is no match at all: a flag-byte for every 8 literals). */
+#define COMPRESSION_MAX_COMPRESSED_LEN(len)	((len) + ((len) + 7)/8)
+
+
+/**@brief Function to compress data.
+ *
+ * @param[in]	data				Pointer to the data that should be compressed.
+ * @param[in]	len					The number of bytes to compress.
+ * @param[out]	compressed			Pointer to the buffer for the compressed data.
+ * @param[in]	max_compressed_len	The size of the compressed buffer.
+ * @param[out]	compressed_len		The number of bytes of the compressed data.
+ *
+ * @retval	NRF_SUCCESS			If the data were compressed successfully.
+ * @retval	NRF_ERROR_NO_MEM	If the compressed data don't fit into the compressed buffer.
+ *
+ * @note	Use a max_compressed_len < len, to stop early if the compression doesn't save any bytes.
+ */
+ret_code_t compression_compress(const uint8_t* data, uint32_t len, uint8_t* compressed, uint32_t max_compressed_len, uint32_t* compressed_len);
+
+
+/**@brief Function to decompress data that were compressed with compression_compress().
+ *
+ * @param[in]	compressed			Pointer to the compressed data.
+ * @param[in]	compressed_len		The number of bytes of the compressed data.
+ * @param[out]	data				Pointer to the buffer for the decompressed data.
+ * @param[in]	max_len				The size of the data buffer.
+ * @param[out]	len					The number of bytes of the decompressed data.
+ *
+ * @retval	NRF_SUCCESS				If the data were decompressed successfully.
+ * @retval	NRF_ERROR_NO_MEM		If the decompressed data don't fit into the data buffer.
+ * @retval	NRF_ERROR_INVALID_DATA	If the compressed data are malformed.
+ */
+ret_code_t compression_decompress(const uint8_t* compressed, uint32_t compressed_len, uint8_t* data, uint32_t max_len, uint32_t* len);
+
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "stdio.h"
 #include "string.h"	// For memcpy
+#include "trace_lib.h"
 
 #define ITERATOR_VALID_NUMBER	0xA5
 
@@ -903,7 +904,10 @@ ret_code_t filesystem_clear_partition(uint16_t partition_id) {
 
 
 
-ret_code_t filesystem_store_element(uint16_t partition_id, uint8_t* element_data, uint16_t element_len) {
+/**@brief Function that actually stores an element (see filesystem_store_element()). 
+ *			It is wrapped by filesystem_store_element() to trace the complete store-operation.
+ */
+static ret_code_t filesystem_store_element_internal(uint16_t partition_id, uint8_t* element_data, uint16_t element_len) {
 	uint16_t index = partition_id & 0x3FFF;
 	uint8_t is_dynamic = (partition_id & 0x8000) ? 1 : 0;
 	
@@ -1149,6 +1153,13 @@ ret_code_t filesystem_store_element(uint16_t partition_id, uint8_t* element_data
 	
 }
 
+ret_code_t filesystem_store_element(uint16_t partition_id, uint8_t* element_data, uint16_t element_len) {
+	TRACE_BEGIN(TRACE_EVENT_FILESYSTEM_STORE, partition_id);
+	ret_code_t ret = filesystem_store_element_internal(partition_id, element_data, element_len);
+	TRACE_END(TRACE_EVENT_FILESYSTEM_STORE, element_len);
+	return ret;
+}
+
 
 
 
@@ -1368,7 +1379,7 @@ ret_code_t filesystem_iterator_previous(uint16_t partition_id) {
 	return NRF_SUCCESS;
 }
 
-ret_code_t filesystem_iterator_read_element(uint16_t partition_id, uint8_t* element_data, uint16_t* element_len, uint16_t* record_id) {
+ret_code_t filesystem_iterator_read_element(uint16_t partition_id, uint8_t* element_data, uint16_t max_element_len, uint16_t* element_len, uint16_t* record_id) {
 	ret_code_t ret = filesystem_iterator_check_validity(partition_id);
 	if(ret != NRF_SUCCESS)
 		return ret;
@@ -1383,6 +1394,10 @@ ret_code_t filesystem_iterator_read_element(uint16_t partition_id, uint8_t* elem
 	
 	
 	uint32_t header_len = (cur_element_address == partitions[index].first_element_address) ? (PARTITION_METADATA_SIZE + filesystem_get_element_header_len(partition_id)) : (filesystem_get_element_header_len(partition_id));
+	
+	// The element-length of a dynamic partition is read from the header, that could be corrupted (e.g. by a power loss during the store)
+	if(*element_len > max_element_len)
+		return NRF_ERROR_INVALID_DATA;
 		
 	ret = storage_read(cur_element_address + header_len, element_data, *element_len);
 	if(ret != NRF_SUCCESS) return NRF_ERROR_INTERNAL;
@@ -1400,3 +1415,14 @@ ret_code_t filesystem_iterator_read_element(uint16_t partition_id, uint8_t* elem
 	return NRF_SUCCESS;
 }
 
+ret_code_t filesystem_iterator_get_record_id(uint16_t partition_id, uint16_t* record_id) {
+	ret_code_t ret = filesystem_iterator_check_validity(partition_id);
+	if(ret != NRF_SUCCESS)
+		return ret;
+	
+	uint16_t index = partition_id & 0x3FFF;	// Clear the MSBs
+	*record_id = partition_iterators[index].cur_element_header.record_id;
+	
+	return NRF_SUCCESS;
+}
+
@@ -262,15 +262,30 @@ ret_code_t filesystem_iterator_previous(uint16_t partition_id);
  * 
  * @param[in]	partition_id				The identifier of the partition.
  * @param[out]	element_data				Pointer to buffer where the data should be stored to.
+ * @param[in]	max_element_len				The size of the element_data buffer.
  * @param[out]	element_len					Pointer to memory where the data length should stored to.
  * @param[out]	record_id					Pointer to memory where the record-id should stored to.
  * 
  * @retval 		NRF_SUCCESS					If operation was successful.
- * @retval		NRF_ERROR_INVALID_DATA		If CRC is enabled and the data are corrupted.
+ * @retval		NRF_ERROR_INVALID_DATA		If CRC is enabled and the data are corrupted, or the element is larger than max_element_len (e.g. a corrupted header after a power loss).
  * @retval		NRF_ERROR_INVALID_STATE		If the iterator was invalidated.
  * @retval     	NRF_ERROR_INTERNAL  		If there was an internal error (e.g. the data couldn't be read because of busy).
  */
-ret_code_t filesystem_iterator_read_element(uint16_t partition_id, uint8_t* element_data, uint16_t* element_len, uint16_t* record_id);
+ret_code_t filesystem_iterator_read_element(uint16_t partition_id, uint8_t* element_data, uint16_t max_element_len, uint16_t* element_len, uint16_t* record_id);
+
+/** @brief Function to get the record-id of the element the iterator is currently pointing to.
+ *
+ * @details	In contrast to filesystem_iterator_read_element() the element data are not read, 
+ *			so it is cheap to locate an element by its record-id.
+ * 
+ * @param[in]	partition_id				The identifier of the partition.
+ * @param[out]	record_id					Pointer to memory where the record-id should stored to.
+ * 
+ * @retval 		NRF_SUCCESS					If operation was successful.
+ * @retval		NRF_ERROR_INVALID_STATE		If the iterator was invalidated.
+ * @retval     	NRF_ERROR_INTERNAL  		If there was an internal error (e.g. the data couldn't be read because of busy).
+ */
+ret_code_t filesystem_iterator_get_record_id(uint16_t partition_id, uint16_t* record_id);
 
 
 
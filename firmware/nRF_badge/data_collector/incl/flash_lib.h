@@ -28,7 +28,7 @@
 
 
 // TODO: define this by the linker script with enough space for new program code!
-#ifdef UNIT_TEST
+#if defined(UNIT_TEST) && !defined(BADGE_SIM)	// The badge simulator has the flash of the firmware, so that all storer-partitions fit
 #define FLASH_NUM_PAGES 30	
 #else
 #ifdef DEBUG_LOG_ENABLE
@@ -1,6 +1,6 @@
 #include "processing_lib.h"
 #include <stdlib.h>		// For qsort
-#include "app_scheduler.h"
+#include "scheduler_lib.h"
 
 #include "sampling_lib.h"
 #include "chunk_fifo_lib.h"
@@ -12,8 +12,6 @@
 #include "debug_lib.h"
 
 
-static ScanChunk scan_chunk;	/**< A Scan-chunk structure, needed to convert from ScanSamplingChunk to ScanChunk */
-
 /************************** ACCELEROMETER ***********************/
 void processing_process_accelerometer_chunk(void * p_event_data, uint16_t event_size) {
 	//debug_log("PROCESSING: processing_process_accelerometer_chunk...\n");
@@ -23,7 +21,7 @@ void processing_process_accelerometer_chunk(void * p_event_data, uint16_t event_
 		ret_code_t ret = storer_store_accelerometer_chunk(accelerometer_chunk);
 		debug_log("PROCESSING: Try to store accelerometer chunk: Ret %d\n", ret);
 		if(ret == NRF_ERROR_INTERNAL) {	// E.g. if busy --> reschedule
-			app_sched_event_put(NULL, 0, processing_process_accelerometer_chunk);
+			scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_process_accelerometer_chunk);
 			break;
 		} else {
 			chunk_fifo_read_close(&accelerometer_chunk_fifo);	
@@ -40,7 +38,7 @@ void processing_process_accelerometer_interrupt_chunk(void * p_event_data, uint1
 		ret_code_t ret = storer_store_accelerometer_interrupt_chunk(accelerometer_interrupt_chunk);
 		debug_log("PROCESSING: Try to store accelerometer interrupt chunk: Ret %d\n", ret);
 		if(ret == NRF_ERROR_INTERNAL) {	// E.g. if busy --> reschedule
-			app_sched_event_put(NULL, 0, processing_process_accelerometer_interrupt_chunk);
+			scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_process_accelerometer_interrupt_chunk);
 			break;
 		} else {
 			chunk_fifo_read_close(&accelerometer_interrupt_chunk_fifo);	
@@ -57,7 +55,7 @@ void processing_process_battery_chunk(void * p_event_data, uint16_t event_size)
 		ret_code_t ret = storer_store_battery_chunk(battery_chunk);		
 		debug_log("PROCESSING: Try to store battery chunk: Ret %d\n", ret);
 		if(ret == NRF_ERROR_INTERNAL) {	// E.g. if busy --> reschedule
-			app_sched_event_put(NULL, 0, processing_process_battery_chunk);
+			scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_process_battery_chunk);
 			break;
 		} else {
 			chunk_fifo_read_close(&battery_chunk_fifo);	
@@ -75,7 +73,7 @@ void processing_process_microphone_chunk(void * p_event_data, uint16_t event_siz
 		ret_code_t ret = storer_store_microphone_chunk(microphone_chunk);		
 		debug_log("PROCESSING: Try to store microphone chunk: Ret %d\n", ret);
 		if(ret == NRF_ERROR_INTERNAL) {	// E.g. if busy --> reschedule
-			app_sched_event_put(NULL, 0, processing_process_microphone_chunk);
+			scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_process_microphone_chunk);
 			break;
 		} else {
 			chunk_fifo_read_close(&microphone_chunk_fifo);	
@@ -171,6 +169,14 @@ static void sort_scan(ScanSamplingChunk* scan_sampling_chunk) {
 	qsort(&((scan_sampling_chunk->scan_result_data)[prioritized_beacons]), scan_sampling_chunk->scan_result_data_count - num_beacons, sizeof(ScanResultData), compare_by_RSSI);
 }
 
+#ifdef UNIT_TEST
+/**@brief (Private) Function to sort the seen devices like sort_scan() (only for testing purposes, e.g. for the performance suite).
+ */
+void processing_sort_scan(ScanSamplingChunk* scan_sampling_chunk) {
+	sort_scan(scan_sampling_chunk);
+}
+#endif
+
 void processing_process_scan_sampling_chunk(void * p_event_data, uint16_t event_size) {
 	//debug_log("PROCESSING: processing_process_scan_sampling_chunk...\n");
 	ScanSamplingChunk* scan_sampling_chunk;
@@ -182,16 +188,11 @@ void processing_process_scan_sampling_chunk(void * p_event_data, uint16_t event_
 			scan_sampling_chunk->scan_result_data_count = SCAN_CHUNK_DATA_SIZE;
 		}
 		
-		scan_chunk.timestamp = scan_sampling_chunk->timestamp;
-		scan_chunk.scan_result_data_count = scan_sampling_chunk->scan_result_data_count;
-		for(uint32_t i = 0; i < scan_chunk.scan_result_data_count; i++) {
-			scan_chunk.scan_result_data[i] = scan_sampling_chunk->scan_result_data[i];
-		}		
-		
-		ret_code_t ret = storer_store_scan_chunk(&scan_chunk);
+		// Store the chunk directly from the fifo-slot (it is encoded in the ScanChunk-format)
+		ret_code_t ret = storer_store_scan_sampling_chunk(scan_sampling_chunk);
 		debug_log("PROCESSING: Try to store scan chunk: Ret %d\n", ret);
 		if(ret == NRF_ERROR_INTERNAL) {	// E.g. if busy --> reschedule
-			app_sched_event_put(NULL, 0, processing_process_scan_sampling_chunk);
+			scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_process_scan_sampling_chunk);
 			break;
 		} else {
 			chunk_fifo_read_close(&scan_sampling_chunk_fifo);	
@@ -52,10 +52,10 @@ void processing_process_microphone_chunk(void * p_event_data, uint16_t event_siz
 
 /**@brief Function that processes the scanning chunks.
  *
- * @details	It checks for available chunks in the chunk-fifo. In this case not the ScanSamplingChunk-structure is stored but the ScanChunk-structure.
- *			The ScanSamplingChunk-structure can hold much more devices than the ScanChunk-structure that is used for storing.
- *			To get only the relevant devices a sorting mechanism is performed that sortes for strong RSSI-values and prioritzes beacons.
- *			After the sorting, the ScanChunk is stored in the filesystem via the storer-module.
+ * @details	It checks for available chunks in the chunk-fifo. The ScanSamplingChunk-structure can hold much more devices than the ScanChunk-format that is used for storing.
+ *			To get only the relevant devices a sorting mechanism is performed in place that sortes for strong RSSI-values and prioritzes beacons.
+ *			After the sorting, the chunk is stored directly from the chunk-fifo slot in the ScanChunk-format via the storer-module
+ *			(without copying it into an intermediate ScanChunk-structure).
  *
  * @param[in] p_event_data	Pointer to event data (actually always == NULL).
  * @param[in] event_size	Event data size (actually always == 0).
@@ -99,6 +99,44 @@ const tb_field_t BatteryDataRequest_fields[2] = {
 	TB_LAST_FIELD,
 };
 
+const tb_field_t ExportCursor_fields[6] = {
+	{65, tb_offsetof(ExportCursor, microphone_record_id), 0, 0, tb_membersize(ExportCursor, microphone_record_id), 0, 0, 0, NULL},
+	{65, tb_offsetof(ExportCursor, scan_record_id), 0, 0, tb_membersize(ExportCursor, scan_record_id), 0, 0, 0, NULL},
+	{65, tb_offsetof(ExportCursor, accelerometer_record_id), 0, 0, tb_membersize(ExportCursor, accelerometer_record_id), 0, 0, 0, NULL},
+	{65, tb_offsetof(ExportCursor, accelerometer_interrupt_record_id), 0, 0, tb_membersize(ExportCursor, accelerometer_interrupt_record_id), 0, 0, 0, NULL},
+	{65, tb_offsetof(ExportCursor, battery_record_id), 0, 0, tb_membersize(ExportCursor, battery_record_id), 0, 0, 0, NULL},
+	TB_LAST_FIELD,
+};
+
+const tb_field_t BulkExportRequest_fields[3] = {
+	{65, tb_offsetof(BulkExportRequest, checkpoint_interval), 0, 0, tb_membersize(BulkExportRequest, checkpoint_interval), 0, 0, 0, NULL},
+	{514, tb_offsetof(BulkExportRequest, cursor), tb_delta(BulkExportRequest, has_cursor, cursor), 1, tb_membersize(BulkExportRequest, cursor), 0, 0, 0, &ExportCursor_fields},
+	TB_LAST_FIELD,
+};
+
+const tb_field_t PullNewDataRequest_fields[3] = {
+	{65, tb_offsetof(PullNewDataRequest, hub_id), 0, 0, tb_membersize(PullNewDataRequest, hub_id), 0, 0, 0, NULL},
+	{65, tb_offsetof(PullNewDataRequest, checkpoint_interval), 0, 0, tb_membersize(PullNewDataRequest, checkpoint_interval), 0, 0, 0, NULL},
+	TB_LAST_FIELD,
+};
+
+const tb_field_t AcknowledgeDataRequest_fields[3] = {
+	{65, tb_offsetof(AcknowledgeDataRequest, hub_id), 0, 0, tb_membersize(AcknowledgeDataRequest, hub_id), 0, 0, 0, NULL},
+	{513, tb_offsetof(AcknowledgeDataRequest, cursor), 0, 0, tb_membersize(AcknowledgeDataRequest, cursor), 0, 0, 0, &ExportCursor_fields},
+	TB_LAST_FIELD,
+};
+
+const tb_field_t SetCompressionRequest_fields[2] = {
+	{65, tb_offsetof(SetCompressionRequest, compression), 0, 0, tb_membersize(SetCompressionRequest, compression), 0, 0, 0, NULL},
+	TB_LAST_FIELD,
+};
+
+const tb_field_t SetOverflowPolicyRequest_fields[3] = {
+	{65, tb_offsetof(SetOverflowPolicyRequest, data_source), 0, 0, tb_membersize(SetOverflowPolicyRequest, data_source), 0, 0, 0, NULL},
+	{65, tb_offsetof(SetOverflowPolicyRequest, overflow_policy), 0, 0, tb_membersize(SetOverflowPolicyRequest, overflow_policy), 0, 0, 0, NULL},
+	TB_LAST_FIELD,
+};
+
 const tb_field_t StartMicrophoneStreamRequest_fields[4] = {
 	{513, tb_offsetof(StartMicrophoneStreamRequest, timestamp), 0, 0, tb_membersize(StartMicrophoneStreamRequest, timestamp), 0, 0, 0, &Timestamp_fields},
 	{65, tb_offsetof(StartMicrophoneStreamRequest, timeout), 0, 0, tb_membersize(StartMicrophoneStreamRequest, timeout), 0, 0, 0, NULL},
@@ -176,7 +214,12 @@ const tb_field_t RestartRequest_fields[1] = {
 	TB_LAST_FIELD,
 };
 
-const tb_field_t Request_fields[30] = {
+const tb_field_t DiagnosticsRequest_fields[2] = {
+	{65, tb_offsetof(DiagnosticsRequest, reset_chunk_fifo_status), 0, 0, tb_membersize(DiagnosticsRequest, reset_chunk_fifo_status), 0, 0, 0, NULL},
+	TB_LAST_FIELD,
+};
+
+const tb_field_t Request_fields[36] = {
 	{528, tb_offsetof(Request, type.status_request), tb_delta(Request, which_type, type.status_request), 1, tb_membersize(Request, type.status_request), 0, 1, 1, &StatusRequest_fields},
 	{528, tb_offsetof(Request, type.start_microphone_request), tb_delta(Request, which_type, type.start_microphone_request), 1, tb_membersize(Request, type.start_microphone_request), 0, 2, 0, &StartMicrophoneRequest_fields},
 	{528, tb_offsetof(Request, type.stop_microphone_request), tb_delta(Request, which_type, type.stop_microphone_request), 1, tb_membersize(Request, type.stop_microphone_request), 0, 3, 0, &StopMicrophoneRequest_fields},
@@ -206,10 +249,16 @@ const tb_field_t Request_fields[30] = {
 	{528, tb_offsetof(Request, type.identify_request), tb_delta(Request, which_type, type.identify_request), 1, tb_membersize(Request, type.identify_request), 0, 27, 0, &IdentifyRequest_fields},
 	{528, tb_offsetof(Request, type.test_request), tb_delta(Request, which_type, type.test_request), 1, tb_membersize(Request, type.test_request), 0, 28, 0, &TestRequest_fields},
 	{528, tb_offsetof(Request, type.restart_request), tb_delta(Request, which_type, type.restart_request), 1, tb_membersize(Request, type.restart_request), 0, 29, 0, &RestartRequest_fields},
+	{528, tb_offsetof(Request, type.diagnostics_request), tb_delta(Request, which_type, type.diagnostics_request), 1, tb_membersize(Request, type.diagnostics_request), 0, 30, 0, &DiagnosticsRequest_fields},
+	{528, tb_offsetof(Request, type.bulk_export_request), tb_delta(Request, which_type, type.bulk_export_request), 1, tb_membersize(Request, type.bulk_export_request), 0, 31, 0, &BulkExportRequest_fields},
+	{528, tb_offsetof(Request, type.pull_new_data_request), tb_delta(Request, which_type, type.pull_new_data_request), 1, tb_membersize(Request, type.pull_new_data_request), 0, 32, 0, &PullNewDataRequest_fields},
+	{528, tb_offsetof(Request, type.acknowledge_data_request), tb_delta(Request, which_type, type.acknowledge_data_request), 1, tb_membersize(Request, type.acknowledge_data_request), 0, 33, 0, &AcknowledgeDataRequest_fields},
+	{528, tb_offsetof(Request, type.set_compression_request), tb_delta(Request, which_type, type.set_compression_request), 1, tb_membersize(Request, type.set_compression_request), 0, 34, 0, &SetCompressionRequest_fields},
+	{528, tb_offsetof(Request, type.set_overflow_policy_request), tb_delta(Request, which_type, type.set_overflow_policy_request), 1, tb_membersize(Request, type.set_overflow_policy_request), 0, 35, 0, &SetOverflowPolicyRequest_fields},
 	TB_LAST_FIELD,
 };
 
-const tb_field_t StatusResponse_fields[9] = {
+const tb_field_t StatusResponse_fields[10] = {
 	{65, tb_offsetof(StatusResponse, clock_status), 0, 0, tb_membersize(StatusResponse, clock_status), 0, 0, 0, NULL},
 	{65, tb_offsetof(StatusResponse, microphone_status), 0, 0, tb_membersize(StatusResponse, microphone_status), 0, 0, 0, NULL},
 	{65, tb_offsetof(StatusResponse, scan_status), 0, 0, tb_membersize(StatusResponse, scan_status), 0, 0, 0, NULL},
@@ -218,6 +267,7 @@ const tb_field_t StatusResponse_fields[9] = {
 	{65, tb_offsetof(StatusResponse, battery_status), 0, 0, tb_membersize(StatusResponse, battery_status), 0, 0, 0, NULL},
 	{513, tb_offsetof(StatusResponse, timestamp), 0, 0, tb_membersize(StatusResponse, timestamp), 0, 0, 0, &Timestamp_fields},
 	{513, tb_offsetof(StatusResponse, battery_data), 0, 0, tb_membersize(StatusResponse, battery_data), 0, 0, 0, &BatteryData_fields},
+	{65, tb_offsetof(StatusResponse, dropped_chunks), 0, 0, tb_membersize(StatusResponse, dropped_chunks), 0, 0, 0, NULL},
 	TB_LAST_FIELD,
 };
 
@@ -281,6 +331,22 @@ const tb_field_t BatteryDataResponse_fields[4] = {
 	TB_LAST_FIELD,
 };
 
+const tb_field_t BulkExportCheckpointResponse_fields[3] = {
+	{65, tb_offsetof(BulkExportCheckpointResponse, last_response), 0, 0, tb_membersize(BulkExportCheckpointResponse, last_response), 0, 0, 0, NULL},
+	{513, tb_offsetof(BulkExportCheckpointResponse, cursor), 0, 0, tb_membersize(BulkExportCheckpointResponse, cursor), 0, 0, 0, &ExportCursor_fields},
+	TB_LAST_FIELD,
+};
+
+const tb_field_t SetCompressionResponse_fields[2] = {
+	{65, tb_offsetof(SetCompressionResponse, compression), 0, 0, tb_membersize(SetCompressionResponse, compression), 0, 0, 0, NULL},
+	TB_LAST_FIELD,
+};
+
+const tb_field_t SetOverflowPolicyResponse_fields[2] = {
+	{65, tb_offsetof(SetOverflowPolicyResponse, overflow_policy), 0, 0, tb_membersize(SetOverflowPolicyResponse, overflow_policy), 0, 0, 0, NULL},
+	TB_LAST_FIELD,
+};
+
 const tb_field_t StreamResponse_fields[7] = {
 	{513, tb_offsetof(StreamResponse, timestamp), 0, 0, tb_membersize(StreamResponse, timestamp), 0, 0, 0, &Timestamp_fields},
 	{516, tb_offsetof(StreamResponse, battery_stream), tb_delta(StreamResponse, battery_stream_count, battery_stream), 1, tb_membersize(StreamResponse, battery_stream[0]), tb_membersize(StreamResponse, battery_stream)/tb_membersize(StreamResponse, battery_stream[0]), 0, 0, &BatteryStream_fields},
@@ -296,7 +362,23 @@ const tb_field_t TestResponse_fields[2] = {
 	TB_LAST_FIELD,
 };
 
-const tb_field_t Response_fields[14] = {
+const tb_field_t ChunkFifoStatus_fields[4] = {
+	{65, tb_offsetof(ChunkFifoStatus, dropped_chunks), 0, 0, tb_membersize(ChunkFifoStatus, dropped_chunks), 0, 0, 0, NULL},
+	{65, tb_offsetof(ChunkFifoStatus, high_water_mark), 0, 0, tb_membersize(ChunkFifoStatus, high_water_mark), 0, 0, 0, NULL},
+	{65, tb_offsetof(ChunkFifoStatus, capacity), 0, 0, tb_membersize(ChunkFifoStatus, capacity), 0, 0, 0, NULL},
+	TB_LAST_FIELD,
+};
+
+const tb_field_t DiagnosticsResponse_fields[6] = {
+	{513, tb_offsetof(DiagnosticsResponse, microphone_chunk_fifo_status), 0, 0, tb_membersize(DiagnosticsResponse, microphone_chunk_fifo_status), 0, 0, 0, &ChunkFifoStatus_fields},
+	{513, tb_offsetof(DiagnosticsResponse, scan_chunk_fifo_status), 0, 0, tb_membersize(DiagnosticsResponse, scan_chunk_fifo_status), 0, 0, 0, &ChunkFifoStatus_fields},
+	{513, tb_offsetof(DiagnosticsResponse, accelerometer_chunk_fifo_status), 0, 0, tb_membersize(DiagnosticsResponse, accelerometer_chunk_fifo_status), 0, 0, 0, &ChunkFifoStatus_fields},
+	{513, tb_offsetof(DiagnosticsResponse, accelerometer_interrupt_chunk_fifo_status), 0, 0, tb_membersize(DiagnosticsResponse, accelerometer_interrupt_chunk_fifo_status), 0, 0, 0, &ChunkFifoStatus_fields},
+	{513, tb_offsetof(DiagnosticsResponse, battery_chunk_fifo_status), 0, 0, tb_membersize(DiagnosticsResponse, battery_chunk_fifo_status), 0, 0, 0, &ChunkFifoStatus_fields},
+	TB_LAST_FIELD,
+};
+
+const tb_field_t Response_fields[18] = {
 	{528, tb_offsetof(Response, type.status_response), tb_delta(Response, which_type, type.status_response), 1, tb_membersize(Response, type.status_response), 0, 1, 1, &StatusResponse_fields},
 	{528, tb_offsetof(Response, type.start_microphone_response), tb_delta(Response, which_type, type.start_microphone_response), 1, tb_membersize(Response, type.start_microphone_response), 0, 2, 0, &StartMicrophoneResponse_fields},
 	{528, tb_offsetof(Response, type.start_scan_response), tb_delta(Response, which_type, type.start_scan_response), 1, tb_membersize(Response, type.start_scan_response), 0, 3, 0, &StartScanResponse_fields},
@@ -310,6 +392,1482 @@ const tb_field_t Response_fields[14] = {
 	{528, tb_offsetof(Response, type.battery_data_response), tb_delta(Response, which_type, type.battery_data_response), 1, tb_membersize(Response, type.battery_data_response), 0, 11, 0, &BatteryDataResponse_fields},
 	{528, tb_offsetof(Response, type.stream_response), tb_delta(Response, which_type, type.stream_response), 1, tb_membersize(Response, type.stream_response), 0, 12, 0, &StreamResponse_fields},
 	{528, tb_offsetof(Response, type.test_response), tb_delta(Response, which_type, type.test_response), 1, tb_membersize(Response, type.test_response), 0, 13, 0, &TestResponse_fields},
+	{528, tb_offsetof(Response, type.diagnostics_response), tb_delta(Response, which_type, type.diagnostics_response), 1, tb_membersize(Response, type.diagnostics_response), 0, 14, 0, &DiagnosticsResponse_fields},
+	{528, tb_offsetof(Response, type.bulk_export_checkpoint_response), tb_delta(Response, which_type, type.bulk_export_checkpoint_response), 1, tb_membersize(Response, type.bulk_export_checkpoint_response), 0, 15, 0, &BulkExportCheckpointResponse_fields},
+	{528, tb_offsetof(Response, type.set_compression_response), tb_delta(Response, which_type, type.set_compression_response), 1, tb_membersize(Response, type.set_compression_response), 0, 16, 0, &SetCompressionResponse_fields},
+	{528, tb_offsetof(Response, type.set_overflow_policy_response), tb_delta(Response, which_type, type.set_overflow_policy_response), 1, tb_membersize(Response, type.set_overflow_policy_response), 0, 17, 0, &SetOverflowPolicyResponse_fields},
 	TB_LAST_FIELD,
 };
+
+uint8_t StatusRequest_encode(tb_ostream_t* ostream, const StatusRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StatusRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 7);
+	if(p == NULL) return 0;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	*(p + 6) = (uint8_t) src->has_badge_assignement;
+	if(src->has_badge_assignement) {
+		p = tb_ostream_reserve(ostream, 3);
+		if(p == NULL) return 0;
+		BadgeAssignement_put(p, &(src->badge_assignement), endianness);
+	}
+	return 1;
+}
+
+uint8_t StatusRequest_decode(tb_istream_t* istream, StatusRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StatusRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, 7);
+	if(p == NULL) return 0;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->has_badge_assignement = (uint8_t) *(p + 6);
+	if(dst->has_badge_assignement) {
+		p = tb_istream_consume(istream, 3);
+		if(p == NULL) return 0;
+		BadgeAssignement_get(p, &(dst->badge_assignement), endianness);
+	}
+	return 1;
+}
+
+uint8_t StartMicrophoneRequest_encode(tb_ostream_t* ostream, const StartMicrophoneRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartMicrophoneRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartMicrophoneRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartMicrophoneRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartMicrophoneRequest_decode(tb_istream_t* istream, StartMicrophoneRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartMicrophoneRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartMicrophoneRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartMicrophoneRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StopMicrophoneRequest_encode(tb_ostream_t* ostream, const StopMicrophoneRequest* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, StopMicrophoneRequest_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t StopMicrophoneRequest_decode(tb_istream_t* istream, StopMicrophoneRequest* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, StopMicrophoneRequest_fields, dst, endianness);
+	return 1;
+}
+
+uint8_t StartScanRequest_encode(tb_ostream_t* ostream, const StartScanRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartScanRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartScanRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartScanRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartScanRequest_decode(tb_istream_t* istream, StartScanRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartScanRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartScanRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartScanRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StopScanRequest_encode(tb_ostream_t* ostream, const StopScanRequest* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, StopScanRequest_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t StopScanRequest_decode(tb_istream_t* istream, StopScanRequest* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, StopScanRequest_fields, dst, endianness);
+	return 1;
+}
+
+uint8_t StartAccelerometerRequest_encode(tb_ostream_t* ostream, const StartAccelerometerRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartAccelerometerRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartAccelerometerRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartAccelerometerRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartAccelerometerRequest_decode(tb_istream_t* istream, StartAccelerometerRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartAccelerometerRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartAccelerometerRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartAccelerometerRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StopAccelerometerRequest_encode(tb_ostream_t* ostream, const StopAccelerometerRequest* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, StopAccelerometerRequest_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t StopAccelerometerRequest_decode(tb_istream_t* istream, StopAccelerometerRequest* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, StopAccelerometerRequest_fields, dst, endianness);
+	return 1;
+}
+
+uint8_t StartAccelerometerInterruptRequest_encode(tb_ostream_t* ostream, const StartAccelerometerInterruptRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartAccelerometerInterruptRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartAccelerometerInterruptRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartAccelerometerInterruptRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartAccelerometerInterruptRequest_decode(tb_istream_t* istream, StartAccelerometerInterruptRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartAccelerometerInterruptRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartAccelerometerInterruptRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartAccelerometerInterruptRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StopAccelerometerInterruptRequest_encode(tb_ostream_t* ostream, const StopAccelerometerInterruptRequest* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, StopAccelerometerInterruptRequest_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t StopAccelerometerInterruptRequest_decode(tb_istream_t* istream, StopAccelerometerInterruptRequest* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, StopAccelerometerInterruptRequest_fields, dst, endianness);
+	return 1;
+}
+
+uint8_t StartBatteryRequest_encode(tb_ostream_t* ostream, const StartBatteryRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartBatteryRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartBatteryRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartBatteryRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartBatteryRequest_decode(tb_istream_t* istream, StartBatteryRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartBatteryRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartBatteryRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartBatteryRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StopBatteryRequest_encode(tb_ostream_t* ostream, const StopBatteryRequest* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, StopBatteryRequest_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t StopBatteryRequest_decode(tb_istream_t* istream, StopBatteryRequest* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, StopBatteryRequest_fields, dst, endianness);
+	return 1;
+}
+
+uint8_t MicrophoneDataRequest_encode(tb_ostream_t* ostream, const MicrophoneDataRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, MicrophoneDataRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, MicrophoneDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	MicrophoneDataRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t MicrophoneDataRequest_decode(tb_istream_t* istream, MicrophoneDataRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, MicrophoneDataRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, MicrophoneDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	MicrophoneDataRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t ScanDataRequest_encode(tb_ostream_t* ostream, const ScanDataRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, ScanDataRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, ScanDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	ScanDataRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t ScanDataRequest_decode(tb_istream_t* istream, ScanDataRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, ScanDataRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, ScanDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	ScanDataRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerDataRequest_encode(tb_ostream_t* ostream, const AccelerometerDataRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, AccelerometerDataRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, AccelerometerDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerDataRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerDataRequest_decode(tb_istream_t* istream, AccelerometerDataRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, AccelerometerDataRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, AccelerometerDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerDataRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerInterruptDataRequest_encode(tb_ostream_t* ostream, const AccelerometerInterruptDataRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, AccelerometerInterruptDataRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, AccelerometerInterruptDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerInterruptDataRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerInterruptDataRequest_decode(tb_istream_t* istream, AccelerometerInterruptDataRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, AccelerometerInterruptDataRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, AccelerometerInterruptDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerInterruptDataRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t BatteryDataRequest_encode(tb_ostream_t* ostream, const BatteryDataRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, BatteryDataRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, BatteryDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BatteryDataRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t BatteryDataRequest_decode(tb_istream_t* istream, BatteryDataRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, BatteryDataRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, BatteryDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BatteryDataRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t ExportCursor_encode(tb_ostream_t* ostream, const ExportCursor* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, ExportCursor_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, ExportCursor_ENCODED_LEN);
+	if(p == NULL) return 0;
+	ExportCursor_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t ExportCursor_decode(tb_istream_t* istream, ExportCursor* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, ExportCursor_fields, dst, endianness);
+	p = tb_istream_consume(istream, ExportCursor_ENCODED_LEN);
+	if(p == NULL) return 0;
+	ExportCursor_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t BulkExportRequest_encode(tb_ostream_t* ostream, const BulkExportRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, BulkExportRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 3);
+	if(p == NULL) return 0;
+	tb_put_16(p, (uint16_t) src->checkpoint_interval, endianness);
+	*(p + 2) = (uint8_t) src->has_cursor;
+	if(src->has_cursor) {
+		p = tb_ostream_reserve(ostream, 10);
+		if(p == NULL) return 0;
+		ExportCursor_put(p, &(src->cursor), endianness);
+	}
+	return 1;
+}
+
+uint8_t BulkExportRequest_decode(tb_istream_t* istream, BulkExportRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, BulkExportRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, 3);
+	if(p == NULL) return 0;
+	dst->checkpoint_interval = (uint16_t) tb_get_16(p, endianness);
+	dst->has_cursor = (uint8_t) *(p + 2);
+	if(dst->has_cursor) {
+		p = tb_istream_consume(istream, 10);
+		if(p == NULL) return 0;
+		ExportCursor_get(p, &(dst->cursor), endianness);
+	}
+	return 1;
+}
+
+uint8_t PullNewDataRequest_encode(tb_ostream_t* ostream, const PullNewDataRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, PullNewDataRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, PullNewDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	PullNewDataRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t PullNewDataRequest_decode(tb_istream_t* istream, PullNewDataRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, PullNewDataRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, PullNewDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	PullNewDataRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t AcknowledgeDataRequest_encode(tb_ostream_t* ostream, const AcknowledgeDataRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, AcknowledgeDataRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, AcknowledgeDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AcknowledgeDataRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t AcknowledgeDataRequest_decode(tb_istream_t* istream, AcknowledgeDataRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, AcknowledgeDataRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, AcknowledgeDataRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AcknowledgeDataRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t SetCompressionRequest_encode(tb_ostream_t* ostream, const SetCompressionRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, SetCompressionRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, SetCompressionRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	SetCompressionRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t SetCompressionRequest_decode(tb_istream_t* istream, SetCompressionRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, SetCompressionRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, SetCompressionRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	SetCompressionRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t SetOverflowPolicyRequest_encode(tb_ostream_t* ostream, const SetOverflowPolicyRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, SetOverflowPolicyRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, SetOverflowPolicyRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	SetOverflowPolicyRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t SetOverflowPolicyRequest_decode(tb_istream_t* istream, SetOverflowPolicyRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, SetOverflowPolicyRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, SetOverflowPolicyRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	SetOverflowPolicyRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StartMicrophoneStreamRequest_encode(tb_ostream_t* ostream, const StartMicrophoneStreamRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartMicrophoneStreamRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartMicrophoneStreamRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartMicrophoneStreamRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartMicrophoneStreamRequest_decode(tb_istream_t* istream, StartMicrophoneStreamRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartMicrophoneStreamRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartMicrophoneStreamRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartMicrophoneStreamRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StopMicrophoneStreamRequest_encode(tb_ostream_t* ostream, const StopMicrophoneStreamRequest* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, StopMicrophoneStreamRequest_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t StopMicrophoneStreamRequest_decode(tb_istream_t* istream, StopMicrophoneStreamRequest* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, StopMicrophoneStreamRequest_fields, dst, endianness);
+	return 1;
+}
+
+uint8_t StartScanStreamRequest_encode(tb_ostream_t* ostream, const StartScanStreamRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartScanStreamRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartScanStreamRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartScanStreamRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartScanStreamRequest_decode(tb_istream_t* istream, StartScanStreamRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartScanStreamRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartScanStreamRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartScanStreamRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StopScanStreamRequest_encode(tb_ostream_t* ostream, const StopScanStreamRequest* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, StopScanStreamRequest_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t StopScanStreamRequest_decode(tb_istream_t* istream, StopScanStreamRequest* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, StopScanStreamRequest_fields, dst, endianness);
+	return 1;
+}
+
+uint8_t StartAccelerometerStreamRequest_encode(tb_ostream_t* ostream, const StartAccelerometerStreamRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartAccelerometerStreamRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartAccelerometerStreamRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartAccelerometerStreamRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartAccelerometerStreamRequest_decode(tb_istream_t* istream, StartAccelerometerStreamRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartAccelerometerStreamRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartAccelerometerStreamRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartAccelerometerStreamRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StopAccelerometerStreamRequest_encode(tb_ostream_t* ostream, const StopAccelerometerStreamRequest* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, StopAccelerometerStreamRequest_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t StopAccelerometerStreamRequest_decode(tb_istream_t* istream, StopAccelerometerStreamRequest* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, StopAccelerometerStreamRequest_fields, dst, endianness);
+	return 1;
+}
+
+uint8_t StartAccelerometerInterruptStreamRequest_encode(tb_ostream_t* ostream, const StartAccelerometerInterruptStreamRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartAccelerometerInterruptStreamRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartAccelerometerInterruptStreamRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartAccelerometerInterruptStreamRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartAccelerometerInterruptStreamRequest_decode(tb_istream_t* istream, StartAccelerometerInterruptStreamRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartAccelerometerInterruptStreamRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartAccelerometerInterruptStreamRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartAccelerometerInterruptStreamRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StopAccelerometerInterruptStreamRequest_encode(tb_ostream_t* ostream, const StopAccelerometerInterruptStreamRequest* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, StopAccelerometerInterruptStreamRequest_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t StopAccelerometerInterruptStreamRequest_decode(tb_istream_t* istream, StopAccelerometerInterruptStreamRequest* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, StopAccelerometerInterruptStreamRequest_fields, dst, endianness);
+	return 1;
+}
+
+uint8_t StartBatteryStreamRequest_encode(tb_ostream_t* ostream, const StartBatteryStreamRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartBatteryStreamRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartBatteryStreamRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartBatteryStreamRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartBatteryStreamRequest_decode(tb_istream_t* istream, StartBatteryStreamRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartBatteryStreamRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartBatteryStreamRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartBatteryStreamRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StopBatteryStreamRequest_encode(tb_ostream_t* ostream, const StopBatteryStreamRequest* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, StopBatteryStreamRequest_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t StopBatteryStreamRequest_decode(tb_istream_t* istream, StopBatteryStreamRequest* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, StopBatteryStreamRequest_fields, dst, endianness);
+	return 1;
+}
+
+uint8_t IdentifyRequest_encode(tb_ostream_t* ostream, const IdentifyRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, IdentifyRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, IdentifyRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	IdentifyRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t IdentifyRequest_decode(tb_istream_t* istream, IdentifyRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, IdentifyRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, IdentifyRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	IdentifyRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t TestRequest_encode(tb_ostream_t* ostream, const TestRequest* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, TestRequest_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t TestRequest_decode(tb_istream_t* istream, TestRequest* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, TestRequest_fields, dst, endianness);
+	return 1;
+}
+
+uint8_t RestartRequest_encode(tb_ostream_t* ostream, const RestartRequest* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, RestartRequest_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t RestartRequest_decode(tb_istream_t* istream, RestartRequest* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, RestartRequest_fields, dst, endianness);
+	return 1;
+}
+
+uint8_t DiagnosticsRequest_encode(tb_ostream_t* ostream, const DiagnosticsRequest* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, DiagnosticsRequest_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, DiagnosticsRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	DiagnosticsRequest_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t DiagnosticsRequest_decode(tb_istream_t* istream, DiagnosticsRequest* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, DiagnosticsRequest_fields, dst, endianness);
+	p = tb_istream_consume(istream, DiagnosticsRequest_ENCODED_LEN);
+	if(p == NULL) return 0;
+	DiagnosticsRequest_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t Request_encode(tb_ostream_t* ostream, const Request* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, Request_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->which_type;
+	switch(src->which_type) {
+		case Request_status_request_tag:
+			if(!StatusRequest_encode(ostream, &(src->type.status_request), endianness)) return 0;
+			break;
+		case Request_start_microphone_request_tag:
+			p = tb_ostream_reserve(ostream, 10);
+			if(p == NULL) return 0;
+			StartMicrophoneRequest_put(p, &(src->type.start_microphone_request), endianness);
+			break;
+		case Request_stop_microphone_request_tag:
+			break;
+		case Request_start_scan_request_tag:
+			p = tb_ostream_reserve(ostream, 17);
+			if(p == NULL) return 0;
+			StartScanRequest_put(p, &(src->type.start_scan_request), endianness);
+			break;
+		case Request_stop_scan_request_tag:
+			break;
+		case Request_start_accelerometer_request_tag:
+			p = tb_ostream_reserve(ostream, 14);
+			if(p == NULL) return 0;
+			StartAccelerometerRequest_put(p, &(src->type.start_accelerometer_request), endianness);
+			break;
+		case Request_stop_accelerometer_request_tag:
+			break;
+		case Request_start_accelerometer_interrupt_request_tag:
+			p = tb_ostream_reserve(ostream, 16);
+			if(p == NULL) return 0;
+			StartAccelerometerInterruptRequest_put(p, &(src->type.start_accelerometer_interrupt_request), endianness);
+			break;
+		case Request_stop_accelerometer_interrupt_request_tag:
+			break;
+		case Request_start_battery_request_tag:
+			p = tb_ostream_reserve(ostream, 12);
+			if(p == NULL) return 0;
+			StartBatteryRequest_put(p, &(src->type.start_battery_request), endianness);
+			break;
+		case Request_stop_battery_request_tag:
+			break;
+		case Request_microphone_data_request_tag:
+			p = tb_ostream_reserve(ostream, 6);
+			if(p == NULL) return 0;
+			MicrophoneDataRequest_put(p, &(src->type.microphone_data_request), endianness);
+			break;
+		case Request_scan_data_request_tag:
+			p = tb_ostream_reserve(ostream, 6);
+			if(p == NULL) return 0;
+			ScanDataRequest_put(p, &(src->type.scan_data_request), endianness);
+			break;
+		case Request_accelerometer_data_request_tag:
+			p = tb_ostream_reserve(ostream, 6);
+			if(p == NULL) return 0;
+			AccelerometerDataRequest_put(p, &(src->type.accelerometer_data_request), endianness);
+			break;
+		case Request_accelerometer_interrupt_data_request_tag:
+			p = tb_ostream_reserve(ostream, 6);
+			if(p == NULL) return 0;
+			AccelerometerInterruptDataRequest_put(p, &(src->type.accelerometer_interrupt_data_request), endianness);
+			break;
+		case Request_battery_data_request_tag:
+			p = tb_ostream_reserve(ostream, 6);
+			if(p == NULL) return 0;
+			BatteryDataRequest_put(p, &(src->type.battery_data_request), endianness);
+			break;
+		case Request_start_microphone_stream_request_tag:
+			p = tb_ostream_reserve(ostream, 10);
+			if(p == NULL) return 0;
+			StartMicrophoneStreamRequest_put(p, &(src->type.start_microphone_stream_request), endianness);
+			break;
+		case Request_stop_microphone_stream_request_tag:
+			break;
+		case Request_start_scan_stream_request_tag:
+			p = tb_ostream_reserve(ostream, 17);
+			if(p == NULL) return 0;
+			StartScanStreamRequest_put(p, &(src->type.start_scan_stream_request), endianness);
+			break;
+		case Request_stop_scan_stream_request_tag:
+			break;
+		case Request_start_accelerometer_stream_request_tag:
+			p = tb_ostream_reserve(ostream, 14);
+			if(p == NULL) return 0;
+			StartAccelerometerStreamRequest_put(p, &(src->type.start_accelerometer_stream_request), endianness);
+			break;
+		case Request_stop_accelerometer_stream_request_tag:
+			break;
+		case Request_start_accelerometer_interrupt_stream_request_tag:
+			p = tb_ostream_reserve(ostream, 16);
+			if(p == NULL) return 0;
+			StartAccelerometerInterruptStreamRequest_put(p, &(src->type.start_accelerometer_interrupt_stream_request), endianness);
+			break;
+		case Request_stop_accelerometer_interrupt_stream_request_tag:
+			break;
+		case Request_start_battery_stream_request_tag:
+			p = tb_ostream_reserve(ostream, 12);
+			if(p == NULL) return 0;
+			StartBatteryStreamRequest_put(p, &(src->type.start_battery_stream_request), endianness);
+			break;
+		case Request_stop_battery_stream_request_tag:
+			break;
+		case Request_identify_request_tag:
+			p = tb_ostream_reserve(ostream, 2);
+			if(p == NULL) return 0;
+			IdentifyRequest_put(p, &(src->type.identify_request), endianness);
+			break;
+		case Request_test_request_tag:
+			break;
+		case Request_restart_request_tag:
+			break;
+		case Request_diagnostics_request_tag:
+			p = tb_ostream_reserve(ostream, 1);
+			if(p == NULL) return 0;
+			DiagnosticsRequest_put(p, &(src->type.diagnostics_request), endianness);
+			break;
+		case Request_bulk_export_request_tag:
+			if(!BulkExportRequest_encode(ostream, &(src->type.bulk_export_request), endianness)) return 0;
+			break;
+		case Request_pull_new_data_request_tag:
+			p = tb_ostream_reserve(ostream, 4);
+			if(p == NULL) return 0;
+			PullNewDataRequest_put(p, &(src->type.pull_new_data_request), endianness);
+			break;
+		case Request_acknowledge_data_request_tag:
+			p = tb_ostream_reserve(ostream, 12);
+			if(p == NULL) return 0;
+			AcknowledgeDataRequest_put(p, &(src->type.acknowledge_data_request), endianness);
+			break;
+		case Request_set_compression_request_tag:
+			p = tb_ostream_reserve(ostream, 1);
+			if(p == NULL) return 0;
+			SetCompressionRequest_put(p, &(src->type.set_compression_request), endianness);
+			break;
+		case Request_set_overflow_policy_request_tag:
+			p = tb_ostream_reserve(ostream, 2);
+			if(p == NULL) return 0;
+			SetOverflowPolicyRequest_put(p, &(src->type.set_overflow_policy_request), endianness);
+			break;
+		default:
+			return 0;
+	}
+	return 1;
+}
+
+uint8_t Request_decode(tb_istream_t* istream, Request* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, Request_fields, dst, endianness);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->which_type = (uint8_t) *(p);
+	switch(dst->which_type) {
+		case Request_status_request_tag:
+			if(!StatusRequest_decode(istream, &(dst->type.status_request), endianness)) return 0;
+			break;
+		case Request_start_microphone_request_tag:
+			p = tb_istream_consume(istream, 10);
+			if(p == NULL) return 0;
+			StartMicrophoneRequest_get(p, &(dst->type.start_microphone_request), endianness);
+			break;
+		case Request_stop_microphone_request_tag:
+			break;
+		case Request_start_scan_request_tag:
+			p = tb_istream_consume(istream, 17);
+			if(p == NULL) return 0;
+			StartScanRequest_get(p, &(dst->type.start_scan_request), endianness);
+			break;
+		case Request_stop_scan_request_tag:
+			break;
+		case Request_start_accelerometer_request_tag:
+			p = tb_istream_consume(istream, 14);
+			if(p == NULL) return 0;
+			StartAccelerometerRequest_get(p, &(dst->type.start_accelerometer_request), endianness);
+			break;
+		case Request_stop_accelerometer_request_tag:
+			break;
+		case Request_start_accelerometer_interrupt_request_tag:
+			p = tb_istream_consume(istream, 16);
+			if(p == NULL) return 0;
+			StartAccelerometerInterruptRequest_get(p, &(dst->type.start_accelerometer_interrupt_request), endianness);
+			break;
+		case Request_stop_accelerometer_interrupt_request_tag:
+			break;
+		case Request_start_battery_request_tag:
+			p = tb_istream_consume(istream, 12);
+			if(p == NULL) return 0;
+			StartBatteryRequest_get(p, &(dst->type.start_battery_request), endianness);
+			break;
+		case Request_stop_battery_request_tag:
+			break;
+		case Request_microphone_data_request_tag:
+			p = tb_istream_consume(istream, 6);
+			if(p == NULL) return 0;
+			MicrophoneDataRequest_get(p, &(dst->type.microphone_data_request), endianness);
+			break;
+		case Request_scan_data_request_tag:
+			p = tb_istream_consume(istream, 6);
+			if(p == NULL) return 0;
+			ScanDataRequest_get(p, &(dst->type.scan_data_request), endianness);
+			break;
+		case Request_accelerometer_data_request_tag:
+			p = tb_istream_consume(istream, 6);
+			if(p == NULL) return 0;
+			AccelerometerDataRequest_get(p, &(dst->type.accelerometer_data_request), endianness);
+			break;
+		case Request_accelerometer_interrupt_data_request_tag:
+			p = tb_istream_consume(istream, 6);
+			if(p == NULL) return 0;
+			AccelerometerInterruptDataRequest_get(p, &(dst->type.accelerometer_interrupt_data_request), endianness);
+			break;
+		case Request_battery_data_request_tag:
+			p = tb_istream_consume(istream, 6);
+			if(p == NULL) return 0;
+			BatteryDataRequest_get(p, &(dst->type.battery_data_request), endianness);
+			break;
+		case Request_start_microphone_stream_request_tag:
+			p = tb_istream_consume(istream, 10);
+			if(p == NULL) return 0;
+			StartMicrophoneStreamRequest_get(p, &(dst->type.start_microphone_stream_request), endianness);
+			break;
+		case Request_stop_microphone_stream_request_tag:
+			break;
+		case Request_start_scan_stream_request_tag:
+			p = tb_istream_consume(istream, 17);
+			if(p == NULL) return 0;
+			StartScanStreamRequest_get(p, &(dst->type.start_scan_stream_request), endianness);
+			break;
+		case Request_stop_scan_stream_request_tag:
+			break;
+		case Request_start_accelerometer_stream_request_tag:
+			p = tb_istream_consume(istream, 14);
+			if(p == NULL) return 0;
+			StartAccelerometerStreamRequest_get(p, &(dst->type.start_accelerometer_stream_request), endianness);
+			break;
+		case Request_stop_accelerometer_stream_request_tag:
+			break;
+		case Request_start_accelerometer_interrupt_stream_request_tag:
+			p = tb_istream_consume(istream, 16);
+			if(p == NULL) return 0;
+			StartAccelerometerInterruptStreamRequest_get(p, &(dst->type.start_accelerometer_interrupt_stream_request), endianness);
+			break;
+		case Request_stop_accelerometer_interrupt_stream_request_tag:
+			break;
+		case Request_start_battery_stream_request_tag:
+			p = tb_istream_consume(istream, 12);
+			if(p == NULL) return 0;
+			StartBatteryStreamRequest_get(p, &(dst->type.start_battery_stream_request), endianness);
+			break;
+		case Request_stop_battery_stream_request_tag:
+			break;
+		case Request_identify_request_tag:
+			p = tb_istream_consume(istream, 2);
+			if(p == NULL) return 0;
+			IdentifyRequest_get(p, &(dst->type.identify_request), endianness);
+			break;
+		case Request_test_request_tag:
+			break;
+		case Request_restart_request_tag:
+			break;
+		case Request_diagnostics_request_tag:
+			p = tb_istream_consume(istream, 1);
+			if(p == NULL) return 0;
+			DiagnosticsRequest_get(p, &(dst->type.diagnostics_request), endianness);
+			break;
+		case Request_bulk_export_request_tag:
+			if(!BulkExportRequest_decode(istream, &(dst->type.bulk_export_request), endianness)) return 0;
+			break;
+		case Request_pull_new_data_request_tag:
+			p = tb_istream_consume(istream, 4);
+			if(p == NULL) return 0;
+			PullNewDataRequest_get(p, &(dst->type.pull_new_data_request), endianness);
+			break;
+		case Request_acknowledge_data_request_tag:
+			p = tb_istream_consume(istream, 12);
+			if(p == NULL) return 0;
+			AcknowledgeDataRequest_get(p, &(dst->type.acknowledge_data_request), endianness);
+			break;
+		case Request_set_compression_request_tag:
+			p = tb_istream_consume(istream, 1);
+			if(p == NULL) return 0;
+			SetCompressionRequest_get(p, &(dst->type.set_compression_request), endianness);
+			break;
+		case Request_set_overflow_policy_request_tag:
+			p = tb_istream_consume(istream, 2);
+			if(p == NULL) return 0;
+			SetOverflowPolicyRequest_get(p, &(dst->type.set_overflow_policy_request), endianness);
+			break;
+		default:
+			return 0;
+	}
+	return 1;
+}
+
+uint8_t StatusResponse_encode(tb_ostream_t* ostream, const StatusResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StatusResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StatusResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StatusResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StatusResponse_decode(tb_istream_t* istream, StatusResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StatusResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, StatusResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StatusResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StartMicrophoneResponse_encode(tb_ostream_t* ostream, const StartMicrophoneResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartMicrophoneResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartMicrophoneResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartMicrophoneResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartMicrophoneResponse_decode(tb_istream_t* istream, StartMicrophoneResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartMicrophoneResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartMicrophoneResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartMicrophoneResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StartScanResponse_encode(tb_ostream_t* ostream, const StartScanResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartScanResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartScanResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartScanResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartScanResponse_decode(tb_istream_t* istream, StartScanResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartScanResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartScanResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartScanResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StartAccelerometerResponse_encode(tb_ostream_t* ostream, const StartAccelerometerResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartAccelerometerResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartAccelerometerResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartAccelerometerResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartAccelerometerResponse_decode(tb_istream_t* istream, StartAccelerometerResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartAccelerometerResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartAccelerometerResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartAccelerometerResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StartAccelerometerInterruptResponse_encode(tb_ostream_t* ostream, const StartAccelerometerInterruptResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartAccelerometerInterruptResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartAccelerometerInterruptResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartAccelerometerInterruptResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartAccelerometerInterruptResponse_decode(tb_istream_t* istream, StartAccelerometerInterruptResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartAccelerometerInterruptResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartAccelerometerInterruptResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartAccelerometerInterruptResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StartBatteryResponse_encode(tb_ostream_t* ostream, const StartBatteryResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StartBatteryResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, StartBatteryResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartBatteryResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t StartBatteryResponse_decode(tb_istream_t* istream, StartBatteryResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StartBatteryResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, StartBatteryResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	StartBatteryResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t MicrophoneDataResponse_encode(tb_ostream_t* ostream, const MicrophoneDataResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, MicrophoneDataResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 9);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->last_response;
+	Timestamp_put(p + 1, &(src->timestamp), endianness);
+	tb_put_16(p + 7, (uint16_t) src->sample_period_ms, endianness);
+	if(src->microphone_data_count > 114) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->microphone_data_count)*1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->microphone_data_count;
+	for(uint32_t i = 0; i < src->microphone_data_count; i++) MicrophoneData_put(p + 1 + i*1, &(src->microphone_data[i]), endianness);
+	return 1;
+}
+
+uint8_t MicrophoneDataResponse_decode(tb_istream_t* istream, MicrophoneDataResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, MicrophoneDataResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, 10);
+	if(p == NULL) return 0;
+	dst->last_response = (uint8_t) *(p);
+	Timestamp_get(p + 1, &(dst->timestamp), endianness);
+	dst->sample_period_ms = (uint16_t) tb_get_16(p + 7, endianness);
+	dst->microphone_data_count = (uint8_t) *(p + 9);
+	if(dst->microphone_data_count > 114) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->microphone_data_count)*1);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->microphone_data_count; i++) MicrophoneData_get(p + i*1, &(dst->microphone_data[i]), endianness);
+	return 1;
+}
+
+uint8_t ScanDataResponse_encode(tb_ostream_t* ostream, const ScanDataResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, ScanDataResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 7);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->last_response;
+	Timestamp_put(p + 1, &(src->timestamp), endianness);
+	if(src->scan_result_data_count > 29) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->scan_result_data_count)*4);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->scan_result_data_count;
+	for(uint32_t i = 0; i < src->scan_result_data_count; i++) ScanResultData_put(p + 1 + i*4, &(src->scan_result_data[i]), endianness);
+	return 1;
+}
+
+uint8_t ScanDataResponse_decode(tb_istream_t* istream, ScanDataResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, ScanDataResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, 8);
+	if(p == NULL) return 0;
+	dst->last_response = (uint8_t) *(p);
+	Timestamp_get(p + 1, &(dst->timestamp), endianness);
+	dst->scan_result_data_count = (uint8_t) *(p + 7);
+	if(dst->scan_result_data_count > 29) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->scan_result_data_count)*4);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->scan_result_data_count; i++) ScanResultData_get(p + i*4, &(dst->scan_result_data[i]), endianness);
+	return 1;
+}
+
+uint8_t AccelerometerDataResponse_encode(tb_ostream_t* ostream, const AccelerometerDataResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, AccelerometerDataResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 7);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->last_response;
+	Timestamp_put(p + 1, &(src->timestamp), endianness);
+	if(src->accelerometer_data_count > 100) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->accelerometer_data_count)*2);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->accelerometer_data_count;
+	for(uint32_t i = 0; i < src->accelerometer_data_count; i++) AccelerometerData_put(p + 1 + i*2, &(src->accelerometer_data[i]), endianness);
+	return 1;
+}
+
+uint8_t AccelerometerDataResponse_decode(tb_istream_t* istream, AccelerometerDataResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, AccelerometerDataResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, 8);
+	if(p == NULL) return 0;
+	dst->last_response = (uint8_t) *(p);
+	Timestamp_get(p + 1, &(dst->timestamp), endianness);
+	dst->accelerometer_data_count = (uint8_t) *(p + 7);
+	if(dst->accelerometer_data_count > 100) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->accelerometer_data_count)*2);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->accelerometer_data_count; i++) AccelerometerData_get(p + i*2, &(dst->accelerometer_data[i]), endianness);
+	return 1;
+}
+
+uint8_t AccelerometerInterruptDataResponse_encode(tb_ostream_t* ostream, const AccelerometerInterruptDataResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, AccelerometerInterruptDataResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, AccelerometerInterruptDataResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerInterruptDataResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerInterruptDataResponse_decode(tb_istream_t* istream, AccelerometerInterruptDataResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, AccelerometerInterruptDataResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, AccelerometerInterruptDataResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerInterruptDataResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t BatteryDataResponse_encode(tb_ostream_t* ostream, const BatteryDataResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, BatteryDataResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, BatteryDataResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BatteryDataResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t BatteryDataResponse_decode(tb_istream_t* istream, BatteryDataResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, BatteryDataResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, BatteryDataResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BatteryDataResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t BulkExportCheckpointResponse_encode(tb_ostream_t* ostream, const BulkExportCheckpointResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, BulkExportCheckpointResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, BulkExportCheckpointResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BulkExportCheckpointResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t BulkExportCheckpointResponse_decode(tb_istream_t* istream, BulkExportCheckpointResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, BulkExportCheckpointResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, BulkExportCheckpointResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BulkExportCheckpointResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t SetCompressionResponse_encode(tb_ostream_t* ostream, const SetCompressionResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, SetCompressionResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, SetCompressionResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	SetCompressionResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t SetCompressionResponse_decode(tb_istream_t* istream, SetCompressionResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, SetCompressionResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, SetCompressionResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	SetCompressionResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t SetOverflowPolicyResponse_encode(tb_ostream_t* ostream, const SetOverflowPolicyResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, SetOverflowPolicyResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, SetOverflowPolicyResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	SetOverflowPolicyResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t SetOverflowPolicyResponse_decode(tb_istream_t* istream, SetOverflowPolicyResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, SetOverflowPolicyResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, SetOverflowPolicyResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	SetOverflowPolicyResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t StreamResponse_encode(tb_ostream_t* ostream, const StreamResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, StreamResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 6);
+	if(p == NULL) return 0;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	if(src->battery_stream_count > 10) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->battery_stream_count)*4);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->battery_stream_count;
+	for(uint32_t i = 0; i < src->battery_stream_count; i++) BatteryStream_put(p + 1 + i*4, &(src->battery_stream[i]), endianness);
+	if(src->microphone_stream_count > 10) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->microphone_stream_count)*1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->microphone_stream_count;
+	for(uint32_t i = 0; i < src->microphone_stream_count; i++) MicrophoneStream_put(p + 1 + i*1, &(src->microphone_stream[i]), endianness);
+	if(src->scan_stream_count > 10) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->scan_stream_count)*3);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->scan_stream_count;
+	for(uint32_t i = 0; i < src->scan_stream_count; i++) ScanStream_put(p + 1 + i*3, &(src->scan_stream[i]), endianness);
+	if(src->accelerometer_stream_count > 10) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->accelerometer_stream_count)*6);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->accelerometer_stream_count;
+	for(uint32_t i = 0; i < src->accelerometer_stream_count; i++) AccelerometerStream_put(p + 1 + i*6, &(src->accelerometer_stream[i]), endianness);
+	if(src->accelerometer_interrupt_stream_count > 10) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->accelerometer_interrupt_stream_count)*6);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->accelerometer_interrupt_stream_count;
+	for(uint32_t i = 0; i < src->accelerometer_interrupt_stream_count; i++) AccelerometerInterruptStream_put(p + 1 + i*6, &(src->accelerometer_interrupt_stream[i]), endianness);
+	return 1;
+}
+
+uint8_t StreamResponse_decode(tb_istream_t* istream, StreamResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, StreamResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, 7);
+	if(p == NULL) return 0;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->battery_stream_count = (uint8_t) *(p + 6);
+	if(dst->battery_stream_count > 10) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->battery_stream_count)*4);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->battery_stream_count; i++) BatteryStream_get(p + i*4, &(dst->battery_stream[i]), endianness);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->microphone_stream_count = (uint8_t) *(p);
+	if(dst->microphone_stream_count > 10) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->microphone_stream_count)*1);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->microphone_stream_count; i++) MicrophoneStream_get(p + i*1, &(dst->microphone_stream[i]), endianness);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->scan_stream_count = (uint8_t) *(p);
+	if(dst->scan_stream_count > 10) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->scan_stream_count)*3);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->scan_stream_count; i++) ScanStream_get(p + i*3, &(dst->scan_stream[i]), endianness);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->accelerometer_stream_count = (uint8_t) *(p);
+	if(dst->accelerometer_stream_count > 10) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->accelerometer_stream_count)*6);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->accelerometer_stream_count; i++) AccelerometerStream_get(p + i*6, &(dst->accelerometer_stream[i]), endianness);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->accelerometer_interrupt_stream_count = (uint8_t) *(p);
+	if(dst->accelerometer_interrupt_stream_count > 10) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->accelerometer_interrupt_stream_count)*6);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->accelerometer_interrupt_stream_count; i++) AccelerometerInterruptStream_get(p + i*6, &(dst->accelerometer_interrupt_stream[i]), endianness);
+	return 1;
+}
+
+uint8_t TestResponse_encode(tb_ostream_t* ostream, const TestResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, TestResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, TestResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	TestResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t TestResponse_decode(tb_istream_t* istream, TestResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, TestResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, TestResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	TestResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t ChunkFifoStatus_encode(tb_ostream_t* ostream, const ChunkFifoStatus* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, ChunkFifoStatus_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, ChunkFifoStatus_ENCODED_LEN);
+	if(p == NULL) return 0;
+	ChunkFifoStatus_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t ChunkFifoStatus_decode(tb_istream_t* istream, ChunkFifoStatus* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, ChunkFifoStatus_fields, dst, endianness);
+	p = tb_istream_consume(istream, ChunkFifoStatus_ENCODED_LEN);
+	if(p == NULL) return 0;
+	ChunkFifoStatus_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t DiagnosticsResponse_encode(tb_ostream_t* ostream, const DiagnosticsResponse* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, DiagnosticsResponse_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, DiagnosticsResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	DiagnosticsResponse_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t DiagnosticsResponse_decode(tb_istream_t* istream, DiagnosticsResponse* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, DiagnosticsResponse_fields, dst, endianness);
+	p = tb_istream_consume(istream, DiagnosticsResponse_ENCODED_LEN);
+	if(p == NULL) return 0;
+	DiagnosticsResponse_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t Response_encode(tb_ostream_t* ostream, const Response* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, Response_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->which_type;
+	switch(src->which_type) {
+		case Response_status_response_tag:
+			p = tb_ostream_reserve(ostream, 18);
+			if(p == NULL) return 0;
+			StatusResponse_put(p, &(src->type.status_response), endianness);
+			break;
+		case Response_start_microphone_response_tag:
+			p = tb_ostream_reserve(ostream, 6);
+			if(p == NULL) return 0;
+			StartMicrophoneResponse_put(p, &(src->type.start_microphone_response), endianness);
+			break;
+		case Response_start_scan_response_tag:
+			p = tb_ostream_reserve(ostream, 6);
+			if(p == NULL) return 0;
+			StartScanResponse_put(p, &(src->type.start_scan_response), endianness);
+			break;
+		case Response_start_accelerometer_response_tag:
+			p = tb_ostream_reserve(ostream, 6);
+			if(p == NULL) return 0;
+			StartAccelerometerResponse_put(p, &(src->type.start_accelerometer_response), endianness);
+			break;
+		case Response_start_accelerometer_interrupt_response_tag:
+			p = tb_ostream_reserve(ostream, 6);
+			if(p == NULL) return 0;
+			StartAccelerometerInterruptResponse_put(p, &(src->type.start_accelerometer_interrupt_response), endianness);
+			break;
+		case Response_start_battery_response_tag:
+			p = tb_ostream_reserve(ostream, 6);
+			if(p == NULL) return 0;
+			StartBatteryResponse_put(p, &(src->type.start_battery_response), endianness);
+			break;
+		case Response_microphone_data_response_tag:
+			if(!MicrophoneDataResponse_encode(ostream, &(src->type.microphone_data_response), endianness)) return 0;
+			break;
+		case Response_scan_data_response_tag:
+			if(!ScanDataResponse_encode(ostream, &(src->type.scan_data_response), endianness)) return 0;
+			break;
+		case Response_accelerometer_data_response_tag:
+			if(!AccelerometerDataResponse_encode(ostream, &(src->type.accelerometer_data_response), endianness)) return 0;
+			break;
+		case Response_accelerometer_interrupt_data_response_tag:
+			p = tb_ostream_reserve(ostream, 7);
+			if(p == NULL) return 0;
+			AccelerometerInterruptDataResponse_put(p, &(src->type.accelerometer_interrupt_data_response), endianness);
+			break;
+		case Response_battery_data_response_tag:
+			p = tb_ostream_reserve(ostream, 11);
+			if(p == NULL) return 0;
+			BatteryDataResponse_put(p, &(src->type.battery_data_response), endianness);
+			break;
+		case Response_stream_response_tag:
+			if(!StreamResponse_encode(ostream, &(src->type.stream_response), endianness)) return 0;
+			break;
+		case Response_test_response_tag:
+			p = tb_ostream_reserve(ostream, 1);
+			if(p == NULL) return 0;
+			TestResponse_put(p, &(src->type.test_response), endianness);
+			break;
+		case Response_diagnostics_response_tag:
+			p = tb_ostream_reserve(ostream, 20);
+			if(p == NULL) return 0;
+			DiagnosticsResponse_put(p, &(src->type.diagnostics_response), endianness);
+			break;
+		case Response_bulk_export_checkpoint_response_tag:
+			p = tb_ostream_reserve(ostream, 11);
+			if(p == NULL) return 0;
+			BulkExportCheckpointResponse_put(p, &(src->type.bulk_export_checkpoint_response), endianness);
+			break;
+		case Response_set_compression_response_tag:
+			p = tb_ostream_reserve(ostream, 1);
+			if(p == NULL) return 0;
+			SetCompressionResponse_put(p, &(src->type.set_compression_response), endianness);
+			break;
+		case Response_set_overflow_policy_response_tag:
+			p = tb_ostream_reserve(ostream, 1);
+			if(p == NULL) return 0;
+			SetOverflowPolicyResponse_put(p, &(src->type.set_overflow_policy_response), endianness);
+			break;
+		default:
+			return 0;
+	}
+	return 1;
+}
+
+uint8_t Response_decode(tb_istream_t* istream, Response* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, Response_fields, dst, endianness);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->which_type = (uint8_t) *(p);
+	switch(dst->which_type) {
+		case Response_status_response_tag:
+			p = tb_istream_consume(istream, 18);
+			if(p == NULL) return 0;
+			StatusResponse_get(p, &(dst->type.status_response), endianness);
+			break;
+		case Response_start_microphone_response_tag:
+			p = tb_istream_consume(istream, 6);
+			if(p == NULL) return 0;
+			StartMicrophoneResponse_get(p, &(dst->type.start_microphone_response), endianness);
+			break;
+		case Response_start_scan_response_tag:
+			p = tb_istream_consume(istream, 6);
+			if(p == NULL) return 0;
+			StartScanResponse_get(p, &(dst->type.start_scan_response), endianness);
+			break;
+		case Response_start_accelerometer_response_tag:
+			p = tb_istream_consume(istream, 6);
+			if(p == NULL) return 0;
+			StartAccelerometerResponse_get(p, &(dst->type.start_accelerometer_response), endianness);
+			break;
+		case Response_start_accelerometer_interrupt_response_tag:
+			p = tb_istream_consume(istream, 6);
+			if(p == NULL) return 0;
+			StartAccelerometerInterruptResponse_get(p, &(dst->type.start_accelerometer_interrupt_response), endianness);
+			break;
+		case Response_start_battery_response_tag:
+			p = tb_istream_consume(istream, 6);
+			if(p == NULL) return 0;
+			StartBatteryResponse_get(p, &(dst->type.start_battery_response), endianness);
+			break;
+		case Response_microphone_data_response_tag:
+			if(!MicrophoneDataResponse_decode(istream, &(dst->type.microphone_data_response), endianness)) return 0;
+			break;
+		case Response_scan_data_response_tag:
+			if(!ScanDataResponse_decode(istream, &(dst->type.scan_data_response), endianness)) return 0;
+			break;
+		case Response_accelerometer_data_response_tag:
+			if(!AccelerometerDataResponse_decode(istream, &(dst->type.accelerometer_data_response), endianness)) return 0;
+			break;
+		case Response_accelerometer_interrupt_data_response_tag:
+			p = tb_istream_consume(istream, 7);
+			if(p == NULL) return 0;
+			AccelerometerInterruptDataResponse_get(p, &(dst->type.accelerometer_interrupt_data_response), endianness);
+			break;
+		case Response_battery_data_response_tag:
+			p = tb_istream_consume(istream, 11);
+			if(p == NULL) return 0;
+			BatteryDataResponse_get(p, &(dst->type.battery_data_response), endianness);
+			break;
+		case Response_stream_response_tag:
+			if(!StreamResponse_decode(istream, &(dst->type.stream_response), endianness)) return 0;
+			break;
+		case Response_test_response_tag:
+			p = tb_istream_consume(istream, 1);
+			if(p == NULL) return 0;
+			TestResponse_get(p, &(dst->type.test_response), endianness);
+			break;
+		case Response_diagnostics_response_tag:
+			p = tb_istream_consume(istream, 20);
+			if(p == NULL) return 0;
+			DiagnosticsResponse_get(p, &(dst->type.diagnostics_response), endianness);
+			break;
+		case Response_bulk_export_checkpoint_response_tag:
+			p = tb_istream_consume(istream, 11);
+			if(p == NULL) return 0;
+			BulkExportCheckpointResponse_get(p, &(dst->type.bulk_export_checkpoint_response), endianness);
+			break;
+		case Response_set_compression_response_tag:
+			p = tb_istream_consume(istream, 1);
+			if(p == NULL) return 0;
+			SetCompressionResponse_get(p, &(dst->type.set_compression_response), endianness);
+			break;
+		case Response_set_overflow_policy_response_tag:
+			p = tb_istream_consume(istream, 1);
+			if(p == NULL) return 0;
+			SetOverflowPolicyResponse_get(p, &(dst->type.set_overflow_policy_response), endianness);
+			break;
+		default:
+			return 0;
+	}
+	return 1;
+}
 #endif
@@ -9,6 +9,16 @@
 #define PROTOCOL_MICROPHONE_DATA_SIZE 114
 #define PROTOCOL_SCAN_DATA_SIZE 29
 #define PROTOCOL_ACCELEROMETER_DATA_SIZE 100
+#define PROTOCOL_COMPRESSION_NONE 0
+#define PROTOCOL_COMPRESSION_LZSS 1
+#define PROTOCOL_DATA_SOURCE_MICROPHONE 0
+#define PROTOCOL_DATA_SOURCE_SCAN 1
+#define PROTOCOL_DATA_SOURCE_ACCELEROMETER 2
+#define PROTOCOL_DATA_SOURCE_ACCELEROMETER_INTERRUPT 3
+#define PROTOCOL_DATA_SOURCE_BATTERY 4
+#define PROTOCOL_OVERFLOW_POLICY_DROP_NEWEST 0
+#define PROTOCOL_OVERFLOW_POLICY_DROP_OLDEST 1
+#define PROTOCOL_OVERFLOW_POLICY_DEGRADE_RATE 2
 #define PROTOCOL_MICROPHONE_STREAM_SIZE 10
 #define PROTOCOL_SCAN_STREAM_SIZE 10
 #define PROTOCOL_ACCELEROMETER_STREAM_SIZE 10
@@ -44,6 +54,12 @@
 #define Request_identify_request_tag 27
 #define Request_test_request_tag 28
 #define Request_restart_request_tag 29
+#define Request_diagnostics_request_tag 30
+#define Request_bulk_export_request_tag 31
+#define Request_pull_new_data_request_tag 32
+#define Request_acknowledge_data_request_tag 33
+#define Request_set_compression_request_tag 34
+#define Request_set_overflow_policy_request_tag 35
 #define Response_status_response_tag 1
 #define Response_start_microphone_response_tag 2
 #define Response_start_scan_response_tag 3
@@ -57,6 +73,10 @@
 #define Response_battery_data_response_tag 11
 #define Response_stream_response_tag 12
 #define Response_test_response_tag 13
+#define Response_diagnostics_response_tag 14
+#define Response_bulk_export_checkpoint_response_tag 15
+#define Response_set_compression_response_tag 16
+#define Response_set_overflow_policy_response_tag 17
 
 typedef struct {
 	Timestamp timestamp;
@@ -138,6 +158,39 @@ typedef struct {
 	Timestamp timestamp;
 } BatteryDataRequest;
 
+typedef struct {
+	uint16_t microphone_record_id;
+	uint16_t scan_record_id;
+	uint16_t accelerometer_record_id;
+	uint16_t accelerometer_interrupt_record_id;
+	uint16_t battery_record_id;
+} ExportCursor;
+
+typedef struct {
+	uint16_t checkpoint_interval;
+	uint8_t has_cursor;
+	ExportCursor cursor;
+} BulkExportRequest;
+
+typedef struct {
+	uint16_t hub_id;
+	uint16_t checkpoint_interval;
+} PullNewDataRequest;
+
+typedef struct {
+	uint16_t hub_id;
+	ExportCursor cursor;
+} AcknowledgeDataRequest;
+
+typedef struct {
+	uint8_t compression;
+} SetCompressionRequest;
+
+typedef struct {
+	uint8_t data_source;
+	uint8_t overflow_policy;
+} SetOverflowPolicyRequest;
+
 typedef struct {
 	Timestamp timestamp;
 	uint16_t timeout;
@@ -202,6 +255,10 @@ typedef struct {
 typedef struct {
 } RestartRequest;
 
+typedef struct {
+	uint8_t reset_chunk_fifo_status;
+} DiagnosticsRequest;
+
 typedef struct {
 	uint8_t which_type;
 	union {
@@ -234,6 +291,12 @@ typedef struct {
 		IdentifyRequest identify_request;
 		TestRequest test_request;
 		RestartRequest restart_request;
+		DiagnosticsRequest diagnostics_request;
+		BulkExportRequest bulk_export_request;
+		PullNewDataRequest pull_new_data_request;
+		AcknowledgeDataRequest acknowledge_data_request;
+		SetCompressionRequest set_compression_request;
+		SetOverflowPolicyRequest set_overflow_policy_request;
 	} type;
 } Request;
 
@@ -246,6 +309,7 @@ typedef struct {
 	uint8_t battery_status;
 	Timestamp timestamp;
 	BatteryData battery_data;
+	uint16_t dropped_chunks;
 } StatusResponse;
 
 typedef struct {
@@ -301,6 +365,19 @@ typedef struct {
 	BatteryData battery_data;
 } BatteryDataResponse;
 
+typedef struct {
+	uint8_t last_response;
+	ExportCursor cursor;
+} BulkExportCheckpointResponse;
+
+typedef struct {
+	uint8_t compression;
+} SetCompressionResponse;
+
+typedef struct {
+	uint8_t overflow_policy;
+} SetOverflowPolicyResponse;
+
 typedef struct {
 	Timestamp timestamp;
 	uint8_t battery_stream_count;
@@ -319,6 +396,20 @@ typedef struct {
 	uint8_t test_failed;
 } TestResponse;
 
+typedef struct {
+	uint16_t dropped_chunks;
+	uint8_t high_water_mark;
+	uint8_t capacity;
+} ChunkFifoStatus;
+
+typedef struct {
+	ChunkFifoStatus microphone_chunk_fifo_status;
+	ChunkFifoStatus scan_chunk_fifo_status;
+	ChunkFifoStatus accelerometer_chunk_fifo_status;
+	ChunkFifoStatus accelerometer_interrupt_chunk_fifo_status;
+	ChunkFifoStatus battery_chunk_fifo_status;
+} DiagnosticsResponse;
+
 typedef struct {
 	uint8_t which_type;
 	union {
@@ -335,6 +426,10 @@ typedef struct {
 		BatteryDataResponse battery_data_response;
 		StreamResponse stream_response;
 		TestResponse test_response;
+		DiagnosticsResponse diagnostics_response;
+		BulkExportCheckpointResponse bulk_export_checkpoint_response;
+		SetCompressionResponse set_compression_response;
+		SetOverflowPolicyResponse set_overflow_policy_response;
 	} type;
 } Response;
 
@@ -354,6 +449,12 @@ extern const tb_field_t ScanDataRequest_fields[2];
 extern const tb_field_t AccelerometerDataRequest_fields[2];
 extern const tb_field_t AccelerometerInterruptDataRequest_fields[2];
 extern const tb_field_t BatteryDataRequest_fields[2];
+extern const tb_field_t ExportCursor_fields[6];
+extern const tb_field_t BulkExportRequest_fields[3];
+extern const tb_field_t PullNewDataRequest_fields[3];
+extern const tb_field_t AcknowledgeDataRequest_fields[3];
+extern const tb_field_t SetCompressionRequest_fields[2];
+extern const tb_field_t SetOverflowPolicyRequest_fields[3];
 extern const tb_field_t StartMicrophoneStreamRequest_fields[4];
 extern const tb_field_t StopMicrophoneStreamRequest_fields[1];
 extern const tb_field_t StartScanStreamRequest_fields[8];
@@ -367,8 +468,9 @@ extern const tb_field_t StopBatteryStreamRequest_fields[1];
 extern const tb_field_t IdentifyRequest_fields[2];
 extern const tb_field_t TestRequest_fields[1];
 extern const tb_field_t RestartRequest_fields[1];
-extern const tb_field_t Request_fields[30];
-extern const tb_field_t StatusResponse_fields[9];
+extern const tb_field_t DiagnosticsRequest_fields[2];
+extern const tb_field_t Request_fields[36];
+extern const tb_field_t StatusResponse_fields[10];
 extern const tb_field_t StartMicrophoneResponse_fields[2];
 extern const tb_field_t StartScanResponse_fields[2];
 extern const tb_field_t StartAccelerometerResponse_fields[2];
@@ -379,8 +481,717 @@ extern const tb_field_t ScanDataResponse_fields[4];
 extern const tb_field_t AccelerometerDataResponse_fields[4];
 extern const tb_field_t AccelerometerInterruptDataResponse_fields[3];
 extern const tb_field_t BatteryDataResponse_fields[4];
+extern const tb_field_t BulkExportCheckpointResponse_fields[3];
+extern const tb_field_t SetCompressionResponse_fields[2];
+extern const tb_field_t SetOverflowPolicyResponse_fields[2];
 extern const tb_field_t StreamResponse_fields[7];
 extern const tb_field_t TestResponse_fields[2];
-extern const tb_field_t Response_fields[14];
+extern const tb_field_t ChunkFifoStatus_fields[4];
+extern const tb_field_t DiagnosticsResponse_fields[6];
+extern const tb_field_t Response_fields[18];
+
+/**< Straight-line encode/decode functions (same binary representation as tb_encode()/tb_decode() with the _fields-arrays) */
+uint8_t StatusRequest_encode(tb_ostream_t* ostream, const StatusRequest* src, tb_endian_t endianness);
+uint8_t StatusRequest_decode(tb_istream_t* istream, StatusRequest* dst, tb_endian_t endianness);
+
+#define StartMicrophoneRequest_ENCODED_LEN 10
+static inline void StartMicrophoneRequest_put(uint8_t* p, const StartMicrophoneRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	tb_put_16(p + 6, (uint16_t) src->timeout, endianness);
+	tb_put_16(p + 8, (uint16_t) src->period_ms, endianness);
+}
+static inline void StartMicrophoneRequest_get(const uint8_t* p, StartMicrophoneRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->timeout = (uint16_t) tb_get_16(p + 6, endianness);
+	dst->period_ms = (uint16_t) tb_get_16(p + 8, endianness);
+}
+uint8_t StartMicrophoneRequest_encode(tb_ostream_t* ostream, const StartMicrophoneRequest* src, tb_endian_t endianness);
+uint8_t StartMicrophoneRequest_decode(tb_istream_t* istream, StartMicrophoneRequest* dst, tb_endian_t endianness);
+
+#define StopMicrophoneRequest_ENCODED_LEN 0
+static inline void StopMicrophoneRequest_put(uint8_t* p, const StopMicrophoneRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void StopMicrophoneRequest_get(const uint8_t* p, StopMicrophoneRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t StopMicrophoneRequest_encode(tb_ostream_t* ostream, const StopMicrophoneRequest* src, tb_endian_t endianness);
+uint8_t StopMicrophoneRequest_decode(tb_istream_t* istream, StopMicrophoneRequest* dst, tb_endian_t endianness);
+
+#define StartScanRequest_ENCODED_LEN 17
+static inline void StartScanRequest_put(uint8_t* p, const StartScanRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	tb_put_16(p + 6, (uint16_t) src->timeout, endianness);
+	tb_put_16(p + 8, (uint16_t) src->window, endianness);
+	tb_put_16(p + 10, (uint16_t) src->interval, endianness);
+	tb_put_16(p + 12, (uint16_t) src->duration, endianness);
+	tb_put_16(p + 14, (uint16_t) src->period, endianness);
+	*(p + 16) = (uint8_t) src->aggregation_type;
+}
+static inline void StartScanRequest_get(const uint8_t* p, StartScanRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->timeout = (uint16_t) tb_get_16(p + 6, endianness);
+	dst->window = (uint16_t) tb_get_16(p + 8, endianness);
+	dst->interval = (uint16_t) tb_get_16(p + 10, endianness);
+	dst->duration = (uint16_t) tb_get_16(p + 12, endianness);
+	dst->period = (uint16_t) tb_get_16(p + 14, endianness);
+	dst->aggregation_type = (uint8_t) *(p + 16);
+}
+uint8_t StartScanRequest_encode(tb_ostream_t* ostream, const StartScanRequest* src, tb_endian_t endianness);
+uint8_t StartScanRequest_decode(tb_istream_t* istream, StartScanRequest* dst, tb_endian_t endianness);
+
+#define StopScanRequest_ENCODED_LEN 0
+static inline void StopScanRequest_put(uint8_t* p, const StopScanRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void StopScanRequest_get(const uint8_t* p, StopScanRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t StopScanRequest_encode(tb_ostream_t* ostream, const StopScanRequest* src, tb_endian_t endianness);
+uint8_t StopScanRequest_decode(tb_istream_t* istream, StopScanRequest* dst, tb_endian_t endianness);
+
+#define StartAccelerometerRequest_ENCODED_LEN 14
+static inline void StartAccelerometerRequest_put(uint8_t* p, const StartAccelerometerRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	tb_put_16(p + 6, (uint16_t) src->timeout, endianness);
+	*(p + 8) = (uint8_t) src->operating_mode;
+	*(p + 9) = (uint8_t) src->full_scale;
+	tb_put_16(p + 10, (uint16_t) src->datarate, endianness);
+	tb_put_16(p + 12, (uint16_t) src->fifo_sampling_period_ms, endianness);
+}
+static inline void StartAccelerometerRequest_get(const uint8_t* p, StartAccelerometerRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->timeout = (uint16_t) tb_get_16(p + 6, endianness);
+	dst->operating_mode = (uint8_t) *(p + 8);
+	dst->full_scale = (uint8_t) *(p + 9);
+	dst->datarate = (uint16_t) tb_get_16(p + 10, endianness);
+	dst->fifo_sampling_period_ms = (uint16_t) tb_get_16(p + 12, endianness);
+}
+uint8_t StartAccelerometerRequest_encode(tb_ostream_t* ostream, const StartAccelerometerRequest* src, tb_endian_t endianness);
+uint8_t StartAccelerometerRequest_decode(tb_istream_t* istream, StartAccelerometerRequest* dst, tb_endian_t endianness);
+
+#define StopAccelerometerRequest_ENCODED_LEN 0
+static inline void StopAccelerometerRequest_put(uint8_t* p, const StopAccelerometerRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void StopAccelerometerRequest_get(const uint8_t* p, StopAccelerometerRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t StopAccelerometerRequest_encode(tb_ostream_t* ostream, const StopAccelerometerRequest* src, tb_endian_t endianness);
+uint8_t StopAccelerometerRequest_decode(tb_istream_t* istream, StopAccelerometerRequest* dst, tb_endian_t endianness);
+
+#define StartAccelerometerInterruptRequest_ENCODED_LEN 16
+static inline void StartAccelerometerInterruptRequest_put(uint8_t* p, const StartAccelerometerInterruptRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	tb_put_16(p + 6, (uint16_t) src->timeout, endianness);
+	tb_put_16(p + 8, (uint16_t) src->threshold_mg, endianness);
+	tb_put_16(p + 10, (uint16_t) src->minimal_duration_ms, endianness);
+	tb_put_32(p + 12, (uint32_t) src->ignore_duration_ms, endianness);
+}
+static inline void StartAccelerometerInterruptRequest_get(const uint8_t* p, StartAccelerometerInterruptRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->timeout = (uint16_t) tb_get_16(p + 6, endianness);
+	dst->threshold_mg = (uint16_t) tb_get_16(p + 8, endianness);
+	dst->minimal_duration_ms = (uint16_t) tb_get_16(p + 10, endianness);
+	dst->ignore_duration_ms = (uint32_t) tb_get_32(p + 12, endianness);
+}
+uint8_t StartAccelerometerInterruptRequest_encode(tb_ostream_t* ostream, const StartAccelerometerInterruptRequest* src, tb_endian_t endianness);
+uint8_t StartAccelerometerInterruptRequest_decode(tb_istream_t* istream, StartAccelerometerInterruptRequest* dst, tb_endian_t endianness);
+
+#define StopAccelerometerInterruptRequest_ENCODED_LEN 0
+static inline void StopAccelerometerInterruptRequest_put(uint8_t* p, const StopAccelerometerInterruptRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void StopAccelerometerInterruptRequest_get(const uint8_t* p, StopAccelerometerInterruptRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t StopAccelerometerInterruptRequest_encode(tb_ostream_t* ostream, const StopAccelerometerInterruptRequest* src, tb_endian_t endianness);
+uint8_t StopAccelerometerInterruptRequest_decode(tb_istream_t* istream, StopAccelerometerInterruptRequest* dst, tb_endian_t endianness);
+
+#define StartBatteryRequest_ENCODED_LEN 12
+static inline void StartBatteryRequest_put(uint8_t* p, const StartBatteryRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	tb_put_16(p + 6, (uint16_t) src->timeout, endianness);
+	tb_put_32(p + 8, (uint32_t) src->period_ms, endianness);
+}
+static inline void StartBatteryRequest_get(const uint8_t* p, StartBatteryRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->timeout = (uint16_t) tb_get_16(p + 6, endianness);
+	dst->period_ms = (uint32_t) tb_get_32(p + 8, endianness);
+}
+uint8_t StartBatteryRequest_encode(tb_ostream_t* ostream, const StartBatteryRequest* src, tb_endian_t endianness);
+uint8_t StartBatteryRequest_decode(tb_istream_t* istream, StartBatteryRequest* dst, tb_endian_t endianness);
+
+#define StopBatteryRequest_ENCODED_LEN 0
+static inline void StopBatteryRequest_put(uint8_t* p, const StopBatteryRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void StopBatteryRequest_get(const uint8_t* p, StopBatteryRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t StopBatteryRequest_encode(tb_ostream_t* ostream, const StopBatteryRequest* src, tb_endian_t endianness);
+uint8_t StopBatteryRequest_decode(tb_istream_t* istream, StopBatteryRequest* dst, tb_endian_t endianness);
+
+#define MicrophoneDataRequest_ENCODED_LEN 6
+static inline void MicrophoneDataRequest_put(uint8_t* p, const MicrophoneDataRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+}
+static inline void MicrophoneDataRequest_get(const uint8_t* p, MicrophoneDataRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+}
+uint8_t MicrophoneDataRequest_encode(tb_ostream_t* ostream, const MicrophoneDataRequest* src, tb_endian_t endianness);
+uint8_t MicrophoneDataRequest_decode(tb_istream_t* istream, MicrophoneDataRequest* dst, tb_endian_t endianness);
+
+#define ScanDataRequest_ENCODED_LEN 6
+static inline void ScanDataRequest_put(uint8_t* p, const ScanDataRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+}
+static inline void ScanDataRequest_get(const uint8_t* p, ScanDataRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+}
+uint8_t ScanDataRequest_encode(tb_ostream_t* ostream, const ScanDataRequest* src, tb_endian_t endianness);
+uint8_t ScanDataRequest_decode(tb_istream_t* istream, ScanDataRequest* dst, tb_endian_t endianness);
+
+#define AccelerometerDataRequest_ENCODED_LEN 6
+static inline void AccelerometerDataRequest_put(uint8_t* p, const AccelerometerDataRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+}
+static inline void AccelerometerDataRequest_get(const uint8_t* p, AccelerometerDataRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+}
+uint8_t AccelerometerDataRequest_encode(tb_ostream_t* ostream, const AccelerometerDataRequest* src, tb_endian_t endianness);
+uint8_t AccelerometerDataRequest_decode(tb_istream_t* istream, AccelerometerDataRequest* dst, tb_endian_t endianness);
+
+#define AccelerometerInterruptDataRequest_ENCODED_LEN 6
+static inline void AccelerometerInterruptDataRequest_put(uint8_t* p, const AccelerometerInterruptDataRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+}
+static inline void AccelerometerInterruptDataRequest_get(const uint8_t* p, AccelerometerInterruptDataRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+}
+uint8_t AccelerometerInterruptDataRequest_encode(tb_ostream_t* ostream, const AccelerometerInterruptDataRequest* src, tb_endian_t endianness);
+uint8_t AccelerometerInterruptDataRequest_decode(tb_istream_t* istream, AccelerometerInterruptDataRequest* dst, tb_endian_t endianness);
+
+#define BatteryDataRequest_ENCODED_LEN 6
+static inline void BatteryDataRequest_put(uint8_t* p, const BatteryDataRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+}
+static inline void BatteryDataRequest_get(const uint8_t* p, BatteryDataRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+}
+uint8_t BatteryDataRequest_encode(tb_ostream_t* ostream, const BatteryDataRequest* src, tb_endian_t endianness);
+uint8_t BatteryDataRequest_decode(tb_istream_t* istream, BatteryDataRequest* dst, tb_endian_t endianness);
+
+#define ExportCursor_ENCODED_LEN 10
+static inline void ExportCursor_put(uint8_t* p, const ExportCursor* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	tb_put_16(p, (uint16_t) src->microphone_record_id, endianness);
+	tb_put_16(p + 2, (uint16_t) src->scan_record_id, endianness);
+	tb_put_16(p + 4, (uint16_t) src->accelerometer_record_id, endianness);
+	tb_put_16(p + 6, (uint16_t) src->accelerometer_interrupt_record_id, endianness);
+	tb_put_16(p + 8, (uint16_t) src->battery_record_id, endianness);
+}
+static inline void ExportCursor_get(const uint8_t* p, ExportCursor* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->microphone_record_id = (uint16_t) tb_get_16(p, endianness);
+	dst->scan_record_id = (uint16_t) tb_get_16(p + 2, endianness);
+	dst->accelerometer_record_id = (uint16_t) tb_get_16(p + 4, endianness);
+	dst->accelerometer_interrupt_record_id = (uint16_t) tb_get_16(p + 6, endianness);
+	dst->battery_record_id = (uint16_t) tb_get_16(p + 8, endianness);
+}
+uint8_t ExportCursor_encode(tb_ostream_t* ostream, const ExportCursor* src, tb_endian_t endianness);
+uint8_t ExportCursor_decode(tb_istream_t* istream, ExportCursor* dst, tb_endian_t endianness);
+
+uint8_t BulkExportRequest_encode(tb_ostream_t* ostream, const BulkExportRequest* src, tb_endian_t endianness);
+uint8_t BulkExportRequest_decode(tb_istream_t* istream, BulkExportRequest* dst, tb_endian_t endianness);
+
+#define PullNewDataRequest_ENCODED_LEN 4
+static inline void PullNewDataRequest_put(uint8_t* p, const PullNewDataRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	tb_put_16(p, (uint16_t) src->hub_id, endianness);
+	tb_put_16(p + 2, (uint16_t) src->checkpoint_interval, endianness);
+}
+static inline void PullNewDataRequest_get(const uint8_t* p, PullNewDataRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->hub_id = (uint16_t) tb_get_16(p, endianness);
+	dst->checkpoint_interval = (uint16_t) tb_get_16(p + 2, endianness);
+}
+uint8_t PullNewDataRequest_encode(tb_ostream_t* ostream, const PullNewDataRequest* src, tb_endian_t endianness);
+uint8_t PullNewDataRequest_decode(tb_istream_t* istream, PullNewDataRequest* dst, tb_endian_t endianness);
+
+#define AcknowledgeDataRequest_ENCODED_LEN 12
+static inline void AcknowledgeDataRequest_put(uint8_t* p, const AcknowledgeDataRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	tb_put_16(p, (uint16_t) src->hub_id, endianness);
+	ExportCursor_put(p + 2, &(src->cursor), endianness);
+}
+static inline void AcknowledgeDataRequest_get(const uint8_t* p, AcknowledgeDataRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->hub_id = (uint16_t) tb_get_16(p, endianness);
+	ExportCursor_get(p + 2, &(dst->cursor), endianness);
+}
+uint8_t AcknowledgeDataRequest_encode(tb_ostream_t* ostream, const AcknowledgeDataRequest* src, tb_endian_t endianness);
+uint8_t AcknowledgeDataRequest_decode(tb_istream_t* istream, AcknowledgeDataRequest* dst, tb_endian_t endianness);
+
+#define SetCompressionRequest_ENCODED_LEN 1
+static inline void SetCompressionRequest_put(uint8_t* p, const SetCompressionRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	*(p) = (uint8_t) src->compression;
+}
+static inline void SetCompressionRequest_get(const uint8_t* p, SetCompressionRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->compression = (uint8_t) *(p);
+}
+uint8_t SetCompressionRequest_encode(tb_ostream_t* ostream, const SetCompressionRequest* src, tb_endian_t endianness);
+uint8_t SetCompressionRequest_decode(tb_istream_t* istream, SetCompressionRequest* dst, tb_endian_t endianness);
+
+#define SetOverflowPolicyRequest_ENCODED_LEN 2
+static inline void SetOverflowPolicyRequest_put(uint8_t* p, const SetOverflowPolicyRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	*(p) = (uint8_t) src->data_source;
+	*(p + 1) = (uint8_t) src->overflow_policy;
+}
+static inline void SetOverflowPolicyRequest_get(const uint8_t* p, SetOverflowPolicyRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->data_source = (uint8_t) *(p);
+	dst->overflow_policy = (uint8_t) *(p + 1);
+}
+uint8_t SetOverflowPolicyRequest_encode(tb_ostream_t* ostream, const SetOverflowPolicyRequest* src, tb_endian_t endianness);
+uint8_t SetOverflowPolicyRequest_decode(tb_istream_t* istream, SetOverflowPolicyRequest* dst, tb_endian_t endianness);
+
+#define StartMicrophoneStreamRequest_ENCODED_LEN 10
+static inline void StartMicrophoneStreamRequest_put(uint8_t* p, const StartMicrophoneStreamRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	tb_put_16(p + 6, (uint16_t) src->timeout, endianness);
+	tb_put_16(p + 8, (uint16_t) src->period_ms, endianness);
+}
+static inline void StartMicrophoneStreamRequest_get(const uint8_t* p, StartMicrophoneStreamRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->timeout = (uint16_t) tb_get_16(p + 6, endianness);
+	dst->period_ms = (uint16_t) tb_get_16(p + 8, endianness);
+}
+uint8_t StartMicrophoneStreamRequest_encode(tb_ostream_t* ostream, const StartMicrophoneStreamRequest* src, tb_endian_t endianness);
+uint8_t StartMicrophoneStreamRequest_decode(tb_istream_t* istream, StartMicrophoneStreamRequest* dst, tb_endian_t endianness);
+
+#define StopMicrophoneStreamRequest_ENCODED_LEN 0
+static inline void StopMicrophoneStreamRequest_put(uint8_t* p, const StopMicrophoneStreamRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void StopMicrophoneStreamRequest_get(const uint8_t* p, StopMicrophoneStreamRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t StopMicrophoneStreamRequest_encode(tb_ostream_t* ostream, const StopMicrophoneStreamRequest* src, tb_endian_t endianness);
+uint8_t StopMicrophoneStreamRequest_decode(tb_istream_t* istream, StopMicrophoneStreamRequest* dst, tb_endian_t endianness);
+
+#define StartScanStreamRequest_ENCODED_LEN 17
+static inline void StartScanStreamRequest_put(uint8_t* p, const StartScanStreamRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	tb_put_16(p + 6, (uint16_t) src->timeout, endianness);
+	tb_put_16(p + 8, (uint16_t) src->window, endianness);
+	tb_put_16(p + 10, (uint16_t) src->interval, endianness);
+	tb_put_16(p + 12, (uint16_t) src->duration, endianness);
+	tb_put_16(p + 14, (uint16_t) src->period, endianness);
+	*(p + 16) = (uint8_t) src->aggregation_type;
+}
+static inline void StartScanStreamRequest_get(const uint8_t* p, StartScanStreamRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->timeout = (uint16_t) tb_get_16(p + 6, endianness);
+	dst->window = (uint16_t) tb_get_16(p + 8, endianness);
+	dst->interval = (uint16_t) tb_get_16(p + 10, endianness);
+	dst->duration = (uint16_t) tb_get_16(p + 12, endianness);
+	dst->period = (uint16_t) tb_get_16(p + 14, endianness);
+	dst->aggregation_type = (uint8_t) *(p + 16);
+}
+uint8_t StartScanStreamRequest_encode(tb_ostream_t* ostream, const StartScanStreamRequest* src, tb_endian_t endianness);
+uint8_t StartScanStreamRequest_decode(tb_istream_t* istream, StartScanStreamRequest* dst, tb_endian_t endianness);
+
+#define StopScanStreamRequest_ENCODED_LEN 0
+static inline void StopScanStreamRequest_put(uint8_t* p, const StopScanStreamRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void StopScanStreamRequest_get(const uint8_t* p, StopScanStreamRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t StopScanStreamRequest_encode(tb_ostream_t* ostream, const StopScanStreamRequest* src, tb_endian_t endianness);
+uint8_t StopScanStreamRequest_decode(tb_istream_t* istream, StopScanStreamRequest* dst, tb_endian_t endianness);
+
+#define StartAccelerometerStreamRequest_ENCODED_LEN 14
+static inline void StartAccelerometerStreamRequest_put(uint8_t* p, const StartAccelerometerStreamRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	tb_put_16(p + 6, (uint16_t) src->timeout, endianness);
+	*(p + 8) = (uint8_t) src->operating_mode;
+	*(p + 9) = (uint8_t) src->full_scale;
+	tb_put_16(p + 10, (uint16_t) src->datarate, endianness);
+	tb_put_16(p + 12, (uint16_t) src->fifo_sampling_period_ms, endianness);
+}
+static inline void StartAccelerometerStreamRequest_get(const uint8_t* p, StartAccelerometerStreamRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->timeout = (uint16_t) tb_get_16(p + 6, endianness);
+	dst->operating_mode = (uint8_t) *(p + 8);
+	dst->full_scale = (uint8_t) *(p + 9);
+	dst->datarate = (uint16_t) tb_get_16(p + 10, endianness);
+	dst->fifo_sampling_period_ms = (uint16_t) tb_get_16(p + 12, endianness);
+}
+uint8_t StartAccelerometerStreamRequest_encode(tb_ostream_t* ostream, const StartAccelerometerStreamRequest* src, tb_endian_t endianness);
+uint8_t StartAccelerometerStreamRequest_decode(tb_istream_t* istream, StartAccelerometerStreamRequest* dst, tb_endian_t endianness);
+
+#define StopAccelerometerStreamRequest_ENCODED_LEN 0
+static inline void StopAccelerometerStreamRequest_put(uint8_t* p, const StopAccelerometerStreamRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void StopAccelerometerStreamRequest_get(const uint8_t* p, StopAccelerometerStreamRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t StopAccelerometerStreamRequest_encode(tb_ostream_t* ostream, const StopAccelerometerStreamRequest* src, tb_endian_t endianness);
+uint8_t StopAccelerometerStreamRequest_decode(tb_istream_t* istream, StopAccelerometerStreamRequest* dst, tb_endian_t endianness);
+
+#define StartAccelerometerInterruptStreamRequest_ENCODED_LEN 16
+static inline void StartAccelerometerInterruptStreamRequest_put(uint8_t* p, const StartAccelerometerInterruptStreamRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	tb_put_16(p + 6, (uint16_t) src->timeout, endianness);
+	tb_put_16(p + 8, (uint16_t) src->threshold_mg, endianness);
+	tb_put_16(p + 10, (uint16_t) src->minimal_duration_ms, endianness);
+	tb_put_32(p + 12, (uint32_t) src->ignore_duration_ms, endianness);
+}
+static inline void StartAccelerometerInterruptStreamRequest_get(const uint8_t* p, StartAccelerometerInterruptStreamRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->timeout = (uint16_t) tb_get_16(p + 6, endianness);
+	dst->threshold_mg = (uint16_t) tb_get_16(p + 8, endianness);
+	dst->minimal_duration_ms = (uint16_t) tb_get_16(p + 10, endianness);
+	dst->ignore_duration_ms = (uint32_t) tb_get_32(p + 12, endianness);
+}
+uint8_t StartAccelerometerInterruptStreamRequest_encode(tb_ostream_t* ostream, const StartAccelerometerInterruptStreamRequest* src, tb_endian_t endianness);
+uint8_t StartAccelerometerInterruptStreamRequest_decode(tb_istream_t* istream, StartAccelerometerInterruptStreamRequest* dst, tb_endian_t endianness);
+
+#define StopAccelerometerInterruptStreamRequest_ENCODED_LEN 0
+static inline void StopAccelerometerInterruptStreamRequest_put(uint8_t* p, const StopAccelerometerInterruptStreamRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void StopAccelerometerInterruptStreamRequest_get(const uint8_t* p, StopAccelerometerInterruptStreamRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t StopAccelerometerInterruptStreamRequest_encode(tb_ostream_t* ostream, const StopAccelerometerInterruptStreamRequest* src, tb_endian_t endianness);
+uint8_t StopAccelerometerInterruptStreamRequest_decode(tb_istream_t* istream, StopAccelerometerInterruptStreamRequest* dst, tb_endian_t endianness);
+
+#define StartBatteryStreamRequest_ENCODED_LEN 12
+static inline void StartBatteryStreamRequest_put(uint8_t* p, const StartBatteryStreamRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+	tb_put_16(p + 6, (uint16_t) src->timeout, endianness);
+	tb_put_32(p + 8, (uint32_t) src->period_ms, endianness);
+}
+static inline void StartBatteryStreamRequest_get(const uint8_t* p, StartBatteryStreamRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+	dst->timeout = (uint16_t) tb_get_16(p + 6, endianness);
+	dst->period_ms = (uint32_t) tb_get_32(p + 8, endianness);
+}
+uint8_t StartBatteryStreamRequest_encode(tb_ostream_t* ostream, const StartBatteryStreamRequest* src, tb_endian_t endianness);
+uint8_t StartBatteryStreamRequest_decode(tb_istream_t* istream, StartBatteryStreamRequest* dst, tb_endian_t endianness);
+
+#define StopBatteryStreamRequest_ENCODED_LEN 0
+static inline void StopBatteryStreamRequest_put(uint8_t* p, const StopBatteryStreamRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void StopBatteryStreamRequest_get(const uint8_t* p, StopBatteryStreamRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t StopBatteryStreamRequest_encode(tb_ostream_t* ostream, const StopBatteryStreamRequest* src, tb_endian_t endianness);
+uint8_t StopBatteryStreamRequest_decode(tb_istream_t* istream, StopBatteryStreamRequest* dst, tb_endian_t endianness);
+
+#define IdentifyRequest_ENCODED_LEN 2
+static inline void IdentifyRequest_put(uint8_t* p, const IdentifyRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	tb_put_16(p, (uint16_t) src->timeout, endianness);
+}
+static inline void IdentifyRequest_get(const uint8_t* p, IdentifyRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->timeout = (uint16_t) tb_get_16(p, endianness);
+}
+uint8_t IdentifyRequest_encode(tb_ostream_t* ostream, const IdentifyRequest* src, tb_endian_t endianness);
+uint8_t IdentifyRequest_decode(tb_istream_t* istream, IdentifyRequest* dst, tb_endian_t endianness);
+
+#define TestRequest_ENCODED_LEN 0
+static inline void TestRequest_put(uint8_t* p, const TestRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void TestRequest_get(const uint8_t* p, TestRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t TestRequest_encode(tb_ostream_t* ostream, const TestRequest* src, tb_endian_t endianness);
+uint8_t TestRequest_decode(tb_istream_t* istream, TestRequest* dst, tb_endian_t endianness);
+
+#define RestartRequest_ENCODED_LEN 0
+static inline void RestartRequest_put(uint8_t* p, const RestartRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void RestartRequest_get(const uint8_t* p, RestartRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t RestartRequest_encode(tb_ostream_t* ostream, const RestartRequest* src, tb_endian_t endianness);
+uint8_t RestartRequest_decode(tb_istream_t* istream, RestartRequest* dst, tb_endian_t endianness);
+
+#define DiagnosticsRequest_ENCODED_LEN 1
+static inline void DiagnosticsRequest_put(uint8_t* p, const DiagnosticsRequest* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	*(p) = (uint8_t) src->reset_chunk_fifo_status;
+}
+static inline void DiagnosticsRequest_get(const uint8_t* p, DiagnosticsRequest* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->reset_chunk_fifo_status = (uint8_t) *(p);
+}
+uint8_t DiagnosticsRequest_encode(tb_ostream_t* ostream, const DiagnosticsRequest* src, tb_endian_t endianness);
+uint8_t DiagnosticsRequest_decode(tb_istream_t* istream, DiagnosticsRequest* dst, tb_endian_t endianness);
+
+uint8_t Request_encode(tb_ostream_t* ostream, const Request* src, tb_endian_t endianness);
+uint8_t Request_decode(tb_istream_t* istream, Request* dst, tb_endian_t endianness);
+
+#define StatusResponse_ENCODED_LEN 18
+static inline void StatusResponse_put(uint8_t* p, const StatusResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	*(p) = (uint8_t) src->clock_status;
+	*(p + 1) = (uint8_t) src->microphone_status;
+	*(p + 2) = (uint8_t) src->scan_status;
+	*(p + 3) = (uint8_t) src->accelerometer_status;
+	*(p + 4) = (uint8_t) src->accelerometer_interrupt_status;
+	*(p + 5) = (uint8_t) src->battery_status;
+	Timestamp_put(p + 6, &(src->timestamp), endianness);
+	BatteryData_put(p + 12, &(src->battery_data), endianness);
+	tb_put_16(p + 16, (uint16_t) src->dropped_chunks, endianness);
+}
+static inline void StatusResponse_get(const uint8_t* p, StatusResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->clock_status = (uint8_t) *(p);
+	dst->microphone_status = (uint8_t) *(p + 1);
+	dst->scan_status = (uint8_t) *(p + 2);
+	dst->accelerometer_status = (uint8_t) *(p + 3);
+	dst->accelerometer_interrupt_status = (uint8_t) *(p + 4);
+	dst->battery_status = (uint8_t) *(p + 5);
+	Timestamp_get(p + 6, &(dst->timestamp), endianness);
+	BatteryData_get(p + 12, &(dst->battery_data), endianness);
+	dst->dropped_chunks = (uint16_t) tb_get_16(p + 16, endianness);
+}
+uint8_t StatusResponse_encode(tb_ostream_t* ostream, const StatusResponse* src, tb_endian_t endianness);
+uint8_t StatusResponse_decode(tb_istream_t* istream, StatusResponse* dst, tb_endian_t endianness);
+
+#define StartMicrophoneResponse_ENCODED_LEN 6
+static inline void StartMicrophoneResponse_put(uint8_t* p, const StartMicrophoneResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+}
+static inline void StartMicrophoneResponse_get(const uint8_t* p, StartMicrophoneResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+}
+uint8_t StartMicrophoneResponse_encode(tb_ostream_t* ostream, const StartMicrophoneResponse* src, tb_endian_t endianness);
+uint8_t StartMicrophoneResponse_decode(tb_istream_t* istream, StartMicrophoneResponse* dst, tb_endian_t endianness);
+
+#define StartScanResponse_ENCODED_LEN 6
+static inline void StartScanResponse_put(uint8_t* p, const StartScanResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+}
+static inline void StartScanResponse_get(const uint8_t* p, StartScanResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+}
+uint8_t StartScanResponse_encode(tb_ostream_t* ostream, const StartScanResponse* src, tb_endian_t endianness);
+uint8_t StartScanResponse_decode(tb_istream_t* istream, StartScanResponse* dst, tb_endian_t endianness);
+
+#define StartAccelerometerResponse_ENCODED_LEN 6
+static inline void StartAccelerometerResponse_put(uint8_t* p, const StartAccelerometerResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+}
+static inline void StartAccelerometerResponse_get(const uint8_t* p, StartAccelerometerResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+}
+uint8_t StartAccelerometerResponse_encode(tb_ostream_t* ostream, const StartAccelerometerResponse* src, tb_endian_t endianness);
+uint8_t StartAccelerometerResponse_decode(tb_istream_t* istream, StartAccelerometerResponse* dst, tb_endian_t endianness);
+
+#define StartAccelerometerInterruptResponse_ENCODED_LEN 6
+static inline void StartAccelerometerInterruptResponse_put(uint8_t* p, const StartAccelerometerInterruptResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+}
+static inline void StartAccelerometerInterruptResponse_get(const uint8_t* p, StartAccelerometerInterruptResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+}
+uint8_t StartAccelerometerInterruptResponse_encode(tb_ostream_t* ostream, const StartAccelerometerInterruptResponse* src, tb_endian_t endianness);
+uint8_t StartAccelerometerInterruptResponse_decode(tb_istream_t* istream, StartAccelerometerInterruptResponse* dst, tb_endian_t endianness);
+
+#define StartBatteryResponse_ENCODED_LEN 6
+static inline void StartBatteryResponse_put(uint8_t* p, const StartBatteryResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+}
+static inline void StartBatteryResponse_get(const uint8_t* p, StartBatteryResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+}
+uint8_t StartBatteryResponse_encode(tb_ostream_t* ostream, const StartBatteryResponse* src, tb_endian_t endianness);
+uint8_t StartBatteryResponse_decode(tb_istream_t* istream, StartBatteryResponse* dst, tb_endian_t endianness);
+
+uint8_t MicrophoneDataResponse_encode(tb_ostream_t* ostream, const MicrophoneDataResponse* src, tb_endian_t endianness);
+uint8_t MicrophoneDataResponse_decode(tb_istream_t* istream, MicrophoneDataResponse* dst, tb_endian_t endianness);
+
+uint8_t ScanDataResponse_encode(tb_ostream_t* ostream, const ScanDataResponse* src, tb_endian_t endianness);
+uint8_t ScanDataResponse_decode(tb_istream_t* istream, ScanDataResponse* dst, tb_endian_t endianness);
+
+uint8_t AccelerometerDataResponse_encode(tb_ostream_t* ostream, const AccelerometerDataResponse* src, tb_endian_t endianness);
+uint8_t AccelerometerDataResponse_decode(tb_istream_t* istream, AccelerometerDataResponse* dst, tb_endian_t endianness);
+
+#define AccelerometerInterruptDataResponse_ENCODED_LEN 7
+static inline void AccelerometerInterruptDataResponse_put(uint8_t* p, const AccelerometerInterruptDataResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	*(p) = (uint8_t) src->last_response;
+	Timestamp_put(p + 1, &(src->timestamp), endianness);
+}
+static inline void AccelerometerInterruptDataResponse_get(const uint8_t* p, AccelerometerInterruptDataResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->last_response = (uint8_t) *(p);
+	Timestamp_get(p + 1, &(dst->timestamp), endianness);
+}
+uint8_t AccelerometerInterruptDataResponse_encode(tb_ostream_t* ostream, const AccelerometerInterruptDataResponse* src, tb_endian_t endianness);
+uint8_t AccelerometerInterruptDataResponse_decode(tb_istream_t* istream, AccelerometerInterruptDataResponse* dst, tb_endian_t endianness);
+
+#define BatteryDataResponse_ENCODED_LEN 11
+static inline void BatteryDataResponse_put(uint8_t* p, const BatteryDataResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	*(p) = (uint8_t) src->last_response;
+	Timestamp_put(p + 1, &(src->timestamp), endianness);
+	BatteryData_put(p + 7, &(src->battery_data), endianness);
+}
+static inline void BatteryDataResponse_get(const uint8_t* p, BatteryDataResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->last_response = (uint8_t) *(p);
+	Timestamp_get(p + 1, &(dst->timestamp), endianness);
+	BatteryData_get(p + 7, &(dst->battery_data), endianness);
+}
+uint8_t BatteryDataResponse_encode(tb_ostream_t* ostream, const BatteryDataResponse* src, tb_endian_t endianness);
+uint8_t BatteryDataResponse_decode(tb_istream_t* istream, BatteryDataResponse* dst, tb_endian_t endianness);
+
+#define BulkExportCheckpointResponse_ENCODED_LEN 11
+static inline void BulkExportCheckpointResponse_put(uint8_t* p, const BulkExportCheckpointResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	*(p) = (uint8_t) src->last_response;
+	ExportCursor_put(p + 1, &(src->cursor), endianness);
+}
+static inline void BulkExportCheckpointResponse_get(const uint8_t* p, BulkExportCheckpointResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->last_response = (uint8_t) *(p);
+	ExportCursor_get(p + 1, &(dst->cursor), endianness);
+}
+uint8_t BulkExportCheckpointResponse_encode(tb_ostream_t* ostream, const BulkExportCheckpointResponse* src, tb_endian_t endianness);
+uint8_t BulkExportCheckpointResponse_decode(tb_istream_t* istream, BulkExportCheckpointResponse* dst, tb_endian_t endianness);
+
+#define SetCompressionResponse_ENCODED_LEN 1
+static inline void SetCompressionResponse_put(uint8_t* p, const SetCompressionResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	*(p) = (uint8_t) src->compression;
+}
+static inline void SetCompressionResponse_get(const uint8_t* p, SetCompressionResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->compression = (uint8_t) *(p);
+}
+uint8_t SetCompressionResponse_encode(tb_ostream_t* ostream, const SetCompressionResponse* src, tb_endian_t endianness);
+uint8_t SetCompressionResponse_decode(tb_istream_t* istream, SetCompressionResponse* dst, tb_endian_t endianness);
+
+#define SetOverflowPolicyResponse_ENCODED_LEN 1
+static inline void SetOverflowPolicyResponse_put(uint8_t* p, const SetOverflowPolicyResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	*(p) = (uint8_t) src->overflow_policy;
+}
+static inline void SetOverflowPolicyResponse_get(const uint8_t* p, SetOverflowPolicyResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->overflow_policy = (uint8_t) *(p);
+}
+uint8_t SetOverflowPolicyResponse_encode(tb_ostream_t* ostream, const SetOverflowPolicyResponse* src, tb_endian_t endianness);
+uint8_t SetOverflowPolicyResponse_decode(tb_istream_t* istream, SetOverflowPolicyResponse* dst, tb_endian_t endianness);
+
+uint8_t StreamResponse_encode(tb_ostream_t* ostream, const StreamResponse* src, tb_endian_t endianness);
+uint8_t StreamResponse_decode(tb_istream_t* istream, StreamResponse* dst, tb_endian_t endianness);
+
+#define TestResponse_ENCODED_LEN 1
+static inline void TestResponse_put(uint8_t* p, const TestResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	*(p) = (uint8_t) src->test_failed;
+}
+static inline void TestResponse_get(const uint8_t* p, TestResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->test_failed = (uint8_t) *(p);
+}
+uint8_t TestResponse_encode(tb_ostream_t* ostream, const TestResponse* src, tb_endian_t endianness);
+uint8_t TestResponse_decode(tb_istream_t* istream, TestResponse* dst, tb_endian_t endianness);
+
+#define ChunkFifoStatus_ENCODED_LEN 4
+static inline void ChunkFifoStatus_put(uint8_t* p, const ChunkFifoStatus* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	tb_put_16(p, (uint16_t) src->dropped_chunks, endianness);
+	*(p + 2) = (uint8_t) src->high_water_mark;
+	*(p + 3) = (uint8_t) src->capacity;
+}
+static inline void ChunkFifoStatus_get(const uint8_t* p, ChunkFifoStatus* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	dst->dropped_chunks = (uint16_t) tb_get_16(p, endianness);
+	dst->high_water_mark = (uint8_t) *(p + 2);
+	dst->capacity = (uint8_t) *(p + 3);
+}
+uint8_t ChunkFifoStatus_encode(tb_ostream_t* ostream, const ChunkFifoStatus* src, tb_endian_t endianness);
+uint8_t ChunkFifoStatus_decode(tb_istream_t* istream, ChunkFifoStatus* dst, tb_endian_t endianness);
+
+#define DiagnosticsResponse_ENCODED_LEN 20
+static inline void DiagnosticsResponse_put(uint8_t* p, const DiagnosticsResponse* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	ChunkFifoStatus_put(p, &(src->microphone_chunk_fifo_status), endianness);
+	ChunkFifoStatus_put(p + 4, &(src->scan_chunk_fifo_status), endianness);
+	ChunkFifoStatus_put(p + 8, &(src->accelerometer_chunk_fifo_status), endianness);
+	ChunkFifoStatus_put(p + 12, &(src->accelerometer_interrupt_chunk_fifo_status), endianness);
+	ChunkFifoStatus_put(p + 16, &(src->battery_chunk_fifo_status), endianness);
+}
+static inline void DiagnosticsResponse_get(const uint8_t* p, DiagnosticsResponse* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	ChunkFifoStatus_get(p, &(dst->microphone_chunk_fifo_status), endianness);
+	ChunkFifoStatus_get(p + 4, &(dst->scan_chunk_fifo_status), endianness);
+	ChunkFifoStatus_get(p + 8, &(dst->accelerometer_chunk_fifo_status), endianness);
+	ChunkFifoStatus_get(p + 12, &(dst->accelerometer_interrupt_chunk_fifo_status), endianness);
+	ChunkFifoStatus_get(p + 16, &(dst->battery_chunk_fifo_status), endianness);
+}
+uint8_t DiagnosticsResponse_encode(tb_ostream_t* ostream, const DiagnosticsResponse* src, tb_endian_t endianness);
+uint8_t DiagnosticsResponse_decode(tb_istream_t* istream, DiagnosticsResponse* dst, tb_endian_t endianness);
+
+uint8_t Response_encode(tb_ostream_t* ostream, const Response* src, tb_endian_t endianness);
+uint8_t Response_decode(tb_istream_t* istream, Response* dst, tb_endian_t endianness);
+
 
 #endif
@@ -7,7 +7,7 @@
 
 #include <string.h>
 #include "app_fifo.h"
-#include "app_scheduler.h"
+#include "scheduler_lib.h"
 #include "sender_lib.h"
 #include "systick_lib.h"
 #include "storer_lib.h"
@@ -173,13 +173,13 @@ static void receive_notification_handler(receive_notification_t receive_notifica
 	// processed notification is ready.
 	if(!processing_receive_notification) {
 		processing_receive_notification = 1;		
-		app_sched_event_put(NULL, 0, process_receive_notification);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, process_receive_notification);
 	}
 }
 
 static void finish_request(void) {
 	processing_receive_notification = 0;
-	app_sched_event_put(NULL, 0, process_receive_notification);
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, process_receive_notification);
 }
 
 // Called when await data failed, or decoding the notification failed, or request does not exist, or transmitting the response failed (because disconnected or something else)
@@ -356,7 +356,7 @@ static void send_response(void * p_event_data, uint16_t event_size) {
 	
 	if(ret == NRF_SUCCESS) {
 		if(response_event.response_success_handler != NULL) {
-			app_sched_event_put(NULL, 0, response_event.response_success_handler);
+			scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, response_event.response_success_handler);
 		} else {
 			// If we don't need to call a success_handler-function, we are done with the request
 			finish_request();
@@ -364,7 +364,7 @@ static void send_response(void * p_event_data, uint16_t event_size) {
 	} else {
 		if(ret == NRF_ERROR_NO_MEM)	// Only reschedule a fail handler, if we could not transmit because of memory problems
 			if(response_event.response_fail_handler != NULL) {	// This function should actually always be set..
-				app_sched_event_put(NULL, 0, response_event.response_fail_handler);
+				scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, response_event.response_fail_handler);
 				return;
 			}
 		// Some BLE-problems occured (e.g. disconnected...)
@@ -468,7 +468,7 @@ static void microphone_data_response_handler(void * p_event_data, uint16_t event
 		response_event.response_success_handler = NULL;
 		send_response(NULL, 0);	
 	} else {
-		app_sched_event_put(NULL, 0, microphone_data_response_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, microphone_data_response_handler);
 	}
 }
 
@@ -500,7 +500,7 @@ static void scan_data_response_handler(void * p_event_data, uint16_t event_size)
 		response_event.response_success_handler = NULL;
 		send_response(NULL, 0);	
 	} else {
-		app_sched_event_put(NULL, 0, scan_data_response_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, scan_data_response_handler);
 	}
 }
 
@@ -527,7 +527,7 @@ static void status_request_handler(void * p_event_data, uint16_t event_size) {
 	systick_set_timestamp(request_event.request_timepoint_ticks, timestamp.seconds, timestamp.ms);
 	advertiser_set_status_flag_is_clock_synced(1);
 	
-	app_sched_event_put(NULL, 0, status_response_handler);
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, status_response_handler);
 }
 
 static void status_assign_request_handler(void * p_event_data, uint16_t event_size) {
@@ -543,11 +543,11 @@ static void status_assign_request_handler(void * p_event_data, uint16_t event_si
 	
 	ret_code_t ret = advertiser_set_badge_assignement(badge_assignement);
 	if(ret == NRF_ERROR_INTERNAL) {
-		app_sched_event_put(NULL, 0, status_assign_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, status_assign_request_handler);
 	} else if(ret != NRF_SUCCESS) {
 		finish_request_error();
 	} else { // ret should be NRF_SUCCESS here
-		app_sched_event_put(NULL, 0, status_response_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, status_response_handler);
 	}
 }
 
@@ -566,10 +566,10 @@ static void start_microphone_request_handler(void * p_event_data, uint16_t event
 	debug_log("REQUEST_HANDLER: Ret sampling_start_microphone: %d\n\r", ret);
 	
 	if(ret == NRF_SUCCESS) {
-		app_sched_event_put(NULL, 0, start_microphone_response_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_microphone_response_handler);
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, start_microphone_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_microphone_request_handler);
 	}
 }
 
@@ -577,7 +577,7 @@ static void stop_microphone_request_handler(void * p_event_data, uint16_t event_
 	sampling_stop_microphone(0);
 	
 	debug_log("REQUEST_HANDLER: Stop microphone\n");
-	app_sched_event_put(NULL, 0, stop_microphone_response_handler);
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, stop_microphone_response_handler);
 }
 
 static void start_scan_request_handler(void * p_event_data, uint16_t event_size) {
@@ -604,10 +604,10 @@ static void start_scan_request_handler(void * p_event_data, uint16_t event_size)
 	
 	
 	if(ret == NRF_SUCCESS) {
-		app_sched_event_put(NULL, 0, start_scan_response_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_scan_response_handler);
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, start_scan_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_scan_request_handler);
 	}
 }
 
@@ -615,7 +615,7 @@ static void stop_scan_request_handler(void * p_event_data, uint16_t event_size)
 	sampling_stop_scan(0);
 	
 	debug_log("REQUEST_HANDLER: Stop scan\n");
-	app_sched_event_put(NULL, 0, stop_scan_response_handler);
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, stop_scan_response_handler);
 }
 
 
@@ -623,12 +623,12 @@ static void microphone_data_request_handler(void * p_event_data, uint16_t event_
 	Timestamp timestamp = request_event.request.type.microphone_data_request.timestamp;
 	debug_log("REQUEST_HANDLER: Pull microphone data since: %u s, %u ms\n", timestamp.seconds, timestamp.ms);
 	
-	ret_code_t ret = storer_find_microphone_chunk_from_timestamp(timestamp, &microphone_chunk);
+	ret_code_t ret = storer_find_microphone_chunk_from_timestamp(timestamp);
 	if(ret == NRF_SUCCESS || ret == NRF_ERROR_INVALID_STATE) {
-		app_sched_event_put(NULL, 0, microphone_data_response_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, microphone_data_response_handler);
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, microphone_data_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, microphone_data_request_handler);
 	}	
 }
 
@@ -640,12 +640,12 @@ static void scan_data_request_handler(void * p_event_data, uint16_t event_size)
 	timestamp.ms		= 0;
 	debug_log("REQUEST_HANDLER: Pull scan data since: %u s, %u ms\n", timestamp.seconds, timestamp.ms);
 	
-	ret_code_t ret = storer_find_scan_chunk_from_timestamp(timestamp, &scan_chunk);
+	ret_code_t ret = storer_find_scan_chunk_from_timestamp(timestamp);
 	if(ret == NRF_SUCCESS || ret == NRF_ERROR_INVALID_STATE) {
-		app_sched_event_put(NULL, 0, scan_data_response_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, scan_data_response_handler);
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, scan_data_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, scan_data_request_handler);
 	}	
 
 }
@@ -660,7 +660,7 @@ static void identify_request_handler(void * p_event_data, uint16_t event_size) {
 	systick_delay_millis(timeout*1000);
 	nrf_gpio_pin_write(RED_LED, LED_OFF); 
 	#endif
-	app_sched_event_put(NULL, 0, identify_response_handler);
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, identify_response_handler);
 }
 
 #endif
@@ -5,7 +5,9 @@
 
 #include <string.h>
 #include "app_fifo.h"
-#include "app_scheduler.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+#include "scheduler_lib.h"
 #include "sender_lib.h"
 #include "systick_lib.h"
 #include "storer_lib.h"
@@ -20,6 +22,7 @@
 #include "protocol_messages_02v1.h"
 #include "chunk_messages.h"
 #include "selftest_lib.h"
+#include "compression_lib.h"
 
 #ifndef UNIT_TEST
 #include "custom_board.h"
@@ -27,20 +30,59 @@
 #endif
 
 #define RECEIVE_NOTIFICATION_FIFO_SIZE					256		/**< Buffer size for the receive-notification FIFO. Has to be a power of two */
-#define AWAIT_DATA_TIMEOUT_MS							1000
-#define TRANSMIT_DATA_TIMEOUT_MS						100
+#define AWAIT_DATA_TIMEOUT_MS							1000	/**< Maximum time to receive the rest of a request frame, after its first notification */
 #define REQUEST_HANDLER_SERIALIZED_BUFFER_SIZE			512		
+#define REQUEST_HANDLER_RESPONSE_BUFFERS				1		/**< Number of response buffers that could be in transmission at the same time (each needs REQUEST_HANDLER_SERIALIZED_BUFFER_SIZE bytes) */
 #define RESPONSE_MAX_TRANSMIT_RETRIES					50		
+#define RESPONSE_LENGTH_HEADER_COMPRESSED_FLAG			0x8000	/**< Flag in the length header, if the response is compressed (see compression_lib.h) */
+#define LENGTH_HEADER_REQUEST_ID_FLAG					0x4000	/**< Flag in the length header, if a request-id byte follows the header (the responses to such a request carry the same request-id) */
+#define LENGTH_HEADER_LEN_MASK							0x3FFF	/**< Mask of the length in the length header */
+#define REQUEST_ID_NONE									0xFFFF	/**< The request-id of requests without request-id (the response frames have no request-id) */
+#define STREAM_MAX_LATENCY_MS							500		/**< Maximum time streamed samples wait in the stream-fifos before a stream response is triggered */
+#define STREAM_MAX_BATCH_SIZE							10		/**< Maximum number of samples per data-source a stream response is triggered at (limited by the PROTOCOL_*_STREAM_SIZE of each data-source) */
 
 
 
 typedef struct {
 	uint64_t 	request_timepoint_ticks;
+	uint16_t	request_id;		/**< The request-id of the request frame, or REQUEST_ID_NONE */
 	Request 	request;
 } request_event_t;
 
+typedef struct {
+	uint8_t		receiving;			/**< Flag if a request frame is currently received */
+	uint8_t		header_received;	/**< Flag if the length header of the request frame was already read */
+	uint8_t		has_request_id;		/**< Flag if a request-id byte follows the length header */
+	uint16_t	len;				/**< The length of the encoded request */
+} receive_frame_t;
+
+/**< The fill-level of the stream-fifos (see get_stream_fill()) */
+typedef enum {
+	STREAM_FILL_EMPTY	= 0,	/**< All stream-fifos are empty */
+	STREAM_FILL_PARTIAL	= 1,	/**< At least one stream-fifo has samples, but none has a complete batch */
+	STREAM_FILL_BATCH	= 2,	/**< At least one stream-fifo has a complete batch */
+} stream_fill_t;
+
+typedef struct {
+	sampling_configuration_t	streaming;		/**< The streaming-flag of the data-source */
+	circular_fifo_t*			stream_fifo;	/**< The stream-fifo of the data-source */
+	uint32_t					element_size;	/**< The size of one streamed sample */
+	uint32_t					max_count;		/**< The maximum number of samples in a stream response (PROTOCOL_*_STREAM_SIZE) */
+} stream_source_t;
+
+typedef struct {
+	uint16_t	checkpoint_interval;		/**< Number of records after which a cursor checkpoint is sent (0: only at the end) */
+	uint16_t	records_since_checkpoint;
+	uint8_t		partition;					/**< The partition to export the next record from (round-robin) */
+	uint8_t		finished_partitions;		/**< Bit-mask of the partitions without further records */
+	uint16_t	next_record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS];	/**< The cursor: record-id of the next record to export for each partition */
+	uint16_t	request_id;					/**< The request-id of the bulk export (or pull new data) request */
+	uint8_t		active;						/**< Flag if the bulk_export_response_handler-chain is running (until the final checkpoint or an error) */
+} bulk_export_t;
+
 typedef struct {
 	uint32_t					response_retries;
+	uint16_t					request_id;					/**< The request-id of the request this response belongs to, or REQUEST_ID_NONE */
 	app_sched_event_handler_t	response_success_handler;	/**< Scheduler function that should be called, after the reponse was transmitted successfully, to queue some other reponses */
 	app_sched_event_handler_t	response_fail_handler;		/**< Scheduler function that should be called, if the response could not be transmitted */
 	Response					response;
@@ -69,19 +111,56 @@ static volatile uint8_t processing_receive_notification = 0;			/**< Flag that re
 static volatile uint8_t processing_response = 0;						/**< Flag that represents if the processing of response is still running. */
 static volatile uint8_t streaming_started = 0;							/**< Flag that represents if streaming is currently running. */
 
-static uint8_t serialized_buf[REQUEST_HANDLER_SERIALIZED_BUFFER_SIZE];
+static bulk_export_t	bulk_export;	/**< The state of the current bulk export */
+static receive_frame_t	receive_frame;	/**< The state of the request frame that is currently received */
+static uint16_t			stream_request_id = REQUEST_ID_NONE;	/**< The request-id of the last start stream request (for the stream responses) */
+static uint16_t			single_response_request_id = REQUEST_ID_NONE;	/**< The request-id of the pending status-, start-, test-, diagnostics- or set-compression-response (captured when the request is accepted) */
+static uint16_t			data_request_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS];	/**< The request-id of the last data request of each chunk-partition (for its data responses) */
+
+static volatile uint8_t	stream_response_scheduled = 0;			/**< Flag if the stream_response_handler is already scheduled by stream_trigger() */
+static volatile uint8_t	stream_latency_timer_running = 0;		/**< Flag if the stream latency-timer is running */
+static uint8_t			stream_batch_size = 1;					/**< The number of samples of a data-source that trigger a stream response (adapted to the BLE-throughput) */
+APP_TIMER_DEF(stream_latency_timer);							/**< Triggers a stream response, if samples waited STREAM_MAX_LATENCY_MS in the stream-fifos */
+
+static volatile uint8_t	receive_frame_timed_out = 0;			/**< Flag if the receive-frame timer expired for the request frame that is currently received */
+APP_TIMER_DEF(receive_frame_timer);								/**< Closes the connection, if a request frame is not completely received within AWAIT_DATA_TIMEOUT_MS */
+
+/**< The data-sources that could be streamed */
+static const stream_source_t stream_sources[] = {
+	#if ACCELEROMETER_PRESENT
+	{STREAMING_ACCELEROMETER, &accelerometer_stream_fifo, sizeof(AccelerometerStream), PROTOCOL_ACCELEROMETER_STREAM_SIZE},
+	{STREAMING_ACCELEROMETER_INTERRUPT, &accelerometer_interrupt_stream_fifo, sizeof(AccelerometerInterruptStream), PROTOCOL_ACCELEROMETER_INTERRUPT_STREAM_SIZE},
+	#endif
+	{STREAMING_BATTERY, &battery_stream_fifo, sizeof(BatteryStream), PROTOCOL_BATTERY_STREAM_SIZE},
+	{STREAMING_MICROPHONE, &microphone_stream_fifo, sizeof(MicrophoneStream), PROTOCOL_MICROPHONE_STREAM_SIZE},
+	{STREAMING_SCAN, &scan_stream_fifo, sizeof(ScanStream), PROTOCOL_SCAN_STREAM_SIZE},
+};
+
+/**< The sampling-types of the data-sources of the protocol (indexed by PROTOCOL_DATA_SOURCE_*) */
+static const sampling_configuration_t data_source_sampling_types[] = {
+	SAMPLING_MICROPHONE,				// PROTOCOL_DATA_SOURCE_MICROPHONE
+	SAMPLING_SCAN,						// PROTOCOL_DATA_SOURCE_SCAN
+	SAMPLING_ACCELEROMETER,				// PROTOCOL_DATA_SOURCE_ACCELEROMETER
+	SAMPLING_ACCELEROMETER_INTERRUPT,	// PROTOCOL_DATA_SOURCE_ACCELEROMETER_INTERRUPT
+	SAMPLING_BATTERY,					// PROTOCOL_DATA_SOURCE_BATTERY
+};
+
+static uint8_t serialized_buf[REQUEST_HANDLER_SERIALIZED_BUFFER_SIZE];	/**< Buffer for the received requests */
+
+static uint8_t response_buf[REQUEST_HANDLER_RESPONSE_BUFFERS][REQUEST_HANDLER_SERIALIZED_BUFFER_SIZE];	/**< Buffers for the encoded responses (transmitted in place by the sender) */
+static uint8_t response_length_header[REQUEST_HANDLER_RESPONSE_BUFFERS][3];	/**< The length header and the optional request-id of the responses */
+static volatile uint8_t response_buf_in_use[REQUEST_HANDLER_RESPONSE_BUFFERS];		/**< Flags, if the response buffers are currently in transmission */
+static volatile uint8_t response_pending = 0;		/**< Flag, if send_response() waits for a free response buffer (it is scheduled again when a buffer is released) */
+static uint8_t uncompressed_response_buf[REQUEST_HANDLER_SERIALIZED_BUFFER_SIZE];	/**< Buffer for the encoded response before it is compressed into a response buffer */
+static volatile uint8_t response_compression = PROTOCOL_COMPRESSION_NONE;	/**< The negotiated compression of the responses (reset on disconnect) */
 
-/**< Store-messages to represent how the data should be stored (global because needed more than one) */
-static MicrophoneChunk 				microphone_chunk;
-static ScanChunk 					scan_chunk;
-static AccelerometerChunk 			accelerometer_chunk;
-static AccelerometerInterruptChunk 	accelerometer_interrupt_chunk;
-static BatteryChunk 				battery_chunk;
 
 
 
 static void receive_notification_handler(receive_notification_t receive_notification);
+static void disconnect_handler(void);
 static void process_receive_notification(void * p_event_data, uint16_t event_size);
+static void send_response(void * p_event_data, uint16_t event_size);
 
 
 static void status_request_handler(void * p_event_data, uint16_t event_size);
@@ -113,6 +192,12 @@ static void stop_battery_stream_request_handler(void * p_event_data, uint16_t ev
 static void identify_request_handler(void * p_event_data, uint16_t event_size);
 static void test_request_handler(void * p_event_data, uint16_t event_size);
 static void restart_request_handler(void * p_event_data, uint16_t event_size);
+static void diagnostics_request_handler(void * p_event_data, uint16_t event_size);
+static void bulk_export_request_handler(void * p_event_data, uint16_t event_size);
+static void pull_new_data_request_handler(void * p_event_data, uint16_t event_size);
+static void acknowledge_data_request_handler(void * p_event_data, uint16_t event_size);
+static void set_compression_request_handler(void * p_event_data, uint16_t event_size);
+static void set_overflow_policy_request_handler(void * p_event_data, uint16_t event_size);
 
 
 static void status_response_handler(void * p_event_data, uint16_t event_size);
@@ -127,7 +212,17 @@ static void accelerometer_data_response_handler(void * p_event_data, uint16_t ev
 static void accelerometer_interrupt_data_response_handler(void * p_event_data, uint16_t event_size);
 static void battery_data_response_handler(void * p_event_data, uint16_t event_size);
 static void stream_response_handler(void * p_event_data, uint16_t event_size);
+static void stream_trigger(void);
+static void stop_streaming(void);
+static void start_receive_frame(void);
+static void stop_receive_frame(void);
+static void stream_latency_timer_callback(void* p_context);
+static void receive_frame_timer_callback(void* p_context);
 static void test_response_handler(void * p_event_data, uint16_t event_size);
+static void diagnostics_response_handler(void * p_event_data, uint16_t event_size);
+static void bulk_export_response_handler(void * p_event_data, uint16_t event_size);
+static void set_compression_response_handler(void * p_event_data, uint16_t event_size);
+static void set_overflow_policy_response_handler(void * p_event_data, uint16_t event_size);
 
 
 static request_handler_for_type_t request_handlers[] = {
@@ -248,6 +343,30 @@ static request_handler_for_type_t request_handlers[] = {
 		{
                 .type = Request_restart_request_tag,
                 .handler = restart_request_handler,
+        },
+		{
+                .type = Request_diagnostics_request_tag,
+                .handler = diagnostics_request_handler,
+        },
+		{
+                .type = Request_bulk_export_request_tag,
+                .handler = bulk_export_request_handler,
+        },
+		{
+                .type = Request_pull_new_data_request_tag,
+                .handler = pull_new_data_request_handler,
+        },
+		{
+                .type = Request_acknowledge_data_request_tag,
+                .handler = acknowledge_data_request_handler,
+        },
+		{
+                .type = Request_set_compression_request_tag,
+                .handler = set_compression_request_handler,
+        },
+		{
+                .type = Request_set_overflow_policy_request_tag,
+                .handler = set_overflow_policy_request_handler,
         }
 };
 
@@ -258,10 +377,22 @@ ret_code_t request_handler_init(void) {
 	if(ret != NRF_SUCCESS) return ret;
 	
 	sender_set_receive_notification_handler(receive_notification_handler);
+	sender_set_disconnect_handler(disconnect_handler);
+	
+	for(uint8_t i = 0; i < STORER_NUMBER_OF_CHUNK_PARTITIONS; i++)
+		data_request_ids[i] = REQUEST_ID_NONE;
 	
 	ret = app_fifo_init(&receive_notification_fifo, receive_notification_buf, sizeof(receive_notification_buf));
 	if(ret != NRF_SUCCESS) return ret;
 	
+	ret = app_timer_create(&stream_latency_timer, APP_TIMER_MODE_SINGLE_SHOT, stream_latency_timer_callback);
+	if(ret != NRF_SUCCESS) return ret;
+	
+	ret = app_timer_create(&receive_frame_timer, APP_TIMER_MODE_SINGLE_SHOT, receive_frame_timer_callback);
+	if(ret != NRF_SUCCESS) return ret;
+	
+	sampling_set_stream_handler(stream_trigger);
+	
 	return NRF_SUCCESS;
 }
 
@@ -281,8 +412,18 @@ static void receive_notification_handler(receive_notification_t receive_notifica
 	
 	app_fifo_write(&receive_notification_fifo, (uint8_t*) &receive_notification, &notification_size);
 	
-	app_sched_event_put(NULL, 0, process_receive_notification);
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, process_receive_notification);
+
+}
 
+/**@brief Handler that is called by the sender-module, when the connection was closed.
+ *
+ * @details The compression has to be negotiated again by the next hub.
+ */
+static void disconnect_handler(void) {
+	response_compression = PROTOCOL_COMPRESSION_NONE;
+	stop_receive_frame();
+	stop_streaming();
 }
 
 static void finish_receive_notification(void) {
@@ -291,12 +432,12 @@ static void finish_receive_notification(void) {
 
 static void finish_and_reschedule_receive_notification(void) {
 	processing_receive_notification = 0;
-	app_sched_event_put(NULL, 0, process_receive_notification);
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, process_receive_notification);
 }
 
 static ret_code_t start_receive_notification(app_sched_event_handler_t reschedule_handler) {
 	if(processing_receive_notification) {
-		app_sched_event_put(NULL, 0, reschedule_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, reschedule_handler);
 		return NRF_ERROR_BUSY;
 	}
 	processing_receive_notification = 1;
@@ -308,24 +449,31 @@ static void finish_response(void) {
 	processing_response = 0;
 }
 
-static ret_code_t start_response(app_sched_event_handler_t reschedule_handler) {
+static ret_code_t start_response_with_priority(scheduler_priority_t priority, app_sched_event_handler_t reschedule_handler) {
 	if(processing_response) {	// Check if we are allowed to prepare and send our response, if not reschedule the response-handler again
-		app_sched_event_put(NULL, 0, reschedule_handler);
+		scheduler_event_put(priority, reschedule_handler);
 		return NRF_ERROR_BUSY;
 	}
 	processing_response = 1;
 	return NRF_SUCCESS;
 }
 
+static ret_code_t start_response(app_sched_event_handler_t reschedule_handler) {
+	return start_response_with_priority(SCHEDULER_PRIORITY_RX_TX, reschedule_handler);
+}
+
 
 // Called when await data failed, or decoding the notification failed, or request does not exist, or transmitting the response failed (because disconnected or something else)
 static void finish_error(void) {
 	app_fifo_flush(&receive_notification_fifo);
 	debug_log("REQUEST_HANDLER: Error while processing request/response --> Disconnect!!!\n");
+	response_pending = 0;	// The response is dropped, so a released buffer must not schedule it again
 	sender_disconnect();	// To clear the RX- and TX-FIFO
+	stop_receive_frame();
 	finish_receive_notification();
 	finish_response();
-	streaming_started = 0;
+	stop_streaming();
+	bulk_export.active = 0;	// Stops the bulk_export_response_handler-chain
 	storer_invalidate_iterators();
 }
 
@@ -369,6 +517,36 @@ static void receive_notification_fifo_set_receive_notification(receive_notificat
 	}	
 }
 
+/**@brief Function to start receiving a new request frame. It arms the receive_frame_timer. */
+static void start_receive_frame(void) {
+	receive_frame.receiving = 1;
+	receive_frame.header_received = 0;
+	receive_frame_timed_out = 0;
+	app_timer_start(receive_frame_timer, APP_TIMER_TICKS(AWAIT_DATA_TIMEOUT_MS, 0), NULL);
+}
+
+/**@brief Function to stop receiving the current request frame (completely received, disconnected or an error). */
+static void stop_receive_frame(void) {
+	app_timer_stop(receive_frame_timer);
+	receive_frame.receiving = 0;
+	receive_frame_timed_out = 0;
+}
+
+/**@brief Handler that closes the connection, if the request frame is still not completely received after the timeout. */
+static void receive_frame_timeout_handler(void * p_event_data, uint16_t event_size) {
+	// The frame could have been completed (or a new one started) after the timer expired
+	if(!receive_frame.receiving || !receive_frame_timed_out)
+		return;
+	debug_log("REQUEST_HANDLER: Timeout while receiving the request frame\n");
+	finish_error();
+}
+
+/**@brief Callback of the receive-frame timer, that schedules the receive_frame_timeout_handler. */
+static void receive_frame_timer_callback(void* p_context) {
+	receive_frame_timed_out = 1;
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, receive_frame_timeout_handler);
+}
+
 /**
  * This function could handle multiple queued receive notifications.
  * It searches for the length of the packet and then splits the 
@@ -393,37 +571,56 @@ static void process_receive_notification(void * p_event_data, uint16_t event_siz
 		return;
 	}
 	
-	// Get the timestamp and clock-sync status before processing the request!
-	response_timestamp.seconds = receive_notification.timepoint_seconds;
-	response_timestamp.ms = receive_notification.timepoint_milliseconds;
-	response_clock_status = systick_is_synced();
+	if(!receive_frame.receiving)
+		start_receive_frame();
 	
-	uint64_t timepoint_ticks = receive_notification.timepoint_ticks;
+	// Read the length header as soon as it is available. Until the frame is complete, the processing is finished instead of busy-waiting:
+	// The receive_notification_handler schedules it again at the next notification, and the receive_frame_timer closes the connection
+	// if the frame is not complete within AWAIT_DATA_TIMEOUT_MS.
+	if(!receive_frame.header_received) {
+		if(sender_get_received_data_size() < 2) {
+			finish_receive_notification();
+			return;
+		}
+		uint8_t length_header[2];
+		sender_await_data(length_header, 2, 0);
+		uint16_t header = (((uint16_t)length_header[0]) << 8) | ((uint16_t)length_header[1]);
+		receive_frame.has_request_id = (header & LENGTH_HEADER_REQUEST_ID_FLAG) ? 1 : 0;
+		receive_frame.len = header & LENGTH_HEADER_LEN_MASK;
+		receive_frame.header_received = 1;
+		if(receive_frame.len > sizeof(serialized_buf)) {
+			debug_log("REQUEST_HANDLER: Request too long: %u\n", receive_frame.len);
+			finish_error();
+			return;
+		}
+	}
 	
-	// Wait for the length header bytes
-	uint8_t length_header[2];
-	ret = sender_await_data(length_header, 2, AWAIT_DATA_TIMEOUT_MS);
-	if(ret != NRF_SUCCESS) {
-		debug_log("REQUEST_HANDLER: sender_await_data() error for length header\n");
-		app_fifo_flush(&receive_notification_fifo);
-		finish_error();
+	// Now wait (without blocking) for the request-id and the actual data
+	if(sender_get_received_data_size() < (uint32_t) receive_frame.has_request_id + receive_frame.len) {
+		finish_receive_notification();
 		return;
 	}
+	stop_receive_frame();
 	
-	uint16_t len = (((uint16_t)length_header[0]) << 8) | ((uint16_t)length_header[1]);
-	
-	// Now wait for the actual data
-	ret = sender_await_data(serialized_buf, len, AWAIT_DATA_TIMEOUT_MS);
-	if(ret != NRF_SUCCESS) {
-		debug_log("REQUEST_HANDLER: sender_await_data() error\n");
-		app_fifo_flush(&receive_notification_fifo);
-		finish_error();
-		return;
+	uint16_t request_id = REQUEST_ID_NONE;
+	if(receive_frame.has_request_id) {
+		uint8_t request_id_byte;
+		sender_await_data(&request_id_byte, 1, 0);
+		request_id = request_id_byte;
 	}
+	uint16_t len = receive_frame.len;
+	sender_await_data(serialized_buf, len, 0);
+	
+	// Get the timestamp and clock-sync status (of the first notification of the request) before processing the request!
+	response_timestamp.seconds = receive_notification.timepoint_seconds;
+	response_timestamp.ms = receive_notification.timepoint_milliseconds;
+	response_clock_status = systick_is_synced();
+	
+	uint64_t timepoint_ticks = receive_notification.timepoint_ticks;
 	
 	// Here we assume that we got enough receive notifications to receive all the data,
 	// so we need to consume all notifications in the notification-fifo that corresponds to this data
-	uint16_t consume_len = len + 2;	// + 2 for the header
+	uint16_t consume_len = len + 2 + receive_frame.has_request_id;	// + 2 for the header
 	uint32_t consume_index = 0;
 	while(consume_len > 0) {
 		ret = receive_notification_fifo_peek(&receive_notification, consume_index);
@@ -456,7 +653,7 @@ static void process_receive_notification(void * p_event_data, uint16_t event_siz
 	// Now decode the serialized notification
 	memset(&(request_event.request), 0, sizeof(request_event.request));
 	tb_istream_t istream = tb_istream_from_buffer(serialized_buf, len);
-	uint8_t decode_status = tb_decode(&istream, Request_fields, &(request_event.request), TB_BIG_ENDIAN);
+	uint8_t decode_status = Request_decode(&istream, &(request_event.request), TB_BIG_ENDIAN);
 	if(decode_status == 0) {
 		debug_log("REQUEST_HANDLER: Error decoding\n");
 		finish_error();
@@ -469,6 +666,7 @@ static void process_receive_notification(void * p_event_data, uint16_t event_siz
 	}
 	
 	request_event.request_timepoint_ticks = timepoint_ticks;
+	request_event.request_id = request_id;
 
 	
 	debug_log("REQUEST_HANDLER: Which request type: %u, Ticks: %u\n", request_event.request.which_type, request_event.request_timepoint_ticks);
@@ -496,10 +694,42 @@ static void process_receive_notification(void * p_event_data, uint16_t event_siz
 }
 
 
+/**@brief Complete handler of the sender, that releases the response buffer after it was handed to the BLE-stack.
+ *
+ * @details If a response waits for a free buffer, send_response() is scheduled (once) again.
+ *
+ * @param[in]	status		The transmit status (not needed here, the buffer is released in any case).
+ * @param[in]	p_context	The index of the response buffer.
+ */
+static void response_transmit_complete_handler(ret_code_t status, void* p_context) {
+	uint8_t schedule = 0;
+	CRITICAL_REGION_ENTER();
+	response_buf_in_use[(uintptr_t) p_context] = 0;
+	schedule = response_pending;
+	response_pending = 0;
+	CRITICAL_REGION_EXIT();
+	
+	if(schedule)
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, send_response);
+}
+
 static void send_response(void * p_event_data, uint16_t event_size) {
 	// On transmit failure, reschedule itself
 	response_event.response_fail_handler = send_response;
 	
+	// Search for a response buffer that is not in transmission anymore.
+	// If there is none, wait without counting a retry: the complete handler schedules this function again, 
+	// as soon as a buffer was handed to the BLE-stack (or on disconnect).
+	uint32_t buf_index = 0;
+	CRITICAL_REGION_ENTER();
+	while(buf_index < REQUEST_HANDLER_RESPONSE_BUFFERS && response_buf_in_use[buf_index])
+		buf_index++;
+	if(buf_index >= REQUEST_HANDLER_RESPONSE_BUFFERS)
+		response_pending = 1;
+	CRITICAL_REGION_EXIT();
+	if(buf_index >= REQUEST_HANDLER_RESPONSE_BUFFERS)
+		return;
+	
 	// Check if we already had too much retries
 	if(response_event.response_retries > RESPONSE_MAX_TRANSMIT_RETRIES) {
 		finish_error();
@@ -511,9 +741,13 @@ static void send_response(void * p_event_data, uint16_t event_size) {
 	// Encoding has not to be done every time, but to don't have an extra function for that, we just do it here..
 
 
-	tb_ostream_t ostream = tb_ostream_from_buffer(&serialized_buf[2], sizeof(serialized_buf) - 2);
-	uint8_t encode_status = tb_encode(&ostream, Response_fields, &(response_event.response), TB_BIG_ENDIAN);
+	// If the responses are compressed, encode into the uncompressed buffer, and compress from there into the response buffer
+	uint8_t compress = (response_compression == PROTOCOL_COMPRESSION_LZSS);
+	uint8_t* encode_buf = (compress) ? uncompressed_response_buf : response_buf[buf_index];
+	tb_ostream_t ostream = tb_ostream_from_buffer(encode_buf, REQUEST_HANDLER_SERIALIZED_BUFFER_SIZE);
+	uint8_t encode_status = Response_encode(&ostream, &(response_event.response), TB_BIG_ENDIAN);
 	uint32_t len = ostream.bytes_written;
+	uint16_t length_header = (uint16_t) len;
 	
 	
 	
@@ -526,11 +760,39 @@ static void send_response(void * p_event_data, uint16_t event_size) {
 	
 	
 	
+	if(compress) {
+		// Only send the compressed response, if it is smaller than the uncompressed one
+		uint32_t compressed_len = 0;
+		if(compression_compress(uncompressed_response_buf, len, response_buf[buf_index], len - 1, &compressed_len) == NRF_SUCCESS) {
+			len = compressed_len;
+			length_header = ((uint16_t) len) | RESPONSE_LENGTH_HEADER_COMPRESSED_FLAG;
+		} else {
+			memcpy(response_buf[buf_index], uncompressed_response_buf, len);
+		}
+	}
+	
 	ret_code_t ret = NRF_SUCCESS;
 
-	serialized_buf[0] = (uint8_t)((((uint16_t) len) & 0xFF00) >> 8);
-	serialized_buf[1] = (uint8_t)(((uint16_t) len) & 0xFF);
-	ret = sender_transmit(serialized_buf, len+2, TRANSMIT_DATA_TIMEOUT_MS);	
+	uint32_t length_header_len = 2;
+	if(response_event.request_id != REQUEST_ID_NONE) {
+		length_header |= LENGTH_HEADER_REQUEST_ID_FLAG;
+		response_length_header[buf_index][2] = (uint8_t) response_event.request_id;
+		length_header_len = 3;
+	}
+	response_length_header[buf_index][0] = (uint8_t)((length_header & 0xFF00) >> 8);
+	response_length_header[buf_index][1] = (uint8_t)(length_header & 0xFF);
+	
+	// Transmit the length header (with the request-id) and the encoded response in place (without copying them)
+	sender_segment_t segments[2];
+	segments[0].data = response_length_header[buf_index];
+	segments[0].len = length_header_len;
+	segments[1].data = response_buf[buf_index];
+	segments[1].len = len;
+	
+	response_buf_in_use[buf_index] = 1;
+	ret = sender_transmit_segments(segments, 2, response_transmit_complete_handler, (void*) (uintptr_t) buf_index);
+	if(ret != NRF_SUCCESS)
+		response_buf_in_use[buf_index] = 0;
 	
 	debug_log("REQUEST_HANDLER: Transmit status %u!\n", ret);
 	
@@ -538,7 +800,7 @@ static void send_response(void * p_event_data, uint16_t event_size) {
 	if(ret == NRF_SUCCESS) {
 		
 		if(response_event.response_success_handler != NULL) {
-			app_sched_event_put(NULL, 0, response_event.response_success_handler);
+			scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, response_event.response_success_handler);
 		} 
 		
 		finish_response();	// We are now done with this reponse
@@ -546,7 +808,7 @@ static void send_response(void * p_event_data, uint16_t event_size) {
 	} else {
 		if(ret == NRF_ERROR_NO_MEM)	// Only reschedule a fail handler, if we could not transmit because of memory problems
 			if(response_event.response_fail_handler != NULL) {	// This function should actually always be set..
-				app_sched_event_put(NULL, 0, response_event.response_fail_handler);
+				scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, response_event.response_fail_handler);
 				// Here we are not done with the response, so don't call the finish_response()-function
 				return;
 			}
@@ -580,8 +842,10 @@ static void status_response_handler(void * p_event_data, uint16_t event_size) {
 	response_event.response.type.status_response.battery_status = (sampling_get_sampling_configuration() & SAMPLING_BATTERY) ? 1 : 0; 
 	response_event.response.type.status_response.timestamp = response_timestamp;
 	response_event.response.type.status_response.battery_data.voltage = battery_get_voltage();
+	response_event.response.type.status_response.dropped_chunks = sampling_get_dropped_chunks();
 	
 	response_event.response_retries = 0;
+	response_event.request_id = single_response_request_id;
 	response_event.response_success_handler = NULL;
 	
 	finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification. 
@@ -596,6 +860,7 @@ static void start_microphone_response_handler(void * p_event_data, uint16_t even
 	
 	response_event.response.which_type = Response_start_microphone_response_tag;
 	response_event.response_retries = 0;
+	response_event.request_id = single_response_request_id;
 	response_event.response_success_handler = NULL;
 	response_event.response.type.start_microphone_response.timestamp = response_timestamp;
 	
@@ -603,6 +868,144 @@ static void start_microphone_response_handler(void * p_event_data, uint16_t even
 	send_response(NULL, 0);	
 }
 
+static void set_compression_response_handler(void * p_event_data, uint16_t event_size) {
+	if(start_response(set_compression_response_handler) != NRF_SUCCESS)
+		return;
+	
+	response_event.response.which_type = Response_set_compression_response_tag;
+	response_event.response_retries = 0;
+	response_event.request_id = single_response_request_id;
+	response_event.response_success_handler = NULL;
+	
+	response_event.response.type.set_compression_response.compression = response_compression;
+	
+	finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification. 
+	send_response(NULL, 0);	
+}
+
+static void set_overflow_policy_response_handler(void * p_event_data, uint16_t event_size) {
+	if(start_response(set_overflow_policy_response_handler) != NRF_SUCCESS)
+		return;
+	
+	response_event.response.which_type = Response_set_overflow_policy_response_tag;
+	response_event.response_retries = 0;
+	response_event.request_id = single_response_request_id;
+	response_event.response_success_handler = NULL;
+	
+	// The policy the data-source uses from now on (drop-newest if the data-source is not available)
+	sampling_overflow_policy_t overflow_policy = SAMPLING_OVERFLOW_DROP_NEWEST;
+	uint8_t degrade_factor;
+	uint8_t data_source = request_event.request.type.set_overflow_policy_request.data_source;
+	if(data_source < sizeof(data_source_sampling_types)/sizeof(data_source_sampling_types[0]))
+		sampling_get_overflow_policy(data_source_sampling_types[data_source], &overflow_policy, &degrade_factor);
+	response_event.response.type.set_overflow_policy_response.overflow_policy = (uint8_t) overflow_policy;
+	
+	finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification. 
+	send_response(NULL, 0);	
+}
+
+/**@brief Function to put the cursor of the current bulk export into an ExportCursor-message. */
+static void bulk_export_get_cursor(ExportCursor* cursor) {
+	cursor->microphone_record_id = bulk_export.next_record_ids[STORER_CHUNK_PARTITION_MICROPHONE];
+	cursor->scan_record_id = bulk_export.next_record_ids[STORER_CHUNK_PARTITION_SCAN];
+	cursor->accelerometer_record_id = bulk_export.next_record_ids[STORER_CHUNK_PARTITION_ACCELEROMETER];
+	cursor->accelerometer_interrupt_record_id = bulk_export.next_record_ids[STORER_CHUNK_PARTITION_ACCELEROMETER_INTERRUPT];
+	cursor->battery_record_id = bulk_export.next_record_ids[STORER_CHUNK_PARTITION_BATTERY];
+}
+
+/**@brief Function to decode the next record of a partition directly into the corresponding data response (all fields except last_response).
+ *
+ * @retval	See storer_decode_next_chunk().
+ */
+static ret_code_t bulk_export_decode_next_record(storer_chunk_partition_t partition, uint16_t* record_id) {
+	Response* response = &(response_event.response);
+	switch(partition) {
+		case STORER_CHUNK_PARTITION_MICROPHONE:
+			response->which_type = Response_microphone_data_response_tag;
+			response->type.microphone_data_response.last_response = 0;
+			return storer_decode_next_chunk(partition, &MicrophoneDataResponse_fields[1], &(response->type.microphone_data_response), record_id);
+		case STORER_CHUNK_PARTITION_SCAN:
+			response->which_type = Response_scan_data_response_tag;
+			response->type.scan_data_response.last_response = 0;
+			return storer_decode_next_chunk(partition, &ScanDataResponse_fields[1], &(response->type.scan_data_response), record_id);
+		case STORER_CHUNK_PARTITION_ACCELEROMETER:
+			response->which_type = Response_accelerometer_data_response_tag;
+			response->type.accelerometer_data_response.last_response = 0;
+			return storer_decode_next_chunk(partition, &AccelerometerDataResponse_fields[1], &(response->type.accelerometer_data_response), record_id);
+		case STORER_CHUNK_PARTITION_ACCELEROMETER_INTERRUPT:
+			response->which_type = Response_accelerometer_interrupt_data_response_tag;
+			response->type.accelerometer_interrupt_data_response.last_response = 0;
+			return storer_decode_next_chunk(partition, &AccelerometerInterruptDataResponse_fields[1], &(response->type.accelerometer_interrupt_data_response), record_id);
+		case STORER_CHUNK_PARTITION_BATTERY:
+			response->which_type = Response_battery_data_response_tag;
+			response->type.battery_data_response.last_response = 0;
+			return storer_decode_next_chunk(partition, &BatteryDataResponse_fields[1], &(response->type.battery_data_response), record_id);
+		default:
+			return NRF_ERROR_INVALID_PARAM;
+	}
+}
+
+/**@brief Response handler of the bulk export.
+ *
+ * @details	The records of all partitions are sent interleaved (round-robin) as the normal data responses with last_response = 0.
+ *			After every checkpoint_interval records, a BulkExportCheckpointResponse with the current cursor is sent.
+ *			When all partitions are exported, a final BulkExportCheckpointResponse with last_response = 1 is sent.
+ *			So the hub could resume an interrupted export from the last received checkpoint.
+ *			There is only one chain of this handler at a time (see bulk_export.active), that ends after the final checkpoint or in finish_error().
+ */
+static void bulk_export_response_handler(void * p_event_data, uint16_t event_size) {
+	if(!bulk_export.active)	// Cancelled by finish_error()
+		return;
+	if(start_response(bulk_export_response_handler) != NRF_SUCCESS)
+		return;
+	
+	response_event.response_retries = 0;
+	response_event.request_id = bulk_export.request_id;
+	response_event.response_success_handler = bulk_export_response_handler;
+	
+	if(bulk_export.checkpoint_interval > 0 && bulk_export.records_since_checkpoint >= bulk_export.checkpoint_interval) {
+		bulk_export.records_since_checkpoint = 0;
+		response_event.response.which_type = Response_bulk_export_checkpoint_response_tag;
+		response_event.response.type.bulk_export_checkpoint_response.last_response = 0;
+		bulk_export_get_cursor(&(response_event.response.type.bulk_export_checkpoint_response.cursor));
+		send_response(NULL, 0);
+		return;
+	}
+	
+	while(bulk_export.finished_partitions != ((1 << STORER_NUMBER_OF_CHUNK_PARTITIONS) - 1)) {
+		storer_chunk_partition_t partition = (storer_chunk_partition_t) bulk_export.partition;
+		if(bulk_export.finished_partitions & (1 << partition)) {
+			bulk_export.partition = (bulk_export.partition + 1) % STORER_NUMBER_OF_CHUNK_PARTITIONS;
+			continue;
+		}
+		
+		uint16_t record_id;
+		ret_code_t ret = bulk_export_decode_next_record(partition, &record_id);
+		if(ret == NRF_SUCCESS) {
+			bulk_export.partition = (bulk_export.partition + 1) % STORER_NUMBER_OF_CHUNK_PARTITIONS;
+			bulk_export.next_record_ids[partition] = (uint16_t) (record_id + 1);
+			bulk_export.records_since_checkpoint++;
+			send_response(NULL, 0);
+			return;
+		} else if(ret == NRF_ERROR_NOT_FOUND || ret == NRF_ERROR_INVALID_STATE) {
+			bulk_export.finished_partitions |= (1 << partition);
+		} else {
+			// Busy --> try the same partition again
+			finish_response();
+			scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, bulk_export_response_handler);
+			return;
+		}
+	}
+	
+	debug_log("REQUEST_HANDLER: Bulk export done. Sending end checkpoint..\n");
+	response_event.response.which_type = Response_bulk_export_checkpoint_response_tag;
+	response_event.response.type.bulk_export_checkpoint_response.last_response = 1;
+	bulk_export_get_cursor(&(response_event.response.type.bulk_export_checkpoint_response.cursor));
+	response_event.response_success_handler = NULL;
+	bulk_export.active = 0;
+	send_response(NULL, 0);
+}
+
 
 static void start_scan_response_handler(void * p_event_data, uint16_t event_size) {
 	if(start_response(start_scan_response_handler) != NRF_SUCCESS)
@@ -610,6 +1013,7 @@ static void start_scan_response_handler(void * p_event_data, uint16_t event_size
 	
 	response_event.response.which_type = Response_start_scan_response_tag;
 	response_event.response_retries = 0;
+	response_event.request_id = single_response_request_id;
 	response_event.response_success_handler = NULL;
 	response_event.response.type.start_scan_response.timestamp = response_timestamp;
 	
@@ -623,6 +1027,7 @@ static void start_accelerometer_response_handler(void * p_event_data, uint16_t e
 	
 	response_event.response.which_type = Response_start_accelerometer_response_tag;
 	response_event.response_retries = 0;
+	response_event.request_id = single_response_request_id;
 	response_event.response_success_handler = NULL;
 	response_event.response.type.start_accelerometer_response.timestamp = response_timestamp;
 	
@@ -636,6 +1041,7 @@ static void start_accelerometer_interrupt_response_handler(void * p_event_data,
 	
 	response_event.response.which_type = Response_start_accelerometer_interrupt_response_tag;
 	response_event.response_retries = 0;
+	response_event.request_id = single_response_request_id;
 	response_event.response_success_handler = NULL;
 	response_event.response.type.start_accelerometer_interrupt_response.timestamp = response_timestamp;
 	
@@ -650,6 +1056,7 @@ static void start_battery_response_handler(void * p_event_data, uint16_t event_s
 	
 	response_event.response.which_type = Response_start_battery_response_tag;
 	response_event.response_retries = 0;
+	response_event.request_id = single_response_request_id;
 	response_event.response_success_handler = NULL;
 	response_event.response.type.start_battery_response.timestamp = response_timestamp;
 	
@@ -664,19 +1071,16 @@ static void microphone_data_response_handler(void * p_event_data, uint16_t event
 	
 	response_event.response.which_type = Response_microphone_data_response_tag;
 	response_event.response_retries = 0;
+	response_event.request_id = data_request_ids[STORER_CHUNK_PARTITION_MICROPHONE];
 	response_event.response_success_handler = microphone_data_response_handler;
 	
 
-	ret_code_t ret = storer_get_next_microphone_chunk(&microphone_chunk);
+	// Decode the stored chunk directly into the response (all fields except last_response)
+	ret_code_t ret = storer_decode_next_microphone_chunk(&MicrophoneDataResponse_fields[1], &(response_event.response.type.microphone_data_response));
 	if(ret == NRF_SUCCESS) {
 		debug_log("REQUEST_HANDLER: Found microphone data..\n");
 		// Send microphone data
 		response_event.response.type.microphone_data_response.last_response = 0;
-		response_event.response.type.microphone_data_response.timestamp = microphone_chunk.timestamp;
-		response_event.response.type.microphone_data_response.sample_period_ms = microphone_chunk.sample_period_ms;
-		uint32_t microphone_data_count = (microphone_chunk.microphone_data_count > PROTOCOL_MICROPHONE_DATA_SIZE) ? PROTOCOL_MICROPHONE_DATA_SIZE : microphone_chunk.microphone_data_count;
-		response_event.response.type.microphone_data_response.microphone_data_count = microphone_data_count;
-		memcpy(response_event.response.type.microphone_data_response.microphone_data, microphone_chunk.microphone_data, microphone_data_count*sizeof(MicrophoneData));
 		
 		send_response(NULL, 0);	
 	} else if(ret == NRF_ERROR_NOT_FOUND || ret == NRF_ERROR_INVALID_STATE) {
@@ -688,7 +1092,7 @@ static void microphone_data_response_handler(void * p_event_data, uint16_t event
 		response_event.response_success_handler = NULL;
 		send_response(NULL, 0);	
 	} else {
-		app_sched_event_put(NULL, 0, microphone_data_response_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, microphone_data_response_handler);
 	}
 }
 
@@ -699,20 +1103,17 @@ static void scan_data_response_handler(void * p_event_data, uint16_t event_size)
 	
 	response_event.response.which_type = Response_scan_data_response_tag;
 	response_event.response_retries = 0;
+	response_event.request_id = data_request_ids[STORER_CHUNK_PARTITION_SCAN];
 	response_event.response_success_handler = scan_data_response_handler;
 	
 
 	
-	ret_code_t ret = storer_get_next_scan_chunk(&scan_chunk);
+	// Decode the stored chunk directly into the response (all fields except last_response)
+	ret_code_t ret = storer_decode_next_scan_chunk(&ScanDataResponse_fields[1], &(response_event.response.type.scan_data_response));
 	if(ret == NRF_SUCCESS) {
 		debug_log("REQUEST_HANDLER: Found scan data..\n");
 		// Send scan data
 		response_event.response.type.scan_data_response.last_response = 0;
-		response_event.response.type.scan_data_response.timestamp = scan_chunk.timestamp;
-		uint32_t scan_result_data_count = (scan_chunk.scan_result_data_count > PROTOCOL_SCAN_DATA_SIZE) ? PROTOCOL_SCAN_DATA_SIZE : scan_chunk.scan_result_data_count;
-		response_event.response.type.scan_data_response.scan_result_data_count = scan_result_data_count;
-		memcpy(response_event.response.type.scan_data_response.scan_result_data, scan_chunk.scan_result_data, scan_result_data_count*sizeof(ScanResultData));
-		
 		
 		send_response(NULL, 0);	
 	} else if(ret == NRF_ERROR_NOT_FOUND || ret == NRF_ERROR_INVALID_STATE) {
@@ -724,7 +1125,7 @@ static void scan_data_response_handler(void * p_event_data, uint16_t event_size)
 		response_event.response_success_handler = NULL;
 		send_response(NULL, 0);	
 	} else {
-		app_sched_event_put(NULL, 0, scan_data_response_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, scan_data_response_handler);
 	}
 }
 
@@ -735,19 +1136,16 @@ static void accelerometer_data_response_handler(void * p_event_data, uint16_t ev
 	
 	response_event.response.which_type = Response_accelerometer_data_response_tag;
 	response_event.response_retries = 0;
+	response_event.request_id = data_request_ids[STORER_CHUNK_PARTITION_ACCELEROMETER];
 	response_event.response_success_handler = accelerometer_data_response_handler;
 	
 	
-	ret_code_t ret = storer_get_next_accelerometer_chunk(&accelerometer_chunk);
+	// Decode the stored chunk directly into the response (all fields except last_response)
+	ret_code_t ret = storer_decode_next_accelerometer_chunk(&AccelerometerDataResponse_fields[1], &(response_event.response.type.accelerometer_data_response));
 	if(ret == NRF_SUCCESS) {
 		debug_log("REQUEST_HANDLER: Found accelerometer data..\n");
 		// Send accelerometer data
 		response_event.response.type.accelerometer_data_response.last_response = 0;
-		response_event.response.type.accelerometer_data_response.timestamp = accelerometer_chunk.timestamp;
-		uint32_t accelerometer_data_count = (accelerometer_chunk.accelerometer_data_count > PROTOCOL_ACCELEROMETER_DATA_SIZE) ? PROTOCOL_ACCELEROMETER_DATA_SIZE : accelerometer_chunk.accelerometer_data_count;
-		response_event.response.type.accelerometer_data_response.accelerometer_data_count = accelerometer_data_count;
-		memcpy(response_event.response.type.accelerometer_data_response.accelerometer_data, accelerometer_chunk.accelerometer_data, accelerometer_data_count*sizeof(AccelerometerData));
-		
 		
 		send_response(NULL, 0);	
 	} else if(ret == NRF_ERROR_NOT_FOUND || ret == NRF_ERROR_INVALID_STATE) {
@@ -759,7 +1157,7 @@ static void accelerometer_data_response_handler(void * p_event_data, uint16_t ev
 		response_event.response_success_handler = NULL;
 		send_response(NULL, 0);	
 	} else {
-		app_sched_event_put(NULL, 0, accelerometer_data_response_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, accelerometer_data_response_handler);
 	}	
 }
 
@@ -770,15 +1168,16 @@ static void accelerometer_interrupt_data_response_handler(void * p_event_data, u
 	
 	response_event.response.which_type = Response_accelerometer_interrupt_data_response_tag;
 	response_event.response_retries = 0;
+	response_event.request_id = data_request_ids[STORER_CHUNK_PARTITION_ACCELEROMETER_INTERRUPT];
 	response_event.response_success_handler = accelerometer_interrupt_data_response_handler;
 	
 	
-	ret_code_t ret = storer_get_next_accelerometer_interrupt_chunk(&accelerometer_interrupt_chunk);
+	// Decode the stored chunk directly into the response (all fields except last_response)
+	ret_code_t ret = storer_decode_next_accelerometer_interrupt_chunk(&AccelerometerInterruptDataResponse_fields[1], &(response_event.response.type.accelerometer_interrupt_data_response));
 	if(ret == NRF_SUCCESS) {
 		debug_log("REQUEST_HANDLER: Found accelerometer interrupt data..\n");
 		// Send accelerometer interrupt data
 		response_event.response.type.accelerometer_interrupt_data_response.last_response = 0;
-		response_event.response.type.accelerometer_interrupt_data_response.timestamp = accelerometer_interrupt_chunk.timestamp;
 		
 		send_response(NULL, 0);	
 	} else if(ret == NRF_ERROR_NOT_FOUND || ret == NRF_ERROR_INVALID_STATE) {
@@ -789,7 +1188,7 @@ static void accelerometer_interrupt_data_response_handler(void * p_event_data, u
 		response_event.response_success_handler = NULL;
 		send_response(NULL, 0);	
 	} else {
-		app_sched_event_put(NULL, 0, accelerometer_interrupt_data_response_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, accelerometer_interrupt_data_response_handler);
 	}	
 }
 
@@ -800,15 +1199,15 @@ static void battery_data_response_handler(void * p_event_data, uint16_t event_si
 
 	response_event.response.which_type = Response_battery_data_response_tag;
 	response_event.response_retries = 0;
+	response_event.request_id = data_request_ids[STORER_CHUNK_PARTITION_BATTERY];
 	response_event.response_success_handler = battery_data_response_handler;
 	
-	ret_code_t ret = storer_get_next_battery_chunk(&battery_chunk);
+	// Decode the stored chunk directly into the response (all fields except last_response)
+	ret_code_t ret = storer_decode_next_battery_chunk(&BatteryDataResponse_fields[1], &(response_event.response.type.battery_data_response));
 	if(ret == NRF_SUCCESS) {
 		debug_log("REQUEST_HANDLER: Found battery data..\n");
-		// Send accelerometer interrupt data
+		// Send battery data
 		response_event.response.type.battery_data_response.last_response = 0;
-		response_event.response.type.battery_data_response.timestamp = battery_chunk.timestamp;
-		response_event.response.type.battery_data_response.battery_data = battery_chunk.battery_data;
 		
 		send_response(NULL, 0);	
 	} else if(ret == NRF_ERROR_NOT_FOUND || ret == NRF_ERROR_INVALID_STATE) {
@@ -819,17 +1218,132 @@ static void battery_data_response_handler(void * p_event_data, uint16_t event_si
 		response_event.response_success_handler = NULL;
 		send_response(NULL, 0);	
 	} else {
-		app_sched_event_put(NULL, 0, battery_data_response_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, battery_data_response_handler);
 	}	
 }
 
+/**@brief Function to retrieve the fill-level of the stream-fifos of the streamed data-sources.
+ *
+ * @retval	STREAM_FILL_BATCH	If at least one stream-fifo contains stream_batch_size samples (or a full stream response).
+ * @retval	STREAM_FILL_PARTIAL	If at least one stream-fifo contains samples.
+ * @retval	STREAM_FILL_EMPTY	Otherwise.
+ */
+static stream_fill_t get_stream_fill(void) {
+	stream_fill_t fill = STREAM_FILL_EMPTY;
+	sampling_configuration_t sampling_configuration = sampling_get_sampling_configuration();
+	for(uint8_t i = 0; i < sizeof(stream_sources)/sizeof(stream_source_t); i++) {
+		if(!(sampling_configuration & stream_sources[i].streaming))
+			continue;
+		uint32_t n = circular_fifo_get_size(stream_sources[i].stream_fifo) / stream_sources[i].element_size;
+		uint32_t batch_size = (stream_batch_size < stream_sources[i].max_count) ? stream_batch_size : stream_sources[i].max_count;
+		if(n >= batch_size)
+			return STREAM_FILL_BATCH;
+		if(n > 0)
+			fill = STREAM_FILL_PARTIAL;
+	}
+	return fill;
+}
+
+/**@brief Function that schedules the stream_response_handler, if a batch of samples is available in the stream-fifos.
+ *
+ * @details	It is called by the sampling-module after new samples were put into a stream-fifo (could be in interrupt context),
+ *			and by the stream_response_handler after a stream response was sent.
+ *			If there are samples, but not enough for a batch, the latency-timer is started to send them after STREAM_MAX_LATENCY_MS.
+ *			So the streaming only needs CPU-time if there are samples to stream.
+ */
+static void stream_trigger(void) {
+	if(!streaming_started)
+		return;
+	stream_fill_t fill = get_stream_fill();
+	if(fill == STREAM_FILL_EMPTY)
+		return;
+	
+	uint8_t schedule = 0;
+	uint8_t start_timer = 0;
+	CRITICAL_REGION_ENTER();
+	if(!stream_response_scheduled) {
+		if(fill == STREAM_FILL_BATCH) {
+			stream_response_scheduled = 1;
+			schedule = 1;
+		} else if(!stream_latency_timer_running) {
+			stream_latency_timer_running = 1;
+			start_timer = 1;
+		}
+	}
+	CRITICAL_REGION_EXIT();
+	
+	if(schedule && scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, stream_response_handler) != NRF_SUCCESS)
+		stream_response_scheduled = 0;	// Retried with the next samples
+	if(start_timer)
+		app_timer_start(stream_latency_timer, APP_TIMER_TICKS(STREAM_MAX_LATENCY_MS, 0), NULL);
+}
+
+/**@brief Callback of the latency-timer, that schedules the stream_response_handler for the samples that are not a complete batch. */
+static void stream_latency_timer_callback(void* p_context) {
+	uint8_t schedule = 0;
+	CRITICAL_REGION_ENTER();
+	stream_latency_timer_running = 0;
+	if(!stream_response_scheduled) {
+		stream_response_scheduled = 1;
+		schedule = 1;
+	}
+	CRITICAL_REGION_EXIT();
+	
+	if(schedule && scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, stream_response_handler) != NRF_SUCCESS)
+		stream_response_scheduled = 0;	// Retried with the next samples
+}
+
+/**@brief Function to stop the streaming, e.g. on disconnect or an error. The data-sources are stopped by the stream_response_handler. */
+static void stop_streaming(void) {
+	if(streaming_started) {
+		streaming_started = 0;
+		scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, stream_response_handler);
+	}
+}
+
+/**@brief Function that adapts the batch size of the streaming to the BLE-throughput.
+ *
+ * @details	If the former responses are still in transmission, the link is the bottleneck: the batch size is doubled,
+ *			so that fewer and larger stream responses are sent (less header overhead per sample).
+ *			Otherwise it is decreased step by step, to reduce the latency of the streamed samples.
+ */
+static void adapt_stream_batch_size(void) {
+	if(sender_get_transmit_fifo_size() > 0) {
+		stream_batch_size = (stream_batch_size*2 > STREAM_MAX_BATCH_SIZE) ? STREAM_MAX_BATCH_SIZE : stream_batch_size*2;
+	} else if(stream_batch_size > 1) {
+		stream_batch_size--;
+	}
+}
+
 static void stream_response_handler(void * p_event_data, uint16_t event_size) {
-	if(start_response(stream_response_handler) != NRF_SUCCESS)
+	// The stream responses are scheduled at the processing-priority (like by stream_trigger()), so they don't delay the request/response-traffic
+	if(start_response_with_priority(SCHEDULER_PRIORITY_PROCESSING, stream_response_handler) != NRF_SUCCESS)
+		return;
+	
+	CRITICAL_REGION_ENTER();
+	stream_response_scheduled = 0;
+	stream_latency_timer_running = 0;
+	CRITICAL_REGION_EXIT();
+	app_timer_stop(stream_latency_timer);
+	
+	// E.g. when disconnected or any other error occured
+	if(!streaming_started) {
+		// Stop all streamings
+		sampling_stop_accelerometer(1);
+		sampling_stop_accelerometer_interrupt(1);
+		sampling_stop_battery(1);
+		sampling_stop_microphone(1);
+		sampling_stop_scan(1);
+		stream_batch_size = 1;
+		finish_response();
 		return;
+	}
 	
+	adapt_stream_batch_size();
 		
 	response_event.response.which_type = Response_stream_response_tag;
 	response_event.response_retries = 0;
+	response_event.request_id = stream_request_id;
 	response_event.response_success_handler = NULL;
 	
 	response_event.response.type.stream_response.battery_stream_count = 0;
@@ -897,27 +1411,12 @@ static void stream_response_handler(void * p_event_data, uint16_t event_size) {
 		finish_response();
 	}
 	
-	// E.g. when disconnected or any other error occured
-	if(!streaming_started) {
-		// Stop all streamings
-		sampling_stop_accelerometer(1);
-		sampling_stop_accelerometer_interrupt(1);
-		sampling_stop_battery(1);
-		sampling_stop_microphone(1);
-		sampling_stop_scan(1);
-	}
-	
-	// Check if we need to cancel the streaming
-	if((!(sampling_configuration & STREAMING_ACCELEROMETER || sampling_configuration & STREAMING_ACCELEROMETER_INTERRUPT ||
-		sampling_configuration & STREAMING_BATTERY || sampling_configuration & STREAMING_MICROPHONE || sampling_configuration & STREAMING_SCAN)) || !streaming_started) {
-			streaming_started = 0;
+	// Check if we need to cancel the streaming, otherwise wait for the next batch (or the latency-timer)
+	if(!(sampling_configuration & STREAMING_ACCELEROMETER || sampling_configuration & STREAMING_ACCELEROMETER_INTERRUPT ||
+		sampling_configuration & STREAMING_BATTERY || sampling_configuration & STREAMING_MICROPHONE || sampling_configuration & STREAMING_SCAN)) {
+		streaming_started = 0;
 	} else {
-		// Put itself manually on the scheduler again --> if not ready with sending the response start_response() will reschedule
-		// It is done this way (not with the response_event.response_success_handler) because if sth wents wrong during sending
-		// this function won't be called anymore to disable the streaming for all peripherals.
-		// Another reason is that we probably don't want to send everytime this stream_response_handler is called
-		// because we don't have anything to send (all counts = 0)
-		app_sched_event_put(NULL, 0, stream_response_handler);
+		stream_trigger();
 	}	
 }
 
@@ -929,12 +1428,51 @@ static void test_response_handler(void * p_event_data, uint16_t event_size) {
 	
 	response_event.response.which_type = Response_test_response_tag;
 	response_event.response_retries = 0;
+	response_event.request_id = single_response_request_id;
 	response_event.response_success_handler = NULL;
 	
 	selftest_status_t status = selftest_test();
 	
 	response_event.response.type.test_response.test_failed = (uint8_t) status;
 	
+	finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification. 
+	send_response(NULL, 0);	
+}
+
+/**@brief Function to fill the ChunkFifoStatus of a data-source.
+ *
+ * @param[in]	sampling_type		The data-source.
+ * @param[out]	chunk_fifo_status	Pointer to the ChunkFifoStatus that should be filled.
+ */
+static void fill_chunk_fifo_status(sampling_configuration_t sampling_type, ChunkFifoStatus* chunk_fifo_status) {
+	chunk_fifo_statistics_t statistics;
+	sampling_get_chunk_fifo_statistics(sampling_type, &statistics);
+	chunk_fifo_status->dropped_chunks = statistics.dropped_chunks;
+	chunk_fifo_status->high_water_mark = statistics.high_water_mark;
+	chunk_fifo_status->capacity = statistics.chunk_num;
+}
+
+static void diagnostics_response_handler(void * p_event_data, uint16_t event_size) {
+	if(start_response(diagnostics_response_handler) != NRF_SUCCESS)
+		return;
+	
+	response_event.response.which_type = Response_diagnostics_response_tag;
+	response_event.response_retries = 0;
+	response_event.request_id = single_response_request_id;
+	response_event.response_success_handler = NULL;
+	
+	fill_chunk_fifo_status(SAMPLING_MICROPHONE, &(response_event.response.type.diagnostics_response.microphone_chunk_fifo_status));
+	fill_chunk_fifo_status(SAMPLING_SCAN, &(response_event.response.type.diagnostics_response.scan_chunk_fifo_status));
+	fill_chunk_fifo_status(SAMPLING_ACCELEROMETER, &(response_event.response.type.diagnostics_response.accelerometer_chunk_fifo_status));
+	fill_chunk_fifo_status(SAMPLING_ACCELEROMETER_INTERRUPT, &(response_event.response.type.diagnostics_response.accelerometer_interrupt_chunk_fifo_status));
+	fill_chunk_fifo_status(SAMPLING_BATTERY, &(response_event.response.type.diagnostics_response.battery_chunk_fifo_status));
+	
+	// Reset the statistics after they have been put into the response
+	if(request_event.request.type.diagnostics_request.reset_chunk_fifo_status) {
+		sampling_reset_chunk_fifo_statistics();
+	}
+	
+	finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification. 
 	send_response(NULL, 0);	
 }
 
@@ -987,7 +1525,7 @@ static void status_request_handler(void * p_event_data, uint16_t event_size) {
 		
 		ret_code_t ret = advertiser_set_badge_assignement(badge_assignement);
 		if(ret == NRF_ERROR_INTERNAL) {
-			app_sched_event_put(NULL, 0, status_request_handler);
+			scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, status_request_handler);
 			return;
 		} else if(ret != NRF_SUCCESS) {
 			finish_error();
@@ -996,7 +1534,8 @@ static void status_request_handler(void * p_event_data, uint16_t event_size) {
 		// ret should be NRF_SUCCESS here
 	}
 	
-	app_sched_event_put(NULL, 0, status_response_handler);
+	single_response_request_id = request_event.request_id;
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, status_response_handler);
 	// Don't finish it here, but in the response-handler (because of the response_timestamp and response_clock_status)
 	//finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification. 
 }
@@ -1017,12 +1556,13 @@ static void start_microphone_request_handler(void * p_event_data, uint16_t event
 	debug_log("REQUEST_HANDLER: Ret sampling_start_microphone: %d\n\r", ret);
 	
 	if(ret == NRF_SUCCESS) {
-		app_sched_event_put(NULL, 0, start_microphone_response_handler);
+		single_response_request_id = request_event.request_id;
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_microphone_response_handler);
 		// Don't finish it here, but in the response-handler (because of the response_timestamp and response_clock_status)
 		//finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification. 
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, start_microphone_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_microphone_request_handler);
 	}
 }
 
@@ -1059,12 +1599,13 @@ static void start_scan_request_handler(void * p_event_data, uint16_t event_size)
 	
 	
 	if(ret == NRF_SUCCESS) {
-		app_sched_event_put(NULL, 0, start_scan_response_handler);
+		single_response_request_id = request_event.request_id;
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_scan_response_handler);
 		// Don't finish it here, but in the response-handler (because of the response_timestamp and response_clock_status)
 		//finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification. 
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, start_scan_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_scan_request_handler);
 	}
 }
 
@@ -1092,12 +1633,13 @@ static void start_accelerometer_request_handler(void * p_event_data, uint16_t ev
 	debug_log("REQUEST_HANDLER: Ret sampling_start_accelerometer: %d\n\r", ret);
 	
 	if(ret == NRF_SUCCESS) {
-		app_sched_event_put(NULL, 0, start_accelerometer_response_handler);
+		single_response_request_id = request_event.request_id;
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_accelerometer_response_handler);
 		// Don't finish it here, but in the response-handler (because of the response_timestamp and response_clock_status)
 		//finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification. 
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, start_accelerometer_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_accelerometer_request_handler);
 	}
 }
 
@@ -1125,12 +1667,13 @@ static void start_accelerometer_interrupt_request_handler(void * p_event_data, u
 	debug_log("REQUEST_HANDLER: Ret sampling_start_accelerometer_interrupt: %d\n\r", ret);
 	
 	if(ret == NRF_SUCCESS) {
-		app_sched_event_put(NULL, 0, start_accelerometer_interrupt_response_handler);
+		single_response_request_id = request_event.request_id;
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_accelerometer_interrupt_response_handler);
 		// Don't finish it here, but in the response-handler (because of the response_timestamp and response_clock_status)
 		//finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification. 
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, start_accelerometer_interrupt_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_accelerometer_interrupt_request_handler);
 	}
 }
 
@@ -1155,12 +1698,13 @@ static void start_battery_request_handler(void * p_event_data, uint16_t event_si
 	debug_log("REQUEST_HANDLER: Ret sampling_start_battery: %d\n\r", ret);
 	
 	if(ret == NRF_SUCCESS) {
-		app_sched_event_put(NULL, 0, start_battery_response_handler);
+		single_response_request_id = request_event.request_id;
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_battery_response_handler);
 		// Don't finish it here, but in the response-handler (because of the response_timestamp and response_clock_status)
 		//finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification. 
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, start_battery_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_battery_request_handler);
 	}
 }
 static void stop_battery_request_handler(void * p_event_data, uint16_t event_size) {
@@ -1173,13 +1717,14 @@ static void microphone_data_request_handler(void * p_event_data, uint16_t event_
 	Timestamp timestamp = request_event.request.type.microphone_data_request.timestamp;
 	debug_log("REQUEST_HANDLER: Pull microphone data since: %u s, %u ms\n", timestamp.seconds, timestamp.ms);
 	
-	ret_code_t ret = storer_find_microphone_chunk_from_timestamp(timestamp, &microphone_chunk);
+	ret_code_t ret = storer_find_microphone_chunk_from_timestamp(timestamp);
 	if(ret == NRF_SUCCESS || ret == NRF_ERROR_INVALID_STATE) {
-		app_sched_event_put(NULL, 0, microphone_data_response_handler);
+		data_request_ids[STORER_CHUNK_PARTITION_MICROPHONE] = request_event.request_id;
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, microphone_data_response_handler);
 		finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, microphone_data_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, microphone_data_request_handler);
 	}
 }
 
@@ -1188,13 +1733,14 @@ static void scan_data_request_handler(void * p_event_data, uint16_t event_size)
 	Timestamp timestamp =  request_event.request.type.scan_data_request.timestamp;	
 	debug_log("REQUEST_HANDLER: Pull scan data since: %u s, %u ms\n", timestamp.seconds, timestamp.ms);
 	
-	ret_code_t ret = storer_find_scan_chunk_from_timestamp(timestamp, &scan_chunk);
+	ret_code_t ret = storer_find_scan_chunk_from_timestamp(timestamp);
 	if(ret == NRF_SUCCESS || ret == NRF_ERROR_INVALID_STATE) {
-		app_sched_event_put(NULL, 0, scan_data_response_handler);
+		data_request_ids[STORER_CHUNK_PARTITION_SCAN] = request_event.request_id;
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, scan_data_response_handler);
 		finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, scan_data_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, scan_data_request_handler);
 	}	
 }
 
@@ -1204,13 +1750,14 @@ static void accelerometer_data_request_handler(void * p_event_data, uint16_t eve
 	Timestamp timestamp =  request_event.request.type.accelerometer_data_request.timestamp;	
 	debug_log("REQUEST_HANDLER: Pull accelerometer data since: %u s, %u ms\n", timestamp.seconds, timestamp.ms);
 	
-	ret_code_t ret = storer_find_accelerometer_chunk_from_timestamp(timestamp, &accelerometer_chunk);
+	ret_code_t ret = storer_find_accelerometer_chunk_from_timestamp(timestamp);
 	if(ret == NRF_SUCCESS || ret == NRF_ERROR_INVALID_STATE) {
-		app_sched_event_put(NULL, 0, accelerometer_data_response_handler);
+		data_request_ids[STORER_CHUNK_PARTITION_ACCELEROMETER] = request_event.request_id;
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, accelerometer_data_response_handler);
 		finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, accelerometer_data_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, accelerometer_data_request_handler);
 	}	
 }
 
@@ -1220,13 +1767,14 @@ static void accelerometer_interrupt_data_request_handler(void * p_event_data, ui
 	Timestamp timestamp =  request_event.request.type.accelerometer_interrupt_data_request.timestamp;	
 	debug_log("REQUEST_HANDLER: Pull accelerometer interrupt data since: %u s, %u ms\n", timestamp.seconds, timestamp.ms);
 	
-	ret_code_t ret = storer_find_accelerometer_interrupt_chunk_from_timestamp(timestamp, &accelerometer_interrupt_chunk);
+	ret_code_t ret = storer_find_accelerometer_interrupt_chunk_from_timestamp(timestamp);
 	if(ret == NRF_SUCCESS || ret == NRF_ERROR_INVALID_STATE) {
-		app_sched_event_put(NULL, 0, accelerometer_interrupt_data_response_handler);
+		data_request_ids[STORER_CHUNK_PARTITION_ACCELEROMETER_INTERRUPT] = request_event.request_id;
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, accelerometer_interrupt_data_response_handler);
 		finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, accelerometer_interrupt_data_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, accelerometer_interrupt_data_request_handler);
 	}	
 }
 
@@ -1235,13 +1783,14 @@ static void battery_data_request_handler(void * p_event_data, uint16_t event_siz
 	Timestamp timestamp =  request_event.request.type.battery_data_request.timestamp;	
 	debug_log("REQUEST_HANDLER: Pull battery data since: %u s, %u ms\n", timestamp.seconds, timestamp.ms);
 	
-	ret_code_t ret = storer_find_battery_chunk_from_timestamp(timestamp, &battery_chunk);
+	ret_code_t ret = storer_find_battery_chunk_from_timestamp(timestamp);
 	if(ret == NRF_SUCCESS || ret == NRF_ERROR_INVALID_STATE) {
-		app_sched_event_put(NULL, 0, battery_data_response_handler);
+		data_request_ids[STORER_CHUNK_PARTITION_BATTERY] = request_event.request_id;
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, battery_data_response_handler);
 		finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, battery_data_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, battery_data_request_handler);
 	}	
 }
 
@@ -1260,14 +1809,15 @@ static void start_microphone_stream_request_handler(void * p_event_data, uint16_
 	debug_log("REQUEST_HANDLER: Ret sampling_start_microphone stream: %d\n\r", ret);
 	
 	if(ret == NRF_SUCCESS) {
+		stream_request_id = request_event.request_id;
 		if(!streaming_started) 	{	
 			streaming_started = 1;
-			app_sched_event_put(NULL, 0, stream_response_handler);
+			scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, stream_response_handler);
 		}
 		finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, start_microphone_stream_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_microphone_stream_request_handler);
 	}	
 }
 
@@ -1302,14 +1852,15 @@ static void start_scan_stream_request_handler(void * p_event_data, uint16_t even
 	
 	
 	if(ret == NRF_SUCCESS) {
+		stream_request_id = request_event.request_id;
 		if(!streaming_started) 	{	
 			streaming_started = 1;
-			app_sched_event_put(NULL, 0, stream_response_handler);
+			scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, stream_response_handler);
 		}
 		finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, start_scan_stream_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_scan_stream_request_handler);
 	}
 }
 
@@ -1341,14 +1892,15 @@ static void start_accelerometer_stream_request_handler(void * p_event_data, uint
 	debug_log("REQUEST_HANDLER: Ret sampling_start_accelerometer stream: %d\n\r", ret);
 	
 	if(ret == NRF_SUCCESS) {
+		stream_request_id = request_event.request_id;
 		if(!streaming_started) 	{	
 			streaming_started = 1;
-			app_sched_event_put(NULL, 0, stream_response_handler);
+			scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, stream_response_handler);
 		}
 		finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, start_accelerometer_stream_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_accelerometer_stream_request_handler);
 	}
 }
 static void stop_accelerometer_stream_request_handler(void * p_event_data, uint16_t event_size) {
@@ -1377,14 +1929,15 @@ static void start_accelerometer_interrupt_stream_request_handler(void * p_event_
 	debug_log("REQUEST_HANDLER: Ret sampling_start_accelerometer_interrupt stream: %d\n\r", ret);
 	
 	if(ret == NRF_SUCCESS) {
+		stream_request_id = request_event.request_id;
 		if(!streaming_started) 	{	
 			streaming_started = 1;
-			app_sched_event_put(NULL, 0, stream_response_handler);
+			scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, stream_response_handler);
 		}
 		finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, start_accelerometer_interrupt_stream_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_accelerometer_interrupt_stream_request_handler);
 	}
 }
 static void stop_accelerometer_interrupt_stream_request_handler(void * p_event_data, uint16_t event_size) {
@@ -1412,14 +1965,15 @@ static void start_battery_stream_request_handler(void * p_event_data, uint16_t e
 	debug_log("REQUEST_HANDLER: Ret sampling_start_battery stream: %d\n\r", ret);
 	
 	if(ret == NRF_SUCCESS) {
+		stream_request_id = request_event.request_id;
 		if(!streaming_started) 	{	
 			streaming_started = 1;
-			app_sched_event_put(NULL, 0, stream_response_handler);
+			scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, stream_response_handler);
 		}
 		finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
 	} else {
 		// TODO: Error counter for rescheduling 
-		app_sched_event_put(NULL, 0, start_battery_stream_request_handler);
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, start_battery_stream_request_handler);
 	}
 }
 static void stop_battery_stream_request_handler(void * p_event_data, uint16_t event_size) {
@@ -1444,7 +1998,156 @@ static void identify_request_handler(void * p_event_data, uint16_t event_size) {
 static void test_request_handler(void * p_event_data, uint16_t event_size) {
 	debug_log("REQUEST_HANDLER: Test request handler\n");
 	
-	app_sched_event_put(NULL, 0, test_response_handler);
+	single_response_request_id = request_event.request_id;
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, test_response_handler);
+	// Don't finish it here, but in the response-handler (because of the single_response_request_id)
+	//finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
+}
+
+static void set_compression_request_handler(void * p_event_data, uint16_t event_size) {
+	uint8_t compression = request_event.request.type.set_compression_request.compression;
+	debug_log("REQUEST_HANDLER: Set compression request handler: %u\n", compression);
+	
+	// Unknown compressions are not supported --> the response tells the hub that the responses are not compressed
+	response_compression = (compression == PROTOCOL_COMPRESSION_LZSS) ? PROTOCOL_COMPRESSION_LZSS : PROTOCOL_COMPRESSION_NONE;
+	
+	single_response_request_id = request_event.request_id;
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, set_compression_response_handler);
+	// Don't finish it here, but in the response-handler (because of the single_response_request_id)
+	//finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
+}
+
+static void set_overflow_policy_request_handler(void * p_event_data, uint16_t event_size) {
+	uint8_t data_source = request_event.request.type.set_overflow_policy_request.data_source;
+	uint8_t overflow_policy = request_event.request.type.set_overflow_policy_request.overflow_policy;
+	debug_log("REQUEST_HANDLER: Set overflow policy request handler: %u, %u\n", data_source, overflow_policy);
+	
+	// Unsupported data-sources or policies are ignored --> the response tells the hub the policy that is still used
+	if(data_source < sizeof(data_source_sampling_types)/sizeof(data_source_sampling_types[0]) && overflow_policy <= PROTOCOL_OVERFLOW_POLICY_DEGRADE_RATE) {
+		ret_code_t ret = sampling_set_overflow_policy(data_source_sampling_types[data_source], (sampling_overflow_policy_t) overflow_policy);
+		debug_log("REQUEST_HANDLER: Ret sampling_set_overflow_policy: %d\n", ret);
+		(void) ret;
+	}
+	
+	single_response_request_id = request_event.request_id;
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, set_overflow_policy_response_handler);
+	// Don't finish it here, but in the response-handler (because of the single_response_request_id and the data-source of the request)
+	//finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
+}
+
+static void diagnostics_request_handler(void * p_event_data, uint16_t event_size) {
+	debug_log("REQUEST_HANDLER: Diagnostics request handler\n");
+	
+	single_response_request_id = request_event.request_id;
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, diagnostics_response_handler);
+	// Don't finish it here, but in the response-handler (because of the single_response_request_id and the reset flag of the request)
+	//finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
+}
+
+/**@brief Function to convert an ExportCursor into the record-ids of the chunk-partitions (storer_chunk_partition_t). */
+static void export_cursor_to_record_ids(const ExportCursor* cursor, uint16_t record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS]) {
+	record_ids[STORER_CHUNK_PARTITION_MICROPHONE] = cursor->microphone_record_id;
+	record_ids[STORER_CHUNK_PARTITION_SCAN] = cursor->scan_record_id;
+	record_ids[STORER_CHUNK_PARTITION_ACCELEROMETER] = cursor->accelerometer_record_id;
+	record_ids[STORER_CHUNK_PARTITION_ACCELEROMETER_INTERRUPT] = cursor->accelerometer_interrupt_record_id;
+	record_ids[STORER_CHUNK_PARTITION_BATTERY] = cursor->battery_record_id;
+}
+
+/**@brief Function to initialize the bulk export state and to schedule the bulk_export_response_handler.
+ *
+ * @details	If a bulk export is already running, it is cancelled: its handler-chain continues with the new state
+ *			(and the request-id of the new request), so that there are never two chains exporting at the same time.
+ *
+ * @param[in]	record_ids				The record-ids to start from for each chunk-partition, or NULL to start from the oldest chunks.
+ * @param[in]	checkpoint_interval		The number of records between two checkpoint-responses.
+ *
+ * @retval	NRF_SUCCESS		If the bulk export was started.
+ * @retval	Otherwise		If a partition could not be searched (e.g. busy).
+ */
+static ret_code_t bulk_export_start(const uint16_t* record_ids, uint16_t checkpoint_interval) {
+	// Search all partitions first, so that a running export is not changed if a partition is busy
+	uint8_t finished_partitions = 0;
+	uint16_t next_record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS];
+	for(uint8_t i = 0; i < STORER_NUMBER_OF_CHUNK_PARTITIONS; i++) {
+		ret_code_t ret;
+		uint16_t record_id = 0;
+		if(record_ids != NULL) {
+			record_id = record_ids[i];
+			ret = storer_find_chunk_from_record_id((storer_chunk_partition_t) i, &record_id);
+		} else {
+			ret = storer_find_oldest_chunk((storer_chunk_partition_t) i, &record_id);
+		}
+		
+		if(ret == NRF_ERROR_INVALID_STATE) {	// No data in the partition
+			finished_partitions |= (1 << i);
+		} else if(ret != NRF_SUCCESS) {
+			return ret;
+		}
+		next_record_ids[i] = record_id;
+	}
+	bulk_export.finished_partitions = finished_partitions;
+	memcpy(bulk_export.next_record_ids, next_record_ids, sizeof(next_record_ids));
+	bulk_export.checkpoint_interval = checkpoint_interval;
+	bulk_export.request_id = request_event.request_id;
+	bulk_export.records_since_checkpoint = 0;
+	bulk_export.partition = 0;
+	
+	if(bulk_export.active) {
+		debug_log("REQUEST_HANDLER: Restart the running bulk export\n");
+		return NRF_SUCCESS;
+	}
+	bulk_export.active = 1;
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, bulk_export_response_handler);
+	return NRF_SUCCESS;
+}
+
+static void bulk_export_request_handler(void * p_event_data, uint16_t event_size) {
+	BulkExportRequest* bulk_export_request = &(request_event.request.type.bulk_export_request);
+	debug_log("REQUEST_HANDLER: Bulk export request handler, has cursor: %u\n", bulk_export_request->has_cursor);
+	
+	uint16_t record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS];
+	if(bulk_export_request->has_cursor)
+		export_cursor_to_record_ids(&(bulk_export_request->cursor), record_ids);
+	
+	ret_code_t ret = bulk_export_start((bulk_export_request->has_cursor) ? record_ids : NULL, bulk_export_request->checkpoint_interval);
+	if(ret != NRF_SUCCESS) {
+		// TODO: Error counter for rescheduling 
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, bulk_export_request_handler);
+		return;
+	}
+	finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
+}
+
+static void pull_new_data_request_handler(void * p_event_data, uint16_t event_size) {
+	PullNewDataRequest* pull_new_data_request = &(request_event.request.type.pull_new_data_request);
+	
+	// Start directly at the download cursor of the hub, or at the oldest chunks if the hub is unknown
+	uint16_t record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS];
+	uint8_t has_cursor = (storer_get_download_cursor(pull_new_data_request->hub_id, record_ids) == NRF_SUCCESS);
+	debug_log("REQUEST_HANDLER: Pull new data request handler, hub: %u, has cursor: %u\n", pull_new_data_request->hub_id, has_cursor);
+	
+	ret_code_t ret = bulk_export_start((has_cursor) ? record_ids : NULL, pull_new_data_request->checkpoint_interval);
+	if(ret != NRF_SUCCESS) {
+		// TODO: Error counter for rescheduling 
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, pull_new_data_request_handler);
+		return;
+	}
+	finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
+}
+
+static void acknowledge_data_request_handler(void * p_event_data, uint16_t event_size) {
+	AcknowledgeDataRequest* acknowledge_data_request = &(request_event.request.type.acknowledge_data_request);
+	debug_log("REQUEST_HANDLER: Acknowledge data request handler, hub: %u\n", acknowledge_data_request->hub_id);
+	
+	uint16_t record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS];
+	export_cursor_to_record_ids(&(acknowledge_data_request->cursor), record_ids);
+	
+	ret_code_t ret = storer_store_download_cursor(acknowledge_data_request->hub_id, record_ids);
+	if(ret == NRF_ERROR_INTERNAL) {	// Busy
+		// TODO: Error counter for rescheduling 
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, acknowledge_data_request_handler);
+		return;
+	}
 	finish_and_reschedule_receive_notification();	// Now we are done with processing the request --> we can now advance to the next receive-notification
 }
 
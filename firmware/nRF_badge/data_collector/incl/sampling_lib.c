@@ -1,5 +1,5 @@
 #include "sampling_lib.h"
-#include "app_scheduler.h"
+#include "scheduler_lib.h"
 #include "app_timer.h"
 #include "chunk_messages.h"
 #include "stream_messages.h"
@@ -13,6 +13,8 @@
 #include "advertiser_lib.h"
 
 #include "systick_lib.h"
+#include "trace_lib.h"
+#include "string.h"	// For memset-function
 
 // TODO: remove
 #include "debug_lib.h"
@@ -40,6 +42,15 @@
 
 static sampling_configuration_t sampling_configuration;
 
+/**< Structure to handle the overflow of the chunk-fifo of a data-source (see sampling_set_overflow_policy()) */
+typedef struct {
+	sampling_overflow_policy_t	overflow_policy;
+	uint8_t						degrade_factor;		/**< Only every degrade_factor-th sample is recorded in the chunks */
+	uint8_t						degrade_counter;	/**< Counts the samples since the last recorded sample */
+} sampling_overflow_t;
+
+static volatile sampling_stream_handler_t stream_handler = NULL;	/**< The handler that is called after new samples were put into a stream-fifo */
+
 
 
 
@@ -58,6 +69,7 @@ typedef struct {
 static sampling_accelerometer_parameters_t sampling_accelerometer_parameters;
 static uint32_t accelerometer_timeout_id;
 static uint32_t accelerometer_stream_timeout_id;
+static sampling_overflow_t accelerometer_overflow;
 
 chunk_fifo_t 	accelerometer_interrupt_chunk_fifo;
 circular_fifo_t accelerometer_interrupt_stream_fifo;
@@ -65,6 +77,7 @@ static AccelerometerInterruptChunk*	accelerometer_interrupt_chunk = NULL;
 static uint32_t	accelerometer_interrupt_ignore_duration_ms = 0;
 static uint32_t accelerometer_interrupt_timeout_id;
 static uint32_t accelerometer_interrupt_stream_timeout_id;
+static sampling_overflow_t accelerometer_interrupt_overflow;
 #endif
 
 chunk_fifo_t 	battery_chunk_fifo;
@@ -78,6 +91,7 @@ typedef struct {
 static sampling_battery_parameters_t sampling_battery_parameters;
 static uint32_t battery_timeout_id;
 static uint32_t battery_stream_timeout_id;
+static sampling_overflow_t battery_overflow;
 
 chunk_fifo_t 	microphone_chunk_fifo;
 circular_fifo_t microphone_stream_fifo;
@@ -93,6 +107,7 @@ static uint32_t microphone_aggregated = 0;
 static uint32_t microphone_aggregated_count = 0;
 static uint32_t microphone_timeout_id;
 static uint32_t microphone_stream_timeout_id;
+static sampling_overflow_t microphone_overflow;
 
 chunk_fifo_t 	scan_sampling_chunk_fifo;
 circular_fifo_t scan_stream_fifo;
@@ -119,6 +134,8 @@ static uint8_t	scan_aggregation_type = SCAN_CHUNK_AGGREGATE_TYPE_MAX;
 static int32_t  scan_aggregated_rssi[SCAN_SAMPLING_CHUNK_DATA_SIZE];		/**< Temporary array to aggregate the rssi-data */
 static uint32_t scan_timeout_id;
 static uint32_t scan_stream_timeout_id;
+static sampling_overflow_t scan_overflow;
+static uint8_t scan_sampling_chunk_recording = 0;		/**< Flag if the current scan-cycle is recorded in a scan sampling chunk */
 /**< The scan:period is directly setted by starting the timer */
 
 
@@ -163,6 +180,64 @@ void sampling_timeout_scan(void);
 void sampling_timeout_scan_stream(void);
 
 
+/**@brief Function to initialize the overflow-handling structure of a data-source.
+ *
+ * @param[in]	overflow	Pointer to the overflow-handling structure of the data-source.
+ */
+static void overflow_init(sampling_overflow_t* overflow) {
+	overflow->overflow_policy = SAMPLING_OVERFLOW_DROP_NEWEST;
+	overflow->degrade_factor = 1;
+	overflow->degrade_counter = 0;
+}
+
+/**@brief Function that checks if a sample should not be recorded in the chunk, because the sampling rate is degraded.
+ *
+ * @param[in]	overflow	Pointer to the overflow-handling structure of the data-source.
+ *
+ * @retval	0	If the sample should be recorded.
+ * @retval	1	If the sample should be skipped.
+ */
+static uint8_t overflow_skip_sample(sampling_overflow_t* overflow) {
+	uint8_t skip = (overflow->degrade_counter != 0);
+	overflow->degrade_counter = (overflow->degrade_counter + 1) % overflow->degrade_factor;
+	return skip;
+}
+
+/**@brief Function that adapts the degrade factor of a data-source after a chunk was closed in its chunk-fifo.
+ *
+ * @details	If the chunk-fifo was full the degrade factor is doubled. If the chunk-fifo has drained (only the closed chunk is left) the degrade factor is halved.
+ *			The degrade factor is only changed between two chunks, so all the samples of a chunk have the same period.
+ *
+ * @param[in]	overflow	Pointer to the overflow-handling structure of the data-source.
+ * @param[in]	chunk_fifo	Pointer to the chunk-fifo of the data-source.
+ * @param[in]	close_ret	The return value of chunk_fifo_write_close().
+ */
+static void overflow_on_chunk_closed(sampling_overflow_t* overflow, chunk_fifo_t* chunk_fifo, ret_code_t close_ret) {
+	overflow->degrade_counter = 0;
+	if(overflow->overflow_policy != SAMPLING_OVERFLOW_DEGRADE_RATE) {
+		overflow->degrade_factor = 1;
+		return;
+	}
+	if(close_ret == NRF_ERROR_NO_MEM) {
+		if(overflow->degrade_factor < SAMPLING_OVERFLOW_MAX_DEGRADE_FACTOR) {
+			overflow->degrade_factor *= 2;
+			debug_log("SAMPLING: Chunk-fifo full --> degrade sampling rate by %u\n", overflow->degrade_factor);
+		}
+	} else if(overflow->degrade_factor > 1 && chunk_fifo_get_number_of_chunks(chunk_fifo) <= 1) {
+		overflow->degrade_factor /= 2;
+		debug_log("SAMPLING: Chunk-fifo drained --> degrade sampling rate by %u\n", overflow->degrade_factor);
+	}
+}
+
+
+/**@brief Function to notify the stream handler (if set), that new samples were put into a stream-fifo. */
+static void notify_stream_handler(void) {
+	sampling_stream_handler_t handler = stream_handler;
+	if(handler != NULL)
+		handler();
+}
+
+
 ret_code_t sampling_init(void) {
 	ret_code_t ret = NRF_SUCCESS;
 	(void) ret;
@@ -199,6 +274,8 @@ ret_code_t sampling_init(void) {
 	ret = timeout_register(&accelerometer_stream_timeout_id, sampling_timeout_accelerometer_stream);
 	if(ret != NRF_SUCCESS) return ret;
 	
+	overflow_init(&accelerometer_overflow);
+	
 	/********************* ACCELEROMETER INTERRUPT ***************************/
 	// create a timer for reset of the interrupt 
 	ret = app_timer_create(&sampling_accelerometer_interrupt_reset_timer, APP_TIMER_MODE_SINGLE_SHOT, sampling_accelerometer_interrupt_reset_callback);
@@ -217,6 +294,8 @@ ret_code_t sampling_init(void) {
 	ret = timeout_register(&accelerometer_interrupt_stream_timeout_id, sampling_timeout_accelerometer_interrupt_stream);
 	if(ret != NRF_SUCCESS) return ret;
 	
+	overflow_init(&accelerometer_interrupt_overflow);
+	
 	#endif
 	
 	
@@ -242,6 +321,8 @@ ret_code_t sampling_init(void) {
 	ret = timeout_register(&battery_stream_timeout_id, sampling_timeout_battery_stream);
 	if(ret != NRF_SUCCESS) return ret;
 	
+	overflow_init(&battery_overflow);
+	
 
 	/********************* MICROPHONE ***********************************/
 	microphone_init();
@@ -267,6 +348,8 @@ ret_code_t sampling_init(void) {
 	ret = timeout_register(&microphone_stream_timeout_id, sampling_timeout_microphone_stream);
 	if(ret != NRF_SUCCESS) return ret;
 	
+	overflow_init(&microphone_overflow);
+	
 	/********************* SCAN ***************************************/
 	scanner_init();
 	
@@ -291,6 +374,8 @@ ret_code_t sampling_init(void) {
 	ret = timeout_register(&scan_stream_timeout_id, sampling_timeout_scan_stream);
 	if(ret != NRF_SUCCESS) return ret;
 	
+	overflow_init(&scan_overflow);
+	
 	return NRF_SUCCESS;
 }
 
@@ -522,11 +607,12 @@ void sampling_finalize_accelerometer_chunk(void) {
 	debug_log("SAMPLING: Finalize accelerometer chunk\n");
 	
 	// Close the chunk in the FIFO
-	chunk_fifo_write_close(&accelerometer_chunk_fifo);
+	ret_code_t ret = chunk_fifo_write_close(&accelerometer_chunk_fifo);
+	overflow_on_chunk_closed(&accelerometer_overflow, &accelerometer_chunk_fifo, ret);
 	
 	sampling_setup_accelerometer_chunk();		// Setup a new chunk
 	
-	app_sched_event_put(NULL, 0, processing_process_accelerometer_chunk);
+	scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_process_accelerometer_chunk);
 	#endif
 }
 
@@ -541,6 +627,7 @@ void sampling_accelerometer_fifo_callback(void* p_context) {
 	if((sampling_configuration & SAMPLING_ACCELEROMETER) == 0 && (sampling_configuration & STREAMING_ACCELEROMETER) == 0)
 		return;
 	
+	TRACE_BEGIN(TRACE_EVENT_SAMPLING_ACCELEROMETER, 0);
 	int16_t x[32], y[32], z[32];
 	
 	uint32_t num =  accelerometer_chunk->accelerometer_data_count;
@@ -548,8 +635,10 @@ void sampling_accelerometer_fifo_callback(void* p_context) {
 	uint8_t num_samples = 0;
 	// Read the accelerometer
 	ret_code_t ret = accel_read_acceleration(x, y, z, &num_samples, remaining_num_samples);
-	if(ret != NRF_SUCCESS)
+	if(ret != NRF_SUCCESS) {
+		TRACE_END(TRACE_EVENT_SAMPLING_ACCELEROMETER, 0);
 		return;
+	}
 	//debug_log("SAMPLING: Read accel fifo: n=%u, remain=%u, ms=%u\n", num_samples, remaining_num_samples, (uint32_t) systick_get_millis());
 	if(sampling_configuration & SAMPLING_ACCELEROMETER) {	// Fill the chunk if we want to
 		for(uint8_t i = 0; i < num_samples; i++) {	
@@ -574,7 +663,9 @@ void sampling_accelerometer_fifo_callback(void* p_context) {
 			accelerometer_stream.accelerometer_raw_data.raw_acceleration[2] = z[i];
 			circular_fifo_write(&accelerometer_stream_fifo, (uint8_t*) &accelerometer_stream, sizeof(accelerometer_stream));
 		}
+		notify_stream_handler();
 	}	
+	TRACE_END(TRACE_EVENT_SAMPLING_ACCELEROMETER, num_samples);
 	#endif
 }
 
@@ -689,9 +780,10 @@ void sampling_finalize_accelerometer_interrupt_chunk(void) {
 	debug_log("SAMPLING: Finalize accelerometer interrupt chunk\n");
 	
 	// Close the chunk in the FIFO
-	chunk_fifo_write_close(&accelerometer_interrupt_chunk_fifo);
+	ret_code_t ret = chunk_fifo_write_close(&accelerometer_interrupt_chunk_fifo);
+	overflow_on_chunk_closed(&accelerometer_interrupt_overflow, &accelerometer_interrupt_chunk_fifo, ret);
 	
-	app_sched_event_put(NULL, 0, processing_process_accelerometer_interrupt_chunk);
+	scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_process_accelerometer_interrupt_chunk);
 	
 	// Don't call sampling_setup_accelerometer_interrupt_chunk() here because it should be called via the reset-timer
 	#endif
@@ -704,7 +796,7 @@ void sampling_accelerometer_interrupt_reset_callback(void* p_context) {
 	// because the SPI-transfer might have the same IRQ-Priority like this function (called by the timer)
 	// and so the SPI-transfer would never terminate.
 	
-	app_sched_event_put(NULL, 0, sampling_setup_accelerometer_interrupt_chunk);
+	scheduler_event_put(SCHEDULER_PRIORITY_SAMPLING, sampling_setup_accelerometer_interrupt_chunk);
 	#endif
 }
 
@@ -723,6 +815,7 @@ void sampling_accelerometer_interrupt_callback(accel_interrupt_event_t const * p
 	if((sampling_configuration & SAMPLING_ACCELEROMETER_INTERRUPT) == 0 && (sampling_configuration & STREAMING_ACCELEROMETER_INTERRUPT) == 0)
 		return;
 	
+	TRACE_BEGIN(TRACE_EVENT_SAMPLING_ACCELEROMETER_INTERRUPT, 0);
 	
 	if(sampling_configuration & SAMPLING_ACCELEROMETER_INTERRUPT) {	
 		systick_get_timestamp(&(accelerometer_interrupt_chunk->timestamp.seconds), &(accelerometer_interrupt_chunk->timestamp.ms));
@@ -737,12 +830,14 @@ void sampling_accelerometer_interrupt_callback(accel_interrupt_event_t const * p
 		systick_get_timestamp(&(accelerometer_interrupt_stream.timestamp.seconds), &(accelerometer_interrupt_stream.timestamp.ms));
 
 		circular_fifo_write(&accelerometer_interrupt_stream_fifo, (uint8_t*) &accelerometer_interrupt_stream, sizeof(accelerometer_interrupt_stream));
+		notify_stream_handler();
 
 	}	
 	
 	
 	// Now start the reset timer that should reset the interrupt after a certain period of time.
 	app_timer_start(sampling_accelerometer_interrupt_reset_timer, APP_TIMER_TICKS(accelerometer_interrupt_ignore_duration_ms, 0), NULL);
+	TRACE_END(TRACE_EVENT_SAMPLING_ACCELEROMETER_INTERRUPT, 0);
 	#endif
 }
 
@@ -848,10 +943,10 @@ void sampling_battery_callback(void* p_context) {
 	if((sampling_configuration & SAMPLING_BATTERY) == 0 && (sampling_configuration & STREAMING_BATTERY) == 0)
 		return;
 	
-	
+	TRACE_BEGIN(TRACE_EVENT_SAMPLING_BATTERY, 0);
 	float voltage = battery_get_voltage();
 	
-	if(sampling_configuration & SAMPLING_BATTERY) {	
+	if((sampling_configuration & SAMPLING_BATTERY) && !overflow_skip_sample(&battery_overflow)) {	
 		systick_get_timestamp(&(battery_chunk->timestamp.seconds), &(battery_chunk->timestamp.ms));
 		battery_chunk->battery_data.voltage = voltage;
 		sampling_finalize_battery_chunk();
@@ -861,7 +956,9 @@ void sampling_battery_callback(void* p_context) {
 		BatteryStream battery_stream;
 		battery_stream.battery_data.voltage = voltage;		
 		circular_fifo_write(&battery_stream_fifo, (uint8_t*) &battery_stream, sizeof(battery_stream));
+		notify_stream_handler();
 	}		
+	TRACE_END(TRACE_EVENT_SAMPLING_BATTERY, 0);
 }
 
 void sampling_setup_battery_chunk(void) {
@@ -872,11 +969,12 @@ void sampling_setup_battery_chunk(void) {
 
 void sampling_finalize_battery_chunk(void) {
 	// Close the chunk in the FIFO
-	chunk_fifo_write_close(&battery_chunk_fifo);
+	ret_code_t ret = chunk_fifo_write_close(&battery_chunk_fifo);
+	overflow_on_chunk_closed(&battery_overflow, &battery_chunk_fifo, ret);
 	
 	sampling_setup_battery_chunk();
 	
-	app_sched_event_put(NULL, 0, processing_process_battery_chunk);
+	scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_process_battery_chunk);
 }
 
 
@@ -996,6 +1094,7 @@ void sampling_microphone_callback(void* p_context) {
 		debug_log("SAMPLING: Microphone aggregated count <= 5. We need more samples!\n");
 	}
 
+	TRACE_BEGIN(TRACE_EVENT_SAMPLING_MICROPHONE, 0);
 	uint32_t tmp = (microphone_aggregated/(microphone_aggregated_count/2));
 	uint8_t value = (tmp > 255) ? 255 : ((uint8_t) tmp);
 
@@ -1003,7 +1102,7 @@ void sampling_microphone_callback(void* p_context) {
 	microphone_aggregated = 0;
 	microphone_aggregated_count = 0;
 	
-	if(sampling_configuration & SAMPLING_MICROPHONE) {
+	if((sampling_configuration & SAMPLING_MICROPHONE) && !overflow_skip_sample(&microphone_overflow)) {
 		microphone_chunk->microphone_data[microphone_chunk->microphone_data_count].value = value;
 		microphone_chunk->microphone_data_count++;
 		//debug_log("SAMPLING: Mic value: %u, %u\n", value, microphone_chunk->microphone_data_count);
@@ -1016,9 +1115,10 @@ void sampling_microphone_callback(void* p_context) {
 		MicrophoneStream microphone_stream;
 		microphone_stream.microphone_data.value = value;
 		circular_fifo_write(&microphone_stream_fifo, (uint8_t*) &microphone_stream, sizeof(microphone_stream));
+		notify_stream_handler();
 	}
 	
-	
+	TRACE_END(TRACE_EVENT_SAMPLING_MICROPHONE, value);
 }
 
 void sampling_microphone_aggregated_callback(void* p_context) {
@@ -1042,18 +1142,19 @@ void sampling_setup_microphone_chunk(void) {
 	chunk_fifo_write_open(&microphone_chunk_fifo, (void**) &microphone_chunk, NULL);
 	
 	systick_get_timestamp(&(microphone_chunk->timestamp.seconds), &(microphone_chunk->timestamp.ms));
-	microphone_chunk->sample_period_ms = sampling_microphone_parameters.microphone_period_ms;
+	microphone_chunk->sample_period_ms = sampling_microphone_parameters.microphone_period_ms * microphone_overflow.degrade_factor;
 	microphone_chunk->microphone_data_count = 0;	
 }
 
 void sampling_finalize_microphone_chunk(void) {
 	debug_log("SAMPLING: sampling_finalize_microphone_chunk\n");
 	// Close the chunk in the FIFO
-	chunk_fifo_write_close(&microphone_chunk_fifo);
+	ret_code_t ret = chunk_fifo_write_close(&microphone_chunk_fifo);
+	overflow_on_chunk_closed(&microphone_overflow, &microphone_chunk_fifo, ret);
 	
 	sampling_setup_microphone_chunk();		// Setup a new chunk
 	
-	app_sched_event_put(NULL, 0, processing_process_microphone_chunk);
+	scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_process_microphone_chunk);
 }
 
 /************************** SCAN *********************************/
@@ -1162,8 +1263,11 @@ void sampling_timeout_scan_stream(void) {
 }
 
 void sampling_scan_callback(void* p_context) {
-	if(sampling_configuration & SAMPLING_SCAN) {
+	scan_sampling_chunk_recording = (sampling_configuration & SAMPLING_SCAN) && !overflow_skip_sample(&scan_overflow);
+	if(scan_sampling_chunk_recording) {
 		sampling_setup_scan_sampling_chunk();
+	} else if((sampling_configuration & STREAMING_SCAN) == 0) {
+		return;	// Nothing to record in this scan-cycle (degraded sampling rate)
 	}
 	// Start the scan procedure:
 	ret_code_t ret = scanner_start_scanning(sampling_scan_parameters.scan_interval_ms, sampling_scan_parameters.scan_window_ms, sampling_scan_parameters.scan_duration_seconds);
@@ -1172,7 +1276,8 @@ void sampling_scan_callback(void* p_context) {
 }
 
 void sampling_on_scan_timeout_callback(void) {
-	if(sampling_configuration & SAMPLING_SCAN) {
+	if((sampling_configuration & SAMPLING_SCAN) && scan_sampling_chunk_recording) {
+		scan_sampling_chunk_recording = 0;
 		sampling_finalize_scan_sampling_chunk();
 	}
 }
@@ -1184,8 +1289,9 @@ void sampling_on_scan_report_callback(scanner_scan_report_t* scanner_scan_report
 		return;
 	}
 
+	TRACE_BEGIN(TRACE_EVENT_SAMPLING_SCAN, scanner_scan_report->ID);
 	
-	if(sampling_configuration & SAMPLING_SCAN) {
+	if((sampling_configuration & SAMPLING_SCAN) && scan_sampling_chunk_recording) {
 	
 		uint8_t prev_seen = 0;
 		for(uint32_t i = 0; i < scan_sampling_chunk->scan_result_data_count; i++) {
@@ -1221,9 +1327,10 @@ void sampling_on_scan_report_callback(scanner_scan_report_t* scanner_scan_report
 		scan_stream.scan_device.ID = scanner_scan_report->ID;
 		scan_stream.scan_device.rssi = scanner_scan_report->rssi;
 		circular_fifo_write(&scan_stream_fifo, (uint8_t*) &scan_stream, sizeof(scan_stream));
+		notify_stream_handler();
 	}
 	
-	
+	TRACE_END(TRACE_EVENT_SAMPLING_SCAN, scanner_scan_report->ID);
 }
 
 void sampling_setup_scan_sampling_chunk(void) {
@@ -1256,10 +1363,115 @@ void sampling_finalize_scan_sampling_chunk(void) {
 	//debug_log("SAMPLING: Scanning ended. Seen devices: %u\n", scan_sampling_chunk->scan_result_data_count);
 	
 	// Close the chunk in the FIFO
-	chunk_fifo_write_close(&scan_sampling_chunk_fifo);
+	ret_code_t ret = chunk_fifo_write_close(&scan_sampling_chunk_fifo);
+	overflow_on_chunk_closed(&scan_overflow, &scan_sampling_chunk_fifo, ret);
 	
 	
-	app_sched_event_put(NULL, 0, processing_process_scan_sampling_chunk);
+	scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_process_scan_sampling_chunk);
 
 }
 
+
+
+/************************** OVERFLOW *********************************/
+
+/**@brief Function to retrieve the overflow-handling structure and the chunk-fifo of a data-source.
+ *
+ * @param[in]	sampling_type	The data-source.
+ * @param[out]	overflow		Pointer to the pointer of the overflow-handling structure.
+ * @param[out]	chunk_fifo		Pointer to the pointer of the chunk-fifo.
+ *
+ * @retval	NRF_SUCCESS					If the data-source is available.
+ * @retval	NRF_ERROR_INVALID_PARAM		If the sampling_type is not an available data-source.
+ */
+static ret_code_t get_overflow_and_chunk_fifo(sampling_configuration_t sampling_type, sampling_overflow_t** overflow, chunk_fifo_t** chunk_fifo) {
+	#if SAMPLING_ACCEL_ENABLED
+	if(sampling_type == SAMPLING_ACCELEROMETER) {
+		*overflow = &accelerometer_overflow;
+		*chunk_fifo = &accelerometer_chunk_fifo;
+		return NRF_SUCCESS;
+	}
+	if(sampling_type == SAMPLING_ACCELEROMETER_INTERRUPT) {
+		*overflow = &accelerometer_interrupt_overflow;
+		*chunk_fifo = &accelerometer_interrupt_chunk_fifo;
+		return NRF_SUCCESS;
+	}
+	#endif
+	if(sampling_type == SAMPLING_BATTERY) {
+		*overflow = &battery_overflow;
+		*chunk_fifo = &battery_chunk_fifo;
+	} else if(sampling_type == SAMPLING_MICROPHONE) {
+		*overflow = &microphone_overflow;
+		*chunk_fifo = &microphone_chunk_fifo;
+	} else if(sampling_type == SAMPLING_SCAN) {
+		*overflow = &scan_overflow;
+		*chunk_fifo = &scan_sampling_chunk_fifo;
+	} else {
+		return NRF_ERROR_INVALID_PARAM;
+	}
+	return NRF_SUCCESS;
+}
+
+ret_code_t sampling_set_overflow_policy(sampling_configuration_t sampling_type, sampling_overflow_policy_t overflow_policy) {
+	sampling_overflow_t* overflow;
+	chunk_fifo_t* chunk_fifo;
+	ret_code_t ret = get_overflow_and_chunk_fifo(sampling_type, &overflow, &chunk_fifo);
+	if(ret != NRF_SUCCESS) return ret;
+	
+	// The accelerometer chunks have no fixed sampling period that could be degraded
+	if(overflow_policy == SAMPLING_OVERFLOW_DEGRADE_RATE && (sampling_type == SAMPLING_ACCELEROMETER || sampling_type == SAMPLING_ACCELEROMETER_INTERRUPT))
+		return NRF_ERROR_INVALID_PARAM;
+	
+	// The degrade factor is reset when the current chunk is closed
+	overflow->overflow_policy = overflow_policy;
+	chunk_fifo_set_overflow_policy(chunk_fifo, (overflow_policy == SAMPLING_OVERFLOW_DROP_OLDEST) ? CHUNK_FIFO_OVERFLOW_DROP_OLDEST : CHUNK_FIFO_OVERFLOW_DROP_NEWEST);
+	
+	return NRF_SUCCESS;
+}
+
+ret_code_t sampling_get_overflow_policy(sampling_configuration_t sampling_type, sampling_overflow_policy_t* overflow_policy, uint8_t* degrade_factor) {
+	sampling_overflow_t* overflow;
+	chunk_fifo_t* chunk_fifo;
+	ret_code_t ret = get_overflow_and_chunk_fifo(sampling_type, &overflow, &chunk_fifo);
+	if(ret != NRF_SUCCESS) return ret;
+	
+	*overflow_policy = overflow->overflow_policy;
+	*degrade_factor = overflow->degrade_factor;
+	return NRF_SUCCESS;
+}
+
+void sampling_get_chunk_fifo_statistics(sampling_configuration_t sampling_type, chunk_fifo_statistics_t* statistics) {
+	sampling_overflow_t* overflow;
+	chunk_fifo_t* chunk_fifo;
+	ret_code_t ret = get_overflow_and_chunk_fifo(sampling_type, &overflow, &chunk_fifo);
+	if(ret != NRF_SUCCESS) {
+		memset(statistics, 0, sizeof(chunk_fifo_statistics_t));
+		return;
+	}
+	chunk_fifo_get_statistics(chunk_fifo, statistics);
+}
+
+uint16_t sampling_get_dropped_chunks(void) {
+	const sampling_configuration_t sampling_types[] = {SAMPLING_ACCELEROMETER, SAMPLING_ACCELEROMETER_INTERRUPT, SAMPLING_BATTERY, SAMPLING_MICROPHONE, SAMPLING_SCAN};
+	uint32_t dropped_chunks = 0;
+	for(uint8_t i = 0; i < sizeof(sampling_types)/sizeof(sampling_types[0]); i++) {
+		chunk_fifo_statistics_t statistics;
+		sampling_get_chunk_fifo_statistics(sampling_types[i], &statistics);
+		dropped_chunks += statistics.dropped_chunks;
+	}
+	return (dropped_chunks > 0xFFFF) ? 0xFFFF : (uint16_t) dropped_chunks;
+}
+
+void sampling_reset_chunk_fifo_statistics(void) {
+	#if SAMPLING_ACCEL_ENABLED
+	chunk_fifo_reset_statistics(&accelerometer_chunk_fifo);
+	chunk_fifo_reset_statistics(&accelerometer_interrupt_chunk_fifo);
+	#endif
+	chunk_fifo_reset_statistics(&battery_chunk_fifo);
+	chunk_fifo_reset_statistics(&microphone_chunk_fifo);
+	chunk_fifo_reset_statistics(&scan_sampling_chunk_fifo);
+}
+
+void sampling_set_stream_handler(sampling_stream_handler_t handler) {
+	stream_handler = handler;
+}
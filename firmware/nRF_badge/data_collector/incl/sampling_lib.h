@@ -26,6 +26,18 @@ typedef enum {
 	STREAMING_SCAN 						= (1 << 9),
 } sampling_configuration_t;
 
+/**@brief Handler type that is called after new samples were put into a stream-fifo (could be called in interrupt context). */
+typedef void (*sampling_stream_handler_t)(void);
+
+/**@brief The policies of the data-sources, when its chunk-fifo is full because the chunks could not be stored fast enough. */
+typedef enum {
+	SAMPLING_OVERFLOW_DROP_NEWEST	= 0,	/**< The newest chunk is dropped (default). */
+	SAMPLING_OVERFLOW_DROP_OLDEST	= 1,	/**< The oldest not yet stored chunk is dropped. */
+	SAMPLING_OVERFLOW_DEGRADE_RATE	= 2,	/**< The newest chunk is dropped and the sampling rate is halved (down to 1/SAMPLING_OVERFLOW_MAX_DEGRADE_FACTOR), until the chunks are stored fast enough again. */
+} sampling_overflow_policy_t;
+
+#define SAMPLING_OVERFLOW_MAX_DEGRADE_FACTOR	8	/**< The maximum factor the sampling period is increased by the SAMPLING_OVERFLOW_DEGRADE_RATE-policy. */
+
 
 /**< Declaration of the chunk-fifos and stream-fifos of the different data-sources */
 extern chunk_fifo_t 	accelerometer_chunk_fifo;
@@ -196,4 +208,57 @@ void 	   sampling_stop_scan(uint8_t streaming);
 
 
 
+/**@brief Function to set the overflow-policy of a data-source.
+ *
+ * @details	The policy defines what happens when a chunk is finished while the chunk-fifo of the data-source is full 
+ *			(e.g. because the storage is busy for a longer time). The SAMPLING_OVERFLOW_DEGRADE_RATE-policy records only every 
+ *			2nd, 4th, ... sample in the chunks (the streams are not affected) and restores the rate step by step, once the chunk-fifo drains.
+ *
+ * @param[in]	sampling_type				The data-source: SAMPLING_ACCELEROMETER, SAMPLING_ACCELEROMETER_INTERRUPT, SAMPLING_BATTERY, SAMPLING_MICROPHONE or SAMPLING_SCAN.
+ * @param[in]	overflow_policy				The overflow-policy to use for the data-source.
+ *
+ * @retval		NRF_SUCCESS 				If everything was ok.
+ * @retval		NRF_ERROR_INVALID_PARAM		If the sampling_type is not a data-source, or the policy is not supported by the data-source
+ *											(SAMPLING_OVERFLOW_DEGRADE_RATE is not supported by the accelerometer and the accelerometer-interrupt).
+ */
+ret_code_t sampling_set_overflow_policy(sampling_configuration_t sampling_type, sampling_overflow_policy_t overflow_policy);
+
+/**@brief Function to retrieve the overflow-policy and the current degrade factor of a data-source.
+ *
+ * @param[in]	sampling_type				The data-source: SAMPLING_ACCELEROMETER, SAMPLING_ACCELEROMETER_INTERRUPT, SAMPLING_BATTERY, SAMPLING_MICROPHONE or SAMPLING_SCAN.
+ * @param[out]	overflow_policy				Pointer to the overflow-policy of the data-source.
+ * @param[out]	degrade_factor				Pointer to the factor the sampling rate is currently degraded by (1 if not degraded).
+ *
+ * @retval		NRF_SUCCESS 				If everything was ok.
+ * @retval		NRF_ERROR_INVALID_PARAM		If the sampling_type is not a data-source.
+ */
+ret_code_t sampling_get_overflow_policy(sampling_configuration_t sampling_type, sampling_overflow_policy_t* overflow_policy, uint8_t* degrade_factor);
+
+/**@brief Function to retrieve the statistics (dropped chunks and high-water mark) of the chunk-fifo of a data-source.
+ *
+ * @param[in]	sampling_type				The data-source: SAMPLING_ACCELEROMETER, SAMPLING_ACCELEROMETER_INTERRUPT, SAMPLING_BATTERY, SAMPLING_MICROPHONE or SAMPLING_SCAN.
+ * @param[out]	statistics					Pointer to the statistics structure that should be filled (all zero if the data-source is not available).
+ */
+void sampling_get_chunk_fifo_statistics(sampling_configuration_t sampling_type, chunk_fifo_statistics_t* statistics);
+
+/**@brief Function to retrieve the total number of chunks that were dropped by all data-sources.
+ *
+ * @retval		The number of dropped chunks (saturates at 0xFFFF).
+ */
+uint16_t sampling_get_dropped_chunks(void);
+
+/**@brief Function to reset the statistics of the chunk-fifos of all data-sources.
+ */
+void sampling_reset_chunk_fifo_statistics(void);
+
+/**@brief Function to set the handler that is called after new samples were put into a stream-fifo.
+ *
+ * @details	The handler allows the streaming to be triggered by the fill-level of the stream-fifos, instead of polling them.
+ *
+ * @param[in]	stream_handler				The handler, or NULL to disable it.
+ */
+void sampling_set_stream_handler(sampling_stream_handler_t stream_handler);
+
+
+
 #endif
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "scheduler_lib.h"
+#include "stdlib.h" // Needed for NULL definition
+#include "app_util_platform.h"
+#include "trace_lib.h"
+
+/**@brief The queue of one priority class. */
+typedef struct {
+	app_sched_event_handler_t	handlers[SCHEDULER_QUEUE_SIZE];		/**< The pending event handlers. */
+	uint16_t					put_sequence[SCHEDULER_QUEUE_SIZE];	/**< The dispatch_sequence at the time the event was put (to compute the wait). */
+	volatile uint8_t			read_pos;
+	volatile uint8_t			count;
+	uint8_t						skipped;							/**< Number of times the (non-empty) class was skipped by a higher priority class. */
+	scheduler_statistics_t		statistics;
+} scheduler_queue_t;
+
+static scheduler_queue_t scheduler_queues[SCHEDULER_NUMBER_OF_PRIORITIES];
+static volatile uint16_t dispatch_sequence = 0;	/**< Incremented with every executed event (wraps around). */
+
+static void scheduler_dispatch(void * p_event_data, uint16_t event_size);
+
+
+ret_code_t scheduler_init(void) {
+	CRITICAL_REGION_ENTER();
+	for(uint8_t i = 0; i < SCHEDULER_NUMBER_OF_PRIORITIES; i++) {
+		scheduler_queues[i].read_pos = 0;
+		scheduler_queues[i].count = 0;
+		scheduler_queues[i].skipped = 0;
+		scheduler_queues[i].statistics.high_water_mark = 0;
+		scheduler_queues[i].statistics.max_wait = 0;
+		scheduler_queues[i].statistics.dropped_events = 0;
+	}
+	dispatch_sequence = 0;
+	CRITICAL_REGION_EXIT();
+	return NRF_SUCCESS;
+}
+
+ret_code_t scheduler_event_put(scheduler_priority_t priority, app_sched_event_handler_t handler) {
+	if(priority >= SCHEDULER_NUMBER_OF_PRIORITIES || handler == NULL)
+		return NRF_ERROR_INVALID_PARAM;
+	
+	ret_code_t ret = NRF_SUCCESS;
+	scheduler_queue_t* queue = &scheduler_queues[priority];
+	
+	CRITICAL_REGION_ENTER();
+	if(queue->count >= SCHEDULER_QUEUE_SIZE) {
+		ret = NRF_ERROR_NO_MEM;
+	} else {
+		// Every queued event gets its own dispatch-event, so the app-scheduler queue is the overall limit.
+		ret = app_sched_event_put(NULL, 0, scheduler_dispatch);
+		if(ret == NRF_SUCCESS) {
+			uint8_t write_pos = (queue->read_pos + queue->count) % SCHEDULER_QUEUE_SIZE;
+			queue->handlers[write_pos] = handler;
+			queue->put_sequence[write_pos] = dispatch_sequence;
+			queue->count++;
+			if(queue->count > queue->statistics.high_water_mark)
+				queue->statistics.high_water_mark = queue->count;
+		}
+	}
+	if(ret != NRF_SUCCESS && queue->statistics.dropped_events < 0xFFFF)
+		queue->statistics.dropped_events++;
+	CRITICAL_REGION_EXIT();
+	
+	TRACE_INSTANT(TRACE_EVENT_SCHEDULER_PUT, priority);
+	
+	return ret;
+}
+
+/**@brief Function to select the priority class whose event should be executed next.
+ *
+ * @details	Normally the highest non-empty priority class is selected. If a lower non-empty 
+ *			class has been skipped SCHEDULER_STARVATION_LIMIT times, it is selected instead.
+ *			Has to be called in a critical region.
+ *
+ * @retval	The selected priority class, or SCHEDULER_NUMBER_OF_PRIORITIES if all queues are empty.
+ */
+static uint8_t select_priority(void) {
+	uint8_t selected = SCHEDULER_NUMBER_OF_PRIORITIES;
+	for(uint8_t i = 0; i < SCHEDULER_NUMBER_OF_PRIORITIES; i++) {
+		if(scheduler_queues[i].count == 0)
+			continue;
+		if(selected == SCHEDULER_NUMBER_OF_PRIORITIES) {
+			selected = i;
+		} else if(scheduler_queues[i].skipped >= SCHEDULER_STARVATION_LIMIT) {
+			// Starving lower priority class --> serve it now (the higher one is skipped instead)
+			selected = i;
+			break;
+		}
+	}
+	
+	for(uint8_t i = 0; i < SCHEDULER_NUMBER_OF_PRIORITIES; i++) {
+		if(i == selected)
+			scheduler_queues[i].skipped = 0;
+		else if(scheduler_queues[i].count > 0 && scheduler_queues[i].skipped < 0xFF)
+			scheduler_queues[i].skipped++;
+	}
+	return selected;
+}
+
+/**@brief Handler that is put into the app-scheduler for every event. It executes the next event according to the priorities.
+ *
+ * @param[in]	p_event_data	Pointer to event data (not used).
+ * @param[in]	event_size		Size of the event data (not used).
+ */
+static void scheduler_dispatch(void * p_event_data, uint16_t event_size) {
+	app_sched_event_handler_t handler = NULL;
+	uint8_t priority;
+	
+	CRITICAL_REGION_ENTER();
+	priority = select_priority();
+	if(priority < SCHEDULER_NUMBER_OF_PRIORITIES) {
+		scheduler_queue_t* queue = &scheduler_queues[priority];
+		handler = queue->handlers[queue->read_pos];
+		uint16_t wait = (uint16_t)(dispatch_sequence - queue->put_sequence[queue->read_pos]);
+		if(wait > queue->statistics.max_wait)
+			queue->statistics.max_wait = wait;
+		queue->read_pos = (queue->read_pos + 1) % SCHEDULER_QUEUE_SIZE;
+		queue->count--;
+		dispatch_sequence++;
+	}
+	CRITICAL_REGION_EXIT();
+	
+	if(handler != NULL) {
+		TRACE_BEGIN(TRACE_EVENT_SCHEDULER_EXECUTE, priority);
+		handler(NULL, 0);
+		TRACE_END(TRACE_EVENT_SCHEDULER_EXECUTE, priority);
+	}
+}
+
+uint32_t scheduler_get_pending_events(scheduler_priority_t priority) {
+	if(priority >= SCHEDULER_NUMBER_OF_PRIORITIES)
+		return 0;
+	return scheduler_queues[priority].count;
+}
+
+ret_code_t scheduler_get_statistics(scheduler_priority_t priority, scheduler_statistics_t* statistics) {
+	if(priority >= SCHEDULER_NUMBER_OF_PRIORITIES || statistics == NULL)
+		return NRF_ERROR_INVALID_PARAM;
+	
+	CRITICAL_REGION_ENTER();
+	*statistics = scheduler_queues[priority].statistics;
+	CRITICAL_REGION_EXIT();
+	return NRF_SUCCESS;
+}
+
+void scheduler_reset_statistics(void) {
+	CRITICAL_REGION_ENTER();
+	for(uint8_t i = 0; i < SCHEDULER_NUMBER_OF_PRIORITIES; i++) {
+		scheduler_queues[i].statistics.high_water_mark = scheduler_queues[i].count;
+		scheduler_queues[i].statistics.max_wait = 0;
+		scheduler_queues[i].statistics.dropped_events = 0;
+	}
+	CRITICAL_REGION_EXIT();
+}
@@ -0,0 +1,88 @@
+/**@file
+ * @details This module provides priority classes on top of the app-scheduler.
+ *			Every event is put into a static queue of its priority class and a dispatch-event is put
+ *			into the app-scheduler. Each dispatch-event executes the oldest event of the highest 
+ *			non-empty priority class, so e.g. the processing of a BLE-request doesn't have to wait 
+ *			behind storage-work that reschedules itself.
+ *
+ *			To guarantee that lower priority classes are not starved (e.g. by a handler that reschedules itself 
+ *			until a lower priority handler has finished), a waiting lower priority class is served
+ *			after it was skipped SCHEDULER_STARVATION_LIMIT times.
+ *
+ * @note 	Only events without event-data are supported (all handlers of the application are called with NULL, 0).
+ * @note	The app-scheduler has to be initialized before (APP_SCHED_INIT()).
+ */
+
+#ifndef __SCHEDULER_LIB_H
+#define __SCHEDULER_LIB_H
+
+#include "stdint.h"
+#include "sdk_errors.h"	// Needed for the definition of ret_code_t and the error-codes
+#include "app_scheduler.h"
+
+
+#define SCHEDULER_QUEUE_SIZE				20		/**< Maximal number of pending events per priority class. */
+#define SCHEDULER_STARVATION_LIMIT			8		/**< Number of times a waiting priority class could be skipped before it is served. */
+
+/**@brief The different priority classes of the scheduler (the lower the value, the higher the priority). */
+typedef enum {
+	SCHEDULER_PRIORITY_RX_TX			= 0,	/**< Processing of received requests and sending of the responses. */
+	SCHEDULER_PRIORITY_SAMPLING			= 1,	/**< Setup of the sampling of the peripherals. */
+	SCHEDULER_PRIORITY_PROCESSING		= 2,	/**< Processing and storing of the sampled chunks and streaming. */
+	SCHEDULER_PRIORITY_HOUSEKEEPING		= 3,	/**< Everything else, e.g. updating the advertising data. */
+	SCHEDULER_NUMBER_OF_PRIORITIES		= 4,
+} scheduler_priority_t;
+
+/**@brief Statistics of a priority class, to measure the latency of the events. */
+typedef struct {
+	uint16_t	max_wait;			/**< Maximum number of events that were executed between putting and executing an event of the priority class. */
+	uint16_t	dropped_events;		/**< Number of events that could not be put because the queue was full (saturates at 0xFFFF). */
+	uint8_t		high_water_mark;	/**< Maximum number of events that were pending in the priority class at the same time. */
+} scheduler_statistics_t;
+
+
+/**@brief Function to initialize (or to reset) the scheduler-module.
+ *
+ * @details	Clears all pending events and the statistics. 
+ *			If the module is used without calling this function, all queues are empty.
+ *
+ * @retval	NRF_SUCCESS		On success.
+ */
+ret_code_t scheduler_init(void);
+
+/**@brief Function to put an event into the queue of a priority class.
+ *
+ * @details	This is the prioritised version of app_sched_event_put(NULL, 0, handler).
+ *			It can be called from interrupt context.
+ *
+ * @param[in]	priority	The priority class of the event.
+ * @param[in]	handler		The event handler that should be called (it will be called with NULL, 0).
+ *
+ * @retval	NRF_SUCCESS					If the event was put successfully.
+ * @retval	NRF_ERROR_INVALID_PARAM		If the priority class or the handler is invalid.
+ * @retval	NRF_ERROR_NO_MEM			If the queue of the priority class or the app-scheduler queue is full.
+ */
+ret_code_t scheduler_event_put(scheduler_priority_t priority, app_sched_event_handler_t handler);
+
+/**@brief Function to retrieve the number of pending events of a priority class.
+ *
+ * @param[in]	priority	The priority class.
+ *
+ * @retval	The number of pending events.
+ */
+uint32_t scheduler_get_pending_events(scheduler_priority_t priority);
+
+/**@brief Function to retrieve the statistics of a priority class.
+ *
+ * @param[in]	priority	The priority class.
+ * @param[out]	statistics	Pointer to the statistics that should be filled.
+ *
+ * @retval	NRF_SUCCESS					On success.
+ * @retval	NRF_ERROR_INVALID_PARAM		If the priority class is invalid.
+ */
+ret_code_t scheduler_get_statistics(scheduler_priority_t priority, scheduler_statistics_t* statistics);
+
+/**@brief Function to reset the statistics of all priority classes. */
+void scheduler_reset_statistics(void);
+
+#endif
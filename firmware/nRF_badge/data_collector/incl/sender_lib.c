@@ -6,6 +6,7 @@
 #include "app_util_platform.h"
 #include "timeout_lib.h"	// Needed for disconnecting after N milliseconds
 #include "app_timer.h"
+#include "trace_lib.h"
 #ifndef UNIT_TEST
 #include "custom_board.h"	// For LED
 #include "nrf_gpio.h"		// For LED
@@ -15,8 +16,7 @@
 //#include "string.h"
 #include "debug_lib.h"
 
-#define TRANSMIT_QUEUED_BYTES_PERIOD_MS		5	/**< The timer period where the transmit_queued_bytes-function is called */
-#define TX_FIFO_SIZE				512		/**< Size of the transmit fifo of the BLE (has to be a power of two) */
+#define TRANSMIT_QUEUED_BYTES_PERIOD_MS		5	/**< The timer period where the transmit_queued_bytes-function is called (to start the transmission, afterwards it is driven by the on transmit callback) */
 #define RX_FIFO_SIZE				128		/**< Size of the receive fifo of the BLE (has to be a power of two) */
 #define MAX_BYTES_PER_TRANSMIT		20		/**< Number of bytes that could be sent at once via the Nordic Uart Service */		
 #define DISCONNECT_TIMEOUT_MS		(15*1000) /**< The timeout after the sender should disconnect when no packet was transmitted successfully in this time */
@@ -28,6 +28,16 @@
 
 
 
+typedef struct {
+	sender_segment_t 					segments[SENDER_MAX_SEGMENTS];	/**< The segments (the data are not copied) */
+	uint8_t								number_of_segments;
+	uint8_t								segment_index;					/**< The segment that is currently transmitted */
+	uint32_t							segment_offset;					/**< The number of bytes of the current segment that are already transmitted */
+	sender_transmit_complete_handler_t	complete_handler;				/**< Handler that is called when all bytes were handed to the BLE-stack */
+	void*								p_context;
+} transmit_entry_t;
+
+
 static void on_connect_callback(void);
 static void on_disconnect_callback(void);
 static void on_transmit_callback(void);
@@ -37,14 +47,19 @@ void transmit_queued_bytes_timer_callback(void* p_context);
 
 static volatile uint8_t connected = 0;			/**< Flag, if there is a ble-connection. */
 static volatile uint8_t transmitting = 0;		/**< Flag, if there is currently an ongoing transmit_queued_bytes()-operation. */
+static volatile uint8_t blocking_transmit_done = 0;				/**< Flag, if the transmit of sender_transmit() is done. */
+static volatile ret_code_t blocking_transmit_status = NRF_SUCCESS;	/**< The status of the transmit of sender_transmit(). */
 static sender_receive_notification_handler_t receive_notification_handler = NULL; /**< External notification handler, that should be called if sth was received */
+static sender_disconnect_handler_t disconnect_handler = NULL;	/**< External disconnect handler, that should be called if the connection was closed */
 
 
-static uint8_t 	tx_fifo_buf[TX_FIFO_SIZE];
 static uint8_t 	rx_fifo_buf[RX_FIFO_SIZE];
-static uint8_t	transmit_buf[MAX_BYTES_PER_TRANSMIT];	/**< Buffer where the actual bytes to send will be buffered */
+static uint8_t	transmit_buf[MAX_BYTES_PER_TRANSMIT];	/**< Buffer to gather the bytes of a notification that crosses a segment boundary */
+
+static transmit_entry_t	transmit_queue[SENDER_TRANSMIT_QUEUE_SIZE];	/**< The queue of the scatter-gather transmits */
+static volatile uint8_t	transmit_queue_read_index = 0;				/**< The index of the entry that is currently transmitted */
+static volatile uint8_t	transmit_queue_count = 0;					/**< Number of entries in the transmit queue */
 
-static app_fifo_t tx_fifo;								/**< The fifo for transmitting */
 static app_fifo_t rx_fifo;								/**< The fifo for receiving */
 
 static uint32_t disconnect_timeout_id = 0;				/**< The timeout-id for the disconnect timeout */
@@ -52,13 +67,56 @@ static uint32_t disconnect_timeout_id = 0;				/**< The timeout-id for the discon
 APP_TIMER_DEF(transmit_queued_bytes_timer);				/**< The app-timer to periodically call the transmit_queued_bytes */
 
 
+/**@brief Function to remove the current entry from the transmit queue and to call its complete handler.
+ *
+ * @param[in]	status	The status that is passed to the complete handler.
+ */
+static void transmit_queue_pop(ret_code_t status) {
+	sender_transmit_complete_handler_t complete_handler;
+	void* p_context;
+	CRITICAL_REGION_ENTER();
+	complete_handler = transmit_queue[transmit_queue_read_index].complete_handler;
+	p_context = transmit_queue[transmit_queue_read_index].p_context;
+	transmit_queue_read_index = (transmit_queue_read_index + 1) % SENDER_TRANSMIT_QUEUE_SIZE;
+	transmit_queue_count--;
+	CRITICAL_REGION_EXIT();
+	
+	// Now the buffers of this entry could be released
+	if(complete_handler != NULL)
+		complete_handler(status, p_context);
+}
+
+/**@brief Function to abort a queued transmit, e.g. when sender_transmit() timed out.
+ *
+ * @details	The remaining bytes of the entry are not transmitted (the data of the caller are not accessed anymore) 
+ *			and its complete handler is not called. The entry is removed by transmit_queued_bytes() when it is reached.
+ *
+ * @param[in]	complete_handler	The complete handler of the entry that should be aborted.
+ * @param[in]	p_context			The context of the entry that should be aborted.
+ */
+static void transmit_queue_abort(sender_transmit_complete_handler_t complete_handler, void* p_context) {
+	CRITICAL_REGION_ENTER();
+	for(uint8_t i = 0; i < transmit_queue_count; i++) {
+		transmit_entry_t* entry = &transmit_queue[(transmit_queue_read_index + i) % SENDER_TRANSMIT_QUEUE_SIZE];
+		if(entry->complete_handler == complete_handler && entry->p_context == p_context) {
+			entry->segment_index = entry->number_of_segments;
+			entry->complete_handler = NULL;
+			break;
+		}
+	}
+	CRITICAL_REGION_EXIT();
+}
+
 /**@brief Function to reset the sender state.
+ *
+ * @details	All queued transmits are aborted (their complete handlers are called with NRF_ERROR_INVALID_STATE).
  */
 static void sender_reset(void) {
 	connected = 0;
 	transmitting = 0;
-	// Flush the tx and rx FIFO
-	app_fifo_flush(&tx_fifo);
+	while(transmit_queue_count > 0)
+		transmit_queue_pop(NRF_ERROR_INVALID_STATE);
+	// Flush the rx FIFO
 	app_fifo_flush(&rx_fifo);
 }
 
@@ -93,15 +151,17 @@ static void on_disconnect_callback(void) {
 	#endif
 	#endif
 	debug_log("SENDER: Disconnected callback\n");
+	if(disconnect_handler != NULL)
+		disconnect_handler();
 }
 
 /**@brief Function that is called when the transmission was successful.
  *
- * @details transmit_queued_bytes() is called to send the remaining bytes in the FIFO.
+ * @details transmit_queued_bytes() is called to send the remaining bytes in the FIFO,
+ *			because the notification buffers of the SoftDevice are free again.
  */
 static void on_transmit_callback(void) {
-	// Reschedule the transmit of the queued bytes
-	// transmit_queued_bytes();
+	transmit_queued_bytes();
 }
 
 /**@brief Function that is called when data are received.
@@ -135,9 +195,14 @@ void transmit_queued_bytes_timer_callback(void* p_context) {
 }
 
 
-/**@brief Function transmits the data in tx_fifo in small portions (MAX_BYTES_PER_TRANSMIT).
+/**@brief Function transmits the data of the transmit queue in small portions (MAX_BYTES_PER_TRANSMIT).
  *
- * @retval	NRF_SUCCESS If the data were sent successfully. Otherwise, an error code is returned.
+ * @details	The portions are queued until the transmit queue is empty or all notification buffers of the SoftDevice are in use.
+ *			In the latter case the function is called again by the on transmit callback (or the timer as fallback).
+ *			A portion is passed directly from the segment to the BLE-stack, only portions that cross a segment boundary
+ *			are gathered in transmit_buf. A notification never contains bytes of two different entries.
+ *
+ * @retval	NRF_SUCCESS If the data were queued successfully. Otherwise, an error code is returned.
  */
 static ret_code_t transmit_queued_bytes(void) {
 	if(!transmitting) {
@@ -145,53 +210,82 @@ static ret_code_t transmit_queued_bytes(void) {
 		return NRF_ERROR_INVALID_STATE;
 	}
 
-	//uint32_t ms = (uint32_t) systick_get_continuous_millis();
-	//debug_log("Queued %u ms\n", ms);
-	
-	// Read out how many bytes have to be sent:
-	uint32_t remaining_size = 0;
-	CRITICAL_REGION_ENTER();
-	app_fifo_read(&tx_fifo, NULL, &remaining_size);
-	// Calculate the actual number of bytes to sent in this operation
-	if(remaining_size == 0) { // Clear the transmitting-flag, if we have nothing to send anymore
-		transmitting = 0;
-	}
-	CRITICAL_REGION_EXIT(); 
-	
-	uint32_t len = (remaining_size > sizeof(transmit_buf)) ? sizeof(transmit_buf) : remaining_size;	
-	
 	ret_code_t ret = NRF_SUCCESS;
-	if(len > 0) {	
-		// Read the bytes manually from the fifo to be efficient:
-		for(uint32_t i = 0; i < len; i++) 
-			transmit_buf[i] = tx_fifo.p_buf[(tx_fifo.read_pos + i) & tx_fifo.buf_size_mask];	// extracted from app_fifo.c: "static __INLINE void fifo_peek(app_fifo_t * p_fifo, uint16_t index, uint8_t * p_byte)"
-		/*
-		char out_buf[100];
-		sprintf(out_buf, "SENDER: Transmit (%u): ", (unsigned int) len);
-		for(uint8_t i = 0; i < len; i++)  
-			sprintf(&out_buf[strlen(out_buf)], "%02X", transmit_buf[i]);
-		debug_log("%s\n",out_buf);
-		systick_delay_millis(100);
-		*/
+	while(1) {
+		CRITICAL_REGION_ENTER();
+		if(transmit_queue_count == 0) { // Clear the transmitting-flag, if we have nothing to send anymore
+			transmitting = 0;
+		}
+		CRITICAL_REGION_EXIT(); 
+		
+		if(!transmitting) {
+			app_timer_stop(transmit_queued_bytes_timer);
+			break;
+		}
+		
+		transmit_entry_t* entry = &transmit_queue[transmit_queue_read_index];
+		
+		// Skip the completely transmitted segments
+		while(entry->segment_index < entry->number_of_segments && entry->segment_offset >= entry->segments[entry->segment_index].len) {
+			entry->segment_index++;
+			entry->segment_offset = 0;
+		}
+		if(entry->segment_index >= entry->number_of_segments) {
+			transmit_queue_pop(NRF_SUCCESS);
+			continue;
+		}
+		
+		// Check whether the portion could be sent directly out of the current segment
+		const sender_segment_t* segment = &entry->segments[entry->segment_index];
+		uint32_t segment_remaining = segment->len - entry->segment_offset;
+		uint8_t* p_data = (uint8_t*) &segment->data[entry->segment_offset];
+		uint32_t len = 0;
+		if(segment_remaining >= MAX_BYTES_PER_TRANSMIT || entry->segment_index + 1 >= entry->number_of_segments) {
+			len = (segment_remaining > MAX_BYTES_PER_TRANSMIT) ? MAX_BYTES_PER_TRANSMIT : segment_remaining;
+		} else {
+			// Gather the portion from the following segments
+			uint8_t index = entry->segment_index;
+			uint32_t offset = entry->segment_offset;
+			while(len < MAX_BYTES_PER_TRANSMIT && index < entry->number_of_segments) {
+				if(offset >= entry->segments[index].len) {
+					index++;
+					offset = 0;
+					continue;
+				}
+				transmit_buf[len++] = entry->segments[index].data[offset++];
+			}
+			p_data = transmit_buf;
+		}
+		
 		// Now send the bytes via bluetooth
-		ret = ble_transmit(transmit_buf, len);
-		if(ret == NRF_SUCCESS) { // If the transmission was successful, we can "consume" the data in the fifo manually
-			tx_fifo.read_pos += len;
-			//timeout_reset(disconnect_timeout_id);
+		ret = ble_transmit(p_data, len);
+		if(ret != NRF_SUCCESS) {
+			// If all buffers are in use, we wait for the next on transmit callback
+			if(ret == NRF_ERROR_BUSY)
+				ret = NRF_SUCCESS;
+			break;
 		}
-	} else {
-		app_timer_stop(transmit_queued_bytes_timer);
-	} 
+		
+		// If the transmission was successful, we can "consume" the bytes of the segments
+		while(len > 0) {
+			uint32_t consumed = entry->segments[entry->segment_index].len - entry->segment_offset;
+			if(consumed > len)
+				consumed = len;
+			entry->segment_offset += consumed;
+			len -= consumed;
+			if(len > 0) {
+				entry->segment_index++;
+				entry->segment_offset = 0;
+			}
+		}
+	}
 	return ret;
 }
 
 
 ret_code_t sender_init(void) {
 	
-	ret_code_t ret = app_fifo_init(&tx_fifo, tx_fifo_buf, sizeof(tx_fifo_buf));
-	if(ret != NRF_SUCCESS) return NRF_ERROR_INTERNAL;
-	
-	ret = app_fifo_init(&rx_fifo, rx_fifo_buf, sizeof(rx_fifo_buf));
+	ret_code_t ret = app_fifo_init(&rx_fifo, rx_fifo_buf, sizeof(rx_fifo_buf));
 	if(ret != NRF_SUCCESS) return NRF_ERROR_INTERNAL;
 	
 	sender_reset();
@@ -201,6 +295,7 @@ ret_code_t sender_init(void) {
 	if(ret != NRF_SUCCESS) return NRF_ERROR_INTERNAL;
 	
 	receive_notification_handler = NULL;
+	disconnect_handler = NULL;
 	ble_set_on_connect_callback(on_connect_callback);
 	ble_set_on_disconnect_callback(on_disconnect_callback);
 	ble_set_on_transmit_callback(on_transmit_callback);
@@ -222,6 +317,10 @@ void sender_set_receive_notification_handler(sender_receive_notification_handler
 	receive_notification_handler = sender_receive_notification_handler;
 }
 
+void sender_set_disconnect_handler(sender_disconnect_handler_t sender_disconnect_handler) {
+	disconnect_handler = sender_disconnect_handler;
+}
+
 uint32_t sender_get_received_data_size(void) {
 	// Read size of rx-fifo:
 	uint32_t available_size = 0;
@@ -256,53 +355,110 @@ ret_code_t sender_await_data(uint8_t* data, uint32_t len, uint32_t timeout_ms) {
 }
 
 uint32_t sender_get_transmit_fifo_size(void) {
-	uint32_t available_size = 0;
-	app_fifo_write(&tx_fifo, NULL, &available_size);
-	
-	return TX_FIFO_SIZE - available_size;
+	uint32_t size = 0;
+	CRITICAL_REGION_ENTER();
+	for(uint8_t i = 0; i < transmit_queue_count; i++) {
+		transmit_entry_t* entry = &transmit_queue[(transmit_queue_read_index + i) % SENDER_TRANSMIT_QUEUE_SIZE];
+		for(uint8_t j = entry->segment_index; j < entry->number_of_segments; j++) {
+			size += entry->segments[j].len;
+		}
+		size -= (entry->segment_index < entry->number_of_segments) ? entry->segment_offset : 0;
+	}
+	CRITICAL_REGION_EXIT();
+	return size;
 }
 
-ret_code_t sender_transmit(const uint8_t* data, uint32_t len, uint32_t timeout_ms) {
+/**@brief Function that actually queues the segments for transmission (see sender_transmit_segments()). 
+ */
+static ret_code_t sender_transmit_segments_internal(const sender_segment_t* segments, uint8_t number_of_segments, sender_transmit_complete_handler_t complete_handler, void* p_context) {
+	if(number_of_segments == 0 || number_of_segments > SENDER_MAX_SEGMENTS)
+		return NRF_ERROR_INVALID_PARAM;
+	
 	if(!connected)
 		return NRF_ERROR_INVALID_STATE;
 	
-	
-	
-	// First check available space in tx-fifo:
-	uint64_t start_ms = systick_get_continuous_millis();
-	uint32_t available_size = 0;
-	// Wait for available space in fifo or timeout
-	do {
-		app_fifo_write(&tx_fifo, NULL, &available_size);
-	} while((len > available_size) && systick_get_continuous_millis() <= start_ms + (uint64_t) timeout_ms);
-	
-	if(len > available_size) 
+	if(transmit_queue_count >= SENDER_TRANSMIT_QUEUE_SIZE)
 		return NRF_ERROR_NO_MEM;
 	
 	// Reset the disconnect timeout timer if we can queue the new packet
 	timeout_reset(disconnect_timeout_id);
 	
-	// If there is enough space in the FIFO, write the data to the FIFO:
-	ret_code_t ret;
+	// Only the main-context inserts entries, so the write index could be calculated outside of the critical region
+	transmit_entry_t* entry = &transmit_queue[(transmit_queue_read_index + transmit_queue_count) % SENDER_TRANSMIT_QUEUE_SIZE];
+	for(uint8_t i = 0; i < number_of_segments; i++)
+		entry->segments[i] = segments[i];
+	entry->number_of_segments = number_of_segments;
+	entry->segment_index = 0;
+	entry->segment_offset = 0;
+	entry->complete_handler = complete_handler;
+	entry->p_context = p_context;
+	
+	uint8_t start_transmitting = 0;
 	CRITICAL_REGION_ENTER();	
 	// This is saved by a critical region because:
-	// when the transmit_queued_bytes() is called via the ble-ISR, and it reads out that no bytes are left in the TX-FIFO, and before setting the transmitting-flag to 0,
-	// the app_fifo_write(&tx_fifo,...)-function is called (only possible in Thread-mode not in normal interrupt-mode), it could happen that the transmit_queued_bytes()
-	// is not called again to start the transmitting for the new insert bytes.
-	ret	= app_fifo_write(&tx_fifo, data, &len);
+	// when the transmit_queued_bytes() is called via the ble-ISR, and it reads out that no entries are left in the queue, and before setting the transmitting-flag to 0,
+	// the entry is inserted (only possible in Thread-mode not in normal interrupt-mode), it could happen that the transmit_queued_bytes()
+	// is not called again to start the transmitting for the new inserted entry.
+	transmit_queue_count++;
+	start_transmitting = !transmitting;
+	transmitting = 1;
 	CRITICAL_REGION_EXIT();
-	if(ret != NRF_SUCCESS) return ret;
 	
-	ret = NRF_SUCCESS;
-	if(!transmitting) {	// Only start the transmit_queued_bytes()-function, if it is not already transmitting the data of the FIFO
-		transmitting = 1;
-		//ret = transmit_queued_bytes();
-		//if(ret != NRF_SUCCESS) return ret;
+	if(start_transmitting) {	// Only start the transmit_queued_bytes()-function, if it is not already transmitting the data of the queue
 		app_timer_start(transmit_queued_bytes_timer, APP_TIMER_TICKS(TRANSMIT_QUEUED_BYTES_PERIOD_MS, 0), NULL);
 	} 
+	return NRF_SUCCESS;
+}
+
+ret_code_t sender_transmit_segments(const sender_segment_t* segments, uint8_t number_of_segments, sender_transmit_complete_handler_t complete_handler, void* p_context) {
+	TRACE_BEGIN(TRACE_EVENT_SENDER_TRANSMIT, (uint16_t) number_of_segments);
+	ret_code_t ret = sender_transmit_segments_internal(segments, number_of_segments, complete_handler, p_context);
+	TRACE_END(TRACE_EVENT_SENDER_TRANSMIT, (uint16_t) ret);
 	return ret;
 }
 
+/**@brief Complete handler of the transmit of sender_transmit(). */
+static void blocking_transmit_complete_handler(ret_code_t status, void* p_context) {
+	blocking_transmit_status = status;
+	blocking_transmit_done = 1;
+}
+
+ret_code_t sender_transmit(const uint8_t* data, uint32_t len, uint32_t timeout_ms) {
+	if(!connected)
+		return NRF_ERROR_INVALID_STATE;
+	
+	if(len == 0)
+		return NRF_SUCCESS;
+	
+	sender_segment_t segment;
+	segment.data = data;
+	segment.len = len;
+	
+	// Wait for a free entry in the transmit queue or timeout
+	uint64_t start_ms = systick_get_continuous_millis();
+	ret_code_t ret;
+	blocking_transmit_done = 0;
+	do {
+		ret = sender_transmit_segments(&segment, 1, blocking_transmit_complete_handler, NULL);
+	} while(ret == NRF_ERROR_NO_MEM && systick_get_continuous_millis() <= start_ms + (uint64_t) timeout_ms);
+	if(ret != NRF_SUCCESS) 
+		return ret;
+	
+	// The data are not copied, so wait until all bytes are handed to the BLE-stack (if the connection drops, the transmit is aborted)
+	while(!blocking_transmit_done && systick_get_continuous_millis() <= start_ms + (uint64_t) timeout_ms) {
+		systick_delay_millis(1);
+	}
+	if(!blocking_transmit_done) {
+		// The caller could release the data after returning --> the remaining bytes must not be transmitted anymore
+		transmit_queue_abort(blocking_transmit_complete_handler, NULL);
+		// The transmit could have been completed before it was aborted
+		if(!blocking_transmit_done)
+			return NRF_ERROR_TIMEOUT;
+	}
+	
+	return blocking_transmit_status;
+}
+
 
 void sender_disconnect(void) {
 	//debug_log("SENDER: sender_disconnect()-called\n");
@@ -15,6 +15,23 @@ typedef struct {
 /**< The on receive notification callback function type. */
 typedef void (*sender_receive_notification_handler_t) (receive_notification_t receive_notification);	
 
+/**< The on disconnect callback function type. */
+typedef void (*sender_disconnect_handler_t) (void);
+
+
+#define SENDER_TRANSMIT_QUEUE_SIZE	2	/**< Number of sender_transmit_segments()-calls that could be queued at the same time */
+#define SENDER_MAX_SEGMENTS			4	/**< Maximum number of segments per sender_transmit_segments()-call */
+
+/**< A segment of a scatter-gather transmit. The data are not copied, so they have to be valid until the complete handler is called. */
+typedef struct {
+	const uint8_t*	data;
+	uint32_t		len;
+} sender_segment_t;
+
+/**< The transmit complete callback function type. status is NRF_SUCCESS if all bytes were handed to the BLE-stack, 
+ *   or NRF_ERROR_INVALID_STATE if the transmit was aborted because of a disconnect. */
+typedef void (*sender_transmit_complete_handler_t) (ret_code_t status, void* p_context);
+
 
 
 /**@brief Function to initialize the sender.
@@ -36,6 +53,12 @@ ret_code_t sender_init(void);
  */
 void sender_set_receive_notification_handler(sender_receive_notification_handler_t sender_receive_notification_handler);
 
+/**@brief Function set the disconnect handler, that should be called when the connection is closed (e.g. to reset per-connection state).
+ *
+ * @param[in] sender_disconnect_handler	The handler that should be called when the connection is closed.
+ */
+void sender_set_disconnect_handler(sender_disconnect_handler_t sender_disconnect_handler);
+
 
 /**@brief Function to retrieve the available bytes in the receive RX-FIFO.
  *
@@ -65,30 +88,49 @@ void sender_get_received_data(uint8_t* data, uint32_t* len);
 ret_code_t sender_await_data(uint8_t* data, uint32_t len, uint32_t timeout_ms);
 
 
-/**@brief Function that returns the number of bytes in the transmit-FIFO.
+/**@brief Function that returns the number of bytes that are queued for transmission, but not yet handed to the BLE-stack.
  *
- * @retval		Number of bytes in the transmit-FIFO.
+ * @retval		Number of queued bytes.
  */
 uint32_t sender_get_transmit_fifo_size(void);
 
-/**@brief Function to transmit bytes via the internal TX-FIFO.
+/**@brief Function to transmit a list of buffer segments (e.g. a length header and an encoded body) without copying them.
  *
- * @details	If the data couldn't be put in the TX-FIFO in timeout_ms milliseconds,
+ * @details	The segments are streamed in place into (20 byte) notifications. Only a notification that crosses
+ *			a segment boundary is gathered in an internal buffer. The transmission is started by an app-timer
+ *			and afterwards driven by the on transmit complete callback of the BLE-stack.
+ *			The segment descriptors are copied, but the data must not be modified or released until the 
+ *			complete handler is called. The complete handler is called in interrupt context.
+ *
+ * @param[in] 	segments			Pointer to the segments that should be sent.
+ * @param[in] 	number_of_segments	Number of segments (1 to SENDER_MAX_SEGMENTS).
+ * @param[in] 	complete_handler	Handler that is called when all bytes were handed to the BLE-stack or when the transmit was aborted (could be NULL).
+ * @param[in] 	p_context			Context that is passed to the complete handler.
+ *
+ * @retval		NRF_SUCCESS					If the segments were queued for transmission.
+ * @retval		NRF_ERROR_INVALID_PARAM		If number_of_segments is 0 or larger than SENDER_MAX_SEGMENTS.
+ * @retval		NRF_ERROR_INVALID_STATE		If there is no alive BLE-connection.
+ * @retval		NRF_ERROR_NO_MEM			If the transmit queue is full (SENDER_TRANSMIT_QUEUE_SIZE).
+ */
+ret_code_t sender_transmit_segments(const sender_segment_t* segments, uint8_t number_of_segments, sender_transmit_complete_handler_t complete_handler, void* p_context);
+
+/**@brief Function to transmit bytes in blocking mode.
+ *
+ * @details	If the data couldn't be queued in timeout_ms milliseconds,
  *			this function returns NRF_ERROR_NO_MEM.
- *			Internally, an app-timer is used to send the queued bytes in the FIFO.
- *			This timer periodically calls (every TRANSMIT_QUEUED_BYTES_PERIOD_MS) 
- *			the (20 byte) ble-transmitting function,
- *			to transmit the bytes (probably it would return that it couldn't send the
- *			bytes currently, but the timer holds with trying).
+ *			Internally, sender_transmit_segments() is used, so this function waits
+ *			until all bytes were handed to the BLE-stack (the data are not copied).
+ *			If that does not happen within timeout_ms milliseconds (from the call of this function), 
+ *			the transmit is aborted and this function returns NRF_ERROR_TIMEOUT (the bytes could be transmitted partially).
  *
  * @param[in] 	data		Pointer to data that should be sent.
- * @param[in] 	len			Number of bytes to read.
- * @param[in] 	timeout_ms	The timeout in milliseconds.
+ * @param[in] 	len			Number of bytes to send.
+ * @param[in] 	timeout_ms	The timeout in milliseconds to queue and hand over all the bytes to the BLE-stack.
  *
- * @retval		NRF_SUCCESS					If len bytes have been read from the FIFO.
- * @retval		NRF_ERROR_INVALID_STATE		If there is no alive BLE-connection.
- * @retval		NRF_ERROR_NO_MEM			If a timeout occured.
- * @retval		Another error code generated by the ble-stack.
+ * @retval		NRF_SUCCESS					If len bytes have been handed to the BLE-stack.
+ * @retval		NRF_ERROR_INVALID_STATE		If there is no alive BLE-connection, or the connection was lost during the transmit.
+ * @retval		NRF_ERROR_NO_MEM			If the data couldn't be queued within the timeout.
+ * @retval		NRF_ERROR_TIMEOUT			If the bytes couldn't be handed to the BLE-stack within the timeout.
  */
 ret_code_t sender_transmit(const uint8_t* data, uint32_t len, uint32_t timeout_ms);
 
@@ -13,7 +13,7 @@ typedef uint32_t 	(*storage_get_unit_size_function_t)(void);
 typedef ret_code_t 	(*storage_clear_function_t)(uint32_t address, uint32_t length);
 
 
-#ifdef UNIT_TEST	// Because currently the unit-tests are written for this configuration. But for an efficient filesystem (because of SWAP_PAGE) we need the EEPROM as first storage-module
+#if defined(UNIT_TEST) && !defined(BADGE_SIM)	// Because currently the unit-tests are written for this configuration. But for an efficient filesystem (because of SWAP_PAGE) we need the EEPROM as first storage-module (like the simulators)
 storage_init_function_t 			storage_init_functions[] 			= {storage1_init, 			storage2_init};
 storage_read_function_t 			storage_read_functions[] 			= {storage1_read, 			storage2_read};
 storage_store_function_t 			storage_store_functions[]			= {storage1_store, 			storage2_store};
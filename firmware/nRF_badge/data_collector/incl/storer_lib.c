@@ -10,12 +10,16 @@
 
 #define STORER_SERIALIZED_BUFFER_SIZE				512
 
+#if DOWNLOAD_CURSOR_PARTITIONS != STORER_NUMBER_OF_CHUNK_PARTITIONS
+#error "DOWNLOAD_CURSOR_PARTITIONS has to be equal to STORER_NUMBER_OF_CHUNK_PARTITIONS"
+#endif
 
 
 
 static uint8_t serialized_buf[STORER_SERIALIZED_BUFFER_SIZE];
 
 static uint16_t partition_id_badge_assignement;
+static uint16_t partition_id_download_cursors;
 static uint16_t partition_id_battery_chunks;
 static uint16_t partition_id_microphone_chunks;
 static uint16_t partition_id_scan_chunks;
@@ -28,6 +32,8 @@ static uint8_t scan_chunks_found_timestamp = 0;
 static uint8_t battery_chunks_found_timestamp = 0;
 static uint8_t accelerometer_interrupt_chunks_found_timestamp = 0;
 static uint8_t accelerometer_chunks_found_timestamp = 0;
+
+static DownloadCursorTable download_cursor_table;	/**< Copy of the latest stored download cursors (the most recently stored hub first) */
 /*
 
 
@@ -36,6 +42,36 @@ static uint16_t partition_id_accelerometer_interrupts;
 */
 
 
+/**@brief Function to read the latest stored download cursor table into download_cursor_table.
+ *
+ * @retval NRF_ERROR_INTERNAL		Busy.
+ * @retval NRF_ERROR_INVALID_STATE	Iterator invalidated/no data found.
+ * @retval NRF_ERROR_INVALID_DATA	If the CRC does not match or decoding fails.
+ * @retval NRF_SUCCESS				If everything was fine.
+ */
+static ret_code_t read_download_cursor_table(void) {
+	memset(&download_cursor_table, 0, sizeof(download_cursor_table));
+	ret_code_t ret = filesystem_iterator_init(partition_id_download_cursors); // Get the latest stored table
+	if(ret != NRF_SUCCESS) {
+		filesystem_iterator_invalidate(partition_id_download_cursors);
+		return ret;
+	}
+	uint16_t element_len, record_id;
+	ret = filesystem_iterator_read_element(partition_id_download_cursors, serialized_buf, sizeof(serialized_buf), &element_len, &record_id);
+	filesystem_iterator_invalidate(partition_id_download_cursors);
+	
+	if(ret != NRF_SUCCESS) return ret;
+	
+	tb_istream_t istream = tb_istream_from_buffer(serialized_buf, element_len);
+	uint8_t decode_status = DownloadCursorTable_decode(&istream, &download_cursor_table, TB_LITTLE_ENDIAN);
+	if(!decode_status) {
+		memset(&download_cursor_table, 0, sizeof(download_cursor_table));
+		return NRF_ERROR_INVALID_DATA;
+	}
+	
+	return NRF_SUCCESS;
+}
+
 /**@brief Function that registers all needed partitions to the filesystem.
  *
  * @retval		NRF_SUCCESS 				If operation was successful.
@@ -97,6 +133,19 @@ ret_code_t storer_register_partitions(void) {
 	// Register a static partition with CRC for the accelerometer-data	
 	ret = filesystem_register_partition(&partition_id_accelerometer_chunks, &required_size, 0, 1, serialized_accelerometer_data_len);
 	if(ret != NRF_SUCCESS) return ret;
+	//debug_log("STORER: Available size: %u\n", filesystem_get_available_size());
+	
+	/******************* DOWNLOAD CURSORS **********************/
+	// Registered last, so that the partitions above keep the flash/EEPROM addresses of badges without download cursors
+	uint32_t serialized_download_cursor_table_len = tb_get_max_encoded_len(DownloadCursorTable_fields);
+	// Required size for the download cursors
+	required_size = PARTITION_METADATA_SIZE + STORER_DOWNLOAD_CURSORS_NUMBER*(serialized_download_cursor_table_len + PARTITION_ELEMENT_HEADER_RECORD_ID_SIZE + PARTITION_ELEMENT_HEADER_ELEMENT_CRC_SIZE);
+	// Register a static partition with CRC for the download cursors (each element is the whole table)
+	ret = filesystem_register_partition(&partition_id_download_cursors, &required_size, 0, 1, serialized_download_cursor_table_len);
+	if(ret != NRF_SUCCESS) return ret;	
+	// Only an internal error is a registration error (no or corrupted data just mean that there are no download cursors)
+	ret = read_download_cursor_table();
+	if(ret == NRF_ERROR_INTERNAL) return ret;
 	debug_log("STORER: Available size: %u\n", filesystem_get_available_size());
 	
 	
@@ -118,6 +167,10 @@ ret_code_t storer_clear(void) {
 	ret_code_t ret = filesystem_clear_partition(partition_id_badge_assignement);
 	if(ret != NRF_SUCCESS) return ret;
 	
+	ret = filesystem_clear_partition(partition_id_download_cursors);
+	if(ret != NRF_SUCCESS) return ret;
+	memset(&download_cursor_table, 0, sizeof(download_cursor_table));
+	
 	ret = filesystem_clear_partition(partition_id_battery_chunks);
 	if(ret != NRF_SUCCESS) return ret;
 	
@@ -156,7 +209,7 @@ ret_code_t storer_clear_badge_assignement(void) {
 
 ret_code_t storer_store_badge_assignement(BadgeAssignement* badge_assignement) {
 	tb_ostream_t ostream = tb_ostream_from_buffer(serialized_buf, sizeof(serialized_buf));
-	uint8_t encode_status = tb_encode(&ostream, BadgeAssignement_fields, badge_assignement, TB_LITTLE_ENDIAN);
+	uint8_t encode_status = BadgeAssignement_encode(&ostream, badge_assignement, TB_LITTLE_ENDIAN);
 	if(!encode_status) return NRF_ERROR_INVALID_DATA;
 	
 	return filesystem_store_element(partition_id_badge_assignement, serialized_buf, ostream.bytes_written);
@@ -171,13 +224,13 @@ ret_code_t storer_read_badge_assignement(BadgeAssignement* badge_assignement) {
 		return ret;
 	}
 	uint16_t element_len, record_id;
-	ret = filesystem_iterator_read_element(partition_id_badge_assignement, serialized_buf, &element_len, &record_id);
+	ret = filesystem_iterator_read_element(partition_id_badge_assignement, serialized_buf, sizeof(serialized_buf), &element_len, &record_id);
 	filesystem_iterator_invalidate(partition_id_badge_assignement);
 	
 	if(ret != NRF_SUCCESS) return ret;
 	
 	tb_istream_t istream = tb_istream_from_buffer(serialized_buf, element_len);
-	uint8_t decode_status = tb_decode(&istream, BadgeAssignement_fields, badge_assignement, TB_LITTLE_ENDIAN);
+	uint8_t decode_status = BadgeAssignement_decode(&istream, badge_assignement, TB_LITTLE_ENDIAN);
 	if(!decode_status) return NRF_ERROR_INVALID_DATA;
 
 	return NRF_SUCCESS;
@@ -185,23 +238,78 @@ ret_code_t storer_read_badge_assignement(BadgeAssignement* badge_assignement) {
 
 
 
+ret_code_t storer_get_download_cursor(uint16_t hub_id, uint16_t record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS]) {
+	for(uint8_t i = 0; i < download_cursor_table.download_cursors_count; i++) {
+		if(download_cursor_table.download_cursors[i].hub_id == hub_id) {
+			memcpy(record_ids, download_cursor_table.download_cursors[i].record_ids, sizeof(download_cursor_table.download_cursors[i].record_ids));
+			return NRF_SUCCESS;
+		}
+	}
+	return NRF_ERROR_NOT_FOUND;
+}
+
+ret_code_t storer_store_download_cursor(uint16_t hub_id, const uint16_t record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS]) {
+	// Search the hub in the table (if it is not in the table, the least recently stored hub at the end is replaced)
+	uint8_t index = 0;
+	while(index < download_cursor_table.download_cursors_count && download_cursor_table.download_cursors[index].hub_id != hub_id)
+		index++;
+	
+	if(index < download_cursor_table.download_cursors_count && index == 0 &&
+	   memcmp(download_cursor_table.download_cursors[0].record_ids, record_ids, sizeof(download_cursor_table.download_cursors[0].record_ids)) == 0) {
+		return NRF_SUCCESS;	// Nothing has changed --> don't write to the storage
+	}
+	
+	DownloadCursorTable table = download_cursor_table;
+	if(index >= DOWNLOAD_CURSOR_TABLE_SIZE) {
+		index = DOWNLOAD_CURSOR_TABLE_SIZE - 1;
+	} else if(index >= table.download_cursors_count) {
+		table.download_cursors_count++;
+	}
+	// Move the entries in front of the hub one position back, and put the hub at the first position
+	memmove(&table.download_cursors[1], &table.download_cursors[0], index*sizeof(DownloadCursor));
+	table.download_cursors[0].hub_id = hub_id;
+	memcpy(table.download_cursors[0].record_ids, record_ids, sizeof(table.download_cursors[0].record_ids));
+	
+	// The partition is static, so the encoded table is zero-padded to its maximum length
+	uint32_t serialized_download_cursor_table_len = tb_get_max_encoded_len(DownloadCursorTable_fields);
+	memset(serialized_buf, 0, serialized_download_cursor_table_len);
+	tb_ostream_t ostream = tb_ostream_from_buffer(serialized_buf, sizeof(serialized_buf));
+	uint8_t encode_status = DownloadCursorTable_encode(&ostream, &table, TB_LITTLE_ENDIAN);
+	if(!encode_status) return NRF_ERROR_INVALID_DATA;
+	
+	ret_code_t ret = filesystem_store_element(partition_id_download_cursors, serialized_buf, serialized_download_cursor_table_len);
+	if(ret != NRF_SUCCESS) return ret;
+	
+	// Only update the RAM copy, if the table was stored successfully
+	download_cursor_table = table;
+	return NRF_SUCCESS;
+}
+
+
+
 /**@brief Function to store a chunk of data in a partition.
+ *
+ * @details The chunk has to be encoded into serialized_buf with its generated straight-line encode function before
+ *			(e.g. BatteryChunk_encode() with an ostream from store_chunk_ostream()).
  *
  * @param[in]	partition_id	The partition_id where to store the chunk.
- * @param[in]	message_fields	The message fields need to encode the message-chunk with tinybuf.
- * @param[in]	message			Pointer to the message-chunk that should be encoded and stored.
+ * @param[in]	encode_status	The return value of the encode function of the message-chunk.
+ * @param[in]	ostream			Pointer to the ostream the message-chunk was encoded with.
  * 
  * @retval NRF_ERROR_NO_MEM			If the element is too big, to be stored in the partition.
  * @retval NRF_ERROR_INTERNAL		Busy or iterator is pointing to the same address we want to write to.
  * @retval NRF_ERROR_INVALID_DATA	If encoding fails.
  * @retval NRF_SUCCESS				If everything was fine.
  */
-ret_code_t store_chunk(uint16_t partition_id, const tb_field_t message_fields[], void* message) {
-	tb_ostream_t ostream = tb_ostream_from_buffer(serialized_buf, sizeof(serialized_buf));
-	uint8_t encode_status = tb_encode(&ostream, message_fields, message, TB_LITTLE_ENDIAN);
+static ret_code_t store_chunk(uint16_t partition_id, uint8_t encode_status, const tb_ostream_t* ostream) {
 	if(!encode_status) return NRF_ERROR_INVALID_DATA;
 
-	return filesystem_store_element(partition_id, serialized_buf, ostream.bytes_written);
+	return filesystem_store_element(partition_id, serialized_buf, ostream->bytes_written);
+}
+
+/**@brief Function to create the ostream to encode a chunk into serialized_buf (before it is stored with store_chunk()). */
+static tb_ostream_t store_chunk_ostream(void) {
+	return tb_ostream_from_buffer(serialized_buf, sizeof(serialized_buf));
 }
 
 
@@ -212,18 +320,18 @@ ret_code_t store_chunk(uint16_t partition_id, const tb_field_t message_fields[],
  *			that is still greater than the timestamp. It uses the iterator of the partition
  *			to step back.
  *
+ *			Every chunk starts with its Timestamp, so only this leading Timestamp is decoded
+ *			from each element (the rest of the chunk is never decoded while stepping back).
+ *
  * @param[in]	timestamp			The timestamp since when the data should be requested.
  * @param[in]	partition_id		The partition_id where to search the chunk.
- * @param[in]	message_fields		The message fields need to decode the message-chunk with tinybuf.
- * @param[out]	message				Pointer to a message-chunk (needed for internal decoding).
- * @param[out]	message_timestamp	Pointer to the timestamp entry in the message-chunk.
  * @param[out]	found_timestamp		Pointer to a flag-variable that expresses, if an "old" element with a greater timestamp was found.
  * 
  * @retval NRF_ERROR_INTERNAL		Busy
  * @retval NRF_ERROR_INVALID_STATE	Iterator invalidated/no data found.
  * @retval NRF_SUCCESS				If everything was fine.
  */
-static ret_code_t find_chunk_from_timestamp(Timestamp timestamp, uint16_t partition_id, const tb_field_t message_fields[], void* message, Timestamp* message_timestamp, uint8_t* found_timestamp) {
+static ret_code_t find_chunk_from_timestamp(Timestamp timestamp, uint16_t partition_id, uint8_t* found_timestamp) {
 	
 	*found_timestamp = 0;
 	
@@ -237,7 +345,7 @@ static ret_code_t find_chunk_from_timestamp(Timestamp timestamp, uint16_t partit
 	
 	while(1) {		
 		uint16_t element_len, record_id;
-		ret = filesystem_iterator_read_element(partition_id, serialized_buf, &element_len, &record_id);
+		ret = filesystem_iterator_read_element(partition_id, serialized_buf, sizeof(serialized_buf), &element_len, &record_id);
 		// ret could be NRF_SUCCESS, NRF_ERROR_INVALID_DATA, NRF_ERROR_INVALID_STATE, NRF_ERROR_INTERNAL
 		if(!(ret == NRF_ERROR_INVALID_DATA || ret == NRF_SUCCESS)) {
 			filesystem_iterator_invalidate(partition_id);
@@ -246,11 +354,12 @@ static ret_code_t find_chunk_from_timestamp(Timestamp timestamp, uint16_t partit
 
 		if(ret == NRF_SUCCESS) { // Only try to decode when the data are not corrupted (NRF_ERROR_INVALID_DATA)
 
-			// Decode the current element
+			// Decode only the timestamp at the beginning of the current element
+			Timestamp message_timestamp;
 			tb_istream_t istream = tb_istream_from_buffer(serialized_buf, element_len);
-			uint8_t decode_status = tb_decode(&istream, message_fields, message, TB_LITTLE_ENDIAN);
+			uint8_t decode_status = Timestamp_decode(&istream, &message_timestamp, TB_LITTLE_ENDIAN);
 			if(decode_status) {	
-				if(storer_compare_timestamps(*message_timestamp, timestamp) == 1) {
+				if(storer_compare_timestamps(message_timestamp, timestamp) == 1) {
 					// We have found the timestamp --> we need to go to the next again
 					ret = filesystem_iterator_next(partition_id);
 					// ret could be NRF_SUCCESS, NRF_ERROR_NOT_FOUND, NRF_ERROR_INVALID_STATE, NRF_ERROR_INTERNAL
@@ -301,6 +410,7 @@ static ret_code_t find_chunk_from_timestamp(Timestamp timestamp, uint16_t partit
  * @param[in]	message_fields		The message fields need to decode the message-chunk with tinybuf.
  * @param[out]	message				Pointer to a message-chunk where to store the read chunk.
  * @param[in]	found_timestamp		Pointer to a flag-variable that expresses, if an "old" element with a greater timestamp was found.
+ * @param[out]	p_record_id			Pointer where to store the record-id of the read chunk (could be NULL).
  * 
  * @retval	NRF_SUCCESS					If an element was found and returned successfully.
  * @retval	NRF_ERROR_NOT_FOUND			If no more element in the partition.
@@ -309,7 +419,7 @@ static ret_code_t find_chunk_from_timestamp(Timestamp timestamp, uint16_t partit
  *
  * @note 	The application needs to invalidate the iterator, if the function is not used until no more element is found (because it invalidates it then automatically).
  */
-static ret_code_t get_next_chunk(uint16_t partition_id, const tb_field_t message_fields[], void* message, uint8_t* found_timestamp) {
+static ret_code_t get_next_chunk(uint16_t partition_id, const tb_field_t message_fields[], void* message, uint8_t* found_timestamp, uint16_t* p_record_id) {
 	ret_code_t ret;
 	uint16_t element_len, record_id;
 	// do-while-loop to ignore invalid data
@@ -326,7 +436,7 @@ static ret_code_t get_next_chunk(uint16_t partition_id, const tb_field_t message
 		*found_timestamp = 0;	
 		
 		// TODO: What happens if read failed, but we have already done a next-step successfully?
-		ret = filesystem_iterator_read_element(partition_id, serialized_buf, &element_len, &record_id);
+		ret = filesystem_iterator_read_element(partition_id, serialized_buf, sizeof(serialized_buf), &element_len, &record_id);
 		// ret could be NRF_SUCCESS, NRF_ERROR_INVALID_DATA, NRF_ERROR_INVALID_STATE, NRF_ERROR_INTERNAL
 		if(!(ret == NRF_ERROR_INVALID_DATA || ret == NRF_SUCCESS)) {
 			filesystem_iterator_invalidate(partition_id);
@@ -341,11 +451,134 @@ static ret_code_t get_next_chunk(uint16_t partition_id, const tb_field_t message
 		}
 	} while(ret == NRF_ERROR_INVALID_DATA);
 	
+	if(p_record_id != NULL)
+		*p_record_id = record_id;
+	
 	return ret; // Should actually always be NRF_SUCCESS
 }
 
 
 
+/**@brief Function to find a chunk in the partition based on its record-id.
+ *
+ * @details	The iterator is initialized at the latest chunk. Because the record-ids of a partition are consecutive,
+ *			the number of steps back is computed from the record-ids (the 16 bit difference, so wrap-arounds are handled).
+ *			A difference of 0x8000 or more means that the requested record-id is newer than the latest chunk.
+ *
+ * @param[in]		partition_id		The partition_id where to search the chunk.
+ * @param[in]		from_oldest			Flag if the iterator should be set to the oldest chunk (then the input record_id is ignored).
+ * @param[in/out]	record_id			In: the requested record-id. Out: the record-id of the chunk get_next_chunk() returns next.
+ * @param[out]		found_record_id		Pointer to the flag-variable of get_next_chunk() (set, if the iterator points to the chunk to return next).
+ * 
+ * @retval NRF_ERROR_INTERNAL		Busy
+ * @retval NRF_ERROR_INVALID_STATE	Iterator invalidated/no data found.
+ * @retval NRF_SUCCESS				If everything was fine.
+ */
+static ret_code_t find_chunk_from_record_id(uint16_t partition_id, uint8_t from_oldest, uint16_t* record_id, uint8_t* found_record_id) {
+	*found_record_id = 0;
+	
+	ret_code_t ret = filesystem_iterator_init(partition_id);
+	// If there are no data in partition --> directly return
+	if(ret != NRF_SUCCESS) {
+		filesystem_iterator_invalidate(partition_id);
+		return ret;
+	}
+	
+	uint16_t latest_record_id;
+	ret = filesystem_iterator_get_record_id(partition_id, &latest_record_id);
+	if(ret != NRF_SUCCESS) {
+		filesystem_iterator_invalidate(partition_id);
+		return ret;
+	}
+	
+	uint16_t steps = (uint16_t) (latest_record_id - *record_id);
+	if(!from_oldest && steps >= 0x8000) {
+		// The requested chunk is newer than the latest one, so the next chunk will be the next stored one
+		*record_id = (uint16_t) (latest_record_id + 1);
+		return NRF_SUCCESS;
+	}
+	if(from_oldest)
+		steps = 0xFFFF;
+	
+	*record_id = latest_record_id;
+	while(steps > 0) {
+		ret = filesystem_iterator_previous(partition_id);
+		// ret could be NRF_SUCCESS, NRF_ERROR_NOT_FOUND, NRF_ERROR_INVALID_STATE, NRF_ERROR_INTERNAL
+		if(ret == NRF_ERROR_NOT_FOUND)	// We have reached the oldest chunk (the requested one was already overwritten)
+			break;
+		if(ret != NRF_SUCCESS) {
+			filesystem_iterator_invalidate(partition_id);
+			return ret;
+		}
+		(*record_id)--;
+		steps--;
+	}
+	*found_record_id = 1;
+	
+	return NRF_SUCCESS;
+}
+
+/**@brief Function to get the partition_id and the found-flag of a chunk-partition.
+ *
+ * @retval NRF_ERROR_INVALID_PARAM	If the partition does not exist.
+ * @retval NRF_SUCCESS				If everything was fine.
+ */
+static ret_code_t get_chunk_partition(storer_chunk_partition_t partition, uint16_t* partition_id, uint8_t** found_flag) {
+	switch(partition) {
+		case STORER_CHUNK_PARTITION_MICROPHONE:
+			*partition_id = partition_id_microphone_chunks;
+			*found_flag = &microphone_chunks_found_timestamp;
+			break;
+		case STORER_CHUNK_PARTITION_SCAN:
+			*partition_id = partition_id_scan_chunks;
+			*found_flag = &scan_chunks_found_timestamp;
+			break;
+		case STORER_CHUNK_PARTITION_ACCELEROMETER:
+			*partition_id = partition_id_accelerometer_chunks;
+			*found_flag = &accelerometer_chunks_found_timestamp;
+			break;
+		case STORER_CHUNK_PARTITION_ACCELEROMETER_INTERRUPT:
+			*partition_id = partition_id_accelerometer_interrupt_chunks;
+			*found_flag = &accelerometer_interrupt_chunks_found_timestamp;
+			break;
+		case STORER_CHUNK_PARTITION_BATTERY:
+			*partition_id = partition_id_battery_chunks;
+			*found_flag = &battery_chunks_found_timestamp;
+			break;
+		default:
+			return NRF_ERROR_INVALID_PARAM;
+	}
+	return NRF_SUCCESS;
+}
+
+ret_code_t storer_find_chunk_from_record_id(storer_chunk_partition_t partition, uint16_t* record_id) {
+	uint16_t partition_id;
+	uint8_t* found_flag;
+	ret_code_t ret = get_chunk_partition(partition, &partition_id, &found_flag);
+	if(ret != NRF_SUCCESS) return ret;
+	
+	return find_chunk_from_record_id(partition_id, 0, record_id, found_flag);
+}
+
+ret_code_t storer_find_oldest_chunk(storer_chunk_partition_t partition, uint16_t* record_id) {
+	uint16_t partition_id;
+	uint8_t* found_flag;
+	ret_code_t ret = get_chunk_partition(partition, &partition_id, &found_flag);
+	if(ret != NRF_SUCCESS) return ret;
+	
+	return find_chunk_from_record_id(partition_id, 1, record_id, found_flag);
+}
+
+ret_code_t storer_decode_next_chunk(storer_chunk_partition_t partition, const tb_field_t message_fields[], void* message, uint16_t* record_id) {
+	uint16_t partition_id;
+	uint8_t* found_flag;
+	ret_code_t ret = get_chunk_partition(partition, &partition_id, &found_flag);
+	if(ret != NRF_SUCCESS) return ret;
+	
+	return get_next_chunk(partition_id, message_fields, message, found_flag, record_id);
+}
+
+
 void storer_invalidate_iterators(void) {
 	filesystem_iterator_invalidate(partition_id_accelerometer_chunks);
 	filesystem_iterator_invalidate(partition_id_accelerometer_interrupt_chunks);
@@ -356,33 +589,43 @@ void storer_invalidate_iterators(void) {
 
 
 ret_code_t storer_store_accelerometer_chunk(AccelerometerChunk* accelerometer_chunk) {
-	return store_chunk(partition_id_accelerometer_chunks, AccelerometerChunk_fields, accelerometer_chunk);
+	tb_ostream_t ostream = store_chunk_ostream();
+	uint8_t encode_status = AccelerometerChunk_encode(&ostream, accelerometer_chunk, TB_LITTLE_ENDIAN);
+	return store_chunk(partition_id_accelerometer_chunks, encode_status, &ostream);
 }
 
-ret_code_t storer_find_accelerometer_chunk_from_timestamp(Timestamp timestamp, AccelerometerChunk* accelerometer_chunk) {
-	memset(accelerometer_chunk, 0, sizeof(AccelerometerChunk));
-	return find_chunk_from_timestamp(timestamp, partition_id_accelerometer_chunks, AccelerometerChunk_fields, accelerometer_chunk, &(accelerometer_chunk->timestamp), &accelerometer_chunks_found_timestamp);
+ret_code_t storer_find_accelerometer_chunk_from_timestamp(Timestamp timestamp) {
+	return find_chunk_from_timestamp(timestamp, partition_id_accelerometer_chunks, &accelerometer_chunks_found_timestamp);
 }
 
 ret_code_t storer_get_next_accelerometer_chunk(AccelerometerChunk* accelerometer_chunk) {
 	memset(accelerometer_chunk, 0, sizeof(AccelerometerChunk));
-	return get_next_chunk(partition_id_accelerometer_chunks, AccelerometerChunk_fields, accelerometer_chunk, &accelerometer_chunks_found_timestamp);
+	return storer_decode_next_accelerometer_chunk(AccelerometerChunk_fields, accelerometer_chunk);
+}
+
+ret_code_t storer_decode_next_accelerometer_chunk(const tb_field_t message_fields[], void* message) {
+	return get_next_chunk(partition_id_accelerometer_chunks, message_fields, message, &accelerometer_chunks_found_timestamp, NULL);
 }
 
 
 
 ret_code_t storer_store_accelerometer_interrupt_chunk(AccelerometerInterruptChunk* accelerometer_interrupt_chunk) {
-	return store_chunk(partition_id_accelerometer_interrupt_chunks, AccelerometerInterruptChunk_fields, accelerometer_interrupt_chunk);
+	tb_ostream_t ostream = store_chunk_ostream();
+	uint8_t encode_status = AccelerometerInterruptChunk_encode(&ostream, accelerometer_interrupt_chunk, TB_LITTLE_ENDIAN);
+	return store_chunk(partition_id_accelerometer_interrupt_chunks, encode_status, &ostream);
 }
 
-ret_code_t storer_find_accelerometer_interrupt_chunk_from_timestamp(Timestamp timestamp, AccelerometerInterruptChunk* accelerometer_interrupt_chunk) {
-	memset(accelerometer_interrupt_chunk, 0, sizeof(AccelerometerInterruptChunk));
-	return find_chunk_from_timestamp(timestamp, partition_id_accelerometer_interrupt_chunks, AccelerometerInterruptChunk_fields, accelerometer_interrupt_chunk, &(accelerometer_interrupt_chunk->timestamp), &accelerometer_interrupt_chunks_found_timestamp);
+ret_code_t storer_find_accelerometer_interrupt_chunk_from_timestamp(Timestamp timestamp) {
+	return find_chunk_from_timestamp(timestamp, partition_id_accelerometer_interrupt_chunks, &accelerometer_interrupt_chunks_found_timestamp);
 }
 
 ret_code_t storer_get_next_accelerometer_interrupt_chunk(AccelerometerInterruptChunk* accelerometer_interrupt_chunk) {
 	memset(accelerometer_interrupt_chunk, 0, sizeof(AccelerometerInterruptChunk));
-	return get_next_chunk(partition_id_accelerometer_interrupt_chunks, AccelerometerInterruptChunk_fields, accelerometer_interrupt_chunk, &accelerometer_interrupt_chunks_found_timestamp);
+	return storer_decode_next_accelerometer_interrupt_chunk(AccelerometerInterruptChunk_fields, accelerometer_interrupt_chunk);
+}
+
+ret_code_t storer_decode_next_accelerometer_interrupt_chunk(const tb_field_t message_fields[], void* message) {
+	return get_next_chunk(partition_id_accelerometer_interrupt_chunks, message_fields, message, &accelerometer_interrupt_chunks_found_timestamp, NULL);
 }
 
 
@@ -392,17 +635,22 @@ ret_code_t storer_get_next_accelerometer_interrupt_chunk(AccelerometerInterruptC
 
 
 ret_code_t storer_store_battery_chunk(BatteryChunk* battery_chunk) {
-	return store_chunk(partition_id_battery_chunks, BatteryChunk_fields, battery_chunk);
+	tb_ostream_t ostream = store_chunk_ostream();
+	uint8_t encode_status = BatteryChunk_encode(&ostream, battery_chunk, TB_LITTLE_ENDIAN);
+	return store_chunk(partition_id_battery_chunks, encode_status, &ostream);
 }
 
-ret_code_t storer_find_battery_chunk_from_timestamp(Timestamp timestamp, BatteryChunk* battery_chunk) {
-	memset(battery_chunk, 0, sizeof(BatteryChunk));
-	return find_chunk_from_timestamp(timestamp, partition_id_battery_chunks, BatteryChunk_fields, battery_chunk, &(battery_chunk->timestamp), &battery_chunks_found_timestamp);
+ret_code_t storer_find_battery_chunk_from_timestamp(Timestamp timestamp) {
+	return find_chunk_from_timestamp(timestamp, partition_id_battery_chunks, &battery_chunks_found_timestamp);
 }
 
 ret_code_t storer_get_next_battery_chunk(BatteryChunk* battery_chunk) {
 	memset(battery_chunk, 0, sizeof(BatteryChunk));
-	return get_next_chunk(partition_id_battery_chunks, BatteryChunk_fields, battery_chunk, &battery_chunks_found_timestamp);
+	return storer_decode_next_battery_chunk(BatteryChunk_fields, battery_chunk);
+}
+
+ret_code_t storer_decode_next_battery_chunk(const tb_field_t message_fields[], void* message) {
+	return get_next_chunk(partition_id_battery_chunks, message_fields, message, &battery_chunks_found_timestamp, NULL);
 }
 
 
@@ -410,31 +658,49 @@ ret_code_t storer_get_next_battery_chunk(BatteryChunk* battery_chunk) {
 
 
 ret_code_t storer_store_scan_chunk(ScanChunk* scan_chunk) {
-	return store_chunk(partition_id_scan_chunks, ScanChunk_fields, scan_chunk);
+	tb_ostream_t ostream = store_chunk_ostream();
+	uint8_t encode_status = ScanChunk_encode(&ostream, scan_chunk, TB_LITTLE_ENDIAN);
+	return store_chunk(partition_id_scan_chunks, encode_status, &ostream);
 }
 
-ret_code_t storer_find_scan_chunk_from_timestamp(Timestamp timestamp, ScanChunk* scan_chunk) {
-	memset(scan_chunk, 0, sizeof(ScanChunk));
-	return find_chunk_from_timestamp(timestamp, partition_id_scan_chunks, ScanChunk_fields, scan_chunk, &(scan_chunk->timestamp), &scan_chunks_found_timestamp);
+ret_code_t storer_store_scan_sampling_chunk(ScanSamplingChunk* scan_sampling_chunk) {
+	if(scan_sampling_chunk->scan_result_data_count > SCAN_CHUNK_DATA_SIZE) return NRF_ERROR_INVALID_PARAM;
+	// With at most SCAN_CHUNK_DATA_SIZE entries the encoded ScanSamplingChunk is byte-identical to the encoded ScanChunk
+	tb_ostream_t ostream = store_chunk_ostream();
+	uint8_t encode_status = ScanSamplingChunk_encode(&ostream, scan_sampling_chunk, TB_LITTLE_ENDIAN);
+	return store_chunk(partition_id_scan_chunks, encode_status, &ostream);
+}
+
+ret_code_t storer_find_scan_chunk_from_timestamp(Timestamp timestamp) {
+	return find_chunk_from_timestamp(timestamp, partition_id_scan_chunks, &scan_chunks_found_timestamp);
 }
 
 ret_code_t storer_get_next_scan_chunk(ScanChunk* scan_chunk) {
 	memset(scan_chunk, 0, sizeof(ScanChunk));
-	return get_next_chunk(partition_id_scan_chunks, ScanChunk_fields, scan_chunk, &scan_chunks_found_timestamp);
+	return storer_decode_next_scan_chunk(ScanChunk_fields, scan_chunk);
+}
+
+ret_code_t storer_decode_next_scan_chunk(const tb_field_t message_fields[], void* message) {
+	return get_next_chunk(partition_id_scan_chunks, message_fields, message, &scan_chunks_found_timestamp, NULL);
 }
 
 
 
 ret_code_t storer_store_microphone_chunk(MicrophoneChunk* microphone_chunk) {
-	return store_chunk(partition_id_microphone_chunks, MicrophoneChunk_fields, microphone_chunk);
+	tb_ostream_t ostream = store_chunk_ostream();
+	uint8_t encode_status = MicrophoneChunk_encode(&ostream, microphone_chunk, TB_LITTLE_ENDIAN);
+	return store_chunk(partition_id_microphone_chunks, encode_status, &ostream);
 }
 
-ret_code_t storer_find_microphone_chunk_from_timestamp(Timestamp timestamp, MicrophoneChunk* microphone_chunk) {
-	memset(microphone_chunk, 0, sizeof(MicrophoneChunk));
-	return find_chunk_from_timestamp(timestamp, partition_id_microphone_chunks, MicrophoneChunk_fields, microphone_chunk, &(microphone_chunk->timestamp), &microphone_chunks_found_timestamp);
+ret_code_t storer_find_microphone_chunk_from_timestamp(Timestamp timestamp) {
+	return find_chunk_from_timestamp(timestamp, partition_id_microphone_chunks, &microphone_chunks_found_timestamp);
 }
 
 ret_code_t storer_get_next_microphone_chunk(MicrophoneChunk* microphone_chunk) {
 	memset(microphone_chunk, 0, sizeof(MicrophoneChunk));
-	return get_next_chunk(partition_id_microphone_chunks, MicrophoneChunk_fields, microphone_chunk, &microphone_chunks_found_timestamp);
+	return storer_decode_next_microphone_chunk(MicrophoneChunk_fields, microphone_chunk);
+}
+
+ret_code_t storer_decode_next_microphone_chunk(const tb_field_t message_fields[], void* message) {
+	return get_next_chunk(partition_id_microphone_chunks, message_fields, message, &microphone_chunks_found_timestamp, NULL);
 }
@@ -6,13 +6,30 @@
 
 /**< The number of entries in each partition (can be adopted on the user's needs) */ 
 #define STORER_BADGE_ASSIGNEMENT_NUMBER				1
+#define STORER_DOWNLOAD_CURSORS_NUMBER				10
 #define STORER_BATTERY_DATA_NUMBER					100
 #define STORER_MICROPHONE_DATA_NUMBER				1340
+#if defined(UNIT_TEST) && !defined(BADGE_SIM)	// The unit tests have a smaller flash (see flash_lib.h), so that all partitions only fit with less scan-data
+#define STORER_SCAN_DATA_NUMBER						760
+#else
 #define STORER_SCAN_DATA_NUMBER						960
+#endif
 #define STORER_ACCELEROMETER_INTERRUPT_DATA_NUMBER	50
 #define STORER_ACCELEROMETER_DATA_NUMBER			50
 
 
+/**< The chunk-partitions that could be accessed via their record-ids (e.g. for a bulk export) */
+typedef enum {
+	STORER_CHUNK_PARTITION_MICROPHONE				= 0,
+	STORER_CHUNK_PARTITION_SCAN						= 1,
+	STORER_CHUNK_PARTITION_ACCELEROMETER			= 2,
+	STORER_CHUNK_PARTITION_ACCELEROMETER_INTERRUPT	= 3,
+	STORER_CHUNK_PARTITION_BATTERY					= 4,
+} storer_chunk_partition_t;
+
+#define STORER_NUMBER_OF_CHUNK_PARTITIONS			5
+
+
 /**@brief Function to initialize the storer-module.
  * @details It initializes the filesystem and registers all the needed partitions. 
  *			You can change the above values for the number of chunks stored in the filesystem.
@@ -61,6 +78,32 @@ ret_code_t storer_store_badge_assignement(BadgeAssignement* badge_assignement);
 ret_code_t storer_read_badge_assignement(BadgeAssignement* badge_assignement);
 
 
+/**@brief Function to get the download cursor of a hub.
+ * @details The download cursors of the last DOWNLOAD_CURSOR_TABLE_SIZE hubs are kept in their own partition,
+ *			and a copy is kept in RAM (loaded in storer_init()).
+ *
+ * @param[in]	hub_id			The identifier of the hub.
+ * @param[out]	record_ids		The record-ids of the next chunks to download for each chunk-partition (storer_chunk_partition_t).
+ *
+ * @retval NRF_ERROR_NOT_FOUND		If there is no download cursor for the hub.
+ * @retval NRF_SUCCESS				If everything was fine.
+ */
+ret_code_t storer_get_download_cursor(uint16_t hub_id, uint16_t record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS]);
+
+/**@brief Function to store the download cursor of a hub (e.g. after the hub acknowledged the received chunks).
+ * @details If the table is full, the cursor of the least recently stored hub is replaced.
+ *			If the cursor has not changed, nothing is written to the storage.
+ *
+ * @param[in]	hub_id			The identifier of the hub.
+ * @param[in]	record_ids		The record-ids of the next chunks to download for each chunk-partition (storer_chunk_partition_t).
+ *
+ * @retval NRF_ERROR_INTERNAL		Busy.
+ * @retval NRF_ERROR_INVALID_DATA	If encoding fails.
+ * @retval NRF_SUCCESS				If everything was fine.
+ */
+ret_code_t storer_store_download_cursor(uint16_t hub_id, const uint16_t record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS]);
+
+
 /**@brief Function to invalidate all iterators of the chunk-partitions.
  * @note  This function has to be called when the application can't 
  * 		  call the get_next_..._chunk()-function anymore (e.g. because of disconnect),
@@ -70,6 +113,53 @@ ret_code_t storer_read_badge_assignement(BadgeAssignement* badge_assignement);
 void storer_invalidate_iterators(void);
 
 
+/**@brief Function to find a chunk from its record-id and set the iterator of the partition.
+ * @details	The record-ids of the chunks in a partition are consecutive, so only the element-headers are read while stepping back 
+ *			(no data are read or decoded). Afterwards storer_decode_next_chunk() returns the chunk with the record-id.
+ *			If the chunk was already overwritten, the iterator is set to the oldest chunk of the partition.
+ *			If the record-id is newer than the latest chunk (e.g. the latest record-id + 1), storer_decode_next_chunk() 
+ *			will return NRF_ERROR_NOT_FOUND (except new chunks were stored since then).
+ *
+ * @param[in]		partition	The chunk-partition.
+ * @param[in/out]	record_id	In: the record-id of the chunk that should be returned next. 
+ *								Out: the record-id of the chunk that is actually returned next (differs if the chunk was already overwritten).
+ *
+ * @retval NRF_ERROR_INVALID_PARAM	If the partition does not exist.
+ * @retval NRF_ERROR_INTERNAL		Busy.
+ * @retval NRF_ERROR_INVALID_STATE	Iterator invalidated/no data found.
+ * @retval NRF_SUCCESS				If everything was fine.
+ */
+ret_code_t storer_find_chunk_from_record_id(storer_chunk_partition_t partition, uint16_t* record_id);
+
+/**@brief Function to set the iterator of the partition to the oldest chunk.
+ *
+ * @param[in]		partition	The chunk-partition.
+ * @param[out]		record_id	The record-id of the oldest chunk.
+ *
+ * @retval NRF_ERROR_INVALID_PARAM	If the partition does not exist.
+ * @retval NRF_ERROR_INTERNAL		Busy.
+ * @retval NRF_ERROR_INVALID_STATE	Iterator invalidated/no data found.
+ * @retval NRF_SUCCESS				If everything was fine.
+ */
+ret_code_t storer_find_oldest_chunk(storer_chunk_partition_t partition, uint16_t* record_id);
+
+/**@brief Function to get the next chunk of a partition and decode it directly into a caller provided structure, together with its record-id.
+ * @details The message_fields have to describe the encoded chunk of the partition (see e.g. storer_decode_next_microphone_chunk()).
+ *
+ * @param[in]	partition		The chunk-partition.
+ * @param[in]	message_fields	The message fields needed to decode the chunk.
+ * @param[out]	message			Pointer to the structure where to decode the chunk to.
+ * @param[out]	record_id		Pointer to memory where the record-id of the chunk should be stored to.
+ *
+ * @retval	NRF_SUCCESS					If an element was found and returned successfully.
+ * @retval	NRF_ERROR_NOT_FOUND			If no more element in the partition.
+ * @retval	NRF_ERROR_INVALID_STATE		If iterator not initialized or invalidated.
+ * @retval	NRF_ERROR_INVALID_PARAM		If the partition does not exist.
+ * @retval	NRF_ERROR_INTERNAL			If busy.
+ */
+ret_code_t storer_decode_next_chunk(storer_chunk_partition_t partition, const tb_field_t message_fields[], void* message, uint16_t* record_id);
+
+
 
 
 
@@ -86,7 +176,7 @@ ret_code_t storer_store_accelerometer_chunk(AccelerometerChunk* accelerometer_ch
  * @retval NRF_ERROR_INVALID_STATE	Iterator invalidated/no data found.
  * @retval NRF_SUCCESS				If everything was fine.
  */
-ret_code_t storer_find_accelerometer_chunk_from_timestamp(Timestamp timestamp, AccelerometerChunk* accelerometer_chunk);
+ret_code_t storer_find_accelerometer_chunk_from_timestamp(Timestamp timestamp);
 
 /**@brief Function to get the next accelerometer chunk from the iterator of the partition. (For detailed description: get_next_chunk())
  * @retval	NRF_SUCCESS					If an element was found and returned successfully.
@@ -96,6 +186,16 @@ ret_code_t storer_find_accelerometer_chunk_from_timestamp(Timestamp timestamp, A
  */
 ret_code_t storer_get_next_accelerometer_chunk(AccelerometerChunk* accelerometer_chunk);
 
+/**@brief Function to get the next accelerometer chunk and decode it directly into a caller provided structure (e.g. a response message).
+ * @details The message_fields have to describe the encoded AccelerometerChunk, e.g. the fields of a data response without its leading field
+ *			(&AccelerometerDataResponse_fields[1]). So the chunk can be decoded without an intermediate AccelerometerChunk-structure.
+ * @retval	NRF_SUCCESS					If an element was found and returned successfully.
+ * @retval	NRF_ERROR_NOT_FOUND			If no more element in the partition.
+ * @retval	NRF_ERROR_INVALID_STATE		If iterator not initialized or invalidated.
+ * @retval	NRF_ERROR_INTERNAL			If busy.
+ */
+ret_code_t storer_decode_next_accelerometer_chunk(const tb_field_t message_fields[], void* message);
+
 
 
 
@@ -114,7 +214,7 @@ ret_code_t storer_store_accelerometer_interrupt_chunk(AccelerometerInterruptChun
  * @retval NRF_ERROR_INVALID_STATE	Iterator invalidated/no data found.
  * @retval NRF_SUCCESS				If everything was fine.
  */
-ret_code_t storer_find_accelerometer_interrupt_chunk_from_timestamp(Timestamp timestamp, AccelerometerInterruptChunk* accelerometer_interrupt_chunk);
+ret_code_t storer_find_accelerometer_interrupt_chunk_from_timestamp(Timestamp timestamp);
 
 /**@brief Function to get the next accelerometer-interrupt chunk from the iterator of the partition. (For detailed description: get_next_chunk())
  * @retval	NRF_SUCCESS					If an element was found and returned successfully.
@@ -124,6 +224,16 @@ ret_code_t storer_find_accelerometer_interrupt_chunk_from_timestamp(Timestamp ti
  */
 ret_code_t storer_get_next_accelerometer_interrupt_chunk(AccelerometerInterruptChunk* accelerometer_interrupt_chunk);
 
+/**@brief Function to get the next accelerometer-interrupt chunk and decode it directly into a caller provided structure (e.g. a response message).
+ * @details The message_fields have to describe the encoded AccelerometerInterruptChunk, e.g. the fields of a data response without its leading field
+ *			(&AccelerometerInterruptDataResponse_fields[1]). So the chunk can be decoded without an intermediate AccelerometerInterruptChunk-structure.
+ * @retval	NRF_SUCCESS					If an element was found and returned successfully.
+ * @retval	NRF_ERROR_NOT_FOUND			If no more element in the partition.
+ * @retval	NRF_ERROR_INVALID_STATE		If iterator not initialized or invalidated.
+ * @retval	NRF_ERROR_INTERNAL			If busy.
+ */
+ret_code_t storer_decode_next_accelerometer_interrupt_chunk(const tb_field_t message_fields[], void* message);
+
 
 
 
@@ -142,7 +252,7 @@ ret_code_t storer_store_battery_chunk(BatteryChunk* battery_chunk);
  * @retval NRF_ERROR_INVALID_STATE	Iterator invalidated/no data found.
  * @retval NRF_SUCCESS				If everything was fine.
  */
-ret_code_t storer_find_battery_chunk_from_timestamp(Timestamp timestamp, BatteryChunk* battery_chunk);
+ret_code_t storer_find_battery_chunk_from_timestamp(Timestamp timestamp);
 
 /**@brief Function to get the next battery chunk from the iterator of the partition. (For detailed description: get_next_chunk())
  * @retval	NRF_SUCCESS					If an element was found and returned successfully.
@@ -152,6 +262,16 @@ ret_code_t storer_find_battery_chunk_from_timestamp(Timestamp timestamp, Battery
  */
 ret_code_t storer_get_next_battery_chunk(BatteryChunk* battery_chunk);
 
+/**@brief Function to get the next battery chunk and decode it directly into a caller provided structure (e.g. a response message).
+ * @details The message_fields have to describe the encoded BatteryChunk, e.g. the fields of a data response without its leading field
+ *			(&BatteryDataResponse_fields[1]). So the chunk can be decoded without an intermediate BatteryChunk-structure.
+ * @retval	NRF_SUCCESS					If an element was found and returned successfully.
+ * @retval	NRF_ERROR_NOT_FOUND			If no more element in the partition.
+ * @retval	NRF_ERROR_INVALID_STATE		If iterator not initialized or invalidated.
+ * @retval	NRF_ERROR_INTERNAL			If busy.
+ */
+ret_code_t storer_decode_next_battery_chunk(const tb_field_t message_fields[], void* message);
+
 
 
 
@@ -165,12 +285,23 @@ ret_code_t storer_get_next_battery_chunk(BatteryChunk* battery_chunk);
  */
 ret_code_t storer_store_scan_chunk(ScanChunk* scan_chunk);
 
+/**@brief Function to store a ScanSamplingChunk (e.g. directly from its chunk-fifo slot) as scan chunk in the scan-partition.
+ * @details The chunk must already be reduced to at most SCAN_CHUNK_DATA_SIZE devices. Then it is encoded exactly like a ScanChunk,
+ *			so no conversion into an intermediate ScanChunk-structure is needed.
+ * @retval NRF_ERROR_INVALID_PARAM	If the chunk contains more than SCAN_CHUNK_DATA_SIZE devices.
+ * @retval NRF_ERROR_NO_MEM			If the element is too big, to be stored in the partition.
+ * @retval NRF_ERROR_INTERNAL		Busy or iterator is pointing to the same address we want to write to.
+ * @retval NRF_ERROR_INVALID_DATA	If encoding fails.
+ * @retval NRF_SUCCESS				If everything was fine.
+ */
+ret_code_t storer_store_scan_sampling_chunk(ScanSamplingChunk* scan_sampling_chunk);
+
 /**@brief Function to find a scan chunk from timestamp and set the iterator of the partition. (For detailed description: find_chunk_from_timestamp())
  * @retval NRF_ERROR_INTERNAL		Busy.
  * @retval NRF_ERROR_INVALID_STATE	Iterator invalidated/no data found.
  * @retval NRF_SUCCESS				If everything was fine.
  */
-ret_code_t storer_find_scan_chunk_from_timestamp(Timestamp timestamp, ScanChunk* scan_chunk);
+ret_code_t storer_find_scan_chunk_from_timestamp(Timestamp timestamp);
 
 /**@brief Function to get the next scan chunk from the iterator of the partition. (For detailed description: get_next_chunk())
  * @retval	NRF_SUCCESS					If an element was found and returned successfully.
@@ -180,6 +311,16 @@ ret_code_t storer_find_scan_chunk_from_timestamp(Timestamp timestamp, ScanChunk*
  */
 ret_code_t storer_get_next_scan_chunk(ScanChunk* scan_chunk);
 
+/**@brief Function to get the next scan chunk and decode it directly into a caller provided structure (e.g. a response message).
+ * @details The message_fields have to describe the encoded ScanChunk, e.g. the fields of a data response without its leading field
+ *			(&ScanDataResponse_fields[1]). So the chunk can be decoded without an intermediate ScanChunk-structure.
+ * @retval	NRF_SUCCESS					If an element was found and returned successfully.
+ * @retval	NRF_ERROR_NOT_FOUND			If no more element in the partition.
+ * @retval	NRF_ERROR_INVALID_STATE		If iterator not initialized or invalidated.
+ * @retval	NRF_ERROR_INTERNAL			If busy.
+ */
+ret_code_t storer_decode_next_scan_chunk(const tb_field_t message_fields[], void* message);
+
 
 
 
@@ -198,7 +339,7 @@ ret_code_t storer_store_microphone_chunk(MicrophoneChunk* microphone_chunk);
  * @retval NRF_ERROR_INVALID_STATE	Iterator invalidated/no data found.
  * @retval NRF_SUCCESS				If everything was fine.
  */
-ret_code_t storer_find_microphone_chunk_from_timestamp(Timestamp timestamp, MicrophoneChunk* microphone_chunk);
+ret_code_t storer_find_microphone_chunk_from_timestamp(Timestamp timestamp);
 
 /**@brief Function to get the next microphone chunk from the iterator of the partition. (For detailed description: get_next_chunk())
  * @retval	NRF_SUCCESS					If an element was found and returned successfully.
@@ -208,5 +349,15 @@ ret_code_t storer_find_microphone_chunk_from_timestamp(Timestamp timestamp, Micr
  */
 ret_code_t storer_get_next_microphone_chunk(MicrophoneChunk* microphone_chunk);
 
+/**@brief Function to get the next microphone chunk and decode it directly into a caller provided structure (e.g. a response message).
+ * @details The message_fields have to describe the encoded MicrophoneChunk, e.g. the fields of a data response without its leading field
+ *			(&MicrophoneDataResponse_fields[1]). So the chunk can be decoded without an intermediate MicrophoneChunk-structure.
+ * @retval	NRF_SUCCESS					If an element was found and returned successfully.
+ * @retval	NRF_ERROR_NOT_FOUND			If no more element in the partition.
+ * @retval	NRF_ERROR_INVALID_STATE		If iterator not initialized or invalidated.
+ * @retval	NRF_ERROR_INTERNAL			If busy.
+ */
+ret_code_t storer_decode_next_microphone_chunk(const tb_field_t message_fields[], void* message);
+
 #endif 
 
@@ -26,3 +26,93 @@ const tb_field_t AccelerometerInterruptStream_fields[2] = {
 	TB_LAST_FIELD,
 };
 
+uint8_t BatteryStream_encode(tb_ostream_t* ostream, const BatteryStream* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, BatteryStream_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, BatteryStream_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BatteryStream_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t BatteryStream_decode(tb_istream_t* istream, BatteryStream* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, BatteryStream_fields, dst, endianness);
+	p = tb_istream_consume(istream, BatteryStream_ENCODED_LEN);
+	if(p == NULL) return 0;
+	BatteryStream_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t MicrophoneStream_encode(tb_ostream_t* ostream, const MicrophoneStream* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, MicrophoneStream_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, MicrophoneStream_ENCODED_LEN);
+	if(p == NULL) return 0;
+	MicrophoneStream_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t MicrophoneStream_decode(tb_istream_t* istream, MicrophoneStream* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, MicrophoneStream_fields, dst, endianness);
+	p = tb_istream_consume(istream, MicrophoneStream_ENCODED_LEN);
+	if(p == NULL) return 0;
+	MicrophoneStream_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t ScanStream_encode(tb_ostream_t* ostream, const ScanStream* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, ScanStream_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, ScanStream_ENCODED_LEN);
+	if(p == NULL) return 0;
+	ScanStream_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t ScanStream_decode(tb_istream_t* istream, ScanStream* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, ScanStream_fields, dst, endianness);
+	p = tb_istream_consume(istream, ScanStream_ENCODED_LEN);
+	if(p == NULL) return 0;
+	ScanStream_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerStream_encode(tb_ostream_t* ostream, const AccelerometerStream* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, AccelerometerStream_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, AccelerometerStream_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerStream_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerStream_decode(tb_istream_t* istream, AccelerometerStream* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, AccelerometerStream_fields, dst, endianness);
+	p = tb_istream_consume(istream, AccelerometerStream_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerStream_get(p, dst, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerInterruptStream_encode(tb_ostream_t* ostream, const AccelerometerInterruptStream* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, AccelerometerInterruptStream_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, AccelerometerInterruptStream_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerInterruptStream_put(p, src, endianness);
+	return 1;
+}
+
+uint8_t AccelerometerInterruptStream_decode(tb_istream_t* istream, AccelerometerInterruptStream* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, AccelerometerInterruptStream_fields, dst, endianness);
+	p = tb_istream_consume(istream, AccelerometerInterruptStream_ENCODED_LEN);
+	if(p == NULL) return 0;
+	AccelerometerInterruptStream_get(p, dst, endianness);
+	return 1;
+}
+
@@ -38,4 +38,66 @@ extern const tb_field_t ScanStream_fields[2];
 extern const tb_field_t AccelerometerStream_fields[2];
 extern const tb_field_t AccelerometerInterruptStream_fields[2];
 
+/**< Straight-line encode/decode functions (same binary representation as tb_encode()/tb_decode() with the _fields-arrays) */
+#define BatteryStream_ENCODED_LEN 4
+static inline void BatteryStream_put(uint8_t* p, const BatteryStream* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	BatteryData_put(p, &(src->battery_data), endianness);
+}
+static inline void BatteryStream_get(const uint8_t* p, BatteryStream* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	BatteryData_get(p, &(dst->battery_data), endianness);
+}
+uint8_t BatteryStream_encode(tb_ostream_t* ostream, const BatteryStream* src, tb_endian_t endianness);
+uint8_t BatteryStream_decode(tb_istream_t* istream, BatteryStream* dst, tb_endian_t endianness);
+
+#define MicrophoneStream_ENCODED_LEN 1
+static inline void MicrophoneStream_put(uint8_t* p, const MicrophoneStream* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	MicrophoneData_put(p, &(src->microphone_data), endianness);
+}
+static inline void MicrophoneStream_get(const uint8_t* p, MicrophoneStream* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	MicrophoneData_get(p, &(dst->microphone_data), endianness);
+}
+uint8_t MicrophoneStream_encode(tb_ostream_t* ostream, const MicrophoneStream* src, tb_endian_t endianness);
+uint8_t MicrophoneStream_decode(tb_istream_t* istream, MicrophoneStream* dst, tb_endian_t endianness);
+
+#define ScanStream_ENCODED_LEN 3
+static inline void ScanStream_put(uint8_t* p, const ScanStream* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	ScanDevice_put(p, &(src->scan_device), endianness);
+}
+static inline void ScanStream_get(const uint8_t* p, ScanStream* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	ScanDevice_get(p, &(dst->scan_device), endianness);
+}
+uint8_t ScanStream_encode(tb_ostream_t* ostream, const ScanStream* src, tb_endian_t endianness);
+uint8_t ScanStream_decode(tb_istream_t* istream, ScanStream* dst, tb_endian_t endianness);
+
+#define AccelerometerStream_ENCODED_LEN 6
+static inline void AccelerometerStream_put(uint8_t* p, const AccelerometerStream* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	AccelerometerRawData_put(p, &(src->accelerometer_raw_data), endianness);
+}
+static inline void AccelerometerStream_get(const uint8_t* p, AccelerometerStream* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	AccelerometerRawData_get(p, &(dst->accelerometer_raw_data), endianness);
+}
+uint8_t AccelerometerStream_encode(tb_ostream_t* ostream, const AccelerometerStream* src, tb_endian_t endianness);
+uint8_t AccelerometerStream_decode(tb_istream_t* istream, AccelerometerStream* dst, tb_endian_t endianness);
+
+#define AccelerometerInterruptStream_ENCODED_LEN 6
+static inline void AccelerometerInterruptStream_put(uint8_t* p, const AccelerometerInterruptStream* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+	Timestamp_put(p, &(src->timestamp), endianness);
+}
+static inline void AccelerometerInterruptStream_get(const uint8_t* p, AccelerometerInterruptStream* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+	Timestamp_get(p, &(dst->timestamp), endianness);
+}
+uint8_t AccelerometerInterruptStream_encode(tb_ostream_t* ostream, const AccelerometerInterruptStream* src, tb_endian_t endianness);
+uint8_t AccelerometerInterruptStream_decode(tb_istream_t* istream, AccelerometerInterruptStream* dst, tb_endian_t endianness);
+
+
 #endif
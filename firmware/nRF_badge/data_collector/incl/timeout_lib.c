@@ -6,11 +6,13 @@
 #include "app_util_platform.h"
 
 #define MAX_MILLIS_PER_TIMEOUT_TIMER	(100*1000)
+#define MIN_MILLIS_PER_TIMEOUT_TIMER	2		/**< Because APP-Timer needs at least 5 Ticks... */
 
 typedef struct {
-	volatile uint32_t 	remaining_ms;
+	volatile uint64_t 	deadline_ms;		/**< Absolute systick-time (continuous millis) when the timeout occurs. */
 	volatile uint32_t 	timeout_ms;
 	volatile uint8_t 	active;
+	volatile uint8_t	heap_index;			/**< Position of the timeout in timeout_heap (only valid if active). */
 	timeout_handler_t 	timeout_handler;
 } timeout_t;
 
@@ -18,15 +20,20 @@ typedef struct {
 static timeout_t registered_timeouts[MAX_NUMBER_OF_TIMEOUTS];
 static uint32_t number_of_registered_timeouts = 0;
 
+/**< Binary min-heap of the active timeout-ids, ordered by their deadline_ms. */
+static uint8_t timeout_heap[MAX_NUMBER_OF_TIMEOUTS];
+static volatile uint32_t timeout_heap_size = 0;
+
 APP_TIMER_DEF(timeout_timer);
 static void timeout_timer_callback(void* p_context);
 volatile uint8_t timeout_timer_running = 0;
-static volatile uint64_t timeout_timer_start_ms = 0;
+static volatile uint64_t timeout_timer_deadline_ms = 0;	/**< The deadline the timeout timer is currently armed for (only valid if timeout_timer_running). */
 
 // App-timer has to be initialized before
 // Systick has to be initialized before
 ret_code_t timeout_init(void) {
 	number_of_registered_timeouts = 0;
+	timeout_heap_size = 0;
 	timeout_timer_running = 0;	
 	
 	ret_code_t ret = app_timer_create(&timeout_timer, APP_TIMER_MODE_SINGLE_SHOT, timeout_timer_callback);
@@ -43,7 +50,8 @@ ret_code_t timeout_register(uint32_t* timeout_id, timeout_handler_t timeout_hand
 	timeout_t timeout;
 	timeout.timeout_handler = timeout_handler;
 	timeout.active = 0;
-	timeout.remaining_ms = 0;
+	timeout.heap_index = 0;
+	timeout.deadline_ms = 0;
 	timeout.timeout_ms = 0;
 	
 	registered_timeouts[*timeout_id] = timeout;
@@ -52,132 +60,222 @@ ret_code_t timeout_register(uint32_t* timeout_id, timeout_handler_t timeout_hand
 	return NRF_SUCCESS;
 }
 
-/**@brief Function to retrieve the minimal remaining milliseconds of all timeouts.
+/**@brief Function to swap two entries of the timeout-heap and to update their heap-indices.
  *
- * @retval 	UINT32_MAX	If no active timeout was found.
- * @retval				Otherwise the minimal remaining milliseconds.
+ * @param[in]	a	Heap-position of the first entry.
+ * @param[in]	b	Heap-position of the second entry.
  */
-static uint32_t get_minimal_remaining_ms(void) {
-	uint32_t minimal_remaining_ms = UINT32_MAX;
-	for(uint32_t i = 0; i < number_of_registered_timeouts; i++) {
-		if(registered_timeouts[i].active) {
-			if(registered_timeouts[i].remaining_ms < minimal_remaining_ms) {
-				minimal_remaining_ms = registered_timeouts[i].remaining_ms;
-			}
-		}
+static void heap_swap(uint32_t a, uint32_t b) {
+	uint8_t tmp = timeout_heap[a];
+	timeout_heap[a] = timeout_heap[b];
+	timeout_heap[b] = tmp;
+	registered_timeouts[timeout_heap[a]].heap_index = a;
+	registered_timeouts[timeout_heap[b]].heap_index = b;
+}
+
+/**@brief Function to move an entry of the timeout-heap up until its parent has an earlier (or equal) deadline.
+ *
+ * @param[in]	pos		Heap-position of the entry.
+ */
+static void heap_sift_up(uint32_t pos) {
+	while(pos > 0) {
+		uint32_t parent = (pos - 1)/2;
+		if(registered_timeouts[timeout_heap[parent]].deadline_ms <= registered_timeouts[timeout_heap[pos]].deadline_ms)
+			break;
+		heap_swap(pos, parent);
+		pos = parent;
 	}
+}
+
+/**@brief Function to move an entry of the timeout-heap down until its children have later (or equal) deadlines.
+ *
+ * @param[in]	pos		Heap-position of the entry.
+ */
+static void heap_sift_down(uint32_t pos) {
+	while(1) {
+		uint32_t smallest = pos;
+		uint32_t left = 2*pos + 1;
+		uint32_t right = 2*pos + 2;
+		if(left < timeout_heap_size && registered_timeouts[timeout_heap[left]].deadline_ms < registered_timeouts[timeout_heap[smallest]].deadline_ms)
+			smallest = left;
+		if(right < timeout_heap_size && registered_timeouts[timeout_heap[right]].deadline_ms < registered_timeouts[timeout_heap[smallest]].deadline_ms)
+			smallest = right;
+		if(smallest == pos)
+			break;
+		heap_swap(pos, smallest);
+		pos = smallest;
+	}
+}
+
+/**@brief Function to insert an inactive timeout into the timeout-heap and to mark it active.
+ *
+ * @param[in]	timeout_id	The timeout_id to insert.
+ */
+static void heap_insert(uint32_t timeout_id) {
+	uint32_t pos = timeout_heap_size;
+	timeout_heap[pos] = (uint8_t) timeout_id;
+	registered_timeouts[timeout_id].heap_index = pos;
+	registered_timeouts[timeout_id].active = 1;
+	timeout_heap_size++;
+	heap_sift_up(pos);
+}
+
+/**@brief Function to remove an active timeout from the timeout-heap and to mark it inactive.
+ *
+ * @param[in]	timeout_id	The timeout_id to remove.
+ */
+static void heap_remove(uint32_t timeout_id) {
+	uint32_t pos = registered_timeouts[timeout_id].heap_index;
+	registered_timeouts[timeout_id].active = 0;
+	timeout_heap_size--;
+	if(pos == timeout_heap_size)
+		return;
 	
-	if(minimal_remaining_ms == UINT32_MAX)
-		return UINT32_MAX;
-	
-	minimal_remaining_ms = (minimal_remaining_ms > MAX_MILLIS_PER_TIMEOUT_TIMER) ? MAX_MILLIS_PER_TIMEOUT_TIMER : minimal_remaining_ms;
-	// Because APP-Timer needs at least 5 Ticks...
-	minimal_remaining_ms = (minimal_remaining_ms < 2) ? 2 : minimal_remaining_ms;
-	
-	return minimal_remaining_ms;
+	// Move the last entry into the gap and restore the heap-property
+	uint8_t moved_id = timeout_heap[timeout_heap_size];
+	timeout_heap[pos] = moved_id;
+	registered_timeouts[moved_id].heap_index = pos;
+	heap_sift_up(pos);
+	heap_sift_down(registered_timeouts[moved_id].heap_index);
 }
 
-/**@brief Function that adapts the remaining milliseconds of all timeouts and calls the handler if necessary.
+/**@brief Function to (re-)arm the timeout timer for the earliest deadline in the timeout-heap.
+ *
+ * @details	The timer is only restarted if there is no running timer or if the earliest deadline
+ *			is before the deadline the timer is currently armed for. If the timer fires too early
+ *			(because the earliest timeout was resetted or stopped in the meantime), 
+ *			the timeout_timer_callback() just re-arms the timer.
  *
- * @retval 	UINT32_MAX	If no active timeout was found.
- * @retval				Otherwise the minimal remaining milliseconds.
+ * @param[in]	now_ms		The current systick-time in continuous milliseconds.
+ *
+ * @retval	NRF_SUCCESS					If the timer was (re-)armed successfully or did not need to be re-armed.
+ * @retval  NRF_ERROR_INVALID_STATE   	If the application timer module has not been initialized or the timer
+ *                                      has not been created.
+ * @retval  NRF_ERROR_NO_MEM          	If the timer operations queue was full.
  */
-static void adapt_remaining_ms(void) {
-	
-	uint32_t delta_ms = (uint32_t) (systick_get_continuous_millis() - timeout_timer_start_ms);
-	for(uint32_t i = 0; i < number_of_registered_timeouts; i++) {
-		if(registered_timeouts[i].active) {
-			if(registered_timeouts[i].remaining_ms < delta_ms) {
-				// Call the handler
-				if(registered_timeouts[i].timeout_handler != NULL)
-					registered_timeouts[i].timeout_handler();
-				
-				registered_timeouts[i].active = 0;
-			} else {
-				// Adapt remaining-ms
-				registered_timeouts[i].remaining_ms -= delta_ms;
-			}
+static ret_code_t timeout_timer_schedule(uint64_t now_ms) {
+	if(timeout_heap_size == 0) {
+		if(timeout_timer_running) {
+			timeout_timer_running = 0;
+			app_timer_stop(timeout_timer);
 		}
+		return NRF_SUCCESS;
 	}
 	
+	uint64_t deadline_ms = registered_timeouts[timeout_heap[0]].deadline_ms;
+	if(timeout_timer_running && timeout_timer_deadline_ms <= deadline_ms)
+		return NRF_SUCCESS;
+	
+	if(timeout_timer_running) {
+		app_timer_stop(timeout_timer);
+		timeout_timer_running = 0;
+	}
+	
+	uint64_t delta_ms = (deadline_ms > now_ms) ? (deadline_ms - now_ms) : 0;
+	delta_ms = (delta_ms > MAX_MILLIS_PER_TIMEOUT_TIMER) ? MAX_MILLIS_PER_TIMEOUT_TIMER : delta_ms;
+	delta_ms = (delta_ms < MIN_MILLIS_PER_TIMEOUT_TIMER) ? MIN_MILLIS_PER_TIMEOUT_TIMER : delta_ms;
+	
+	timeout_timer_deadline_ms = now_ms + delta_ms;
+	timeout_timer_running = 1;
+	return app_timer_start(timeout_timer, APP_TIMER_TICKS((uint32_t) delta_ms, 0), NULL);
 }
 
 /**@brief Handler that is called by the timeout timer.
+ *
+ * @details	Pops all expired timeouts from the timeout-heap, calls their handlers 
+ *			and re-arms the timer for the next deadline.
  *
  * @param[in]	p_context	Pointer to context provided by the timer.
  */
 static void timeout_timer_callback(void* p_context) {
 	timeout_timer_running = 0;
 	
-	adapt_remaining_ms();
+	uint64_t now_ms = systick_get_continuous_millis();
+	while(1) {
+		timeout_handler_t timeout_handler = NULL;
+		uint8_t expired = 0;
+		
+		CRITICAL_REGION_ENTER();
+		if(timeout_heap_size > 0 && registered_timeouts[timeout_heap[0]].deadline_ms <= now_ms) {
+			uint32_t timeout_id = timeout_heap[0];
+			timeout_handler = registered_timeouts[timeout_id].timeout_handler;
+			heap_remove(timeout_id);
+			expired = 1;
+		}
+		CRITICAL_REGION_EXIT();
+		
+		if(!expired)
+			break;
+		
+		// Call the handler (it might start/stop other timeouts)
+		if(timeout_handler != NULL)
+			timeout_handler();
+	}
 	
-	uint32_t minimal_remaining_ms = get_minimal_remaining_ms();
-
-	// If we have found another active timeout, we activate the timer again
-	if(minimal_remaining_ms < UINT32_MAX) {
-		timeout_timer_running = 1;
-		timeout_timer_start_ms = systick_get_continuous_millis();
-		app_timer_start(timeout_timer, APP_TIMER_TICKS(minimal_remaining_ms, 0), NULL);
-	} 
+	timeout_timer_schedule(systick_get_continuous_millis());
 }
 
 ret_code_t timeout_start(uint32_t timeout_id, uint32_t timeout_ms) {
-	ret_code_t ret = NRF_SUCCESS;
-	
 	if(timeout_id >= number_of_registered_timeouts)
 		return NRF_ERROR_INVALID_PARAM;
 	
 	if(timeout_ms == 0) {
-		registered_timeouts[timeout_id].active = 0;
+		timeout_stop(timeout_id);
 		return NRF_SUCCESS;
 	}
-
-	if(timeout_timer_running) {
-		app_timer_stop(timeout_timer);
-		adapt_remaining_ms();
-		timeout_timer_running = 0;
-	}
-
-
-	registered_timeouts[timeout_id].timeout_ms = timeout_ms;
-	registered_timeouts[timeout_id].remaining_ms = timeout_ms;
-	registered_timeouts[timeout_id].active = 1;
-
 	
-	uint32_t minimal_remaining_ms = get_minimal_remaining_ms();
-
-	if(minimal_remaining_ms < UINT32_MAX) {		
-		timeout_timer_running = 1;
-		timeout_timer_start_ms = systick_get_continuous_millis();
-		ret = app_timer_start(timeout_timer, APP_TIMER_TICKS(minimal_remaining_ms, 0), NULL);
+	uint64_t now_ms = systick_get_continuous_millis();
+	
+	CRITICAL_REGION_ENTER();
+	registered_timeouts[timeout_id].timeout_ms = timeout_ms;
+	registered_timeouts[timeout_id].deadline_ms = now_ms + timeout_ms;
+	if(registered_timeouts[timeout_id].active) {
+		// The deadline could have moved in both directions
+		uint32_t pos = registered_timeouts[timeout_id].heap_index;
+		heap_sift_up(pos);
+		heap_sift_down(registered_timeouts[timeout_id].heap_index);
+	} else {
+		heap_insert(timeout_id);
 	}
-
-	return ret;
+	CRITICAL_REGION_EXIT();
+	
+	return timeout_timer_schedule(now_ms);
 }
 
 void timeout_stop(uint32_t timeout_id) {
 	if(timeout_id >= number_of_registered_timeouts)
 		return;
 	
-	registered_timeouts[timeout_id].active = 0;
-	uint8_t found_active = 0;
-	for(uint32_t i = 0; i < number_of_registered_timeouts; i++) {
-		if(registered_timeouts[i].active) {
-			found_active = 1;
-			break;
-		}
-	}	
-	// If there are no active timeouts anymore --> stop the timer
-	if(!found_active) {
+	uint8_t heap_empty = 0;
+	CRITICAL_REGION_ENTER();
+	if(registered_timeouts[timeout_id].active)
+		heap_remove(timeout_id);
+	heap_empty = (timeout_heap_size == 0);
+	CRITICAL_REGION_EXIT();
+	
+	// If there are no active timeouts anymore --> stop the timer.
+	// Otherwise the timer is kept running: if it fires too early, it is just re-armed.
+	if(heap_empty && timeout_timer_running) {
 		timeout_timer_running = 0;
 		app_timer_stop(timeout_timer);
 	}	
 }
 
 void timeout_reset(uint32_t timeout_id) {
-	if(registered_timeouts[timeout_id].active)
-		timeout_start(timeout_id, registered_timeouts[timeout_id].timeout_ms);
+	if(timeout_id >= number_of_registered_timeouts)
+		return;
+	
+	if(!registered_timeouts[timeout_id].active)
+		return;
+	
+	uint64_t now_ms = systick_get_continuous_millis();
+	
+	// Lazy reset: the deadline can only move to a later point in time, so the timer doesn't need to be restarted.
+	// If the timer fires before the new deadline, the timeout_timer_callback() just re-arms it.
+	CRITICAL_REGION_ENTER();
+	if(registered_timeouts[timeout_id].active) {
+		registered_timeouts[timeout_id].deadline_ms = now_ms + registered_timeouts[timeout_id].timeout_ms;
+		heap_sift_down(registered_timeouts[timeout_id].heap_index);
+	}
+	CRITICAL_REGION_EXIT();
 }
-
-
-
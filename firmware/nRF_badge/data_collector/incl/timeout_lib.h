@@ -6,7 +6,10 @@
  *	the timeout-handler is called.
  *
  * 	Internally, the module uses one app-timer to create alarms at certain intervals,
- *	to check for timeouts.
+ *	to check for timeouts. The active timeouts are kept in a binary min-heap
+ *	ordered by their deadline, so starting, stopping and resetting a timeout
+ *	is O(log MAX_NUMBER_OF_TIMEOUTS) and the app-timer only needs to be armed 
+ *	for the earliest deadline.
  */
 
 #ifndef __TIMEOUT_LIB_H
@@ -63,6 +66,10 @@ ret_code_t timeout_start(uint32_t timeout_id, uint32_t timeout_ms);
 void timeout_stop(uint32_t timeout_id);
 
 /**@brief Function to reset a timeout.
+ *
+ * @details	The reset is done lazily: only the deadline of the timeout is moved,
+ *			the underlying app-timer is not restarted. If the app-timer fires
+ *			before the new deadline, it is just re-armed.
  *
  * @param[in]	timeout_id			The timeout_id that should be resetted.
  */
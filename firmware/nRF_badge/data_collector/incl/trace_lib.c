@@ -0,0 +1,149 @@
+#include "trace_lib.h"
+
+#ifdef TRACE_ENABLE
+
+#include "app_util_platform.h"
+
+#ifdef UNIT_TEST
+#include "timer_lib.h"
+#include "stdio.h"
+#else
+#include "app_timer.h"
+#endif
+
+
+static trace_record_t trace_buffer[TRACE_BUFFER_SIZE];	/**< The ring-buffer of the trace-records. */
+static volatile uint32_t trace_write_count = 0;			/**< Number of records written since trace_init(). */
+static volatile uint32_t trace_read_count = 0;			/**< Number of records read (or overwritten) since trace_init(). */
+static volatile uint32_t trace_overwritten_count = 0;	/**< Number of records overwritten before they were read. */
+#ifdef UNIT_TEST
+static uint64_t trace_start_microseconds = 0;			/**< The time of trace_init(), so that the 32 bit timestamps don't wrap in long test-runs. */
+#endif
+
+/**< The names of the events (in the order of trace_event_t). */
+static const char* trace_event_names[TRACE_NUMBER_OF_EVENTS] = {
+	"scheduler_put",
+	"scheduler_execute",
+	"filesystem_store_element",
+	"tb_encode",
+	"tb_decode",
+	"sender_transmit",
+	"sampling_accelerometer",
+	"sampling_accelerometer_interrupt",
+	"sampling_battery",
+	"sampling_microphone",
+	"sampling_scan",
+};
+
+
+void trace_init(void) {
+	CRITICAL_REGION_ENTER();
+	trace_write_count = 0;
+	trace_read_count = 0;
+	trace_overwritten_count = 0;
+	CRITICAL_REGION_EXIT();
+#ifdef UNIT_TEST
+	trace_start_microseconds = timer_get_microseconds_since_start();
+#endif
+}
+
+/**@brief Function to retrieve the current timestamp.
+ *
+ * @retval	The timestamp with TRACE_TIMESTAMP_FREQ.
+ */
+static uint32_t trace_get_timestamp(void) {
+#ifdef UNIT_TEST
+	return (uint32_t) (timer_get_microseconds_since_start() - trace_start_microseconds);
+#else
+	return app_timer_cnt_get();
+#endif
+}
+
+void trace_record(trace_event_t event, trace_phase_t phase, uint16_t arg) {
+	uint32_t timestamp = trace_get_timestamp();
+	uint32_t pos;
+#ifdef UNIT_TEST
+	// The critical region of the mock is a non-recursive mutex, and the hooks might be called while it is hold.
+	pos = __sync_fetch_and_add(&trace_write_count, 1);
+#else
+	CRITICAL_REGION_ENTER();
+	pos = trace_write_count++;
+	CRITICAL_REGION_EXIT();
+#endif
+	trace_record_t* record = &trace_buffer[pos % TRACE_BUFFER_SIZE];
+	record->timestamp = timestamp;
+	record->event = (uint8_t) event;
+	record->phase = (uint8_t) phase;
+	record->arg = arg;
+}
+
+uint32_t trace_read(trace_record_t* records, uint32_t max_records) {
+	uint32_t write_count = trace_write_count;
+	// Skip the records that were already overwritten
+	if(write_count - trace_read_count > TRACE_BUFFER_SIZE) {
+		trace_overwritten_count += write_count - trace_read_count - TRACE_BUFFER_SIZE;
+		trace_read_count = write_count - TRACE_BUFFER_SIZE;
+	}
+	
+	uint32_t n = 0;
+	while(n < max_records && trace_read_count != write_count) {
+		records[n] = trace_buffer[trace_read_count % TRACE_BUFFER_SIZE];
+		trace_read_count++;
+		n++;
+	}
+	return n;
+}
+
+uint32_t trace_get_overwritten_records(void) {
+	uint32_t write_count = trace_write_count;
+	uint32_t overwritten = trace_overwritten_count;
+	if(write_count - trace_read_count > TRACE_BUFFER_SIZE)
+		overwritten += write_count - trace_read_count - TRACE_BUFFER_SIZE;
+	return overwritten;
+}
+
+const char* trace_get_event_name(trace_event_t event) {
+	if(event >= TRACE_NUMBER_OF_EVENTS)
+		return "unknown";
+	return trace_event_names[event];
+}
+
+
+#ifdef UNIT_TEST
+/**@brief Function to retrieve the Chrome trace thread-id of an event.
+ *
+ * @details	The sampling callbacks are called in interrupt context, so they get their own thread,
+ *			otherwise their spans would break the nesting of the spans of the main context.
+ *
+ * @param[in]	event	The event.
+ *
+ * @retval	The thread-id.
+ */
+static uint32_t trace_get_thread_id(uint8_t event) {
+	return (event >= TRACE_EVENT_SAMPLING_ACCELEROMETER) ? 1 : 0;
+}
+
+ret_code_t trace_dump_chrome_json(const char* filename) {
+	FILE* file = fopen(filename, "w");
+	if(file == NULL)
+		return NRF_ERROR_INTERNAL;
+	
+	fprintf(file, "{\"traceEvents\":[\n");
+	fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"main\"}},\n");
+	fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"interrupt\"}}");
+	
+	trace_record_t record;
+	while(trace_read(&record, 1) == 1) {
+		fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%u,\"pid\":0,\"tid\":%u,", trace_get_event_name((trace_event_t) record.event), record.phase, record.timestamp, trace_get_thread_id(record.event));
+		if(record.phase == TRACE_PHASE_INSTANT)
+			fprintf(file, "\"s\":\"t\",");
+		fprintf(file, "\"args\":{\"arg\":%u}}", record.arg);
+	}
+	fprintf(file, "\n],\"otherData\":{\"overwritten_records\":%u}}\n", trace_get_overwritten_records());
+	
+	fclose(file);
+	return NRF_SUCCESS;
+}
+#endif
+
+#endif
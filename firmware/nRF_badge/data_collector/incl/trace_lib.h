@@ -0,0 +1,127 @@
+#ifndef __TRACE_LIB_H
+#define __TRACE_LIB_H
+
+
+/** @file
+ *
+ * @brief Event-trace library.
+ *
+ * @details This module records compact timestamped events (begin/end of a span or an instant event) 
+ *			into a RAM ring-buffer. The ring-buffer can be drained over UART (uart-command "trace")
+ *			and in the unit_test build it can be dumped as Chrome trace JSON (chrome://tracing or https://ui.perfetto.dev).
+ *			When the ring-buffer is full, the oldest events are overwritten.
+ *			If trace is not enabled (TRACE_ENABLE), the macros are replaced by nothing, causing the compiler to remove them.
+ *
+ * @note 	The timestamps are in microseconds in the unit_test build, and in app-timer ticks (TRACE_TIMESTAMP_FREQ, 24 bit) on the badge.
+ */
+
+#include "stdint.h"
+
+/**@brief The different events that could be traced. */
+typedef enum {
+	TRACE_EVENT_SCHEDULER_PUT						= 0,	/**< Instant: event put into the scheduler (arg: priority). */
+	TRACE_EVENT_SCHEDULER_EXECUTE					= 1,	/**< Span: execution of a scheduled event (arg: priority). */
+	TRACE_EVENT_FILESYSTEM_STORE					= 2,	/**< Span: filesystem_store_element (arg: partition_id). */
+	TRACE_EVENT_TB_ENCODE							= 3,	/**< Span: tb_encode (end-arg: number of encoded bytes). */
+	TRACE_EVENT_TB_DECODE							= 4,	/**< Span: tb_decode (end-arg: number of decoded bytes). */
+	TRACE_EVENT_SENDER_TRANSMIT						= 5,	/**< Span: sender_transmit (arg: length of the data). */
+	TRACE_EVENT_SAMPLING_ACCELEROMETER				= 6,	/**< Span: accelerometer sampling callback. */
+	TRACE_EVENT_SAMPLING_ACCELEROMETER_INTERRUPT	= 7,	/**< Span: accelerometer interrupt sampling callback. */
+	TRACE_EVENT_SAMPLING_BATTERY					= 8,	/**< Span: battery sampling callback. */
+	TRACE_EVENT_SAMPLING_MICROPHONE					= 9,	/**< Span: microphone sampling callback. */
+	TRACE_EVENT_SAMPLING_SCAN						= 10,	/**< Span: scan sampling callback (scan report). */
+	TRACE_NUMBER_OF_EVENTS							= 11,
+} trace_event_t;
+
+/**@brief The phases of a trace-record (the values are the Chrome trace phases). */
+typedef enum {
+	TRACE_PHASE_BEGIN		= 'B',
+	TRACE_PHASE_END			= 'E',
+	TRACE_PHASE_INSTANT		= 'i',
+} trace_phase_t;
+
+/**@brief One trace-record in the ring-buffer (8 bytes). */
+typedef struct {
+	uint32_t	timestamp;		/**< Timestamp of the event. */
+	uint8_t		event;			/**< The trace_event_t. */
+	uint8_t		phase;			/**< The trace_phase_t. */
+	uint16_t	arg;			/**< Event specific argument. */
+} trace_record_t;
+
+
+
+#ifdef TRACE_ENABLE
+
+#include "sdk_errors.h"	// Needed for the definition of ret_code_t and the error-codes
+
+#ifdef UNIT_TEST
+#define TRACE_BUFFER_SIZE		8192	/**< Number of trace-records in the ring-buffer (the host has enough memory to record complete test-runs). */
+#define TRACE_TIMESTAMP_FREQ	1000000	/**< Frequency of the timestamps (microseconds in the unit_test build). */
+#else
+#define TRACE_BUFFER_SIZE		128		/**< Number of trace-records in the ring-buffer. */
+#define TRACE_TIMESTAMP_FREQ	32768	/**< Frequency of the timestamps (app-timer ticks with prescaler 0). */
+#endif
+
+#define TRACE_BEGIN(event, arg)		trace_record((event), TRACE_PHASE_BEGIN, (arg))
+#define TRACE_END(event, arg)		trace_record((event), TRACE_PHASE_END, (arg))
+#define TRACE_INSTANT(event, arg)	trace_record((event), TRACE_PHASE_INSTANT, (arg))
+
+/**@brief Function to clear the trace ring-buffer. */
+void trace_init(void);
+
+/**@brief Function to record an event into the trace ring-buffer.
+ *
+ * @details	It can be called from interrupt context. If the ring-buffer is full, the oldest record is overwritten.
+ *
+ * @param[in]	event	The event to record.
+ * @param[in]	phase	The phase of the event.
+ * @param[in]	arg		Event specific argument.
+ */
+void trace_record(trace_event_t event, trace_phase_t phase, uint16_t arg);
+
+/**@brief Function to drain the oldest records from the trace ring-buffer.
+ *
+ * @param[out]	records		Pointer to array where the records should be stored to.
+ * @param[in]	max_records	Maximum number of records to read.
+ *
+ * @retval	Number of records read.
+ */
+uint32_t trace_read(trace_record_t* records, uint32_t max_records);
+
+/**@brief Function to retrieve the number of records that were overwritten before they could be read.
+ *
+ * @retval	Number of overwritten records.
+ */
+uint32_t trace_get_overwritten_records(void);
+
+/**@brief Function to retrieve the name of an event.
+ *
+ * @param[in]	event	The event.
+ *
+ * @retval	Pointer to the name of the event.
+ */
+const char* trace_get_event_name(trace_event_t event);
+
+#ifdef UNIT_TEST
+/**@brief Function to drain the trace ring-buffer into a Chrome trace JSON file.
+ *
+ * @param[in]	filename	The file to write.
+ *
+ * @retval	NRF_SUCCESS				On success.
+ * @retval	NRF_ERROR_INTERNAL		If the file could not be written.
+ */
+ret_code_t trace_dump_chrome_json(const char* filename);
+#endif
+
+#else
+
+#define TRACE_BEGIN(event, arg)
+#define TRACE_END(event, arg)
+#define TRACE_INSTANT(event, arg)
+
+#define trace_init(...)
+
+#endif
+
+
+#endif //__TRACE_LIB_H
@@ -3,6 +3,7 @@
 #include "debug_lib.h"
 #include "app_util_platform.h"
 #include "custom_board.h"
+#include "trace_lib.h"
 
 #ifdef DEBUG_LOG_ENABLE
 
@@ -35,12 +36,37 @@ static void on_restart_command(void) {
     NVIC_SystemReset();
 }
 
+#ifdef TRACE_ENABLE
+#define TRACE_UART_DRAIN_RECORDS	32	/**< Maximum number of trace-records printed per trace-command (the debug-FIFO is limited). */
+
+/**@brief Command handler function that is called when the trace-command was received.
+ *
+ * @details	Drains up to TRACE_UART_DRAIN_RECORDS records from the trace ring-buffer and prints them.
+ *			One line per record: "TRACE: <timestamp> <event> <phase> <arg>" (timestamp in TRACE_TIMESTAMP_FREQ).
+ */
+static void on_trace_command(void) {
+	trace_record_t record;
+	uint32_t n = 0;
+	while(n < TRACE_UART_DRAIN_RECORDS && trace_read(&record, 1) == 1) {
+		debug_log("TRACE: %u %u %c %u\n", record.timestamp, record.event, record.phase, record.arg);
+		n++;
+	}
+	debug_log("TRACE: %u records, %u overwritten, %u Hz\n", n, trace_get_overwritten_records(), TRACE_TIMESTAMP_FREQ);
+}
+#endif
+
 /**< The command lookup table, maps textual string commands to methods executed when they're received. */
 static uart_command_t uart_commands[] = {
         {
                 .command = "restart",
                 .handler = on_restart_command,
         },
+#ifdef TRACE_ENABLE
+        {
+                .command = "trace",
+                .handler = on_trace_command,
+        },
+#endif
 };
 
 
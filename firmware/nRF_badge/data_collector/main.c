@@ -19,6 +19,8 @@
 #include "storer_lib.h"
 #include "sampling_lib.h"
 #include "app_scheduler.h"
+#include "scheduler_lib.h"
+#include "trace_lib.h"
 #include "selftest_lib.h"
 #include "uart_commands_lib.h"
 
@@ -46,6 +48,7 @@ int main(void)
 	
 	
 	debug_init();
+	trace_init();
 	
 	debug_log("MAIN: Start...\n\r");
 
@@ -58,6 +61,7 @@ int main(void)
 
 	SOFTDEVICE_HANDLER_INIT(&clock_lf_cfg, NULL);
 	APP_SCHED_INIT(4, 100);
+	scheduler_init();
 	APP_TIMER_INIT(0, 60, NULL);
 
 	ret = systick_init(0);
@@ -7,13 +7,16 @@ import traceback
 
 
 
-SUPPORTED_OUTPUT_FORMATS = ['-c', '-python']	
+SUPPORTED_OUTPUT_FORMATS = ['-c', '-cpp', '-python']	
 
 BIG_ENDIANNESS = 0
 LITTLE_ENDIANNESS = 1
 	
 SUPPORTED_ENDIANNESS = ['-be', '-le']	
 
+# Option for C: Additionally create straight-line encode/decode functions for each message
+STRAIGHT_LINE_OPTION = '-straight_line'
+
 
 
 
@@ -27,10 +30,23 @@ FIELD_TYPE_UINT 			= 64
 FIELD_TYPE_FLOAT 			= 128
 FIELD_TYPE_DOUBLE 			= 256
 FIELD_TYPE_MESSAGE 			= 512
+FIELD_TYPE_VARINT 			= 1024
+FIELD_TYPE_VARUINT 			= 2048
+FIELD_TYPE_PACKED 			= 4096
+FIELD_TYPE_PACKED_BITS_POS 	= 13
 	
 
+# Integers with a variable encoded length (LEB128, signed ones zigzag-encoded before). The number is the size of the integer in the structure.
+VARINT_FIELD_TYPE_SIZES = {'varuint16': 2, 'varint16': 2, 'varuint32': 4, 'varint32': 4, 'varuint64': 8, 'varint64': 8}
+
+# Unsigned integers with less than 8 bits, only allowed in packed fields (the values are bit-packed). The number is the number of bits.
+PACKED_FIELD_TYPE_BITS = {'uint1': 1, 'uint2': 2, 'uint3': 3, 'uint4': 4, 'uint5': 5, 'uint6': 6, 'uint7': 7}
+
+PRIMITIVE_FIELD_TYPES = ['uint8', 'int8', 'uint16', 'int16', 'uint32', 'int32', 'uint64', 'int64', 'float', 'double'] + sorted(VARINT_FIELD_TYPE_SIZES.keys())
+PRIMITIVE_FIELD_TYPE_LENS = {'uint8': 1, 'int8': 1, 'uint16': 2, 'int16': 2, 'uint32': 4, 'int32': 4, 'uint64': 8, 'int64': 8, 'float': 4, 'double': 8}	# Only the types with a fixed encoded length
+
 # The supported field types. Messages/extern messages are added to this list, so that subsequent messages can use this message as field type.
-SUPPORTED_FIELD_TYPES = ['uint8', 'int8', 'uint16', 'int16', 'uint32', 'int32', 'uint64', 'int64', 'float', 'double']
+SUPPORTED_FIELD_TYPES = list(PRIMITIVE_FIELD_TYPES)
 
 
 				
@@ -358,6 +374,44 @@ class FixedRepeatedField(Field):
 		else:
 			return None
 		
+class PackedField(RepeatedField):	# A repeated field of bit-packed values, the structure is the same as for a repeated field
+	def __init__(self, name, type, size):
+		RepeatedField.__init__(self, name, type, size)
+		self.bits = PACKED_FIELD_TYPE_BITS[type]
+		
+	def __repr__(self):
+		return "PackedField" + str(self.__dict__)
+		
+		
+	@classmethod
+	def get_field(cls, line):
+		if(line[0] == 'packed'):
+			
+			format = ["packed", "'field_type'", "'field_name'", "[", "'array_size'", "]", ";"]
+			format_required = [1, 0, 0, 1, 0, 1, 1]
+			if(not check_format(line, format, format_required)): 
+				raise Exception('Expects packed field format ' + str(format) + "\nBut given is: " + str(line))
+			
+			field_type = line[1]
+			if(not field_type in PACKED_FIELD_TYPE_BITS):
+				raise Exception('Unsupported packed field type ' + field_type + ', expects one of ' + str(sorted(PACKED_FIELD_TYPE_BITS.keys())))
+			
+			
+			field_name = line[2]
+			if(not Field.field_name_valid(field_name)):
+				raise Exception('Unsupported field name ' + field_name)
+			
+			array_size_str = line[4]
+			array_size = Field.get_integer(array_size_str)
+			if(array_size == None):
+				raise Exception('Unsupported array size ' + array_size_str)
+			
+			
+			return PackedField(field_name, field_type, array_size)
+			
+		else:
+			return None
+		
 class OptionalField(Field):
 	def __init__(self, name, type):
 		Field.__init__(self, name)
@@ -712,6 +766,12 @@ class Parser:
 								block.remove_lines([block_line_number])
 								continue
 								
+							field = PackedField.get_field(block_line)
+							if(not field == None):
+								message.add_field(field)
+								block.remove_lines([block_line_number])
+								continue
+								
 							field = OptionalField.get_field(block_line)
 							if(not field == None):
 								message.add_field(field)
@@ -769,12 +829,14 @@ def search_size_type(size):
 
 
 class C_Creator:
-	def __init__(self, output_path, output_name, imports, defines, messages):
+	def __init__(self, output_path, output_name, imports, defines, messages, straight_line = False, imported_messages = []):
 		self.output_path = output_path
 		self.output_name = output_name
 		self.imports = imports
 		self.defines = defines
 		self.messages = messages
+		self.straight_line = straight_line
+		self.imported_messages = imported_messages
 		
 		self.create()
 		
@@ -823,6 +885,13 @@ class C_Creator:
 			self.create_message_fields(message)
 			self.c_file.append_line()
 		
+		# Optionally create the straight-line encode/decode functions
+		if(self.straight_line):
+			self.h_file.append_line()
+			straight_line_creator = C_StraightLineCreator(self, self.messages, self.imported_messages)
+			straight_line_creator.create_header(self.h_file)
+			straight_line_creator.create_source(self.c_file)
+		
 		# Finally close the header-file with #endif 
 		self.h_file.append_line()
 		self.h_file.append_line("#endif")
@@ -847,20 +916,28 @@ class C_Creator:
 	def get_field_type_mapping(self, field_type):
 		field_type_mapping = {"uint8": "uint8_t", "int8": "int8_t", "uint16": "uint16_t", "int16": "int16_t", 
 							  "uint32": "uint32_t", "int32": "int32_t", "uint64": "uint64_t", "int64": "int64_t", 
-							  "float": "float", "double": "double"}
+							  "float": "float", "double": "double",
+							  "varuint16": "uint16_t", "varint16": "int16_t", "varuint32": "uint32_t", "varint32": "int32_t",
+							  "varuint64": "uint64_t", "varint64": "int64_t"}
 					
 		if field_type in field_type_mapping:
 			return field_type_mapping[field_type]
+		elif field_type in PACKED_FIELD_TYPE_BITS:
+			return "uint8_t"
 		else:	# For example in the case of message as field type
 			return field_type
 			
 	def get_field_type_identifier(self, field_type):
 		field_type_identifier ={"uint8": FIELD_TYPE_UINT, "int8": FIELD_TYPE_INT, "uint16": FIELD_TYPE_UINT, "int16": FIELD_TYPE_INT, 
 								"uint32": FIELD_TYPE_UINT, "int32": FIELD_TYPE_INT, "uint64": FIELD_TYPE_UINT, "int64": FIELD_TYPE_INT, 
-								"float": FIELD_TYPE_FLOAT, "double": FIELD_TYPE_DOUBLE}
+								"float": FIELD_TYPE_FLOAT, "double": FIELD_TYPE_DOUBLE,
+								"varuint16": FIELD_TYPE_VARUINT, "varint16": FIELD_TYPE_VARINT, "varuint32": FIELD_TYPE_VARUINT, "varint32": FIELD_TYPE_VARINT,
+								"varuint64": FIELD_TYPE_VARUINT, "varint64": FIELD_TYPE_VARINT}
 		
 		if field_type in field_type_identifier:
 			return field_type_identifier[field_type]
+		elif field_type in PACKED_FIELD_TYPE_BITS:	# The number of bits is stored in the upper bits of the identifier
+			return FIELD_TYPE_PACKED | (PACKED_FIELD_TYPE_BITS[field_type] << FIELD_TYPE_PACKED_BITS_POS)
 		else:	# For example in the case of message as field type
 			return FIELD_TYPE_MESSAGE
 		
@@ -980,6 +1057,520 @@ class C_Creator:
 
 
 
+def parse_imported_messages(schema_file):
+	"""Parses the schema-files of the imports (if they are in the directory of schema_file) and returns their messages.
+	
+	Needed for the straight-line functions, to know whether an extern message has a fixed encoded length.
+	The global lists are restored afterwards.
+	"""
+	schema_dir = os.path.dirname(os.path.abspath(schema_file))
+	saved = (Imports[:], Defines[:], Messages[:], SUPPORTED_FIELD_TYPES[:])
+	messages = []
+	for imp in saved[0]:
+		import_file = os.path.join(schema_dir, imp.name + ".tb")
+		if(not os.path.isfile(import_file)):
+			continue
+		del Imports[:]
+		del Defines[:]
+		del Messages[:]
+		SUPPORTED_FIELD_TYPES[:] = PRIMITIVE_FIELD_TYPES
+		try:
+			Parser(import_file)
+			messages += Messages
+			messages += parse_imported_messages(import_file)
+		finally:
+			Imports[:] = saved[0]
+			Defines[:] = saved[1]
+			Messages[:] = saved[2]
+			SUPPORTED_FIELD_TYPES[:] = saved[3]
+	return messages
+
+
+class C_SegmentWriter:
+	"""Collects the lines of a straight-line encode/decode function.
+	
+	Consecutive fields with a fixed encoded length are merged into one segment, 
+	so that only one bounds check (tb_ostream_reserve()/tb_istream_consume()) is needed for them.
+	"""
+	def __init__(self, encode, indent):
+		self.encode = encode
+		self.indent = indent
+		self.lines = []
+		self.segment_len = 0
+		self.segment_lines = []
+		
+	def add_fixed(self, length, make_lines):	# make_lines(offset) returns the lines to access the bytes at p + offset
+		self.segment_lines += make_lines(self.segment_len)
+		self.segment_len += length
+		
+	def add_line(self, line):
+		self.flush()
+		self.lines.append(self.indent + line)
+		
+	def flush(self):
+		if(self.segment_len == 0 and len(self.segment_lines) == 0):
+			return
+		if(self.segment_len > 0):
+			self.append_reserve(str(self.segment_len))
+		for line in self.segment_lines:
+			self.lines.append(self.indent + line)
+		self.segment_len = 0
+		self.segment_lines = []
+	
+	def add_reserve(self, length_expression):	# The pending segment is flushed first, so that the bytes keep the field order
+		self.flush()
+		self.append_reserve(length_expression)
+		
+	def append_reserve(self, length_expression):
+		if(self.encode):
+			self.lines.append(self.indent + "p = tb_ostream_reserve(ostream, " + length_expression + ");")
+		else:
+			self.lines.append(self.indent + "p = tb_istream_consume(istream, " + length_expression + ");")
+		self.lines.append(self.indent + "if(p == NULL) return 0;")
+		
+	def get_lines(self):
+		self.flush()
+		return self.lines
+	
+
+class C_StraightLineCreator:
+	"""Creates straight-line encode/decode functions for the messages (option -straight_line).
+	
+	For every message M the functions M_encode(ostream, src, endianness) and M_decode(istream, dst, endianness) are created.
+	They produce the same binary representation as tb_encode()/tb_decode() with M_fields, but without interpreting the field-array at runtime.
+	Messages with a fixed encoded length additionally get the static inline functions M_put()/M_get() and the define M_ENCODED_LEN in the header,
+	so that they can be inlined into other messages (also of other schema-files, that are generated with this option).
+	"""
+	def __init__(self, c_creator, messages, imported_messages):
+		self.c_creator = c_creator
+		self.messages = messages
+		self.known_messages = {}
+		for m in imported_messages + messages:
+			self.known_messages[m.name] = m
+	
+	def get_fixed_len(self, field_type):	# Returns the fixed encoded length of a type, or None if the length is not fixed (or unknown)
+		if field_type in PRIMITIVE_FIELD_TYPE_LENS:
+			return PRIMITIVE_FIELD_TYPE_LENS[field_type]
+		if field_type not in self.known_messages:
+			return None
+		length = 0
+		for field in self.known_messages[field_type].fields:
+			field_len = None
+			if(isinstance(field, RequiredField)):
+				field_len = self.get_fixed_len(field.type)
+			elif(isinstance(field, FixedRepeatedField)):
+				field_len = self.get_fixed_len(field.type)
+				if(field_len != None):
+					field_len = field_len * field.size
+			if(field_len == None):
+				return None
+			length += field_len
+		return length
+		
+	def get_put_line(self, field_type, pointer, value):
+		if field_type not in PRIMITIVE_FIELD_TYPE_LENS:
+			return field_type + "_put(" + pointer + ", &(" + value + "), endianness);"
+		if field_type in ['float', 'double']:
+			return "tb_put_" + field_type + "(" + pointer + ", " + value + ", endianness);"
+		length = PRIMITIVE_FIELD_TYPE_LENS[field_type]
+		if(length == 1):
+			return "*(" + pointer + ") = (uint8_t) " + value + ";"
+		return "tb_put_" + str(8*length) + "(" + pointer + ", (uint" + str(8*length) + "_t) " + value + ", endianness);"
+		
+	def get_get_line(self, field_type, pointer, value):
+		if field_type not in PRIMITIVE_FIELD_TYPE_LENS:
+			return field_type + "_get(" + pointer + ", &(" + value + "), endianness);"
+		c_type = self.c_creator.get_field_type_mapping(field_type)
+		if field_type in ['float', 'double']:
+			return value + " = tb_get_" + field_type + "(" + pointer + ", endianness);"
+		length = PRIMITIVE_FIELD_TYPE_LENS[field_type]
+		if(length == 1):
+			return value + " = (" + c_type + ") *(" + pointer + ");"
+		return value + " = (" + c_type + ") tb_get_" + str(8*length) + "(" + pointer + ", endianness);"
+	
+	def get_access_line(self, encode, field_type, pointer, value):
+		if(encode):
+			return self.get_put_line(field_type, pointer, value)
+		return self.get_get_line(field_type, pointer, value)
+	
+	def offset_pointer(self, offset, index_expression = None, element_len = 0):
+		s = "p"
+		if(offset > 0):
+			s += " + " + str(offset)
+		if(index_expression != None):
+			s += " + " + index_expression + "*" + str(element_len)
+		return s
+		
+	def get_varint_lines(self, encode, field_type, value):	# Returns the lines to encode/decode a single varint (the decode function needs the variable varint)
+		signed = field_type.startswith('varint')
+		if(encode):
+			encoded_value = ("tb_zigzag_encode((int64_t) " + value + ")") if signed else ("(uint64_t) " + value)
+			return ["if(!tb_encode_varuint(ostream, " + encoded_value + ")) return 0;"]
+		c_type = self.c_creator.get_field_type_mapping(field_type)
+		decoded_value = ("(" + c_type + ") tb_zigzag_decode(varint)") if signed else ("(" + c_type + ") varint")
+		return ["if(!tb_decode_varuint(istream, &varint, " + str(VARINT_FIELD_TYPE_SIZES[field_type]) + ")) return 0;", value + " = " + decoded_value + ";"]
+		
+	def add_single(self, writer, encode, field_type, value):	# Adds a single (required) value of field_type
+		if field_type in VARINT_FIELD_TYPE_SIZES:
+			for line in self.get_varint_lines(encode, field_type, value):
+				writer.add_line(line)
+			return
+		fixed_len = self.get_fixed_len(field_type)
+		if(fixed_len == 0):	# Nothing to encode (e.g. an empty message)
+			return
+		if(fixed_len != None):
+			writer.add_fixed(fixed_len, lambda offset: [self.get_access_line(encode, field_type, self.offset_pointer(offset), value)])
+		elif(encode):
+			writer.add_line("if(!" + field_type + "_encode(ostream, &(" + value + "), endianness)) return 0;")
+		else:
+			writer.add_line("if(!" + field_type + "_decode(istream, &(" + value + "), endianness)) return 0;")
+	
+	def add_array(self, writer, encode, field_type, value, count_expression, fixed_count):	# Adds the elements of an array of field_type
+		fixed_len = self.get_fixed_len(field_type)
+		loop = "for(uint32_t i = 0; i < " + count_expression + "; i++) "
+		if field_type in VARINT_FIELD_TYPE_SIZES:
+			writer.add_line(loop + "{")
+			for line in self.get_varint_lines(encode, field_type, value + "[i]"):
+				writer.add_line("\t" + line)
+			writer.add_line("}")
+			return
+		if(fixed_len == 0):
+			return
+		if(fixed_len != None and fixed_count):
+			writer.add_fixed(fixed_len*fixed_count, lambda offset: [loop + self.get_access_line(encode, field_type, self.offset_pointer(offset, "i", fixed_len), value + "[i]")])
+		elif(fixed_len != None):
+			writer.add_reserve("((uint32_t) " + count_expression + ")*" + str(fixed_len))
+			writer.add_line(loop + self.get_access_line(encode, field_type, self.offset_pointer(0, "i", fixed_len), value + "[i]"))
+		elif(encode):
+			writer.add_line(loop + "if(!" + field_type + "_encode(ostream, &(" + value + "[i]), endianness)) return 0;")
+		else:
+			writer.add_line(loop + "if(!" + field_type + "_decode(istream, &(" + value + "[i]), endianness)) return 0;")
+		
+	def add_packed(self, writer, encode, field, value, count_expression, size_type, size_type_byte_number, count_check):	# Adds the count and the bit-packed elements of a packed field
+		packed_len = "TB_PACKED_LEN(" + count_expression + ", " + str(field.bits) + ")"
+		if(encode):
+			writer.add_reserve(str(size_type_byte_number) + " + " + packed_len)
+			writer.add_line(self.get_access_line(encode, size_type, self.offset_pointer(0), count_expression))
+			writer.add_line("if(!tb_pack_bits(" + self.offset_pointer(size_type_byte_number) + ", " + value + ", " + count_expression + ", " + str(field.bits) + ")) return 0;")
+			return
+		writer.add_fixed(size_type_byte_number, lambda offset: [self.get_access_line(encode, size_type, self.offset_pointer(offset), count_expression)])
+		if(count_check):
+			writer.add_line(count_check)
+		writer.add_reserve(packed_len)
+		writer.add_line("tb_unpack_bits(p, " + value + ", " + count_expression + ", " + str(field.bits) + ");")
+		
+	def create_function_body(self, message, encode):
+		s = "src->" if encode else "dst->"
+		writer = C_SegmentWriter(encode, "\t")
+		for field in message.fields:
+			if(isinstance(field, RequiredField)):
+				self.add_single(writer, encode, field.type, s + field.name)
+			elif(isinstance(field, OptionalField)):
+				writer.add_fixed(1, lambda offset, field=field: [self.get_access_line(encode, 'uint8', self.offset_pointer(offset), s + "has_" + field.name)])
+				writer.add_line("if(" + s + "has_" + field.name + ") {")
+				inner_writer = C_SegmentWriter(encode, writer.indent + "\t")
+				self.add_single(inner_writer, encode, field.type, s + field.name)
+				writer.lines += inner_writer.get_lines()
+				writer.add_line("}")
+			elif(isinstance(field, RepeatedField)):
+				[size_type, size_type_byte_number] = search_size_type(field.size)
+				count = s + field.name + "_count"
+				count_check = "if(" + count + " > " + str(field.size) + ") return 0;"
+				if(field.size == (2**8)**size_type_byte_number - 1):	# The count can't be larger (the check would cause a type-limits warning)
+					count_check = None
+				if(encode and count_check):
+					writer.add_line(count_check)
+				if(isinstance(field, PackedField)):
+					self.add_packed(writer, encode, field, s + field.name, count, size_type, size_type_byte_number, count_check)
+					continue
+				element_len = self.get_fixed_len(field.type)
+				if(encode and element_len):	# The count and the elements are known in advance: only one bounds check
+					writer.add_reserve(str(size_type_byte_number) + " + ((uint32_t) " + count + ")*" + str(element_len))
+					writer.add_line(self.get_access_line(encode, size_type, self.offset_pointer(0), count))
+					writer.add_line("for(uint32_t i = 0; i < " + count + "; i++) " + self.get_access_line(encode, field.type, self.offset_pointer(size_type_byte_number, "i", element_len), s + field.name + "[i]"))
+					continue
+				writer.add_fixed(size_type_byte_number, lambda offset, count=count, size_type=size_type: [self.get_access_line(encode, size_type, self.offset_pointer(offset), count)])
+				if(not encode and count_check):
+					writer.add_line(count_check)
+				self.add_array(writer, encode, field.type, s + field.name, count, None)
+			elif(isinstance(field, FixedRepeatedField)):
+				self.add_array(writer, encode, field.type, s + field.name, str(field.size), field.size)
+			elif(isinstance(field, OneofField)):
+				which = s + "which_" + field.name
+				writer.add_fixed(1, lambda offset, which=which: [self.get_access_line(encode, 'uint8', self.offset_pointer(offset), which)])
+				writer.add_line("switch(" + which + ") {")
+				for inner_field in field.inner_fields:
+					writer.add_line("\tcase " + message.name + "_" + inner_field.name + "_tag:")
+					inner_writer = C_SegmentWriter(encode, writer.indent + "\t\t")
+					self.add_single(inner_writer, encode, inner_field.type, s + field.name + "." + inner_field.name)
+					writer.lines += inner_writer.get_lines()
+					writer.add_line("\t\tbreak;")
+				writer.add_line("\tdefault:")
+				writer.add_line("\t\treturn 0;")
+				writer.add_line("}")
+			else:
+				raise Exception ("Field " + str(field) + " is not supported")
+		return writer.get_lines()
+		
+	def create_fixed_function_body(self, message, encode):	# The body of M_put()/M_get(), all fields have a fixed length
+		s = "src->" if encode else "dst->"
+		lines = []
+		offset = 0
+		for field in message.fields:
+			field_len = self.get_fixed_len(field.type)
+			if(field_len == 0):
+				continue
+			if(isinstance(field, RequiredField)):
+				lines.append("\t" + self.get_access_line(encode, field.type, self.offset_pointer(offset), s + field.name))
+				offset += field_len
+			else:	# FixedRepeatedField
+				lines.append("\tfor(uint32_t i = 0; i < " + str(field.size) + "; i++) " + self.get_access_line(encode, field.type, self.offset_pointer(offset, "i", field_len), s + field.name + "[i]"))
+				offset += field_len*field.size
+		return lines
+		
+	def create_header(self, h_file):
+		h_file.append_line("/**< Straight-line encode/decode functions (same binary representation as tb_encode()/tb_decode() with the _fields-arrays) */")
+		for message in self.messages:
+			fixed_len = self.get_fixed_len(message.name)
+			if(fixed_len != None):
+				h_file.append_line("#define " + message.name + "_ENCODED_LEN " + str(fixed_len))
+				for encode in [True, False]:
+					if(encode):
+						h_file.append_line("static inline void " + message.name + "_put(uint8_t* p, const " + message.name + "* src, tb_endian_t endianness) {")
+					else:
+						h_file.append_line("static inline void " + message.name + "_get(const uint8_t* p, " + message.name + "* dst, tb_endian_t endianness) {")
+					h_file.append_line("\t(void) p; (void) endianness; (void) " + ("src;" if encode else "dst;"))
+					for line in self.create_fixed_function_body(message, encode):
+						h_file.append_line(line)
+					h_file.append_line("}")
+			h_file.append_line("uint8_t " + message.name + "_encode(tb_ostream_t* ostream, const " + message.name + "* src, tb_endian_t endianness);")
+			h_file.append_line("uint8_t " + message.name + "_decode(tb_istream_t* istream, " + message.name + "* dst, tb_endian_t endianness);")
+			h_file.append_line()
+	
+	def create_source(self, c_file):
+		for message in self.messages:
+			fixed_len = self.get_fixed_len(message.name)
+			for encode in [True, False]:
+				if(encode):
+					c_file.append_line("uint8_t " + message.name + "_encode(tb_ostream_t* ostream, const " + message.name + "* src, tb_endian_t endianness) {")
+				else:
+					c_file.append_line("uint8_t " + message.name + "_decode(tb_istream_t* istream, " + message.name + "* dst, tb_endian_t endianness) {")
+				if(fixed_len != None):
+					lines = []
+					if(fixed_len > 0):
+						writer = C_SegmentWriter(encode, "\t")
+						writer.add_reserve(message.name + "_ENCODED_LEN")
+						lines = writer.get_lines()
+						lines.append("\t" + message.name + ("_put(p, src" if encode else "_get(p, dst") + ", endianness);")
+				else:
+					lines = self.create_function_body(message, encode)
+				# Callback-streams have only a small window, so they use the table-driven functions
+				if(encode):
+					lines.insert(0, "\tif(ostream->callback != NULL) return tb_encode(ostream, " + message.name + "_fields, (void*) src, endianness);")
+				else:
+					lines.insert(0, "\tif(istream->callback != NULL) return tb_decode(istream, " + message.name + "_fields, dst, endianness);")
+				if(any("p = tb_" in line for line in lines)):
+					c_file.append_line("\t" + ("uint8_t* p;" if encode else "const uint8_t* p;"))
+				if(any("&varint" in line for line in lines)):
+					c_file.append_line("\tuint64_t varint;")
+				if(not any("endianness" in line for line in lines)):
+					c_file.append_line("\t(void) endianness;")
+				if(len(lines) == 0):
+					c_file.append_line("\t(void) " + ("ostream; (void) src;" if encode else "istream; (void) dst;"))
+				for line in lines:
+					c_file.append_line(line)
+				c_file.append_line("\treturn 1;")
+				c_file.append_line("}")
+				c_file.append_line()
+
+
+class Cpp_Creator(C_Creator):
+	"""Creates a header-only C++ file (option -cpp) for hosts, e.g. the hub that decodes many responses.
+	
+	The structures are the same as the ones of the C-files, but in the namespace tinybuf. For every message M the specialization 
+	tinybuf::MessageTraits<M> (see tinybuf.hpp) is created with the templated functions encode(), decode() and visit(),
+	and the constexpr function max_encoded_len(). So the field layout is known at compile time, no "_fields"-array is interpreted.
+	"""
+	def __init__(self, output_path, output_name, imports, defines, messages):
+		C_Creator.__init__(self, output_path, output_name, imports, defines, messages)
+		
+	def create(self):
+		print "Creating C++-File..."
+		
+		self.h_file = OutputFile(self.output_path + "/" + self.output_name + ".hpp")
+		
+		self.h_file.append_line("#ifndef " + "__" + self.output_name.upper() + "_HPP")
+		self.h_file.append_line("#define " + "__" + self.output_name.upper() + "_HPP")
+		self.h_file.append_line()
+		
+		self.h_file.append_line("#include <stdint.h>")
+		self.h_file.append_line('#include "tinybuf.hpp"')
+		for imp in self.imports:
+			self.h_file.append_line('#include "' + imp.name + '.hpp"')
+		self.h_file.append_line()
+		
+		# The defines and oneof_tags are the same as in the C-header (so both headers can be included)
+		for define in self.defines:
+			self.h_file.append_line("#define " + define.name + " " + str(define.number))
+		self.h_file.append_line()
+		
+		for message in self.messages:
+			self.create_oneof_tags(message)
+		self.h_file.append_line()
+		
+		self.h_file.append_line("namespace tinybuf {")
+		self.h_file.append_line()
+		
+		# A message can only use the messages before it, so the traits can directly follow each structure
+		for message in self.messages:
+			self.create_struct(message)
+			self.h_file.append_line()
+			self.create_traits(message)
+			self.h_file.append_line()
+		
+		self.h_file.append_line("}	// namespace tinybuf")
+		self.h_file.append_line()
+		self.h_file.append_line("#endif")
+		
+		self.h_file.write_to_file()
+		
+	def is_message_type(self, field_type):
+		return (field_type not in PRIMITIVE_FIELD_TYPES) and (field_type not in PACKED_FIELD_TYPE_BITS)
+		
+	def get_max_len_expression(self, field_type):	# Returns the constexpr of the maximal encoded length of a single value of field_type
+		if self.is_message_type(field_type):
+			return "MessageTraits<" + field_type + ">::max_encoded_len()"
+		if field_type in VARINT_FIELD_TYPE_SIZES:
+			return "varint_max_len(" + str(VARINT_FIELD_TYPE_SIZES[field_type]) + ")"
+		return str(PRIMITIVE_FIELD_TYPE_LENS[field_type])
+		
+	def get_max_len_expressions(self, message):
+		expressions = []
+		for field in message.fields:
+			if(isinstance(field, RequiredField)):
+				expressions.append(self.get_max_len_expression(field.type))
+			elif(isinstance(field, OptionalField)):
+				expressions.append("1 + " + self.get_max_len_expression(field.type))
+			elif(isinstance(field, PackedField)):
+				[size_type, size_type_byte_number] = search_size_type(field.size)
+				expressions.append(str(size_type_byte_number) + " + packed_len(" + str(field.size) + ", " + str(field.bits) + ")")
+			elif(isinstance(field, RepeatedField)):
+				[size_type, size_type_byte_number] = search_size_type(field.size)
+				expressions.append(str(size_type_byte_number) + " + " + str(field.size) + "*" + self.get_max_len_expression(field.type))
+			elif(isinstance(field, FixedRepeatedField)):
+				expressions.append(str(field.size) + "*" + self.get_max_len_expression(field.type))
+			elif(isinstance(field, OneofField)):
+				s = self.get_max_len_expression(field.inner_fields[-1].type)
+				for inner_field in reversed(field.inner_fields[:-1]):
+					s = "max_len(" + self.get_max_len_expression(inner_field.type) + ", " + s + ")"
+				expressions.append("1 + " + s)
+		return expressions
+		
+	def get_single_statement(self, encode, field_type, value):	# Returns the call that returns false, if a single value could not be encoded/decoded
+		if self.is_message_type(field_type):
+			if(encode):
+				return "MessageTraits<" + field_type + ">::encode(ostream, " + value + ")"
+			return "MessageTraits<" + field_type + ">::decode(istream, " + value + ")"
+		function = "write" if encode else "read"
+		if field_type in VARINT_FIELD_TYPE_SIZES:
+			function += "_varint" if field_type.startswith('varint') else "_varuint"
+		return ("ostream." if encode else "istream.") + function + "(" + value + ")"
+		
+	def append_check(self, indent, call, precondition = None):	# Appends the lines to return false, if the call fails (and the precondition holds)
+		if(precondition == None):
+			self.h_file.append_line(indent + "if(!" + call + ")")
+		else:
+			self.h_file.append_line(indent + "if(" + precondition + " && !" + call + ")")
+		self.h_file.append_line(indent + "\treturn false;")
+		
+	def append_array(self, encode, indent, field, count):	# Appends the lines to encode/decode count elements of the field
+		if(isinstance(field, PackedField)):
+			function = "ostream.write_packed" if encode else "istream.read_packed"
+			self.append_check(indent, function + "(message." + field.name + ", " + count + ", " + str(field.bits) + ")")
+		elif(self.is_message_type(field.type) or field.type in VARINT_FIELD_TYPE_SIZES):
+			self.h_file.append_line(indent + "for(uint32_t i = 0; i < " + count + "; i++)")
+			self.append_check(indent + "\t", self.get_single_statement(encode, field.type, "message." + field.name + "[i]"))
+		else:
+			function = "ostream.write_array" if encode else "istream.read_array"
+			self.append_check(indent, function + "(message." + field.name + ", " + count + ")")
+		
+	def create_function(self, message, encode):
+		if(encode):
+			self.h_file.append_line("\ttemplate<Endian E> static bool encode(Ostream<E>& ostream, const " + message.name + "& message) {")
+		else:
+			self.h_file.append_line("\ttemplate<Endian E> static bool decode(Istream<E>& istream, " + message.name + "& message) {")
+		if(len(message.fields) == 0):
+			self.h_file.append_line("\t\t(void) " + ("ostream;" if encode else "istream;") + " (void) message;")
+		stream = "ostream.write" if encode else "istream.read"
+		for field in message.fields:
+			if(isinstance(field, RequiredField)):
+				self.append_check("\t\t", self.get_single_statement(encode, field.type, "message." + field.name))
+			elif(isinstance(field, OptionalField)):
+				self.append_check("\t\t", stream + "(message.has_" + field.name + ")")
+				self.append_check("\t\t", self.get_single_statement(encode, field.type, "message." + field.name), "message.has_" + field.name)
+			elif(isinstance(field, RepeatedField)):
+				count = "message." + field.name + "_count"
+				[size_type, size_type_byte_number] = search_size_type(field.size)
+				count_check = (field.size < 2**(8*size_type_byte_number) - 1)	# Otherwise the count always fits (and the compiler would warn)
+				if(encode and count_check):
+					self.h_file.append_line("\t\tif(" + count + " > " + str(field.size) + ")")
+					self.h_file.append_line("\t\t\treturn false;")
+				self.append_check("\t\t", stream + "(" + count + ")")
+				if(not encode and count_check):
+					self.h_file.append_line("\t\tif(" + count + " > " + str(field.size) + ")")
+					self.h_file.append_line("\t\t\treturn false;")
+				self.append_array(encode, "\t\t", field, count)
+			elif(isinstance(field, FixedRepeatedField)):
+				self.append_array(encode, "\t\t", field, str(field.size))
+			elif(isinstance(field, OneofField)):
+				self.append_check("\t\t", stream + "(message.which_" + field.name + ")")
+				self.h_file.append_line("\t\tswitch(message.which_" + field.name + ") {")
+				for inner_field in field.inner_fields:
+					self.h_file.append_line("\t\t\tcase " + str(inner_field.tag) + ":")
+					self.append_check("\t\t\t\t", self.get_single_statement(encode, inner_field.type, "message." + field.name + "." + inner_field.name))
+					self.h_file.append_line("\t\t\t\tbreak;")
+				self.h_file.append_line("\t\t\tdefault:")
+				self.h_file.append_line("\t\t\t\treturn false;")
+				self.h_file.append_line("\t\t}")
+		self.h_file.append_line("\t\treturn true;")
+		self.h_file.append_line("\t}")
+		
+	def create_visit_function(self, message):
+		self.h_file.append_line("\ttemplate<typename V> static void visit(V& visitor, const " + message.name + "& message) {")
+		if(len(message.fields) == 0):
+			self.h_file.append_line("\t\t(void) visitor; (void) message;")
+		for field in message.fields:
+			if(isinstance(field, RequiredField)):
+				self.h_file.append_line('\t\tvisitor.field("' + field.name + '", message.' + field.name + ");")
+			elif(isinstance(field, OptionalField)):
+				self.h_file.append_line('\t\tvisitor.optional("' + field.name + '", message.has_' + field.name + ", message." + field.name + ");")
+			elif(isinstance(field, RepeatedField)):
+				self.h_file.append_line('\t\tvisitor.repeated("' + field.name + '", message.' + field.name + ", (uint32_t) message." + field.name + "_count);")
+			elif(isinstance(field, FixedRepeatedField)):
+				self.h_file.append_line('\t\tvisitor.repeated("' + field.name + '", message.' + field.name + ", (uint32_t) " + str(field.size) + ");")
+			elif(isinstance(field, OneofField)):
+				self.h_file.append_line('\t\tvisitor.begin_oneof("' + field.name + '", message.which_' + field.name + ");")
+				for inner_field in field.inner_fields:
+					self.h_file.append_line('\t\tvisitor.oneof_member("' + inner_field.name + '", message.which_' + field.name + " == " + str(inner_field.tag) + ", message." + field.name + "." + inner_field.name + ");")
+				self.h_file.append_line("\t\tvisitor.end_oneof();")
+		self.h_file.append_line("\t}")
+		
+	def create_traits(self, message):
+		self.h_file.append_line("template<>")
+		self.h_file.append_line("struct MessageTraits<" + message.name + "> {")
+		self.h_file.append_line('\tstatic constexpr const char* name() { return "' + message.name + '"; }')
+		expressions = self.get_max_len_expressions(message)
+		self.h_file.append_line("\tstatic constexpr uint32_t max_encoded_len() { return " + (" + ".join(expressions) if len(expressions) > 0 else "0") + "; }")
+		self.h_file.append_line()
+		self.create_function(message, True)
+		self.h_file.append_line()
+		self.create_function(message, False)
+		self.h_file.append_line()
+		self.create_visit_function(message)
+		self.h_file.append_line("};")
+
+
+
 class Python_Creator:
 	def __init__(self, output_path, output_name, imports, defines, messages, endianness):
 		self.output_path = output_path
@@ -1024,6 +1615,21 @@ class Python_Creator:
 		self.python_file.append_line("\t\tself.buf = b''")
 		self.python_file.append_line("\tdef write(self, data):")
 		self.python_file.append_line("\t\tself.buf += data")
+		self.python_file.append_line("\tdef write_varuint(self, value):")
+		self.python_file.append_line("\t\twhile(value >= 0x80):")
+		self.python_file.append_line("\t\t\tself.buf += struct.pack('B', (value & 0x7F) | 0x80)")
+		self.python_file.append_line("\t\t\tvalue >>= 7")
+		self.python_file.append_line("\t\tself.buf += struct.pack('B', value)")
+		self.python_file.append_line("\tdef write_varint(self, value):")
+		self.python_file.append_line("\t\tself.write_varuint((value << 1) ^ (value >> 63))")
+		self.python_file.append_line("\tdef write_packed(self, values, bits):")
+		self.python_file.append_line("\t\tpacked = 0")
+		self.python_file.append_line("\t\tfor i in range(0, len(values)):")
+		self.python_file.append_line("\t\t\tif(values[i] < 0 or values[i] >> bits):")
+		self.python_file.append_line('\t\t\t\traise Exception("Value does not fit into " + str(bits) + " bits")')
+		self.python_file.append_line("\t\t\tpacked |= values[i] << (i*bits)")
+		self.python_file.append_line("\t\tfor i in range(0, (len(values)*bits + 7)//8):")
+		self.python_file.append_line("\t\t\tself.buf += struct.pack('B', (packed >> (8*i)) & 0xFF)")
 		self.python_file.append_line()
 		
 		# Create Istream-class
@@ -1036,6 +1642,25 @@ class Python_Creator:
 		self.python_file.append_line("\t\tret = self.buf[0:l]")
 		self.python_file.append_line("\t\tself.buf = self.buf[l:]")
 		self.python_file.append_line("\t\treturn ret")
+		self.python_file.append_line("\tdef read_varuint(self, size):")
+		self.python_file.append_line("\t\tvalue = 0")
+		self.python_file.append_line("\t\tfor i in range(0, (size*8 + 6)//7):")
+		self.python_file.append_line("\t\t\tbyte = struct.unpack('B', self.read(1))[0]")
+		self.python_file.append_line("\t\t\tvalue |= (byte & 0x7F) << (7*i)")
+		self.python_file.append_line("\t\t\tif(not (byte & 0x80)):")
+		self.python_file.append_line("\t\t\t\tif(value >> (size*8)):")
+		self.python_file.append_line('\t\t\t\t\traise Exception("Varint does not fit into " + str(size) + " bytes")')
+		self.python_file.append_line("\t\t\t\treturn value")
+		self.python_file.append_line('\t\traise Exception("Varint is too long")')
+		self.python_file.append_line("\tdef read_varint(self, size):")
+		self.python_file.append_line("\t\tvalue = self.read_varuint(size)")
+		self.python_file.append_line("\t\treturn (value >> 1) ^ -(value & 1)")
+		self.python_file.append_line("\tdef read_packed(self, count, bits):")
+		self.python_file.append_line("\t\tdata = self.read((count*bits + 7)//8)")
+		self.python_file.append_line("\t\tpacked = 0")
+		self.python_file.append_line("\t\tfor i in range(0, len(data)):")
+		self.python_file.append_line("\t\t\tpacked |= struct.unpack('B', data[i:i+1])[0] << (8*i)")
+		self.python_file.append_line("\t\treturn [(packed >> (i*bits)) & ((1 << bits) - 1) for i in range(0, count)]")
 		self.python_file.append_line()
 
 		
@@ -1061,7 +1686,9 @@ class Python_Creator:
 	def get_default_value(self, field_type):
 		field_type_values = {"uint8": "0", "int8": "0", "uint16": "0", "int16": "0", 
 							  "uint32": "0", "int32": "0", "uint64": "0", "int64": "0", 
-							  "float": "0", "double": "0"}
+							  "float": "0", "double": "0",
+							  "varuint16": "0", "varint16": "0", "varuint32": "0", "varint32": "0",
+							  "varuint64": "0", "varint64": "0"}
 		
 		if field_type in field_type_values:
 			return field_type_values[field_type]
@@ -1080,6 +1707,8 @@ class Python_Creator:
 					
 		if field_type in field_type_mapping:
 			return field_type_mapping[field_type]
+		elif field_type in VARINT_FIELD_TYPE_SIZES:	# Not encoded via struct, see get_write_statement() and get_read_expression()
+			return field_type
 		else:	# For example in the case of message as field type
 			return None
 	
@@ -1089,6 +1718,20 @@ class Python_Creator:
 								"float": 4, "double": 8}
 								
 		return field_type_lengths[field_type]
+		
+	def get_write_statement(self, field_type, value):	# Returns the statement to write a value of a primitive field_type to the ostream
+		if field_type in VARINT_FIELD_TYPE_SIZES:
+			if field_type.startswith('varint'):
+				return "ostream.write_varint(" + value + ")"
+			return "ostream.write_varuint(" + value + ")"
+		return "ostream.write(" + "struct.pack('" + self.get_field_type_mapping(field_type) + "', " + value + "))"
+		
+	def get_read_expression(self, field_type):	# Returns the expression to read a value of a primitive field_type from the istream
+		if field_type in VARINT_FIELD_TYPE_SIZES:
+			if field_type.startswith('varint'):
+				return "istream.read_varint(" + str(VARINT_FIELD_TYPE_SIZES[field_type]) + ")"
+			return "istream.read_varuint(" + str(VARINT_FIELD_TYPE_SIZES[field_type]) + ")"
+		return "struct.unpack('" + self.get_field_type_mapping(field_type) + "', " + "istream.read(" + str(self.get_field_type_len(field_type)) + "))[0]"
 			
 	def create_encode_functions(self, message):
 		# Create the encode function
@@ -1124,7 +1767,7 @@ class Python_Creator:
 				if(mapped_field_type == None): # is a message
 					self.python_file.append_line("\t\t" + "self." + field.name + ".encode_internal(ostream)")
 				else:
-					self.python_file.append_line("\t\t" + "ostream.write(" + "struct.pack('" + mapped_field_type + "', " + "self." + field.name + "))")		
+					self.python_file.append_line("\t\t" + self.get_write_statement(field.type, "self." + field.name))		
 					
 			elif(isinstance(field, OptionalField)): # Is optional field
 				self.python_file.append_line("\t\t" + "ostream.write(" + "struct.pack('" + self.get_field_type_mapping('uint8') + "', " + "self.has_" + field.name + "))")
@@ -1133,18 +1776,22 @@ class Python_Creator:
 				if(mapped_field_type == None): # is a message
 					self.python_file.append_line("\t\t\t" + "self." + field.name + ".encode_internal(ostream)")
 				else:
-					self.python_file.append_line("\t\t\t" + "ostream.write(" + "struct.pack('" + mapped_field_type + "', " + "self." + field.name + "))")
+					self.python_file.append_line("\t\t\t" + self.get_write_statement(field.type, "self." + field.name))
 				
 			elif(isinstance(field, RepeatedField)): # Is repeated field			
 				[size_type, size_type_number_bytes] = search_size_type(field.size)
 				self.python_file.append_line("\t\t" + "count = len(" + "self." + field.name + ")")
 				self.python_file.append_line("\t\t" + "ostream.write(" + "struct.pack('" + self.get_field_type_mapping(size_type) + "', " + "count" + "))")
+				if(isinstance(field, PackedField)):
+					self.python_file.append_line("\t\t" + "ostream.write_packed(" + "self." + field.name + ", " + str(field.bits) + ")")
+					self.python_file.append_line()
+					continue
 				self.python_file.append_line("\t\t" + "for i in range(0, " + "count" + "):")
 				mapped_field_type = self.get_field_type_mapping(field.type)				
 				if(mapped_field_type == None): # is a message
 					self.python_file.append_line("\t\t\t" + "self." + field.name + "[i].encode_internal(ostream)" )
 				else:
-					self.python_file.append_line("\t\t\t" + "ostream.write(" + "struct.pack('" + mapped_field_type + "', " + "self." + field.name + "[i]))")
+					self.python_file.append_line("\t\t\t" + self.get_write_statement(field.type, "self." + field.name + "[i]"))
 					
 			elif(isinstance(field, FixedRepeatedField)): # Is fixed repeated field
 				self.python_file.append_line("\t\t" + "count = " + str(field.size))
@@ -1154,7 +1801,7 @@ class Python_Creator:
 				if(mapped_field_type == None): # is a message
 					self.python_file.append_line("\t\t\t" + "self." + field.name + "[i].encode_internal(ostream)" )
 				else:
-					self.python_file.append_line("\t\t\t" + "ostream.write(" + "struct.pack('" + mapped_field_type + "', " + "self." + field.name + "[i]))")
+					self.python_file.append_line("\t\t\t" + self.get_write_statement(field.type, "self." + field.name + "[i]"))
 				
 			else:
 				raise Exception ("Field " + str(field) + " is not supported")
@@ -1206,7 +1853,7 @@ class Python_Creator:
 					self.python_file.append_line("\t\t" + "self." + field.name + " = " + field.type + "()")
 					self.python_file.append_line("\t\t" + "self." + field.name + ".decode_internal(istream)")
 				else:
-					self.python_file.append_line("\t\t" + "self." + field.name + "= struct.unpack('" + mapped_field_type + "', "  + "istream.read(" + str(self.get_field_type_len(field.type)) + "))[0]")
+					self.python_file.append_line("\t\t" + "self." + field.name + "= " + self.get_read_expression(field.type))
 					
 			elif(isinstance(field, OptionalField)): # Is optional field
 				self.python_file.append_line("\t\t" + "self.has_" + field.name + "= struct.unpack('" + self.get_field_type_mapping('uint8') + "', " + "istream.read(" + "1" + "))[0]" )
@@ -1217,12 +1864,16 @@ class Python_Creator:
 					self.python_file.append_line("\t\t\t" + "self." + field.name + " = " + field.type + "()")
 					self.python_file.append_line("\t\t\t" + "self." + field.name + ".decode_internal(istream)")
 				else:
-					self.python_file.append_line("\t\t\t" + "self." + field.name + "= struct.unpack('" + mapped_field_type + "', "  + "istream.read(" + str(self.get_field_type_len(field.type)) + "))[0]")
+					self.python_file.append_line("\t\t\t" + "self." + field.name + "= " + self.get_read_expression(field.type))
 			
 			
 			elif(isinstance(field, RepeatedField)): # Is repeated field			
 				[size_type, size_type_number_bytes] = search_size_type(field.size)
 				self.python_file.append_line("\t\t" + "count = struct.unpack('" + self.get_field_type_mapping(size_type) + "', " + "istream.read(" + str(size_type_number_bytes) + "))[0]" )
+				if(isinstance(field, PackedField)):
+					self.python_file.append_line("\t\t" + "self." + field.name + " = istream.read_packed(count, " + str(field.bits) + ")")
+					self.python_file.append_line()
+					continue
 				self.python_file.append_line("\t\t" + "for i in range(0, " + "count" + "):")
 				
 				mapped_field_type = self.get_field_type_mapping(field.type)
@@ -1231,7 +1882,7 @@ class Python_Creator:
 					self.python_file.append_line("\t\t\t" + "tmp.decode_internal(istream)")
 					self.python_file.append_line("\t\t\t" + "self." + field.name + ".append(tmp)")
 				else:
-					self.python_file.append_line("\t\t\t" + "self." + field.name + ".append(struct.unpack('" + mapped_field_type + "', " + "istream.read(" +  str(self.get_field_type_len(field.type)) + "))[0])")
+					self.python_file.append_line("\t\t\t" + "self." + field.name + ".append(" + self.get_read_expression(field.type) + ")")
 			
 			elif(isinstance(field, FixedRepeatedField)): # Is fixed repeated field
 				self.python_file.append_line("\t\t" + "count = " + str(field.size) )
@@ -1244,7 +1895,7 @@ class Python_Creator:
 					self.python_file.append_line("\t\t\t" + "tmp.decode_internal(istream)")
 					self.python_file.append_line("\t\t\t" + "self." + field.name + ".append(tmp)")
 				else:
-					self.python_file.append_line("\t\t\t" + "self." + field.name + ".append(struct.unpack('" + mapped_field_type + "', " + "istream.read(" +  str(self.get_field_type_len(field.type)) + "))[0])")				
+					self.python_file.append_line("\t\t\t" + "self." + field.name + ".append(" + self.get_read_expression(field.type) + ")")				
 			else:
 				raise Exception ("Field " + str(field) + " is not supported")
 					
@@ -1302,7 +1953,7 @@ class Python_Creator:
 					if(mapped_field_type == None): # is a message
 						self.python_file.append_line("\t\t\t" + "self." + inner_field.name + ".encode_internal(ostream)")
 					else:
-						self.python_file.append_line("\t\t\t" + "ostream.write(" + "struct.pack('" + mapped_field_type + "', " + "self." + inner_field.name + "))")
+						self.python_file.append_line("\t\t\t" + self.get_write_statement(inner_field.type, "self." + inner_field.name))
 					
 					self.python_file.append_line()
 						
@@ -1335,7 +1986,7 @@ class Python_Creator:
 						self.python_file.append_line("\t\t\t" + "self." + inner_field.name + " = " + inner_field.type + "()")
 						self.python_file.append_line("\t\t\t" + "self." + inner_field.name + ".decode_internal(istream)")				
 					else:
-						self.python_file.append_line("\t\t\t" + "self." + inner_field.name + "= struct.unpack('" + mapped_field_type + "', "  + "istream.read(" + str(self.get_field_type_len(inner_field.type)) + "))[0]")
+						self.python_file.append_line("\t\t\t" + "self." + inner_field.name + "= " + self.get_read_expression(inner_field.type))
 					
 					self.python_file.append_line()		
 				
@@ -1385,12 +2036,13 @@ class Python_Creator:
 
 if __name__ == '__main__':
 	if(len(sys.argv) < 5):
-		raise Exception("Script has to be called with: " + sys.argv[0] + " " + str(SUPPORTED_OUTPUT_FORMATS) + " 'protocol-file' 'output-path' 'output-file name'" + " " + str(SUPPORTED_ENDIANNESS))
+		raise Exception("Script has to be called with: " + sys.argv[0] + " " + str(SUPPORTED_OUTPUT_FORMATS) + " 'protocol-file' 'output-path' 'output-file name'" + " " + str(SUPPORTED_ENDIANNESS) + " [" + STRAIGHT_LINE_OPTION + "]")
 
 	output_format = sys.argv[1]
 	file = sys.argv[2]
 	output_path = sys.argv[3]
 	output_name = sys.argv[4]
+	options = sys.argv[5:]
 	
 	
 	print "Output name"
@@ -1406,9 +2058,13 @@ if __name__ == '__main__':
 	
 	# Create the source code
 	if(output_format == '-c'):
-		C_Creator(output_path, output_name, Imports, Defines, Messages)
+		straight_line = STRAIGHT_LINE_OPTION in options
+		imported_messages = parse_imported_messages(file) if straight_line else []
+		C_Creator(output_path, output_name, Imports, Defines, Messages, straight_line, imported_messages)
+	elif(output_format == '-cpp'):
+		Cpp_Creator(output_path, output_name, Imports, Defines, Messages)
 	elif(output_format == '-python'):
-		endianness = BIG_ENDIANNESS if sys.argv[5] == '-be' else LITTLE_ENDIANNESS
+		endianness = BIG_ENDIANNESS if options[0] == '-be' else LITTLE_ENDIANNESS
 		Python_Creator(output_path, output_name, Imports, Defines, Messages, endianness)
 	
 	
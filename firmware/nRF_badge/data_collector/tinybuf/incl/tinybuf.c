@@ -2,6 +2,19 @@
 #include <string.h>
 #include "stdio.h"
 
+#ifdef TRACE_ENABLE
+#include "trace_lib.h"
+#else
+#define TRACE_BEGIN(event, arg)
+#define TRACE_END(event, arg)
+#endif
+
+
+#if defined(__BYTE_ORDER__)
+/**< The endianness of the system is known at compile time, so the check for the conversion is optimized away */
+#define SYSTEM_ENDIANNESS	((__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__) ? TB_BIG_ENDIAN : TB_LITTLE_ENDIAN)
+#else
+#define SYSTEM_ENDIANNESS	test_endianness()
 
 /**@brief Function to retrieve the endianness of the system.
  *
@@ -21,37 +34,184 @@ static tb_endian_t test_endianness(void) {
 		return TB_LITTLE_ENDIAN;
 	}
 }
+#endif
+
+
+#if defined(__GNUC__)
+/**< Compiles to REV16/REV on ARM and to rol/bswap on x86 */
+#define SWAP_16(x)	__builtin_bswap16(x)
+#define SWAP_32(x)	__builtin_bswap32(x)
+#define SWAP_64(x)	__builtin_bswap64(x)
+#else
+#define SWAP_16(x)	((uint16_t) (((x) >> 8) | ((x) << 8)))
+#define SWAP_32(x)	((((x) >> 24) & 0xFF) | (((x) >> 8) & 0xFF00) | (((x) << 8) & 0xFF0000) | ((x) << 24))
+#define SWAP_64(x)	((((uint64_t) SWAP_32((uint32_t) (x))) << 32) | SWAP_32((uint32_t) ((x) >> 32)))
+#endif
  
 
 
-/**@brief Function to converts endiannes of input-data if necessary.
+/**@brief Function to copy an array of data entries and to convert their endianness if necessary.
+ *
+ * @details	If the endianness of the system is the desired endianness (or the entries are only one byte), 
+ *			the whole array is copied with memcpy. Otherwise the entries are swapped word-wise.
+ *			The data don't need to be aligned.
  *
  * @param[in]	data_in				Pointer to input-data.
- * @param[out]	data_out			Pointer to output-data.
- * @param[in]	data_size			Size of the data to convert.
+ * @param[out]	data_out			Pointer to output-data (must not overlap with the input-data).
+ * @param[in]	data_size			Size of one data entry.
+ * @param[in]	len					Number of data entries.
  * @param[in] 	desired_endianness	The desired endianness of the output-data.
  */
-static void convert_endianness(uint8_t* data_in, uint8_t* data_out, uint8_t data_size, tb_endian_t desired_endianness) {
-	// First check the endiannes, to check whether we have to swap the entries or not
-	static uint8_t endian_test_done = 0;
-	static tb_endian_t endianness = TB_LITTLE_ENDIAN;
-	if(endian_test_done == 0) {
-		endian_test_done = 1;
-		endianness = test_endianness();
+static void convert_endianness(const uint8_t* data_in, uint8_t* data_out, uint8_t data_size, uint32_t len, tb_endian_t desired_endianness) {
+	if(SYSTEM_ENDIANNESS == desired_endianness || data_size == 1) {
+		memcpy(data_out, data_in, ((uint32_t) data_size)*len);
+		return;
 	}
 	
-	if(endianness != desired_endianness) {
-		// Swap array entries to create array with correct endianness
-		for(uint8_t k = 0; k < data_size; k++) {
-			data_out[data_size-k-1] = data_in[k];
-		}
-	} else {
-		for(uint8_t k = 0; k < data_size; k++) {
-			data_out[k] = data_in[k];
+	switch(data_size) {
+		case 2:
+			for(uint32_t i = 0; i < len; i++) {
+				uint16_t tmp;
+				memcpy(&tmp, &data_in[2*i], 2);
+				tmp = SWAP_16(tmp);
+				memcpy(&data_out[2*i], &tmp, 2);
+			}
+			break;
+		case 4:
+			for(uint32_t i = 0; i < len; i++) {
+				uint32_t tmp;
+				memcpy(&tmp, &data_in[4*i], 4);
+				tmp = SWAP_32(tmp);
+				memcpy(&data_out[4*i], &tmp, 4);
+			}
+			break;
+		case 8:
+			for(uint32_t i = 0; i < len; i++) {
+				uint64_t tmp;
+				memcpy(&tmp, &data_in[8*i], 8);
+				tmp = SWAP_64(tmp);
+				memcpy(&data_out[8*i], &tmp, 8);
+			}
+			break;
+		default:
+			// Swap array entries to create array with correct endianness
+			for(uint32_t i = 0; i < len; i++) {
+				for(uint8_t k = 0; k < data_size; k++) {
+					data_out[data_size-k-1] = data_in[k];
+				}
+				data_in += data_size;
+				data_out += data_size;
+			}
+			break;
+	}
+}
+
+/**@brief Function to read the (native) count of a repeated field from a structure.
+ *
+ * @param[in]	count_ptr		Pointer to the count-entry in the structure.
+ * @param[in]	count_size		Size of the count-entry.
+ *
+ * @retval		The count.
+ */
+static uint32_t get_count(const void* count_ptr, uint32_t count_size) {
+	switch(count_size) {
+		case 1:	return *((const uint8_t*) count_ptr);
+		case 2:	return *((const uint16_t*) count_ptr);
+		default: return *((const uint32_t*) count_ptr);
+	}
+}
+
+/**@brief Function to check whether a message consists only of numbers of the same size without any padding.
+ *
+ * @details	Arrays of such messages (e.g. AccelerometerData or AccelerometerRawData) have the same binary representation
+ *			as an array of numbers, so they can be converted in bulk instead of encoding/decoding each message recursively.
+ *			Only required- and fixed_repeated-fields (also of nested messages) are allowed.
+ *
+ * @param[in]	fields			Pointer to the array of structure-fields of the message.
+ * @param[in]	struct_size		Size of the structure of the message.
+ *
+ * @retval		The size of the numbers, or 0 if the message has another layout.
+ */
+static uint8_t get_uniform_data_size(const tb_field_t fields[], uint32_t struct_size) {
+	uint8_t data_size = 0;
+	uint32_t offset = 0;
+	for(uint8_t i = 0; fields[i].type != 0; i++) {
+		const tb_field_t* field = &fields[i];
+		if(field->data_offset != offset)
+			return 0;
+		uint32_t number = (field->type & FIELD_TYPE_FIXED_REPEATED) ? field->array_size : 1;
+		if(!(field->type & (FIELD_TYPE_REQUIRED | FIELD_TYPE_FIXED_REPEATED)) || (field->type & (DATA_TYPE_VARINT | DATA_TYPE_VARUINT)))
+			return 0;
+		
+		uint8_t field_data_size = (uint8_t) field->data_size;
+		if(field->type & DATA_TYPE_MESSAGE) {
+			field_data_size = get_uniform_data_size((const tb_field_t*) field->ptr, field->data_size);
+			number *= (field_data_size > 0) ? (field->data_size / field_data_size) : 0;
 		}
+		if(field_data_size == 0 || (data_size != 0 && field_data_size != data_size))
+			return 0;
+		data_size = field_data_size;
+		offset += number*data_size;
+	}
+	return (offset == struct_size) ? data_size : 0;
+}
+
+
+
+
+
+/**@brief Function to load a (native) integer from a structure.
+ *
+ * @param[in]	data		Pointer to the integer.
+ * @param[in]	data_size	Size of the integer (1, 2, 4 or 8).
+ * @param[in]	is_signed	Flag if the integer is signed (then it is sign-extended to 64 bit).
+ *
+ * @retval		The integer.
+ */
+static uint64_t load_integer(const uint8_t* data, uint8_t data_size, uint8_t is_signed) {
+	uint64_t value = 0;
+	switch(data_size) {
+		case 1: { uint8_t tmp; memcpy(&tmp, data, 1); value = tmp; } break;
+		case 2: { uint16_t tmp; memcpy(&tmp, data, 2); value = tmp; } break;
+		case 4: { uint32_t tmp; memcpy(&tmp, data, 4); value = tmp; } break;
+		default: memcpy(&value, data, 8); break;
+	}
+	if(is_signed && data_size < 8 && (value >> (8*data_size - 1)))
+		value |= UINT64_MAX << (8*data_size);
+	return value;
+}
+
+/**@brief Function to store an integer (truncated to data_size) into a structure.
+ *
+ * @param[out]	data		Pointer to the integer.
+ * @param[in]	data_size	Size of the integer (1, 2, 4 or 8).
+ * @param[in]	value		The value to store.
+ */
+static void store_integer(uint8_t* data, uint8_t data_size, uint64_t value) {
+	switch(data_size) {
+		case 1: { uint8_t tmp = (uint8_t) value; memcpy(data, &tmp, 1); } break;
+		case 2: { uint16_t tmp = (uint16_t) value; memcpy(data, &tmp, 2); } break;
+		case 4: { uint32_t tmp = (uint32_t) value; memcpy(data, &tmp, 4); } break;
+		default: memcpy(data, &value, 8); break;
 	}
 }
 
+/**@brief Function to retrieve the maximum number of bytes a data entry of a field needs in the output-stream.
+ */
+static uint32_t get_max_data_len(const tb_field_t* field) {
+	if(field->type & (DATA_TYPE_VARINT | DATA_TYPE_VARUINT))
+		return TB_VARINT_MAX_LEN(field->data_size);
+	return field->data_size;
+}
+
+/**@brief Function to retrieve the maximum number of bytes number data entries of a (primitive) field need in the output-stream.
+ */
+static uint32_t get_max_array_len(const tb_field_t* field, uint32_t number) {
+	if(field->type & DATA_TYPE_PACKED)
+		return TB_PACKED_LEN(number, TB_PACKED_BITS(field->type));
+	return number * get_max_data_len(field);
+}
+
 
 
 
@@ -64,10 +224,45 @@ static void convert_endianness(uint8_t* data_in, uint8_t* data_out, uint8_t data
  * @retval 		tb_ostream_t	Output-stream structure.
  */
 tb_ostream_t tb_ostream_from_buffer(uint8_t* buf, uint32_t buf_size) {
-	tb_ostream_t ostream = {buf, buf_size, 0};
+	tb_ostream_t ostream = {buf, buf_size, 0, NULL, NULL, 0};
 	return ostream;
 }
 
+tb_ostream_t tb_ostream_from_callback(tb_ostream_callback_t callback, void* state, uint8_t* window, uint32_t window_size) {
+	tb_ostream_t ostream = {window, window_size, 0, callback, state, 0};
+	return ostream;
+}
+
+uint8_t tb_ostream_flush(tb_ostream_t* ostream) {
+	uint32_t len = ostream->bytes_written - ostream->bytes_flushed;
+	if(ostream->callback == NULL || len == 0)
+		return 1;
+	ostream->bytes_flushed = ostream->bytes_written;
+	return ostream->callback(ostream, ostream->buf, len);
+}
+
+/**< Pointer to the current position of the output-stream in its buffer */
+#define OSTREAM_POS(ostream)	(&((ostream)->buf[(ostream)->bytes_written - (ostream)->bytes_flushed]))
+
+/**@brief Function to retrieve the free space at the current position of the output-stream.
+ *
+ * @details	If there are less than min_len free bytes in the window of a callback-stream, the window is flushed before.
+ *
+ * @param[in]	ostream		Pointer to output-stream structure.
+ * @param[in]	min_len		The number of bytes that are needed at least.
+ *
+ * @retval 		The number of free bytes at OSTREAM_POS(), or 0 if there are less than min_len.
+ */
+static uint32_t get_ostream_space(tb_ostream_t* ostream, uint32_t min_len) {
+	uint32_t space = ostream->buf_size - (ostream->bytes_written - ostream->bytes_flushed);
+	if(space < min_len && ostream->callback != NULL) {
+		if(!tb_ostream_flush(ostream))
+			return 0;
+		space = ostream->buf_size;
+	}
+	return (space >= min_len) ? space : 0;
+}
+
 /**@brief Function to write data to ostream.
  *
  * @param[in]	ostream		Pointer to output-stream structure.
@@ -78,16 +273,18 @@ tb_ostream_t tb_ostream_from_buffer(uint8_t* buf, uint32_t buf_size) {
  * @retval		0			On failure, due to buffer limitations.
  */
 static uint8_t tb_write_to_ostream(tb_ostream_t* ostream, uint8_t* data, uint32_t len) {
-	if(ostream->bytes_written + len > ostream->buf_size)
+	// Data that don't fit into the window are handed directly to the callback, without copying them
+	if(ostream->callback != NULL && len >= ostream->buf_size) {
+		if(!tb_ostream_flush(ostream) || !ostream->callback(ostream, data, len))
+			return 0;
+		ostream->bytes_written += len;
+		ostream->bytes_flushed = ostream->bytes_written;
+		return 1;
+	}
+	if(get_ostream_space(ostream, len) == 0)
 		return 0;
 	
-	memcpy(&(ostream->buf[ostream->bytes_written]), data, len);
-	/*
-	printf("Written %u bytes to ostream: {", len);
-	for(uint32_t i = ostream->bytes_written; i < ostream->bytes_written+len; i++)
-		printf("0x%X, ", ostream->buf[i]);
-	printf("}\n");
-	*/
+	memcpy(OSTREAM_POS(ostream), data, len);
 	ostream->bytes_written += len;	
 	return 1;
 }
@@ -105,12 +302,99 @@ static uint8_t tb_write_to_ostream(tb_ostream_t* ostream, uint8_t* data, uint32_
  * @retval		0			On failure, due to buffer limitations.
  */
 static uint8_t tb_write_to_ostream_big_endian(tb_ostream_t* ostream, uint8_t* data, uint8_t data_size, uint32_t len, tb_endian_t ouput_endianness) {
-	uint8_t tmp[data_size];
+	// Without conversion, the data can be handed directly to the callback (if they don't fit into the window)
+	if(ostream->callback != NULL && (data_size == 1 || ouput_endianness == SYSTEM_ENDIANNESS))
+		return tb_write_to_ostream(ostream, data, ((uint32_t) data_size)*len);
 	
+	// In one piece for buffer-streams, in pieces of the free window space for callback-streams
+	uint32_t min_len = (ostream->callback != NULL) ? data_size : ((uint32_t) data_size)*len;
+	while(len > 0) {
+		uint32_t number = get_ostream_space(ostream, min_len)/data_size;
+		if(number == 0)
+			return 0;
+		if(number > len)
+			number = len;
+		convert_endianness(data, OSTREAM_POS(ostream), data_size, number, ouput_endianness);
+		ostream->bytes_written += ((uint32_t) data_size)*number;
+		data += ((uint32_t) data_size)*number;
+		len -= number;
+	}
+	return 1;
+}
+
+
+
+uint8_t tb_encode_varuint(tb_ostream_t* ostream, uint64_t value) {
+	uint8_t encoded[TB_VARINT_MAX_LEN(8)];
+	uint32_t len = 0;
+	do {
+		uint8_t byte = (uint8_t) (value & 0x7F);
+		value >>= 7;
+		if(value)
+			byte |= 0x80;
+		encoded[len++] = byte;
+	} while(value);
+	return tb_write_to_ostream(ostream, encoded, len);
+}
+
+uint8_t tb_pack_bits(uint8_t* packed, const uint8_t* values, uint32_t number, uint8_t bits) {
+	memset(packed, 0, TB_PACKED_LEN(number, bits));
+	uint32_t bit_pos = 0;
+	for(uint32_t i = 0; i < number; i++, bit_pos += bits) {
+		uint8_t value = values[i];
+		if(value >> bits)
+			return 0;
+		uint32_t byte_pos = bit_pos >> 3;
+		uint8_t shift = (uint8_t) (bit_pos & 0x07);
+		packed[byte_pos] |= (uint8_t) (value << shift);
+		if(shift + bits > 8)	// The value continues in the next byte
+			packed[byte_pos + 1] = (uint8_t) (value >> (8 - shift));
+	}
+	return 1;
+}
+
+/**@brief Function to write numbers of a field to the output-stream.
+ *
+ * @details	Varint-fields are LEB128-encoded (signed ones zigzag-encoded before), 
+ *			all other numbers are written with their binary representation in the desired endianness.
+ *
+ * @param[in]	ostream		Pointer to output-stream structure.
+ * @param[in]	type		The type of the field.
+ * @param[in]	data		Pointer to the numbers.
+ * @param[in]	data_size	Size of one number.
+ * @param[in]	len			Number of numbers.
+ * @param[in] 	output_endianness	The desired endianness of the output-data.
+ *
+ * @retval 		1			On success.
+ * @retval		0			On failure, due to buffer limitations.
+ */
+static uint8_t tb_write_numbers_to_ostream(tb_ostream_t* ostream, uint16_t type, uint8_t* data, uint8_t data_size, uint32_t len, tb_endian_t output_endianness) {
+	if(type & DATA_TYPE_PACKED) {
+		// For callback-streams in groups of 8 values (bits bytes), that fit into the free window space
+		uint8_t bits = TB_PACKED_BITS(type);
+		while(len > 0) {
+			uint32_t packed_len = TB_PACKED_LEN(len, bits);
+			uint32_t space = get_ostream_space(ostream, (ostream->callback != NULL && packed_len > bits) ? bits : packed_len);
+			uint32_t number = (space >= packed_len) ? len : (space/bits)*8;
+			if(number == 0)
+				return 0;
+			if(!tb_pack_bits(OSTREAM_POS(ostream), data, number, bits))
+				return 0;
+			ostream->bytes_written += TB_PACKED_LEN(number, bits);
+			data += number;
+			len -= number;
+		}
+		return 1;
+	}
+	if(!(type & (DATA_TYPE_VARINT | DATA_TYPE_VARUINT)))
+		return tb_write_to_ostream_big_endian(ostream, data, data_size, len, output_endianness);
+	
+	uint8_t is_signed = (type & DATA_TYPE_VARINT) ? 1 : 0;
 	for(uint32_t i = 0; i < len; i++) {
-		uint8_t* cur_data = data + (((uint32_t)data_size)*i);
-		convert_endianness(cur_data, tmp, data_size, ouput_endianness);
-		if(!tb_write_to_ostream(ostream, tmp, data_size))
+		uint64_t value = load_integer(data + ((uint32_t) data_size)*i, data_size, is_signed);
+		if(is_signed)
+			value = tb_zigzag_encode((int64_t) value);
+		if(!tb_encode_varuint(ostream, value))
 			return 0;
 	}
 	return 1;
@@ -126,10 +410,46 @@ static uint8_t tb_write_to_ostream_big_endian(tb_ostream_t* ostream, uint8_t* da
  * @retval 		tb_istream_t	Input-stream structure.
  */
 tb_istream_t tb_istream_from_buffer(uint8_t* buf, uint32_t buf_size) {
-	tb_istream_t istream = {buf, buf_size, 0};
+	tb_istream_t istream = {buf, buf_size, 0, NULL, NULL, 0, buf_size};
+	return istream;
+}
+
+tb_istream_t tb_istream_from_callback(tb_istream_callback_t callback, void* state, uint8_t* window, uint32_t window_size) {
+	tb_istream_t istream = {window, 0, 0, callback, state, 0, window_size};
 	return istream;
 }
 
+/**< Pointer to the current position of the input-stream in its buffer */
+#define ISTREAM_POS(istream)	(&((istream)->buf[(istream)->bytes_read - (istream)->bytes_discarded]))
+
+/**@brief Function to retrieve the number of available bytes at the current position of the input-stream.
+ *
+ * @details	If there are less than min_len bytes in the window of a callback-stream, the unread bytes 
+ *			are moved to the beginning of the window and the window is refilled by the callback.
+ *
+ * @param[in]	istream		Pointer to input-stream structure.
+ * @param[in]	min_len		The number of bytes that are needed at least.
+ *
+ * @retval 		The number of available bytes at ISTREAM_POS(), or 0 if there are less than min_len.
+ */
+static uint32_t get_istream_available(tb_istream_t* istream, uint32_t min_len) {
+	uint32_t pos = istream->bytes_read - istream->bytes_discarded;
+	uint32_t available = istream->buf_size - pos;
+	if(available < min_len && istream->callback != NULL && min_len <= istream->window_size) {
+		memmove(istream->buf, &(istream->buf[pos]), available);
+		istream->bytes_discarded = istream->bytes_read;
+		istream->buf_size = available;
+		while(istream->buf_size < min_len) {
+			uint32_t len = istream->callback(istream, &(istream->buf[istream->buf_size]), istream->window_size - istream->buf_size);
+			if(len == 0)
+				break;
+			istream->buf_size += len;
+		}
+		available = istream->buf_size;
+	}
+	return (available >= min_len) ? available : 0;
+}
+
 /**@brief Function to read data from the input-stream.
  *
  * @param[in]	istream		Pointer to input-stream structure.
@@ -140,17 +460,19 @@ tb_istream_t tb_istream_from_buffer(uint8_t* buf, uint32_t buf_size) {
  * @retval		0			On failure, due to buffer limitations.
  */
 static uint8_t tb_read_from_istream(tb_istream_t* istream, uint8_t* data, uint32_t len) {
-	if(istream->bytes_read + len > istream->buf_size)
-		return 0;
-	
-	memcpy(data, &(istream->buf[istream->bytes_read]), len);
-	/*
-	printf("Read %u bytes from istream: {", len);
-	for(uint32_t i = istream->bytes_read; i < istream->bytes_read+len; i++)
-		printf("0x%X, ", istream->buf[i]);
-	printf("}\n");
-	*/
-	istream->bytes_read += len;	
+	// In one piece for buffer-streams, in pieces of the window for callback-streams
+	uint32_t min_len = (istream->callback != NULL) ? 1 : len;
+	while(len > 0) {
+		uint32_t number = get_istream_available(istream, min_len);
+		if(number == 0)
+			return 0;
+		if(number > len)
+			number = len;
+		memcpy(data, ISTREAM_POS(istream), number);
+		istream->bytes_read += number;
+		data += number;
+		len -= number;
+	}
 	return 1;
 }
 
@@ -166,14 +488,93 @@ static uint8_t tb_read_from_istream(tb_istream_t* istream, uint8_t* data, uint32
  * @retval		0			On failure, due to buffer limitations.
  */
 static uint8_t tb_read_from_istream_little_endian(tb_istream_t* istream, uint8_t* data, uint8_t data_size, uint32_t len, tb_endian_t input_endianness) {
-	uint8_t tmp[data_size];
+	uint32_t min_len = (istream->callback != NULL) ? data_size : ((uint32_t) data_size)*len;
+	while(len > 0) {
+		uint32_t number = get_istream_available(istream, min_len)/data_size;
+		if(number == 0)
+			return 0;
+		if(number > len)
+			number = len;
+		convert_endianness(ISTREAM_POS(istream), data, data_size, number, input_endianness);
+		istream->bytes_read += ((uint32_t) data_size)*number;
+		data += ((uint32_t) data_size)*number;
+		len -= number;
+	}
+	return 1;
+}
+
+
+uint8_t tb_decode_varuint(tb_istream_t* istream, uint64_t* value, uint8_t data_size) {
+	uint64_t result = 0;
+	uint32_t max_len = TB_VARINT_MAX_LEN(data_size);
+	for(uint32_t i = 0; i < max_len; i++) {
+		if(get_istream_available(istream, 1) == 0)
+			return 0;
+		uint8_t byte = *ISTREAM_POS(istream);
+		istream->bytes_read++;
+		result |= ((uint64_t) (byte & 0x7F)) << (7*i);
+		if(!(byte & 0x80)) {
+			// Check that the value fits into data_size bytes (the last byte of a 64 bit value may only contain one bit)
+			if((data_size < 8 && (result >> (8*data_size)) != 0) || (data_size >= 8 && i == 9 && byte > 1))
+				return 0;
+			*value = result;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+void tb_unpack_bits(const uint8_t* packed, uint8_t* values, uint32_t number, uint8_t bits) {
+	uint8_t mask = (uint8_t) ((1 << bits) - 1);
+	uint32_t bit_pos = 0;
+	for(uint32_t i = 0; i < number; i++, bit_pos += bits) {
+		uint32_t byte_pos = bit_pos >> 3;
+		uint8_t shift = (uint8_t) (bit_pos & 0x07);
+		uint16_t value = (uint16_t) (packed[byte_pos] >> shift);
+		if(shift + bits > 8)
+			value |= (uint16_t) (((uint16_t) packed[byte_pos + 1]) << (8 - shift));
+		values[i] = (uint8_t) (value & mask);
+	}
+}
+
+/**@brief Function to read numbers of a field from the input-stream (the counterpart of tb_write_numbers_to_ostream()).
+ *
+ * @param[in]	istream		Pointer to input-stream structure.
+ * @param[in]	type		The type of the field.
+ * @param[in]	data		Pointer to the numbers where the read data should be stored to.
+ * @param[in]	data_size	Size of one number.
+ * @param[in]	len			Number of numbers.
+ * @param[in] 	input_endianness	The endianness of the input-data.
+ *
+ * @retval 		1			On success.
+ * @retval		0			On failure, due to buffer limitations or invalid varints.
+ */
+static uint8_t tb_read_numbers_from_istream(tb_istream_t* istream, uint16_t type, uint8_t* data, uint8_t data_size, uint32_t len, tb_endian_t input_endianness) {
+	if(type & DATA_TYPE_PACKED) {
+		uint8_t bits = TB_PACKED_BITS(type);
+		while(len > 0) {
+			uint32_t packed_len = TB_PACKED_LEN(len, bits);
+			uint32_t available = get_istream_available(istream, (istream->callback != NULL && packed_len > bits) ? bits : packed_len);
+			uint32_t number = (available >= packed_len) ? len : (available/bits)*8;
+			if(number == 0)
+				return 0;
+			tb_unpack_bits(ISTREAM_POS(istream), data, number, bits);
+			istream->bytes_read += TB_PACKED_LEN(number, bits);
+			data += number;
+			len -= number;
+		}
+		return 1;
+	}
+	if(!(type & (DATA_TYPE_VARINT | DATA_TYPE_VARUINT)))
+		return tb_read_from_istream_little_endian(istream, data, data_size, len, input_endianness);
 	
 	for(uint32_t i = 0; i < len; i++) {
-		if(!tb_read_from_istream(istream, tmp, data_size))
+		uint64_t value = 0;
+		if(!tb_decode_varuint(istream, &value, data_size))
 			return 0;
-		uint8_t* cur_data = data + (((uint32_t)data_size)*i);
-		convert_endianness(tmp, cur_data, data_size, input_endianness);
-		
+		if(type & DATA_TYPE_VARINT)
+			value = (uint64_t) tb_zigzag_decode(value);
+		store_integer(data + ((uint32_t) data_size)*i, data_size, value);
 	}
 	return 1;
 }
@@ -215,18 +616,18 @@ static uint8_t check_oneof_which_tag_validity(const tb_field_t fields[], uint8_t
  * @retval 		1			On success.
  * @retval		0			On failure, due to buffer limitations or invalid structure.
  */
-uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_struct, tb_endian_t output_endianness) {
+static uint8_t encode_fields(tb_ostream_t* ostream, const tb_field_t fields[], void* src_struct, tb_endian_t output_endianness) {
 	uint8_t i = 0;
 	
 	while(fields[i].type != 0) {
 		tb_field_t field = fields[i];
 		// All these types are little endian
-		if(field.type & DATA_TYPE_INT || field.type & DATA_TYPE_UINT || field.type & DATA_TYPE_FLOAT || field.type & DATA_TYPE_DOUBLE)  {
+		if(field.type & DATA_TYPE_INT || field.type & DATA_TYPE_UINT || field.type & DATA_TYPE_FLOAT || field.type & DATA_TYPE_DOUBLE || field.type & DATA_TYPE_VARINT || field.type & DATA_TYPE_VARUINT || field.type & DATA_TYPE_PACKED)  {
 			void* data_ptr;
 			data_ptr = ((uint8_t*)src_struct + field.data_offset);
 			
 			if(field.type & FIELD_TYPE_REQUIRED) {
-				if(!tb_write_to_ostream_big_endian(ostream, (uint8_t*) data_ptr, field.data_size, 1, output_endianness))
+				if(!tb_write_numbers_to_ostream(ostream, field.type, (uint8_t*) data_ptr, field.data_size, 1, output_endianness))
 					return 0;
 			} else if(field.type & FIELD_TYPE_OPTIONAL) {
 				
@@ -240,7 +641,7 @@ uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_st
 				
 				// Only write the data if has_flag is true
 				if(has_flag) {
-					if(!tb_write_to_ostream_big_endian(ostream, (uint8_t*) data_ptr, field.data_size, 1, output_endianness))
+					if(!tb_write_numbers_to_ostream(ostream, field.type, (uint8_t*) data_ptr, field.data_size, 1, output_endianness))
 						return 0;
 				}				
 			} else if(field.type & FIELD_TYPE_REPEATED) {
@@ -252,12 +653,7 @@ uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_st
 					//printf("Error count_size is too big for uint32_t!\n");
 					return 0;
 				}
-				uint8_t tmp[count_size];
-				convert_endianness((uint8_t*)count_ptr, tmp, count_size, TB_BIG_ENDIAN);
-				// Create the actual count
-				for(uint8_t k = 0; k < count_size; k++) {
-					count |= (tmp[count_size-1-k]) << (8*k);
-				}
+				count = get_count(count_ptr, count_size);
 				//printf("Count: %u\n", count);
 				
 				// Check the count:
@@ -269,11 +665,11 @@ uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_st
 					return 0;
 				
 				// Now write the actual data of the array				
-				if(!tb_write_to_ostream_big_endian(ostream, (uint8_t*) data_ptr, field.data_size, count, output_endianness))
+				if(!tb_write_numbers_to_ostream(ostream, field.type, (uint8_t*) data_ptr, field.data_size, count, output_endianness))
 					return 0;
 			} else if(field.type & FIELD_TYPE_FIXED_REPEATED) {
 				// Write the actual data of the array				
-				if(!tb_write_to_ostream_big_endian(ostream, (uint8_t*) data_ptr, field.data_size, field.array_size, output_endianness))
+				if(!tb_write_numbers_to_ostream(ostream, field.type, (uint8_t*) data_ptr, field.data_size, field.array_size, output_endianness))
 					return 0;
 			} else if (field.type & FIELD_TYPE_ONEOF) {
 				void* which_ptr = ((uint8_t*) data_ptr + field.size_offset);
@@ -291,7 +687,7 @@ uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_st
 				
 				if(which == field.oneof_tag) {
 					// Here we assume to have a required-field type!
-					if(!tb_write_to_ostream_big_endian(ostream, (uint8_t*) data_ptr, field.data_size, 1, output_endianness))
+					if(!tb_write_numbers_to_ostream(ostream, field.type, (uint8_t*) data_ptr, field.data_size, 1, output_endianness))
 						return 0;
 				}				
 			} else {
@@ -306,7 +702,7 @@ uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_st
 			
 			if(field.type & FIELD_TYPE_REQUIRED) {
 				// Recursive call of encode function
-				if(!tb_encode(ostream, (tb_field_t*) field.ptr, struct_ptr, output_endianness))
+				if(!encode_fields(ostream, (tb_field_t*) field.ptr, struct_ptr, output_endianness))
 					return 0;
 			} else if(field.type & FIELD_TYPE_OPTIONAL) {
 				// Check the has ptr-flag
@@ -320,7 +716,7 @@ uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_st
 				// Only write the data if has_flag is true
 				if(has_flag) {
 					// Recursive call of encode function
-					if(!tb_encode(ostream, (tb_field_t*) field.ptr, struct_ptr, output_endianness))
+					if(!encode_fields(ostream, (tb_field_t*) field.ptr, struct_ptr, output_endianness))
 						return 0;
 				}
 				
@@ -335,12 +731,7 @@ uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_st
 					//printf("Error count_size is too big for uint32_t!\n");
 					return 0;
 				}
-				uint8_t tmp[count_size];
-				convert_endianness((uint8_t*)count_ptr, tmp, count_size, TB_BIG_ENDIAN);	
-				// Create the actual count
-				for(uint8_t k = 0; k < count_size; k++) {
-					count |= (tmp[count_size-1-k]) << (8*k);
-				}
+				count = get_count(count_ptr, count_size);
 				//printf("Count: %u\n", count);				
 				// Check the count:
 				if(count > field.array_size) {
@@ -351,18 +742,34 @@ uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_st
 				if(!tb_write_to_ostream_big_endian(ostream, (uint8_t*)count_ptr, count_size, 1, output_endianness))
 					return 0;
 				
+				// Messages that consist only of numbers of the same size are written in bulk
+				uint8_t uniform_data_size = get_uniform_data_size((tb_field_t*) field.ptr, field.data_size);
+				if(uniform_data_size) {
+					if(!tb_write_to_ostream_big_endian(ostream, (uint8_t*) struct_ptr, uniform_data_size, count*(field.data_size/uniform_data_size), output_endianness))
+						return 0;
+					count = 0;
+				}
 				
 				for(uint32_t k = 0; k < count; k++) {
 					struct_ptr = ((uint8_t*)src_struct + field.data_offset + k*field.data_size);
 					// Recursive call of encode function
-					if(!tb_encode(ostream, (tb_field_t*) field.ptr, struct_ptr, output_endianness))
+					if(!encode_fields(ostream, (tb_field_t*) field.ptr, struct_ptr, output_endianness))
 						return 0;					
 				}				
 			} else if(field.type & FIELD_TYPE_FIXED_REPEATED) {
-				for(uint32_t k = 0; k < field.array_size; k++) {
+				// Messages that consist only of numbers of the same size are written in bulk
+				uint32_t array_size = field.array_size;
+				uint8_t uniform_data_size = get_uniform_data_size((tb_field_t*) field.ptr, field.data_size);
+				if(uniform_data_size) {
+					if(!tb_write_to_ostream_big_endian(ostream, (uint8_t*) struct_ptr, uniform_data_size, array_size*(field.data_size/uniform_data_size), output_endianness))
+						return 0;
+					array_size = 0;
+				}
+				
+				for(uint32_t k = 0; k < array_size; k++) {
 					struct_ptr = ((uint8_t*)src_struct + field.data_offset + k*field.data_size);
 					// Recursive call of encode function
-					if(!tb_encode(ostream, (tb_field_t*) field.ptr, struct_ptr, output_endianness))
+					if(!encode_fields(ostream, (tb_field_t*) field.ptr, struct_ptr, output_endianness))
 						return 0;					
 				}				
 			} else if (field.type & FIELD_TYPE_ONEOF) {
@@ -382,7 +789,7 @@ uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_st
 				if(which == field.oneof_tag) {
 					// Here we assume to have a required-field type!
 					// Recursive call of encode function
-					if(!tb_encode(ostream, (tb_field_t*) field.ptr, struct_ptr, output_endianness))
+					if(!encode_fields(ostream, (tb_field_t*) field.ptr, struct_ptr, output_endianness))
 						return 0;
 				}				
 			} else {
@@ -412,18 +819,18 @@ uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_st
  * @retval 		1			On success.
  * @retval		0			On failure, due to buffer limitations or invalid structure.
  */
-uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_struct, tb_endian_t input_endianness) {
+static uint8_t decode_fields(tb_istream_t* istream, const tb_field_t fields[], void* dst_struct, tb_endian_t input_endianness) {
 	uint8_t i = 0;
 	
 	while(fields[i].type != 0) {		
 		tb_field_t field = fields[i];
 		// All these types are little endian
-		if(field.type & DATA_TYPE_INT || field.type & DATA_TYPE_UINT || field.type & DATA_TYPE_FLOAT || field.type & DATA_TYPE_DOUBLE)  {
+		if(field.type & DATA_TYPE_INT || field.type & DATA_TYPE_UINT || field.type & DATA_TYPE_FLOAT || field.type & DATA_TYPE_DOUBLE || field.type & DATA_TYPE_VARINT || field.type & DATA_TYPE_VARUINT || field.type & DATA_TYPE_PACKED)  {
 			void* data_ptr;
 			data_ptr = ((uint8_t*)dst_struct + field.data_offset);
 			
 			if(field.type & FIELD_TYPE_REQUIRED) {
-				if(!tb_read_from_istream_little_endian(istream, (uint8_t*) data_ptr, field.data_size, 1, input_endianness))
+				if(!tb_read_numbers_from_istream(istream, field.type, (uint8_t*) data_ptr, field.data_size, 1, input_endianness))
 					return 0;
 			} else if(field.type & FIELD_TYPE_OPTIONAL) {
 				
@@ -437,7 +844,7 @@ uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_st
 				
 				// Only write the data if has_flag is true
 				if(has_flag) {
-					if(!tb_read_from_istream_little_endian(istream, (uint8_t*) data_ptr, field.data_size, 1, input_endianness))
+					if(!tb_read_numbers_from_istream(istream, field.type, (uint8_t*) data_ptr, field.data_size, 1, input_endianness))
 						return 0;
 				}				
 			} else if(field.type & FIELD_TYPE_REPEATED) {
@@ -452,12 +859,7 @@ uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_st
 				if(!tb_read_from_istream_little_endian(istream, (uint8_t*) count_ptr, count_size, 1, input_endianness))
 					return 0;
 				
-				uint8_t tmp[count_size];
-				convert_endianness((uint8_t*)count_ptr, tmp, count_size, TB_BIG_ENDIAN);
-				// Create the actual count
-				for(uint8_t k = 0; k < count_size; k++) {
-					count |= (tmp[count_size-1-k]) << (8*k);
-				}
+				count = get_count(count_ptr, count_size);
 				//printf("Count: %u\n", count);
 				// Check the count:
 				if(count > field.array_size) {
@@ -466,12 +868,12 @@ uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_st
 				}
 				
 				// Now read the actual data of the array		
-				if(!tb_read_from_istream_little_endian(istream, (uint8_t*) data_ptr, field.data_size, count, input_endianness))
+				if(!tb_read_numbers_from_istream(istream, field.type, (uint8_t*) data_ptr, field.data_size, count, input_endianness))
 					return 0;
 				
 			} else if(field.type & FIELD_TYPE_FIXED_REPEATED) {
 				// Write the actual data of the array		
-				if(!tb_read_from_istream_little_endian(istream, (uint8_t*) data_ptr, field.data_size, field.array_size, input_endianness))
+				if(!tb_read_numbers_from_istream(istream, field.type, (uint8_t*) data_ptr, field.data_size, field.array_size, input_endianness))
 					return 0;
 				
 			} else if (field.type & FIELD_TYPE_ONEOF) {
@@ -493,7 +895,7 @@ uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_st
 				
 				if(which == field.oneof_tag) {
 					// Here we assume to have a required-field type!
-					if(!tb_read_from_istream_little_endian(istream, (uint8_t*) data_ptr, field.data_size, 1, input_endianness))
+					if(!tb_read_numbers_from_istream(istream, field.type, (uint8_t*) data_ptr, field.data_size, 1, input_endianness))
 						return 0;
 				}				
 			} else {
@@ -507,7 +909,7 @@ uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_st
 			
 			if(field.type & FIELD_TYPE_REQUIRED) {
 				// Recursive call of decode function
-				if(!tb_decode(istream, (tb_field_t*) field.ptr, struct_ptr, input_endianness))
+				if(!decode_fields(istream, (tb_field_t*) field.ptr, struct_ptr, input_endianness))
 					return 0;
 			} else if(field.type & FIELD_TYPE_OPTIONAL) {
 				
@@ -522,7 +924,7 @@ uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_st
 				// Only read the data if has_flag is true
 				if(has_flag) {
 					// Recursive call of decode function
-					if(!tb_decode(istream, (tb_field_t*) field.ptr, struct_ptr, input_endianness))
+					if(!decode_fields(istream, (tb_field_t*) field.ptr, struct_ptr, input_endianness))
 						return 0;
 				}
 				
@@ -540,32 +942,43 @@ uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_st
 				if(!tb_read_from_istream_little_endian(istream, (uint8_t*) count_ptr, count_size, 1, input_endianness))
 					return 0;
 				
-				uint8_t tmp[count_size];
-				convert_endianness((uint8_t*)count_ptr, tmp, count_size, TB_BIG_ENDIAN);
-				// Create the actual count
-				for(uint8_t k = 0; k < count_size; k++) {
-					count |= (tmp[count_size-1-k]) << (8*k);
-				}
+				count = get_count(count_ptr, count_size);
 				//printf("Count: %u\n", count);
 				// Check the count:
 				if(count > field.array_size) {
 					//printf("Count exceeds array size!\n");
 					return 0;				
 				}
+				
+				// Messages that consist only of numbers of the same size are read in bulk
+				uint8_t uniform_data_size = get_uniform_data_size((tb_field_t*) field.ptr, field.data_size);
+				if(uniform_data_size) {
+					if(!tb_read_from_istream_little_endian(istream, (uint8_t*) struct_ptr, uniform_data_size, count*(field.data_size/uniform_data_size), input_endianness))
+						return 0;
+					count = 0;
+				}
 			
 				for(uint32_t k = 0; k < count; k++) {
 					struct_ptr = ((uint8_t*)dst_struct + field.data_offset + k*field.data_size);
 					// Recursive call of encode function
-					if(!tb_decode(istream, (tb_field_t*) field.ptr, struct_ptr, input_endianness))
+					if(!decode_fields(istream, (tb_field_t*) field.ptr, struct_ptr, input_endianness))
 						return 0;					
 				}
 				
 			} else if(field.type & FIELD_TYPE_FIXED_REPEATED) {
+				// Messages that consist only of numbers of the same size are read in bulk
+				uint32_t array_size = field.array_size;
+				uint8_t uniform_data_size = get_uniform_data_size((tb_field_t*) field.ptr, field.data_size);
+				if(uniform_data_size) {
+					if(!tb_read_from_istream_little_endian(istream, (uint8_t*) struct_ptr, uniform_data_size, array_size*(field.data_size/uniform_data_size), input_endianness))
+						return 0;
+					array_size = 0;
+				}
 				
-				for(uint32_t k = 0; k < field.array_size; k++) {
+				for(uint32_t k = 0; k < array_size; k++) {
 					struct_ptr = ((uint8_t*)dst_struct + field.data_offset + k*field.data_size);
 					// Recursive call of encode function
-					if(!tb_decode(istream, (tb_field_t*) field.ptr, struct_ptr, input_endianness))
+					if(!decode_fields(istream, (tb_field_t*) field.ptr, struct_ptr, input_endianness))
 						return 0;					
 				}
 				
@@ -588,7 +1001,7 @@ uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_st
 				if(which == field.oneof_tag) {
 					// Here we assume to have a required-field type!
 					// Recursive call of encode function
-					if(!tb_decode(istream, (tb_field_t*) field.ptr, struct_ptr, input_endianness))
+					if(!decode_fields(istream, (tb_field_t*) field.ptr, struct_ptr, input_endianness))
 						return 0;	
 				}				
 			} else {
@@ -606,6 +1019,25 @@ uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_st
 }
 
 
+uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_struct, tb_endian_t output_endianness) {
+	TRACE_BEGIN(TRACE_EVENT_TB_ENCODE, 0);
+	uint32_t bytes_written = ostream->bytes_written;
+	uint8_t ret = encode_fields(ostream, fields, src_struct, output_endianness);
+	if(ret)	// Hand the rest of the message to the callback (nothing to do for buffer-streams)
+		ret = tb_ostream_flush(ostream);
+	TRACE_END(TRACE_EVENT_TB_ENCODE, (uint16_t) (ostream->bytes_written - bytes_written));
+	(void) bytes_written;
+	return ret;
+}
+
+uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_struct, tb_endian_t input_endianness) {
+	TRACE_BEGIN(TRACE_EVENT_TB_DECODE, 0);
+	uint32_t bytes_read = istream->bytes_read;
+	uint8_t ret = decode_fields(istream, fields, dst_struct, input_endianness);
+	TRACE_END(TRACE_EVENT_TB_DECODE, (uint16_t) (istream->bytes_read - bytes_read));
+	(void) bytes_read;
+	return ret;
+}
 
 
 uint32_t tb_get_max_encoded_len(const tb_field_t fields[]) {
@@ -614,17 +1046,17 @@ uint32_t tb_get_max_encoded_len(const tb_field_t fields[]) {
 	
 	while(fields[i].type != 0) {	
 		tb_field_t field = fields[i];
-		if(field.type & DATA_TYPE_INT || field.type & DATA_TYPE_UINT || field.type & DATA_TYPE_FLOAT || field.type & DATA_TYPE_DOUBLE)  {
+		if(field.type & DATA_TYPE_INT || field.type & DATA_TYPE_UINT || field.type & DATA_TYPE_FLOAT || field.type & DATA_TYPE_DOUBLE || field.type & DATA_TYPE_VARINT || field.type & DATA_TYPE_VARUINT || field.type & DATA_TYPE_PACKED)  {
 			if(field.type & FIELD_TYPE_REQUIRED) {
-				len += field.data_size;
+				len += get_max_data_len(&field);
 			} else if(field.type & FIELD_TYPE_OPTIONAL) {
 				len += field.size_size;
-				len += field.data_size;
+				len += get_max_data_len(&field);
 			} else if(field.type & FIELD_TYPE_REPEATED) {
 				len += field.size_size;
-				len += ((uint32_t) field.array_size) * field.data_size;
+				len += get_max_array_len(&field, field.array_size);
 			} else if(field.type & FIELD_TYPE_FIXED_REPEATED) {
-				len += ((uint32_t) field.array_size) * field.data_size;
+				len += get_max_array_len(&field, field.array_size);
 			} else if (field.type & FIELD_TYPE_ONEOF) {
 				// Here we need to search for the max
 				len += field.size_size;	// The which field
@@ -634,7 +1066,7 @@ uint32_t tb_get_max_encoded_len(const tb_field_t fields[]) {
 					if(fields[i].type & DATA_TYPE_MESSAGE) {
 						tmp_len = tb_get_max_encoded_len((tb_field_t*) fields[i].ptr);
 					} else {
-						tmp_len = fields[i].data_size;
+						tmp_len = get_max_data_len(&fields[i]);
 					}
 					if(tmp_len > tmp_len_max) {
 						tmp_len_max = tmp_len;
@@ -661,10 +1093,10 @@ uint32_t tb_get_max_encoded_len(const tb_field_t fields[]) {
 				uint32_t tmp_len_max = 0;
 				do {
 					uint32_t tmp_len = 0;
-					if(field.type & DATA_TYPE_MESSAGE) {
-						tmp_len = tb_get_max_encoded_len((tb_field_t*) field.ptr);
+					if(fields[i].type & DATA_TYPE_MESSAGE) {
+						tmp_len = tb_get_max_encoded_len((tb_field_t*) fields[i].ptr);
 					} else {
-						tmp_len = fields[i].data_size;
+						tmp_len = get_max_data_len(&fields[i]);
 					}
 					if(tmp_len > tmp_len_max) {
 						tmp_len_max = tmp_len;
@@ -4,6 +4,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 #define tb_membersize(st, m) 	((uint32_t)(sizeof ((st*)0)->m))
 #define tb_offsetof(st, m)		((uint32_t) (offsetof(st, m)))
@@ -29,11 +30,24 @@ typedef enum {
 	DATA_TYPE_FLOAT 			= (1 << 7),
 	DATA_TYPE_DOUBLE 			= (1 << 8),
 	DATA_TYPE_MESSAGE 			= (1 << 9),
+	DATA_TYPE_VARINT 			= (1 << 10),	/**< Signed integer, zigzag- and LEB128-encoded */
+	DATA_TYPE_VARUINT 			= (1 << 11),	/**< Unsigned integer, LEB128-encoded */
+	DATA_TYPE_PACKED 			= (1 << 12),	/**< Unsigned integers with 1..7 bits in uint8_t, bit-packed (only repeated). The number of bits is in the type, see TB_PACKED_BITS() */
 } tb_data_type_t;
 
+#define TB_PACKED_BITS_POS				13
+#define TB_PACKED_BITS(type)			(((type) >> TB_PACKED_BITS_POS) & 0x07)	/**< The number of bits of a DATA_TYPE_PACKED-field */
+#define TB_PACKED_LEN(number, bits)		((((uint32_t) (number))*(bits) + 7)/8)	/**< The number of bytes of number bit-packed values */
+
+
+/**< The maximum number of bytes of a LEB128-encoded integer with data_size bytes (7 bits per byte) */
+#define TB_VARINT_MAX_LEN(data_size)	((((uint32_t) (data_size))*8 + 6)/7)
+
 
 #define TB_LAST_FIELD {0, 0, 0, 0, 0, 0, 0, 0, NULL}	/**< Marker for the last field in a field-array */
 
+#define TB_STREAM_MIN_WINDOW_SIZE	8	/**< Minimal window size of callback-streams (the largest number is encoded in one piece) */
+
 typedef struct {
 	uint16_t 	type; 			/**< optional/repeated/required. uint, int, float, double, submessage */
 	uint32_t 	data_offset;	/**< Offset of data relative to begin of struct */
@@ -48,17 +62,40 @@ typedef struct {
 
 
 
-typedef struct {
+typedef struct tb_ostream_s tb_ostream_t;
+typedef struct tb_istream_s tb_istream_t;
+
+/**@brief Callback of a callback-backed output-stream, that has to consume (e.g. transmit, store or checksum) len bytes.
+ *
+ * @retval 		1			On success.
+ * @retval		0			On failure (the encoding fails then).
+ */
+typedef uint8_t (*tb_ostream_callback_t)(tb_ostream_t* ostream, const uint8_t* data, uint32_t len);
+
+/**@brief Callback of a callback-backed input-stream, that has to provide the next (at most max_len) bytes of the input.
+ *
+ * @retval 		The number of provided bytes, 0 at the end of the input (or on failure).
+ */
+typedef uint32_t (*tb_istream_callback_t)(tb_istream_t* istream, uint8_t* buf, uint32_t max_len);
+
+struct tb_ostream_s {
 	uint8_t* buf;
 	uint32_t buf_size;
-	uint32_t bytes_written;
-} tb_ostream_t;
+	uint32_t bytes_written;				/**< The total number of bytes written to the stream */
+	tb_ostream_callback_t callback;		/**< NULL for buffer-streams. Otherwise buf is a window, that is handed to the callback when it is full */
+	void* state;						/**< Context for the callback */
+	uint32_t bytes_flushed;				/**< The number of bytes handed to the callback (buf[0] is at this stream position) */
+};
 
-typedef struct {
+struct tb_istream_s {
 	uint8_t* buf;
-	uint32_t buf_size;
-	uint32_t bytes_read;
-} tb_istream_t;
+	uint32_t buf_size;					/**< The number of valid bytes in buf */
+	uint32_t bytes_read;				/**< The total number of bytes read from the stream */
+	tb_istream_callback_t callback;		/**< NULL for buffer-streams. Otherwise buf is a window, that is refilled by the callback */
+	void* state;						/**< Context for the callback */
+	uint32_t bytes_discarded;			/**< The number of bytes removed from the window (buf[0] is at this stream position) */
+	uint32_t window_size;				/**< The size of the window */
+};
 
 
 /**@brief Function to create an output-stream from a buffer.
@@ -81,6 +118,49 @@ tb_ostream_t tb_ostream_from_buffer(uint8_t* buf, uint32_t buf_size);
 tb_istream_t tb_istream_from_buffer(uint8_t* buf, uint32_t buf_size);
 
 
+/**@brief Function to create an output-stream that hands the encoded bytes to a callback (e.g. a transmit-queue, a storage or a checksum).
+ *
+ * @details	The bytes are collected in the window and handed to the callback when the window is full, 
+ *			at the end of tb_encode() and on tb_ostream_flush(). Large byte-arrays are handed directly to the callback.
+ *			So messages of any size can be encoded with a small window.
+ *			The straight-line encode functions (option -straight_line) fall back to tb_encode() for these streams.
+ *
+ * @param[in]	callback		The callback that consumes the bytes.
+ * @param[in]	state			Context for the callback (ostream->state).
+ * @param[in]	window			Pointer to the window buffer.
+ * @param[in]	window_size		Size of the window, at least TB_STREAM_MIN_WINDOW_SIZE.
+ *
+ * @retval 		tb_ostream_t	Output-stream structure.
+ */
+tb_ostream_t tb_ostream_from_callback(tb_ostream_callback_t callback, void* state, uint8_t* window, uint32_t window_size);
+
+
+/**@brief Function to create an input-stream that reads the bytes from a callback (e.g. a receive-queue or a storage).
+ *
+ * @details	The callback refills the window, when the decoder needs more bytes. 
+ *			Because of that, the callback might have provided more bytes than were decoded (istream->bytes_read).
+ *			The straight-line decode functions (option -straight_line) fall back to tb_decode() for these streams.
+ *
+ * @param[in]	callback		The callback that provides the bytes.
+ * @param[in]	state			Context for the callback (istream->state).
+ * @param[in]	window			Pointer to the window buffer.
+ * @param[in]	window_size		Size of the window, at least TB_STREAM_MIN_WINDOW_SIZE.
+ *
+ * @retval 		tb_istream_t	Input-stream structure.
+ */
+tb_istream_t tb_istream_from_callback(tb_istream_callback_t callback, void* state, uint8_t* window, uint32_t window_size);
+
+
+/**@brief Function to hand the bytes in the window of a callback-backed output-stream to the callback.
+ *
+ * @param[in]	ostream		Pointer to output-stream structure.
+ *
+ * @retval 		1			On success (also for buffer-streams, where nothing has to be done).
+ * @retval		0			If the callback failed.
+ */
+uint8_t tb_ostream_flush(tb_ostream_t* ostream);
+
+
 
 /**@brief Function to serialize a structure into an output-stream.
  *
@@ -108,6 +188,71 @@ uint8_t tb_encode(tb_ostream_t* ostream, const tb_field_t fields[], void* src_st
 uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_struct, tb_endian_t input_endianness);
 
 
+/**@brief Function to LEB128-encode an unsigned integer into an output-stream.
+ *
+ * @details	7 bits per byte (least significant group first), the MSB of each byte is set if more bytes follow.
+ *
+ * @param[in]	ostream		Pointer to output-stream structure.
+ * @param[in]	value		The value to encode.
+ *
+ * @retval 		1			On success.
+ * @retval		0			On failure, due to buffer limitations.
+ */
+uint8_t tb_encode_varuint(tb_ostream_t* ostream, uint64_t value);
+
+
+/**@brief Function to decode a LEB128-encoded unsigned integer from an input-stream.
+ *
+ * @param[in]	istream		Pointer to input-stream structure.
+ * @param[out]	value		Pointer to the decoded value.
+ * @param[in]	data_size	The size of the integer in bytes (the value has to fit into it).
+ *
+ * @retval 		1			On success.
+ * @retval		0			On failure, due to buffer limitations, too many bytes or a value that doesn't fit into data_size bytes.
+ */
+uint8_t tb_decode_varuint(tb_istream_t* istream, uint64_t* value, uint8_t data_size);
+
+
+/**@brief Function to bit-pack values.
+ *
+ * @details	Value i occupies the bits [i*bits, (i+1)*bits) of the packed data, LSB first 
+ *			(bit k of the packed data is bit k%8 of byte k/8). Unused bits of the last byte are 0.
+ *
+ * @param[out]	packed		Pointer to the packed data (TB_PACKED_LEN(number, bits) bytes).
+ * @param[in]	values		Pointer to the values.
+ * @param[in]	number		Number of values.
+ * @param[in]	bits		Number of bits per value (1..7).
+ *
+ * @retval 		1			On success.
+ * @retval		0			If a value doesn't fit into bits.
+ */
+uint8_t tb_pack_bits(uint8_t* packed, const uint8_t* values, uint32_t number, uint8_t bits);
+
+
+/**@brief Function to unpack bit-packed values (the counterpart of tb_pack_bits()).
+ *
+ * @param[in]	packed		Pointer to the packed data (TB_PACKED_LEN(number, bits) bytes).
+ * @param[out]	values		Pointer to the values.
+ * @param[in]	number		Number of values.
+ * @param[in]	bits		Number of bits per value (1..7).
+ */
+void tb_unpack_bits(const uint8_t* packed, uint8_t* values, uint32_t number, uint8_t bits);
+
+
+/**@brief Function to map a signed integer to an unsigned integer (zigzag: 0, -1, 1, -2, ... --> 0, 1, 2, 3, ...),
+ *			so that values with a small magnitude have a short LEB128-encoding.
+ */
+static inline uint64_t tb_zigzag_encode(int64_t value) {
+	return (((uint64_t) value) << 1) ^ ((value < 0) ? UINT64_MAX : 0);
+}
+
+/**@brief Function to map a zigzag-encoded integer back to the signed integer.
+ */
+static inline int64_t tb_zigzag_decode(uint64_t value) {
+	return (int64_t) ((value >> 1) ^ (~(value & 1) + 1));
+}
+
+
 /**@brief Function to retrieve the max encoded length of a message.
  *
  * @param[in]	fields		Pointer to the array of structure-fields.
@@ -117,5 +262,101 @@ uint8_t tb_decode(tb_istream_t* istream, const tb_field_t fields[], void* dst_st
 uint32_t tb_get_max_encoded_len(const tb_field_t fields[]);
 
 
+
+/**< Helper functions for the straight-line encode/decode functions that are created by the generator with the -straight_line option. */
+
+/**@brief Function to reserve len bytes in the output-stream (one bounds check for multiple fields).
+ *
+ * @retval 		Pointer to the reserved bytes, or NULL if the buffer is too small.
+ */
+static inline uint8_t* tb_ostream_reserve(tb_ostream_t* ostream, uint32_t len) {
+	if(ostream->bytes_written + len > ostream->buf_size)
+		return NULL;
+	uint8_t* p = &(ostream->buf[ostream->bytes_written]);
+	ostream->bytes_written += len;
+	return p;
+}
+
+/**@brief Function to consume len bytes from the input-stream (one bounds check for multiple fields).
+ *
+ * @retval 		Pointer to the consumed bytes, or NULL if there are not enough bytes.
+ */
+static inline const uint8_t* tb_istream_consume(tb_istream_t* istream, uint32_t len) {
+	if(istream->bytes_read + len > istream->buf_size)
+		return NULL;
+	const uint8_t* p = &(istream->buf[istream->bytes_read]);
+	istream->bytes_read += len;
+	return p;
+}
+
+static inline void tb_put_16(uint8_t* p, uint16_t value, tb_endian_t endianness) {
+	if(endianness == TB_BIG_ENDIAN) {
+		p[0] = (uint8_t) (value >> 8); p[1] = (uint8_t) value;
+	} else {
+		p[0] = (uint8_t) value; p[1] = (uint8_t) (value >> 8);
+	}
+}
+
+static inline void tb_put_32(uint8_t* p, uint32_t value, tb_endian_t endianness) {
+	if(endianness == TB_BIG_ENDIAN) {
+		p[0] = (uint8_t) (value >> 24); p[1] = (uint8_t) (value >> 16); p[2] = (uint8_t) (value >> 8); p[3] = (uint8_t) value;
+	} else {
+		p[0] = (uint8_t) value; p[1] = (uint8_t) (value >> 8); p[2] = (uint8_t) (value >> 16); p[3] = (uint8_t) (value >> 24);
+	}
+}
+
+static inline void tb_put_64(uint8_t* p, uint64_t value, tb_endian_t endianness) {
+	if(endianness == TB_BIG_ENDIAN) {
+		tb_put_32(p, (uint32_t) (value >> 32), endianness); tb_put_32(p + 4, (uint32_t) value, endianness);
+	} else {
+		tb_put_32(p, (uint32_t) value, endianness); tb_put_32(p + 4, (uint32_t) (value >> 32), endianness);
+	}
+}
+
+static inline void tb_put_float(uint8_t* p, float value, tb_endian_t endianness) {
+	uint32_t tmp;
+	memcpy(&tmp, &value, sizeof(tmp));
+	tb_put_32(p, tmp, endianness);
+}
+
+static inline void tb_put_double(uint8_t* p, double value, tb_endian_t endianness) {
+	uint64_t tmp;
+	memcpy(&tmp, &value, sizeof(tmp));
+	tb_put_64(p, tmp, endianness);
+}
+
+static inline uint16_t tb_get_16(const uint8_t* p, tb_endian_t endianness) {
+	if(endianness == TB_BIG_ENDIAN)
+		return (uint16_t) ((((uint16_t) p[0]) << 8) | ((uint16_t) p[1]));
+	return (uint16_t) ((((uint16_t) p[1]) << 8) | ((uint16_t) p[0]));
+}
+
+static inline uint32_t tb_get_32(const uint8_t* p, tb_endian_t endianness) {
+	if(endianness == TB_BIG_ENDIAN)
+		return (((uint32_t) p[0]) << 24) | (((uint32_t) p[1]) << 16) | (((uint32_t) p[2]) << 8) | ((uint32_t) p[3]);
+	return (((uint32_t) p[3]) << 24) | (((uint32_t) p[2]) << 16) | (((uint32_t) p[1]) << 8) | ((uint32_t) p[0]);
+}
+
+static inline uint64_t tb_get_64(const uint8_t* p, tb_endian_t endianness) {
+	if(endianness == TB_BIG_ENDIAN)
+		return (((uint64_t) tb_get_32(p, endianness)) << 32) | ((uint64_t) tb_get_32(p + 4, endianness));
+	return (((uint64_t) tb_get_32(p + 4, endianness)) << 32) | ((uint64_t) tb_get_32(p, endianness));
+}
+
+static inline float tb_get_float(const uint8_t* p, tb_endian_t endianness) {
+	uint32_t tmp = tb_get_32(p, endianness);
+	float value;
+	memcpy(&value, &tmp, sizeof(value));
+	return value;
+}
+
+static inline double tb_get_double(const uint8_t* p, tb_endian_t endianness) {
+	uint64_t tmp = tb_get_64(p, endianness);
+	double value;
+	memcpy(&value, &tmp, sizeof(value));
+	return value;
+}
+
+
 #endif
 
@@ -0,0 +1,327 @@
+#ifndef __TINYBUF_HPP
+#define __TINYBUF_HPP
+
+/**@file
+ * @details Header-only C++ counterpart of the tinybuf-module for hosts (e.g. the hub).
+ *			It is used by the headers that tinybuf_generator.py creates with -cpp: for each message M of a schema-file
+ *			the structure tinybuf::M (with the same layout as the C structure) and tinybuf::MessageTraits<M> with
+ *			encode()/decode()/visit() are generated. The field layout is compiled into these templates,
+ *			and the endianness is a template parameter, so nothing is interpreted at runtime.
+ *			The encoded representation is the same as the one of tb_encode()/tb_decode().
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+
+namespace tinybuf {
+
+enum class Endian {
+	big,
+	little,
+};
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+constexpr Endian host_endian = Endian::big;
+#else
+constexpr Endian host_endian = Endian::little;
+#endif
+
+/**< The maximum number of bytes of a LEB128-encoded integer with data_size bytes (like TB_VARINT_MAX_LEN()) */
+constexpr uint32_t varint_max_len(uint32_t data_size) {
+	return (data_size*8 + 6)/7;
+}
+
+/**< The number of bytes of number bit-packed values (like TB_PACKED_LEN()) */
+constexpr uint32_t packed_len(uint32_t number, uint32_t bits) {
+	return (number*bits + 7)/8;
+}
+
+/**< The larger one of two encoded lengths (e.g. of the members of a oneof-field) */
+constexpr uint32_t max_len(uint32_t len1, uint32_t len2) {
+	return (len1 > len2) ? len1 : len2;
+}
+
+
+/**@brief Template that is specialized for each generated message M.
+ *
+ * @details The specializations provide:
+ *			- static constexpr const char* name()
+ *			- static constexpr uint32_t max_encoded_len()
+ *			- template<Endian E> static bool encode(Ostream<E>& ostream, const M& message)
+ *			- template<Endian E> static bool decode(Istream<E>& istream, M& message)
+ *			- template<typename V> static void visit(V& visitor, const M& message)
+ *
+ *			visit() calls for every field (in the order of the schema-file) one of these functions of the visitor:
+ *			- field(name, value)						for required fields
+ *			- optional(name, has, value)				for optional fields
+ *			- repeated(name, values, count)				for repeated, fixed_repeated and packed fields
+ *			- begin_oneof(name, which), oneof_member(name, is_set, value) for each member, end_oneof()	for oneof fields
+ *			The values are numbers or other messages (that can be visited recursively).
+ */
+template<typename M>
+struct MessageTraits;
+
+
+namespace detail {
+
+template<size_t N> struct UnsignedOfSize;
+template<> struct UnsignedOfSize<1> { typedef uint8_t type; };
+template<> struct UnsignedOfSize<2> { typedef uint16_t type; };
+template<> struct UnsignedOfSize<4> { typedef uint32_t type; };
+template<> struct UnsignedOfSize<8> { typedef uint64_t type; };
+
+inline uint8_t swap_bytes(uint8_t value) {
+	return value;
+}
+
+inline uint16_t swap_bytes(uint16_t value) {
+	return (uint16_t) ((value >> 8) | (value << 8));
+}
+
+inline uint32_t swap_bytes(uint32_t value) {
+	return ((value >> 24) & 0xFF) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24);
+}
+
+inline uint64_t swap_bytes(uint64_t value) {
+	return (((uint64_t) swap_bytes((uint32_t) value)) << 32) | swap_bytes((uint32_t) (value >> 32));
+}
+
+/**@brief Function to load a number of type T in endianness E from p.
+ */
+template<Endian E, typename T>
+inline T load(const uint8_t* p) {
+	typename UnsignedOfSize<sizeof(T)>::type raw;
+	memcpy(&raw, p, sizeof(T));
+	if(E != host_endian)
+		raw = swap_bytes(raw);
+	T value;
+	memcpy(&value, &raw, sizeof(T));
+	return value;
+}
+
+/**@brief Function to store a number of type T in endianness E to p.
+ */
+template<Endian E, typename T>
+inline void store(uint8_t* p, T value) {
+	typename UnsignedOfSize<sizeof(T)>::type raw;
+	memcpy(&raw, &value, sizeof(T));
+	if(E != host_endian)
+		raw = swap_bytes(raw);
+	memcpy(p, &raw, sizeof(T));
+}
+
+inline uint64_t zigzag_encode(int64_t value) {
+	return (((uint64_t) value) << 1) ^ ((value < 0) ? UINT64_MAX : 0);
+}
+
+inline int64_t zigzag_decode(uint64_t value) {
+	return (int64_t) ((value >> 1) ^ (~(value & 1) + 1));
+}
+
+}	// namespace detail
+
+
+/**@brief Output-stream on a buffer. All write-functions return false if the buffer is too small.
+ */
+template<Endian E>
+class Ostream {
+public:
+	Ostream(uint8_t* buf, size_t buf_size) : buf_(buf), buf_size_(buf_size), bytes_written_(0) {}
+
+	size_t bytes_written() const {
+		return bytes_written_;
+	}
+
+	template<typename T>
+	bool write(T value) {
+		if(buf_size_ - bytes_written_ < sizeof(T))
+			return false;
+		detail::store<E>(&buf_[bytes_written_], value);
+		bytes_written_ += sizeof(T);
+		return true;
+	}
+
+	template<typename T>
+	bool write_array(const T* values, size_t number) {
+		if((buf_size_ - bytes_written_)/sizeof(T) < number)
+			return false;
+		if(E == host_endian || sizeof(T) == 1) {
+			memcpy(&buf_[bytes_written_], values, number*sizeof(T));
+			bytes_written_ += number*sizeof(T);
+		} else {
+			for(size_t i = 0; i < number; i++)
+				write(values[i]);
+		}
+		return true;
+	}
+
+	bool write_varuint(uint64_t value) {
+		do {
+			if(bytes_written_ >= buf_size_)
+				return false;
+			uint8_t byte = (uint8_t) (value & 0x7F);
+			value >>= 7;
+			if(value)
+				byte |= 0x80;
+			buf_[bytes_written_++] = byte;
+		} while(value);
+		return true;
+	}
+
+	bool write_varint(int64_t value) {
+		return write_varuint(detail::zigzag_encode(value));
+	}
+
+	/**@brief Function to write values with bits bits LSB-first bit-packed (like tb_pack_bits()), fails if a value has more bits.
+	 */
+	bool write_packed(const uint8_t* values, size_t number, uint8_t bits) {
+		size_t len = packed_len((uint32_t) number, bits);
+		if(buf_size_ - bytes_written_ < len)
+			return false;
+		uint8_t* packed = &buf_[bytes_written_];
+		memset(packed, 0, len);
+		uint32_t bit_pos = 0;
+		for(size_t i = 0; i < number; i++, bit_pos += bits) {
+			if(values[i] >> bits)
+				return false;
+			uint8_t shift = (uint8_t) (bit_pos & 0x07);
+			packed[bit_pos >> 3] |= (uint8_t) (values[i] << shift);
+			if(shift + bits > 8)
+				packed[(bit_pos >> 3) + 1] = (uint8_t) (values[i] >> (8 - shift));
+		}
+		bytes_written_ += len;
+		return true;
+	}
+
+private:
+	uint8_t* buf_;
+	size_t buf_size_;
+	size_t bytes_written_;
+};
+
+
+/**@brief Input-stream on a buffer. All read-functions return false if there are not enough bytes (or an invalid varint).
+ */
+template<Endian E>
+class Istream {
+public:
+	Istream(const uint8_t* buf, size_t buf_size) : buf_(buf), buf_size_(buf_size), bytes_read_(0) {}
+
+	size_t bytes_read() const {
+		return bytes_read_;
+	}
+
+	template<typename T>
+	bool read(T& value) {
+		if(buf_size_ - bytes_read_ < sizeof(T))
+			return false;
+		value = detail::load<E, T>(&buf_[bytes_read_]);
+		bytes_read_ += sizeof(T);
+		return true;
+	}
+
+	template<typename T>
+	bool read_array(T* values, size_t number) {
+		if((buf_size_ - bytes_read_)/sizeof(T) < number)
+			return false;
+		if(E == host_endian || sizeof(T) == 1) {
+			memcpy(values, &buf_[bytes_read_], number*sizeof(T));
+			bytes_read_ += number*sizeof(T);
+		} else {
+			for(size_t i = 0; i < number; i++)
+				read(values[i]);
+		}
+		return true;
+	}
+
+	/**@brief Function to read a LEB128-encoded integer, that has to fit into T (like tb_decode_varuint()).
+	 */
+	template<typename T>
+	bool read_varuint(T& value) {
+		uint64_t result = 0;
+		for(uint32_t i = 0; i < varint_max_len(sizeof(T)); i++) {
+			if(bytes_read_ >= buf_size_)
+				return false;
+			uint8_t byte = buf_[bytes_read_++];
+			result |= ((uint64_t) (byte & 0x7F)) << (7*i);
+			if(!(byte & 0x80)) {
+				if((sizeof(T) < 8 && (result >> (4*sizeof(T)) >> (4*sizeof(T))) != 0) || (sizeof(T) >= 8 && i == 9 && byte > 1))	// Two shifts: no shift by the width of uint64_t
+					return false;
+				value = (T) result;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<typename T>
+	bool read_varint(T& value) {
+		typename detail::UnsignedOfSize<sizeof(T)>::type encoded;
+		if(!read_varuint(encoded))
+			return false;
+		value = (T) detail::zigzag_decode(encoded);
+		return true;
+	}
+
+	/**@brief Function to read number bit-packed values with bits bits (like tb_unpack_bits()).
+	 */
+	bool read_packed(uint8_t* values, size_t number, uint8_t bits) {
+		size_t len = packed_len((uint32_t) number, bits);
+		if(buf_size_ - bytes_read_ < len)
+			return false;
+		const uint8_t* packed = &buf_[bytes_read_];
+		uint8_t mask = (uint8_t) ((1 << bits) - 1);
+		uint32_t bit_pos = 0;
+		for(size_t i = 0; i < number; i++, bit_pos += bits) {
+			uint8_t shift = (uint8_t) (bit_pos & 0x07);
+			uint16_t value = (uint16_t) (packed[bit_pos >> 3] >> shift);
+			if(shift + bits > 8)
+				value |= (uint16_t) (((uint16_t) packed[(bit_pos >> 3) + 1]) << (8 - shift));
+			values[i] = (uint8_t) (value & mask);
+		}
+		bytes_read_ += len;
+		return true;
+	}
+
+private:
+	const uint8_t* buf_;
+	size_t buf_size_;
+	size_t bytes_read_;
+};
+
+
+/**@brief Function to encode a message into a buffer.
+ *
+ * @param[out]	bytes_written	The number of written bytes (can be NULL).
+ *
+ * @retval		true on success, false if the buffer is too small or the message is invalid (e.g. a count is too large).
+ */
+template<Endian E, typename M>
+inline bool encode(uint8_t* buf, size_t buf_size, const M& message, size_t* bytes_written = NULL) {
+	Ostream<E> ostream(buf, buf_size);
+	bool ret = MessageTraits<M>::encode(ostream, message);
+	if(bytes_written != NULL)
+		*bytes_written = ostream.bytes_written();
+	return ret;
+}
+
+/**@brief Function to decode a message from a buffer. The message should be zeroed before (like for tb_decode()).
+ *
+ * @param[out]	bytes_read		The number of read bytes (can be NULL).
+ *
+ * @retval		true on success, false if the buffer is too short or the data is invalid.
+ */
+template<Endian E, typename M>
+inline bool decode(const uint8_t* buf, size_t buf_size, M& message, size_t* bytes_read = NULL) {
+	Istream<E> istream(buf, buf_size);
+	bool ret = MessageTraits<M>::decode(istream, message);
+	if(bytes_read != NULL)
+		*bytes_read = istream.bytes_read();
+	return ret;
+}
+
+}	// namespace tinybuf
+
+#endif
@@ -0,0 +1,212 @@
+/**@file
+ * @details Throughput benchmark of tinybuf on the badge protocol (host only).
+ *			Every message of protocol_messages_02v1.tb and chunk_messages.tb is filled (see message_filler.h),
+ *			and encoded/decoded with the table interpreter (tb_encode()/tb_decode()) and with the straight-line functions,
+ *			in both endiannesses. The results are printed as ns per message and MB/s of encoded data.
+ *
+ *			Usage: run_benchmark [min_time_ms]		(default: 20 ms per measurement)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "tinybuf.h"
+#include "protocol_messages_02v1.h"
+#include "chunk_messages.h"
+#include "message_filler.h"
+
+
+#define MAX_STRUCT_SIZE		4096
+#define MAX_ENCODED_LEN		4096
+
+
+typedef uint8_t (*encode_function_t)(tb_ostream_t* ostream, const void* src, tb_endian_t endianness);
+typedef uint8_t (*decode_function_t)(tb_istream_t* istream, void* dst, tb_endian_t endianness);
+
+typedef struct {
+	const char* name;
+	const tb_field_t* fields;
+	uint32_t struct_size;
+	encode_function_t encode;
+	decode_function_t decode;
+} benchmark_message_t;
+
+typedef enum {
+	CODEC_TABLE_ENCODE,
+	CODEC_TABLE_DECODE,
+	CODEC_STRAIGHT_LINE_ENCODE,
+	CODEC_STRAIGHT_LINE_DECODE,
+	CODEC_NUMBER,
+} codec_t;
+
+#define BENCHMARK_MESSAGE(M)	{#M, M##_fields, sizeof(M), (encode_function_t) M##_encode, (decode_function_t) M##_decode}
+
+static const benchmark_message_t messages[] = {
+	// protocol_messages_02v1.tb
+	BENCHMARK_MESSAGE(StatusRequest),
+	BENCHMARK_MESSAGE(StartMicrophoneRequest),
+	BENCHMARK_MESSAGE(StopMicrophoneRequest),
+	BENCHMARK_MESSAGE(StartScanRequest),
+	BENCHMARK_MESSAGE(StopScanRequest),
+	BENCHMARK_MESSAGE(StartAccelerometerRequest),
+	BENCHMARK_MESSAGE(StopAccelerometerRequest),
+	BENCHMARK_MESSAGE(StartAccelerometerInterruptRequest),
+	BENCHMARK_MESSAGE(StopAccelerometerInterruptRequest),
+	BENCHMARK_MESSAGE(StartBatteryRequest),
+	BENCHMARK_MESSAGE(StopBatteryRequest),
+	BENCHMARK_MESSAGE(MicrophoneDataRequest),
+	BENCHMARK_MESSAGE(ScanDataRequest),
+	BENCHMARK_MESSAGE(AccelerometerDataRequest),
+	BENCHMARK_MESSAGE(AccelerometerInterruptDataRequest),
+	BENCHMARK_MESSAGE(BatteryDataRequest),
+	BENCHMARK_MESSAGE(ExportCursor),
+	BENCHMARK_MESSAGE(BulkExportRequest),
+	BENCHMARK_MESSAGE(PullNewDataRequest),
+	BENCHMARK_MESSAGE(AcknowledgeDataRequest),
+	BENCHMARK_MESSAGE(SetCompressionRequest),
+	BENCHMARK_MESSAGE(StartMicrophoneStreamRequest),
+	BENCHMARK_MESSAGE(StopMicrophoneStreamRequest),
+	BENCHMARK_MESSAGE(StartScanStreamRequest),
+	BENCHMARK_MESSAGE(StopScanStreamRequest),
+	BENCHMARK_MESSAGE(StartAccelerometerStreamRequest),
+	BENCHMARK_MESSAGE(StopAccelerometerStreamRequest),
+	BENCHMARK_MESSAGE(StartAccelerometerInterruptStreamRequest),
+	BENCHMARK_MESSAGE(StopAccelerometerInterruptStreamRequest),
+	BENCHMARK_MESSAGE(StartBatteryStreamRequest),
+	BENCHMARK_MESSAGE(StopBatteryStreamRequest),
+	BENCHMARK_MESSAGE(IdentifyRequest),
+	BENCHMARK_MESSAGE(TestRequest),
+	BENCHMARK_MESSAGE(RestartRequest),
+	BENCHMARK_MESSAGE(DiagnosticsRequest),
+	BENCHMARK_MESSAGE(Request),
+	BENCHMARK_MESSAGE(StatusResponse),
+	BENCHMARK_MESSAGE(StartMicrophoneResponse),
+	BENCHMARK_MESSAGE(StartScanResponse),
+	BENCHMARK_MESSAGE(StartAccelerometerResponse),
+	BENCHMARK_MESSAGE(StartAccelerometerInterruptResponse),
+	BENCHMARK_MESSAGE(StartBatteryResponse),
+	BENCHMARK_MESSAGE(MicrophoneDataResponse),
+	BENCHMARK_MESSAGE(ScanDataResponse),
+	BENCHMARK_MESSAGE(AccelerometerDataResponse),
+	BENCHMARK_MESSAGE(AccelerometerInterruptDataResponse),
+	BENCHMARK_MESSAGE(BatteryDataResponse),
+	BENCHMARK_MESSAGE(BulkExportCheckpointResponse),
+	BENCHMARK_MESSAGE(SetCompressionResponse),
+	BENCHMARK_MESSAGE(StreamResponse),
+	BENCHMARK_MESSAGE(TestResponse),
+	BENCHMARK_MESSAGE(ChunkFifoStatus),
+	BENCHMARK_MESSAGE(DiagnosticsResponse),
+	BENCHMARK_MESSAGE(Response),
+	// chunk_messages.tb
+	BENCHMARK_MESSAGE(BatteryChunk),
+	BENCHMARK_MESSAGE(MicrophoneChunk),
+	BENCHMARK_MESSAGE(ScanSamplingChunk),
+	BENCHMARK_MESSAGE(ScanChunk),
+	BENCHMARK_MESSAGE(AccelerometerChunk),
+	BENCHMARK_MESSAGE(AccelerometerInterruptChunk),
+	BENCHMARK_MESSAGE(DownloadCursor),
+	BENCHMARK_MESSAGE(DownloadCursorTable),
+};
+
+
+static uint8_t message_struct[MAX_STRUCT_SIZE];
+static uint8_t decoded_struct[MAX_STRUCT_SIZE];
+static uint8_t encoded[MAX_ENCODED_LEN];
+
+static volatile uint32_t sink;	/**< Keeps the compiler from removing the measured calls */
+
+
+/**@brief Function to run a codec iterations times.
+ *
+ * @retval	1 if all calls succeeded, otherwise 0.
+ */
+static uint8_t run_codec(const benchmark_message_t* message, codec_t codec, tb_endian_t endianness, uint32_t len, uint32_t iterations) {
+	uint8_t ok = 1;
+	for(uint32_t i = 0; i < iterations; i++) {
+		tb_ostream_t ostream = tb_ostream_from_buffer(encoded, sizeof(encoded));
+		tb_istream_t istream = tb_istream_from_buffer(encoded, len);
+		switch(codec) {
+			case CODEC_TABLE_ENCODE:
+				ok &= tb_encode(&ostream, message->fields, message_struct, endianness);
+				break;
+			case CODEC_TABLE_DECODE:
+				ok &= tb_decode(&istream, message->fields, decoded_struct, endianness);
+				break;
+			case CODEC_STRAIGHT_LINE_ENCODE:
+				ok &= message->encode(&ostream, message_struct, endianness);
+				break;
+			default:
+				ok &= message->decode(&istream, decoded_struct, endianness);
+				break;
+		}
+		sink += encoded[i % sizeof(encoded)] + decoded_struct[i % message->struct_size];
+	}
+	return ok;
+}
+
+/**@brief Function to measure a codec: the number of iterations is doubled until the measurement takes at least min_time_ms.
+ *
+ * @retval	The time per message in ns, or a negative value if the codec failed.
+ */
+static double measure_codec(const benchmark_message_t* message, codec_t codec, tb_endian_t endianness, uint32_t len, double min_time_ms) {
+	for(uint32_t iterations = 16; ; iterations *= 2) {
+		auto start = std::chrono::steady_clock::now();
+		if(!run_codec(message, codec, endianness, len, iterations))
+			return -1;
+		auto end = std::chrono::steady_clock::now();
+		double elapsed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+		if(elapsed_ms >= min_time_ms || iterations >= (1UL << 30))
+			return elapsed_ms * 1e6 / iterations;
+	}
+}
+
+
+int main(int argc, char** argv) {
+	double min_time_ms = (argc > 1) ? atof(argv[1]) : 20;
+	const char* codec_names[CODEC_NUMBER] = {"table enc", "table dec", "straight enc", "straight dec"};
+	const char* endianness_names[2] = {"BE", "LE"};
+
+	printf("%-42s %-3s %6s", "Message", "End", "Bytes");
+	for(uint32_t c = 0; c < CODEC_NUMBER; c++)
+		printf(" | %12s ns %7s", codec_names[c], "MB/s");
+	printf("\n");
+
+	uint8_t failed = 0;
+	for(uint32_t m = 0; m < sizeof(messages)/sizeof(messages[0]); m++) {
+		const benchmark_message_t* message = &messages[m];
+		if(message->struct_size > MAX_STRUCT_SIZE || tb_get_max_encoded_len(message->fields) > MAX_ENCODED_LEN) {
+			printf("%s: Too large for the benchmark buffers\n", message->name);
+			failed = 1;
+			continue;
+		}
+		memset(message_struct, 0, sizeof(message_struct));
+		uint32_t seed = 0x12345678 + m;
+		fill_message(message->fields, message_struct, &seed, -1);
+
+		for(uint32_t e = 0; e < 2; e++) {
+			tb_endian_t endianness = (e == 0) ? TB_BIG_ENDIAN : TB_LITTLE_ENDIAN;
+			tb_ostream_t ostream = tb_ostream_from_buffer(encoded, sizeof(encoded));
+			if(!tb_encode(&ostream, message->fields, message_struct, endianness)) {
+				printf("%s: Encoding failed\n", message->name);
+				failed = 1;
+				continue;
+			}
+			uint32_t len = ostream.bytes_written;
+
+			printf("%-42s %-3s %6u", message->name, endianness_names[e], len);
+			for(uint32_t c = 0; c < CODEC_NUMBER; c++) {
+				double ns = measure_codec(message, (codec_t) c, endianness, len, min_time_ms);
+				if(ns < 0) {
+					printf(" | %15s %7s", "failed", "-");
+					failed = 1;
+				} else {
+					printf(" | %15.1f %7.1f", ns, (ns > 0) ? (len * 1e3 / ns) : 0);
+				}
+			}
+			printf("\n");
+		}
+	}
+	return failed;
+}
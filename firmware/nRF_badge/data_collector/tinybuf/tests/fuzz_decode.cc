@@ -0,0 +1,157 @@
+/**@file
+ * @details Fuzz target for the decoding of requests (host only): the badge decodes the untrusted bytes,
+ *			that are received via BLE, with tb_decode() and Request_fields.
+ *
+ *			For every input and both endiannesses it checks:
+ *				- No memory errors (build with address-/undefined-behavior-sanitizer).
+ *				- tb_decode(), the straight-line Request_decode() and tb_decode() with a callback-stream
+ *				  accept/reject the same inputs, consume the same bytes and produce the same structure.
+ *				- Encoding an accepted request reproduces the consumed bytes.
+ *
+ *			With libFuzzer (clang):	make fuzz_decode, then _build/run_fuzz_decode [corpus-dir]
+ *			Without libFuzzer:		make fuzz_decode_replay, then _build/run_fuzz_decode_replay [files...]
+ *				Without files, pseudo-random mutations of valid requests are checked.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tinybuf.h"
+#include "protocol_messages_02v1.h"
+#include "message_filler.h"
+
+
+#define FUZZ_CHECK(condition)	{if(!(condition)) { fprintf(stderr, "Fuzz check failed at line %u: %s\n", __LINE__, #condition); abort(); }}
+
+#define FUZZ_WINDOW_SIZE	TB_STREAM_MIN_WINDOW_SIZE
+
+
+typedef struct {
+	const uint8_t* data;
+	uint32_t len;
+	uint32_t pos;
+} fuzz_source_t;
+
+/**@brief Callback of the input-stream: provides the input in pieces of up to 3 bytes, to exercise the window refills.
+ */
+static uint32_t fuzz_source_callback(tb_istream_t* istream, uint8_t* buf, uint32_t max_len) {
+	fuzz_source_t* source = (fuzz_source_t*) istream->state;
+	uint32_t len = source->len - source->pos;
+	if(len > max_len)
+		len = max_len;
+	if(len > 3)
+		len = 3;
+	memcpy(buf, &(source->data[source->pos]), len);
+	source->pos += len;
+	return len;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	static Request table, straight_line, streamed;
+	static uint8_t encoded[sizeof(Request) + 64];
+	static uint8_t window[FUZZ_WINDOW_SIZE];
+
+	for(uint32_t e = 0; e < 2; e++) {
+		tb_endian_t endianness = (e == 0) ? TB_BIG_ENDIAN : TB_LITTLE_ENDIAN;
+		memset(&table, 0, sizeof(table));
+		memset(&straight_line, 0, sizeof(straight_line));
+		memset(&streamed, 0, sizeof(streamed));
+
+		tb_istream_t istream_table = tb_istream_from_buffer((uint8_t*) data, (uint32_t) size);
+		uint8_t ret_table = tb_decode(&istream_table, Request_fields, &table, endianness);
+
+		tb_istream_t istream_straight_line = tb_istream_from_buffer((uint8_t*) data, (uint32_t) size);
+		uint8_t ret_straight_line = Request_decode(&istream_straight_line, &straight_line, endianness);
+
+		fuzz_source_t source = {data, (uint32_t) size, 0};
+		tb_istream_t istream_streamed = tb_istream_from_callback(fuzz_source_callback, &source, window, sizeof(window));
+		uint8_t ret_streamed = tb_decode(&istream_streamed, Request_fields, &streamed, endianness);
+
+		FUZZ_CHECK(ret_table == ret_straight_line);
+		FUZZ_CHECK(ret_table == ret_streamed);
+		if(!ret_table)
+			continue;
+
+		FUZZ_CHECK(istream_table.bytes_read <= size);
+		FUZZ_CHECK(istream_table.bytes_read == istream_straight_line.bytes_read);
+		FUZZ_CHECK(istream_table.bytes_read == istream_streamed.bytes_read);
+		FUZZ_CHECK(memcmp(&table, &straight_line, sizeof(table)) == 0);
+		FUZZ_CHECK(memcmp(&table, &streamed, sizeof(table)) == 0);
+
+		tb_ostream_t ostream = tb_ostream_from_buffer(encoded, sizeof(encoded));
+		FUZZ_CHECK(tb_encode(&ostream, Request_fields, &table, endianness) == 1);
+		FUZZ_CHECK(ostream.bytes_written == istream_table.bytes_read);
+		FUZZ_CHECK(memcmp(encoded, data, ostream.bytes_written) == 0);
+	}
+	return 0;
+}
+
+
+#ifdef FUZZ_STANDALONE
+
+#define FUZZ_ITERATIONS		200000
+
+/**@brief Function to check the inputs of files (e.g. crashes found by libFuzzer).
+ */
+static int replay_files(int number_of_files, char** file_names) {
+	static uint8_t buf[65536];
+	for(int i = 0; i < number_of_files; i++) {
+		FILE* file = fopen(file_names[i], "rb");
+		if(file == NULL) {
+			fprintf(stderr, "Could not open %s\n", file_names[i]);
+			return 1;
+		}
+		size_t len = fread(buf, 1, sizeof(buf), file);
+		fclose(file);
+		LLVMFuzzerTestOneInput(buf, len);
+	}
+	printf("Checked %d files\n", number_of_files);
+	return 0;
+}
+
+/**@brief Function to check pseudo-random mutations (bit-flips, truncations, random bytes) of valid requests of every type.
+ */
+static int run_mutations(void) {
+	static Request request;
+	static uint8_t valid[sizeof(Request) + 64];
+	static uint8_t mutated[sizeof(valid)];
+	uint32_t seed = 0x2545F491;
+	uint32_t accepted = 0;
+	for(uint32_t i = 0; i < FUZZ_ITERATIONS; i++) {
+		// A valid request of the type i (modulo the number of types)
+		memset(&request, 0, sizeof(request));
+		fill_message(Request_fields, &request, &seed, (int32_t) (i % 64));
+		tb_endian_t endianness = (i & 1) ? TB_LITTLE_ENDIAN : TB_BIG_ENDIAN;
+		tb_ostream_t ostream = tb_ostream_from_buffer(valid, sizeof(valid));
+		FUZZ_CHECK(tb_encode(&ostream, Request_fields, &request, endianness) == 1);
+		uint32_t len = ostream.bytes_written;
+
+		memcpy(mutated, valid, len);
+		uint32_t mutations = filler_random_byte(&seed) % 4;
+		for(uint32_t k = 0; k < mutations && len > 0; k++) {
+			uint32_t pos = filler_random_byte(&seed) % len;
+			if(filler_random_byte(&seed) & 1)
+				mutated[pos] ^= (uint8_t) (1 << (filler_random_byte(&seed) % 8));
+			else
+				mutated[pos] = filler_random_byte(&seed);
+		}
+		if(len > 0 && (filler_random_byte(&seed) % 4) == 0)
+			len = filler_random_byte(&seed) % len;
+
+		tb_istream_t istream = tb_istream_from_buffer(mutated, len);
+		memset(&request, 0, sizeof(request));
+		accepted += tb_decode(&istream, Request_fields, &request, endianness);
+		LLVMFuzzerTestOneInput(mutated, len);
+	}
+	printf("Checked %u mutated requests (%u accepted)\n", FUZZ_ITERATIONS, accepted);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	if(argc > 1)
+		return replay_files(argc - 1, &argv[1]);
+	return run_mutations();
+}
+
+#endif
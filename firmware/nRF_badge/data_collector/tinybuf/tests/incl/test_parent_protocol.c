@@ -5,3 +5,13 @@ const tb_field_t Empty_message_fields[1] = {
 	TB_LAST_FIELD,
 };
 
+uint8_t Empty_message_encode(tb_ostream_t* ostream, const Empty_message* src, tb_endian_t endianness) {
+	if(ostream->callback != NULL) return tb_encode(ostream, Empty_message_fields, (void*) src, endianness);
+	return 1;
+}
+
+uint8_t Empty_message_decode(tb_istream_t* istream, Empty_message* dst, tb_endian_t endianness) {
+	if(istream->callback != NULL) return tb_decode(istream, Empty_message_fields, dst, endianness);
+	return 1;
+}
+
@@ -11,4 +11,16 @@ typedef struct {
 
 extern const tb_field_t Empty_message_fields[1];
 
+/**< Straight-line encode/decode functions (same binary representation as tb_encode()/tb_decode() with the _fields-arrays) */
+#define Empty_message_ENCODED_LEN 0
+static inline void Empty_message_put(uint8_t* p, const Empty_message* src, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) src;
+}
+static inline void Empty_message_get(const uint8_t* p, Empty_message* dst, tb_endian_t endianness) {
+	(void) p; (void) endianness; (void) dst;
+}
+uint8_t Empty_message_encode(tb_ostream_t* ostream, const Empty_message* src, tb_endian_t endianness);
+uint8_t Empty_message_decode(tb_istream_t* istream, Empty_message* dst, tb_endian_t endianness);
+
+
 #endif
@@ -0,0 +1,36 @@
+#ifndef __TEST_PARENT_PROTOCOL_HPP
+#define __TEST_PARENT_PROTOCOL_HPP
+
+#include <stdint.h>
+#include "tinybuf.hpp"
+
+
+
+namespace tinybuf {
+
+typedef struct {
+} Empty_message;
+
+template<>
+struct MessageTraits<Empty_message> {
+	static constexpr const char* name() { return "Empty_message"; }
+	static constexpr uint32_t max_encoded_len() { return 0; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const Empty_message& message) {
+		(void) ostream; (void) message;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, Empty_message& message) {
+		(void) istream; (void) message;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const Empty_message& message) {
+		(void) visitor; (void) message;
+	}
+};
+
+}	// namespace tinybuf
+
+#endif
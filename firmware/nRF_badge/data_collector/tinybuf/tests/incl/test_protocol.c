@@ -13,7 +13,15 @@ const tb_field_t Embedded_message_fields[4] = {
 	TB_LAST_FIELD,
 };
 
-const tb_field_t Test_message_fields[13] = {
+const tb_field_t Full_count_message_fields[5] = {
+	{65, tb_offsetof(Full_count_message, h), 0, 0, tb_membersize(Full_count_message, h), 0, 0, 0, NULL},
+	{68, tb_offsetof(Full_count_message, full_array), tb_delta(Full_count_message, full_array_count, full_array), 1, tb_membersize(Full_count_message, full_array[0]), tb_membersize(Full_count_message, full_array)/tb_membersize(Full_count_message, full_array[0]), 0, 0, NULL},
+	{65, tb_offsetof(Full_count_message, i), 0, 0, tb_membersize(Full_count_message, i), 0, 0, 0, NULL},
+	{36868, tb_offsetof(Full_count_message, full_nibble_array), tb_delta(Full_count_message, full_nibble_array_count, full_nibble_array), 1, tb_membersize(Full_count_message, full_nibble_array[0]), tb_membersize(Full_count_message, full_nibble_array)/tb_membersize(Full_count_message, full_nibble_array[0]), 0, 0, NULL},
+	TB_LAST_FIELD,
+};
+
+const tb_field_t Test_message_fields[19] = {
 	{72, tb_offsetof(Test_message, fixed_array), 0, 0, tb_membersize(Test_message, fixed_array[0]), tb_membersize(Test_message, fixed_array)/tb_membersize(Test_message, fixed_array[0]), 0, 0, NULL},
 	{66, tb_offsetof(Test_message, a), tb_delta(Test_message, has_a, a), 1, tb_membersize(Test_message, a), 0, 0, 0, NULL},
 	{33, tb_offsetof(Test_message, b), 0, 0, tb_membersize(Test_message, b), 0, 0, 0, NULL},
@@ -24,8 +32,317 @@ const tb_field_t Test_message_fields[13] = {
 	{68, tb_offsetof(Test_message, uint8_array), tb_delta(Test_message, uint8_array_count, uint8_array), 2, tb_membersize(Test_message, uint8_array[0]), tb_membersize(Test_message, uint8_array)/tb_membersize(Test_message, uint8_array[0]), 0, 0, NULL},
 	{258, tb_offsetof(Test_message, c), tb_delta(Test_message, has_c, c), 1, tb_membersize(Test_message, c), 0, 0, 0, NULL},
 	{129, tb_offsetof(Test_message, d), 0, 0, tb_membersize(Test_message, d), 0, 0, 0, NULL},
+	{2049, tb_offsetof(Test_message, v), 0, 0, tb_membersize(Test_message, v), 0, 0, 0, NULL},
+	{1025, tb_offsetof(Test_message, w), 0, 0, tb_membersize(Test_message, w), 0, 0, 0, NULL},
+	{1026, tb_offsetof(Test_message, y), tb_delta(Test_message, has_y, y), 1, tb_membersize(Test_message, y), 0, 0, 0, NULL},
+	{2052, tb_offsetof(Test_message, varint_array), tb_delta(Test_message, varint_array_count, varint_array), 1, tb_membersize(Test_message, varint_array[0]), tb_membersize(Test_message, varint_array)/tb_membersize(Test_message, varint_array[0]), 0, 0, NULL},
+	{36868, tb_offsetof(Test_message, nibble_array), tb_delta(Test_message, nibble_array_count, nibble_array), 1, tb_membersize(Test_message, nibble_array[0]), tb_membersize(Test_message, nibble_array)/tb_membersize(Test_message, nibble_array[0]), 0, 0, NULL},
+	{28676, tb_offsetof(Test_message, packed_array), tb_delta(Test_message, packed_array_count, packed_array), 1, tb_membersize(Test_message, packed_array[0]), tb_membersize(Test_message, packed_array)/tb_membersize(Test_message, packed_array[0]), 0, 0, NULL},
 	{80, tb_offsetof(Test_message, payload.x), tb_delta(Test_message, which_payload, payload.x), 1, tb_membersize(Test_message, payload.x), 0, 1, 1, NULL},
 	{528, tb_offsetof(Test_message, payload.embedded_message_oneof), tb_delta(Test_message, which_payload, payload.embedded_message_oneof), 1, tb_membersize(Test_message, payload.embedded_message_oneof), 0, 2, 0, &Embedded_message_fields},
 	TB_LAST_FIELD,
 };
 
+uint8_t Embedded_message1_encode(tb_ostream_t* ostream, const Embedded_message1* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, Embedded_message1_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->has_e;
+	if(src->has_e) {
+		p = tb_ostream_reserve(ostream, 8);
+		if(p == NULL) return 0;
+		tb_put_64(p, (uint64_t) src->e, endianness);
+	}
+	return 1;
+}
+
+uint8_t Embedded_message1_decode(tb_istream_t* istream, Embedded_message1* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, Embedded_message1_fields, dst, endianness);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->has_e = (uint8_t) *(p);
+	if(dst->has_e) {
+		p = tb_istream_consume(istream, 8);
+		if(p == NULL) return 0;
+		dst->e = (uint64_t) tb_get_64(p, endianness);
+	}
+	return 1;
+}
+
+uint8_t Embedded_message_encode(tb_ostream_t* ostream, const Embedded_message* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, Embedded_message_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->f;
+	for(uint32_t i = 0; i < 2; i++) if(!Embedded_message1_encode(ostream, &(src->embedded_message1[i]), endianness)) return 0;
+	p = tb_ostream_reserve(ostream, 1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->which_embedded_payload;
+	switch(src->which_embedded_payload) {
+		case Embedded_message_g_tag:
+			p = tb_ostream_reserve(ostream, 1);
+			if(p == NULL) return 0;
+			*(p) = (uint8_t) src->embedded_payload.g;
+			break;
+		default:
+			return 0;
+	}
+	return 1;
+}
+
+uint8_t Embedded_message_decode(tb_istream_t* istream, Embedded_message* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, Embedded_message_fields, dst, endianness);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->f = (uint8_t) *(p);
+	for(uint32_t i = 0; i < 2; i++) if(!Embedded_message1_decode(istream, &(dst->embedded_message1[i]), endianness)) return 0;
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->which_embedded_payload = (uint8_t) *(p);
+	switch(dst->which_embedded_payload) {
+		case Embedded_message_g_tag:
+			p = tb_istream_consume(istream, 1);
+			if(p == NULL) return 0;
+			dst->embedded_payload.g = (uint8_t) *(p);
+			break;
+		default:
+			return 0;
+	}
+	return 1;
+}
+
+uint8_t Full_count_message_encode(tb_ostream_t* ostream, const Full_count_message* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, Full_count_message_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 2);
+	if(p == NULL) return 0;
+	tb_put_16(p, (uint16_t) src->h, endianness);
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->full_array_count)*1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->full_array_count;
+	for(uint32_t i = 0; i < src->full_array_count; i++) *(p + 1 + i*1) = (uint8_t) src->full_array[i];
+	p = tb_ostream_reserve(ostream, 1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->i;
+	p = tb_ostream_reserve(ostream, 1 + TB_PACKED_LEN(src->full_nibble_array_count, 4));
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->full_nibble_array_count;
+	if(!tb_pack_bits(p + 1, src->full_nibble_array, src->full_nibble_array_count, 4)) return 0;
+	return 1;
+}
+
+uint8_t Full_count_message_decode(tb_istream_t* istream, Full_count_message* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	if(istream->callback != NULL) return tb_decode(istream, Full_count_message_fields, dst, endianness);
+	p = tb_istream_consume(istream, 3);
+	if(p == NULL) return 0;
+	dst->h = (uint16_t) tb_get_16(p, endianness);
+	dst->full_array_count = (uint8_t) *(p + 2);
+	p = tb_istream_consume(istream, ((uint32_t) dst->full_array_count)*1);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->full_array_count; i++) dst->full_array[i] = (uint8_t) *(p + i*1);
+	p = tb_istream_consume(istream, 2);
+	if(p == NULL) return 0;
+	dst->i = (uint8_t) *(p);
+	dst->full_nibble_array_count = (uint8_t) *(p + 1);
+	p = tb_istream_consume(istream, TB_PACKED_LEN(dst->full_nibble_array_count, 4));
+	if(p == NULL) return 0;
+	tb_unpack_bits(p, dst->full_nibble_array, dst->full_nibble_array_count, 4);
+	return 1;
+}
+
+uint8_t Test_message_encode(tb_ostream_t* ostream, const Test_message* src, tb_endian_t endianness) {
+	uint8_t* p;
+	if(ostream->callback != NULL) return tb_encode(ostream, Test_message_fields, (void*) src, endianness);
+	p = tb_ostream_reserve(ostream, 17);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < 4; i++) tb_put_32(p + i*4, (uint32_t) src->fixed_array[i], endianness);
+	*(p + 16) = (uint8_t) src->has_a;
+	if(src->has_a) {
+		p = tb_ostream_reserve(ostream, 2);
+		if(p == NULL) return 0;
+		tb_put_16(p, (uint16_t) src->a, endianness);
+	}
+	p = tb_ostream_reserve(ostream, 4);
+	if(p == NULL) return 0;
+	tb_put_32(p, (uint32_t) src->b, endianness);
+	if(src->uint16_array_count > 10) return 0;
+	p = tb_ostream_reserve(ostream, 1 + ((uint32_t) src->uint16_array_count)*2);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->uint16_array_count;
+	for(uint32_t i = 0; i < src->uint16_array_count; i++) tb_put_16(p + 1 + i*2, (uint16_t) src->uint16_array[i], endianness);
+	if(src->embedded_messages_count > 12) return 0;
+	p = tb_ostream_reserve(ostream, 1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->embedded_messages_count;
+	for(uint32_t i = 0; i < src->embedded_messages_count; i++) if(!Embedded_message_encode(ostream, &(src->embedded_messages[i]), endianness)) return 0;
+	p = tb_ostream_reserve(ostream, 1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->has_embedded_message1;
+	if(src->has_embedded_message1) {
+		if(!Embedded_message1_encode(ostream, &(src->embedded_message1), endianness)) return 0;
+	}
+	if(src->uint8_array_count > 1000) return 0;
+	p = tb_ostream_reserve(ostream, 2 + ((uint32_t) src->uint8_array_count)*1);
+	if(p == NULL) return 0;
+	tb_put_16(p, (uint16_t) src->uint8_array_count, endianness);
+	for(uint32_t i = 0; i < src->uint8_array_count; i++) *(p + 2 + i*1) = (uint8_t) src->uint8_array[i];
+	p = tb_ostream_reserve(ostream, 1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->has_c;
+	if(src->has_c) {
+		p = tb_ostream_reserve(ostream, 8);
+		if(p == NULL) return 0;
+		tb_put_double(p, src->c, endianness);
+	}
+	p = tb_ostream_reserve(ostream, 4);
+	if(p == NULL) return 0;
+	tb_put_float(p, src->d, endianness);
+	if(!tb_encode_varuint(ostream, (uint64_t) src->v)) return 0;
+	if(!tb_encode_varuint(ostream, tb_zigzag_encode((int64_t) src->w))) return 0;
+	p = tb_ostream_reserve(ostream, 1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->has_y;
+	if(src->has_y) {
+		if(!tb_encode_varuint(ostream, tb_zigzag_encode((int64_t) src->y))) return 0;
+	}
+	if(src->varint_array_count > 10) return 0;
+	p = tb_ostream_reserve(ostream, 1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->varint_array_count;
+	for(uint32_t i = 0; i < src->varint_array_count; i++) {
+		if(!tb_encode_varuint(ostream, (uint64_t) src->varint_array[i])) return 0;
+	}
+	if(src->nibble_array_count > 10) return 0;
+	p = tb_ostream_reserve(ostream, 1 + TB_PACKED_LEN(src->nibble_array_count, 4));
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->nibble_array_count;
+	if(!tb_pack_bits(p + 1, src->nibble_array, src->nibble_array_count, 4)) return 0;
+	if(src->packed_array_count > 10) return 0;
+	p = tb_ostream_reserve(ostream, 1 + TB_PACKED_LEN(src->packed_array_count, 3));
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->packed_array_count;
+	if(!tb_pack_bits(p + 1, src->packed_array, src->packed_array_count, 3)) return 0;
+	p = tb_ostream_reserve(ostream, 1);
+	if(p == NULL) return 0;
+	*(p) = (uint8_t) src->which_payload;
+	switch(src->which_payload) {
+		case Test_message_x_tag:
+			p = tb_ostream_reserve(ostream, 1);
+			if(p == NULL) return 0;
+			*(p) = (uint8_t) src->payload.x;
+			break;
+		case Test_message_embedded_message_oneof_tag:
+			if(!Embedded_message_encode(ostream, &(src->payload.embedded_message_oneof), endianness)) return 0;
+			break;
+		default:
+			return 0;
+	}
+	return 1;
+}
+
+uint8_t Test_message_decode(tb_istream_t* istream, Test_message* dst, tb_endian_t endianness) {
+	const uint8_t* p;
+	uint64_t varint;
+	if(istream->callback != NULL) return tb_decode(istream, Test_message_fields, dst, endianness);
+	p = tb_istream_consume(istream, 17);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < 4; i++) dst->fixed_array[i] = (uint32_t) tb_get_32(p + i*4, endianness);
+	dst->has_a = (uint8_t) *(p + 16);
+	if(dst->has_a) {
+		p = tb_istream_consume(istream, 2);
+		if(p == NULL) return 0;
+		dst->a = (uint16_t) tb_get_16(p, endianness);
+	}
+	p = tb_istream_consume(istream, 5);
+	if(p == NULL) return 0;
+	dst->b = (int32_t) tb_get_32(p, endianness);
+	dst->uint16_array_count = (uint8_t) *(p + 4);
+	if(dst->uint16_array_count > 10) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->uint16_array_count)*2);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->uint16_array_count; i++) dst->uint16_array[i] = (uint16_t) tb_get_16(p + i*2, endianness);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->embedded_messages_count = (uint8_t) *(p);
+	if(dst->embedded_messages_count > 12) return 0;
+	for(uint32_t i = 0; i < dst->embedded_messages_count; i++) if(!Embedded_message_decode(istream, &(dst->embedded_messages[i]), endianness)) return 0;
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->has_embedded_message1 = (uint8_t) *(p);
+	if(dst->has_embedded_message1) {
+		if(!Embedded_message1_decode(istream, &(dst->embedded_message1), endianness)) return 0;
+	}
+	p = tb_istream_consume(istream, 2);
+	if(p == NULL) return 0;
+	dst->uint8_array_count = (uint16_t) tb_get_16(p, endianness);
+	if(dst->uint8_array_count > 1000) return 0;
+	p = tb_istream_consume(istream, ((uint32_t) dst->uint8_array_count)*1);
+	if(p == NULL) return 0;
+	for(uint32_t i = 0; i < dst->uint8_array_count; i++) dst->uint8_array[i] = (uint8_t) *(p + i*1);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->has_c = (uint8_t) *(p);
+	if(dst->has_c) {
+		p = tb_istream_consume(istream, 8);
+		if(p == NULL) return 0;
+		dst->c = tb_get_double(p, endianness);
+	}
+	p = tb_istream_consume(istream, 4);
+	if(p == NULL) return 0;
+	dst->d = tb_get_float(p, endianness);
+	if(!tb_decode_varuint(istream, &varint, 4)) return 0;
+	dst->v = (uint32_t) varint;
+	if(!tb_decode_varuint(istream, &varint, 2)) return 0;
+	dst->w = (int16_t) tb_zigzag_decode(varint);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->has_y = (uint8_t) *(p);
+	if(dst->has_y) {
+		if(!tb_decode_varuint(istream, &varint, 8)) return 0;
+		dst->y = (int64_t) tb_zigzag_decode(varint);
+	}
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->varint_array_count = (uint8_t) *(p);
+	if(dst->varint_array_count > 10) return 0;
+	for(uint32_t i = 0; i < dst->varint_array_count; i++) {
+		if(!tb_decode_varuint(istream, &varint, 2)) return 0;
+		dst->varint_array[i] = (uint16_t) varint;
+	}
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->nibble_array_count = (uint8_t) *(p);
+	if(dst->nibble_array_count > 10) return 0;
+	p = tb_istream_consume(istream, TB_PACKED_LEN(dst->nibble_array_count, 4));
+	if(p == NULL) return 0;
+	tb_unpack_bits(p, dst->nibble_array, dst->nibble_array_count, 4);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->packed_array_count = (uint8_t) *(p);
+	if(dst->packed_array_count > 10) return 0;
+	p = tb_istream_consume(istream, TB_PACKED_LEN(dst->packed_array_count, 3));
+	if(p == NULL) return 0;
+	tb_unpack_bits(p, dst->packed_array, dst->packed_array_count, 3);
+	p = tb_istream_consume(istream, 1);
+	if(p == NULL) return 0;
+	dst->which_payload = (uint8_t) *(p);
+	switch(dst->which_payload) {
+		case Test_message_x_tag:
+			p = tb_istream_consume(istream, 1);
+			if(p == NULL) return 0;
+			dst->payload.x = (uint8_t) *(p);
+			break;
+		case Test_message_embedded_message_oneof_tag:
+			if(!Embedded_message_decode(istream, &(dst->payload.embedded_message_oneof), endianness)) return 0;
+			break;
+		default:
+			return 0;
+	}
+	return 1;
+}
+
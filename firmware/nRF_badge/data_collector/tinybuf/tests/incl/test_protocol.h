@@ -27,6 +27,15 @@ typedef struct {
 	} embedded_payload;
 } Embedded_message;
 
+typedef struct {
+	uint16_t h;
+	uint8_t full_array_count;
+	uint8_t full_array[255];
+	uint8_t i;
+	uint8_t full_nibble_array_count;
+	uint8_t full_nibble_array[255];
+} Full_count_message;
+
 typedef struct {
 	uint32_t fixed_array[4];
 	uint8_t has_a;
@@ -44,6 +53,16 @@ typedef struct {
 	uint8_t has_c;
 	double c;
 	float d;
+	uint32_t v;
+	int16_t w;
+	uint8_t has_y;
+	int64_t y;
+	uint8_t varint_array_count;
+	uint16_t varint_array[10];
+	uint8_t nibble_array_count;
+	uint8_t nibble_array[10];
+	uint8_t packed_array_count;
+	uint8_t packed_array[10];
 	uint8_t which_payload;
 	union {
 		uint8_t x;
@@ -53,6 +72,21 @@ typedef struct {
 
 extern const tb_field_t Embedded_message1_fields[2];
 extern const tb_field_t Embedded_message_fields[4];
-extern const tb_field_t Test_message_fields[13];
+extern const tb_field_t Full_count_message_fields[5];
+extern const tb_field_t Test_message_fields[19];
+
+/**< Straight-line encode/decode functions (same binary representation as tb_encode()/tb_decode() with the _fields-arrays) */
+uint8_t Embedded_message1_encode(tb_ostream_t* ostream, const Embedded_message1* src, tb_endian_t endianness);
+uint8_t Embedded_message1_decode(tb_istream_t* istream, Embedded_message1* dst, tb_endian_t endianness);
+
+uint8_t Embedded_message_encode(tb_ostream_t* ostream, const Embedded_message* src, tb_endian_t endianness);
+uint8_t Embedded_message_decode(tb_istream_t* istream, Embedded_message* dst, tb_endian_t endianness);
+
+uint8_t Full_count_message_encode(tb_ostream_t* ostream, const Full_count_message* src, tb_endian_t endianness);
+uint8_t Full_count_message_decode(tb_istream_t* istream, Full_count_message* dst, tb_endian_t endianness);
+
+uint8_t Test_message_encode(tb_ostream_t* ostream, const Test_message* src, tb_endian_t endianness);
+uint8_t Test_message_decode(tb_istream_t* istream, Test_message* dst, tb_endian_t endianness);
+
 
 #endif
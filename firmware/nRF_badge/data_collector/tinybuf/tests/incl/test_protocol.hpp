@@ -0,0 +1,397 @@
+#ifndef __TEST_PROTOCOL_HPP
+#define __TEST_PROTOCOL_HPP
+
+#include <stdint.h>
+#include "tinybuf.hpp"
+#include "test_parent_protocol.hpp"
+
+#define TEST1 10
+#define TEST2 12
+#define TEST3 1000
+
+#define Embedded_message_g_tag 100
+#define Test_message_x_tag 1
+#define Test_message_embedded_message_oneof_tag 2
+
+namespace tinybuf {
+
+typedef struct {
+	uint8_t has_e;
+	uint64_t e;
+} Embedded_message1;
+
+template<>
+struct MessageTraits<Embedded_message1> {
+	static constexpr const char* name() { return "Embedded_message1"; }
+	static constexpr uint32_t max_encoded_len() { return 1 + 8; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const Embedded_message1& message) {
+		if(!ostream.write(message.has_e))
+			return false;
+		if(message.has_e && !ostream.write(message.e))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, Embedded_message1& message) {
+		if(!istream.read(message.has_e))
+			return false;
+		if(message.has_e && !istream.read(message.e))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const Embedded_message1& message) {
+		visitor.optional("e", message.has_e, message.e);
+	}
+};
+
+typedef struct {
+	uint8_t f;
+	Embedded_message1 embedded_message1[2];
+	uint8_t which_embedded_payload;
+	union {
+		uint8_t g;
+	} embedded_payload;
+} Embedded_message;
+
+template<>
+struct MessageTraits<Embedded_message> {
+	static constexpr const char* name() { return "Embedded_message"; }
+	static constexpr uint32_t max_encoded_len() { return 1 + 2*MessageTraits<Embedded_message1>::max_encoded_len() + 1 + 1; }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const Embedded_message& message) {
+		if(!ostream.write(message.f))
+			return false;
+		for(uint32_t i = 0; i < 2; i++)
+			if(!MessageTraits<Embedded_message1>::encode(ostream, message.embedded_message1[i]))
+				return false;
+		if(!ostream.write(message.which_embedded_payload))
+			return false;
+		switch(message.which_embedded_payload) {
+			case 100:
+				if(!ostream.write(message.embedded_payload.g))
+					return false;
+				break;
+			default:
+				return false;
+		}
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, Embedded_message& message) {
+		if(!istream.read(message.f))
+			return false;
+		for(uint32_t i = 0; i < 2; i++)
+			if(!MessageTraits<Embedded_message1>::decode(istream, message.embedded_message1[i]))
+				return false;
+		if(!istream.read(message.which_embedded_payload))
+			return false;
+		switch(message.which_embedded_payload) {
+			case 100:
+				if(!istream.read(message.embedded_payload.g))
+					return false;
+				break;
+			default:
+				return false;
+		}
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const Embedded_message& message) {
+		visitor.field("f", message.f);
+		visitor.repeated("embedded_message1", message.embedded_message1, (uint32_t) 2);
+		visitor.begin_oneof("embedded_payload", message.which_embedded_payload);
+		visitor.oneof_member("g", message.which_embedded_payload == 100, message.embedded_payload.g);
+		visitor.end_oneof();
+	}
+};
+
+typedef struct {
+	uint16_t h;
+	uint8_t full_array_count;
+	uint8_t full_array[255];
+	uint8_t i;
+	uint8_t full_nibble_array_count;
+	uint8_t full_nibble_array[255];
+} Full_count_message;
+
+template<>
+struct MessageTraits<Full_count_message> {
+	static constexpr const char* name() { return "Full_count_message"; }
+	static constexpr uint32_t max_encoded_len() { return 2 + 1 + 255*1 + 1 + 1 + packed_len(255, 4); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const Full_count_message& message) {
+		if(!ostream.write(message.h))
+			return false;
+		if(!ostream.write(message.full_array_count))
+			return false;
+		if(!ostream.write_array(message.full_array, message.full_array_count))
+			return false;
+		if(!ostream.write(message.i))
+			return false;
+		if(!ostream.write(message.full_nibble_array_count))
+			return false;
+		if(!ostream.write_packed(message.full_nibble_array, message.full_nibble_array_count, 4))
+			return false;
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, Full_count_message& message) {
+		if(!istream.read(message.h))
+			return false;
+		if(!istream.read(message.full_array_count))
+			return false;
+		if(!istream.read_array(message.full_array, message.full_array_count))
+			return false;
+		if(!istream.read(message.i))
+			return false;
+		if(!istream.read(message.full_nibble_array_count))
+			return false;
+		if(!istream.read_packed(message.full_nibble_array, message.full_nibble_array_count, 4))
+			return false;
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const Full_count_message& message) {
+		visitor.field("h", message.h);
+		visitor.repeated("full_array", message.full_array, (uint32_t) message.full_array_count);
+		visitor.field("i", message.i);
+		visitor.repeated("full_nibble_array", message.full_nibble_array, (uint32_t) message.full_nibble_array_count);
+	}
+};
+
+typedef struct {
+	uint32_t fixed_array[4];
+	uint8_t has_a;
+	uint16_t a;
+	int32_t b;
+	uint8_t uint16_array_count;
+	uint16_t uint16_array[10];
+	uint8_t embedded_messages_count;
+	Embedded_message embedded_messages[12];
+	uint8_t has_embedded_message1;
+	Embedded_message1 embedded_message1;
+	Empty_message empty_message;
+	uint16_t uint8_array_count;
+	uint8_t uint8_array[1000];
+	uint8_t has_c;
+	double c;
+	float d;
+	uint32_t v;
+	int16_t w;
+	uint8_t has_y;
+	int64_t y;
+	uint8_t varint_array_count;
+	uint16_t varint_array[10];
+	uint8_t nibble_array_count;
+	uint8_t nibble_array[10];
+	uint8_t packed_array_count;
+	uint8_t packed_array[10];
+	uint8_t which_payload;
+	union {
+		uint8_t x;
+		Embedded_message embedded_message_oneof;
+	} payload;
+} Test_message;
+
+template<>
+struct MessageTraits<Test_message> {
+	static constexpr const char* name() { return "Test_message"; }
+	static constexpr uint32_t max_encoded_len() { return 4*4 + 1 + 2 + 4 + 1 + 10*2 + 1 + 12*MessageTraits<Embedded_message>::max_encoded_len() + 1 + MessageTraits<Embedded_message1>::max_encoded_len() + MessageTraits<Empty_message>::max_encoded_len() + 2 + 1000*1 + 1 + 8 + 4 + varint_max_len(4) + varint_max_len(2) + 1 + varint_max_len(8) + 1 + 10*varint_max_len(2) + 1 + packed_len(10, 4) + 1 + packed_len(10, 3) + 1 + max_len(1, MessageTraits<Embedded_message>::max_encoded_len()); }
+
+	template<Endian E> static bool encode(Ostream<E>& ostream, const Test_message& message) {
+		if(!ostream.write_array(message.fixed_array, 4))
+			return false;
+		if(!ostream.write(message.has_a))
+			return false;
+		if(message.has_a && !ostream.write(message.a))
+			return false;
+		if(!ostream.write(message.b))
+			return false;
+		if(message.uint16_array_count > 10)
+			return false;
+		if(!ostream.write(message.uint16_array_count))
+			return false;
+		if(!ostream.write_array(message.uint16_array, message.uint16_array_count))
+			return false;
+		if(message.embedded_messages_count > 12)
+			return false;
+		if(!ostream.write(message.embedded_messages_count))
+			return false;
+		for(uint32_t i = 0; i < message.embedded_messages_count; i++)
+			if(!MessageTraits<Embedded_message>::encode(ostream, message.embedded_messages[i]))
+				return false;
+		if(!ostream.write(message.has_embedded_message1))
+			return false;
+		if(message.has_embedded_message1 && !MessageTraits<Embedded_message1>::encode(ostream, message.embedded_message1))
+			return false;
+		if(!MessageTraits<Empty_message>::encode(ostream, message.empty_message))
+			return false;
+		if(message.uint8_array_count > 1000)
+			return false;
+		if(!ostream.write(message.uint8_array_count))
+			return false;
+		if(!ostream.write_array(message.uint8_array, message.uint8_array_count))
+			return false;
+		if(!ostream.write(message.has_c))
+			return false;
+		if(message.has_c && !ostream.write(message.c))
+			return false;
+		if(!ostream.write(message.d))
+			return false;
+		if(!ostream.write_varuint(message.v))
+			return false;
+		if(!ostream.write_varint(message.w))
+			return false;
+		if(!ostream.write(message.has_y))
+			return false;
+		if(message.has_y && !ostream.write_varint(message.y))
+			return false;
+		if(message.varint_array_count > 10)
+			return false;
+		if(!ostream.write(message.varint_array_count))
+			return false;
+		for(uint32_t i = 0; i < message.varint_array_count; i++)
+			if(!ostream.write_varuint(message.varint_array[i]))
+				return false;
+		if(message.nibble_array_count > 10)
+			return false;
+		if(!ostream.write(message.nibble_array_count))
+			return false;
+		if(!ostream.write_packed(message.nibble_array, message.nibble_array_count, 4))
+			return false;
+		if(message.packed_array_count > 10)
+			return false;
+		if(!ostream.write(message.packed_array_count))
+			return false;
+		if(!ostream.write_packed(message.packed_array, message.packed_array_count, 3))
+			return false;
+		if(!ostream.write(message.which_payload))
+			return false;
+		switch(message.which_payload) {
+			case 1:
+				if(!ostream.write(message.payload.x))
+					return false;
+				break;
+			case 2:
+				if(!MessageTraits<Embedded_message>::encode(ostream, message.payload.embedded_message_oneof))
+					return false;
+				break;
+			default:
+				return false;
+		}
+		return true;
+	}
+
+	template<Endian E> static bool decode(Istream<E>& istream, Test_message& message) {
+		if(!istream.read_array(message.fixed_array, 4))
+			return false;
+		if(!istream.read(message.has_a))
+			return false;
+		if(message.has_a && !istream.read(message.a))
+			return false;
+		if(!istream.read(message.b))
+			return false;
+		if(!istream.read(message.uint16_array_count))
+			return false;
+		if(message.uint16_array_count > 10)
+			return false;
+		if(!istream.read_array(message.uint16_array, message.uint16_array_count))
+			return false;
+		if(!istream.read(message.embedded_messages_count))
+			return false;
+		if(message.embedded_messages_count > 12)
+			return false;
+		for(uint32_t i = 0; i < message.embedded_messages_count; i++)
+			if(!MessageTraits<Embedded_message>::decode(istream, message.embedded_messages[i]))
+				return false;
+		if(!istream.read(message.has_embedded_message1))
+			return false;
+		if(message.has_embedded_message1 && !MessageTraits<Embedded_message1>::decode(istream, message.embedded_message1))
+			return false;
+		if(!MessageTraits<Empty_message>::decode(istream, message.empty_message))
+			return false;
+		if(!istream.read(message.uint8_array_count))
+			return false;
+		if(message.uint8_array_count > 1000)
+			return false;
+		if(!istream.read_array(message.uint8_array, message.uint8_array_count))
+			return false;
+		if(!istream.read(message.has_c))
+			return false;
+		if(message.has_c && !istream.read(message.c))
+			return false;
+		if(!istream.read(message.d))
+			return false;
+		if(!istream.read_varuint(message.v))
+			return false;
+		if(!istream.read_varint(message.w))
+			return false;
+		if(!istream.read(message.has_y))
+			return false;
+		if(message.has_y && !istream.read_varint(message.y))
+			return false;
+		if(!istream.read(message.varint_array_count))
+			return false;
+		if(message.varint_array_count > 10)
+			return false;
+		for(uint32_t i = 0; i < message.varint_array_count; i++)
+			if(!istream.read_varuint(message.varint_array[i]))
+				return false;
+		if(!istream.read(message.nibble_array_count))
+			return false;
+		if(message.nibble_array_count > 10)
+			return false;
+		if(!istream.read_packed(message.nibble_array, message.nibble_array_count, 4))
+			return false;
+		if(!istream.read(message.packed_array_count))
+			return false;
+		if(message.packed_array_count > 10)
+			return false;
+		if(!istream.read_packed(message.packed_array, message.packed_array_count, 3))
+			return false;
+		if(!istream.read(message.which_payload))
+			return false;
+		switch(message.which_payload) {
+			case 1:
+				if(!istream.read(message.payload.x))
+					return false;
+				break;
+			case 2:
+				if(!MessageTraits<Embedded_message>::decode(istream, message.payload.embedded_message_oneof))
+					return false;
+				break;
+			default:
+				return false;
+		}
+		return true;
+	}
+
+	template<typename V> static void visit(V& visitor, const Test_message& message) {
+		visitor.repeated("fixed_array", message.fixed_array, (uint32_t) 4);
+		visitor.optional("a", message.has_a, message.a);
+		visitor.field("b", message.b);
+		visitor.repeated("uint16_array", message.uint16_array, (uint32_t) message.uint16_array_count);
+		visitor.repeated("embedded_messages", message.embedded_messages, (uint32_t) message.embedded_messages_count);
+		visitor.optional("embedded_message1", message.has_embedded_message1, message.embedded_message1);
+		visitor.field("empty_message", message.empty_message);
+		visitor.repeated("uint8_array", message.uint8_array, (uint32_t) message.uint8_array_count);
+		visitor.optional("c", message.has_c, message.c);
+		visitor.field("d", message.d);
+		visitor.field("v", message.v);
+		visitor.field("w", message.w);
+		visitor.optional("y", message.has_y, message.y);
+		visitor.repeated("varint_array", message.varint_array, (uint32_t) message.varint_array_count);
+		visitor.repeated("nibble_array", message.nibble_array, (uint32_t) message.nibble_array_count);
+		visitor.repeated("packed_array", message.packed_array, (uint32_t) message.packed_array_count);
+		visitor.begin_oneof("payload", message.which_payload);
+		visitor.oneof_member("x", message.which_payload == 1, message.payload.x);
+		visitor.oneof_member("embedded_message_oneof", message.which_payload == 2, message.payload.embedded_message_oneof);
+		visitor.end_oneof();
+	}
+};
+
+}	// namespace tinybuf
+
+#endif
@@ -0,0 +1,108 @@
+/**@file
+ * @details Fills a message structure with pseudo-random values, only using its field-array.
+ *			Needed by the host tools (benchmark and fuzzer), that have to create every message of a schema.
+ *			Repeated fields get the maximal number of elements and optional fields are set,
+ *			so the messages have (nearly) their maximal encoded length.
+ *
+ * @note	Assumes a little-endian host (the counts are stored byte by byte).
+ */
+
+#ifndef __MESSAGE_FILLER_H
+#define __MESSAGE_FILLER_H
+
+#include <stdint.h>
+#include <string.h>
+#include "tinybuf.h"
+
+
+/**@brief Function to retrieve the next pseudo-random byte (xorshift).
+ */
+static inline uint8_t filler_random_byte(uint32_t* seed) {
+	uint32_t x = *seed;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*seed = x;
+	return (uint8_t) (x >> 24);
+}
+
+/**@brief Function to store a count/flag/which-value into a structure entry of size bytes.
+ */
+static inline void filler_store(uint8_t* ptr, uint32_t size, uint32_t value) {
+	for(uint32_t i = 0; i < size; i++)
+		ptr[i] = (uint8_t) (value >> (8*i));
+}
+
+/**@brief Function to retrieve the maximal encoded length of a oneof-member.
+ */
+static inline uint32_t filler_get_max_len(const tb_field_t* field) {
+	if(field->type & DATA_TYPE_MESSAGE)
+		return tb_get_max_encoded_len((const tb_field_t*) field->ptr);
+	return field->data_size;
+}
+
+static void fill_message(const tb_field_t fields[], void* struct_ptr, uint32_t* seed, int32_t oneof_index);
+
+/**@brief Function to fill number entries of a field with pseudo-random values.
+ */
+static inline void filler_fill_entries(const tb_field_t* field, uint8_t* data_ptr, uint32_t number, uint32_t* seed, int32_t oneof_index) {
+	for(uint32_t i = 0; i < number; i++) {
+		uint8_t* entry = data_ptr + i*field->data_size;
+		if(field->type & DATA_TYPE_MESSAGE) {
+			fill_message((const tb_field_t*) field->ptr, entry, seed, oneof_index);
+		} else if(field->type & DATA_TYPE_PACKED) {
+			entry[0] = (uint8_t) (filler_random_byte(seed) & ((1 << TB_PACKED_BITS(field->type)) - 1));
+		} else {
+			for(uint32_t k = 0; k < field->data_size; k++)
+				entry[k] = filler_random_byte(seed);
+		}
+	}
+}
+
+/**@brief Function to fill a message structure with pseudo-random values.
+ *
+ * @param[in]	fields			Pointer to the array of structure-fields.
+ * @param[out]	struct_ptr		Pointer to the structure (has to be zeroed before).
+ * @param[in]	seed			Pointer to the state of the pseudo-random generator (not 0).
+ * @param[in]	oneof_index		The member of the oneof-fields that is set (modulo the number of members),
+ *								or < 0 for the member with the largest encoded length.
+ */
+static void fill_message(const tb_field_t fields[], void* struct_ptr, uint32_t* seed, int32_t oneof_index) {
+	for(uint32_t i = 0; fields[i].type != 0; i++) {
+		const tb_field_t* field = &fields[i];
+		uint8_t* data_ptr = ((uint8_t*) struct_ptr) + field->data_offset;
+		uint8_t* size_ptr = data_ptr + field->size_offset;
+		if(field->type & FIELD_TYPE_REQUIRED) {
+			filler_fill_entries(field, data_ptr, 1, seed, oneof_index);
+		} else if(field->type & FIELD_TYPE_OPTIONAL) {
+			filler_store(size_ptr, field->size_size, 1);
+			filler_fill_entries(field, data_ptr, 1, seed, oneof_index);
+		} else if(field->type & FIELD_TYPE_REPEATED) {
+			filler_store(size_ptr, field->size_size, field->array_size);
+			filler_fill_entries(field, data_ptr, field->array_size, seed, oneof_index);
+		} else if(field->type & FIELD_TYPE_FIXED_REPEATED) {
+			filler_fill_entries(field, data_ptr, field->array_size, seed, oneof_index);
+		} else if((field->type & FIELD_TYPE_ONEOF) && field->oneof_first) {
+			// Choose one of the members, that follow the first one
+			uint32_t number = 1;
+			while(fields[i + number].type != 0 && (fields[i + number].type & FIELD_TYPE_ONEOF) && !fields[i + number].oneof_first)
+				number++;
+			uint32_t chosen = 0;
+			if(oneof_index >= 0) {
+				chosen = ((uint32_t) oneof_index) % number;
+			} else {
+				for(uint32_t k = 1; k < number; k++)
+					if(filler_get_max_len(&fields[i + k]) > filler_get_max_len(&fields[i + chosen]))
+						chosen = k;
+			}
+			const tb_field_t* member = &fields[i + chosen];
+			uint8_t* member_ptr = ((uint8_t*) struct_ptr) + member->data_offset;
+			filler_store(member_ptr + member->size_offset, member->size_size, member->oneof_tag);
+			filler_fill_entries(member, member_ptr, 1, seed, oneof_index);
+			i += number - 1;
+		}
+	}
+}
+
+
+#endif
@@ -7,6 +7,21 @@ class _Ostream:
 		self.buf = b''
 	def write(self, data):
 		self.buf += data
+	def write_varuint(self, value):
+		while(value >= 0x80):
+			self.buf += struct.pack('B', (value & 0x7F) | 0x80)
+			value >>= 7
+		self.buf += struct.pack('B', value)
+	def write_varint(self, value):
+		self.write_varuint((value << 1) ^ (value >> 63))
+	def write_packed(self, values, bits):
+		packed = 0
+		for i in range(0, len(values)):
+			if(values[i] < 0 or values[i] >> bits):
+				raise Exception("Value does not fit into " + str(bits) + " bits")
+			packed |= values[i] << (i*bits)
+		for i in range(0, (len(values)*bits + 7)//8):
+			self.buf += struct.pack('B', (packed >> (8*i)) & 0xFF)
 
 class _Istream:
 	def __init__(self, buf):
@@ -17,12 +32,34 @@ class _Istream:
 		ret = self.buf[0:l]
 		self.buf = self.buf[l:]
 		return ret
+	def read_varuint(self, size):
+		value = 0
+		for i in range(0, (size*8 + 6)//7):
+			byte = struct.unpack('B', self.read(1))[0]
+			value |= (byte & 0x7F) << (7*i)
+			if(not (byte & 0x80)):
+				if(value >> (size*8)):
+					raise Exception("Varint does not fit into " + str(size) + " bytes")
+				return value
+		raise Exception("Varint is too long")
+	def read_varint(self, size):
+		value = self.read_varuint(size)
+		return (value >> 1) ^ -(value & 1)
+	def read_packed(self, count, bits):
+		data = self.read((count*bits + 7)//8)
+		packed = 0
+		for i in range(0, len(data)):
+			packed |= struct.unpack('B', data[i:i+1])[0] << (8*i)
+		return [(packed >> (i*bits)) & ((1 << bits) - 1) for i in range(0, count)]
 
 class Empty_message:
 
 	def __init__(self):
 		self.reset()
 
+	def __repr__(self):
+		return str(self.__dict__)
+
 	def reset(self):
 		pass
 
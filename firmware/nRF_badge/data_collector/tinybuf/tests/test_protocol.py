@@ -14,6 +14,21 @@ class _Ostream:
 		self.buf = b''
 	def write(self, data):
 		self.buf += data
+	def write_varuint(self, value):
+		while(value >= 0x80):
+			self.buf += struct.pack('B', (value & 0x7F) | 0x80)
+			value >>= 7
+		self.buf += struct.pack('B', value)
+	def write_varint(self, value):
+		self.write_varuint((value << 1) ^ (value >> 63))
+	def write_packed(self, values, bits):
+		packed = 0
+		for i in range(0, len(values)):
+			if(values[i] < 0 or values[i] >> bits):
+				raise Exception("Value does not fit into " + str(bits) + " bits")
+			packed |= values[i] << (i*bits)
+		for i in range(0, (len(values)*bits + 7)//8):
+			self.buf += struct.pack('B', (packed >> (8*i)) & 0xFF)
 
 class _Istream:
 	def __init__(self, buf):
@@ -24,12 +39,34 @@ class _Istream:
 		ret = self.buf[0:l]
 		self.buf = self.buf[l:]
 		return ret
+	def read_varuint(self, size):
+		value = 0
+		for i in range(0, (size*8 + 6)//7):
+			byte = struct.unpack('B', self.read(1))[0]
+			value |= (byte & 0x7F) << (7*i)
+			if(not (byte & 0x80)):
+				if(value >> (size*8)):
+					raise Exception("Varint does not fit into " + str(size) + " bytes")
+				return value
+		raise Exception("Varint is too long")
+	def read_varint(self, size):
+		value = self.read_varuint(size)
+		return (value >> 1) ^ -(value & 1)
+	def read_packed(self, count, bits):
+		data = self.read((count*bits + 7)//8)
+		packed = 0
+		for i in range(0, len(data)):
+			packed |= struct.unpack('B', data[i:i+1])[0] << (8*i)
+		return [(packed >> (i*bits)) & ((1 << bits) - 1) for i in range(0, count)]
 
 class Embedded_message1:
 
 	def __init__(self):
 		self.reset()
 
+	def __repr__(self):
+		return str(self.__dict__)
+
 	def reset(self):
 		self.has_e = 0
 		self.e = 0
@@ -72,6 +109,9 @@ class Embedded_message:
 	def __init__(self):
 		self.reset()
 
+	def __repr__(self):
+		return str(self.__dict__)
+
 	def reset(self):
 		self.f = 0
 		self.embedded_message1 = []
@@ -126,6 +166,9 @@ class Embedded_message:
 		def __init__(self):
 			self.reset()
 
+		def __repr__(self):
+			return str(self.__dict__)
+
 		def reset(self):
 			self.which = 0
 			self.g = 0
@@ -156,11 +199,89 @@ class Embedded_message:
 			self.g= struct.unpack('>B', istream.read(1))[0]
 
 
+class Full_count_message:
+
+	def __init__(self):
+		self.reset()
+
+	def __repr__(self):
+		return str(self.__dict__)
+
+	def reset(self):
+		self.h = 0
+		self.full_array = []
+		self.i = 0
+		self.full_nibble_array = []
+		pass
+
+	def encode(self):
+		ostream = _Ostream()
+		self.encode_internal(ostream)
+		return ostream.buf
+
+	def encode_internal(self, ostream):
+		self.encode_h(ostream)
+		self.encode_full_array(ostream)
+		self.encode_i(ostream)
+		self.encode_full_nibble_array(ostream)
+		pass
+
+	def encode_h(self, ostream):
+		ostream.write(struct.pack('>H', self.h))
+
+	def encode_full_array(self, ostream):
+		count = len(self.full_array)
+		ostream.write(struct.pack('>B', count))
+		for i in range(0, count):
+			ostream.write(struct.pack('>B', self.full_array[i]))
+
+	def encode_i(self, ostream):
+		ostream.write(struct.pack('>B', self.i))
+
+	def encode_full_nibble_array(self, ostream):
+		count = len(self.full_nibble_array)
+		ostream.write(struct.pack('>B', count))
+		ostream.write_packed(self.full_nibble_array, 4)
+
+
+	@classmethod
+	def decode(cls, buf):
+		obj = cls()
+		obj.decode_internal(_Istream(buf))
+		return obj
+
+	def decode_internal(self, istream):
+		self.reset()
+		self.decode_h(istream)
+		self.decode_full_array(istream)
+		self.decode_i(istream)
+		self.decode_full_nibble_array(istream)
+		pass
+
+	def decode_h(self, istream):
+		self.h= struct.unpack('>H', istream.read(2))[0]
+
+	def decode_full_array(self, istream):
+		count = struct.unpack('>B', istream.read(1))[0]
+		for i in range(0, count):
+			self.full_array.append(struct.unpack('>B', istream.read(1))[0])
+
+	def decode_i(self, istream):
+		self.i= struct.unpack('>B', istream.read(1))[0]
+
+	def decode_full_nibble_array(self, istream):
+		count = struct.unpack('>B', istream.read(1))[0]
+		self.full_nibble_array = istream.read_packed(count, 4)
+
+
 class Test_message:
 
 	def __init__(self):
 		self.reset()
 
+	def __repr__(self):
+		return str(self.__dict__)
+
 	def reset(self):
 		self.fixed_array = []
 		self.has_a = 0
@@ -175,6 +296,13 @@ class Test_message:
 		self.has_c = 0
 		self.c = 0
 		self.d = 0
+		self.v = 0
+		self.w = 0
+		self.has_y = 0
+		self.y = 0
+		self.varint_array = []
+		self.nibble_array = []
+		self.packed_array = []
 		self.payload = self._payload()
 		pass
 
@@ -194,6 +322,12 @@ class Test_message:
 		self.encode_uint8_array(ostream)
 		self.encode_c(ostream)
 		self.encode_d(ostream)
+		self.encode_v(ostream)
+		self.encode_w(ostream)
+		self.encode_y(ostream)
+		self.encode_varint_array(ostream)
+		self.encode_nibble_array(ostream)
+		self.encode_packed_array(ostream)
 		self.payload.encode_internal(ostream)
 		pass
 
@@ -244,6 +378,33 @@ class Test_message:
 	def encode_d(self, ostream):
 		ostream.write(struct.pack('>f', self.d))
 
+	def encode_v(self, ostream):
+		ostream.write_varuint(self.v)
+
+	def encode_w(self, ostream):
+		ostream.write_varint(self.w)
+
+	def encode_y(self, ostream):
+		ostream.write(struct.pack('>B', self.has_y))
+		if self.has_y:
+			ostream.write_varint(self.y)
+
+	def encode_varint_array(self, ostream):
+		count = len(self.varint_array)
+		ostream.write(struct.pack('>B', count))
+		for i in range(0, count):
+			ostream.write_varuint(self.varint_array[i])
+
+	def encode_nibble_array(self, ostream):
+		count = len(self.nibble_array)
+		ostream.write(struct.pack('>B', count))
+		ostream.write_packed(self.nibble_array, 4)
+
+	def encode_packed_array(self, ostream):
+		count = len(self.packed_array)
+		ostream.write(struct.pack('>B', count))
+		ostream.write_packed(self.packed_array, 3)
+
 
 	@classmethod
 	def decode(cls, buf):
@@ -263,6 +424,12 @@ class Test_message:
 		self.decode_uint8_array(istream)
 		self.decode_c(istream)
 		self.decode_d(istream)
+		self.decode_v(istream)
+		self.decode_w(istream)
+		self.decode_y(istream)
+		self.decode_varint_array(istream)
+		self.decode_nibble_array(istream)
+		self.decode_packed_array(istream)
 		self.payload.decode_internal(istream)
 		pass
 
@@ -314,22 +481,38 @@ class Test_message:
 	def decode_d(self, istream):
 		self.d= struct.unpack('>f', istream.read(4))[0]
 
-	def get_uint8_array_as_bytestring(self):
-		bytestring = b''
-		for b in self.uint8_array:
-			bytestring += struct.pack('>B', b)
-		return bytestring
+	def decode_v(self, istream):
+		self.v= istream.read_varuint(4)
 
-	def set_uint8_array_as_bytestring(self, bytestring):
-		self.uint8_array = []
-		for b in bytestring:
-			self.uint8_array.append(struct.unpack('>B', b)[0])
+	def decode_w(self, istream):
+		self.w= istream.read_varint(2)
+
+	def decode_y(self, istream):
+		self.has_y= struct.unpack('>B', istream.read(1))[0]
+		if self.has_y:
+			self.y= istream.read_varint(8)
+
+	def decode_varint_array(self, istream):
+		count = struct.unpack('>B', istream.read(1))[0]
+		for i in range(0, count):
+			self.varint_array.append(istream.read_varuint(2))
+
+	def decode_nibble_array(self, istream):
+		count = struct.unpack('>B', istream.read(1))[0]
+		self.nibble_array = istream.read_packed(count, 4)
+
+	def decode_packed_array(self, istream):
+		count = struct.unpack('>B', istream.read(1))[0]
+		self.packed_array = istream.read_packed(count, 3)
 
 	class _payload:
 
 		def __init__(self):
 			self.reset()
 
+		def __repr__(self):
+			return str(self.__dict__)
+
 		def reset(self):
 			self.which = 0
 			self.x = 0
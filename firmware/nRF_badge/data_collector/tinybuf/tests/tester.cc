@@ -5,6 +5,7 @@
 #include <stdlib.h>
 
 #include "test_protocol.h"
+#include "test_protocol.hpp"
 
 #define EXPECT_ARRAY_EQ(A, B, len) {for(uint32_t i = 0; i < len; i++) {EXPECT_EQ(A[i], B[i])}}
 #define EXPECT_EQ(A, B)	{if(A != B) { printf("Error EXPECT_EQ at line %u\n", __LINE__); return 0;}}
@@ -12,7 +13,7 @@
 char output_file_name[] = "/output_file.bin";
 char input_file_name[] = "/input_file.bin";
 
-uint8_t create_test_message(uint8_t* buf, uint32_t max_size, uint32_t* len) {
+uint8_t create_test_message(uint8_t* buf, uint32_t max_size, uint32_t* len, uint8_t straight_line) {
 	
 	tb_ostream_t ostream = tb_ostream_from_buffer(buf, max_size);
 
@@ -64,6 +65,24 @@ uint8_t create_test_message(uint8_t* buf, uint32_t max_size, uint32_t* len) {
 	
 	test_message.d = 11.23f;
 	
+	test_message.v = 300;
+	test_message.w = -2;
+	test_message.has_y = 1;
+	test_message.y = -5000000000LL;
+	test_message.varint_array_count = 3;
+	test_message.varint_array[0] = 0;
+	test_message.varint_array[1] = 127;
+	test_message.varint_array[2] = 65535;
+	test_message.nibble_array_count = 5;
+	test_message.nibble_array[0] = 0;
+	test_message.nibble_array[1] = 15;
+	test_message.nibble_array[2] = 7;
+	test_message.nibble_array[3] = 8;
+	test_message.nibble_array[4] = 1;
+	test_message.packed_array_count = 7;
+	for(uint8_t i = 0; i < 7; i++)
+		test_message.packed_array[i] = (uint8_t) ((i*5 + 7) % 8);	// Values that straddle byte boundaries
+	
 	test_message.which_payload = Test_message_embedded_message_oneof_tag;
 	test_message.payload.embedded_message_oneof.f = 11;
 	test_message.payload.embedded_message_oneof.embedded_message1[0].has_e = 1;
@@ -75,7 +94,11 @@ uint8_t create_test_message(uint8_t* buf, uint32_t max_size, uint32_t* len) {
 	
 	
 	
-	uint8_t encode_status = tb_encode(&ostream, Test_message_fields, &test_message, TB_BIG_ENDIAN);
+	uint8_t encode_status = 0;
+	if(straight_line)
+		encode_status = Test_message_encode(&ostream, &test_message, TB_BIG_ENDIAN);
+	else
+		encode_status = tb_encode(&ostream, Test_message_fields, &test_message, TB_BIG_ENDIAN);
 	*len = ostream.bytes_written;
 	printf("Encode status: %u, Len: %u\n", encode_status, *len);
 	
@@ -84,13 +107,17 @@ uint8_t create_test_message(uint8_t* buf, uint32_t max_size, uint32_t* len) {
 	
 }
 
-uint8_t check_test_message(uint8_t* buf, uint32_t len) {
+uint8_t check_test_message(uint8_t* buf, uint32_t len, uint8_t straight_line) {
 	tb_istream_t istream = tb_istream_from_buffer(buf, len);
 	
 	Test_message test_message;
 	memset(&test_message, 0, sizeof(test_message));
 	
-	uint8_t decode_status = tb_decode(&istream, Test_message_fields, &test_message, TB_BIG_ENDIAN);
+	uint8_t decode_status = 0;
+	if(straight_line)
+		decode_status = Test_message_decode(&istream, &test_message, TB_BIG_ENDIAN);
+	else
+		decode_status = tb_decode(&istream, Test_message_fields, &test_message, TB_BIG_ENDIAN);
 	printf("Decode status: %u\n", decode_status);
 	EXPECT_EQ(decode_status, 1);
 	
@@ -143,6 +170,24 @@ uint8_t check_test_message(uint8_t* buf, uint32_t len) {
 	
 	EXPECT_EQ(test_message.d, 11.23f);
 	
+	EXPECT_EQ(test_message.v, 300);
+	EXPECT_EQ(test_message.w, -2);
+	EXPECT_EQ(test_message.has_y, 1);
+	EXPECT_EQ(test_message.y, -5000000000LL);
+	EXPECT_EQ(test_message.varint_array_count, 3);
+	EXPECT_EQ(test_message.varint_array[0], 0);
+	EXPECT_EQ(test_message.varint_array[1], 127);
+	EXPECT_EQ(test_message.varint_array[2], 65535);
+	EXPECT_EQ(test_message.nibble_array_count, 5);
+	EXPECT_EQ(test_message.nibble_array[0], 0);
+	EXPECT_EQ(test_message.nibble_array[1], 15);
+	EXPECT_EQ(test_message.nibble_array[2], 7);
+	EXPECT_EQ(test_message.nibble_array[3], 8);
+	EXPECT_EQ(test_message.nibble_array[4], 1);
+	EXPECT_EQ(test_message.packed_array_count, 7);
+	for(uint8_t i = 0; i < 7; i++)
+		EXPECT_EQ(test_message.packed_array[i], (i*5 + 7) % 8);
+	
 	
 	EXPECT_EQ(test_message.which_payload, Test_message_embedded_message_oneof_tag);
 	EXPECT_EQ(test_message.payload.embedded_message_oneof.f, 11);
@@ -157,6 +202,80 @@ uint8_t check_test_message(uint8_t* buf, uint32_t len) {
 	return decode_status;
 }
 
+/**@brief Function to check the C++ bindings (test_protocol.hpp) against the C-module: same structure, same bytes, same length checks.
+ */
+uint8_t check_cpp_bindings(uint8_t* buf, uint32_t len) {
+	EXPECT_EQ(sizeof(tinybuf::Test_message), sizeof(Test_message));
+	EXPECT_EQ(tinybuf::MessageTraits<tinybuf::Test_message>::max_encoded_len(), tb_get_max_encoded_len(Test_message_fields));
+	
+	static Test_message c_message;
+	static tinybuf::Test_message cpp_message;
+	memset(&c_message, 0, sizeof(c_message));
+	memset(&cpp_message, 0, sizeof(cpp_message));
+	
+	tb_istream_t istream = tb_istream_from_buffer(buf, len);
+	EXPECT_EQ(tb_decode(&istream, Test_message_fields, &c_message, TB_BIG_ENDIAN), 1);
+	size_t bytes_read = 0;
+	EXPECT_EQ(tinybuf::decode<tinybuf::Endian::big>(buf, len, cpp_message, &bytes_read), true);
+	EXPECT_EQ(bytes_read, len);
+	EXPECT_EQ(memcmp(&c_message, &cpp_message, sizeof(c_message)), 0);
+	
+	// Truncated input has to be rejected
+	for(uint32_t i = 0; i < len; i++) {
+		tinybuf::Test_message truncated;
+		memset(&truncated, 0, sizeof(truncated));
+		EXPECT_EQ(tinybuf::decode<tinybuf::Endian::big>(buf, i, truncated), false);
+	}
+	
+	// Encoding has to produce the bytes of tb_encode() in both endiannesses, and fail on too small buffers
+	uint8_t c_buf[1000];
+	uint8_t cpp_buf[1000];
+	for(uint8_t little_endian = 0; little_endian <= 1; little_endian++) {
+		tb_ostream_t ostream = tb_ostream_from_buffer(c_buf, sizeof(c_buf));
+		EXPECT_EQ(tb_encode(&ostream, Test_message_fields, &c_message, little_endian ? TB_LITTLE_ENDIAN : TB_BIG_ENDIAN), 1);
+		size_t bytes_written = 0;
+		uint8_t ret = little_endian ? tinybuf::encode<tinybuf::Endian::little>(cpp_buf, sizeof(cpp_buf), cpp_message, &bytes_written) :
+									tinybuf::encode<tinybuf::Endian::big>(cpp_buf, sizeof(cpp_buf), cpp_message, &bytes_written);
+		EXPECT_EQ(ret, 1);
+		EXPECT_EQ(bytes_written, ostream.bytes_written);
+		EXPECT_ARRAY_EQ(c_buf, cpp_buf, bytes_written);
+		EXPECT_EQ(tinybuf::encode<tinybuf::Endian::big>(cpp_buf, bytes_written - 1, cpp_message), false);
+	}
+	return 1;
+}
+
+/**@brief Function to check the straight-line functions of a message, whose repeated/packed counts have no count-check 
+ * (the size-type can't hold a larger count), against tb_encode()/tb_decode().
+ */
+uint8_t check_full_count_message(void) {
+	static Full_count_message message;
+	memset(&message, 0, sizeof(message));
+	message.h = 0x1234;
+	message.full_array_count = 255;
+	for(uint32_t i = 0; i < 255; i++)
+		message.full_array[i] = (uint8_t) i;
+	message.i = 0xAB;
+	message.full_nibble_array_count = 255;
+	for(uint32_t i = 0; i < 255; i++)
+		message.full_nibble_array[i] = (uint8_t) (i % 16);
+	
+	uint8_t buf[500];
+	uint8_t buf_straight_line[500];
+	tb_ostream_t ostream = tb_ostream_from_buffer(buf, sizeof(buf));
+	tb_ostream_t ostream_straight_line = tb_ostream_from_buffer(buf_straight_line, sizeof(buf_straight_line));
+	EXPECT_EQ(tb_encode(&ostream, Full_count_message_fields, &message, TB_BIG_ENDIAN), 1);
+	EXPECT_EQ(Full_count_message_encode(&ostream_straight_line, &message, TB_BIG_ENDIAN), 1);
+	EXPECT_EQ(ostream.bytes_written, ostream_straight_line.bytes_written);
+	EXPECT_ARRAY_EQ(buf, buf_straight_line, ostream.bytes_written);
+	
+	static Full_count_message decoded;
+	memset(&decoded, 0, sizeof(decoded));
+	tb_istream_t istream = tb_istream_from_buffer(buf, ostream.bytes_written);
+	EXPECT_EQ(Full_count_message_decode(&istream, &decoded, TB_BIG_ENDIAN), 1);
+	EXPECT_EQ(memcmp(&message, &decoded, sizeof(message)), 0);
+	return 1;
+}
+
 void write_to_file(char* file_name, const uint8_t* buf, uint32_t len) {
 	FILE *output_file;
 	output_file = fopen(file_name, "wb");
@@ -205,7 +324,7 @@ int main(void) {
 	uint32_t Embedded_message_expected_size = 1 + 2*Embedded_message1_expected_size + (1+1);
 	uint32_t Test_message_expected_size  = 4*4 + (1+2) + 4 + (1+2*10) + (1+12*Embedded_message_expected_size)
 								+ (1+Embedded_message1_expected_size) + Empty_message_expected_size
-								+ (2+1000) + (1+8) + 4 + (1+Embedded_message_expected_size);
+								+ (2+1000) + (1+8) + 4 + 5 + 3 + (1+10) + (1+10*3) + (1+5) + (1+4) + (1+Embedded_message_expected_size);
 	EXPECT_EQ(tb_get_max_encoded_len(Empty_message_fields), Empty_message_expected_size);
 	EXPECT_EQ(tb_get_max_encoded_len(Embedded_message1_fields), Embedded_message1_expected_size);
 	EXPECT_EQ(tb_get_max_encoded_len(Embedded_message_fields), Embedded_message_expected_size);
@@ -214,9 +333,26 @@ int main(void) {
 	
 	uint8_t buf[1000];
 	uint32_t len = 0;
-	uint8_t ret = create_test_message(buf, sizeof(buf), &len);
+	uint8_t ret = create_test_message(buf, sizeof(buf), &len, 0);
 	EXPECT_EQ(ret, 1);
 	
+	// The straight-line encode function has to produce the same bytes
+	uint8_t buf_straight_line[1000];
+	uint32_t len_straight_line = 0;
+	ret = create_test_message(buf_straight_line, sizeof(buf_straight_line), &len_straight_line, 1);
+	EXPECT_EQ(ret, 1);
+	EXPECT_EQ(len, len_straight_line);
+	EXPECT_ARRAY_EQ(buf, buf_straight_line, len);
+	
+	// Too small buffers have to be detected by both
+	for(uint32_t i = 0; i < len; i++) {
+		uint32_t l = 0;
+		EXPECT_EQ(create_test_message(buf_straight_line, i, &l, 0), 0);
+		EXPECT_EQ(create_test_message(buf_straight_line, i, &l, 1), 0);
+	}
+	
+	EXPECT_EQ(check_full_count_message(), 1);
+	
 	
 	write_to_file(output_file_path, buf, len);
 	
@@ -240,7 +376,13 @@ int main(void) {
 	EXPECT_EQ(len, len1);
 	EXPECT_ARRAY_EQ(buf, buf1, len);
 	
-	ret = check_test_message(buf1, len1);
+	ret = check_test_message(buf1, len1, 0);
+	EXPECT_EQ(ret, 1);
+	
+	ret = check_test_message(buf1, len1, 1);
+	EXPECT_EQ(ret, 1);
+	
+	ret = check_cpp_bindings(buf1, len1);
 	EXPECT_EQ(ret, 1);
 	
 	printf("\nTest was successful!\n");
@@ -6,8 +6,12 @@
  *			saved by a pthread-mutex.
  *			The following functions are implemented:
  *			app_sched_init, app_sched_queue_space_get, app_sched_event_put, app_sched_execute
- *			
  *
+ * @note	The priority classes (scheduler_lib.c) are a layer above the app-scheduler, like in the firmware:
+ *			Every scheduler_event_put() only puts a dispatch-event without event-data into this FIFO,
+ *			so this module needs no priorities of its own. In virtual-time mode the timeout-handlers put their
+ *			events from the calling thread, and the idle-handler of timer_virtual_run_for() (app_sched_execute) runs
+ *			between them like the main-loop. The critical sections of scheduler_lib.c are the ones of the timer-mock.
  */
 #include "app_scheduler.h"
 #include "sdk_common.h"
@@ -5,9 +5,12 @@
 
 #include "debug_lib.h"
 #include "app_fifo.h"
+#include "timer_lib.h"
 
 
-#define TX_FIFO_SIZE	1024
+#define TX_FIFO_SIZE					1024
+#define NUMBER_OF_TX_BUFFERS			6		/**< Number of notification buffers of the simulated SoftDevice. */
+#define CONNECTION_INTERVAL_MS			10		/**< The simulated connection interval. All queued notifications are sent at the next connection event. */
 
 static uint8_t	ble_state;																/**< The current BLE-state. */ 
 
@@ -18,15 +21,26 @@ static ble_on_connect_callback_t		external_ble_on_connect_callback = NULL;		/**<
 static ble_on_disconnect_callback_t		external_ble_on_disconnect_callback = NULL;		/**< The external on disconnect callback function */
 static ble_on_scan_timeout_callback_t	external_ble_on_scan_timeout_callback = NULL;	/**< The external on scan timeout callback function */
 static ble_on_scan_report_callback_t	external_ble_on_scan_report_callback = NULL;	/**< The external on scan report callback function */
+static void (*simulated_connection_event_handler)(void) = NULL;						/**< The handler of the badge simulator, that is called at each connection event */
+
+static uint64_t scan_start_microseconds = 0;			/**< The timepoint when the current scan was started. */
+static uint16_t current_scan_interval_ms = 0;			/**< The scan interval of the current scan. */
+static uint16_t current_scan_window_ms = 0;				/**< The scan window of the current scan. */
 
 
 static app_fifo_t tx_fifo;								/**< The transmit FIFO to check functionallity of transmit. */
 static uint8_t tx_fifo_buf[TX_FIFO_SIZE];				/**< The buffer of the transmit FIFO. */
 
+static uint32_t connection_event_timer_id;				/**< The timer that simulates the next connection event, when there are queued notifications. */
+static volatile uint8_t connection_event_pending = 0;	/**< Flag if the connection_event_timer is running. */
+static volatile uint8_t tx_buffers_in_use = 0;			/**< Number of notification buffers that are queued for the next connection event. */
+static volatile uint32_t transmitted_bytes = 0;		/**< Number of bytes that were sent at the connection events. */
+static volatile uint32_t queued_bytes = 0;				/**< Number of bytes that are queued for the next connection event. */
+
 
 
 static void ble_nus_on_receive_callback(uint8_t * p_data, uint16_t length);
-static void ble_nus_on_transmit_complete_callback(void);
+static void ble_nus_on_transmit_complete_callback(void* p_context);
 static void ble_on_connect_callback(void);
 static void ble_on_disconnect_callback(void);
 static void ble_on_scan_report_callback(ble_gap_evt_adv_report_t* scan_report);
@@ -43,8 +57,6 @@ ret_code_t ble_init(void) {
 	callback_generator_ble_on_disconnect_set_handler(ble_on_disconnect_callback);
 	callback_generator_ble_on_receive_init();
 	callback_generator_ble_on_receive_set_handler(ble_nus_on_receive_callback);
-	callback_generator_ble_on_transmit_complete_init();
-	callback_generator_ble_on_transmit_complete_set_handler(ble_nus_on_transmit_complete_callback);
 	callback_generator_ble_on_scan_report_init();
 	callback_generator_ble_on_scan_report_set_handler(ble_on_scan_report_callback);
 	callback_generator_ble_on_scan_timeout_init();
@@ -54,6 +66,18 @@ ret_code_t ble_init(void) {
 	ret_code_t ret = app_fifo_init(&tx_fifo, tx_fifo_buf, sizeof(tx_fifo_buf));
 	if(ret != NRF_SUCCESS) return ret;
 	
+	static uint8_t timer_created = 0;
+	if(!timer_created) {
+		timer_init();
+		if(!timer_create_timer(&connection_event_timer_id, TIMER_MODE_SINGLE_SHOT, ble_nus_on_transmit_complete_callback, 0)) return NRF_ERROR_INTERNAL;
+		timer_created = 1;
+	}
+	timer_stop_timer(connection_event_timer_id);
+	connection_event_pending = 0;
+	tx_buffers_in_use = 0;
+	transmitted_bytes = 0;
+	queued_bytes = 0;
+	
 	
 	
 	// The trigger for the ble_on_connect_callback should be called
@@ -92,6 +116,11 @@ ret_code_t ble_start_scanning(uint16_t scan_interval_ms, uint16_t scan_window_ms
 	if(scan_interval_ms == 0 || scan_window_ms == 0 || scan_duration_seconds == 0)
 		return NRF_ERROR_INVALID_PARAM;
 	
+	// Remember the scan parameters, to model when the radio listens (see ble_simulate_is_scan_window_open())
+	scan_start_microseconds = timer_get_microseconds_since_start();
+	current_scan_interval_ms = scan_interval_ms;
+	current_scan_window_ms = scan_window_ms;
+	
 	// The trigger function for ble_on_scan_report_callback has to be called
 	callback_generator_ble_on_scan_report_trigger();
 	
@@ -136,9 +165,19 @@ static void ble_nus_on_receive_callback(uint8_t * p_data, uint16_t length) {
 }
 
 
-/**@brief Handler function that is called when data were transmitted via the Nordic Uart Service.
+/**@brief Handler function that is called at a connection event when data were transmitted via the Nordic Uart Service.
+ *
+ * @details	All the queued notifications are sent, so all the notification buffers are free again.
  */
-static void ble_nus_on_transmit_complete_callback(void) {
+static void ble_nus_on_transmit_complete_callback(void* p_context) {
+	connection_event_pending = 0;
+	tx_buffers_in_use = 0;
+	transmitted_bytes += queued_bytes;
+	queued_bytes = 0;
+	
+	if(simulated_connection_event_handler != NULL)
+		simulated_connection_event_handler();
+	
 	if(!(ble_state & BLE_STATE_CONNECTED))
 		return;
 	
@@ -247,16 +286,22 @@ ret_code_t ble_transmit(uint8_t* data, uint16_t len) {
 		return NRF_ERROR_INVALID_PARAM;
 	
 
+	// All the notification buffers are in use until the next connection event
+	if(tx_buffers_in_use >= NUMBER_OF_TX_BUFFERS)
+		return NRF_ERROR_BUSY;
+
 	uint32_t len_32 = len;
 	ret_code_t ret = app_fifo_write(&tx_fifo, data, &len_32);
 	if(ret != NRF_SUCCESS) return ret;
 	
-	// The trigger function for ble_on_transmit_complete_callback has to be called + the "transmit-time" could be set here
-	uint32_t trigger_timepoint = 10;
-	callback_generator_ble_on_transmit_complete_add_trigger_timepoints(&trigger_timepoint, 1);
-	callback_generator_ble_on_transmit_complete_trigger();
-	
+	tx_buffers_in_use++;
+	queued_bytes += len;
 	
+	// The queued notifications are sent at the next connection event
+	if(!connection_event_pending) {
+		connection_event_pending = 1;
+		timer_start_timer(connection_event_timer_id, ((uint64_t) CONNECTION_INTERVAL_MS) * 1000, NULL);
+	}
 	
 	return NRF_SUCCESS;
 }
@@ -271,6 +316,14 @@ uint32_t ble_transmit_fifo_get_size(void) {
 	return len;
 }
 
+/**@brief (Private) Function to retrive the number of bytes that were sent at the connection events (only for testing purposes).
+ *
+ * @retval	Number of sent bytes since ble_init().
+ */
+uint32_t ble_transmit_get_transmitted_bytes(void) {
+	return transmitted_bytes;
+}
+
 /**@brief (Private) Function to retrive the read a certain number of bytes from the transmit-fifo of the simulated ble-interface (only for testing purposes).
  *
  * @retval	NRF_SUCCESS				If the bytes could be read successfully.
@@ -285,6 +338,58 @@ ret_code_t ble_transmit_fifo_read(uint8_t* data, uint32_t len) {
 }
 
 
+/**@brief (Private) Function to establish a BLE-connection from outside, e.g. when a client connects to the badge simulator (only for testing purposes).
+ */
+void ble_simulate_connect(void) {
+	ble_on_connect_callback();
+}
+
+/**@brief (Private) Function to receive data via the Nordic Uart Service from outside, e.g. from a client of the badge simulator (only for testing purposes).
+ *
+ * @details	Like a write of the client to the RX-characteristic, so at most 20 bytes should be passed at once.
+ *
+ * @param[in]	data	Pointer to the received data.
+ * @param[in]	len		Length of the received data.
+ */
+void ble_simulate_receive(uint8_t* data, uint16_t len) {
+	ble_nus_on_receive_callback(data, len);
+}
+
+/**@brief (Private) Function to set a handler that is called at each connection event, after the queued notifications were sent (only for testing purposes).
+ *
+ * @details	The badge simulator reads the sent notifications from the transmit-fifo in this handler, like a peer that receives them.
+ *
+ * @param[in]	connection_event_handler	The handler (could be NULL).
+ */
+void ble_simulate_set_connection_event_handler(void (*connection_event_handler)(void)) {
+	simulated_connection_event_handler = connection_event_handler;
+}
+
+/**@brief (Private) Function to deliver an advertising report from outside, e.g. from the multi-badge radio simulation (only for testing purposes).
+ *
+ * @details	The report is only passed to the scan report callback while the badge is scanning.
+ *
+ * @param[in]	scan_report		Pointer to the advertising report.
+ */
+void ble_simulate_scan_report(ble_gap_evt_adv_report_t* scan_report) {
+	ble_on_scan_report_callback(scan_report);
+}
+
+/**@brief (Private) Function to check whether the simulated radio currently listens for advertising packets (only for testing purposes).
+ *
+ * @details	Like the SoftDevice, the scanner listens for the scan window at the beginning of every scan interval,
+ *			starting with the call to ble_start_scanning().
+ *
+ * @retval	1	If the badge is scanning and the current scan window is open.
+ * @retval	0	Otherwise.
+ */
+uint8_t ble_simulate_is_scan_window_open(void) {
+	if(!(ble_state & BLE_STATE_SCANNING) || current_scan_interval_ms == 0)
+		return 0;
+	uint64_t microseconds_in_interval = (timer_get_microseconds_since_start() - scan_start_microseconds) % (((uint64_t) current_scan_interval_ms) * 1000);
+	return (microseconds_in_interval < ((uint64_t) current_scan_window_ms) * 1000) ? 1 : 0;
+}
+
 void ble_disconnect(void) {
 	ble_on_disconnect_callback();
 }
@@ -133,12 +133,24 @@ static pthread_mutex_t 						NAME##_critical_section_mutex; \
 static volatile uint8_t 					NAME##_start_timer = 0; \
 static volatile uint64_t 					NAME##_timer_end_timepoint_microseconds = 0; \
 static pthread_t 							NAME##_thread_handle; \
+static uint32_t 							NAME##_timer_id; \
+static uint8_t 								NAME##_timer_created = 0; \
 static void callback_generator_##NAME##_internal_handler(void);	\
+static void callback_generator_##NAME##_arm_timer(uint64_t timeout_microseconds) { \
+	NAME##_timer_end_timepoint_microseconds = timer_get_microseconds_since_start() + timeout_microseconds; \
+	NAME##_start_timer = 1; \
+	if(NAME##_timer_created) { \
+		timer_start_timer(NAME##_timer_id, timeout_microseconds, NULL); \
+	} \
+} \
 static void callback_generator_##NAME##_stop_timer(void) { \
 	NAME##_trigger_index++; \
 	NAME##_timepoint_index = 0; \
 	NAME##_processing_trigger = 0; \
 	NAME##_start_timer = 0; \
+	if(NAME##_timer_created) { \
+		timer_stop_timer(NAME##_timer_id); \
+	} \
 } \
 static void callback_generator_##NAME##_start_timer(void) { \
 	NAME##_processing_trigger = 1; \
@@ -148,11 +160,25 @@ static void callback_generator_##NAME##_start_timer(void) { \
 		uint32_t timepoint_len = (uint32_t) NAME##_trigger_vectors[NAME##_trigger_index].size(); \
 		if(NAME##_timepoint_index < timepoint_len) { \
 			uint64_t timeout_microseconds = ((uint64_t)(NAME##_trigger_vectors[NAME##_trigger_index][NAME##_timepoint_index])) * ((uint64_t)1000); \
-			NAME##_timer_end_timepoint_microseconds = timer_get_microseconds_since_start() + timeout_microseconds; \
-			NAME##_start_timer = 1; \
+			callback_generator_##NAME##_arm_timer(timeout_microseconds); \
+		} else { \
+			callback_generator_##NAME##_stop_timer(); \
+		} \
+	} \
+} \
+static void callback_generator_##NAME##_next_timepoint(void) { \
+	NAME##_timepoint_index++; \
+	uint32_t trigger_len = (uint32_t) NAME##_trigger_vectors.size(); \
+	if(NAME##_trigger_index < trigger_len) { \
+		uint32_t timepoint_len = (uint32_t) NAME##_trigger_vectors[NAME##_trigger_index].size(); \
+		if(NAME##_timepoint_index < timepoint_len) { \
+			uint64_t timeout_microseconds = ((uint64_t)(NAME##_trigger_vectors[NAME##_trigger_index][NAME##_timepoint_index])) * ((uint64_t)1000); \
+			callback_generator_##NAME##_arm_timer(timeout_microseconds); \
 		} else { \
 			callback_generator_##NAME##_stop_timer(); \
 		} \
+	} else { \
+		callback_generator_##NAME##_stop_timer(); \
 	} \
 } \
 static void* callback_generator_##NAME##_thread_handler(void* ptr) { \
@@ -162,25 +188,18 @@ static void* callback_generator_##NAME##_thread_handler(void* ptr) { \
 			pthread_mutex_unlock(&NAME##_critical_section_mutex); \
 			callback_generator_##NAME##_internal_handler(); \
 			pthread_mutex_lock(&NAME##_critical_section_mutex); \
-			NAME##_timepoint_index++; \
-			uint32_t trigger_len = (uint32_t) NAME##_trigger_vectors.size(); \
-			if(NAME##_trigger_index < trigger_len) { \
-				uint32_t timepoint_len = (uint32_t) NAME##_trigger_vectors[NAME##_trigger_index].size(); \
-				if(NAME##_timepoint_index < timepoint_len) { \
-					uint64_t timeout_microseconds = ((uint64_t)(NAME##_trigger_vectors[NAME##_trigger_index][NAME##_timepoint_index])) * ((uint64_t)1000); \
-					NAME##_timer_end_timepoint_microseconds = timer_get_microseconds_since_start() + timeout_microseconds; \
-					NAME##_start_timer = 1; \
-				} else { \
-					callback_generator_##NAME##_stop_timer(); \
-				} \
-			} else { \
-				callback_generator_##NAME##_stop_timer(); \
-			} \
+			callback_generator_##NAME##_next_timepoint(); \
 		} \
 		pthread_mutex_unlock(&NAME##_critical_section_mutex); \
 	} \
 	return NULL; \
 } \
+static void callback_generator_##NAME##_timeout_handler(void* p_context) { \
+	callback_generator_##NAME##_internal_handler(); \
+	pthread_mutex_lock(&NAME##_critical_section_mutex); \
+	callback_generator_##NAME##_next_timepoint(); \
+	pthread_mutex_unlock(&NAME##_critical_section_mutex); \
+} \
 void callback_generator_##NAME##_reset(void) { \
 	NAME##_generator = NULL; \
 	NAME##_handler = NULL; \
@@ -190,16 +209,26 @@ void callback_generator_##NAME##_reset(void) { \
 	NAME##_trigger_index = 0; \
 	NAME##_timepoint_index = 0; \
 	NAME##_start_timer = 0; \
+	if(NAME##_timer_created) { \
+		timer_stop_timer(NAME##_timer_id); \
+	} \
 } \
 uint8_t callback_generator_##NAME##_init(void) { \
 	static uint8_t init_done = 0; \
 	if(!init_done) { \
 		pthread_mutex_init (&NAME##_critical_section_mutex, NULL); \
-		pthread_attr_t attr; \
-		pthread_attr_init(&attr); \
-		pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE); \
-		pthread_create(&NAME##_thread_handle, &attr, callback_generator_##NAME##_thread_handler, NULL); \
-		pthread_attr_destroy(&attr); \
+		if(timer_is_virtual_time()) { \
+			/* In virtual-time mode the callbacks are generated through a timer in the context of the simulation */ \
+			timer_init(); \
+			if(!timer_create_timer(&NAME##_timer_id, TIMER_MODE_SINGLE_SHOT, callback_generator_##NAME##_timeout_handler, 1)) return 0; \
+			NAME##_timer_created = 1; \
+		} else { \
+			pthread_attr_t attr; \
+			pthread_attr_init(&attr); \
+			pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE); \
+			pthread_create(&NAME##_thread_handle, &attr, callback_generator_##NAME##_thread_handler, NULL); \
+			pthread_attr_destroy(&attr); \
+		} \
 	} \
 	init_done = 1; \
 	return 1; \
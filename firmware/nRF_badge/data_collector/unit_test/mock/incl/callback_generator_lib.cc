@@ -56,20 +56,6 @@ CALLBACK_GENERATOR_IMPLEMENTATION(ble_on_receive) {
 	}
 }
 
-/** Callback generator implementation for ble_on_transmit_complete-callback.
- *
- * @details	The trigger-timepoints are added in ble_lib_mock.c not in the unit-test.
- *			There is no generator, because we don't need data to be generated.
- */
-CALLBACK_GENERATOR_IMPLEMENTATION(ble_on_transmit_complete) {
-	// We don't need to generate any data for the ble_on_transmit_complete-handler --> So just directly call the handler
-	if(callback_generator_ble_on_transmit_complete_get_handler() != NULL) {
-		callback_generator_ble_on_transmit_complete_get_handler()();
-	}
-}
-
-
-
 /** Callback generator implementation for ble_on_scan_report-callback */
 CALLBACK_GENERATOR_IMPLEMENTATION(ble_on_scan_report) {
 	ble_gap_evt_adv_report_t scan_report;
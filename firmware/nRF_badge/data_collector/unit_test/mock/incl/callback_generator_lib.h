@@ -51,10 +51,6 @@ CALLBACK_HANDLER_FUNCTION_DECLARATION(ble_on_receive, void, uint8_t* data, uint1
 CALLBACK_GENERATOR_FUNCTION_DECLARATION(ble_on_receive, void, uint8_t* data, uint16_t* length, uint16_t max_len);
 CALLBACK_GENERATOR_DECLARATION(ble_on_receive);
 
-CALLBACK_HANDLER_FUNCTION_DECLARATION(ble_on_transmit_complete, void, void);
-CALLBACK_GENERATOR_FUNCTION_DECLARATION(ble_on_transmit_complete, void, void);
-CALLBACK_GENERATOR_DECLARATION(ble_on_transmit_complete);
-
 CALLBACK_HANDLER_FUNCTION_DECLARATION(ble_on_scan_report, void, ble_gap_evt_adv_report_t* scan_report);
 CALLBACK_GENERATOR_FUNCTION_DECLARATION(ble_on_scan_report, void, ble_gap_evt_adv_report_t* scan_report);
 CALLBACK_GENERATOR_DECLARATION(ble_on_scan_report);
@@ -7,26 +7,50 @@
 #include "string.h"		// For memset
 
 #include "storage_file_lib.h"
+#include "storage_model_lib.h"
+#include "power_loss_lib.h"
+#include "timer_lib.h"
 
 
 static uint8_t eeprom_data[EEPROM_SIZE];	/**< Simulator of the external EEPROM data bytes */
 
 
-static volatile eeprom_operation_t eeprom_operation = EEPROM_NO_OPERATION; /**< The current EEPROM operation */
+static volatile eeprom_operation_t eeprom_operation = EEPROM_NO_OPERATION; /**< The current EEPROM operation (only ongoing after the call, if the latency of the storage-model is enabled) */
+
+static uint64_t eeprom_busy_until_microseconds = 0;	/**< The timepoint when the current EEPROM operation is finished (see storage_model_lib.h) */
+
+
+
+/**@brief   Function to finish an EEPROM operation after the time of the storage-model.
+ *
+ * @details	If the latency of the storage-model is disabled, the operation is finished directly.
+ *			Otherwise it is reported as ongoing by eeprom_get_operation() until the modeled time has passed.
+ *
+ * @param[in]	busy_us		The modeled time of the operation.
+ */
+static void eeprom_finish_operation(uint64_t busy_us) {
+	if(storage_model_is_latency_enabled() && busy_us > 0) {
+		eeprom_busy_until_microseconds = timer_get_microseconds_since_start() + busy_us;
+		return;
+	}
+	eeprom_operation = EEPROM_NO_OPERATION;
+}
 
 
 
 /**@brief   Function for initializing the in the simulated EEPROM module.
  *
  * @details If there is no EEPROM file there this function creates one and initializes the file with 0xFF.
- *			
+ *			After power_loss_reboot() the content is retained (see power_loss_lib.h).
  *
  * @retval  NRF_SUCCESS    		If the module was successfully initialized.
  */
 ret_code_t eeprom_init(void) {
 	
 	
-	memset(eeprom_data, 0xFF, EEPROM_SIZE);	
+	if(!power_loss_is_retaining())
+		memset(eeprom_data, 0xFF, EEPROM_SIZE);	
+	eeprom_operation = EEPROM_NO_OPERATION;
 	
 	//debug_log("EEPROM initialized\n");	
 	return  NRF_SUCCESS;
@@ -62,11 +86,11 @@ ret_code_t eeprom_store_bkgnd(uint32_t address, const uint8_t* tx_data, uint32_t
 	
 	eeprom_operation = EEPROM_STORE_OPERATION;
 	
-	// Set data also in the RAM array (to read from it)
-	memcpy(&eeprom_data[address], tx_data, length_tx_data);
+	// Set data also in the RAM array (to read from it), only the leading bytes if the power breaks down during the store (see power_loss_lib.h)
+	memcpy(&eeprom_data[address], tx_data, power_loss_write(POWER_LOSS_EEPROM_STORE, address, length_tx_data));
 		
 	
-	eeprom_operation = EEPROM_NO_OPERATION;
+	eeprom_finish_operation(storage_model_eeprom_store(address, length_tx_data));
 	
 	
 	return NRF_SUCCESS;
@@ -125,7 +149,7 @@ ret_code_t eeprom_read_bkgnd(uint32_t address, uint8_t* rx_data, uint32_t length
 	memcpy(rx_data, &eeprom_data[address], length_rx_data);
 	
 	
-	eeprom_operation = EEPROM_NO_OPERATION;
+	eeprom_finish_operation(storage_model_eeprom_read(address, length_rx_data));
 	
 	return NRF_SUCCESS;
 	
@@ -156,6 +180,9 @@ ret_code_t eeprom_read(uint32_t address, uint8_t* rx_data, uint32_t length_rx_da
 
 eeprom_operation_t eeprom_get_operation(void) {	
 	
+	if(eeprom_operation != EEPROM_NO_OPERATION && timer_get_microseconds_since_start() >= eeprom_busy_until_microseconds) {
+		eeprom_operation = EEPROM_NO_OPERATION;
+	}
 	return eeprom_operation;
 	
 }
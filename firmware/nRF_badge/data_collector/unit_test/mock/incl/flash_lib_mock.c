@@ -6,6 +6,9 @@
 #include "string.h"		// For memset
 
 #include "storage_file_lib.h"
+#include "storage_model_lib.h"
+#include "power_loss_lib.h"
+#include "timer_lib.h"
 
 
 
@@ -21,22 +24,43 @@ static uint32_t flash_words[FLASH_NUM_WORDS];	/**< Simulator of the internal fla
 
 
 
-static volatile flash_operation_t flash_operation = FLASH_NO_OPERATION;	/**< The current flash operation ((in simulation it is actually not really used/set) */
+static volatile flash_operation_t flash_operation = FLASH_NO_OPERATION;	/**< The current flash operation (only ongoing after the call, if the latency of the storage-model is enabled) */
+
+static uint64_t flash_busy_until_microseconds = 0;	/**< The timepoint when the current flash operation is finished (see storage_model_lib.h) */
+
+
+
+/**@brief   Function to finish a flash operation after the time of the storage-model.
+ *
+ * @details	If the latency of the storage-model is disabled, the operation is finished directly.
+ *			Otherwise it is reported as ongoing by flash_get_operation() until the modeled time has passed.
+ *
+ * @param[in]	operation	The operation (FLASH_STORE_OPERATION or FLASH_ERASE_OPERATION).
+ * @param[in]	busy_us		The modeled time of the operation.
+ */
+static void flash_finish_operation(flash_operation_t operation, uint64_t busy_us) {
+	if(storage_model_is_latency_enabled() && busy_us > 0) {
+		flash_busy_until_microseconds = timer_get_microseconds_since_start() + busy_us;
+		return;
+	}
+	flash_operation = (flash_operation_t) (flash_operation & ~operation);
+}
 
 
 
 /**@brief   Function for initializing the in the simulated flash module.
  *
  * @details If there is no flash file there this function creates one and initializes the file with 0xFF.
- *			
+ *			After power_loss_reboot() the content is retained (see power_loss_lib.h).
  *
  * @retval  NRF_SUCCESS    		If the module was successfully initialized.
  */
 ret_code_t flash_init(void) {
 	
 	
-	
-	memset(flash_words, 0xFF, FLASH_SIZE);
+	if(!power_loss_is_retaining())
+		memset(flash_words, 0xFF, FLASH_SIZE);
+	flash_operation = FLASH_NO_OPERATION;
 	
 	
 	//debug_log("Flash initialized\n");
@@ -73,11 +97,12 @@ ret_code_t flash_erase_bkgnd(uint32_t page_num, uint16_t num_pages) {
 	uint32_t start_word_address = page_num*flash_get_page_size_words();
 	uint32_t number_of_words = num_pages*flash_get_page_size_words();
 	
-	
-	memset(&flash_words[start_word_address], 0xFF, number_of_words*sizeof(uint32_t));
+	// Only the leading bytes are erased, if the power breaks down during the erase (see power_loss_lib.h)
+	uint32_t erase_bytes = power_loss_write(POWER_LOSS_FLASH_ERASE, start_word_address*sizeof(uint32_t), number_of_words*sizeof(uint32_t));
+	memset(&flash_words[start_word_address], 0xFF, erase_bytes);
 	
 	
-	flash_operation = (flash_operation_t) (flash_operation & ~FLASH_ERASE_OPERATION);
+	flash_finish_operation(FLASH_ERASE_OPERATION, storage_model_flash_erase(num_pages));
 	
 	return NRF_SUCCESS;
 }
@@ -147,13 +172,18 @@ ret_code_t flash_store_bkgnd(uint32_t word_num, const uint32_t* p_words, uint16_
 	uint32_t start_word_address = word_num;
 	uint32_t number_of_words = length_words;
 	
+	// Only the leading bytes are programmed, if the power breaks down during the store (see power_loss_lib.h)
+	uint32_t store_bytes = power_loss_write(POWER_LOSS_FLASH_STORE, start_word_address*sizeof(uint32_t), number_of_words*sizeof(uint32_t));
+	
 	// Simulate the "flash behaviour" of setting bits to zero, but not to one again --> logical & 
-	for(uint16_t i = 0; i < number_of_words; i++) {
-		flash_words[start_word_address + i] = flash_words[start_word_address + i] & p_words[i];
+	uint8_t* flash_bytes = (uint8_t*) &flash_words[start_word_address];
+	const uint8_t* store_data = (const uint8_t*) p_words;
+	for(uint32_t i = 0; i < store_bytes; i++) {
+		flash_bytes[i] = flash_bytes[i] & store_data[i];
 	}
 	
-	// Reset the store operation
-	flash_operation = (flash_operation_t) (flash_operation & ~FLASH_STORE_OPERATION);	
+	// Reset the store operation (after the modeled time)
+	flash_finish_operation(FLASH_STORE_OPERATION, storage_model_flash_program(length_words));
 	
 	return NRF_SUCCESS;
 }
@@ -189,6 +219,9 @@ ret_code_t flash_store(uint32_t word_num, const uint32_t* p_words, uint16_t leng
 
 
 flash_operation_t flash_get_operation(void) {
+	if((flash_operation & (FLASH_STORE_OPERATION | FLASH_ERASE_OPERATION)) && timer_get_microseconds_since_start() >= flash_busy_until_microseconds) {
+		flash_operation = (flash_operation_t) (flash_operation & ~(FLASH_STORE_OPERATION | FLASH_ERASE_OPERATION));
+	}
 	return flash_operation;
 }
 
@@ -213,6 +246,8 @@ ret_code_t flash_read(uint32_t word_num, uint32_t* p_words, uint16_t length_word
 	
 	memcpy(p_words, &flash_words[word_num],  length_words*sizeof(uint32_t));
 	
+	storage_model_flash_read(length_words);
+	
 	return NRF_SUCCESS;
 }
 
@@ -0,0 +1,81 @@
+#include "power_loss_lib.h"
+
+#include "string.h"		// For memset
+
+
+static uint8_t armed = 0;
+static uint32_t remaining_operations = 0;	/**< Write operations that are still completed before the interrupted one (if armed) */
+static uint32_t interrupted_bytes = 0;		/**< Bytes of the interrupted operation that are written (modulo its length) */
+static uint8_t occurred = 0;
+static uint8_t retaining = 0;
+static uint32_t write_operations = 0;
+static uint32_t written_bytes = 0;
+static power_loss_event_t event;
+
+
+void power_loss_reset(void) {
+	armed = 0;
+	remaining_operations = 0;
+	interrupted_bytes = 0;
+	occurred = 0;
+	retaining = 0;
+	write_operations = 0;
+	written_bytes = 0;
+	memset(&event, 0, sizeof(event));
+}
+
+void power_loss_arm(uint32_t operations, uint32_t bytes) {
+	armed = 1;
+	remaining_operations = operations;
+	interrupted_bytes = bytes;
+	occurred = 0;
+	memset(&event, 0, sizeof(event));
+}
+
+uint8_t power_loss_occurred(void) {
+	return occurred;
+}
+
+void power_loss_get_event(power_loss_event_t* event_out) {
+	*event_out = event;
+}
+
+uint32_t power_loss_get_write_operations(void) {
+	return write_operations;
+}
+
+uint32_t power_loss_get_written_bytes(void) {
+	return written_bytes;
+}
+
+void power_loss_reboot(void) {
+	armed = 0;
+	occurred = 0;
+	retaining = 1;
+}
+
+uint8_t power_loss_is_retaining(void) {
+	return retaining;
+}
+
+uint32_t power_loss_write(power_loss_operation_t operation, uint32_t address, uint32_t len) {
+	if(occurred || len == 0)
+		return 0;
+	
+	write_operations++;
+	if(armed) {
+		if(remaining_operations == 0) {
+			armed = 0;
+			occurred = 1;
+			event.operation = operation;
+			event.address = address;
+			event.len = len;
+			event.written_len = interrupted_bytes % len;
+			written_bytes += event.written_len;
+			return event.written_len;
+		}
+		remaining_operations--;
+	}
+	written_bytes += len;
+	return len;
+}
@@ -0,0 +1,95 @@
+#ifndef __POWER_LOSS_LIB_H
+#define __POWER_LOSS_LIB_H
+
+/**@file
+ * @details	Power-loss fault injection for the storage mocks (flash_lib_mock.c and eeprom_lib_mock.c).
+ *
+ *			Every write operation (flash store, flash page erase, EEPROM store) and its bytes are counted.
+ *			After power_loss_arm() the supply breaks down at a byte of a following write operation: this operation
+ *			is only applied up to this byte (the leading bytes of an interrupted erase are erased, the rest of the pages
+ *			keep their old content), and all further store and erase operations have no effect, because the badge is off.
+ *			The blocking mock functions still return, so the firmware just runs to its next return (e.g. with a failed read-back check).
+ *
+ *			After power_loss_reboot() the next flash_init() and eeprom_init() retain the content of the storage
+ *			(like on a reboot of the badge), so the recovery of filesystem_init()/storer_init() can be run on the interrupted state.
+ */
+
+#include <stdint.h>
+
+
+/**< The storage operation that was interrupted by the power loss */
+typedef enum {
+	POWER_LOSS_NO_OPERATION		= 0,
+	POWER_LOSS_FLASH_STORE		= 1,
+	POWER_LOSS_FLASH_ERASE		= 2,
+	POWER_LOSS_EEPROM_STORE		= 3,
+} power_loss_operation_t;
+
+/**< Information about the power loss */
+typedef struct {
+	power_loss_operation_t	operation;		/**< The interrupted operation. */
+	uint32_t				address;		/**< Byte-address of the interrupted operation (in the flash or in the EEPROM). */
+	uint32_t				len;			/**< Number of bytes of the interrupted operation. */
+	uint32_t				written_len;	/**< Number of bytes that were written before the power loss. */
+} power_loss_event_t;
+
+
+/**@brief Function to reset the fault injection: disarmed, no power loss, counters to 0, the storage is not retained on init.
+ */
+void power_loss_reset(void);
+
+/**@brief Function to arm the power loss.
+ *
+ * @param[in]	operations	Number of write operations that are still completed before the interrupted one (0: the next one is interrupted).
+ * @param[in]	bytes		Number of bytes of the interrupted operation that are written, modulo its length
+ *							(so a random value selects a uniformly distributed byte of the operation).
+ */
+void power_loss_arm(uint32_t operations, uint32_t bytes);
+
+/**@brief Function to check whether the power loss has happened.
+ *
+ * @retval	1 if the supply is broken down, 0 otherwise.
+ */
+uint8_t power_loss_occurred(void);
+
+/**@brief Function to retrieve the information about the power loss.
+ *
+ * @param[out]	event	Pointer to the information to fill (operation is POWER_LOSS_NO_OPERATION, if no power loss has happened).
+ */
+void power_loss_get_event(power_loss_event_t* event);
+
+/**@brief Function to retrieve the number of write operations (stores and erases) since power_loss_reset().
+ *
+ * @details	A run of a workload without fault injection yields the range of the operations where a power loss can be injected.
+ *
+ * @retval	The number of write operations.
+ */
+uint32_t power_loss_get_write_operations(void);
+
+/**@brief Function to retrieve the number of bytes written (stored or erased) since power_loss_reset().
+ *
+ * @retval	The number of written bytes.
+ */
+uint32_t power_loss_get_written_bytes(void);
+
+/**@brief Function to restore the supply (disarms the power loss) and to retain the content of the storage on the next flash_init()/eeprom_init().
+ */
+void power_loss_reboot(void);
+
+/**@brief Function to check whether the storage mocks should retain their content on init (called by the storage mocks).
+ *
+ * @retval	1 after power_loss_reboot(), 0 otherwise.
+ */
+uint8_t power_loss_is_retaining(void);
+
+/**@brief Function to account a write operation of the storage mocks and to retrieve how much of it is applied (called by the storage mocks).
+ *
+ * @param[in]	operation	The write operation.
+ * @param[in]	address		The byte-address of the operation.
+ * @param[in]	len			Number of bytes to write.
+ *
+ * @retval	Number of leading bytes of the operation that are applied (len, if there is no power loss during the operation).
+ */
+uint32_t power_loss_write(power_loss_operation_t operation, uint32_t address, uint32_t len);
+
+#endif
@@ -0,0 +1,140 @@
+#include "storage_model_lib.h"
+
+#include "string.h"		// For memset
+
+
+#define EEPROM_WRITE_ENABLE_SPI_BYTES	1		/**< CMD_WREN */
+#define EEPROM_HEADER_SPI_BYTES			4		/**< CMD_WRITE/CMD_READ + 24 bit address */
+#define EEPROM_STATUS_POLL_SPI_BYTES	2		/**< CMD_RDSR + status byte */
+
+#define MICROSECONDS_PER_HOUR			3600000000.0
+
+
+/**< Approximate values: nRF51 flash (page erase about 20 ms, word program about 46 us), EEPROM at 8 MHz SPI with a write cycle of about 5 ms */
+static const storage_model_parameters_t default_parameters = {
+	20000,		// flash_page_erase_us
+	46,			// flash_program_word_us
+	4000,		// flash_erase_current_ua
+	4000,		// flash_program_current_ua
+	128,		// eeprom_page_size
+	5000,		// eeprom_write_cycle_us
+	3000,		// eeprom_write_current_ua
+	1.0,		// spi_bytes_per_us
+	2000,		// spi_current_ua
+};
+
+static storage_model_parameters_t custom_parameters;
+static const storage_model_parameters_t* parameters = &default_parameters;	/**< The current parameters */
+static uint8_t latency_enabled = 0;
+static storage_model_statistics_t statistics;
+
+
+void storage_model_get_default_parameters(storage_model_parameters_t* parameters_out) {
+	*parameters_out = default_parameters;
+}
+
+void storage_model_set_parameters(const storage_model_parameters_t* new_parameters) {
+	custom_parameters = *new_parameters;
+	parameters = &custom_parameters;
+}
+
+void storage_model_enable_latency(uint8_t enable) {
+	latency_enabled = enable;
+}
+
+uint8_t storage_model_is_latency_enabled(void) {
+	return latency_enabled;
+}
+
+void storage_model_get_statistics(storage_model_statistics_t* statistics_out) {
+	*statistics_out = statistics;
+}
+
+void storage_model_reset_statistics(void) {
+	memset(&statistics, 0, sizeof(statistics));
+}
+
+
+/**@brief Function to account the charge of an operation.
+ *
+ * @param[in]	current_ua		The current during the operation.
+ * @param[in]	time_us			The time of the operation.
+ */
+static void charge(uint32_t current_ua, uint64_t time_us) {
+	statistics.charge_uah += ((double) current_ua) * ((double) time_us) / MICROSECONDS_PER_HOUR;
+}
+
+/**@brief Function to account an SPI transfer.
+ *
+ * @retval	The time of the transfer in microseconds (rounded up).
+ */
+static uint64_t spi_transfer(uint32_t bytes) {
+	uint64_t time_us = (parameters->spi_bytes_per_us > 0) ? (uint64_t) (bytes / parameters->spi_bytes_per_us + 0.999999) : 0;
+	statistics.spi_bytes += bytes;
+	charge(parameters->spi_current_ua, time_us);
+	return time_us;
+}
+
+/**@brief Function to retrieve the number of bytes of the first page-step of an EEPROM operation (split like in eeprom_lib.c).
+ */
+static uint32_t eeprom_step_len(uint32_t address, uint32_t len) {
+	if(parameters->eeprom_page_size == 0)
+		return len;
+	uint32_t next_page_address = ((address/parameters->eeprom_page_size) + 1) * parameters->eeprom_page_size;
+	uint32_t step_len = next_page_address - address;
+	return (len > step_len) ? step_len : len;
+}
+
+
+uint64_t storage_model_flash_erase(uint32_t num_pages) {
+	uint64_t time_us = ((uint64_t) num_pages) * parameters->flash_page_erase_us;
+	statistics.flash_page_erases += num_pages;
+	statistics.flash_busy_us += time_us;
+	charge(parameters->flash_erase_current_ua, time_us);
+	return time_us;
+}
+
+uint64_t storage_model_flash_program(uint32_t num_words) {
+	uint64_t time_us = ((uint64_t) num_words) * parameters->flash_program_word_us;
+	statistics.flash_programmed_words += num_words;
+	statistics.flash_busy_us += time_us;
+	charge(parameters->flash_program_current_ua, time_us);
+	return time_us;
+}
+
+void storage_model_flash_read(uint32_t num_words) {
+	statistics.flash_reads++;
+	statistics.flash_read_words += num_words;
+}
+
+uint64_t storage_model_eeprom_store(uint32_t address, uint32_t len) {
+	uint64_t time_us = 0;
+	while(len > 0) {
+		uint32_t step_len = eeprom_step_len(address, len);
+		time_us += spi_transfer(EEPROM_WRITE_ENABLE_SPI_BYTES + EEPROM_STATUS_POLL_SPI_BYTES);
+		time_us += spi_transfer(EEPROM_HEADER_SPI_BYTES + step_len);
+		time_us += parameters->eeprom_write_cycle_us;
+		charge(parameters->eeprom_write_current_ua, parameters->eeprom_write_cycle_us);
+		time_us += spi_transfer(EEPROM_STATUS_POLL_SPI_BYTES);
+		statistics.eeprom_write_cycles++;
+		address += step_len;
+		len -= step_len;
+	}
+	statistics.eeprom_busy_us += time_us;
+	return time_us;
+}
+
+uint64_t storage_model_eeprom_read(uint32_t address, uint32_t len) {
+	uint64_t time_us = 0;
+	statistics.eeprom_reads++;
+	statistics.eeprom_read_bytes += len;
+	while(len > 0) {
+		uint32_t step_len = eeprom_step_len(address, len);
+		time_us += spi_transfer(EEPROM_HEADER_SPI_BYTES + step_len);
+		time_us += spi_transfer(EEPROM_STATUS_POLL_SPI_BYTES);
+		address += step_len;
+		len -= step_len;
+	}
+	statistics.eeprom_busy_us += time_us;
+	return time_us;
+}
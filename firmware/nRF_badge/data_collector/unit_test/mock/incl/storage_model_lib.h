@@ -0,0 +1,130 @@
+#ifndef __STORAGE_MODEL_LIB_H
+#define __STORAGE_MODEL_LIB_H
+
+/**@file
+ * @details	Timing- and energy-model of the storage mocks (flash_lib_mock.c and eeprom_lib_mock.c).
+ *
+ *			Every flash erase/store and every EEPROM store/read is charged with the time the operation would take
+ *			on the badge (page erase, program per word, SPI transfer of the EEPROM commands and data, EEPROM write cycle)
+ *			and with the charge consumed during this time (flash reads are only counted). The statistics can be retrieved with storage_model_get_statistics().
+ *
+ *			The latency is only accounted by default, so the mocks still complete all operations instantly.
+ *			With storage_model_enable_latency(1) the mocks report the operations as ongoing (flash_get_operation(),
+ *			eeprom_get_operation()) until the modeled time has passed. In virtual-time mode the busy-waits
+ *			of the blocking functions then advance the virtual time, like on the badge.
+ */
+
+#include <stdint.h>
+
+
+/**< The parameters of the model (the default values are approximate values for the nRF51 flash and the SPI-EEPROM of the badge) */
+typedef struct {
+	uint32_t	flash_page_erase_us;		/**< Time to erase one flash page. */
+	uint32_t	flash_program_word_us;		/**< Time to program one word of the flash. */
+	uint32_t	flash_erase_current_ua;		/**< Current during a flash page erase. */
+	uint32_t	flash_program_current_ua;	/**< Current while programming the flash. */
+	uint32_t	eeprom_page_size;			/**< EEPROM stores and reads are split at these page boundaries (like in eeprom_lib.c). */
+	uint32_t	eeprom_write_cycle_us;		/**< Internal write cycle of the EEPROM per written page (after the SPI transfer). */
+	uint32_t	eeprom_write_current_ua;	/**< Current during the EEPROM write cycle. */
+	double		spi_bytes_per_us;			/**< Throughput of the SPI (1 byte/us at 8 MHz). */
+	uint32_t	spi_current_ua;				/**< Current during an SPI transfer (SPI peripheral and EEPROM). */
+} storage_model_parameters_t;
+
+/**< The accounted operations since the last storage_model_reset_statistics() */
+typedef struct {
+	uint32_t	flash_page_erases;
+	uint32_t	flash_programmed_words;
+	uint64_t	flash_busy_us;				/**< Modeled time of all flash erase and program operations. */
+	uint32_t	flash_reads;				/**< Number of flash read operations (e.g. to measure the recovery work of the filesystem). */
+	uint32_t	flash_read_words;
+	uint32_t	eeprom_write_cycles;
+	uint32_t	eeprom_reads;				/**< Number of EEPROM read operations. */
+	uint32_t	eeprom_read_bytes;
+	uint64_t	eeprom_busy_us;				/**< Modeled time of all EEPROM operations (SPI transfers and write cycles). */
+	uint64_t	spi_bytes;					/**< Bytes transferred via SPI (commands, addresses, status polls and data). */
+	double		charge_uah;					/**< Charge consumed by all storage operations in uAh. */
+} storage_model_statistics_t;
+
+
+/**@brief Function to retrieve the default parameters of the model.
+ *
+ * @param[out]	parameters	Pointer to the parameters to fill.
+ */
+void storage_model_get_default_parameters(storage_model_parameters_t* parameters);
+
+/**@brief Function to set the parameters of the model (e.g. to judge a storage optimization for another flash or EEPROM).
+ *
+ * @param[in]	parameters	Pointer to the new parameters.
+ */
+void storage_model_set_parameters(const storage_model_parameters_t* parameters);
+
+/**@brief Function to enable or disable the latency of the storage mocks.
+ *
+ * @param[in]	enable		1 if the operations should take the modeled time, 0 if they complete instantly (default).
+ */
+void storage_model_enable_latency(uint8_t enable);
+
+/**@brief Function to check whether the latency of the storage mocks is enabled.
+ *
+ * @retval	1 if enabled, 0 otherwise.
+ */
+uint8_t storage_model_is_latency_enabled(void);
+
+/**@brief Function to retrieve the statistics of the accounted operations.
+ *
+ * @param[out]	statistics	Pointer to the statistics to fill.
+ */
+void storage_model_get_statistics(storage_model_statistics_t* statistics);
+
+/**@brief Function to reset the statistics of the accounted operations.
+ */
+void storage_model_reset_statistics(void);
+
+
+/**@brief Function to account an erase of flash pages (called by the flash mock).
+ *
+ * @param[in]	num_pages	Number of erased pages.
+ *
+ * @retval	The modeled time of the operation in microseconds.
+ */
+uint64_t storage_model_flash_erase(uint32_t num_pages);
+
+/**@brief Function to account a program-operation of the flash (called by the flash mock).
+ *
+ * @param[in]	num_words	Number of programmed words.
+ *
+ * @retval	The modeled time of the operation in microseconds.
+ */
+uint64_t storage_model_flash_program(uint32_t num_words);
+
+/**@brief Function to account a read-operation of the flash (called by the flash mock).
+ *
+ * @details	The flash is memory-mapped, so reads are only counted and take no modeled time.
+ *
+ * @param[in]	num_words	Number of read words.
+ */
+void storage_model_flash_read(uint32_t num_words);
+
+/**@brief Function to account a store-operation of the EEPROM (called by the EEPROM mock).
+ *
+ * @details	Per page: write-enable command, status poll, command + address + data, write cycle, status poll.
+ *
+ * @param[in]	address		The start address of the operation.
+ * @param[in]	len			Number of stored bytes.
+ *
+ * @retval	The modeled time of the operation in microseconds.
+ */
+uint64_t storage_model_eeprom_store(uint32_t address, uint32_t len);
+
+/**@brief Function to account a read-operation of the EEPROM (called by the EEPROM mock).
+ *
+ * @details	Per page: command + address + data, status poll.
+ *
+ * @param[in]	address		The start address of the operation.
+ * @param[in]	len			Number of read bytes.
+ *
+ * @retval	The modeled time of the operation in microseconds.
+ */
+uint64_t storage_model_eeprom_read(uint32_t address, uint32_t len);
+
+#endif
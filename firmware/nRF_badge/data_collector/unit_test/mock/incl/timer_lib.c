@@ -25,17 +25,39 @@ volatile timer_node_t timer_nodes[MAX_NUMBER_OF_TIMERS]; 	/**< Timer node queue,
 
 uint32_t number_of_timers = 0;								/**< Number of created timers */
 
+static uint8_t virtual_time_enabled = 0;					/**< Flag if the virtual-time mode is enabled. */
+
+static volatile uint64_t virtual_time_microseconds = 0;	/**< The current virtual time in microseconds. */
+
+static volatile uint32_t critical_section_depth = 0;		/**< Number of nested critical sections (only used in virtual-time mode, where there is only one thread). */
+
+static volatile uint8_t virtual_handler_running = 0;		/**< Flag if a timeout-handler is currently called (only in virtual-time mode). */
+
+static volatile uint32_t virtual_busy_wait_reads = 0;		/**< Number of consecutive time-reads without progress of the virtual time. */
+
+static volatile uint8_t virtual_busy_wait_pending = 0;		/**< Flag if a busy-wait was detected inside a critical section. */
+
+
+static void timer_virtual_busy_wait_step(void);
+
 
 /**@brief Function for entering a critical section by locking the mutex.
  */
 void timer_enter_critical_section(void) {
 	pthread_mutex_lock(&critical_section_mutex);
+	critical_section_depth++;
 }
 
 /**@brief Function for exiting a critical section by locking the mutex.
  */
 void timer_exit_critical_section(void) {
+	critical_section_depth--;
 	pthread_mutex_unlock(&critical_section_mutex);
+	
+	// A busy-wait inside a critical section advances the time when the critical section is left (like a pending interrupt)
+	if(virtual_time_enabled && virtual_busy_wait_pending && critical_section_depth == 0 && !virtual_handler_running) {
+		timer_virtual_busy_wait_step();
+	}
 }
 
 /**@brief Function to retrieve the current time in microseconds since a timepoint in the past.
@@ -43,6 +65,10 @@ void timer_exit_critical_section(void) {
  * @retval	Microseconds since a timepoint in the past.
  */
 static uint64_t timer_get_microseconds(void) {
+	if(virtual_time_enabled) {
+		return virtual_time_microseconds;
+	}
+	
 	struct timespec time;
     clock_gettime(CLOCK_MONOTONIC, &time);
 	
@@ -59,15 +85,39 @@ void timer_set_start(void) {
 	time_start_microseconds = timer_get_microseconds();
 }
 
-uint64_t timer_get_microseconds_since_start(void) {
+/**@brief Function to retrieve the current time in microseconds since the reference timepoint without the busy-wait detection.
+ *
+ * @retval	Microseconds since the reference timepoint.
+ */
+static uint64_t timer_get_time_since_start(void) {
 	return timer_get_microseconds() - time_start_microseconds;
 }
 
+uint64_t timer_get_microseconds_since_start(void) {
+	if(virtual_time_enabled) {
+		// Detect busy-waits on the time, otherwise they would never terminate in virtual-time mode
+		virtual_busy_wait_reads++;
+		if(virtual_busy_wait_reads >= TIMER_VIRTUAL_BUSY_WAIT_READS) {
+			if(critical_section_depth > 0 && !virtual_handler_running) {
+				virtual_busy_wait_pending = 1;
+			} else {
+				timer_virtual_busy_wait_step();
+			}
+		}
+	}
+	return timer_get_time_since_start();
+}
+
 uint64_t timer_get_milliseconds_since_start(void) {
 	return timer_get_microseconds_since_start() / 1000;
 }
 
 void timer_sleep_microseconds(uint64_t microseconds) {
+	if(virtual_time_enabled) {
+		timer_virtual_run_for(microseconds, NULL);
+		return;
+	}
+	
 	microseconds = microseconds/TIMER_PRESCALER;
 	
 	uint64_t nsec = (microseconds*1000) % 1000000000;
@@ -97,9 +147,9 @@ void timer_sleep_milliseconds(uint64_t milliseconds) {
  * @param[in]	timer_id				The timer identifier.
  * @param[in]	microseconds_interval	The interval of the timer in microseconds.
  */
-static void timer_insert_node(uint32_t timer_id, uint32_t microseconds_interval) {
+static void timer_insert_node(uint32_t timer_id, uint64_t microseconds_interval) {
 	
-	timer_nodes[timer_id].microseconds_at_start = timer_get_microseconds_since_start();
+	timer_nodes[timer_id].microseconds_at_start = timer_get_time_since_start();
 	timer_nodes[timer_id].microseconds_at_end 	= timer_nodes[timer_id].microseconds_at_start + microseconds_interval;
 	
 	timer_nodes[timer_id].is_running = 1;
@@ -148,12 +198,60 @@ static void timer_insert_node(uint32_t timer_id, uint32_t microseconds_interval)
  */
 static void timer_remove_node(uint32_t timer_id) {
 	timer_nodes[timer_id].is_running = 0;
-	// Search for the node that has timer_node[timer_id] as next-node.
-	for(uint32_t i = 0; i < MAX_NUMBER_OF_TIMERS; i++) {
-		if(timer_nodes[i].next == &timer_nodes[timer_id]) {
-			timer_nodes[i].next = timer_nodes[timer_id].next;
+	
+	// Search for the predecessor in the queue (not in the node-array, because not queued nodes could still point to this node)
+	if(queue_head == &timer_nodes[timer_id]) {
+		queue_head = (volatile timer_node_t*) queue_head->next;
+		return;
+	}
+	volatile timer_node_t* cur_node = queue_head;
+	while(cur_node != NULL) {
+		if(cur_node->next == &timer_nodes[timer_id]) {
+			cur_node->next = timer_nodes[timer_id].next;
 			break;
 		}
+		cur_node = (volatile timer_node_t*) cur_node->next;
+	}
+}
+
+/**@brief Function to remove the queue-head timer-node if it is expired.
+ *
+ * @details	If the expired timer is running its timeout-handler and context are returned,
+ *			and it is reinserted if it is a repeated timer.
+ *
+ * @note This function needs to be saved by enter/exit_critical_section()
+ *
+ * @param[in]	cur_time			The current time in microseconds since start.
+ * @param[out]	p_timeout_handler	Pointer to the timeout-handler of the expired timer (NULL if there is none).
+ * @param[out]	p_timeout_context	Pointer to the context of the expired timer.
+ */
+static void timer_pop_expired_node(uint64_t cur_time, timer_timeout_handler_t* p_timeout_handler, void** p_timeout_context) {
+	*p_timeout_handler = NULL;
+	*p_timeout_context = NULL;
+	
+	if(queue_head != NULL) {			
+		if(cur_time >= queue_head->microseconds_at_end) {				
+			// Backup the current head-queue (needed for the reinsert, if timer-mode is REPEATED)
+			volatile timer_node_t* prev_queue_head = queue_head;
+			
+			// Set the new queue head
+			queue_head = (volatile timer_node_t*) queue_head->next;
+			
+			// Check if the element is running (not stopped)				
+			if(prev_queue_head->is_running) {					
+				prev_queue_head->is_running = 0;
+				*p_timeout_handler = prev_queue_head->p_timeout_handler;
+				*p_timeout_context = prev_queue_head->p_context;
+				
+				if(prev_queue_head->mode == TIMER_MODE_REPEATED) {
+					
+					// Insert the former queue_head-node again (with a small correction)
+					uint64_t delta_t = timer_get_time_since_start() - cur_time;
+					uint64_t microseconds_interval = (delta_t > prev_queue_head->microseconds_interval) ? 0 : (prev_queue_head->microseconds_interval - delta_t);
+					timer_insert_node(prev_queue_head->timer_id, microseconds_interval);
+				}
+			}
+		}
 	}
 }
 
@@ -171,37 +269,13 @@ static void timer_remove_node(uint32_t timer_id) {
 static void* timer_check_queue(void* ptr) {
 	while(timer_running) {
 		timer_enter_critical_section();
-		uint64_t cur_time = timer_get_microseconds_since_start();
-		
+		uint64_t cur_time = timer_get_time_since_start();
 		
 		timer_timeout_handler_t timeout_handler = NULL;
 		void *                 	timeout_context = NULL;
 		
+		timer_pop_expired_node(cur_time, &timeout_handler, &timeout_context);
 		
-		if(queue_head != NULL) {			
-			if(cur_time >= queue_head->microseconds_at_end) {				
-				// Backup the current head-queue (needed for the reinsert, if timer-mode is REPEATED)
-				volatile timer_node_t* prev_queue_head = queue_head;
-				
-				// Set the new queue head
-				queue_head = (volatile timer_node_t*) queue_head->next;
-				
-				// Check if the element is running (not stopped)				
-				if(prev_queue_head->is_running) {					
-					prev_queue_head->is_running = 0;
-					timeout_handler = prev_queue_head->p_timeout_handler;
-					timeout_context	= prev_queue_head->p_context;
-					
-					if(prev_queue_head->mode == TIMER_MODE_REPEATED) {
-						
-						// Insert the former queue_head-node again (with a small correction)
-						uint64_t delta_t = timer_get_microseconds_since_start() - cur_time;
-						uint64_t microseconds_interval = (delta_t > prev_queue_head->microseconds_interval) ? 0 : (prev_queue_head->microseconds_interval - delta_t);
-						timer_insert_node(prev_queue_head->timer_id, microseconds_interval);
-					}
-				}
-			}
-		}		
 		timer_exit_critical_section();
 		
 		// Call the handler outside the critical section (because probably the application timeout-handler could call timer_start_timer())
@@ -214,6 +288,95 @@ static void* timer_check_queue(void* ptr) {
 }
 
 
+void timer_enable_virtual_time(uint8_t enable) {
+	virtual_time_enabled = enable;
+	virtual_time_microseconds = 0;
+	virtual_busy_wait_reads = 0;
+	virtual_busy_wait_pending = 0;
+}
+
+uint8_t timer_is_virtual_time(void) {
+	return virtual_time_enabled;
+}
+
+/**@brief Function to advance the virtual time up to a timepoint and to call the timeout-handler of the next expired timer.
+ *
+ * @param[in]	max_microseconds_since_start	The timepoint up to which the time may be advanced.
+ * @param[in]	call_handler					Flag if the timeout-handler should be called. If not, the time is directly
+ *												advanced to max_microseconds_since_start, and the handlers are called later.
+ *
+ * @retval		1	If a timeout-handler has been called.
+ * @retval		0	If no timer expired until max_microseconds_since_start.
+ */
+static uint8_t timer_virtual_advance(uint64_t max_microseconds_since_start, uint8_t call_handler) {
+	timer_timeout_handler_t timeout_handler = NULL;
+	void *                 	timeout_context = NULL;
+	
+	virtual_busy_wait_reads = 0;
+	virtual_busy_wait_pending = 0;
+	
+	if(!call_handler) {
+		// Don't lock the mutex, because this could be called within a critical section (there is only one thread in virtual-time mode)
+		uint64_t cur_time = timer_get_time_since_start();
+		if(max_microseconds_since_start > cur_time)
+			virtual_time_microseconds += max_microseconds_since_start - cur_time;
+		return 0;
+	}
+	
+	timer_enter_critical_section();
+	uint64_t cur_time = timer_get_time_since_start();
+	
+	if(queue_head != NULL && queue_head->microseconds_at_end <= max_microseconds_since_start) {
+		if(queue_head->microseconds_at_end > cur_time) {
+			virtual_time_microseconds += queue_head->microseconds_at_end - cur_time;
+			cur_time = queue_head->microseconds_at_end;
+		}
+		timer_pop_expired_node(cur_time, &timeout_handler, &timeout_context);
+	} else if(max_microseconds_since_start > cur_time) {
+		virtual_time_microseconds += max_microseconds_since_start - cur_time;
+	}
+	timer_exit_critical_section();
+	
+	if(timeout_handler != NULL) {
+		virtual_handler_running = 1;
+		timeout_handler(timeout_context);
+		virtual_handler_running = 0;
+		return 1;
+	}
+	
+	return 0;
+}
+
+/**@brief Function to advance the virtual time when a busy-wait was detected.
+ *
+ * @details	Outside of critical sections and timeout-handlers the next expired timeout-handler is called.
+ *			Otherwise only the time is advanced (the timeout-handlers are called later).
+ */
+static void timer_virtual_busy_wait_step(void) {
+	uint64_t max_microseconds_since_start = timer_get_time_since_start() + TIMER_VIRTUAL_BUSY_WAIT_STEP_MICROSECONDS;
+	timer_virtual_advance(max_microseconds_since_start, (critical_section_depth == 0 && !virtual_handler_running));
+}
+
+uint8_t timer_virtual_advance_to_next_event(uint64_t max_microseconds_since_start) {
+	if(!virtual_time_enabled)
+		return 0;
+	
+	// Timeout-handlers are not nested
+	return timer_virtual_advance(max_microseconds_since_start, !virtual_handler_running);
+}
+
+void timer_virtual_run_for(uint64_t microseconds, timer_idle_handler_t idle_handler) {
+	if(!virtual_time_enabled)
+		return;
+	
+	uint64_t end_microseconds = timer_get_time_since_start() + microseconds;
+	do {
+		if(idle_handler != NULL)
+			idle_handler();
+	} while(timer_virtual_advance_to_next_event(end_microseconds));
+}
+
+
 
 void timer_init(void) {
 	
@@ -227,14 +390,16 @@ void timer_init(void) {
 	number_of_timers = 0;
 	
 	
-	
-	pthread_attr_t attr;
-	pthread_attr_init(&attr);
-	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+	// In virtual-time mode the timers are processed in the context of the caller
+	if(!virtual_time_enabled) {
+		pthread_attr_t attr;
+		pthread_attr_init(&attr);
+		pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+			
+		pthread_create(&thread_handle, &attr, timer_check_queue, NULL);
 		
-	pthread_create(&thread_handle, &attr, timer_check_queue, NULL);
-	
-	pthread_attr_destroy(&attr);
+		pthread_attr_destroy(&attr);
+	}
 	
 	timer_exit_critical_section();
 }
@@ -10,6 +10,14 @@
  * @note	This module is not based on RTOS, just on normal pthreads. So the main-context can still be executed, 
  *			although the timeout-handler is currently executed.
  *			Each timeout-handler is completely executed before another/next timeout-handler could be called.
+ *
+ * @note	In virtual-time mode (timer_enable_virtual_time() before timer_init()) no timer-thread is started.
+ *			The time only advances when the test-suite calls timer_sleep_microseconds(), timer_virtual_advance_to_next_event()
+ *			or timer_virtual_run_for(), and it jumps directly to the next timer expiration. The timeout-handlers are called
+ *			in the context of the caller, so the whole simulation is deterministic and runs much faster than the real time.
+ *			Busy-waiting on the time (e.g. systick_delay_millis()) is detected after TIMER_VIRTUAL_BUSY_WAIT_READS consecutive
+ *			time-reads without progress, then the time advances by at most TIMER_VIRTUAL_BUSY_WAIT_STEP_MICROSECONDS and
+ *			the due timeout-handlers are called (like pending interrupts, only outside of critical sections and timeout-handlers).
  */
 
 #ifndef TIMER_LIB_H
@@ -23,10 +31,15 @@
 
 #define TIMER_PRESCALER			1		/**< Prescaler for the timer. 1 --> time is like the real time. 10 --> time is 10x faster than the real time. */
 
+#define TIMER_VIRTUAL_BUSY_WAIT_READS				1000	/**< Number of consecutive time-reads without progress, after which a busy-wait is assumed (only in virtual-time mode). */
+#define TIMER_VIRTUAL_BUSY_WAIT_STEP_MICROSECONDS	1000	/**< Maximal time step when a busy-wait is detected (only in virtual-time mode). */
+
 
 
 typedef void (*timer_timeout_handler_t)(void * p_context);	/**< The timeout handler function type. */
 
+typedef void (*timer_idle_handler_t)(void);					/**< The idle handler function type (e.g. app_sched_execute), called between the events in virtual-time mode. */
+
 typedef enum
 {
     TIMER_MODE_SINGLE_SHOT,                 /**< The timer will expire only once. */
@@ -59,6 +72,22 @@ typedef struct {
  */
 void 		timer_init(void);
 
+/**@brief Function for enabling/disabling the virtual-time mode.
+ *
+ * @details	Has to be called before the first timer_init()-call (directly or e.g. via app_timer_init()).
+ *			In virtual-time mode the time starts at 0 and is only advanced by the test-suite.
+ *
+ * @param[in]	enable	1 to enable the virtual-time mode, 0 to use the real time.
+ */
+void		timer_enable_virtual_time(uint8_t enable);
+
+/**@brief Function to check whether the virtual-time mode is enabled.
+ *
+ * @retval	1	If the virtual-time mode is enabled.
+ * @retval	0	If the real time is used.
+ */
+uint8_t		timer_is_virtual_time(void);
+
 /**@brief Function for entering a critical section by locking the mutex.
  */
 void timer_enter_critical_section(void);
@@ -93,6 +122,9 @@ uint64_t 	timer_get_microseconds_since_start(void);
 uint64_t 	timer_get_milliseconds_since_start(void);
 
 /**@brief Function to sleep in microseconds.
+ *
+ * @details	In virtual-time mode the time is advanced by the microseconds, and all timers that expire
+ *			in this interval are processed in order (see timer_virtual_run_for()).
  *
  * @param[in]	Microseconds to sleep.
  */
@@ -104,6 +136,29 @@ void 		timer_sleep_microseconds(uint64_t microseconds);
  */
 void 		timer_sleep_milliseconds(uint64_t milliseconds);
 
+/**@brief Function to advance the virtual time to the next timer expiration and to call its timeout-handler.
+ *
+ * @details	If no timer expires until max_microseconds_since_start, the time is set to max_microseconds_since_start
+ *			(it never goes backwards). Stopped timers are skipped.
+ *
+ * @param[in]	max_microseconds_since_start	The timepoint up to which the time may be advanced.
+ *
+ * @retval		1	If a timeout-handler has been called.
+ * @retval		0	If no timer expired until max_microseconds_since_start (or the virtual-time mode is disabled).
+ */
+uint8_t		timer_virtual_advance_to_next_event(uint64_t max_microseconds_since_start);
+
+/**@brief Function to run the simulation for a certain virtual time.
+ *
+ * @details	The function calls the idle handler (e.g. app_sched_execute) and advances to the next timer expiration
+ *			in turns, until the virtual time has advanced by the microseconds. So the main-context of the application
+ *			is executed between the timeout-handlers, like the main-loop on the real device.
+ *
+ * @param[in]	microseconds	The virtual time to run.
+ * @param[in]	idle_handler	The handler that is called between the events (could be NULL).
+ */
+void		timer_virtual_run_for(uint64_t microseconds, timer_idle_handler_t idle_handler);
+
 /**@brief Function to create a timer.
  *
  * @details	The function creates a timer-node with a certain priority.
@@ -0,0 +1,79 @@
+#!/usr/bin/env python
+# Compares two results of the performance suite (run_perf --benchmark_out=FILE, Google Benchmark JSON format)
+#   and flags the benchmarks that got slower than the threshold.
+#
+# Usage: compare_perf.py [--threshold 0.1] [--metric cpu_time|real_time] BASELINE.json CONTENDER.json
+#
+# If the runs have repetitions (--benchmark_repetitions=N), the medians are compared, otherwise the single runs.
+# The exit code is 1 if at least one benchmark regressed (or failed), so it can be used between two commits, e.g.:
+#   git checkout <old>; make badge_03v6 perf run_perf; cp _build/perf.json /tmp/baseline.json
+#   git checkout <new>; make badge_03v6 perf run_perf; make compare_perf PERF_BASELINE=/tmp/baseline.json
+from __future__ import division, absolute_import, print_function
+
+import argparse
+import json
+import sys
+
+
+def load_results(filename, metric):
+	with open(filename) as f:
+		benchmarks = json.load(f)["benchmarks"]
+
+	has_medians = any(b.get("aggregate_name") == "median" for b in benchmarks)
+	results = {}
+	errors = set()
+	for b in benchmarks:
+		if b.get("error_occurred"):
+			errors.add(b["run_name"])
+			continue
+		if has_medians:
+			if b.get("aggregate_name") == "median":
+				results[b["run_name"]] = b[metric]
+		elif b.get("run_type", "iteration") == "iteration":
+			results[b["name"]] = b[metric]
+	return results, errors
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Compare two results of the performance suite and flag regressions.")
+	parser.add_argument("baseline", help="JSON results of the baseline")
+	parser.add_argument("contender", help="JSON results to compare with the baseline")
+	parser.add_argument("--threshold", type=float, default=0.1, help="Relative slowdown that is flagged as regression (default: 0.1 == 10%%)")
+	parser.add_argument("--metric", choices=["cpu_time", "real_time"], default="cpu_time", help="Time to compare (default: cpu_time)")
+	args = parser.parse_args()
+
+	baseline, baseline_errors = load_results(args.baseline, args.metric)
+	contender, contender_errors = load_results(args.contender, args.metric)
+
+	names = [name for name in contender if name in baseline]
+	width = max([len(name) for name in names] + [len("Benchmark")])
+	print("{:<{w}} {:>14} {:>14} {:>9}".format("Benchmark", "Baseline [ns]", "Contender [ns]", "Change", w=width))
+	print("-" * (width + 40))
+
+	regressions = []
+	for name in names:
+		old, new = baseline[name], contender[name]
+		change = (new - old) / old if old > 0 else 0
+		flag = ""
+		if change > args.threshold:
+			flag = "REGRESSION"
+			regressions.append(name)
+		elif change < -args.threshold:
+			flag = "improved"
+		print("{:<{w}} {:>14.1f} {:>14.1f} {:>+8.1f}% {}".format(name, old, new, change * 100, flag, w=width))
+
+	missing = set(baseline) - set(contender) - contender_errors
+	if missing:
+		print("{} benchmarks of the baseline were not run (e.g. because of --benchmark_filter).".format(len(missing)))
+	for name in sorted(set(contender) - set(baseline)):
+		print("{}: New benchmark".format(name))
+	for name in sorted(contender_errors):
+		print("{}: ERROR in the contender".format(name))
+
+	print("")
+	print("{} of {} benchmarks regressed by more than {:.0f}% ({}).".format(len(regressions), len(names), args.threshold * 100, args.metric))
+	return 1 if (regressions or contender_errors) else 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,85 @@
+/**@file
+ * @details	Benchmarks of the LZSS compression of the responses (compression_lib.c) with an encoded microphone data response,
+ *			the response that is compressed most often (the compressed length is reported as label).
+ */
+
+#include <string.h>
+
+#include "perf_lib.h"
+#include "compression_lib.h"
+#include "tinybuf.h"
+#include "protocol_messages_02v1.h"
+
+
+#define MAX_ENCODED_LEN		512
+
+
+static uint8_t encoded[MAX_ENCODED_LEN];
+static uint8_t compressed[COMPRESSION_MAX_COMPRESSED_LEN(MAX_ENCODED_LEN)];
+static uint8_t decompressed[MAX_ENCODED_LEN];
+
+
+/**@brief Function to encode a microphone data response with slowly changing values (like in a quiet room).
+ *
+ * @retval	The encoded length, or 0 if the encoding failed.
+ */
+static uint32_t encode_microphone_response(void) {
+	static Response response;
+	memset(&response, 0, sizeof(response));
+	response.which_type = Response_microphone_data_response_tag;
+	response.type.microphone_data_response.timestamp.seconds = 1500000000;
+	response.type.microphone_data_response.sample_period_ms = 50;
+	response.type.microphone_data_response.microphone_data_count = PROTOCOL_MICROPHONE_DATA_SIZE;
+	uint32_t seed = 2;
+	uint8_t value = 20;
+	for(uint32_t i = 0; i < PROTOCOL_MICROPHONE_DATA_SIZE; i++) {
+		if((perf_random(&seed) % 8) == 0)
+			value = (uint8_t) (value + (perf_random(&seed) % 5) - 2);
+		response.type.microphone_data_response.microphone_data[i].value = value;
+	}
+	tb_ostream_t ostream = tb_ostream_from_buffer(encoded, sizeof(encoded));
+	if(!tb_encode(&ostream, Response_fields, &response, TB_BIG_ENDIAN))
+		return 0;
+	return ostream.bytes_written;
+}
+
+/**@brief Benchmark of compression_compress() like the request-handler calls it (the compressed response has to be smaller).
+ */
+static void BM_CompressMicrophoneResponse(PerfState& state) {
+	uint32_t len = encode_microphone_response();
+	uint32_t compressed_len = 0;
+	while(state.KeepRunning()) {
+		if(compression_compress(encoded, len, compressed, len - 1, &compressed_len) != NRF_SUCCESS) {
+			state.SkipWithError("Compression failed");
+			break;
+		}
+		perf_do_not_optimize(compressed);
+	}
+	state.SetItemsProcessed(state.iterations());
+	state.SetBytesProcessed(state.iterations() * len);
+	state.SetLabel(std::to_string(len) + " -> " + std::to_string(compressed_len) + " bytes");
+}
+PERF_BENCHMARK(BM_CompressMicrophoneResponse);
+
+
+/**@brief Benchmark of compression_decompress() of the compressed microphone data response (like the hub does it).
+ */
+static void BM_DecompressMicrophoneResponse(PerfState& state) {
+	uint32_t len = encode_microphone_response();
+	uint32_t compressed_len = 0;
+	if(len == 0 || compression_compress(encoded, len, compressed, sizeof(compressed), &compressed_len) != NRF_SUCCESS) {
+		state.SkipWithError("Compression failed");
+		return;
+	}
+	uint32_t decompressed_len = 0;
+	while(state.KeepRunning()) {
+		if(compression_decompress(compressed, compressed_len, decompressed, sizeof(decompressed), &decompressed_len) != NRF_SUCCESS || decompressed_len != len) {
+			state.SkipWithError("Decompression failed");
+			break;
+		}
+		perf_do_not_optimize(decompressed);
+	}
+	state.SetItemsProcessed(state.iterations());
+	state.SetBytesProcessed(state.iterations() * len);
+}
+PERF_BENCHMARK(BM_DecompressMicrophoneResponse);
@@ -0,0 +1,89 @@
+/**@file
+ * @details	Benchmarks of the circular-fifo (streams) and the chunk-fifo (sampling chunks).
+ */
+
+#include <string.h>
+
+#include "perf_lib.h"
+#include "circular_fifo_lib.h"
+#include "chunk_fifo_lib.h"
+#include "chunk_messages.h"
+#include "stream_messages.h"
+
+
+#define CIRCULAR_FIFO_SIZE	1024
+
+
+/**@brief Benchmark of writing and reading back a block of bytes (like a stream-sample) with circular_fifo_write()/circular_fifo_read().
+ */
+static void BM_CircularFifoWriteRead(PerfState& state) {
+	circular_fifo_t fifo;
+	ret_code_t ret;
+	CIRCULAR_FIFO_INIT(ret, fifo, CIRCULAR_FIFO_SIZE);
+	uint32_t len = (uint32_t) state.range(0);
+	uint8_t data[CIRCULAR_FIFO_SIZE];
+	memset(data, 0x5A, sizeof(data));
+
+	while(state.KeepRunning()) {
+		circular_fifo_write(&fifo, data, len);
+		uint32_t read_len = len;
+		circular_fifo_read(&fifo, data, &read_len);
+		if(read_len != len) {
+			state.SkipWithError("Read failed");
+			break;
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+	state.SetBytesProcessed(state.iterations() * len);
+}
+PERF_BENCHMARK(BM_CircularFifoWriteRead)->ArgNames({"bytes"})->Arg(1)->Arg(sizeof(ScanStream))->Arg(128)->Arg(CIRCULAR_FIFO_SIZE/2);
+
+
+/**@brief Benchmark of circular_fifo_put()/circular_fifo_get() byte by byte.
+ */
+static void BM_CircularFifoPutGet(PerfState& state) {
+	circular_fifo_t fifo;
+	ret_code_t ret;
+	CIRCULAR_FIFO_INIT(ret, fifo, CIRCULAR_FIFO_SIZE);
+	uint8_t byte = 0;
+
+	while(state.KeepRunning()) {
+		circular_fifo_put(&fifo, byte);
+		if(circular_fifo_get(&fifo, &byte) != NRF_SUCCESS) {
+			state.SkipWithError("Get failed");
+			break;
+		}
+		byte++;
+	}
+	state.SetBytesProcessed(state.iterations());
+}
+PERF_BENCHMARK(BM_CircularFifoPutGet);
+
+
+/**@brief Benchmark of one chunk through the chunk-fifo (write-open, write-close, read-open, read-close) with chunks chunks in the fifo.
+ */
+static void BM_ChunkFifoWriteRead(PerfState& state) {
+	chunk_fifo_t fifo;
+	ret_code_t ret;
+	CHUNK_FIFO_INIT(ret, fifo, 8, sizeof(BatteryChunk), 0);
+	uint32_t chunks = (uint32_t) state.range(0);
+	BatteryChunk* chunk;
+	for(uint32_t i = 1; i < chunks; i++) {	// Keep chunks-1 chunks in the fifo
+		chunk_fifo_write_open(&fifo, (void**) &chunk, NULL);
+		chunk_fifo_write_close(&fifo);
+	}
+
+	while(state.KeepRunning()) {
+		chunk_fifo_write_open(&fifo, (void**) &chunk, NULL);
+		chunk->timestamp.seconds++;
+		if(chunk_fifo_write_close(&fifo) != NRF_SUCCESS || chunk_fifo_read_open(&fifo, (void**) &chunk, NULL) != NRF_SUCCESS) {
+			state.SkipWithError("Chunk-fifo full or empty");
+			break;
+		}
+		perf_do_not_optimize(chunk);
+		chunk_fifo_read_close(&fifo);
+	}
+	(void) ret;
+	state.SetItemsProcessed(state.iterations());
+}
+PERF_BENCHMARK(BM_ChunkFifoWriteRead)->ArgNames({"chunks"})->Arg(1)->Arg(4);
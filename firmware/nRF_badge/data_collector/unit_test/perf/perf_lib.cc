@@ -0,0 +1,419 @@
+#include "perf_lib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <math.h>
+#include <regex>
+#include <algorithm>
+
+#include "timer_lib.h"
+
+
+#define PERF_MAX_ITERATIONS		1000000000ULL
+#define PERF_DEFAULT_MIN_TIME	0.05		/**< Minimal CPU-time of a run in seconds */
+
+
+/**< One result line (an iteration-run or an aggregate over the repetitions) */
+typedef struct {
+	std::string name;
+	std::string run_name;
+	std::string run_type;			/**< "iteration" or "aggregate" */
+	std::string aggregate_name;		/**< "mean", "median" or "stddev" for aggregates */
+	uint32_t repetitions;
+	uint32_t repetition_index;
+	uint64_t iterations;
+	double real_time;				/**< ns per iteration */
+	double cpu_time;				/**< ns per iteration */
+	double items_per_second;
+	double bytes_per_second;
+	std::string label;
+	std::string error_message;
+} perf_result_t;
+
+
+static std::vector<PerfBenchmark*>& registered_benchmarks(void) {
+	static std::vector<PerfBenchmark*> benchmarks;	// Function-local, so the registration works independent of the static initialization order
+	return benchmarks;
+}
+
+static double now_ns(clockid_t clock) {
+	struct timespec ts;
+	clock_gettime(clock, &ts);
+	return ((double) ts.tv_sec) * 1e9 + (double) ts.tv_nsec;
+}
+
+
+/************************** PerfState *********************************/
+
+PerfState::PerfState(uint64_t max_iterations, const std::vector<int64_t>& args) :
+	real_time_ns(0), cpu_time_ns(0), items_processed(0), bytes_processed(0),
+	max_iterations(max_iterations), iterations_done(0), args(args), started(0), running(0), real_start_ns(0), cpu_start_ns(0) {
+}
+
+void PerfState::start_timer(void) {
+	running = 1;
+	real_start_ns = now_ns(CLOCK_MONOTONIC);
+	cpu_start_ns = now_ns(CLOCK_THREAD_CPUTIME_ID);
+}
+
+void PerfState::stop_timer(void) {
+	if(!running)
+		return;
+	real_time_ns += now_ns(CLOCK_MONOTONIC) - real_start_ns;
+	cpu_time_ns += now_ns(CLOCK_THREAD_CPUTIME_ID) - cpu_start_ns;
+	running = 0;
+}
+
+bool PerfState::KeepRunning(void) {
+	if(!error_message.empty())
+		return false;
+	if(!started) {
+		started = 1;
+		start_timer();
+	} else {
+		iterations_done++;
+	}
+	if(iterations_done < max_iterations)
+		return true;
+	stop_timer();
+	return false;
+}
+
+void PerfState::PauseTiming(void) {
+	stop_timer();
+}
+
+void PerfState::ResumeTiming(void) {
+	start_timer();
+}
+
+int64_t PerfState::range(uint32_t index) const {
+	return (index < args.size()) ? args[index] : 0;
+}
+
+void PerfState::SkipWithError(const std::string& message) {
+	error_message = message;
+	stop_timer();
+}
+
+
+/************************** Registration *********************************/
+
+PerfBenchmark* PerfBenchmark::Arg(int64_t arg) {
+	arg_sets.push_back(std::vector<int64_t>(1, arg));
+	return this;
+}
+
+PerfBenchmark* PerfBenchmark::Args(const std::vector<int64_t>& args) {
+	arg_sets.push_back(args);
+	return this;
+}
+
+PerfBenchmark* PerfBenchmark::ArgNames(const std::vector<std::string>& names) {
+	arg_names = names;
+	return this;
+}
+
+PerfBenchmark* perf_register(const std::string& name, perf_function_t function) {
+	PerfBenchmark* benchmark = new PerfBenchmark(name, function);
+	registered_benchmarks().push_back(benchmark);
+	return benchmark;
+}
+
+void perf_do_not_optimize(const void* p) {
+	asm volatile("" : : "r"(p) : "memory");
+}
+
+uint32_t perf_random(uint32_t* seed) {
+	*seed = (*seed) * 1103515245 + 12345;
+	return (*seed) >> 8;
+}
+
+
+/************************** Runner *********************************/
+
+static std::string run_name(const PerfBenchmark* benchmark, const std::vector<int64_t>& args) {
+	std::string name = benchmark->name;
+	for(uint32_t i = 0; i < args.size(); i++) {
+		name += "/";
+		if(i < benchmark->arg_names.size() && !benchmark->arg_names[i].empty())
+			name += benchmark->arg_names[i] + ":";
+		name += std::to_string((long long) args[i]);
+	}
+	return name;
+}
+
+/**@brief Function to run a benchmark once with a fixed number of iterations.
+ */
+static void run_once(const PerfBenchmark* benchmark, const std::vector<int64_t>& args, uint64_t iterations, PerfState* state) {
+	*state = PerfState(iterations, args);
+	benchmark->function(*state);
+}
+
+/**@brief Function to run one repetition. If iterations == 0, the iterations are calibrated like in Google Benchmark:
+ *			increased until a run takes at least min_time CPU-time (the last run is the measurement).
+ */
+static perf_result_t run_repetition(const PerfBenchmark* benchmark, const std::vector<int64_t>& args, double min_time, uint64_t* iterations) {
+	PerfState state(0, args);
+	uint64_t n = (*iterations > 0) ? *iterations : 1;
+	while(1) {
+		run_once(benchmark, args, n, &state);
+		if(!state.error_message.empty() || *iterations > 0)
+			break;
+		double seconds = state.cpu_time_ns / 1e9;	// Like Google Benchmark, calibrated on the CPU-time (the mocks have timer threads)
+		if(seconds >= min_time || n >= PERF_MAX_ITERATIONS) {
+			*iterations = n;
+			break;
+		}
+		double multiplier = (seconds / min_time > 0.1) ? (min_time * 1.4 / seconds) : 10.0;
+		uint64_t next = (uint64_t) (multiplier * (double) n);
+		n = std::min(std::max(next, n + 1), (uint64_t) PERF_MAX_ITERATIONS);
+	}
+
+	perf_result_t result;
+	result.name = run_name(benchmark, args);
+	result.run_name = result.name;
+	result.run_type = "iteration";
+	result.repetitions = 1;
+	result.repetition_index = 0;
+	result.iterations = state.iterations();
+	result.error_message = state.error_message;
+	result.label = state.label;
+	double divisor = (state.iterations() > 0) ? (double) state.iterations() : 1.0;
+	result.real_time = state.real_time_ns / divisor;
+	result.cpu_time = state.cpu_time_ns / divisor;
+	double cpu_seconds = state.cpu_time_ns / 1e9;
+	result.items_per_second = (cpu_seconds > 0) ? state.items_processed / cpu_seconds : 0;
+	result.bytes_per_second = (cpu_seconds > 0) ? state.bytes_processed / cpu_seconds : 0;
+	return result;
+}
+
+static double aggregate(std::vector<double> values, const std::string& aggregate_name) {
+	double mean = 0;
+	for(uint32_t i = 0; i < values.size(); i++)
+		mean += values[i] / values.size();
+	if(aggregate_name == "mean")
+		return mean;
+	if(aggregate_name == "median") {
+		std::sort(values.begin(), values.end());
+		uint32_t n = values.size();
+		return (n % 2) ? values[n/2] : (values[n/2 - 1] + values[n/2]) / 2;
+	}
+	double variance = 0;
+	for(uint32_t i = 0; i < values.size(); i++)
+		variance += (values[i] - mean) * (values[i] - mean);
+	return (values.size() > 1) ? sqrt(variance / (values.size() - 1)) : 0;
+}
+
+static perf_result_t aggregate_results(const std::vector<perf_result_t>& runs, const std::string& aggregate_name) {
+	std::vector<double> real_times, cpu_times, items, bytes;
+	for(uint32_t i = 0; i < runs.size(); i++) {
+		real_times.push_back(runs[i].real_time);
+		cpu_times.push_back(runs[i].cpu_time);
+		items.push_back(runs[i].items_per_second);
+		bytes.push_back(runs[i].bytes_per_second);
+	}
+	perf_result_t result = runs[0];
+	result.name = runs[0].run_name + "_" + aggregate_name;
+	result.run_type = "aggregate";
+	result.aggregate_name = aggregate_name;
+	result.repetitions = runs.size();
+	result.iterations = runs.size();
+	result.real_time = aggregate(real_times, aggregate_name);
+	result.cpu_time = aggregate(cpu_times, aggregate_name);
+	result.items_per_second = aggregate(items, aggregate_name);
+	result.bytes_per_second = aggregate(bytes, aggregate_name);
+	return result;
+}
+
+
+/************************** Output *********************************/
+
+static std::string format_rate(double rate, const char* unit) {
+	char buf[32];
+	const char* prefixes[] = {"", "k", "M", "G"};
+	uint32_t i = 0;
+	while(rate >= 1000 && i < 3) {
+		rate /= 1000;
+		i++;
+	}
+	snprintf(buf, sizeof(buf), "%.2f%s%s/s", rate, prefixes[i], unit);
+	return std::string(buf);
+}
+
+static void print_result(const perf_result_t& result, uint32_t name_width) {
+	if(!result.error_message.empty()) {
+		printf("%-*s ERROR: %s\n", name_width, result.name.c_str(), result.error_message.c_str());
+		return;
+	}
+	printf("%-*s %13.1f ns %13.1f ns %12llu", name_width, result.name.c_str(), result.real_time, result.cpu_time, (unsigned long long) result.iterations);
+	if(result.bytes_per_second > 0)
+		printf(" %s", format_rate(result.bytes_per_second, "B").c_str());
+	if(result.items_per_second > 0)
+		printf(" %s", format_rate(result.items_per_second, "").c_str());
+	if(!result.label.empty())
+		printf(" %s", result.label.c_str());
+	printf("\n");
+	fflush(stdout);
+}
+
+static std::string json_escape(const std::string& s) {
+	std::string escaped;
+	for(uint32_t i = 0; i < s.size(); i++) {
+		if(s[i] == '"' || s[i] == '\\')
+			escaped += '\\';
+		escaped += s[i];
+	}
+	return escaped;
+}
+
+static uint8_t write_json(const char* filename, const char* executable, const std::vector<perf_result_t>& results) {
+	FILE* file = fopen(filename, "w");
+	if(file == NULL)
+		return 0;
+
+	char date[64], host_name[256] = "";
+	time_t t = time(NULL);
+	strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&t));
+	gethostname(host_name, sizeof(host_name) - 1);
+
+	fprintf(file, "{\n  \"context\": {\n");
+	fprintf(file, "    \"date\": \"%s\",\n", date);
+	fprintf(file, "    \"host_name\": \"%s\",\n", json_escape(host_name).c_str());
+	fprintf(file, "    \"executable\": \"%s\",\n", json_escape(executable).c_str());
+	fprintf(file, "    \"num_cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+	fprintf(file, "    \"library_build_type\": \"release\"\n");
+	fprintf(file, "  },\n  \"benchmarks\": [");
+	for(uint32_t i = 0; i < results.size(); i++) {
+		const perf_result_t& r = results[i];
+		fprintf(file, "%s\n    {\n", (i > 0) ? "," : "");
+		fprintf(file, "      \"name\": \"%s\",\n", json_escape(r.name).c_str());
+		fprintf(file, "      \"run_name\": \"%s\",\n", json_escape(r.run_name).c_str());
+		fprintf(file, "      \"run_type\": \"%s\",\n", r.run_type.c_str());
+		if(r.run_type == "aggregate")
+			fprintf(file, "      \"aggregate_name\": \"%s\",\n", r.aggregate_name.c_str());
+		fprintf(file, "      \"repetitions\": %u,\n", r.repetitions);
+		fprintf(file, "      \"repetition_index\": %u,\n", r.repetition_index);
+		if(!r.error_message.empty()) {
+			fprintf(file, "      \"error_occurred\": true,\n");
+			fprintf(file, "      \"error_message\": \"%s\",\n", json_escape(r.error_message).c_str());
+		}
+		fprintf(file, "      \"iterations\": %llu,\n", (unsigned long long) r.iterations);
+		fprintf(file, "      \"real_time\": %.4f,\n", r.real_time);
+		fprintf(file, "      \"cpu_time\": %.4f,\n", r.cpu_time);
+		fprintf(file, "      \"time_unit\": \"ns\"");
+		if(r.bytes_per_second > 0)
+			fprintf(file, ",\n      \"bytes_per_second\": %.4f", r.bytes_per_second);
+		if(r.items_per_second > 0)
+			fprintf(file, ",\n      \"items_per_second\": %.4f", r.items_per_second);
+		if(!r.label.empty())
+			fprintf(file, ",\n      \"label\": \"%s\"", json_escape(r.label).c_str());
+		fprintf(file, "\n    }");
+	}
+	fprintf(file, "\n  ]\n}\n");
+	fclose(file);
+	return 1;
+}
+
+
+/************************** Main *********************************/
+
+static void print_usage(const char* executable) {
+	printf("Usage: %s [--benchmark_filter=REGEX] [--benchmark_min_time=SECONDS] [--benchmark_repetitions=N]\n", executable);
+	printf("       %*s [--benchmark_out=FILE] [--benchmark_list_tests]\n", (int) strlen(executable), "");
+}
+
+int main(int argc, char** argv) {
+	std::string filter = ".";
+	double min_time = PERF_DEFAULT_MIN_TIME;
+	uint32_t repetitions = 1;
+	const char* out_filename = NULL;
+	uint8_t list_tests = 0;
+
+	for(int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+		if(strncmp(arg, "--benchmark_filter=", 19) == 0) {
+			filter = arg + 19;
+		} else if(strncmp(arg, "--benchmark_min_time=", 21) == 0) {
+			min_time = atof(arg + 21);
+		} else if(strncmp(arg, "--benchmark_repetitions=", 24) == 0) {
+			repetitions = (uint32_t) atoi(arg + 24);
+		} else if(strncmp(arg, "--benchmark_out=", 16) == 0) {
+			out_filename = arg + 16;
+		} else if(strcmp(arg, "--benchmark_list_tests") == 0) {
+			list_tests = 1;
+		} else {
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+	if(repetitions == 0 || min_time <= 0) {
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	// The mocks process their timers in the context of the benchmarks, so no timer-threads compete with the benchmarks for the CPU
+	timer_enable_virtual_time(1);
+
+	std::regex filter_regex(filter);
+	std::vector<std::pair<PerfBenchmark*, std::vector<int64_t> > > runs;
+	uint32_t name_width = 10;
+	for(uint32_t b = 0; b < registered_benchmarks().size(); b++) {
+		PerfBenchmark* benchmark = registered_benchmarks()[b];
+		std::vector<std::vector<int64_t> > arg_sets = benchmark->arg_sets;
+		if(arg_sets.empty())
+			arg_sets.push_back(std::vector<int64_t>());
+		for(uint32_t a = 0; a < arg_sets.size(); a++) {
+			std::string name = run_name(benchmark, arg_sets[a]);
+			if(!std::regex_search(name, filter_regex))
+				continue;
+			runs.push_back(std::make_pair(benchmark, arg_sets[a]));
+			name_width = std::max(name_width, (uint32_t) name.size() + ((repetitions > 1) ? 7 : 0));
+		}
+	}
+
+	if(list_tests) {
+		for(uint32_t i = 0; i < runs.size(); i++)
+			printf("%s\n", run_name(runs[i].first, runs[i].second).c_str());
+		return 0;
+	}
+
+	printf("%-*s %16s %16s %12s\n", name_width, "Benchmark", "Time", "CPU", "Iterations");
+	printf("%s\n", std::string(name_width + 47, '-').c_str());
+
+	std::vector<perf_result_t> results;
+	uint8_t failed = 0;
+	for(uint32_t i = 0; i < runs.size(); i++) {
+		std::vector<perf_result_t> repetition_results;
+		uint64_t iterations = 0;
+		for(uint32_t r = 0; r < repetitions; r++) {
+			perf_result_t result = run_repetition(runs[i].first, runs[i].second, min_time, &iterations);
+			result.repetitions = repetitions;
+			result.repetition_index = r;
+			print_result(result, name_width);
+			results.push_back(result);
+			repetition_results.push_back(result);
+			if(!result.error_message.empty()) {
+				failed = 1;
+				break;
+			}
+		}
+		if(repetitions > 1 && repetition_results.size() == repetitions) {
+			const char* aggregate_names[] = {"mean", "median", "stddev"};
+			for(uint32_t a = 0; a < 3; a++) {
+				perf_result_t result = aggregate_results(repetition_results, aggregate_names[a]);
+				print_result(result, name_width);
+				results.push_back(result);
+			}
+		}
+	}
+
+	if(out_filename != NULL && !write_json(out_filename, argv[0], results)) {
+		printf("Could not write %s\n", out_filename);
+		return 1;
+	}
+	return failed;
+}
@@ -0,0 +1,121 @@
+#ifndef __PERF_LIB_H
+#define __PERF_LIB_H
+
+/**@file
+ * @details	Minimal Google-Benchmark-style harness for the performance suite (make perf, make run_perf).
+ *
+ *			The benchmarks are written like Google Benchmark benchmarks, so they could be moved to it without changes of the bodies:
+ *				static void BM_Something(PerfState& state) {
+ *					// Setup (not measured)
+ *					while(state.KeepRunning()) {
+ *						// Measured code
+ *					}
+ *					state.SetItemsProcessed(state.iterations());
+ *				}
+ *				PERF_BENCHMARK(BM_Something)->Arg(16)->Arg(256);
+ *
+ *			The number of iterations is calibrated until a run takes at least --benchmark_min_time seconds.
+ *			The results are printed as table and can be written as JSON in the format of Google Benchmark
+ *			(--benchmark_out=FILE), so they can be compared between commits with perf/compare_perf.py.
+ *
+ *			Options:	--benchmark_filter=REGEX		Only run the benchmarks whose name matches REGEX.
+ *						--benchmark_min_time=SECONDS	Minimal time of a run (default 0.05).
+ *						--benchmark_repetitions=N		Repeat every benchmark N times and report the mean, median and stddev.
+ *						--benchmark_out=FILE			Write the results as JSON to FILE.
+ *						--benchmark_list_tests			Only print the names of the benchmarks.
+ */
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <functional>
+
+
+/**< The state of a benchmark run, passed to the benchmark function */
+class PerfState {
+public:
+	PerfState(uint64_t max_iterations, const std::vector<int64_t>& args);
+
+	/**@brief Function to control the measured loop: starts the timing on the first call and stops it after the last iteration.
+	 *
+	 * @retval	true if another iteration should be run.
+	 */
+	bool KeepRunning(void);
+
+	/**@brief Functions to exclude a part of an iteration (e.g. the refill of a buffer) from the timing. */
+	void PauseTiming(void);
+	void ResumeTiming(void);
+
+	/**@brief Function to retrieve an argument of the benchmark (see PerfBenchmark::Arg()). */
+	int64_t range(uint32_t index) const;
+
+	uint64_t iterations(void) const { return iterations_done; }
+
+	void SetItemsProcessed(int64_t items) { items_processed = items; }
+	void SetBytesProcessed(int64_t bytes) { bytes_processed = bytes; }
+	void SetLabel(const std::string& text) { label = text; }
+
+	/**@brief Function to abort a benchmark, e.g. if the setup failed. The KeepRunning()-loop is not entered anymore. */
+	void SkipWithError(const std::string& message);
+
+	// Results (used by the runner)
+	double real_time_ns;
+	double cpu_time_ns;
+	int64_t items_processed;
+	int64_t bytes_processed;
+	std::string label;
+	std::string error_message;
+
+private:
+	void start_timer(void);
+	void stop_timer(void);
+
+	uint64_t max_iterations;
+	uint64_t iterations_done;
+	std::vector<int64_t> args;
+	uint8_t started;
+	uint8_t running;
+	double real_start_ns;
+	double cpu_start_ns;
+};
+
+
+typedef std::function<void(PerfState&)> perf_function_t;
+
+/**< A registered benchmark with its argument sets */
+class PerfBenchmark {
+public:
+	PerfBenchmark(const std::string& name, perf_function_t function) : name(name), function(function) {}
+
+	/**@brief Functions to add an argument set, every argument set is a separate run (named like NAME/ARG or NAME/ARGNAME:ARG). */
+	PerfBenchmark* Arg(int64_t arg);
+	PerfBenchmark* Args(const std::vector<int64_t>& args);
+	PerfBenchmark* ArgNames(const std::vector<std::string>& names);
+
+	std::string name;
+	perf_function_t function;
+	std::vector<std::vector<int64_t> > arg_sets;
+	std::vector<std::string> arg_names;
+};
+
+
+/**@brief Function to register a benchmark (e.g. with a lambda, for benchmarks that are generated in a loop).
+ *
+ * @retval	Pointer to the registered benchmark, to add arguments.
+ */
+PerfBenchmark* perf_register(const std::string& name, perf_function_t function);
+
+/**@brief Function to prevent the compiler from removing a computation whose result is not used. */
+void perf_do_not_optimize(const void* p);
+
+/**@brief Function to retrieve a deterministic pseudo-random number (LCG), so every run gets the same input.
+ *
+ * @param[in,out]	seed	Pointer to the state of the generator, advanced by every call.
+ */
+uint32_t perf_random(uint32_t* seed);
+
+#define PERF_CONCAT_(A, B)		A##B
+#define PERF_CONCAT(A, B)		PERF_CONCAT_(A, B)
+#define PERF_BENCHMARK(FUNCTION)	static PerfBenchmark* PERF_CONCAT(perf_benchmark_, __LINE__) __attribute__((unused)) = perf_register(#FUNCTION, FUNCTION)
+
+#endif
@@ -0,0 +1,151 @@
+/**@file
+ * @details	Benchmarks of the scan processing (aggregation of the scan reports in sampling_lib.c, sorting of the seen devices in processing_lib.c)
+ *			and of the CRC16 of the filesystem.
+ */
+
+#include <string.h>
+#include <vector>
+
+#include "perf_lib.h"
+#include "app_timer.h"
+#include "app_scheduler.h"
+#include "systick_lib.h"
+#include "timeout_lib.h"
+#include "ble_lib.h"
+#include "sender_lib.h"
+#include "scanner_lib.h"
+#include "sampling_lib.h"
+#include "processing_lib.h"
+#include "chunk_messages.h"
+
+
+#define SCAN_GROUP_ID				10
+#define SCAN_REPORTS_PER_DEVICE		5		/**< Number of reports per device in one scan-cycle */
+#define SCAN_BEACON_ID_RANGE		20000	/**< The IDs are drawn from [0, 20000), so about 20% are beacons (see SCAN_BEACON_ID_THRESHOLD) */
+
+extern void processing_sort_scan(ScanSamplingChunk* scan_sampling_chunk);	/**< In processing_lib.c */
+extern void sampling_scan_callback(void* p_context);							/**< In sampling_lib.c */
+extern void sampling_on_scan_timeout_callback(void);						/**< In sampling_lib.c */
+extern void sampling_on_scan_report_callback(scanner_scan_report_t* scanner_scan_report);	/**< In sampling_lib.c */
+extern uint16_t crc16_compute(uint8_t const * p_data, uint32_t size, uint16_t const * p_crc); /**< In filesystem_lib.c */
+
+
+/**@brief Function to fill a scan sampling chunk with num_devices devices with random IDs and RSSI values.
+ */
+static void fill_scan_sampling_chunk(ScanSamplingChunk* scan_sampling_chunk, uint32_t num_devices) {
+	uint32_t seed = 42;
+	memset(scan_sampling_chunk, 0, sizeof(ScanSamplingChunk));
+	scan_sampling_chunk->scan_result_data_count = (uint8_t) num_devices;
+	for(uint32_t i = 0; i < num_devices; i++) {
+		scan_sampling_chunk->scan_result_data[i].scan_device.ID = (uint16_t) (perf_random(&seed) % SCAN_BEACON_ID_RANGE);
+		scan_sampling_chunk->scan_result_data[i].scan_device.rssi = (int8_t) (-30 - (int32_t) (perf_random(&seed) % 70));
+		scan_sampling_chunk->scan_result_data[i].count = 1;
+	}
+}
+
+static void BM_SortScan(PerfState& state) {
+	static ScanSamplingChunk input, scan_sampling_chunk;
+	fill_scan_sampling_chunk(&input, (uint32_t) state.range(0));
+
+	while(state.KeepRunning()) {
+		state.PauseTiming();
+		memcpy(&scan_sampling_chunk, &input, sizeof(scan_sampling_chunk));
+		state.ResumeTiming();
+		processing_sort_scan(&scan_sampling_chunk);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+PERF_BENCHMARK(BM_SortScan)->ArgNames({"devices"})->Arg(SCAN_CHUNK_DATA_SIZE + 1)->Arg(128)->Arg(SCAN_SAMPLING_CHUNK_DATA_SIZE);
+
+
+/**@brief Function to initialize the modules that are needed for the scan sampling and the sender (only once, shared with the other benchmarks that need the timers).
+ */
+ret_code_t perf_init_sampling(void) {
+	static uint8_t init_done = 0;
+	if(init_done)
+		return NRF_SUCCESS;
+
+	APP_SCHED_INIT(4, 100);
+	APP_TIMER_INIT(0, 60, NULL);
+	ret_code_t ret = systick_init(0);
+	if(ret != NRF_SUCCESS) return ret;
+	ret = timeout_init();
+	if(ret != NRF_SUCCESS) return ret;
+	ret = ble_init();
+	if(ret != NRF_SUCCESS) return ret;
+	ret = sender_init();
+	if(ret != NRF_SUCCESS) return ret;
+	ret = sampling_init();
+	if(ret != NRF_SUCCESS) return ret;
+	init_done = 1;
+	return NRF_SUCCESS;
+}
+
+/**@brief Benchmark of the aggregation of the scan reports of one scan-cycle into the scan sampling chunk (sampling_lib.c).
+ *
+ * @details	The scan-cycles are started and finished directly (the timers are configured to never fire),
+ *			the aggregation of the reports and the finalization of the chunk are measured.
+ */
+static void BM_ScanAggregation(PerfState& state) {
+	uint32_t num_devices = (uint32_t) state.range(0);
+	uint8_t aggregation_type = (uint8_t) state.range(1);
+	if(perf_init_sampling() != NRF_SUCCESS || sampling_start_scan(0, 0xFFFF, 300, 100, 0xFFFF, SCAN_GROUP_ID, aggregation_type, 0) != NRF_SUCCESS) {
+		state.SkipWithError("Sampling setup failed");
+		return;
+	}
+
+	// The reports of one scan-cycle: every device SCAN_REPORTS_PER_DEVICE times, interleaved
+	uint32_t num_reports = num_devices * SCAN_REPORTS_PER_DEVICE;
+	std::vector<scanner_scan_report_t> reports(num_reports);
+	uint32_t seed = 42;
+	for(uint32_t i = 0; i < num_reports; i++) {
+		reports[i].ID = (uint16_t) (1 + (i % num_devices));
+		reports[i].group = SCAN_GROUP_ID;
+		reports[i].scanner_scan_device_type = SCAN_DEVICE_TYPE_BADGE;
+		reports[i].rssi = (int8_t) (-30 - (int32_t) (perf_random(&seed) % 70));
+	}
+
+	uint32_t stored_devices = 0;
+	while(state.KeepRunning()) {
+		state.PauseTiming();
+		sampling_scan_callback(NULL);	// Opens the scan sampling chunk
+		state.ResumeTiming();
+
+		for(uint32_t i = 0; i < num_reports; i++)
+			sampling_on_scan_report_callback(&reports[i]);
+		sampling_on_scan_timeout_callback();	// Finalizes the scan sampling chunk
+
+		state.PauseTiming();
+		ScanSamplingChunk* scan_sampling_chunk;
+		if(chunk_fifo_read_open(&scan_sampling_chunk_fifo, (void**) &scan_sampling_chunk, NULL) == NRF_SUCCESS) {
+			stored_devices = scan_sampling_chunk->scan_result_data_count;
+			chunk_fifo_read_close(&scan_sampling_chunk_fifo);
+		}
+		app_sched_execute();	// The processing finds no chunk anymore
+		state.ResumeTiming();
+	}
+	sampling_stop_scan(0);
+	if(state.iterations() > 0 && stored_devices != num_devices)
+		state.SkipWithError("Not all devices were aggregated");
+	state.SetItemsProcessed(state.iterations() * num_reports);
+}
+PERF_BENCHMARK(BM_ScanAggregation)->ArgNames({"devices", "mean"})
+	->Args({10, SCAN_CHUNK_AGGREGATE_TYPE_MAX})->Args({100, SCAN_CHUNK_AGGREGATE_TYPE_MAX})->Args({SCAN_SAMPLING_CHUNK_DATA_SIZE, SCAN_CHUNK_AGGREGATE_TYPE_MAX})
+	->Args({10, SCAN_CHUNK_AGGREGATE_TYPE_MEAN})->Args({100, SCAN_CHUNK_AGGREGATE_TYPE_MEAN})->Args({SCAN_SAMPLING_CHUNK_DATA_SIZE, SCAN_CHUNK_AGGREGATE_TYPE_MEAN});
+
+
+static void BM_Crc16(PerfState& state) {
+	uint32_t len = (uint32_t) state.range(0);
+	std::vector<uint8_t> data(len);
+	uint32_t seed = 42;
+	for(uint32_t i = 0; i < len; i++)
+		data[i] = (uint8_t) perf_random(&seed);
+
+	uint16_t crc = 0;
+	while(state.KeepRunning()) {
+		crc = crc16_compute(data.data(), len, &crc);
+	}
+	perf_do_not_optimize(&crc);
+	state.SetBytesProcessed(state.iterations() * len);
+}
+PERF_BENCHMARK(BM_Crc16)->ArgNames({"bytes"})->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
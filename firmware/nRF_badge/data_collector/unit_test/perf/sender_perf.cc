@@ -0,0 +1,117 @@
+/**@file
+ * @details	Benchmark of the sender-module: double-buffered packets are transmitted over the simulated BLE-link
+ *			(the BLE-mock sends at most NUMBER_OF_TX_BUFFERS notifications per connection event, see ble_lib_mock.c).
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "perf_lib.h"
+#include "timer_lib.h"
+#include "app_scheduler.h"
+#include "ble_lib.h"
+#include "sender_lib.h"
+
+
+#define CONNECTION_INTERVAL_MS		10			/**< The connection interval of the BLE-mock */
+#define NUMBER_OF_TX_BUFFERS		6			/**< The notification buffers of the BLE-mock */
+#define MAX_BYTES_PER_TRANSMIT		20			/**< The bytes per notification */
+#define TRANSMIT_BYTES				(64*1024)	/**< The bytes that are transmitted per iteration */
+#define MAX_PACKET_SIZE				1000
+
+extern ret_code_t perf_init_sampling(void);	/**< In processing_perf.cc */
+
+/** Include some (private) functions of the BLE-mock */
+extern void ble_simulate_connect(void);
+extern void ble_simulate_set_connection_event_handler(void (*connection_event_handler)(void));
+extern uint32_t ble_transmit_fifo_get_size(void);
+extern ret_code_t ble_transmit_fifo_read(uint8_t* data, uint32_t len);
+
+
+static uint64_t received_bytes = 0;
+static volatile uint8_t packet_in_use[2];
+
+static void transmit_complete_handler(ret_code_t status, void* p_context) {
+	*((volatile uint8_t*) p_context) = 0;
+}
+
+/**@brief Function to read out the notifications that were sent at a connection event (like the peer).
+ */
+static void receive_transmitted_bytes(void) {
+	uint8_t data[256];
+	uint32_t len = ble_transmit_fifo_get_size();
+	while(len > 0) {
+		uint32_t read_len = (len > sizeof(data)) ? sizeof(data) : len;
+		if(ble_transmit_fifo_read(data, read_len) != NRF_SUCCESS)
+			break;
+		received_bytes += read_len;
+		len -= read_len;
+	}
+}
+
+static void advance_to_next_connection_event(void) {
+	timer_virtual_advance_to_next_event(timer_get_microseconds_since_start() + CONNECTION_INTERVAL_MS*1000);
+}
+
+/**@brief Benchmark of the transmission of TRANSMIT_BYTES in packets of packet_size bytes (one packet is filled while the other one is transmitted in place).
+ *
+ * @details	The bytes are the transmitted bytes, the label reports the throughput in virtual time and the maximum of the simulated link.
+ */
+static void BM_SenderThroughput(PerfState& state) {
+	uint32_t packet_size = (uint32_t) state.range(0);
+	if(perf_init_sampling() != NRF_SUCCESS) {
+		state.SkipWithError("Sender setup failed");
+		return;
+	}
+	ble_simulate_set_connection_event_handler(receive_transmitted_bytes);
+	ble_simulate_connect();
+	timer_virtual_run_for(100*1000, app_sched_execute);
+
+	static uint8_t packet[2][MAX_PACKET_SIZE];
+	uint64_t sent_bytes = 0;
+	uint32_t packet_index = 0;
+	received_bytes = 0;
+	packet_in_use[0] = 0;
+	packet_in_use[1] = 0;
+	uint64_t start_us = timer_get_microseconds_since_start();
+	while(state.KeepRunning()) {
+		uint32_t iteration_bytes = 0;
+		while(iteration_bytes < TRANSMIT_BYTES) {
+			while(packet_in_use[packet_index])
+				advance_to_next_connection_event();
+			memset(packet[packet_index], (uint8_t) sent_bytes, packet_size);
+			sender_segment_t segment;
+			segment.data = packet[packet_index];
+			segment.len = packet_size;
+			packet_in_use[packet_index] = 1;
+			if(sender_transmit_segments(&segment, 1, transmit_complete_handler, (void*) &packet_in_use[packet_index]) != NRF_SUCCESS) {
+				packet_in_use[packet_index] = 0;
+				break;
+			}
+			iteration_bytes += packet_size;
+			sent_bytes += packet_size;
+			packet_index = (packet_index + 1) % 2;
+		}
+		if(iteration_bytes < TRANSMIT_BYTES) {
+			state.SkipWithError("Transmit failed");
+			break;
+		}
+	}
+	// Wait until everything is sent
+	uint64_t max_us = timer_get_microseconds_since_start() + 10*1000*1000;
+	while(received_bytes < sent_bytes && timer_get_microseconds_since_start() < max_us)
+		advance_to_next_connection_event();
+	uint64_t virtual_us = timer_get_microseconds_since_start() - start_us;
+
+	sender_disconnect();
+	timer_virtual_run_for(100*1000, app_sched_execute);
+	ble_simulate_set_connection_event_handler(NULL);
+
+	uint64_t throughput = (virtual_us > 0) ? (received_bytes * 1000 * 1000) / virtual_us : 0;
+	uint32_t link_throughput = (NUMBER_OF_TX_BUFFERS * MAX_BYTES_PER_TRANSMIT * 1000) / CONNECTION_INTERVAL_MS;
+	char label[128];
+	snprintf(label, sizeof(label), "%u bytes/s virtual (link maximum %u bytes/s)", (uint32_t) throughput, link_throughput);
+	state.SetLabel(label);
+	state.SetBytesProcessed(sent_bytes);
+}
+PERF_BENCHMARK(BM_SenderThroughput)->ArgNames({"packet_size"})->Arg(MAX_BYTES_PER_TRANSMIT)->Arg(200)->Arg(MAX_PACKET_SIZE);
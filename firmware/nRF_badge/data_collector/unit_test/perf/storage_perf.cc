@@ -0,0 +1,190 @@
+/**@file
+ * @details	Benchmarks of the filesystem (store and iterator reads by storage medium, partition type and fill level)
+ *			and of the timestamp search of the storer.
+ *			The storage mocks complete all operations instantly, so the benchmarks measure the CPU-time of the firmware code
+ *			(the modeled storage time is accounted by storage_model_lib.h).
+ */
+
+#include <string.h>
+
+#include "perf_lib.h"
+#include "filesystem_lib.h"
+#include "storage_lib.h"
+#include "storage1_lib.h"
+#include "storage2_lib.h"
+#include "storer_lib.h"
+#include "chunk_messages.h"
+
+
+#define FILESYSTEM_ELEMENT_LEN			32
+#define FILESYSTEM_PARTITION_ELEMENTS	1024
+#define FILESYSTEM_MAX_HEADER_LEN		(PARTITION_ELEMENT_HEADER_RECORD_ID_SIZE + PARTITION_ELEMENT_HEADER_PREVIOUS_LEN_XOR_CUR_LEN_SIZE + PARTITION_ELEMENT_HEADER_ELEMENT_CRC_SIZE)
+
+#define MEDIUM_FLASH	0
+#define MEDIUM_EEPROM	1
+
+
+/**@brief Function to clear the storage and register a partition for the benchmark.
+ *
+ * @details	The partitions are placed in the order of registration, beginning in the first storage module
+ *			(the EEPROM in the firmware layout of the simulators, the flash in the layout of the unit tests).
+ *			To place the partition in the second storage module, the rest of the first one is occupied by another partition.
+ */
+static ret_code_t setup_partition(uint16_t* partition_id, uint8_t medium, uint8_t is_dynamic, uint8_t enable_crc) {
+	ret_code_t ret = filesystem_init();
+	if(ret != NRF_SUCCESS) return ret;
+	ret = filesystem_clear();
+	if(ret != NRF_SUCCESS) return ret;
+
+	// The flash has units of a page, the EEPROM units of a byte
+	uint32_t start_unit_address, end_unit_address;
+	ret = storage_get_unit_address_limits(0, 1, &start_unit_address, &end_unit_address);
+	if(ret != NRF_SUCCESS) return ret;
+	uint8_t first_medium = (end_unit_address > start_unit_address) ? MEDIUM_FLASH : MEDIUM_EEPROM;
+	
+	if(medium != first_medium) {
+		uint32_t used_size = storage_get_size() - filesystem_get_available_size();
+		uint32_t required_size = ((first_medium == MEDIUM_FLASH) ? storage1_get_size() : storage2_get_size()) - used_size;
+		uint16_t filler_partition_id;
+		ret = filesystem_register_partition(&filler_partition_id, &required_size, 0, 0, 4);
+		if(ret != NRF_SUCCESS) return ret;
+	}
+
+	uint32_t required_size = PARTITION_METADATA_SIZE + FILESYSTEM_PARTITION_ELEMENTS * (FILESYSTEM_ELEMENT_LEN + FILESYSTEM_MAX_HEADER_LEN);
+	return filesystem_register_partition(partition_id, &required_size, is_dynamic, enable_crc, FILESYSTEM_ELEMENT_LEN);
+}
+
+static void BM_FilesystemStoreElement(PerfState& state) {
+	uint16_t partition_id;
+	if(setup_partition(&partition_id, (uint8_t) state.range(0), (uint8_t) state.range(1), (uint8_t) state.range(2)) != NRF_SUCCESS) {
+		state.SkipWithError("Partition setup failed");
+		return;
+	}
+	uint8_t element[FILESYSTEM_ELEMENT_LEN];
+	memset(element, 0xA5, sizeof(element));
+
+	uint32_t i = 0;
+	while(state.KeepRunning()) {
+		element[0] = (uint8_t) i++;
+		if(filesystem_store_element(partition_id, element, FILESYSTEM_ELEMENT_LEN) != NRF_SUCCESS) {
+			state.SkipWithError("Store failed");
+			break;
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+	state.SetBytesProcessed(state.iterations() * FILESYSTEM_ELEMENT_LEN);
+}
+PERF_BENCHMARK(BM_FilesystemStoreElement)->ArgNames({"eeprom", "dynamic", "crc"})
+	->Args({MEDIUM_FLASH, 0, 0})->Args({MEDIUM_FLASH, 0, 1})->Args({MEDIUM_FLASH, 1, 0})->Args({MEDIUM_FLASH, 1, 1})
+	->Args({MEDIUM_EEPROM, 0, 0})->Args({MEDIUM_EEPROM, 0, 1})->Args({MEDIUM_EEPROM, 1, 0})->Args({MEDIUM_EEPROM, 1, 1});
+
+
+/**@brief Benchmark of reading all elements of a partition with the iterator (from the latest to the oldest element).
+ */
+static void BM_FilesystemIteratorRead(PerfState& state) {
+	uint16_t partition_id;
+	if(setup_partition(&partition_id, (uint8_t) state.range(0), (uint8_t) state.range(1), 1) != NRF_SUCCESS) {
+		state.SkipWithError("Partition setup failed");
+		return;
+	}
+	uint8_t element[FILESYSTEM_ELEMENT_LEN];
+	memset(element, 0xA5, sizeof(element));
+	uint32_t fill = (uint32_t) state.range(2);
+	for(uint32_t i = 0; i < fill; i++) {
+		if(filesystem_store_element(partition_id, element, FILESYSTEM_ELEMENT_LEN) != NRF_SUCCESS) {
+			state.SkipWithError("Filling the partition failed");
+			return;
+		}
+	}
+
+	uint32_t read_elements = 0;
+	while(state.KeepRunning()) {
+		ret_code_t ret = filesystem_iterator_init(partition_id);
+		while(ret == NRF_SUCCESS) {
+			uint16_t element_len, record_id;
+			ret = filesystem_iterator_read_element(partition_id, element, sizeof(element), &element_len, &record_id);
+			if(ret != NRF_SUCCESS)
+				break;
+			read_elements++;
+			ret = filesystem_iterator_previous(partition_id);
+		}
+		filesystem_iterator_invalidate(partition_id);
+		if(ret != NRF_ERROR_NOT_FOUND) {
+			state.SkipWithError("Iterator read failed");
+			break;
+		}
+	}
+	if(read_elements != state.iterations() * fill)
+		state.SkipWithError("Not all elements were read");
+	state.SetItemsProcessed(read_elements);
+	state.SetBytesProcessed(((int64_t) read_elements) * FILESYSTEM_ELEMENT_LEN);
+}
+PERF_BENCHMARK(BM_FilesystemIteratorRead)->ArgNames({"eeprom", "dynamic", "fill"})
+	->Args({MEDIUM_FLASH, 0, 16})->Args({MEDIUM_FLASH, 0, 128})->Args({MEDIUM_FLASH, 0, FILESYSTEM_PARTITION_ELEMENTS})
+	->Args({MEDIUM_FLASH, 1, 16})->Args({MEDIUM_FLASH, 1, 128})->Args({MEDIUM_FLASH, 1, FILESYSTEM_PARTITION_ELEMENTS})
+	->Args({MEDIUM_EEPROM, 0, 16})->Args({MEDIUM_EEPROM, 0, 128})->Args({MEDIUM_EEPROM, 0, FILESYSTEM_PARTITION_ELEMENTS})
+	->Args({MEDIUM_EEPROM, 1, 16})->Args({MEDIUM_EEPROM, 1, 128})->Args({MEDIUM_EEPROM, 1, FILESYSTEM_PARTITION_ELEMENTS});
+
+
+
+/**@brief Function to store number chunks with consecutive timestamps (starting at 1000 seconds) in a chunk partition of the storer.
+ */
+static ret_code_t store_chunks(storer_chunk_partition_t partition, uint32_t number) {
+	static ScanChunk scan_chunk;
+	static MicrophoneChunk microphone_chunk;
+	BatteryChunk battery_chunk;
+	memset(&scan_chunk, 0, sizeof(scan_chunk));
+	memset(&microphone_chunk, 0, sizeof(microphone_chunk));
+	memset(&battery_chunk, 0, sizeof(battery_chunk));
+	scan_chunk.scan_result_data_count = 10;
+	microphone_chunk.microphone_data_count = 114;
+
+	ret_code_t ret = NRF_SUCCESS;
+	for(uint32_t i = 0; i < number && ret == NRF_SUCCESS; i++) {
+		Timestamp timestamp = {1000 + i, 0};
+		if(partition == STORER_CHUNK_PARTITION_BATTERY) {
+			battery_chunk.timestamp = timestamp;
+			ret = storer_store_battery_chunk(&battery_chunk);
+		} else if(partition == STORER_CHUNK_PARTITION_SCAN) {
+			scan_chunk.timestamp = timestamp;
+			ret = storer_store_scan_chunk(&scan_chunk);
+		} else {
+			microphone_chunk.timestamp = timestamp;
+			ret = storer_store_microphone_chunk(&microphone_chunk);
+		}
+	}
+	return ret;
+}
+
+/**@brief Benchmark of storer_find_..._chunk_from_timestamp() for a chunk that is depth chunks older than the latest one.
+ */
+static void BM_StorerFindFromTimestamp(PerfState& state) {
+	storer_chunk_partition_t partition = (storer_chunk_partition_t) state.range(0);
+	uint32_t depth = (uint32_t) state.range(1);
+	if(storer_init() != NRF_SUCCESS || storer_clear() != NRF_SUCCESS || store_chunks(partition, depth + 1) != NRF_SUCCESS) {
+		state.SkipWithError("Storer setup failed");
+		return;
+	}
+	Timestamp timestamp = {1000, 0};	// The oldest stored chunk
+	state.SetLabel((partition == STORER_CHUNK_PARTITION_BATTERY) ? "battery" : (partition == STORER_CHUNK_PARTITION_SCAN) ? "scan" : "microphone");
+
+	while(state.KeepRunning()) {
+		ret_code_t ret;
+		if(partition == STORER_CHUNK_PARTITION_BATTERY)
+			ret = storer_find_battery_chunk_from_timestamp(timestamp);
+		else if(partition == STORER_CHUNK_PARTITION_SCAN)
+			ret = storer_find_scan_chunk_from_timestamp(timestamp);
+		else
+			ret = storer_find_microphone_chunk_from_timestamp(timestamp);
+		storer_invalidate_iterators();
+		if(ret != NRF_SUCCESS) {
+			state.SkipWithError("Find failed");
+			break;
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+PERF_BENCHMARK(BM_StorerFindFromTimestamp)->ArgNames({"partition", "depth"})
+	->Args({STORER_CHUNK_PARTITION_BATTERY, 1})->Args({STORER_CHUNK_PARTITION_BATTERY, STORER_BATTERY_DATA_NUMBER - 2})
+	->Args({STORER_CHUNK_PARTITION_SCAN, 1})->Args({STORER_CHUNK_PARTITION_SCAN, 64})->Args({STORER_CHUNK_PARTITION_SCAN, 512})
+	->Args({STORER_CHUNK_PARTITION_MICROPHONE, 1})->Args({STORER_CHUNK_PARTITION_MICROPHONE, 64})->Args({STORER_CHUNK_PARTITION_MICROPHONE, 512});
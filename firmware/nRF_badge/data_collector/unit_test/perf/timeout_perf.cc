@@ -0,0 +1,75 @@
+/**@file
+ * @details	Benchmarks of the timeout-module: the lazy timeout_reset() and the timeout_start() with re-sorting of the heap.
+ */
+
+#include "perf_lib.h"
+#include "timeout_lib.h"
+
+
+extern ret_code_t perf_init_sampling(void);	/**< In processing_perf.cc (the timeout-module must only be initialized once) */
+
+
+static uint32_t timeout_ids[MAX_NUMBER_OF_TIMEOUTS];
+static uint32_t number_of_timeout_ids = 0;
+
+static void perf_timeout_handler(void) {
+}
+
+/**@brief Function to register all remaining timeouts (like the sampling-module does for every sensor) and to start them.
+ *
+ * @details	The deadlines are far in the future, so no timeout expires during the benchmark.
+ */
+static ret_code_t start_timeouts(void) {
+	ret_code_t ret = perf_init_sampling();
+	if(ret != NRF_SUCCESS)
+		return ret;
+	while(number_of_timeout_ids < MAX_NUMBER_OF_TIMEOUTS && timeout_register(&timeout_ids[number_of_timeout_ids], perf_timeout_handler) == NRF_SUCCESS)
+		number_of_timeout_ids++;
+	if(number_of_timeout_ids == 0)
+		return NRF_ERROR_NO_MEM;
+	for(uint32_t i = 0; i < number_of_timeout_ids; i++)
+		timeout_start(timeout_ids[i], 10000 + i*1000);
+	return NRF_SUCCESS;
+}
+
+static void stop_timeouts(void) {
+	for(uint32_t i = 0; i < number_of_timeout_ids; i++)
+		timeout_stop(timeout_ids[i]);
+}
+
+/**@brief Benchmark of timeout_reset() with all timeouts active (the reset only updates the deadline, the timer is not re-armed).
+ */
+static void BM_TimeoutReset(PerfState& state) {
+	if(start_timeouts() != NRF_SUCCESS) {
+		state.SkipWithError("Timeout setup failed");
+		return;
+	}
+	uint32_t i = 0;
+	while(state.KeepRunning()) {
+		timeout_reset(timeout_ids[i]);
+		i = (i + 1) % number_of_timeout_ids;
+	}
+	stop_timeouts();
+	state.SetItemsProcessed(state.iterations());
+	state.SetLabel(std::to_string(number_of_timeout_ids) + " timeouts");
+}
+PERF_BENCHMARK(BM_TimeoutReset);
+
+
+/**@brief Benchmark of timeout_start() of an active timeout with a changing timeout (the timeout is moved in the heap).
+ */
+static void BM_TimeoutStart(PerfState& state) {
+	if(start_timeouts() != NRF_SUCCESS) {
+		state.SkipWithError("Timeout setup failed");
+		return;
+	}
+	uint32_t i = 0;
+	while(state.KeepRunning()) {
+		timeout_start(timeout_ids[i % number_of_timeout_ids], 10000 + (i % 7)*1000);
+		i++;
+	}
+	stop_timeouts();
+	state.SetItemsProcessed(state.iterations());
+	state.SetLabel(std::to_string(number_of_timeout_ids) + " timeouts");
+}
+PERF_BENCHMARK(BM_TimeoutStart);
@@ -0,0 +1,96 @@
+/**@file
+ * @details	Benchmarks of the tinybuf encoding and decoding of the messages the badge exchanges with the hub and stores in the filesystem.
+ *			Every message is filled (see tinybuf/tests/message_filler.h) and coded with the table interpreter (tb_encode()/tb_decode(), used by the firmware)
+ *			and with the straight-line functions, in the endianness the firmware uses for it (protocol: big endian, chunks: little endian).
+ */
+
+#include <string.h>
+#include <vector>
+
+#include "perf_lib.h"
+#include "tinybuf.h"
+#include "protocol_messages_02v1.h"
+#include "chunk_messages.h"
+#include "../../tinybuf/tests/message_filler.h"
+
+
+#define MAX_ENCODED_LEN		4096
+
+typedef uint8_t (*encode_function_t)(tb_ostream_t* ostream, const void* src, tb_endian_t endianness);
+typedef uint8_t (*decode_function_t)(tb_istream_t* istream, void* dst, tb_endian_t endianness);
+
+typedef struct {
+	const char* name;
+	const tb_field_t* fields;
+	uint32_t struct_size;
+	encode_function_t encode;
+	decode_function_t decode;
+	tb_endian_t endianness;
+} perf_message_t;
+
+#define PERF_MESSAGE(M, ENDIANNESS)	{#M, M##_fields, sizeof(M), (encode_function_t) M##_encode, (decode_function_t) M##_decode, ENDIANNESS}
+
+static const perf_message_t messages[] = {
+	PERF_MESSAGE(Request, TB_BIG_ENDIAN),
+	PERF_MESSAGE(Response, TB_BIG_ENDIAN),
+	PERF_MESSAGE(StatusResponse, TB_BIG_ENDIAN),
+	PERF_MESSAGE(MicrophoneDataResponse, TB_BIG_ENDIAN),
+	PERF_MESSAGE(ScanDataResponse, TB_BIG_ENDIAN),
+	PERF_MESSAGE(AccelerometerDataResponse, TB_BIG_ENDIAN),
+	PERF_MESSAGE(BatteryDataResponse, TB_BIG_ENDIAN),
+	PERF_MESSAGE(BatteryChunk, TB_LITTLE_ENDIAN),
+	PERF_MESSAGE(MicrophoneChunk, TB_LITTLE_ENDIAN),
+	PERF_MESSAGE(ScanChunk, TB_LITTLE_ENDIAN),
+	PERF_MESSAGE(AccelerometerChunk, TB_LITTLE_ENDIAN),
+	PERF_MESSAGE(AccelerometerInterruptChunk, TB_LITTLE_ENDIAN),
+	PERF_MESSAGE(DownloadCursorTable, TB_LITTLE_ENDIAN),
+};
+
+
+/**@brief Benchmark of encoding or decoding a message (state.range(0): 1 for the straight-line functions, 0 for the table interpreter).
+ */
+static void run_codec(PerfState& state, const perf_message_t* message, uint8_t decode) {
+	uint8_t straight_line = (uint8_t) state.range(0);
+	std::vector<uint8_t> message_struct(message->struct_size), decoded_struct(message->struct_size), encoded(MAX_ENCODED_LEN);
+	uint32_t seed = 0x12345678;
+	fill_message(message->fields, message_struct.data(), &seed, -1);
+	tb_ostream_t ostream = tb_ostream_from_buffer(encoded.data(), encoded.size());
+	if(!tb_encode(&ostream, message->fields, message_struct.data(), message->endianness)) {
+		state.SkipWithError("Encoding failed");
+		return;
+	}
+	uint32_t len = ostream.bytes_written;
+
+	while(state.KeepRunning()) {
+		uint8_t ok;
+		if(decode) {
+			tb_istream_t istream = tb_istream_from_buffer(encoded.data(), len);
+			ok = straight_line ? message->decode(&istream, decoded_struct.data(), message->endianness) : tb_decode(&istream, message->fields, decoded_struct.data(), message->endianness);
+		} else {
+			ostream = tb_ostream_from_buffer(encoded.data(), encoded.size());
+			ok = straight_line ? message->encode(&ostream, message_struct.data(), message->endianness) : tb_encode(&ostream, message->fields, message_struct.data(), message->endianness);
+		}
+		if(!ok) {
+			state.SkipWithError("Coding failed");
+			break;
+		}
+		perf_do_not_optimize(decoded_struct.data());
+		perf_do_not_optimize(encoded.data());
+	}
+	state.SetItemsProcessed(state.iterations());
+	state.SetBytesProcessed(state.iterations() * len);
+}
+
+/**@brief Function to register the benchmarks of all messages (called during the static initialization).
+ */
+static uint8_t register_tinybuf_benchmarks(void) {
+	for(uint32_t i = 0; i < sizeof(messages)/sizeof(messages[0]); i++) {
+		const perf_message_t* message = &messages[i];
+		perf_register(std::string("BM_TinybufEncode/") + message->name, [message](PerfState& state) { run_codec(state, message, 0); })
+			->ArgNames({"straight_line"})->Arg(0)->Arg(1);
+		perf_register(std::string("BM_TinybufDecode/") + message->name, [message](PerfState& state) { run_codec(state, message, 1); })
+			->ArgNames({"straight_line"})->Arg(0)->Arg(1);
+	}
+	return 1;
+}
+static uint8_t tinybuf_benchmarks_registered __attribute__((unused)) = register_tinybuf_benchmarks();
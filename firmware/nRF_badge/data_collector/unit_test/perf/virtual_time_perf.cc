@@ -0,0 +1,91 @@
+/**@file
+ * @details	Benchmarks of the virtual-time mode of the timer mock (the perf suite runs in virtual time, see perf_lib.cc):
+ *			the wall-clock time per virtual hour of the timer processing and of a battery sampling scenario with the storage model.
+ */
+
+#include <stdio.h>
+
+#include "perf_lib.h"
+#include "timer_lib.h"
+#include "app_scheduler.h"
+#include "sampling_lib.h"
+#include "storer_lib.h"
+#include "storage_model_lib.h"
+
+
+#define SECONDS_TO_MICROSECONDS(s)	(((uint64_t) (s)) * 1000 * 1000)
+
+#define BATTERY_PERIOD_MS			(60*1000)
+
+extern ret_code_t perf_init_sampling(void);	/**< In processing_perf.cc */
+
+
+static uint32_t timer_count = 0;
+
+static void count_timer_handler(void* p_context) {
+	timer_count++;
+}
+
+/**@brief Benchmark of one virtual hour with a 1 s and a 7 s repeated timer (the time jumps from expiration to expiration).
+ */
+static void BM_VirtualTimeTimers(PerfState& state) {
+	static uint32_t fast_timer_id, slow_timer_id;
+	static uint8_t timers_created = 0;
+	timer_init();
+	if(!timers_created) {
+		if(timer_create_timer(&fast_timer_id, TIMER_MODE_REPEATED, count_timer_handler, 0) != 1 || timer_create_timer(&slow_timer_id, TIMER_MODE_REPEATED, count_timer_handler, 0) != 1) {
+			state.SkipWithError("Timer creation failed");
+			return;
+		}
+		timers_created = 1;
+	}
+	timer_count = 0;
+	timer_start_timer(fast_timer_id, SECONDS_TO_MICROSECONDS(1), NULL);
+	timer_start_timer(slow_timer_id, SECONDS_TO_MICROSECONDS(7), NULL);
+
+	while(state.KeepRunning()) {
+		timer_virtual_run_for(SECONDS_TO_MICROSECONDS(3600), NULL);
+	}
+	timer_stop_timer(fast_timer_id);
+	timer_stop_timer(slow_timer_id);
+	state.SetItemsProcessed(timer_count);	// The timer expirations
+}
+PERF_BENCHMARK(BM_VirtualTimeTimers);
+
+
+/**@brief Benchmark of one virtual hour of battery sampling and storing (with the modeled storage latency).
+ *
+ * @details	The items are the virtual hours, the label reports the modeled storage work per virtual hour.
+ */
+static void BM_VirtualTimeBatteryScenario(PerfState& state) {
+	if(perf_init_sampling() != NRF_SUCCESS || storer_init() != NRF_SUCCESS || storer_clear() != NRF_SUCCESS) {
+		state.SkipWithError("Sampling setup failed");
+		return;
+	}
+	storage_model_enable_latency(1);
+	storage_model_reset_statistics();
+	if(sampling_start_battery(0, BATTERY_PERIOD_MS, 0) != NRF_SUCCESS) {
+		storage_model_enable_latency(0);
+		state.SkipWithError("Battery sampling failed");
+		return;
+	}
+
+	while(state.KeepRunning()) {
+		timer_virtual_run_for(SECONDS_TO_MICROSECONDS(3600), app_sched_execute);
+	}
+	sampling_stop_battery(0);
+	timer_virtual_run_for(SECONDS_TO_MICROSECONDS(1), app_sched_execute);
+
+	storage_model_statistics_t statistics;
+	storage_model_get_statistics(&statistics);
+	storage_model_enable_latency(0);
+
+	uint64_t hours = (state.iterations() > 0) ? state.iterations() : 1;
+	char label[128];
+	snprintf(label, sizeof(label), "per hour: %.1f page erases, %.1f EEPROM write cycles, %.1f ms busy, %.3f uAh",
+			statistics.flash_page_erases / (double) hours, statistics.eeprom_write_cycles / (double) hours,
+			(statistics.flash_busy_us + statistics.eeprom_busy_us) / (1000.0 * hours), statistics.charge_uah / hours);
+	state.SetLabel(label);
+	state.SetItemsProcessed(state.iterations());
+}
+PERF_BENCHMARK(BM_VirtualTimeBatteryScenario);
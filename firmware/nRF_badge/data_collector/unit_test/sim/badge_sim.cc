@@ -0,0 +1,372 @@
+/**@file
+ * @details Host-side simulator of a whole badge: the firmware libraries (request handler, storer, sampling, sender, ...)
+ *			run on the mocks in virtual-time mode, and the Nordic Uart Service is exposed over a local socket.
+ *			A client (e.g. BadgeFramework's SocketBadgeConnection) connects to the socket like a hub to the badge:
+ *			the bytes of the client are the writes to the RX-characteristic, and the notifications of the badge are sent back.
+ *
+ *			The virtual time is paced to the wall-clock (multiplied with the speed factor), so timeouts and
+ *			sampling-rates behave like on the real badge. The link is limited like in the BLE-mock: the client's
+ *			bytes are received in writes of up to 20 bytes once per connection interval, and the notifications
+ *			are sent at the connection events.
+ *
+ *			Usage: run_badge_sim [--port PORT | --unix PATH] [--speed FACTOR] [--trace FILE] [--quiet]
+ *				--port PORT		Listen on 127.0.0.1:PORT (default: BADGE_SIM_DEFAULT_PORT).
+ *				--unix PATH		Listen on a UNIX domain socket instead.
+ *				--speed FACTOR	Virtual seconds per wall-clock second (default: 1, the real time).
+ *				--trace FILE	Dump the trace-records at exit (open it with chrome://tracing or https://ui.perfetto.dev).
+ *				--quiet			Suppress the debug-log of the firmware.
+ *			The statistics of each connection are printed to stderr.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <string>
+
+#include "timer_lib.h"
+#include "app_timer.h"
+#include "app_scheduler.h"
+#include "systick_lib.h"
+#include "timeout_lib.h"
+#include "ble_lib.h"
+#include "advertiser_lib.h"
+#include "request_handler_lib_02v1.h"
+#include "storer_lib.h"
+#include "sampling_lib.h"
+#include "debug_lib.h"
+#include "trace_lib.h"
+
+/** Include some (private) functions of the BLE-mock */
+extern void ble_simulate_connect(void);
+extern void ble_simulate_receive(uint8_t* data, uint16_t len);
+extern void ble_simulate_set_connection_event_handler(void (*connection_event_handler)(void));
+extern uint32_t ble_transmit_fifo_get_size(void);
+extern ret_code_t ble_transmit_fifo_read(uint8_t* data, uint32_t len);
+
+
+#define BADGE_SIM_DEFAULT_PORT			5455
+#define BADGE_SIM_CONNECTION_INTERVAL_MS	10		/**< Same connection interval as in the BLE-mock: one write of the client per connection event */
+#define BADGE_SIM_MAX_WRITE_LEN			20		/**< Maximal number of bytes of a write to the RX-characteristic */
+#define BADGE_SIM_POLL_TIMEOUT_MS		1		/**< Maximal wall-clock time between two simulation steps */
+
+
+typedef struct {
+	uint64_t	start_wall_us;
+	uint64_t	start_virtual_us;
+	uint64_t	received_bytes;		/**< Bytes from the client to the badge */
+	uint64_t	transmitted_bytes;	/**< Bytes from the badge to the client */
+} connection_stats_t;
+
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static int listen_fd = -1;
+static int client_fd = -1;
+static std::string rx_buf;		/**< Bytes of the client, that were not received by the badge yet */
+static std::string tx_buf;		/**< Notifications of the badge, that were not sent to the client yet */
+static uint64_t next_write_virtual_us = 0;
+static connection_stats_t stats;
+
+
+static void on_signal(int signal) {
+	(void) signal;
+	stop_requested = 1;
+}
+
+static uint64_t get_wall_microseconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t) ts.tv_sec)*1000000 + ((uint64_t) ts.tv_nsec)/1000;
+}
+
+static void set_non_blocking(int fd) {
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+
+/**@brief Function to create the listening socket.
+ *
+ * @retval	0 on success, -1 otherwise (with an error message).
+ */
+static int open_listen_socket(uint16_t port, const char* unix_path) {
+	if(unix_path != NULL) {
+		struct sockaddr_un addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		if(strlen(unix_path) >= sizeof(addr.sun_path)) {
+			fprintf(stderr, "UNIX socket path too long: %s\n", unix_path);
+			return -1;
+		}
+		strcpy(addr.sun_path, unix_path);
+		unlink(unix_path);
+		listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if(listen_fd < 0 || bind(listen_fd, (struct sockaddr*) &addr, sizeof(addr)) != 0) {
+			perror("bind");
+			return -1;
+		}
+	} else {
+		struct sockaddr_in addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(port);
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+		int reuse = 1;
+		if(listen_fd >= 0)
+			setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+		if(listen_fd < 0 || bind(listen_fd, (struct sockaddr*) &addr, sizeof(addr)) != 0) {
+			perror("bind");
+			return -1;
+		}
+	}
+	if(listen(listen_fd, 1) != 0) {
+		perror("listen");
+		return -1;
+	}
+	set_non_blocking(listen_fd);
+	return 0;
+}
+
+
+static void print_connection_stats(void) {
+	double wall_s = (get_wall_microseconds() - stats.start_wall_us) / 1e6;
+	double virtual_s = (timer_get_microseconds_since_start() - stats.start_virtual_us) / 1e6;
+	fprintf(stderr, "BADGE_SIM: Connection closed after %.3f s (virtual %.3f s): received %llu bytes, transmitted %llu bytes (%.0f bytes/s virtual)\n",
+			wall_s, virtual_s, (unsigned long long) stats.received_bytes, (unsigned long long) stats.transmitted_bytes,
+			(virtual_s > 0) ? stats.transmitted_bytes / virtual_s : 0);
+}
+
+static void accept_client(void) {
+	int fd = accept(listen_fd, NULL, NULL);
+	if(fd < 0)
+		return;
+	if(client_fd >= 0) {	// The badge only accepts one connection at a time
+		close(fd);
+		return;
+	}
+	client_fd = fd;
+	set_non_blocking(client_fd);
+	int no_delay = 1;
+	setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));	// Fails harmlessly on UNIX sockets
+
+	rx_buf.clear();
+	tx_buf.clear();
+	memset(&stats, 0, sizeof(stats));
+	stats.start_wall_us = get_wall_microseconds();
+	stats.start_virtual_us = timer_get_microseconds_since_start();
+	next_write_virtual_us = stats.start_virtual_us;
+	fprintf(stderr, "BADGE_SIM: Client connected\n");
+
+	ble_simulate_connect();
+}
+
+/**@brief Function to close the connection to the client. If the client closed it, the badge is disconnected too.
+ */
+static void close_client(uint8_t disconnect_badge) {
+	if(client_fd < 0)
+		return;
+	close(client_fd);
+	client_fd = -1;
+	rx_buf.clear();
+	tx_buf.clear();
+	if(disconnect_badge && ble_get_state() == BLE_STATE_CONNECTED)
+		ble_disconnect();
+	print_connection_stats();
+}
+
+/**@brief Function to exchange the buffered bytes with the client (non-blocking).
+ */
+static void serve_client(void) {
+	struct pollfd fds[2];
+	fds[0].fd = listen_fd;
+	fds[0].events = POLLIN;
+	fds[1].fd = client_fd;
+	fds[1].events = POLLIN | (tx_buf.empty() ? 0 : POLLOUT);
+	uint32_t number_of_fds = (client_fd >= 0) ? 2 : 1;
+	if(poll(fds, number_of_fds, BADGE_SIM_POLL_TIMEOUT_MS) <= 0)
+		return;
+
+	if(fds[0].revents & POLLIN)
+		accept_client();
+	if(number_of_fds < 2)
+		return;
+
+	if(fds[1].revents & POLLIN) {
+		char buf[4096];
+		ssize_t len = recv(client_fd, buf, sizeof(buf), 0);
+		if(len == 0 || (len < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+			close_client(1);
+			return;
+		}
+		if(len > 0)
+			rx_buf.append(buf, (size_t) len);
+	}
+	if(!tx_buf.empty() && (fds[1].revents & POLLOUT)) {
+		ssize_t len = send(client_fd, tx_buf.data(), tx_buf.size(), MSG_NOSIGNAL);
+		if(len < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+			close_client(1);
+			return;
+		}
+		if(len > 0)
+			tx_buf.erase(0, (size_t) len);
+	}
+}
+
+/**@brief Function to collect the notifications, that were sent by the BLE-mock at a connection event.
+ *
+ * @details	Called by the BLE-mock at each connection event, so the transmit-fifo never fills up,
+ *			even if the firmware keeps the scheduler busy while it sends (e.g. during a bulk export).
+ */
+static void collect_transmitted_bytes(void) {
+	uint8_t data[256];
+	uint32_t len = ble_transmit_fifo_get_size();
+	while(len > 0) {
+		uint32_t read_len = (len > sizeof(data)) ? sizeof(data) : len;
+		if(ble_transmit_fifo_read(data, read_len) != NRF_SUCCESS)
+			break;
+		if(client_fd >= 0) {
+			tx_buf.append((const char*) data, read_len);
+			stats.transmitted_bytes += read_len;
+		}
+		len -= read_len;
+	}
+}
+
+/**@brief Function to run the firmware until the virtual time reaches target_virtual_us.
+ *
+ * @details	The pending bytes of the client are received in writes of up to BADGE_SIM_MAX_WRITE_LEN bytes,
+ *			one write per connection interval.
+ */
+static void run_until(uint64_t target_virtual_us) {
+	uint64_t now = timer_get_microseconds_since_start();
+	while(now < target_virtual_us) {
+		uint64_t step_end = target_virtual_us;
+		if(client_fd >= 0 && !rx_buf.empty()) {
+			if(now >= next_write_virtual_us) {
+				uint16_t len = (rx_buf.size() > BADGE_SIM_MAX_WRITE_LEN) ? BADGE_SIM_MAX_WRITE_LEN : (uint16_t) rx_buf.size();
+				ble_simulate_receive((uint8_t*) rx_buf.data(), len);
+				rx_buf.erase(0, len);
+				stats.received_bytes += len;
+				next_write_virtual_us = now + ((uint64_t) BADGE_SIM_CONNECTION_INTERVAL_MS)*1000;
+			}
+			if(!rx_buf.empty() && next_write_virtual_us < step_end)
+				step_end = next_write_virtual_us;
+		}
+		timer_virtual_run_for(step_end - now, app_sched_execute);
+		now = timer_get_microseconds_since_start();
+	}
+}
+
+
+static ret_code_t init_badge(void) {
+	ret_code_t ret;
+
+	timer_enable_virtual_time(1);
+	APP_SCHED_INIT(4, 100);
+	APP_TIMER_INIT(0, 60, NULL);
+
+	debug_init();
+	trace_init();
+
+	ret = systick_init(0);
+	if(ret != NRF_SUCCESS) return ret;
+
+	ret = timeout_init();
+	if(ret != NRF_SUCCESS) return ret;
+
+	ret = ble_init();
+	if(ret != NRF_SUCCESS) return ret;
+	ble_simulate_set_connection_event_handler(collect_transmitted_bytes);
+
+	ret = sampling_init();
+	if(ret != NRF_SUCCESS) return ret;
+
+	ret = storer_init();
+	if(ret != NRF_SUCCESS) return ret;
+
+	advertiser_init();
+
+	ret = advertiser_start_advertising();
+	if(ret != NRF_SUCCESS) return ret;
+
+	return request_handler_init();
+}
+
+
+int main(int argc, char** argv) {
+	uint16_t port = BADGE_SIM_DEFAULT_PORT;
+	const char* unix_path = NULL;
+	const char* trace_file = NULL;
+	double speed = 1;
+	for(int i = 1; i < argc; i++) {
+		if(strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+			port = (uint16_t) atoi(argv[++i]);
+		} else if(strcmp(argv[i], "--unix") == 0 && i + 1 < argc) {
+			unix_path = argv[++i];
+		} else if(strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+			speed = atof(argv[++i]);
+		} else if(strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+			trace_file = argv[++i];
+		} else if(strcmp(argv[i], "--quiet") == 0) {
+			if(freopen("/dev/null", "w", stdout) == NULL)
+				return 1;
+		} else {
+			fprintf(stderr, "Usage: %s [--port PORT | --unix PATH] [--speed FACTOR] [--trace FILE] [--quiet]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(speed <= 0) {
+		fprintf(stderr, "The speed factor has to be positive\n");
+		return 1;
+	}
+
+	ret_code_t ret = init_badge();
+	if(ret != NRF_SUCCESS) {
+		fprintf(stderr, "BADGE_SIM: Initialization failed: %u\n", (unsigned) ret);
+		return 1;
+	}
+
+	if(open_listen_socket(port, unix_path) != 0)
+		return 1;
+	if(unix_path != NULL)
+		fprintf(stderr, "BADGE_SIM: Listening on %s\n", unix_path);
+	else
+		fprintf(stderr, "BADGE_SIM: Listening on 127.0.0.1:%u\n", port);
+
+	signal(SIGINT, on_signal);
+	signal(SIGTERM, on_signal);
+
+	uint64_t start_wall_us = get_wall_microseconds();
+	uint64_t start_virtual_us = timer_get_microseconds_since_start();
+	while(!stop_requested) {
+		serve_client();
+		run_until(start_virtual_us + (uint64_t) ((get_wall_microseconds() - start_wall_us) * speed));
+		// The badge closed the connection (e.g. after an invalid request): send the remaining notifications and close the socket
+		if(client_fd >= 0 && ble_get_state() != BLE_STATE_CONNECTED) {
+			if(!tx_buf.empty()) {
+				fcntl(client_fd, F_SETFL, fcntl(client_fd, F_GETFL, 0) & ~O_NONBLOCK);
+				send(client_fd, tx_buf.data(), tx_buf.size(), MSG_NOSIGNAL);
+			}
+			close_client(0);
+		}
+	}
+
+	close_client(1);
+	close(listen_fd);
+	if(unix_path != NULL)
+		unlink(unix_path);
+	if(trace_file != NULL && trace_dump_chrome_json(trace_file) != NRF_SUCCESS)
+		fprintf(stderr, "BADGE_SIM: Could not write the trace to %s\n", trace_file);
+	return 0;
+}
@@ -0,0 +1,836 @@
+/**@file
+ * @details Power-loss campaign for the filesystem: how much work the recovery of storer_init() is, and how much data is lost,
+ *			when the battery is pulled at a random byte of a random store or erase.
+ *
+ *			The badge runs storer operations: battery-, scan- and microphone-chunks, the download cursors of two hubs and
+ *			badge assignements, in a pseudo-random order and with pseudo-random content (a deterministic function of the seed
+ *			and the index). After a prefill, the power breaks down in windows of operations that are spread over the partitions
+ *			(while they wrap around, and in the EEPROM as well as in the flash). For every window a reference process runs the
+ *			window without power loss and reports the write operations of the storage mocks and the range of the stored chunks
+ *			after every operation.
+ *
+ *			Every trial runs a window in its own forked process, with the power loss at a uniformly chosen write operation
+ *			of the window and a uniformly chosen byte of it (see power_loss_lib.h). After the reboot storer_init() recovers
+ *			the filesystem, and the trial measures:
+ *				- the recovery work: storage read operations and bytes, write operations, the modeled storage time
+ *				  (see storage_model_lib.h) and the host time of storer_init(),
+ *				- lost chunks: chunks that were stored before the interrupted operation, and that the reference still keeps after
+ *				  the interrupted operation, but that can't be read anymore,
+ *				- unknown chunks (never stored or already overwritten in the reference) and corrupted chunks (content differs),
+ *				- the download cursors and the badge assignement (the last stored ones, or the ones of the interrupted operation),
+ *				- whether new chunks can be stored and read again.
+ *
+ *			Usage: run_power_loss_sim [--trials N] [--prefill OPERATIONS] [--windows N] [--window OPERATIONS] [--spacing OPERATIONS] [--seed SEED] [--jobs J] [--cut WINDOW,OPERATION,BYTE]
+ *				--trials	Number of power losses, distributed over the windows (default: 400).
+ *				--prefill	Storer operations before the first window (default: 2000).
+ *				--windows	Number of windows (default: 8).
+ *				--window	Storer operations per window (default: 100, at most SIM_MAX_WINDOW).
+ *				--spacing	Storer operations from the start of a window to the start of the next one (default: 1000).
+ *				--jobs		Maximal number of processes at the same time (default: number of CPUs).
+ *				--cut		Only run the trial with the power loss in the write operation OPERATION of the window WINDOW after BYTE bytes,
+ *							and print its details (the failed and lossy trials of a campaign are listed with this option).
+ *
+ *			The exit code is 1 if the recovery failed, crashed or hung, or if a partition is not usable afterwards.
+ *			Lost, unknown and corrupted data are only reported.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <algorithm>
+#include <vector>
+
+#include "timer_lib.h"
+#include "storer_lib.h"
+#include "chunk_messages.h"
+#include "tinybuf.h"
+#include "power_loss_lib.h"
+#include "storage_model_lib.h"
+#include "sim_lib.h"
+
+
+#define SIM_MAX_WINDOW				1000
+#define SIM_CHUNK_KINDS				3			/**< Battery, scan and microphone chunks */
+#define SIM_HUBS					2			/**< Number of hubs that store download cursors */
+#define SIM_SEQ_BASE				1000000		/**< The timestamp-seconds of a chunk are SIM_SEQ_BASE + its sequence number */
+#define SIM_TRIAL_TIMEOUT_S			10			/**< A trial that takes longer is reported as hanging recovery */
+#define SIM_MAX_LISTED_TRIALS		10			/**< Failed and lossy trials that are listed (each) */
+#define SIM_ENCODED_BUF_SIZE		512
+
+typedef enum {
+	SIM_OP_BATTERY				= 0,
+	SIM_OP_SCAN					= 1,
+	SIM_OP_MICROPHONE			= 2,
+	SIM_OP_DOWNLOAD_CURSOR		= 3,
+	SIM_OP_BADGE_ASSIGNEMENT	= 4,
+} sim_op_kind_t;
+
+static const char* const op_names[] = {"battery", "scan", "microphone", "cursor", "assignement"};
+static const storer_chunk_partition_t chunk_partitions[SIM_CHUNK_KINDS] = {STORER_CHUNK_PARTITION_BATTERY, STORER_CHUNK_PARTITION_SCAN, STORER_CHUNK_PARTITION_MICROPHONE};
+static const tb_field_t* const chunk_fields[SIM_CHUNK_KINDS] = {BatteryChunk_fields, ScanChunk_fields, MicrophoneChunk_fields};
+static const char* const operation_names[] = {"-", "flash store", "flash erase", "eeprom store"};
+
+typedef struct {
+	uint8_t		kind;
+	uint8_t		hub;				/**< The hub of a download cursor */
+	uint32_t	seq;				/**< The sequence number of a chunk (per kind) */
+} sim_op_t;
+
+/**< All chunk types start with their Timestamp */
+typedef union {
+	BatteryChunk		battery;
+	ScanChunk			scan;
+	MicrophoneChunk		microphone;
+} sim_chunk_t;
+
+typedef struct {
+	uint32_t	prefill;
+	uint32_t	windows;
+	uint32_t	window;
+	uint32_t	spacing;
+	uint32_t	trials;
+	uint64_t	seed;
+	uint32_t	jobs;
+} options_t;
+
+/**< The recovery work of one storer_init() */
+typedef struct {
+	uint32_t	reads;				/**< Storage read operations */
+	uint32_t	read_bytes;
+	uint32_t	writes;				/**< Storage store and erase operations (e.g. a first element-header restored from the swap page) */
+	uint64_t	storage_us;			/**< Modeled time of all storage operations */
+	uint64_t	host_ns;
+} recovery_t;
+
+/**< The stored chunks of a kind: the sequence numbers [oldest, end) */
+typedef struct {
+	uint32_t	oldest;
+	uint32_t	end;
+} chunk_range_t;
+
+/**< The result of the reference process, sent to the parent via a pipe */
+typedef struct {
+	int32_t			status;										/**< NRF_SUCCESS, or the error of an operation or of the consistency check */
+	uint32_t		write_operations[SIM_MAX_WINDOW + 1];		/**< Write operations of the storage mocks before the operation j of the window */
+	chunk_range_t	ranges[SIM_MAX_WINDOW + 1][SIM_CHUNK_KINDS];	/**< The stored chunks after j operations of the window */
+	recovery_t		clean_recovery;								/**< storer_init() after the window without power loss */
+} reference_t;
+
+/**< The result of one trial, sent from the child-process to the parent via a pipe */
+typedef struct {
+	int32_t				status;						/**< NRF_SUCCESS or the error of storer_init() after the power loss */
+	uint32_t			interrupted_op;				/**< The operation of the window that was interrupted */
+	power_loss_event_t	event;
+	recovery_t			recovery;
+	uint32_t			lost[SIM_CHUNK_KINDS];
+	uint32_t			unknown[SIM_CHUNK_KINDS];
+	uint32_t			corrupted[SIM_CHUNK_KINDS];
+	uint8_t				cursor_lost;
+	uint8_t				assignement_lost;
+	uint8_t				unusable;
+} trial_result_t;
+
+/**< A trial as seen by the parent */
+typedef struct {
+	uint32_t		window;
+	uint32_t		operation;
+	uint32_t		byte;
+	int				exit_reason;					/**< 0: finished, otherwise the signal that terminated the child (SIGALRM: hang) or -1 */
+	trial_result_t	result;
+} trial_t;
+
+
+static options_t options;
+static std::vector<sim_op_t> ops;		/**< The operations of the prefill and the windows */
+static uint32_t window_start = 0;		/**< The index of the first operation of the current window */
+static uint8_t verbose = 0;
+
+
+static uint64_t hash(uint64_t a, uint64_t b, uint64_t c) {
+	return sim_mix(sim_mix(sim_mix(options.seed ^ a) ^ b) ^ c);
+}
+
+
+/**@brief Function to retrieve the index of the first operation of a window.
+ */
+static uint32_t window_begin(uint32_t window) {
+	return options.prefill + window*options.spacing;
+}
+
+/**@brief Function to generate the operations of the prefill and the windows.
+ */
+static void generate_ops(void) {
+	uint32_t seqs[SIM_CHUNK_KINDS] = {0};
+	ops.resize(window_begin(options.windows - 1) + options.window);
+	for(uint32_t i = 0; i < ops.size(); i++) {
+		uint64_t h = hash(0, i, 0);
+		uint32_t r = (uint32_t) (h % 100);
+		sim_op_t op;
+		op.kind = (r < 25) ? SIM_OP_BATTERY : (r < 55) ? SIM_OP_SCAN : (r < 88) ? SIM_OP_MICROPHONE : (r < 98) ? SIM_OP_DOWNLOAD_CURSOR : SIM_OP_BADGE_ASSIGNEMENT;
+		op.hub = (uint8_t) ((h >> 32) % SIM_HUBS);
+		op.seq = (op.kind < SIM_CHUNK_KINDS) ? seqs[op.kind]++ : 0;
+		ops[i] = op;
+	}
+}
+
+/**@brief Function to generate the content of the chunk with a sequence number.
+ */
+static void make_chunk(uint8_t kind, uint32_t seq, sim_chunk_t* chunk) {
+	memset(chunk, 0, sizeof(sim_chunk_t));
+	uint64_t h = hash(1, kind, seq);
+	Timestamp timestamp;
+	timestamp.seconds = SIM_SEQ_BASE + seq;
+	timestamp.ms = (uint16_t) (h % 1000);
+	if(kind == SIM_OP_BATTERY) {
+		chunk->battery.timestamp = timestamp;
+		chunk->battery.battery_data.voltage = 2.5f + (float) ((h >> 16) % 1000) / 1000.0f;
+	} else if(kind == SIM_OP_SCAN) {
+		chunk->scan.timestamp = timestamp;
+		chunk->scan.scan_result_data_count = (uint8_t) ((h >> 16) % (SCAN_CHUNK_DATA_SIZE + 1));
+		for(uint32_t i = 0; i < chunk->scan.scan_result_data_count; i++) {
+			uint64_t d = sim_mix(h + i);
+			chunk->scan.scan_result_data[i].scan_device.ID = (uint16_t) d;
+			chunk->scan.scan_result_data[i].scan_device.rssi = (int8_t) (-40 - (int8_t) ((d >> 16) % 50));
+			chunk->scan.scan_result_data[i].count = (uint8_t) (1 + (d >> 24) % 20);
+		}
+	} else {
+		// The microphone-partition is static, so the chunks are always complete
+		chunk->microphone.timestamp = timestamp;
+		chunk->microphone.sample_period_ms = 50;
+		chunk->microphone.microphone_data_count = MICROPHONE_CHUNK_DATA_SIZE;
+		for(uint32_t i = 0; i < MICROPHONE_CHUNK_DATA_SIZE; i++)
+			chunk->microphone.microphone_data[i].value = (uint8_t) sim_mix(h + i);
+	}
+}
+
+static void make_download_cursor(uint32_t index, uint16_t record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS]) {
+	for(uint32_t i = 0; i < STORER_NUMBER_OF_CHUNK_PARTITIONS; i++)
+		record_ids[i] = (uint16_t) hash(2, index, i);
+}
+
+static uint16_t hub_id(uint8_t hub) {
+	return (uint16_t) (100 + hub);
+}
+
+static void make_badge_assignement(uint32_t index, BadgeAssignement* badge_assignement) {
+	uint64_t h = hash(3, index, 0);
+	badge_assignement->ID = (uint16_t) h;
+	badge_assignement->group = (uint8_t) (h >> 16);
+}
+
+static uint32_t encode_chunk(uint8_t kind, sim_chunk_t* chunk, uint8_t* buf) {
+	tb_ostream_t ostream = tb_ostream_from_buffer(buf, SIM_ENCODED_BUF_SIZE);
+	if(!tb_encode(&ostream, chunk_fields[kind], chunk, TB_LITTLE_ENDIAN))
+		return 0;
+	return ostream.bytes_written;
+}
+
+/**@brief Function to run an operation of the prefill or the window.
+ */
+static ret_code_t run_operation(uint32_t index) {
+	static sim_chunk_t chunk;
+	const sim_op_t& op = ops[index];
+	if(op.kind < SIM_CHUNK_KINDS)
+		make_chunk(op.kind, op.seq, &chunk);
+	switch(op.kind) {
+		case SIM_OP_BATTERY:
+			return storer_store_battery_chunk(&chunk.battery);
+		case SIM_OP_SCAN:
+			return storer_store_scan_chunk(&chunk.scan);
+		case SIM_OP_MICROPHONE:
+			return storer_store_microphone_chunk(&chunk.microphone);
+		case SIM_OP_DOWNLOAD_CURSOR: {
+			uint16_t record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS];
+			make_download_cursor(index, record_ids);
+			return storer_store_download_cursor(hub_id(op.hub), record_ids);
+		}
+		default: {
+			BadgeAssignement badge_assignement;
+			make_badge_assignement(index, &badge_assignement);
+			return storer_store_badge_assignement(&badge_assignement);
+		}
+	}
+}
+
+/**@brief Function to reboot the badge after a power loss and to measure the recovery work of storer_init().
+ */
+static ret_code_t reboot(recovery_t* recovery) {
+	power_loss_reboot();
+	storage_model_reset_statistics();
+	uint32_t write_operations = power_loss_get_write_operations();
+	uint64_t start_ns = sim_get_host_nanoseconds();
+	ret_code_t ret = storer_init();
+	recovery->host_ns = sim_get_host_nanoseconds() - start_ns;
+
+	storage_model_statistics_t statistics;
+	storage_model_get_statistics(&statistics);
+	recovery->reads = statistics.flash_reads + statistics.eeprom_reads;
+	recovery->read_bytes = statistics.flash_read_words*sizeof(uint32_t) + statistics.eeprom_read_bytes;
+	recovery->writes = power_loss_get_write_operations() - write_operations;
+	recovery->storage_us = statistics.flash_busy_us + statistics.eeprom_busy_us;
+	return ret;
+}
+
+
+/**< A chunk that was read from the storage */
+typedef struct {
+	uint32_t	seq;				/**< UINT32_MAX, if the timestamp is no sequence number of a stored chunk */
+	uint8_t		content_ok;
+} read_chunk_t;
+
+/**@brief Function to read all chunks of a kind (from the oldest to the latest) like the hub does, and to compare them with the generated content.
+ *
+ * @param[in]	kind		The kind of the chunks.
+ * @param[in]	stored		Number of chunks of the kind that were stored (or tried to).
+ * @param[out]	chunks		The read chunks.
+ *
+ * @retval	NRF_SUCCESS or the error of the storer.
+ */
+static ret_code_t read_chunks(uint8_t kind, uint32_t stored, std::vector<read_chunk_t>* chunks) {
+	static sim_chunk_t chunk, expected;
+	static uint8_t encoded[SIM_ENCODED_BUF_SIZE], encoded_expected[SIM_ENCODED_BUF_SIZE];
+	chunks->clear();
+	uint16_t record_id;
+	ret_code_t ret = storer_find_oldest_chunk(chunk_partitions[kind], &record_id);
+	if(ret == NRF_ERROR_INVALID_STATE)	// No chunks
+		return NRF_SUCCESS;
+
+	while(ret == NRF_SUCCESS) {
+		memset(&chunk, 0, sizeof(chunk));
+		ret = storer_decode_next_chunk(chunk_partitions[kind], chunk_fields[kind], &chunk, &record_id);
+		if(ret != NRF_SUCCESS)
+			break;
+		read_chunk_t read_chunk;
+		read_chunk.seq = UINT32_MAX;
+		read_chunk.content_ok = 0;
+		uint32_t seconds = chunk.battery.timestamp.seconds;
+		if(seconds >= SIM_SEQ_BASE && seconds - SIM_SEQ_BASE < stored) {
+			read_chunk.seq = seconds - SIM_SEQ_BASE;
+			make_chunk(kind, read_chunk.seq, &expected);
+			uint32_t len = encode_chunk(kind, &chunk, encoded);
+			read_chunk.content_ok = (len > 0 && len == encode_chunk(kind, &expected, encoded_expected) && memcmp(encoded, encoded_expected, len) == 0) ? 1 : 0;
+		}
+		chunks->push_back(read_chunk);
+	}
+	storer_invalidate_iterators();
+	return (ret == NRF_ERROR_NOT_FOUND) ? NRF_SUCCESS : ret;
+}
+
+/**@brief Function to retrieve the number of chunks of a kind that were stored (or tried to) in the operations before end_index.
+ */
+static uint32_t stored_chunks(uint8_t kind, uint32_t end_index) {
+	for(uint32_t i = end_index; i > 0; i--) {
+		if(ops[i - 1].kind == kind)
+			return ops[i - 1].seq + 1;
+	}
+	return 0;
+}
+
+/**@brief Function to find the last operation of a kind (and hub) before end_index.
+ *
+ * @retval	The index of the operation, or -1.
+ */
+static int64_t last_operation(uint8_t kind, uint8_t hub, uint32_t end_index) {
+	for(uint32_t i = end_index; i > 0; i--) {
+		if(ops[i - 1].kind == kind && (kind != SIM_OP_DOWNLOAD_CURSOR || ops[i - 1].hub == hub))
+			return (int64_t) (i - 1);
+	}
+	return -1;
+}
+
+
+/**@brief Function to run the window without power loss (in a child-process).
+ */
+static void run_reference(reference_t* reference) {
+	memset(reference, 0, sizeof(reference_t));
+	std::vector<read_chunk_t> chunks;
+	for(uint32_t j = 0; j <= options.window; j++) {
+		uint32_t index = window_start + j;
+		if(j > 0) {
+			ret_code_t ret = run_operation(index - 1);
+			if(ret != NRF_SUCCESS) {
+				fprintf(stderr, "POWER_LOSS_SIM: Reference operation %u (%s) failed: %d\n", (unsigned) (j - 1), op_names[ops[index - 1].kind], (int) ret);
+				reference->status = ret;
+				return;
+			}
+		}
+		reference->write_operations[j] = power_loss_get_write_operations();
+		for(uint8_t kind = 0; kind < SIM_CHUNK_KINDS; kind++) {
+			if(j > 0 && ops[index - 1].kind != kind) {
+				reference->ranges[j][kind] = reference->ranges[j - 1][kind];
+				continue;
+			}
+			// The chunks in the storage have to be consecutive and correct without power loss
+			ret_code_t ret = read_chunks(kind, stored_chunks(kind, index), &chunks);
+			for(size_t c = 0; ret == NRF_SUCCESS && c < chunks.size(); c++) {
+				if(!chunks[c].content_ok || chunks[c].seq != chunks[0].seq + c)
+					ret = NRF_ERROR_INVALID_DATA;
+			}
+			if(ret != NRF_SUCCESS) {
+				fprintf(stderr, "POWER_LOSS_SIM: Reference %s-chunks are inconsistent after operation %u: %d\n", op_names[kind], (unsigned) j, (int) ret);
+				reference->status = ret;
+				return;
+			}
+			reference->ranges[j][kind].oldest = chunks.empty() ? 0 : chunks[0].seq;
+			reference->ranges[j][kind].end = chunks.empty() ? 0 : chunks.back().seq + 1;
+		}
+	}
+	reference->status = reboot(&reference->clean_recovery);
+}
+
+
+/**@brief Function to check the chunks, the download cursors and the badge assignement after the recovery.
+ */
+static void check_data(const reference_t& reference, uint32_t k, trial_result_t* result) {
+	uint32_t index = window_start + k;	// The interrupted operation
+	std::vector<read_chunk_t> chunks;
+	for(uint8_t kind = 0; kind < SIM_CHUNK_KINDS; kind++) {
+		const chunk_range_t& before = reference.ranges[k][kind];
+		const chunk_range_t& after = reference.ranges[k + 1][kind];
+		// All chunks in both ranges must be recovered, chunks outside of both ranges are unknown
+		uint32_t must_oldest = std::max(before.oldest, after.oldest), must_end = std::min(before.end, after.end);
+		uint32_t allowed_oldest = std::min(before.oldest, after.oldest), allowed_end = std::max(before.end, after.end);
+		if(before.end == before.oldest) {
+			allowed_oldest = after.oldest;
+			must_end = must_oldest;
+		}
+
+		if(read_chunks(kind, stored_chunks(kind, index + 1), &chunks) != NRF_SUCCESS) {
+			result->unusable = 1;
+			continue;
+		}
+		std::vector<uint8_t> found((must_end > must_oldest) ? (must_end - must_oldest) : 0, 0);
+		for(size_t c = 0; c < chunks.size(); c++) {
+			uint32_t seq = chunks[c].seq;
+			if(seq == UINT32_MAX || seq < allowed_oldest || seq >= allowed_end) {
+				result->unknown[kind]++;
+			} else if(!chunks[c].content_ok) {
+				result->corrupted[kind]++;
+			} else if(seq >= must_oldest && seq < must_end) {
+				found[seq - must_oldest] = 1;
+			}
+		}
+		uint32_t first_lost = UINT32_MAX, last_lost = 0;
+		for(uint32_t s = 0; s < found.size(); s++) {
+			if(!found[s]) {
+				result->lost[kind]++;
+				first_lost = std::min(first_lost, must_oldest + s);
+				last_lost = must_oldest + s;
+			}
+		}
+		if(verbose) {
+			printf("  %-11s expected [%u, %u), read %u chunks", op_names[kind], (unsigned) must_oldest, (unsigned) must_end, (unsigned) chunks.size());
+			if(!chunks.empty())
+				printf(" (oldest %d, latest %d)", (int) chunks[0].seq, (int) chunks.back().seq);
+			printf(": lost %u", (unsigned) result->lost[kind]);
+			if(result->lost[kind] > 0)
+				printf(" (between %u and %u)", (unsigned) first_lost, (unsigned) last_lost);
+			printf(", unknown %u, corrupted %u\n", (unsigned) result->unknown[kind], (unsigned) result->corrupted[kind]);
+		}
+	}
+
+	// The download cursors must be the last stored ones (or the ones of the interrupted operation)
+	for(uint8_t hub = 0; hub < SIM_HUBS; hub++) {
+		int64_t last = last_operation(SIM_OP_DOWNLOAD_CURSOR, hub, index);
+		uint16_t record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS], expected[STORER_NUMBER_OF_CHUNK_PARTITIONS], interrupted[STORER_NUMBER_OF_CHUNK_PARTITIONS];
+		ret_code_t ret = storer_get_download_cursor(hub_id(hub), record_ids);
+		uint8_t ok = (last < 0 && ret == NRF_ERROR_NOT_FOUND);
+		if(last >= 0) {
+			make_download_cursor((uint32_t) last, expected);
+			ok = (ret == NRF_SUCCESS && memcmp(record_ids, expected, sizeof(expected)) == 0);
+		}
+		if(!ok && ops[index].kind == SIM_OP_DOWNLOAD_CURSOR && ops[index].hub == hub) {
+			make_download_cursor(index, interrupted);
+			ok = (ret == NRF_SUCCESS && memcmp(record_ids, interrupted, sizeof(interrupted)) == 0);
+		}
+		if(!ok)
+			result->cursor_lost = 1;
+	}
+
+	// The badge assignement likewise
+	int64_t last = last_operation(SIM_OP_BADGE_ASSIGNEMENT, 0, index);
+	BadgeAssignement badge_assignement, expected;
+	ret_code_t ret = storer_read_badge_assignement(&badge_assignement);
+	uint8_t ok = (last < 0 && ret != NRF_SUCCESS);
+	if(last >= 0) {
+		make_badge_assignement((uint32_t) last, &expected);
+		ok = (ret == NRF_SUCCESS && badge_assignement.ID == expected.ID && badge_assignement.group == expected.group);
+	}
+	if(!ok && ops[index].kind == SIM_OP_BADGE_ASSIGNEMENT) {
+		make_badge_assignement(index, &expected);
+		ok = (ret == NRF_SUCCESS && badge_assignement.ID == expected.ID && badge_assignement.group == expected.group);
+	}
+	if(!ok)
+		result->assignement_lost = 1;
+	if(verbose)
+		printf("  cursors %s, assignement %s\n", result->cursor_lost ? "LOST" : "ok", result->assignement_lost ? "LOST" : "ok");
+}
+
+/**@brief Function to check that a new chunk of every kind can be stored and read again after the recovery.
+ */
+static uint8_t check_usable(void) {
+	static sim_chunk_t chunk;
+	std::vector<read_chunk_t> chunks;
+	uint32_t seq = (uint32_t) ops.size();	// Higher than every sequence number of the operations
+	for(uint8_t kind = 0; kind < SIM_CHUNK_KINDS; kind++) {
+		make_chunk(kind, seq, &chunk);
+		ret_code_t ret;
+		if(kind == SIM_OP_BATTERY)
+			ret = storer_store_battery_chunk(&chunk.battery);
+		else if(kind == SIM_OP_SCAN)
+			ret = storer_store_scan_chunk(&chunk.scan);
+		else
+			ret = storer_store_microphone_chunk(&chunk.microphone);
+		if(ret != NRF_SUCCESS || read_chunks(kind, seq + 1, &chunks) != NRF_SUCCESS || chunks.empty() || chunks.back().seq != seq || !chunks.back().content_ok) {
+			if(verbose)
+				printf("  %s-partition NOT usable after the recovery (store: %d)\n", op_names[kind], (int) ret);
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/**@brief Function to run the window with a power loss, to reboot and to check the recovery.
+ *
+ * @param[in]	operation	The interrupted write operation of the window.
+ * @param[in]	byte		The interrupted byte of the operation (modulo its length).
+ */
+static void run_trial(const reference_t& reference, uint32_t operation, uint32_t byte, trial_result_t* result) {
+	memset(result, 0, sizeof(trial_result_t));
+	power_loss_arm(operation, byte);
+	uint32_t k = 0;
+	for(; k < options.window; k++) {
+		run_operation(window_start + k);
+		if(power_loss_occurred())
+			break;
+	}
+	if(k == options.window) {	// The operation is out of the window
+		result->status = NRF_ERROR_INVALID_PARAM;
+		return;
+	}
+	result->interrupted_op = k;
+	power_loss_get_event(&result->event);
+	if(verbose)
+		printf("Power loss in operation %u of the window (%s), %s of %u bytes at 0x%X after %u bytes\n", (unsigned) k, op_names[ops[window_start + k].kind],
+				operation_names[result->event.operation], (unsigned) result->event.len, (unsigned) result->event.address, (unsigned) result->event.written_len);
+
+	result->status = reboot(&result->recovery);
+	if(verbose)
+		printf("Recovery: storer_init() %d, %u reads (%u bytes), %u writes, %.2f ms storage, %.0f us host\n", (int) result->status, (unsigned) result->recovery.reads,
+				(unsigned) result->recovery.read_bytes, (unsigned) result->recovery.writes, result->recovery.storage_us/1000.0, result->recovery.host_ns/1000.0);
+	if(result->status != NRF_SUCCESS)
+		return;
+
+	check_data(reference, k, result);
+	result->unusable |= !check_usable();
+}
+
+
+/**@brief Function to redirect the stdout (the debug-log of the firmware) to /dev/null.
+ *
+ * @retval	The saved descriptor of the stdout for restore_stdout().
+ */
+static int redirect_stdout(void) {
+	fflush(stdout);
+	int saved = dup(STDOUT_FILENO);
+	int null_fd = open("/dev/null", O_WRONLY);
+	if(null_fd >= 0) {
+		dup2(null_fd, STDOUT_FILENO);
+		close(null_fd);
+	}
+	return saved;
+}
+
+static void restore_stdout(int saved) {
+	fflush(stdout);
+	if(saved >= 0) {
+		dup2(saved, STDOUT_FILENO);
+		close(saved);
+	}
+}
+
+/**@brief Function to run the reference in a child-process.
+ *
+ * @retval	0 on success, -1 otherwise.
+ */
+static int get_reference(reference_t* reference) {
+	int exit_reason;
+	if(sim_run_jobs(1, 1, 0, sizeof(reference_t), [](uint32_t index, void* result) { run_reference((reference_t*) result); }, reference, &exit_reason) != 0)
+		return -1;
+	if(exit_reason != 0 || reference->status != NRF_SUCCESS) {
+		fprintf(stderr, "POWER_LOSS_SIM: Reference failed (status %d)\n", (exit_reason == 0) ? (int) reference->status : -1);
+		return -1;
+	}
+	return 0;
+}
+
+/**@brief Function to run the trials of a window in child-processes (at most options.jobs at the same time).
+ *
+ * @param[in]	reference	The reference of the window (the window starts at window_start).
+ * @param[in]	window		The index of the window.
+ * @param[in]	number		Number of trials in the window.
+ * @param[out]	trials		Vector to append the trials to.
+ */
+static void run_trials(const reference_t& reference, uint32_t window, uint32_t number, std::vector<trial_t>* trials) {
+	uint32_t total_operations = reference.write_operations[options.window];
+	size_t first = trials->size();
+	trials->resize(first + number, trial_t());
+	for(uint32_t t = 0; t < number; t++) {
+		trial_t& trial = (*trials)[first + t];
+		uint64_t h = hash(4, window, t);
+		trial.window = window;
+		trial.operation = (uint32_t) (h % total_operations);
+		trial.byte = (uint32_t) (h >> 32);
+	}
+
+	std::vector<trial_result_t> results(number);
+	std::vector<int> exit_reasons(number);
+	const trial_t* window_trials = &(*trials)[first];
+	if(sim_run_jobs(number, options.jobs, SIM_TRIAL_TIMEOUT_S, sizeof(trial_result_t), [&](uint32_t index, void* result) {
+				run_trial(reference, window_trials[index].operation, window_trials[index].byte, (trial_result_t*) result);
+			}, results.data(), exit_reasons.data()) != 0)
+		exit(1);
+	for(uint32_t t = 0; t < number; t++) {
+		(*trials)[first + t].result = results[t];
+		(*trials)[first + t].exit_reason = exit_reasons[t];
+	}
+}
+
+
+static uint8_t is_failed(const trial_t& trial) {
+	return trial.exit_reason != 0 || trial.result.status != NRF_SUCCESS || trial.result.unusable;
+}
+
+static uint32_t lost_data(const trial_t& trial) {
+	uint32_t lost = trial.result.cursor_lost + trial.result.assignement_lost;
+	for(uint8_t kind = 0; kind < SIM_CHUNK_KINDS; kind++)
+		lost += trial.result.lost[kind] + trial.result.unknown[kind] + trial.result.corrupted[kind];
+	return lost;
+}
+
+static void print_recovery_row(const char* name, const std::vector<recovery_t>& recoveries) {
+	if(recoveries.empty()) {
+		printf("%-14s %6u\n", name, 0);
+		return;
+	}
+	std::vector<uint32_t> reads;
+	double sum_reads = 0, sum_storage_us = 0;
+	uint32_t max_read_bytes = 0, max_writes = 0;
+	uint64_t max_storage_us = 0, max_host_ns = 0;
+	for(size_t i = 0; i < recoveries.size(); i++) {
+		const recovery_t& r = recoveries[i];
+		reads.push_back(r.reads);
+		sum_reads += r.reads;
+		sum_storage_us += r.storage_us;
+		max_read_bytes = std::max(max_read_bytes, r.read_bytes);
+		max_writes = std::max(max_writes, r.writes);
+		max_storage_us = std::max(max_storage_us, r.storage_us);
+		max_host_ns = std::max(max_host_ns, r.host_ns);
+	}
+	std::sort(reads.begin(), reads.end());
+	double n = (double) recoveries.size();
+	printf("%-14s %6u %10.0f %8u %8u %10.1f %8u %10.2f %10.2f %10.0f\n", name, (unsigned) recoveries.size(), sum_reads/n, (unsigned) reads[reads.size()/2],
+			(unsigned) reads.back(), max_read_bytes/1024.0, (unsigned) max_writes, sum_storage_us/n/1000.0, max_storage_us/1000.0, max_host_ns/1000.0);
+}
+
+static void print_loss_row(const char* name, const std::vector<trial_t>& trials, int operation) {
+	uint32_t n = 0, lossy = 0, failed = 0, unknown = 0, corrupted = 0, cursor = 0, assignement = 0, max_lost = 0;
+	uint32_t lost[SIM_CHUNK_KINDS] = {0};
+	for(size_t t = 0; t < trials.size(); t++) {
+		const trial_t& trial = trials[t];
+		if(operation >= 0 && (trial.exit_reason != 0 || (int) trial.result.event.operation != operation))
+			continue;
+		n++;
+		failed += is_failed(trial);
+		lossy += (lost_data(trial) > 0);
+		uint32_t trial_lost = 0;
+		for(uint8_t kind = 0; kind < SIM_CHUNK_KINDS; kind++) {
+			lost[kind] += trial.result.lost[kind];
+			trial_lost += trial.result.lost[kind];
+			unknown += trial.result.unknown[kind];
+			corrupted += trial.result.corrupted[kind];
+		}
+		max_lost = std::max(max_lost, trial_lost);
+		cursor += trial.result.cursor_lost;
+		assignement += trial.result.assignement_lost;
+	}
+	printf("%-14s %6u %6u %8u %8u %10u %9u %8u %9u %7u %11u %7u\n", name, (unsigned) n, (unsigned) lossy, (unsigned) lost[SIM_OP_BATTERY], (unsigned) lost[SIM_OP_SCAN],
+			(unsigned) lost[SIM_OP_MICROPHONE], (unsigned) max_lost, (unsigned) unknown, (unsigned) corrupted, (unsigned) cursor, (unsigned) assignement, (unsigned) failed);
+}
+
+static void print_trial(uint32_t t, const trial_t& trial) {
+	printf("  trial %u: --cut %u,%u,%u: ", (unsigned) t, (unsigned) trial.window, (unsigned) trial.operation, (unsigned) trial.byte);
+	if(trial.exit_reason == SIGALRM) {
+		printf("recovery hangs (more than %u s)\n", SIM_TRIAL_TIMEOUT_S);
+		return;
+	} else if(trial.exit_reason != 0) {
+		printf("trial crashed (%d)\n", trial.exit_reason);
+		return;
+	}
+	const trial_result_t& r = trial.result;
+	printf("%s in operation %u (%s)", operation_names[r.event.operation], (unsigned) r.interrupted_op, op_names[ops[window_begin(trial.window) + r.interrupted_op].kind]);
+	if(r.status != NRF_SUCCESS) {
+		printf(": storer_init() failed (%d)\n", (int) r.status);
+		return;
+	}
+	for(uint8_t kind = 0; kind < SIM_CHUNK_KINDS; kind++) {
+		if(r.lost[kind] + r.unknown[kind] + r.corrupted[kind] > 0)
+			printf(", %s lost %u unknown %u corrupted %u", op_names[kind], (unsigned) r.lost[kind], (unsigned) r.unknown[kind], (unsigned) r.corrupted[kind]);
+	}
+	printf("%s%s%s\n", r.cursor_lost ? ", cursor lost" : "", r.assignement_lost ? ", assignement lost" : "", r.unusable ? ", NOT usable" : "");
+}
+
+static void print_usage(const char* program) {
+	fprintf(stderr, "Usage: %s [--trials N] [--prefill OPERATIONS] [--windows N] [--window OPERATIONS] [--spacing OPERATIONS] [--seed SEED] [--jobs J] [--cut WINDOW,OPERATION,BYTE]\n", program);
+}
+
+
+int main(int argc, char** argv) {
+	options.prefill = 2000;
+	options.windows = 8;
+	options.window = 100;
+	options.spacing = 1000;
+	options.trials = 400;
+	options.seed = 1;
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	options.jobs = (cpus > 0) ? (uint32_t) cpus : 1;
+	int64_t cut_window = -1;
+	uint32_t cut_operation = 0, cut_byte = 0;
+
+	for(int i = 1; i < argc; i++) {
+		if(strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+			options.trials = (uint32_t) atoi(argv[++i]);
+		} else if(strcmp(argv[i], "--prefill") == 0 && i + 1 < argc) {
+			options.prefill = (uint32_t) atoi(argv[++i]);
+		} else if(strcmp(argv[i], "--windows") == 0 && i + 1 < argc) {
+			options.windows = (uint32_t) atoi(argv[++i]);
+		} else if(strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+			options.window = (uint32_t) atoi(argv[++i]);
+		} else if(strcmp(argv[i], "--spacing") == 0 && i + 1 < argc) {
+			options.spacing = (uint32_t) atoi(argv[++i]);
+		} else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			options.seed = strtoull(argv[++i], NULL, 10);
+		} else if(strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+			options.jobs = (uint32_t) atoi(argv[++i]);
+		} else if(strcmp(argv[i], "--cut") == 0 && i + 1 < argc) {
+			unsigned window, operation, byte;
+			if(sscanf(argv[++i], "%u,%u,%u", &window, &operation, &byte) != 3) {
+				print_usage(argv[0]);
+				return 1;
+			}
+			cut_window = window;
+			cut_operation = operation;
+			cut_byte = byte;
+		} else {
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+	if(options.windows == 0 || options.window == 0 || options.window > SIM_MAX_WINDOW || options.spacing < options.window || options.jobs == 0 || cut_window >= (int64_t) options.windows) {
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	// The storage mocks complete all operations instantly (the storage time is only accounted), so no timer-threads are needed
+	timer_enable_virtual_time(1);
+	generate_ops();
+
+	int saved_stdout = redirect_stdout();
+	power_loss_reset();
+	ret_code_t ret = storer_init();
+	restore_stdout(saved_stdout);
+	if(ret != NRF_SUCCESS) {
+		fprintf(stderr, "POWER_LOSS_SIM: storer_init() failed: %d\n", (int) ret);
+		return 1;
+	}
+
+	if(cut_window < 0) {
+		printf("Prefill %u operations, %u windows of %u operations every %u operations, %u trials, seed %llu\n", (unsigned) options.prefill, (unsigned) options.windows,
+				(unsigned) options.window, (unsigned) options.spacing, (unsigned) options.trials, (unsigned long long) options.seed);
+	}
+	static reference_t reference;
+	std::vector<recovery_t> clean;
+	std::vector<trial_t> trials;
+	uint32_t executed = 0;
+	for(uint32_t window = 0; window < options.windows; window++) {
+		if(cut_window >= 0 && window != (uint32_t) cut_window)
+			continue;
+		// The parent runs the operations up to the window, every process of the window starts from this state
+		window_start = window_begin(window);
+		saved_stdout = redirect_stdout();
+		for(; executed < window_start && ret == NRF_SUCCESS; executed++)
+			ret = run_operation(executed);
+		restore_stdout(saved_stdout);
+		if(ret != NRF_SUCCESS) {
+			fprintf(stderr, "POWER_LOSS_SIM: Operation %u failed: %d\n", (unsigned) executed - 1, (int) ret);
+			return 1;
+		}
+		power_loss_reset();
+
+		if(get_reference(&reference) != 0)
+			return 1;
+		uint32_t total_operations = reference.write_operations[options.window];
+		if(total_operations == 0) {
+			fprintf(stderr, "POWER_LOSS_SIM: Window %u has no write operations\n", (unsigned) window);
+			return 1;
+		}
+		clean.push_back(reference.clean_recovery);
+
+		if(cut_window >= 0) {
+			if(cut_operation >= total_operations) {
+				fprintf(stderr, "POWER_LOSS_SIM: Window %u has only %u write operations\n", (unsigned) window, (unsigned) total_operations);
+				return 1;
+			}
+			verbose = 1;
+			trial_result_t result;
+			run_trial(reference, cut_operation, cut_byte, &result);
+			return (result.status != NRF_SUCCESS || result.unusable) ? 1 : 0;
+		}
+		// The trials are distributed evenly over the windows
+		uint32_t number = options.trials/options.windows + ((window < options.trials % options.windows) ? 1 : 0);
+		run_trials(reference, window, number, &trials);
+	}
+
+	printf("\nRecovery of storer_init() (reads: storage read operations, storage: modeled time of the storage operations)\n");
+	printf("%-14s %6s %10s %8s %8s %10s %8s %10s %10s %10s\n", "interrupted", "trials", "reads avg", "median", "max", "kB max", "writes", "storage ms", "max ms", "host us");
+	print_recovery_row("none (clean)", clean);
+	std::vector<recovery_t> all;
+	for(int operation = POWER_LOSS_FLASH_STORE; operation <= POWER_LOSS_EEPROM_STORE; operation++) {
+		std::vector<recovery_t> recoveries;
+		for(size_t t = 0; t < trials.size(); t++) {
+			if(trials[t].exit_reason == 0 && trials[t].result.status == NRF_SUCCESS && (int) trials[t].result.event.operation == operation)
+				recoveries.push_back(trials[t].result.recovery);
+		}
+		all.insert(all.end(), recoveries.begin(), recoveries.end());
+		print_recovery_row(operation_names[operation], recoveries);
+	}
+	print_recovery_row("all", all);
+
+	printf("\nData loss (lost: stored before the power loss and kept by the reference, unknown: never stored or already overwritten)\n");
+	printf("%-14s %6s %6s %8s %8s %10s %9s %8s %9s %7s %11s %7s\n", "interrupted", "trials", "lossy", "battery", "scan", "microphone", "max lost",
+			"unknown", "corrupted", "cursor", "assignement", "failed");
+	for(int operation = POWER_LOSS_FLASH_STORE; operation <= POWER_LOSS_EEPROM_STORE; operation++)
+		print_loss_row(operation_names[operation], trials, operation);
+	print_loss_row("all", trials, -1);
+
+	uint32_t failed = 0, listed = 0;
+	for(uint32_t t = 0; t < trials.size(); t++) {
+		if(!is_failed(trials[t]))
+			continue;
+		if(failed++ == 0)
+			printf("\nFailed trials (recovery failed, crashed or hung, or not usable afterwards):\n");
+		if(failed <= SIM_MAX_LISTED_TRIALS)
+			print_trial(t, trials[t]);
+	}
+	for(uint32_t t = 0; t < trials.size() && listed < SIM_MAX_LISTED_TRIALS; t++) {
+		if(is_failed(trials[t]) || lost_data(trials[t]) == 0)
+			continue;
+		if(listed++ == 0)
+			printf("\nTrials with data loss (run with --cut to reproduce one):\n");
+		print_trial(t, trials[t]);
+	}
+	return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,641 @@
+/**@file
+ * @details Multi-badge radio simulation, to see how the scanning, the aggregation and the storage of the firmware
+ *			behave when many badges advertise in one room (CPU load in the scan report callback, chunk-fifo drops, storage rate).
+ *
+ *			N badges are placed on a floor plan and advertise on a shared channel. A subset of them (the observed badges)
+ *			runs the firmware libraries on the mocks in virtual-time mode. The firmware keeps its state in static variables,
+ *			so every observed badge runs in its own forked process. All other badges are only modeled as advertisers.
+ *			The advertising events of every badge are a deterministic function of the badge index and the seed
+ *			(ADVERTISING_INTERVAL_MS plus a pseudo-random advDelay of 0-10 ms, like in the BLE-specification),
+ *			so all processes see the same channel without synchronizing their virtual clocks.
+ *
+ *			An advertising event of badge j is reported to the scan report callback of the observed badge i, if:
+ *				- the RSSI (log-distance path-loss, static shadowing per pair, walls on the line of sight and
+ *				  fading per packet) is at least SIM_SENSITIVITY_DBM,
+ *				- the scan window of badge i is open and badge i does not advertise itself at the same time,
+ *				- every other advertising packet that overlaps in time is at least SIM_CAPTURE_MARGIN_DB weaker (capture effect).
+ *
+ *			Usage: run_scan_density_sim [--badges N[,N...]] [--floor-plan FILE] [--room WIDTHxHEIGHT] [--observe K]
+ *						[--duration SECONDS] [--scan PERIOD,INTERVAL,WINDOW,DURATION] [--path-loss-exponent X]
+ *						[--fading DB] [--seed SEED] [--jobs J]
+ *				--badges			Numbers of badges in the room, one run for each (default: 10,50,100,300).
+ *				--floor-plan		File with the room, badge positions and walls (see below).
+ *				--room				Size of the room in m, if there is no floor plan (default: 20x20).
+ *				--observe			Number of badges that run the firmware (default: 4, evenly spread over the badges).
+ *				--duration			Virtual seconds to simulate (default: 300).
+ *				--scan				Scan parameters of sampling_start_scan() (default: 60,300,100,5 like the hub).
+ *				--path-loss-exponent, --fading	Parameters of the radio model (default: 2.5 and 3 dB).
+ *				--jobs				Maximal number of processes at the same time (default: number of CPUs).
+ *
+ *			Floor plan file (one entry per line, # starts a comment):
+ *				room WIDTH HEIGHT				Size of the room in m. Badges without a position are placed randomly inside.
+ *				badge X Y						Position of the next badge in m.
+ *				wall X1 Y1 X2 Y2 LOSS_DB		Wall that attenuates the signal between every pair whose line of sight crosses it.
+ *
+ *			For each number of badges a line with the averages over the observed badges is printed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <queue>
+#include <deque>
+#include <vector>
+#include <string>
+
+#include "timer_lib.h"
+#include "app_timer.h"
+#include "app_scheduler.h"
+#include "systick_lib.h"
+#include "timeout_lib.h"
+#include "ble_lib.h"
+#include "advertiser_lib.h"
+#include "storer_lib.h"
+#include "sampling_lib.h"
+#include "debug_lib.h"
+#include "trace_lib.h"
+#include "chunk_messages.h"
+#include "tinybuf.h"
+#include "sim_lib.h"
+
+/** Include some (private) functions of the BLE-mock */
+extern void ble_simulate_scan_report(ble_gap_evt_adv_report_t* scan_report);
+extern uint8_t ble_simulate_is_scan_window_open(void);
+
+
+#define SIM_GROUP						1		/**< The group of all badges (and the group-filter of the scans) */
+#define SIM_ADV_INTERVAL_US				(((uint64_t) ADVERTISING_INTERVAL_MS)*1000)
+#define SIM_ADV_MAX_DELAY_US			10000	/**< Maximal pseudo-random advDelay that is added to every advertising interval */
+#define SIM_ADV_PACKET_AIRTIME_US		360		/**< 1 Mbit/s: (1 preamble + 4 access address + 2 header + 6 address + 29 data + 3 CRC) bytes */
+#define SIM_ADV_EVENT_DURATION_US		1500	/**< The own radio is busy (sending on the 3 advertising channels) for this time */
+#define SIM_RSSI_AT_1M_DBM				-59.0
+#define SIM_SENSITIVITY_DBM				-93.0
+#define SIM_CAPTURE_MARGIN_DB			6.0
+#define SIM_SHADOWING_SIGMA_DB			4.0		/**< Standard deviation of the static shadowing of each pair of badges */
+#define SIM_INTERFERENCE_MARGIN_DB		15.0	/**< Badges that are on average this much below the sensitivity are ignored completely */
+#define SIM_MIN_DISTANCE_M				0.1
+#define SIM_STORE_TIME_US				2000000	/**< Virtual time after the simulation to let the processing store the last chunks */
+
+
+typedef struct {
+	double x1, y1, x2, y2;
+	double loss_db;
+} wall_t;
+
+typedef struct {
+	double width, height;
+	std::vector<double> x, y;	/**< Positions of the badges of the floor plan file (might be less than the number of badges) */
+	std::vector<wall_t> walls;
+} floor_plan_t;
+
+typedef struct {
+	std::vector<uint32_t> number_of_badges;
+	uint32_t	observe;
+	uint32_t	duration_seconds;
+	uint16_t	scan_period_seconds;
+	uint16_t	scan_interval_ms;
+	uint16_t	scan_window_ms;
+	uint16_t	scan_duration_seconds;
+	double		path_loss_exponent;
+	double		fading_db;
+	uint64_t	seed;
+	uint32_t	jobs;
+} options_t;
+
+/**< The result of one observed badge, sent from the child-process to the parent via a pipe */
+typedef struct {
+	int32_t		status;					/**< NRF_SUCCESS or the error of the initialization */
+	uint32_t	audible_badges;			/**< Badges whose average RSSI is above the sensitivity */
+	double		scan_seconds;			/**< Virtual time while the badge was scanning */
+	uint64_t	heard_events;			/**< Advertising events above the sensitivity while the scan window was open */
+	uint64_t	lost_events;			/**< Heard events that were lost because of collisions (or the own advertising) */
+	uint64_t	reports;				/**< Reports passed to the firmware */
+	uint64_t	search_steps;			/**< Comparisons of the linear search for the ID in sampling_on_scan_report_callback() */
+	uint64_t	report_host_ns;			/**< Host-time spent in the firmware for the reports */
+	uint64_t	distinct_ids;			/**< Sum of the distinct IDs over all scans */
+	uint32_t	scans;
+	uint32_t	dropped_chunks;
+	uint32_t	high_water_mark;
+	uint32_t	stored_chunks;
+	uint32_t	stored_devices;
+	uint64_t	stored_bytes;			/**< Encoded size of the stored scan chunks */
+} badge_result_t;
+
+/**< An advertising event of a badge */
+typedef struct {
+	uint64_t	time_us;
+	uint32_t	badge;
+	uint32_t	number;					/**< The number of the event of this badge */
+	double		rssi;					/**< RSSI at the observed badge (not used for the own events) */
+} adv_event_t;
+
+struct adv_event_later {
+	bool operator()(const adv_event_t& a, const adv_event_t& b) const {
+		return a.time_us > b.time_us;
+	}
+};
+
+
+static uint64_t hash(uint64_t seed, uint64_t a, uint64_t b, uint64_t c) {
+	return sim_mix(sim_mix(sim_mix(seed ^ a) ^ b) ^ c);
+}
+
+/**@brief Function to retrieve a uniform value in [0, 1) from a hash.
+ */
+static double uniform(uint64_t h) {
+	return (h >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**@brief Function to retrieve a standard normal distributed value from a hash (Box-Muller).
+ */
+static double gaussian(uint64_t h) {
+	double u1 = uniform(sim_mix(h)), u2 = uniform(sim_mix(h + 1));
+	if(u1 < 1e-12)
+		u1 = 1e-12;
+	return sqrt(-2.0*log(u1)) * cos(2.0*M_PI*u2);
+}
+
+
+/**@brief Function to check whether the line segments p1-p2 and p3-p4 intersect.
+ */
+static bool segments_intersect(double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4) {
+	double d1 = (x4 - x3)*(y1 - y3) - (y4 - y3)*(x1 - x3);
+	double d2 = (x4 - x3)*(y2 - y3) - (y4 - y3)*(x2 - x3);
+	double d3 = (x2 - x1)*(y3 - y1) - (y2 - y1)*(x3 - x1);
+	double d4 = (x2 - x1)*(y4 - y1) - (y2 - y1)*(x4 - x1);
+	return ((d1 > 0) != (d2 > 0)) && ((d3 > 0) != (d4 > 0));
+}
+
+/**@brief Function to read a floor plan file.
+ *
+ * @retval	0 on success, -1 otherwise (with an error message).
+ */
+static int read_floor_plan(const char* file_name, floor_plan_t* floor_plan) {
+	FILE* file = fopen(file_name, "r");
+	if(file == NULL) {
+		fprintf(stderr, "Could not open the floor plan %s\n", file_name);
+		return -1;
+	}
+	char line[256];
+	uint32_t line_number = 0;
+	while(fgets(line, sizeof(line), file) != NULL) {
+		line_number++;
+		char* comment = strchr(line, '#');
+		if(comment != NULL)
+			*comment = '\0';
+		char keyword[16];
+		wall_t wall;
+		double x, y;
+		if(sscanf(line, "%15s", keyword) != 1)
+			continue;
+		if(strcmp(keyword, "room") == 0 && sscanf(line, "%*s %lf %lf", &floor_plan->width, &floor_plan->height) == 2) {
+			continue;
+		} else if(strcmp(keyword, "badge") == 0 && sscanf(line, "%*s %lf %lf", &x, &y) == 2) {
+			floor_plan->x.push_back(x);
+			floor_plan->y.push_back(y);
+		} else if(strcmp(keyword, "wall") == 0 && sscanf(line, "%*s %lf %lf %lf %lf %lf", &wall.x1, &wall.y1, &wall.x2, &wall.y2, &wall.loss_db) == 5) {
+			floor_plan->walls.push_back(wall);
+		} else {
+			fprintf(stderr, "Invalid line %u in the floor plan %s\n", line_number, file_name);
+			fclose(file);
+			return -1;
+		}
+	}
+	fclose(file);
+	return 0;
+}
+
+
+/**@brief The shared advertising channel of a room with a number of badges, seen from one observed badge.
+ */
+class RadioChannel {
+public:
+	RadioChannel(const options_t& options, const floor_plan_t& floor_plan, uint32_t number_of_badges, uint32_t observed)
+		: options_(options), floor_plan_(floor_plan), observed_(observed), next_number_(number_of_badges, 0) {
+		// The badges without a position in the floor plan are placed randomly (the same for all observed badges)
+		for(uint32_t i = 0; i < number_of_badges; i++) {
+			if(i < floor_plan.x.size()) {
+				x_.push_back(floor_plan.x[i]);
+				y_.push_back(floor_plan.y[i]);
+			} else {
+				x_.push_back(uniform(hash(options.seed, 1, i, 0)) * floor_plan.width);
+				y_.push_back(uniform(hash(options.seed, 1, i, 1)) * floor_plan.height);
+			}
+		}
+		// Only the badges that could be heard (or interfere) are put into the event queue
+		audible_badges_ = 0;
+		for(uint32_t j = 0; j < number_of_badges; j++) {
+			double rssi = (j == observed) ? 0 : average_rssi(j);
+			average_rssi_.push_back(rssi);
+			if(j != observed && rssi >= SIM_SENSITIVITY_DBM)
+				audible_badges_++;
+			if(j == observed || rssi >= SIM_SENSITIVITY_DBM - SIM_INTERFERENCE_MARGIN_DB)
+				queue_.push(next_event(j, uniform(hash(options.seed, 2, j, 0)) * SIM_ADV_INTERVAL_US));
+		}
+	}
+
+	uint32_t audible_badges(void) const {
+		return audible_badges_;
+	}
+
+	/**@brief Function to retrieve the next advertising event that is finished, i.e. all overlapping events are known.
+	 *
+	 * @param[out]	lost	Whether the event collided with an overlapping event (or the own advertising).
+	 */
+	adv_event_t next_finished_event(bool* lost) {
+		while(pending_.empty() || (!queue_.empty() && queue_.top().time_us <= pending_.front().time_us + SIM_ADV_EVENT_DURATION_US)) {
+			adv_event_t event = queue_.top();
+			queue_.pop();
+			pending_.push_back(event);
+			queue_.push(next_event(event.badge, event.time_us + SIM_ADV_INTERVAL_US + uniform(hash(options_.seed, 3, event.badge, event.number)) * SIM_ADV_MAX_DELAY_US));
+		}
+		adv_event_t event = pending_.front();
+		pending_.pop_front();
+		history_.push_back(event);
+		while(history_.front().time_us + 2*SIM_ADV_EVENT_DURATION_US < event.time_us)
+			history_.pop_front();
+
+		*lost = false;
+		if(event.badge != observed_) {
+			for(size_t k = 0; k < history_.size() + pending_.size() && !*lost; k++) {
+				const adv_event_t& other = (k < history_.size()) ? history_[k] : pending_[k - history_.size()];
+				if(other.badge == event.badge && other.number == event.number)
+					continue;
+				if(other.badge == observed_)
+					*lost = (event.time_us + SIM_ADV_PACKET_AIRTIME_US > other.time_us && event.time_us < other.time_us + SIM_ADV_EVENT_DURATION_US);
+				else if(event.time_us + SIM_ADV_PACKET_AIRTIME_US > other.time_us && other.time_us + SIM_ADV_PACKET_AIRTIME_US > event.time_us)
+					*lost = (event.rssi < other.rssi + SIM_CAPTURE_MARGIN_DB);
+			}
+		}
+		return event;
+	}
+
+	/**@brief Function to fill the advertising report of a badge, like ble_lib.c advertises it.
+	 */
+	void fill_scan_report(const adv_event_t& event, ble_gap_evt_adv_report_t* scan_report) const {
+		uint16_t ID = badge_id(event.badge);
+		// Flags, 16 bit service UUIDs, manufacturer specific data (company identifier, custom advdata of advertiser_lib.c), name
+		uint8_t data[29] = {0x02, 0x01, 0x06, 0x03, 0x03,
+							0x01, 0x00, 0x0E, 0xFF, 0x00,
+							0xFF, 0x00, 0x00, 0x00, 0x00,
+							0x00, 0x00, 0x00, 0x00, 0x00,
+							0x00, 0x00, 0x06, 0x09,
+							0x48, 0x44, 0x42, 0x44, 0x47};
+		data[13] = (uint8_t) (ID & 0xFF);
+		data[14] = (uint8_t) ((ID >> 8) & 0xFF);
+		data[15] = SIM_GROUP;
+		for(uint8_t k = 0; k < 6; k++)
+			data[16 + k] = (uint8_t) (hash(options_.seed, 4, event.badge, k) & 0xFF);
+
+		memset(scan_report, 0, sizeof(ble_gap_evt_adv_report_t));
+		memcpy(scan_report->peer_addr.addr, &data[16], 6);
+		double rssi = (event.rssi < -127) ? -127 : ((event.rssi > 0) ? 0 : event.rssi);
+		scan_report->rssi = (int8_t) lround(rssi);
+		scan_report->dlen = sizeof(data);
+		memcpy((uint8_t*) scan_report->data, data, sizeof(data));
+	}
+
+	static uint16_t badge_id(uint32_t badge) {
+		return (uint16_t) (badge + 1);
+	}
+
+private:
+	/**@brief Function to compute the average RSSI of badge j at the observed badge (path-loss, walls and static shadowing).
+	 */
+	double average_rssi(uint32_t j) const {
+		uint32_t i = observed_;
+		double dx = x_[i] - x_[j], dy = y_[i] - y_[j];
+		double distance = sqrt(dx*dx + dy*dy);
+		if(distance < SIM_MIN_DISTANCE_M)
+			distance = SIM_MIN_DISTANCE_M;
+		double rssi = SIM_RSSI_AT_1M_DBM - 10.0*options_.path_loss_exponent*log10(distance);
+		for(size_t w = 0; w < floor_plan_.walls.size(); w++) {
+			const wall_t& wall = floor_plan_.walls[w];
+			if(segments_intersect(x_[i], y_[i], x_[j], y_[j], wall.x1, wall.y1, wall.x2, wall.y2))
+				rssi -= wall.loss_db;
+		}
+		// The shadowing is symmetric: the same for i->j and j->i
+		uint32_t a = (i < j) ? i : j, b = (i < j) ? j : i;
+		return rssi + SIM_SHADOWING_SIGMA_DB*gaussian(hash(options_.seed, 5, a, b));
+	}
+
+	adv_event_t next_event(uint32_t badge, double time_us) {
+		adv_event_t event;
+		event.time_us = (uint64_t) time_us;
+		event.badge = badge;
+		event.number = next_number_[badge]++;
+		event.rssi = average_rssi_[badge] + options_.fading_db*gaussian(hash(options_.seed, 6 + observed_, badge, event.number));
+		return event;
+	}
+
+	const options_t& options_;
+	const floor_plan_t& floor_plan_;
+	uint32_t observed_;
+	uint32_t audible_badges_;
+	std::vector<double> x_, y_;
+	std::vector<double> average_rssi_;
+	std::vector<uint32_t> next_number_;
+	std::priority_queue<adv_event_t, std::vector<adv_event_t>, adv_event_later> queue_;	/**< The next event of every badge */
+	std::deque<adv_event_t> pending_;	/**< Events that might still overlap with events in the queue */
+	std::deque<adv_event_t> history_;	/**< The last finished events */
+};
+
+
+static ret_code_t init_badge(uint16_t ID) {
+	ret_code_t ret;
+
+	timer_enable_virtual_time(1);
+	APP_SCHED_INIT(4, 100);
+	APP_TIMER_INIT(0, 60, NULL);
+
+	debug_init();
+	trace_init();
+
+	ret = systick_init(0);
+	if(ret != NRF_SUCCESS) return ret;
+
+	ret = timeout_init();
+	if(ret != NRF_SUCCESS) return ret;
+
+	ret = ble_init();
+	if(ret != NRF_SUCCESS) return ret;
+
+	ret = sampling_init();
+	if(ret != NRF_SUCCESS) return ret;
+
+	ret = storer_init();
+	if(ret != NRF_SUCCESS) return ret;
+
+	advertiser_init();
+
+	BadgeAssignement badge_assignement;
+	badge_assignement.ID = ID;
+	badge_assignement.group = SIM_GROUP;
+	ret = advertiser_set_badge_assignement(badge_assignement);
+	if(ret != NRF_SUCCESS) return ret;
+
+	return advertiser_start_advertising();
+}
+
+/**@brief Function to read out the stored scan chunks.
+ */
+static void count_stored_scan_chunks(badge_result_t* result) {
+	static ScanChunk scan_chunk;
+	static uint8_t buf[512];
+	Timestamp timestamp;
+	timestamp.seconds = 0;
+	timestamp.ms = 0;
+	if(storer_find_scan_chunk_from_timestamp(timestamp) != NRF_SUCCESS)
+		return;
+	while(storer_get_next_scan_chunk(&scan_chunk) == NRF_SUCCESS) {
+		tb_ostream_t ostream = tb_ostream_from_buffer(buf, sizeof(buf));
+		tb_encode(&ostream, ScanChunk_fields, &scan_chunk, TB_LITTLE_ENDIAN);
+		result->stored_chunks++;
+		result->stored_devices += scan_chunk.scan_result_data_count;
+		result->stored_bytes += ostream.bytes_written;
+	}
+}
+
+/**@brief Function to simulate one observed badge (in a child-process).
+ */
+static void run_observed_badge(const options_t& options, const floor_plan_t& floor_plan, uint32_t number_of_badges, uint32_t observed, badge_result_t* result) {
+	memset(result, 0, sizeof(badge_result_t));
+	result->status = (int32_t) init_badge(RadioChannel::badge_id(observed));
+	if(result->status != NRF_SUCCESS)
+		return;
+	result->status = (int32_t) sampling_start_scan(0, options.scan_period_seconds, options.scan_interval_ms, options.scan_window_ms, options.scan_duration_seconds, SIM_GROUP, 0, 0);
+	if(result->status != NRF_SUCCESS)
+		return;
+
+	RadioChannel channel(options, floor_plan, number_of_badges, observed);
+	result->audible_badges = channel.audible_badges();
+
+	// The IDs in the order of the sampling chunk, to count the steps of the linear search of the firmware
+	std::vector<int32_t> index_of_id(65536, -1);
+	std::vector<uint16_t> ids_of_scan;
+	uint8_t scanning = 0;
+	uint64_t scanning_since_us = 0;
+
+	uint64_t end_us = ((uint64_t) options.duration_seconds)*1000000;
+	ble_gap_evt_adv_report_t scan_report;
+	while(1) {
+		bool lost;
+		adv_event_t event = channel.next_finished_event(&lost);
+		if(event.time_us >= end_us)
+			break;
+		uint64_t now = timer_get_microseconds_since_start();
+		if(event.time_us > now)
+			timer_virtual_run_for(event.time_us - now, app_sched_execute);
+
+		uint8_t is_scanning = (ble_get_state() == BLE_STATE_SCANNING);
+		if(is_scanning && !scanning) {	// A new scan (and sampling chunk) started
+			for(size_t k = 0; k < ids_of_scan.size(); k++)
+				index_of_id[ids_of_scan[k]] = -1;
+			ids_of_scan.clear();
+			scanning_since_us = event.time_us;
+			result->scans++;
+		} else if(!is_scanning && scanning) {
+			result->scan_seconds += (event.time_us - scanning_since_us) / 1e6;
+			result->distinct_ids += ids_of_scan.size();
+		}
+		scanning = is_scanning;
+
+		if(event.badge == observed || event.rssi < SIM_SENSITIVITY_DBM || !ble_simulate_is_scan_window_open())
+			continue;
+		result->heard_events++;
+		if(lost) {
+			result->lost_events++;
+			continue;
+		}
+
+		uint16_t ID = RadioChannel::badge_id(event.badge);
+		if(index_of_id[ID] >= 0) {
+			result->search_steps += (uint64_t) index_of_id[ID] + 1;
+		} else {
+			result->search_steps += ids_of_scan.size();
+			if(ids_of_scan.size() < SCAN_SAMPLING_CHUNK_DATA_SIZE) {
+				index_of_id[ID] = (int32_t) ids_of_scan.size();
+				ids_of_scan.push_back(ID);
+			}
+		}
+		channel.fill_scan_report(event, &scan_report);
+		uint64_t start_ns = sim_get_host_nanoseconds();
+		ble_simulate_scan_report(&scan_report);
+		result->report_host_ns += sim_get_host_nanoseconds() - start_ns;
+		result->reports++;
+	}
+	if(scanning) {
+		result->scan_seconds += (end_us - scanning_since_us) / 1e6;
+		result->distinct_ids += ids_of_scan.size();
+	}
+
+	// Let the processing store the last finished chunks
+	timer_virtual_run_for(SIM_STORE_TIME_US, app_sched_execute);
+	sampling_stop_scan(0);
+
+	chunk_fifo_statistics_t statistics;
+	sampling_get_chunk_fifo_statistics(SAMPLING_SCAN, &statistics);
+	result->dropped_chunks = statistics.dropped_chunks;
+	result->high_water_mark = statistics.high_water_mark;
+	count_stored_scan_chunks(result);
+}
+
+
+/**@brief Function to simulate all observed badges of one room in child-processes (at most options.jobs at the same time).
+ *
+ * @retval	0 on success, -1 if a badge could not be simulated.
+ */
+static int simulate_room(const options_t& options, const floor_plan_t& floor_plan, uint32_t number_of_badges, std::vector<badge_result_t>* results) {
+	uint32_t observe = (options.observe < number_of_badges) ? options.observe : number_of_badges;
+	results->assign(observe, badge_result_t());
+	std::vector<int> exit_reasons(observe);
+	if(sim_run_jobs(observe, options.jobs, 0, sizeof(badge_result_t), [&](uint32_t index, void* result) {
+				uint32_t observed = (uint32_t) (((uint64_t) index) * number_of_badges / observe);
+				run_observed_badge(options, floor_plan, number_of_badges, observed, (badge_result_t*) result);
+			}, results->data(), exit_reasons.data()) != 0)
+		return -1;
+
+	int ret = 0;
+	for(uint32_t k = 0; k < observe; k++) {
+		if(exit_reasons[k] != 0 || (*results)[k].status != NRF_SUCCESS) {
+			fprintf(stderr, "SCAN_DENSITY_SIM: Badge %u of %u failed (status %d)\n", (unsigned) k, (unsigned) number_of_badges, (exit_reasons[k] == 0) ? (int) (*results)[k].status : -1);
+			ret = -1;
+		}
+	}
+	return ret;
+}
+
+static void print_header(void) {
+	printf("%7s %8s %9s %7s %10s %10s %10s %11s %8s %12s %8s %7s %10s %11s\n",
+			"badges", "audible", "heard/s", "lost%", "reports/s", "steps/s", "ns/report", "cpu us/s", "IDs/scan",
+			"devs/chunk", "dropped", "hwm", "chunks/min", "bytes/min");
+}
+
+static void print_row(uint32_t number_of_badges, const std::vector<badge_result_t>& results, double duration_seconds) {
+	double audible = 0, heard = 0, lost = 0, reports = 0, steps = 0, host_ns = 0, scan_seconds = 0, distinct_ids = 0, scans = 0;
+	double dropped = 0, high_water_mark = 0, stored_chunks = 0, stored_devices = 0, stored_bytes = 0;
+	for(size_t k = 0; k < results.size(); k++) {
+		const badge_result_t& r = results[k];
+		audible += r.audible_badges;
+		heard += r.heard_events;
+		lost += r.lost_events;
+		reports += r.reports;
+		steps += r.search_steps;
+		host_ns += r.report_host_ns;
+		scan_seconds += r.scan_seconds;
+		distinct_ids += r.distinct_ids;
+		scans += r.scans;
+		dropped += r.dropped_chunks;
+		high_water_mark = (r.high_water_mark > high_water_mark) ? r.high_water_mark : high_water_mark;
+		stored_chunks += r.stored_chunks;
+		stored_devices += r.stored_devices;
+		stored_bytes += r.stored_bytes;
+	}
+	double n = (double) results.size();
+	if(n == 0 || scan_seconds <= 0) {
+		printf("%7u (no scan in the simulated time)\n", (unsigned) number_of_badges);
+		return;
+	}
+	// Rates while scanning are per second of scanning, the storage-rates per minute of the simulated time
+	printf("%7u %8.1f %9.1f %7.1f %10.1f %10.0f %10.0f %11.1f %8.1f %12.1f %8.1f %7.0f %10.2f %11.0f\n",
+			(unsigned) number_of_badges, audible/n, heard/scan_seconds, (heard > 0) ? 100.0*lost/heard : 0.0,
+			reports/scan_seconds, steps/scan_seconds, (reports > 0) ? host_ns/reports : 0.0, host_ns/1000.0/scan_seconds,
+			(scans > 0) ? distinct_ids/scans : 0.0, (stored_chunks > 0) ? stored_devices/stored_chunks : 0.0,
+			dropped/n, high_water_mark, stored_chunks/n/(duration_seconds/60.0), stored_bytes/n/(duration_seconds/60.0));
+	fflush(stdout);
+}
+
+static void print_usage(const char* program) {
+	fprintf(stderr, "Usage: %s [--badges N[,N...]] [--floor-plan FILE] [--room WIDTHxHEIGHT] [--observe K] [--duration SECONDS]\n"
+			"\t\t[--scan PERIOD,INTERVAL,WINDOW,DURATION] [--path-loss-exponent X] [--fading DB] [--seed SEED] [--jobs J]\n", program);
+}
+
+
+int main(int argc, char** argv) {
+	options_t options;
+	options.observe = 4;
+	options.duration_seconds = 300;
+	options.scan_period_seconds = 60;
+	options.scan_interval_ms = 300;
+	options.scan_window_ms = 100;
+	options.scan_duration_seconds = 5;
+	options.path_loss_exponent = 2.5;
+	options.fading_db = 3.0;
+	options.seed = 1;
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	options.jobs = (cpus > 0) ? (uint32_t) cpus : 1;
+
+	floor_plan_t floor_plan;
+	floor_plan.width = 20;
+	floor_plan.height = 20;
+	const char* badges = "10,50,100,300";
+
+	for(int i = 1; i < argc; i++) {
+		if(strcmp(argv[i], "--badges") == 0 && i + 1 < argc) {
+			badges = argv[++i];
+		} else if(strcmp(argv[i], "--floor-plan") == 0 && i + 1 < argc) {
+			if(read_floor_plan(argv[++i], &floor_plan) != 0)
+				return 1;
+		} else if(strcmp(argv[i], "--room") == 0 && i + 1 < argc) {
+			if(sscanf(argv[++i], "%lfx%lf", &floor_plan.width, &floor_plan.height) != 2) {
+				print_usage(argv[0]);
+				return 1;
+			}
+		} else if(strcmp(argv[i], "--observe") == 0 && i + 1 < argc) {
+			options.observe = (uint32_t) atoi(argv[++i]);
+		} else if(strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+			options.duration_seconds = (uint32_t) atoi(argv[++i]);
+		} else if(strcmp(argv[i], "--scan") == 0 && i + 1 < argc) {
+			unsigned period, interval, window, duration;
+			if(sscanf(argv[++i], "%u,%u,%u,%u", &period, &interval, &window, &duration) != 4) {
+				print_usage(argv[0]);
+				return 1;
+			}
+			options.scan_period_seconds = (uint16_t) period;
+			options.scan_interval_ms = (uint16_t) interval;
+			options.scan_window_ms = (uint16_t) window;
+			options.scan_duration_seconds = (uint16_t) duration;
+		} else if(strcmp(argv[i], "--path-loss-exponent") == 0 && i + 1 < argc) {
+			options.path_loss_exponent = atof(argv[++i]);
+		} else if(strcmp(argv[i], "--fading") == 0 && i + 1 < argc) {
+			options.fading_db = atof(argv[++i]);
+		} else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			options.seed = strtoull(argv[++i], NULL, 10);
+		} else if(strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+			options.jobs = (uint32_t) atoi(argv[++i]);
+		} else {
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	std::string badges_list(badges);
+	for(size_t pos = 0; pos < badges_list.size(); ) {
+		size_t end = badges_list.find(',', pos);
+		if(end == std::string::npos)
+			end = badges_list.size();
+		int number = atoi(badges_list.substr(pos, end - pos).c_str());
+		if(number > 0 && number < 65535)
+			options.number_of_badges.push_back((uint32_t) number);
+		pos = end + 1;
+	}
+	if(options.number_of_badges.empty() || options.observe == 0 || options.jobs == 0 || options.duration_seconds == 0) {
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	printf("Room %.1f x %.1f m, %u walls, %u observed badges, %u s, scan every %u s for %u s (interval %u ms, window %u ms)\n",
+			floor_plan.width, floor_plan.height, (unsigned) floor_plan.walls.size(), (unsigned) options.observe, (unsigned) options.duration_seconds,
+			options.scan_period_seconds, options.scan_duration_seconds, options.scan_interval_ms, options.scan_window_ms);
+	print_header();
+	int ret = 0;
+	for(size_t k = 0; k < options.number_of_badges.size(); k++) {
+		std::vector<badge_result_t> results;
+		if(simulate_room(options, floor_plan, options.number_of_badges[k], &results) != 0)
+			ret = 1;
+		print_row(options.number_of_badges[k], results, options.duration_seconds);
+	}
+	return ret;
+}
@@ -0,0 +1,86 @@
+#include "sim_lib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <vector>
+
+
+uint64_t sim_mix(uint64_t value) {
+	value += 0x9E3779B97F4A7C15ULL;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+	return value ^ (value >> 31);
+}
+
+uint64_t sim_get_host_nanoseconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t) ts.tv_sec)*1000000000 + (uint64_t) ts.tv_nsec;
+}
+
+ssize_t sim_read_all(int fd, void* data, size_t len) {
+	size_t done = 0;
+	while(done < len) {
+		ssize_t n = read(fd, ((uint8_t*) data) + done, len - done);
+		if(n <= 0)
+			break;
+		done += (size_t) n;
+	}
+	return (ssize_t) done;
+}
+
+int sim_run_jobs(uint32_t number, uint32_t max_jobs, uint32_t timeout_s, size_t result_size, sim_job_function_t job, void* results, int* exit_reasons) {
+	std::vector<int> pipe_of_child(number, -1);
+	std::vector<pid_t> pid_of_child(number, -1);
+	uint32_t started = 0, finished = 0;
+	while(finished < number) {
+		if(started < number && started - finished < max_jobs) {
+			int fds[2];
+			if(pipe(fds) != 0) {
+				perror("pipe");
+				return -1;
+			}
+			fflush(stdout);
+			pid_t pid = fork();
+			if(pid < 0) {
+				perror("fork");
+				return -1;
+			}
+			if(pid == 0) {
+				close(fds[0]);
+				if(freopen("/dev/null", "w", stdout) == NULL)	// The debug-log of the firmware
+					_exit(1);
+				if(timeout_s > 0)
+					alarm(timeout_s);
+				std::vector<uint8_t> result(result_size);
+				job(started, result.data());
+				ssize_t len = write(fds[1], result.data(), result_size);
+				_exit((len == (ssize_t) result_size) ? 0 : 1);
+			}
+			close(fds[1]);
+			pipe_of_child[started] = fds[0];
+			pid_of_child[started] = pid;
+			started++;
+			continue;
+		}
+
+		int status;
+		pid_t pid = wait(&status);
+		if(pid < 0) {
+			perror("wait");
+			return -1;
+		}
+		for(uint32_t k = 0; k < started; k++) {
+			if(pid_of_child[k] != pid)
+				continue;
+			ssize_t len = sim_read_all(pipe_of_child[k], ((uint8_t*) results) + k*result_size, result_size);
+			close(pipe_of_child[k]);
+			exit_reasons[k] = WIFSIGNALED(status) ? WTERMSIG(status) : ((len == (ssize_t) result_size) ? 0 : -1);
+			finished++;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,51 @@
+#ifndef __SIM_LIB_H
+#define __SIM_LIB_H
+
+/**@file
+ * @details	Helper functions that are shared by the simulators (make power_loss_sim, make scan_density_sim):
+ *			deterministic pseudo-random numbers, the host time, and a pool of forked child-processes,
+ *			so that every simulated badge/trial starts from a fresh copy of the firmware state.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <functional>
+
+
+/**@brief Function to mix the bits of a value (splitmix64), to derive deterministic pseudo-random numbers from indices.
+ */
+uint64_t sim_mix(uint64_t value);
+
+/**@brief Function to retrieve the monotonic time of the host in nanoseconds (e.g. to measure the CPU-cost of a firmware function).
+ */
+uint64_t sim_get_host_nanoseconds(void);
+
+/**@brief Function to read len bytes from a file descriptor (a pipe could return less bytes per read).
+ *
+ * @retval	The number of bytes read (less than len at the end of the data).
+ */
+ssize_t sim_read_all(int fd, void* data, size_t len);
+
+
+typedef std::function<void(uint32_t index, void* result)> sim_job_function_t;
+
+/**@brief Function to run number jobs in forked child-processes, at most max_jobs at the same time.
+ *
+ * @details	Every child-process redirects its stdout (the debug-log of the firmware) to /dev/null, calls job(index, result)
+ *			and sends the result_size bytes of the result to the parent via a pipe.
+ *
+ * @param[in]	number			Number of jobs.
+ * @param[in]	max_jobs		Maximal number of child-processes at the same time.
+ * @param[in]	timeout_s		Time after which a child-process is killed by SIGALRM (0: no timeout).
+ * @param[in]	result_size		Size of the result of a job in bytes.
+ * @param[in]	job				The function that is run in the child-process.
+ * @param[out]	results			Array of number results (number*result_size bytes).
+ * @param[out]	exit_reasons	Array of number exit reasons: 0 if the result was received, the signal if the child-process was killed,
+ *								-1 if the result is incomplete.
+ *
+ * @retval	0 on success, -1 if a pipe or a child-process could not be created (perror() is called).
+ */
+int sim_run_jobs(uint32_t number, uint32_t max_jobs, uint32_t timeout_s, size_t result_size, sim_job_function_t job, void* results, int* exit_reasons);
+
+#endif
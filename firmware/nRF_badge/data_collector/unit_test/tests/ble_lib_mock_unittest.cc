@@ -12,6 +12,9 @@
 /** Include some (private) functions only for testing purposes */
 extern uint32_t ble_transmit_fifo_get_size(void);
 extern ret_code_t ble_transmit_fifo_read(uint8_t* data, uint32_t len);
+extern uint32_t ble_transmit_get_transmitted_bytes(void);
+
+#define NUMBER_OF_TX_BUFFERS_TEST	6
 
 /** Some variables and (callback) functions to test functionallity) */
 static volatile uint8_t connected = 0;
@@ -84,7 +87,6 @@ class BLELibMockTest : public ::testing::Test {
 		callback_generator_ble_on_connect_reset();
 		callback_generator_ble_on_disconnect_reset();
 		callback_generator_ble_on_receive_reset();
-		callback_generator_ble_on_transmit_complete_reset();
 		callback_generator_ble_on_scan_report_reset();
 		callback_generator_ble_on_scan_timeout_reset();
 		data_generator_ble_get_MAC_address_reset();
@@ -159,11 +161,23 @@ TEST_F(BLELibMockTest, TransmitTest) {
 	EXPECT_EQ(ret, NRF_SUCCESS);
 	EXPECT_EQ(transmitted, 0);
 	
+	// Fill all the notification buffers until the next connection event
+	for(uint8_t i = 1; i < NUMBER_OF_TX_BUFFERS_TEST; i++) {
+		ret = ble_transmit(data, 20);
+		EXPECT_EQ(ret, NRF_SUCCESS);
+	}
+	ret = ble_transmit(data, 20);
+	EXPECT_EQ(ret, NRF_ERROR_BUSY);
 	
-	while(	!callback_generator_ble_on_transmit_complete_is_ready() );
+	while(!transmitted);
 	
 	EXPECT_EQ(transmitted, 1);
-	EXPECT_EQ(ble_transmit_fifo_get_size(), 20);
+	EXPECT_EQ(ble_transmit_fifo_get_size(), 20*NUMBER_OF_TX_BUFFERS_TEST);
+	EXPECT_EQ(ble_transmit_get_transmitted_bytes(), 20*NUMBER_OF_TX_BUFFERS_TEST);
+	
+	// The buffers are free again after the connection event
+	ret = ble_transmit(data, 20);
+	EXPECT_EQ(ret, NRF_SUCCESS);
 	
 }
 
@@ -149,4 +149,87 @@ TEST(ChunkFifoTest, MultipleElementsTest) {
 	
 }
 
+TEST(ChunkFifoTest, OverflowStatisticsTest) {
+	chunk_fifo_t chunk_fifo;
+	ret_code_t ret;
+	CHUNK_FIFO_INIT(ret, chunk_fifo, 3, 100, 4);
+	
+	chunk_fifo_statistics_t statistics;
+	chunk_fifo_get_statistics(&chunk_fifo, &statistics);
+	EXPECT_EQ(statistics.dropped_chunks, 0);
+	EXPECT_EQ(statistics.high_water_mark, 0);
+	EXPECT_EQ(statistics.chunk_num, 3);
+	
+	data_t*	data = NULL;
+	for(uint8_t i = 0; i < 5; i++) {
+		chunk_fifo_write_open(&chunk_fifo, (void**)&data, NULL);
+		ret = chunk_fifo_write_close(&chunk_fifo);
+		EXPECT_EQ(ret, (i < 3) ? NRF_SUCCESS : NRF_ERROR_NO_MEM);
+	}
+	
+	chunk_fifo_get_statistics(&chunk_fifo, &statistics);
+	EXPECT_EQ(statistics.dropped_chunks, 2);
+	EXPECT_EQ(statistics.high_water_mark, 3);
+	
+	// Read all chunks, the high-water mark should stay
+	data_t* data_read;
+	while(chunk_fifo_read_open(&chunk_fifo, (void**) &data_read, NULL) == NRF_SUCCESS) {
+		chunk_fifo_read_close(&chunk_fifo);
+	}
+	chunk_fifo_get_statistics(&chunk_fifo, &statistics);
+	EXPECT_EQ(statistics.high_water_mark, 3);
+	
+	// Reset the statistics, the high-water mark should be the current number of chunks
+	chunk_fifo_write_open(&chunk_fifo, (void**)&data, NULL);
+	chunk_fifo_write_close(&chunk_fifo);
+	chunk_fifo_reset_statistics(&chunk_fifo);
+	chunk_fifo_get_statistics(&chunk_fifo, &statistics);
+	EXPECT_EQ(statistics.dropped_chunks, 0);
+	EXPECT_EQ(statistics.high_water_mark, 1);
+}
+
+TEST(ChunkFifoTest, DropOldestTest) {
+	chunk_fifo_t chunk_fifo;
+	ret_code_t ret;
+	CHUNK_FIFO_INIT(ret, chunk_fifo, 3, 100, 4);
+	chunk_fifo_set_overflow_policy(&chunk_fifo, CHUNK_FIFO_OVERFLOW_DROP_OLDEST);
+	
+	// Write 5 chunks numbered from 0 to 4
+	data_t*	data = NULL;
+	for(uint8_t i = 0; i < 5; i++) {
+		chunk_fifo_write_open(&chunk_fifo, (void**)&data, NULL);
+		data->buf[0] = i;
+		ret = chunk_fifo_write_close(&chunk_fifo);
+		EXPECT_EQ(ret, (i < 3) ? NRF_SUCCESS : NRF_ERROR_NO_MEM);
+	}
+	EXPECT_EQ(chunk_fifo_get_number_of_chunks(&chunk_fifo), 3);
+	
+	// The two oldest chunks should have been dropped
+	data_t* data_read;
+	ret = chunk_fifo_read_open(&chunk_fifo, (void**) &data_read, NULL);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_EQ(data_read->buf[0], 2);
+	
+	// While the oldest chunk is opened for reading, it must not be dropped --> the newest one is dropped
+	chunk_fifo_write_open(&chunk_fifo, (void**)&data, NULL);
+	data->buf[0] = 5;
+	ret = chunk_fifo_write_close(&chunk_fifo);
+	EXPECT_EQ(ret, NRF_ERROR_NO_MEM);
+	EXPECT_EQ(data_read->buf[0], 2);
+	chunk_fifo_read_close(&chunk_fifo);
+	
+	ret = chunk_fifo_read_open(&chunk_fifo, (void**) &data_read, NULL);
+	EXPECT_EQ(data_read->buf[0], 3);
+	chunk_fifo_read_close(&chunk_fifo);
+	ret = chunk_fifo_read_open(&chunk_fifo, (void**) &data_read, NULL);
+	EXPECT_EQ(data_read->buf[0], 4);
+	chunk_fifo_read_close(&chunk_fifo);
+	ret = chunk_fifo_read_open(&chunk_fifo, (void**) &data_read, NULL);
+	EXPECT_EQ(ret, NRF_ERROR_NOT_FOUND);
+	
+	chunk_fifo_statistics_t statistics;
+	chunk_fifo_get_statistics(&chunk_fifo, &statistics);
+	EXPECT_EQ(statistics.dropped_chunks, 3);
+}
+
 };  
@@ -0,0 +1,111 @@
+// Don't forget gtest.h, which declares the testing framework.
+#include <stdlib.h>
+
+#include "gtest/gtest.h"
+#include "compression_lib.h"
+#include "tinybuf.h"
+#include "protocol_messages_02v1.h"
+
+
+#define TEST_DATA_SIZE		512
+
+
+static uint8_t data[TEST_DATA_SIZE];
+static uint8_t compressed[COMPRESSION_MAX_COMPRESSED_LEN(TEST_DATA_SIZE)];
+static uint8_t decompressed[TEST_DATA_SIZE];
+
+
+/**@brief Function to compress and decompress the data, and to check that the result is equal to the data.
+ *
+ * @retval	The compressed length.
+ */
+static uint32_t round_trip(uint32_t len) {
+	uint32_t compressed_len = 0;
+	uint32_t decompressed_len = 0;
+	EXPECT_EQ(compression_compress(data, len, compressed, sizeof(compressed), &compressed_len), NRF_SUCCESS);
+	EXPECT_LE(compressed_len, COMPRESSION_MAX_COMPRESSED_LEN(len));
+	EXPECT_EQ(compression_decompress(compressed, compressed_len, decompressed, sizeof(decompressed), &decompressed_len), NRF_SUCCESS);
+	EXPECT_EQ(decompressed_len, len);
+	EXPECT_EQ(memcmp(data, decompressed, len), 0);
+	return compressed_len;
+}
+
+
+namespace {
+
+TEST(CompressionTest, RoundTripTest) {
+	// Empty data
+	EXPECT_EQ(round_trip(0), 0);
+
+	// Random data: not compressible, at most one flag-byte per 8 bytes is added
+	srand(0);
+	for(uint32_t i = 0; i < TEST_DATA_SIZE; i++)
+		data[i] = (uint8_t) rand();
+	EXPECT_LE(round_trip(TEST_DATA_SIZE), COMPRESSION_MAX_COMPRESSED_LEN(TEST_DATA_SIZE));
+	EXPECT_EQ(round_trip(1), 2);
+	EXPECT_EQ(round_trip(9), 11);
+
+	// A run of the same byte (an overlapping match, longer than the maximum match length)
+	memset(data, 0x42, TEST_DATA_SIZE);
+	EXPECT_LT(round_trip(TEST_DATA_SIZE), 8);
+
+	// A repeated pattern that is not aligned to the window
+	for(uint32_t i = 0; i < TEST_DATA_SIZE; i++)
+		data[i] = (uint8_t) ((i % 37) * 7);
+	EXPECT_LT(round_trip(TEST_DATA_SIZE), TEST_DATA_SIZE/4);
+
+	// Matches that are (nearly) COMPRESSION_WINDOW_SIZE bytes away
+	for(uint32_t i = 0; i < TEST_DATA_SIZE; i++)
+		data[i] = (i < COMPRESSION_WINDOW_SIZE) ? (uint8_t) rand() : data[i - COMPRESSION_WINDOW_SIZE];
+	EXPECT_LT(round_trip(TEST_DATA_SIZE), COMPRESSION_MAX_COMPRESSED_LEN(COMPRESSION_WINDOW_SIZE) + 8);
+}
+
+TEST(CompressionTest, ExceptionTest) {
+	uint32_t compressed_len = 0;
+	uint32_t decompressed_len = 0;
+	srand(1);
+	for(uint32_t i = 0; i < TEST_DATA_SIZE; i++)
+		data[i] = (uint8_t) rand();
+
+	// Compressed data would be larger than the uncompressed data
+	EXPECT_EQ(compression_compress(data, TEST_DATA_SIZE, compressed, TEST_DATA_SIZE - 1, &compressed_len), NRF_ERROR_NO_MEM);
+
+	// Decompressed data don't fit into the buffer
+	memset(data, 0, TEST_DATA_SIZE);
+	ASSERT_EQ(compression_compress(data, TEST_DATA_SIZE, compressed, sizeof(compressed), &compressed_len), NRF_SUCCESS);
+	EXPECT_EQ(compression_decompress(compressed, compressed_len, decompressed, TEST_DATA_SIZE - 1, &decompressed_len), NRF_ERROR_NO_MEM);
+
+	// A match that references bytes before the start of the data
+	uint8_t malformed_offset[] = {0x01, 0x00, 0x00};
+	EXPECT_EQ(compression_decompress(malformed_offset, sizeof(malformed_offset), decompressed, sizeof(decompressed), &decompressed_len), NRF_ERROR_INVALID_DATA);
+
+	// A truncated match
+	uint8_t malformed_len[] = {0x02, 0x55, 0x00};
+	EXPECT_EQ(compression_decompress(malformed_len, sizeof(malformed_len), decompressed, sizeof(decompressed), &decompressed_len), NRF_ERROR_INVALID_DATA);
+}
+
+TEST(CompressionTest, MicrophoneResponseTest) {
+	// A microphone data response with slowly changing values (like in a quiet room)
+	Response response;
+	memset(&response, 0, sizeof(response));
+	response.which_type = Response_microphone_data_response_tag;
+	response.type.microphone_data_response.timestamp.seconds = 1500000000;
+	response.type.microphone_data_response.sample_period_ms = 50;
+	response.type.microphone_data_response.microphone_data_count = PROTOCOL_MICROPHONE_DATA_SIZE;
+	srand(2);
+	uint8_t value = 20;
+	for(uint32_t i = 0; i < PROTOCOL_MICROPHONE_DATA_SIZE; i++) {
+		if((rand() % 8) == 0)
+			value = (uint8_t) (value + (rand() % 5) - 2);
+		response.type.microphone_data_response.microphone_data[i].value = value;
+	}
+
+	tb_ostream_t ostream = tb_ostream_from_buffer(data, sizeof(data));
+	ASSERT_EQ(tb_encode(&ostream, Response_fields, &response, TB_BIG_ENDIAN), 1);
+	uint32_t len = ostream.bytes_written;
+	uint32_t compressed_len = round_trip(len);
+	EXPECT_LT(compressed_len, len);
+}
+
+
+};
@@ -3,12 +3,17 @@
 // Don't forget gtest.h, which declares the testing framework.
 
 #include "eeprom_lib.h"
+#include "storage_model_lib.h"
+#include "power_loss_lib.h"
+#include "timer_lib.h"
 #include "gtest/gtest.h"
 
 #define EEPROM_SIZE_TEST	(256*1024)
 
 
 extern void eeprom_write_to_file(const char* filename);
+extern ret_code_t eeprom_store_bkgnd(uint32_t address, const uint8_t* tx_data, uint32_t length_tx_data);
+extern ret_code_t eeprom_read_bkgnd(uint32_t address, uint8_t* rx_data, uint32_t length_rx_data);
 
 
 namespace {
@@ -94,4 +99,111 @@ TEST(EEPROMNullPointerTest, ReturnValueTest) {
 }
 
 
-};  
+TEST(EEPROMStorageModelTest, AccountingTest) {
+	storage_model_parameters_t parameters;
+	storage_model_get_default_parameters(&parameters);
+	storage_model_reset_statistics();
+	
+	// 200 bytes from address 100 are split at the page boundaries into 3 steps: 28, 128 and 44 bytes
+	uint8_t store_data[200];
+	memset(store_data, 0x34, sizeof(store_data));
+	ret_code_t ret = eeprom_store(100, store_data, sizeof(store_data));
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	
+	storage_model_statistics_t statistics;
+	storage_model_get_statistics(&statistics);
+	EXPECT_EQ(statistics.eeprom_write_cycles, 3);
+	// Per step: write-enable (1) + status poll (2) + command and address (4) + data + status poll (2)
+	EXPECT_EQ(statistics.spi_bytes, 3*(1 + 2 + 4 + 2) + sizeof(store_data));
+	EXPECT_EQ(statistics.eeprom_busy_us, 3*parameters.eeprom_write_cycle_us + (uint64_t) (statistics.spi_bytes/parameters.spi_bytes_per_us));
+	EXPECT_GT(statistics.charge_uah, 0);
+	
+	storage_model_reset_statistics();
+	uint8_t read_data[200];
+	ret = eeprom_read(100, read_data, sizeof(read_data));
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_TRUE(memcmp(store_data, read_data, sizeof(read_data)) == 0);
+	storage_model_get_statistics(&statistics);
+	EXPECT_EQ(statistics.eeprom_write_cycles, 0);
+	EXPECT_EQ(statistics.spi_bytes, 3*(4 + 2) + sizeof(read_data));
+	EXPECT_EQ(statistics.eeprom_reads, 1);
+	EXPECT_EQ(statistics.eeprom_read_bytes, sizeof(read_data));
+}
+
+TEST(EEPROMStorageModelTest, LatencyTest) {
+	storage_model_parameters_t parameters;
+	storage_model_get_default_parameters(&parameters);
+	// Another EEPROM with a faster write cycle
+	parameters.eeprom_write_cycle_us = 2000;
+	storage_model_set_parameters(&parameters);
+	storage_model_enable_latency(1);
+	
+	uint8_t store_data[10];
+	memset(store_data, 0x56, sizeof(store_data));
+	uint64_t start_us = timer_get_microseconds_since_start();
+	ret_code_t ret = eeprom_store(0, store_data, sizeof(store_data));
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_GE(timer_get_microseconds_since_start() - start_us, parameters.eeprom_write_cycle_us);
+	
+	ret = eeprom_store_bkgnd(0, store_data, sizeof(store_data));
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_EQ(eeprom_get_operation(), EEPROM_STORE_OPERATION);
+	ret = eeprom_read_bkgnd(0, store_data, sizeof(store_data));
+	EXPECT_EQ(ret, NRF_ERROR_BUSY);
+	while(eeprom_get_operation() != EEPROM_NO_OPERATION);
+	
+	storage_model_enable_latency(0);
+	storage_model_get_default_parameters(&parameters);
+	storage_model_set_parameters(&parameters);
+}
+
+
+TEST(EEPROMPowerLossTest, InterruptedStoreTest) {
+	power_loss_reset();
+	uint8_t store_data[20];
+	memset(store_data, 0x00, sizeof(store_data));
+	ret_code_t ret = eeprom_store(0, store_data, sizeof(store_data));
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	ret = eeprom_store(100, store_data, sizeof(store_data));
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	
+	// The store is interrupted after 7 bytes (the armed byte is taken modulo the length)
+	memset(store_data, 0xAB, sizeof(store_data));
+	power_loss_arm(0, sizeof(store_data) + 7);
+	ret = eeprom_store(0, store_data, sizeof(store_data));
+	EXPECT_TRUE(power_loss_occurred());
+	power_loss_event_t event;
+	power_loss_get_event(&event);
+	EXPECT_EQ(event.operation, POWER_LOSS_EEPROM_STORE);
+	EXPECT_EQ(event.address, 0);
+	EXPECT_EQ(event.len, sizeof(store_data));
+	EXPECT_EQ(event.written_len, 7);
+	
+	// All further stores have no effect
+	ret = eeprom_store(100, store_data, sizeof(store_data));
+	EXPECT_EQ(power_loss_get_write_operations(), 3);
+	
+	power_loss_reboot();
+	ret = eeprom_init();
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_FALSE(power_loss_occurred());
+	uint8_t read_data[20];
+	ret = eeprom_read(0, read_data, sizeof(read_data));
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	for(uint32_t i = 0; i < sizeof(read_data); i++)
+		EXPECT_EQ(read_data[i], (i < 7) ? 0xAB : 0x00) << "Byte " << i;
+	ret = eeprom_read(100, read_data, sizeof(read_data));
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_EQ(read_data[0], 0x00);
+	
+	// After the reboot, the stores work again
+	ret = eeprom_store(0, store_data, sizeof(store_data));
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	ret = eeprom_read(0, read_data, sizeof(read_data));
+	EXPECT_TRUE(memcmp(store_data, read_data, sizeof(read_data)) == 0);
+	
+	power_loss_reset();
+}
+
+
+};
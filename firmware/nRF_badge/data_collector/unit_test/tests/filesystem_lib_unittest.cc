@@ -622,7 +622,7 @@ TEST_F(FilesystemTest, DynamicIteratorReadTest) {
 	while(ret == NRF_SUCCESS) {
 		uint16_t element_len, record_id;
 	
-		ret = filesystem_iterator_read_element(partition_id, read_data, &element_len, &record_id);
+		ret = filesystem_iterator_read_element(partition_id, read_data, sizeof(read_data), &element_len, &record_id);
 		EXPECT_EQ(ret, NRF_SUCCESS);
 		EXPECT_EQ(element_len, j);
 		EXPECT_EQ(record_id, j + 1);
@@ -647,7 +647,7 @@ TEST_F(FilesystemTest, DynamicIteratorReadTest) {
 	while(ret == NRF_SUCCESS) {
 		uint16_t element_len, record_id;
 	
-		ret = filesystem_iterator_read_element(partition_id, read_data, &element_len, &record_id);
+		ret = filesystem_iterator_read_element(partition_id, read_data, sizeof(read_data), &element_len, &record_id);
 		EXPECT_EQ(ret, NRF_SUCCESS);
 		EXPECT_EQ(element_len, j);
 		EXPECT_EQ(record_id, j + 1);
@@ -705,10 +705,14 @@ TEST_F(FilesystemTest, StaticIteratorReadTest) {
 	while(ret == NRF_SUCCESS) {
 		uint16_t element_len, record_id;
 	
-		ret = filesystem_iterator_read_element(partition_id, read_data, &element_len, &record_id);
+		ret = filesystem_iterator_read_element(partition_id, read_data, sizeof(read_data), &element_len, &record_id);
 		EXPECT_EQ(ret, NRF_SUCCESS);
 		EXPECT_EQ(element_len, 500);
 		EXPECT_EQ(record_id, j + 1);
+		
+		uint16_t iterator_record_id;
+		EXPECT_EQ(filesystem_iterator_get_record_id(partition_id, &iterator_record_id), NRF_SUCCESS);
+		EXPECT_EQ(iterator_record_id, record_id);
 
 		uint8_t data[1000];
 		for(uint16_t i =0; i < 1000; i++)
@@ -730,7 +734,7 @@ TEST_F(FilesystemTest, StaticIteratorReadTest) {
 	while(ret == NRF_SUCCESS) {
 		uint16_t element_len, record_id;
 	
-		ret = filesystem_iterator_read_element(partition_id, read_data, &element_len, &record_id);
+		ret = filesystem_iterator_read_element(partition_id, read_data, sizeof(read_data), &element_len, &record_id);
 		EXPECT_EQ(ret, NRF_SUCCESS);
 		EXPECT_EQ(element_len, 500);
 		EXPECT_EQ(record_id, j + 1);
@@ -746,7 +750,10 @@ TEST_F(FilesystemTest, StaticIteratorReadTest) {
 		ret = filesystem_iterator_next(partition_id);
 	}
 	EXPECT_EQ(ret, NRF_ERROR_NOT_FOUND);
-
+	
+	uint16_t iterator_record_id;
+	filesystem_iterator_invalidate(partition_id);
+	EXPECT_EQ(filesystem_iterator_get_record_id(partition_id, &iterator_record_id), NRF_ERROR_INVALID_STATE);
 }
 
 TEST_F(FilesystemTest, CorruptedDataTest) {
@@ -786,7 +793,7 @@ TEST_F(FilesystemTest, CorruptedDataTest) {
 	
 	uint8_t read_data[1000];
 	uint16_t element_len, record_id;
-	ret = filesystem_iterator_read_element(partition_id, read_data, &element_len, &record_id);
+	ret = filesystem_iterator_read_element(partition_id, read_data, sizeof(read_data), &element_len, &record_id);
 	EXPECT_EQ(ret, NRF_SUCCESS);
 	EXPECT_EQ(element_len, 1000);
 	EXPECT_EQ(record_id, 2);
@@ -802,7 +809,7 @@ TEST_F(FilesystemTest, CorruptedDataTest) {
 	// Manipulate one byte in element data
 	ret = storage_store(element_address + filesystem_get_element_header_len(partition_id) + 1, &tmp, 1);
 	EXPECT_EQ(ret, NRF_SUCCESS);
-	ret = filesystem_iterator_read_element(partition_id, read_data, &element_len, &record_id);
+	ret = filesystem_iterator_read_element(partition_id, read_data, sizeof(read_data), &element_len, &record_id);
 	EXPECT_EQ(ret, NRF_ERROR_INVALID_DATA);
 	
 	// Restore the entry
@@ -811,7 +818,7 @@ TEST_F(FilesystemTest, CorruptedDataTest) {
 	// Manipulate one byte in element header
 	ret = storage_store(element_address + filesystem_get_element_header_len(partition_id) - 1, &tmp, 1);
 	EXPECT_EQ(ret, NRF_SUCCESS);
-	ret = filesystem_iterator_read_element(partition_id, read_data, &element_len, &record_id);
+	ret = filesystem_iterator_read_element(partition_id, read_data, sizeof(read_data), &element_len, &record_id);
 	EXPECT_EQ(ret, NRF_ERROR_INVALID_STATE);
 	
 	// The iterator should stay in invalid state
@@ -839,7 +846,7 @@ TEST_F(FilesystemTest, CorruptedDataTest) {
 	ASSERT_EQ(ret, NRF_SUCCESS);
 	
 	// Read current (latest element)
-	ret = filesystem_iterator_read_element(partition_id, read_data, &element_len, &record_id);
+	ret = filesystem_iterator_read_element(partition_id, read_data, sizeof(read_data), &element_len, &record_id);
 	EXPECT_EQ(ret, NRF_SUCCESS);
 	EXPECT_EQ(element_len, 100);
 	EXPECT_EQ(record_id, 2);
@@ -854,7 +861,7 @@ TEST_F(FilesystemTest, CorruptedDataTest) {
 	// Manipulate one byte in element data
 	ret = storage_store(element_address + filesystem_get_element_header_len(partition_id) + 1, &tmp, 1);
 	EXPECT_EQ(ret, NRF_SUCCESS);
-	ret = filesystem_iterator_read_element(partition_id, read_data, &element_len, &record_id);
+	ret = filesystem_iterator_read_element(partition_id, read_data, sizeof(read_data), &element_len, &record_id);
 	EXPECT_EQ(ret, NRF_SUCCESS);	// Because we don't use CRC here, we could not detect corrupted data
 	
 	// Restore the entry
@@ -863,7 +870,7 @@ TEST_F(FilesystemTest, CorruptedDataTest) {
 	// Manipulate one byte in element header
 	ret = storage_store(element_address + filesystem_get_element_header_len(partition_id) - 1, &tmp, 1);
 	EXPECT_EQ(ret, NRF_SUCCESS);
-	ret = filesystem_iterator_read_element(partition_id, read_data, &element_len, &record_id);
+	ret = filesystem_iterator_read_element(partition_id, read_data, sizeof(read_data), &element_len, &record_id);
 	EXPECT_EQ(ret, NRF_ERROR_INVALID_STATE);
 	
 	// The iterator should stay in invalid state
@@ -1087,5 +1094,36 @@ TEST_F(FilesystemTest, IteratorConflictTest) {
 	EXPECT_EQ(ret, NRF_ERROR_INTERNAL);	
 }
 
-};
+TEST_F(FilesystemTest, IteratorMaxElementLenTest) {
+	
+	uint16_t partition_id = 0xFFFF;
+	uint32_t required_size = 2048;
+	
+	// Register a dynamic partition
+	ret_code_t ret = filesystem_register_partition(&partition_id, &required_size, 1, 1, 0);
+	ASSERT_EQ(ret, NRF_SUCCESS);
+	
+	uint8_t data[100];
+	for(uint16_t i = 0; i < sizeof(data); i++)
+		data[i] = i;
+	ret = filesystem_store_element(partition_id, data, sizeof(data));
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	
+	ret = filesystem_iterator_init(partition_id);
+	ASSERT_EQ(ret, NRF_SUCCESS);
+	
+	// The element doesn't fit into a smaller buffer (the buffer behind it must not be written)
+	uint8_t read_data[sizeof(data) + 1];
+	memset(read_data, 0, sizeof(read_data));
+	uint16_t element_len, record_id;
+	ret = filesystem_iterator_read_element(partition_id, read_data, sizeof(data) - 1, &element_len, &record_id);
+	EXPECT_EQ(ret, NRF_ERROR_INVALID_DATA);
+	EXPECT_EQ(read_data[1], 0);
+	
+	ret = filesystem_iterator_read_element(partition_id, read_data, sizeof(data), &element_len, &record_id);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_EQ(element_len, sizeof(data));
+	EXPECT_TRUE(memcmp(read_data, data, sizeof(data)) == 0);
+}
 
+};
@@ -3,6 +3,9 @@
 // Don't forget gtest.h, which declares the testing framework.
 
 #include "flash_lib.h"
+#include "storage_model_lib.h"
+#include "power_loss_lib.h"
+#include "timer_lib.h"
 #include "gtest/gtest.h"
 
 #define FLASH_NUM_PAGES_TEST			30
@@ -232,4 +235,148 @@ TEST(FlashNullPointerTest, ReturnValueTest) {
 
 
 
+TEST(FlashStorageModelTest, AccountingTest) {
+	storage_model_parameters_t parameters;
+	storage_model_get_default_parameters(&parameters);
+	storage_model_reset_statistics();
+	
+	ret_code_t ret = flash_erase(0, 2);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	uint32_t store_words[10];
+	memset(store_words, 0x12, sizeof(store_words));
+	ret = flash_store(0, store_words, 10);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	
+	storage_model_statistics_t statistics;
+	storage_model_get_statistics(&statistics);
+	EXPECT_EQ(statistics.flash_page_erases, 2);
+	EXPECT_EQ(statistics.flash_programmed_words, 10);
+	uint64_t expected_busy_us = 2*parameters.flash_page_erase_us + 10*parameters.flash_program_word_us;
+	EXPECT_EQ(statistics.flash_busy_us, expected_busy_us);
+	double expected_charge_uah = (2.0*parameters.flash_page_erase_us*parameters.flash_erase_current_ua + 10.0*parameters.flash_program_word_us*parameters.flash_program_current_ua)/3600000000.0;
+	EXPECT_NEAR(statistics.charge_uah, expected_charge_uah, 1e-9);
+	
+	// Without latency, the operations are finished directly
+	EXPECT_EQ(flash_get_operation(), FLASH_NO_OPERATION);
+}
+
+TEST(FlashStorageModelTest, LatencyTest) {
+	storage_model_parameters_t parameters;
+	storage_model_get_default_parameters(&parameters);
+	storage_model_enable_latency(1);
+	
+	// The blocking erase takes the modeled time
+	uint64_t start_us = timer_get_microseconds_since_start();
+	ret_code_t ret = flash_erase(0, 1);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_GE(timer_get_microseconds_since_start() - start_us, parameters.flash_page_erase_us);
+	
+	// The background store is ongoing until the modeled time has passed
+	uint32_t store_word = 0x12345678;
+	ret = flash_store_bkgnd(0, &store_word, 1);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_TRUE(flash_get_operation() & FLASH_STORE_OPERATION);
+	ret = flash_store_bkgnd(1, &store_word, 1);
+	EXPECT_EQ(ret, NRF_ERROR_BUSY);
+	timer_sleep_microseconds(parameters.flash_program_word_us + 1);
+	EXPECT_EQ(flash_get_operation(), FLASH_NO_OPERATION);
+	
+	storage_model_enable_latency(0);
+}
+
+TEST(FlashStorageModelTest, ReadAccountingTest) {
+	storage_model_reset_statistics();
+	uint32_t read_words[8];
+	ret_code_t ret = flash_read(0, read_words, 8);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	ret = flash_read(8, read_words, 2);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	
+	storage_model_statistics_t statistics;
+	storage_model_get_statistics(&statistics);
+	EXPECT_EQ(statistics.flash_reads, 2);
+	EXPECT_EQ(statistics.flash_read_words, 10);
+	EXPECT_EQ(statistics.flash_busy_us, 0);
+}
+
+
+TEST(FlashPowerLossTest, InterruptedStoreTest) {
+	power_loss_reset();
+	ret_code_t ret = flash_erase(0, 1);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	
+	// The second store is interrupted after 5 bytes
+	uint32_t store_words[4];
+	memset(store_words, 0x00, sizeof(store_words));
+	power_loss_arm(1, 5);
+	ret = flash_store(0, store_words, 1);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_FALSE(power_loss_occurred());
+	ret = flash_store(4, store_words, 4);
+	EXPECT_TRUE(power_loss_occurred());
+	
+	power_loss_event_t event;
+	power_loss_get_event(&event);
+	EXPECT_EQ(event.operation, POWER_LOSS_FLASH_STORE);
+	EXPECT_EQ(event.address, 4*sizeof(uint32_t));
+	EXPECT_EQ(event.len, sizeof(store_words));
+	EXPECT_EQ(event.written_len, 5);
+	
+	// All further operations have no effect
+	ret = flash_store(8, store_words, 4);
+	EXPECT_EQ(power_loss_get_write_operations(), 3);	// The erase and the 2 stores
+	EXPECT_EQ(power_loss_get_written_bytes(), FLASH_PAGE_SIZE_WORDS_TEST*sizeof(uint32_t) + sizeof(uint32_t) + 5);
+	
+	// After the reboot, the content is retained
+	power_loss_reboot();
+	ret = flash_init();
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	uint8_t read_data[12*sizeof(uint32_t)];
+	ret = flash_read(0, (uint32_t*) read_data, 12);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	for(uint32_t i = 0; i < sizeof(read_data); i++) {
+		uint8_t expected = (i < sizeof(uint32_t) || (i >= 4*sizeof(uint32_t) && i < 4*sizeof(uint32_t) + 5)) ? 0x00 : 0xFF;
+		EXPECT_EQ(read_data[i], expected) << "Byte " << i;
+	}
+	
+	power_loss_reset();
+}
+
+TEST(FlashPowerLossTest, InterruptedEraseTest) {
+	power_loss_reset();
+	uint32_t store_words[2*FLASH_PAGE_SIZE_WORDS_TEST];
+	memset(store_words, 0x00, sizeof(store_words));
+	ret_code_t ret = flash_store(0, store_words, 2*FLASH_PAGE_SIZE_WORDS_TEST);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	
+	// The erase of 2 pages is interrupted in the middle of the first page
+	uint32_t erased_bytes = FLASH_PAGE_SIZE_WORDS_TEST*sizeof(uint32_t)/2;
+	power_loss_arm(0, erased_bytes);
+	ret = flash_erase(0, 2);
+	EXPECT_TRUE(power_loss_occurred());
+	power_loss_event_t event;
+	power_loss_get_event(&event);
+	EXPECT_EQ(event.operation, POWER_LOSS_FLASH_ERASE);
+	EXPECT_EQ(event.len, 2*FLASH_PAGE_SIZE_WORDS_TEST*sizeof(uint32_t));
+	
+	power_loss_reboot();
+	ret = flash_init();
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	uint32_t read_words[2*FLASH_PAGE_SIZE_WORDS_TEST];
+	ret = flash_read(0, read_words, 2*FLASH_PAGE_SIZE_WORDS_TEST);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_EQ(read_words[0], 0xFFFFFFFF);
+	EXPECT_EQ(read_words[erased_bytes/sizeof(uint32_t) - 1], 0xFFFFFFFF);
+	EXPECT_EQ(read_words[erased_bytes/sizeof(uint32_t)], 0);
+	EXPECT_EQ(read_words[2*FLASH_PAGE_SIZE_WORDS_TEST - 1], 0);
+	
+	// Without the reboot, the init clears the flash again
+	power_loss_reset();
+	ret = flash_init();
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	ret = flash_read(0, read_words, 2*FLASH_PAGE_SIZE_WORDS_TEST);
+	EXPECT_EQ(read_words[2*FLASH_PAGE_SIZE_WORDS_TEST - 1], 0xFFFFFFFF);
+}
+
+
 };
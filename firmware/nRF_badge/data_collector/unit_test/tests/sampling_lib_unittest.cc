@@ -0,0 +1,151 @@
+// Don't forget gtest.h, which declares the testing framework.
+
+#include "gtest/gtest.h"
+#include "app_timer.h"
+#include "app_scheduler.h"
+#include "systick_lib.h"
+#include "timeout_lib.h"
+#include "ble_lib.h"
+#include "advertiser_lib.h"
+#include "sampling_lib.h"
+#include "chunk_fifo_lib.h"
+#include "debug_lib.h"
+
+
+#define BATTERY_PERIOD_MS			60000	/**< Long enough that the sampling-timer does not fire during the test: the samples are triggered manually */
+#define MAX_CALLBACKS				100
+
+extern void sampling_battery_callback(void* p_context);
+
+namespace {
+
+class SamplingTest : public ::testing::Test {
+	virtual void SetUp() {
+		APP_SCHED_INIT(4, 100);
+		APP_TIMER_INIT(0, 60, NULL);
+
+		debug_init();
+
+		ret_code_t ret = systick_init(0);
+		EXPECT_EQ(ret, NRF_SUCCESS);
+
+		ret = timeout_init();
+		EXPECT_EQ(ret, NRF_SUCCESS);
+
+		ret = ble_init();
+		EXPECT_EQ(ret, NRF_SUCCESS);
+
+		advertiser_init();
+
+		ret = sampling_init();
+		EXPECT_EQ(ret, NRF_SUCCESS);
+	}
+	virtual void TearDown() {
+		sampling_stop_battery(0);
+	}
+};
+
+/**@brief Function to read (and discard) all finished chunks of a chunk-fifo, like the processing does when the storage keeps up. */
+static void drain_chunk_fifo(chunk_fifo_t* chunk_fifo) {
+	void* chunk;
+	while(chunk_fifo_read_open(chunk_fifo, &chunk, NULL) == NRF_SUCCESS)
+		chunk_fifo_read_close(chunk_fifo);
+}
+
+static uint8_t get_degrade_factor(sampling_configuration_t sampling_type) {
+	sampling_overflow_policy_t overflow_policy;
+	uint8_t degrade_factor = 0;
+	ret_code_t ret = sampling_get_overflow_policy(sampling_type, &overflow_policy, &degrade_factor);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	return degrade_factor;
+}
+
+
+TEST_F(SamplingTest, SetOverflowPolicyTest) {
+	sampling_overflow_policy_t overflow_policy;
+	uint8_t degrade_factor;
+
+	ret_code_t ret = sampling_get_overflow_policy(SAMPLING_MICROPHONE, &overflow_policy, &degrade_factor);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_EQ(overflow_policy, SAMPLING_OVERFLOW_DROP_NEWEST);
+	EXPECT_EQ(degrade_factor, 1);
+
+	ret = sampling_set_overflow_policy(SAMPLING_MICROPHONE, SAMPLING_OVERFLOW_DROP_OLDEST);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	ret = sampling_get_overflow_policy(SAMPLING_MICROPHONE, &overflow_policy, &degrade_factor);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	EXPECT_EQ(overflow_policy, SAMPLING_OVERFLOW_DROP_OLDEST);
+
+	// The accelerometer chunks have no fixed sampling period
+	ret = sampling_set_overflow_policy(SAMPLING_ACCELEROMETER, SAMPLING_OVERFLOW_DEGRADE_RATE);
+	EXPECT_EQ(ret, NRF_ERROR_INVALID_PARAM);
+
+	// Streaming flags are no data-sources
+	ret = sampling_set_overflow_policy(STREAMING_BATTERY, SAMPLING_OVERFLOW_DROP_OLDEST);
+	EXPECT_EQ(ret, NRF_ERROR_INVALID_PARAM);
+	ret = sampling_get_overflow_policy(STREAMING_BATTERY, &overflow_policy, &degrade_factor);
+	EXPECT_EQ(ret, NRF_ERROR_INVALID_PARAM);
+}
+
+TEST_F(SamplingTest, DegradeRateTest) {
+	ret_code_t ret = sampling_set_overflow_policy(SAMPLING_BATTERY, SAMPLING_OVERFLOW_DEGRADE_RATE);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+
+	ret = sampling_start_battery(0, BATTERY_PERIOD_MS, 0);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	drain_chunk_fifo(&battery_chunk_fifo);
+
+	// Nobody reads the chunk-fifo (e.g. the storage is busy) --> the factor is doubled with every overflow, up to the maximum
+	uint8_t degrade_factor = get_degrade_factor(SAMPLING_BATTERY);
+	EXPECT_EQ(degrade_factor, 1);
+	uint32_t callbacks = 0;
+	while(degrade_factor < SAMPLING_OVERFLOW_MAX_DEGRADE_FACTOR && callbacks < MAX_CALLBACKS) {
+		sampling_battery_callback(NULL);
+		callbacks++;
+		uint8_t new_degrade_factor = get_degrade_factor(SAMPLING_BATTERY);
+		EXPECT_TRUE(new_degrade_factor == degrade_factor || new_degrade_factor == 2*degrade_factor);
+		degrade_factor = new_degrade_factor;
+	}
+	EXPECT_EQ(degrade_factor, SAMPLING_OVERFLOW_MAX_DEGRADE_FACTOR);
+
+	chunk_fifo_statistics_t statistics;
+	sampling_get_chunk_fifo_statistics(SAMPLING_BATTERY, &statistics);
+	EXPECT_GT(statistics.dropped_chunks, 0);
+
+	// Further overflows don't degrade the rate further
+	for(uint32_t i = 0; i < 4*SAMPLING_OVERFLOW_MAX_DEGRADE_FACTOR; i++)
+		sampling_battery_callback(NULL);
+	EXPECT_EQ(get_degrade_factor(SAMPLING_BATTERY), SAMPLING_OVERFLOW_MAX_DEGRADE_FACTOR);
+
+	// Only every degrade_factor-th sample closes a chunk: the factor is halved at each chunk, while the chunk-fifo is drained
+	drain_chunk_fifo(&battery_chunk_fifo);
+	callbacks = 0;
+	while(degrade_factor > 1 && callbacks < MAX_CALLBACKS) {
+		sampling_battery_callback(NULL);
+		callbacks++;
+		drain_chunk_fifo(&battery_chunk_fifo);
+		uint8_t new_degrade_factor = get_degrade_factor(SAMPLING_BATTERY);
+		EXPECT_TRUE(new_degrade_factor == degrade_factor || 2*new_degrade_factor == degrade_factor);
+		degrade_factor = new_degrade_factor;
+	}
+	EXPECT_EQ(degrade_factor, 1);
+	// 8 + 4 + 2 samples at most, until the factor is back at 1
+	EXPECT_LE(callbacks, 14);
+}
+
+TEST_F(SamplingTest, DropNewestDoesNotDegradeTest) {
+	ret_code_t ret = sampling_set_overflow_policy(SAMPLING_BATTERY, SAMPLING_OVERFLOW_DROP_NEWEST);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+
+	ret = sampling_start_battery(0, BATTERY_PERIOD_MS, 0);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+
+	for(uint32_t i = 0; i < 20; i++) {
+		sampling_battery_callback(NULL);
+		EXPECT_EQ(get_degrade_factor(SAMPLING_BATTERY), 1);
+	}
+	drain_chunk_fifo(&battery_chunk_fifo);
+}
+
+
+};
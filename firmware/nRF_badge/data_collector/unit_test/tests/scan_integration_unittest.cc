@@ -15,6 +15,7 @@
 #include "sampling_lib.h"
 #include "app_scheduler.h"
 #include "debug_lib.h"
+#include "trace_lib.h"
 #include "chunk_messages.h"
 #include "processing_lib.h"
 
@@ -117,6 +118,7 @@ TEST_F(ScanIntegrationTest, Test) {
 	APP_TIMER_INIT(0, 60, NULL);
 	
 	debug_init();
+	trace_init();
 	
 	ret = systick_init(0);
 	EXPECT_EQ(ret, NRF_SUCCESS);
@@ -182,7 +184,7 @@ TEST_F(ScanIntegrationTest, Test) {
 	timestamp.seconds = 0;
 	timestamp.ms = 0;
 	
-	ret = storer_find_scan_chunk_from_timestamp(timestamp, &scan_chunk);
+	ret = storer_find_scan_chunk_from_timestamp(timestamp);
 	EXPECT_EQ(ret, NRF_SUCCESS);
 	
 	// Check if we generated at least SCAN_PRIORITIZED_BEACONS beacons. If not (unlikely, but could happen) --> restart/retry
@@ -198,6 +200,9 @@ TEST_F(ScanIntegrationTest, Test) {
 	} while(ret == NRF_SUCCESS);
 	EXPECT_EQ(number_of_stored_scan_chunks, NUMBER_OF_SCANS);
 	
+	// Dump the timeline of the test (open it with chrome://tracing or https://ui.perfetto.dev)
+	ret = trace_dump_chrome_json("scan_integration_trace.json");
+	EXPECT_EQ(ret, NRF_SUCCESS);
 }
 
 
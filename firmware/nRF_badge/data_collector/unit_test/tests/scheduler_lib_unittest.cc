@@ -0,0 +1,132 @@
+// Don't forget gtest.h, which declares the testing framework.
+
+#include "scheduler_lib.h"
+#include "app_scheduler.h"
+#include "gtest/gtest.h"
+
+#define SCHED_MAX_EVENT_DATA_SIZE sizeof(uint32_t)
+#define SCHED_QUEUE_SIZE 100
+
+
+namespace {
+
+class SchedulerTest : public ::testing::Test {
+	virtual void SetUp() {
+		APP_SCHED_INIT(SCHED_MAX_EVENT_DATA_SIZE, SCHED_QUEUE_SIZE);
+		scheduler_init();
+		execution_order_len = 0;
+	}
+public:
+	static uint32_t execution_order_len;
+};
+
+uint32_t SchedulerTest::execution_order_len = 0;
+char execution_order[200];
+
+void rx_tx_handler(void * p_event_data, uint16_t event_size) {
+	execution_order[SchedulerTest::execution_order_len++] = 'R';
+}
+void sampling_handler(void * p_event_data, uint16_t event_size) {
+	execution_order[SchedulerTest::execution_order_len++] = 'S';
+}
+void processing_handler(void * p_event_data, uint16_t event_size) {
+	execution_order[SchedulerTest::execution_order_len++] = 'P';
+}
+void housekeeping_handler(void * p_event_data, uint16_t event_size) {
+	execution_order[SchedulerTest::execution_order_len++] = 'H';
+}
+
+TEST_F(SchedulerTest, PriorityOrderTest) {
+	EXPECT_EQ(scheduler_event_put(SCHEDULER_PRIORITY_HOUSEKEEPING, housekeeping_handler), NRF_SUCCESS);
+	EXPECT_EQ(scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_handler), NRF_SUCCESS);
+	EXPECT_EQ(scheduler_event_put(SCHEDULER_PRIORITY_SAMPLING, sampling_handler), NRF_SUCCESS);
+	EXPECT_EQ(scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, rx_tx_handler), NRF_SUCCESS);
+	EXPECT_EQ(scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_handler), NRF_SUCCESS);
+
+	EXPECT_EQ(scheduler_get_pending_events(SCHEDULER_PRIORITY_PROCESSING), 2);
+	EXPECT_EQ(execution_order_len, 0);
+
+	app_sched_execute();
+
+	ASSERT_EQ(execution_order_len, 5);
+	EXPECT_EQ(std::string(execution_order, execution_order_len), "RSPPH");
+	EXPECT_EQ(scheduler_get_pending_events(SCHEDULER_PRIORITY_PROCESSING), 0);
+}
+
+TEST_F(SchedulerTest, LatencyTest) {
+	// Heavy processing load, then a request arrives
+	for(uint32_t i = 0; i < 10; i++)
+		scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, processing_handler);
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, rx_tx_handler);
+
+	app_sched_execute();
+
+	ASSERT_EQ(execution_order_len, 11);
+	EXPECT_EQ(execution_order[0], 'R');
+
+	scheduler_statistics_t statistics;
+	EXPECT_EQ(scheduler_get_statistics(SCHEDULER_PRIORITY_RX_TX, &statistics), NRF_SUCCESS);
+	EXPECT_EQ(statistics.max_wait, 0);
+	EXPECT_EQ(statistics.high_water_mark, 1);
+	EXPECT_EQ(statistics.dropped_events, 0);
+
+	EXPECT_EQ(scheduler_get_statistics(SCHEDULER_PRIORITY_PROCESSING, &statistics), NRF_SUCCESS);
+	EXPECT_EQ(statistics.max_wait, 10);
+	EXPECT_EQ(statistics.high_water_mark, 10);
+
+	scheduler_reset_statistics();
+	EXPECT_EQ(scheduler_get_statistics(SCHEDULER_PRIORITY_PROCESSING, &statistics), NRF_SUCCESS);
+	EXPECT_EQ(statistics.max_wait, 0);
+	EXPECT_EQ(statistics.high_water_mark, 0);
+
+	EXPECT_EQ(scheduler_get_statistics(SCHEDULER_NUMBER_OF_PRIORITIES, &statistics), NRF_ERROR_INVALID_PARAM);
+}
+
+uint32_t busy_handler_count = 0;
+void busy_rx_tx_handler(void * p_event_data, uint16_t event_size) {
+	execution_order[SchedulerTest::execution_order_len++] = 'R';
+	// Reschedule itself (e.g. waiting for a lower priority handler)
+	busy_handler_count++;
+	if(busy_handler_count < 50)
+		scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, busy_rx_tx_handler);
+}
+
+TEST_F(SchedulerTest, StarvationTest) {
+	busy_handler_count = 0;
+	scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, busy_rx_tx_handler);
+	scheduler_event_put(SCHEDULER_PRIORITY_HOUSEKEEPING, housekeeping_handler);
+
+	app_sched_execute();
+
+	EXPECT_EQ(busy_handler_count, 50);
+	ASSERT_EQ(execution_order_len, 51);
+	// The housekeeping handler must be executed after it was skipped SCHEDULER_STARVATION_LIMIT times
+	EXPECT_EQ(execution_order[SCHEDULER_STARVATION_LIMIT], 'H');
+
+	scheduler_statistics_t statistics;
+	scheduler_get_statistics(SCHEDULER_PRIORITY_HOUSEKEEPING, &statistics);
+	EXPECT_EQ(statistics.max_wait, SCHEDULER_STARVATION_LIMIT);
+}
+
+TEST_F(SchedulerTest, ExceptionTest) {
+	EXPECT_EQ(scheduler_event_put(SCHEDULER_NUMBER_OF_PRIORITIES, rx_tx_handler), NRF_ERROR_INVALID_PARAM);
+	EXPECT_EQ(scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, NULL), NRF_ERROR_INVALID_PARAM);
+
+	for(uint32_t i = 0; i < SCHEDULER_QUEUE_SIZE; i++)
+		EXPECT_EQ(scheduler_event_put(SCHEDULER_PRIORITY_SAMPLING, sampling_handler), NRF_SUCCESS);
+	EXPECT_EQ(scheduler_event_put(SCHEDULER_PRIORITY_SAMPLING, sampling_handler), NRF_ERROR_NO_MEM);
+	// The other priority classes are not affected
+	EXPECT_EQ(scheduler_event_put(SCHEDULER_PRIORITY_RX_TX, rx_tx_handler), NRF_SUCCESS);
+
+	scheduler_statistics_t statistics;
+	scheduler_get_statistics(SCHEDULER_PRIORITY_SAMPLING, &statistics);
+	EXPECT_EQ(statistics.dropped_events, 1);
+	EXPECT_EQ(statistics.high_water_mark, SCHEDULER_QUEUE_SIZE);
+
+	app_sched_execute();
+	EXPECT_EQ(execution_order_len, SCHEDULER_QUEUE_SIZE + 1);
+	EXPECT_EQ(execution_order[0], 'R');
+}
+
+
+};
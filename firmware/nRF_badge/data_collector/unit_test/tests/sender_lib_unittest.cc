@@ -0,0 +1,237 @@
+// Don't forget gtest.h, which declares the testing framework.
+
+#include "gtest/gtest.h"
+#include "timer_lib.h"
+#include "app_timer.h"
+#include "app_scheduler.h"
+#include "systick_lib.h"
+#include "timeout_lib.h"
+#include "ble_lib.h"
+#include "sender_lib.h"
+
+#include "callback_generator_lib.h"
+
+/** Include some (private) functions only for testing purposes */
+extern uint32_t ble_transmit_fifo_get_size(void);
+extern ret_code_t ble_transmit_fifo_read(uint8_t* data, uint32_t len);
+extern uint32_t ble_transmit_get_transmitted_bytes(void);
+
+#define NUMBER_OF_TX_BUFFERS_TEST		6
+#define CONNECTION_INTERVAL_MS_TEST		10
+#define MAX_BYTES_PER_TRANSMIT_TEST		20
+
+#define THROUGHPUT_TEST_BYTES			(64*1024)
+#define THROUGHPUT_TEST_PACKET_SIZE		200
+
+
+static uint32_t received_bytes = 0;
+
+static volatile uint32_t completed_transmits = 0;
+static volatile ret_code_t completed_status = NRF_SUCCESS;
+static volatile uint8_t packet_in_use[2];
+
+static void transmit_complete_handler(ret_code_t status, void* p_context) {
+	completed_status = status;
+	completed_transmits++;
+	if(p_context != NULL)
+		*((volatile uint8_t*) p_context) = 0;
+}
+
+/**@brief Function to read out and check the bytes that were sent by the simulated ble-interface. */
+static void check_transmitted_bytes(void) {
+	uint8_t data[256];
+	uint32_t len = ble_transmit_fifo_get_size();
+	while(len > 0) {
+		uint32_t read_len = (len > sizeof(data)) ? sizeof(data) : len;
+		ASSERT_EQ(ble_transmit_fifo_read(data, read_len), NRF_SUCCESS);
+		for(uint32_t i = 0; i < read_len; i++) {
+			ASSERT_EQ(data[i], (uint8_t) ((received_bytes + i) % 251));
+		}
+		received_bytes += read_len;
+		len -= read_len;
+	}
+}
+
+
+namespace {
+
+class SenderTest : public ::testing::Test {
+public:
+	// The virtual-time mode has to be enabled before anything initializes the timer-module
+	static void SetUpTestCase() {
+		timer_enable_virtual_time(1);
+	}
+};
+
+
+TEST_F(SenderTest, ThroughputTest) {
+	APP_SCHED_INIT(4, 100);
+	APP_TIMER_INIT(0, 60, NULL);
+
+	EXPECT_EQ(systick_init(0), NRF_SUCCESS);
+	EXPECT_EQ(timeout_init(), NRF_SUCCESS);
+
+	uint32_t timepoint_connect = 10;
+	callback_generator_ble_on_connect_reset();
+	callback_generator_ble_on_connect_add_trigger_timepoints(&timepoint_connect, 1);
+
+	EXPECT_EQ(ble_init(), NRF_SUCCESS);
+	EXPECT_EQ(sender_init(), NRF_SUCCESS);
+
+	timer_virtual_run_for(100*1000, app_sched_execute);
+	ASSERT_EQ(ble_get_state(), BLE_STATE_CONNECTED);
+
+	// Double buffered: one packet is filled while the other one is transmitted in place
+	uint8_t packet[2][THROUGHPUT_TEST_PACKET_SIZE];
+	uint32_t sent_bytes = 0;
+	uint32_t packet_index = 0;
+	received_bytes = 0;
+	packet_in_use[0] = 0;
+	packet_in_use[1] = 0;
+	uint64_t start_ms = systick_get_continuous_millis();
+	while(sent_bytes < THROUGHPUT_TEST_BYTES) {
+		while(packet_in_use[packet_index]) {
+			timer_virtual_advance_to_next_event(timer_get_microseconds_since_start() + CONNECTION_INTERVAL_MS_TEST*1000);
+			check_transmitted_bytes();
+		}
+		for(uint32_t i = 0; i < sizeof(packet[packet_index]); i++)
+			packet[packet_index][i] = (uint8_t) ((sent_bytes + i) % 251);
+		sender_segment_t segment;
+		segment.data = packet[packet_index];
+		segment.len = sizeof(packet[packet_index]);
+		packet_in_use[packet_index] = 1;
+		ret_code_t ret = sender_transmit_segments(&segment, 1, transmit_complete_handler, (void*) &packet_in_use[packet_index]);
+		ASSERT_EQ(ret, NRF_SUCCESS);
+		sent_bytes += sizeof(packet[packet_index]);
+		packet_index = (packet_index + 1) % 2;
+		check_transmitted_bytes();
+	}
+	// Wait until everything is sent
+	while(ble_transmit_get_transmitted_bytes() < sent_bytes) {
+		timer_virtual_advance_to_next_event(timer_get_microseconds_since_start() + CONNECTION_INTERVAL_MS_TEST*1000);
+		check_transmitted_bytes();
+	}
+	uint64_t end_ms = systick_get_continuous_millis();
+	check_transmitted_bytes();
+	EXPECT_EQ(received_bytes, sent_bytes);
+
+	uint32_t throughput = (uint32_t) ((((uint64_t) sent_bytes) * 1000) / (end_ms - start_ms));
+	uint32_t link_throughput = (NUMBER_OF_TX_BUFFERS_TEST * MAX_BYTES_PER_TRANSMIT_TEST * 1000) / CONNECTION_INTERVAL_MS_TEST;
+
+	// All notification buffers are used at (nearly) every connection event
+	EXPECT_GE(throughput, (link_throughput * 9) / 10);
+	EXPECT_LE(throughput, link_throughput);
+}
+
+TEST_F(SenderTest, SegmentsTest) {
+	APP_SCHED_INIT(4, 100);
+	APP_TIMER_INIT(0, 60, NULL);
+
+	EXPECT_EQ(systick_init(0), NRF_SUCCESS);
+	EXPECT_EQ(timeout_init(), NRF_SUCCESS);
+
+	uint32_t timepoint_connect = 10;
+	callback_generator_ble_on_connect_reset();
+	callback_generator_ble_on_connect_add_trigger_timepoints(&timepoint_connect, 1);
+
+	EXPECT_EQ(ble_init(), NRF_SUCCESS);
+	EXPECT_EQ(sender_init(), NRF_SUCCESS);
+
+	timer_virtual_run_for(100*1000, app_sched_execute);
+	ASSERT_EQ(ble_get_state(), BLE_STATE_CONNECTED);
+	check_transmitted_bytes();
+
+	// Segment lengths that are not aligned to the notification size (a header, a body, a tiny trailer)
+	uint8_t data[2][2 + 45 + 1];
+	sender_segment_t segments[2][3];
+	received_bytes = 0;
+	for(uint32_t k = 0; k < 2; k++) {
+		for(uint32_t i = 0; i < sizeof(data[k]); i++)
+			data[k][i] = (uint8_t) ((k*sizeof(data[k]) + i) % 251);
+		segments[k][0].data = &data[k][0];
+		segments[k][0].len = 2;
+		segments[k][1].data = &data[k][2];
+		segments[k][1].len = 45;
+		segments[k][2].data = &data[k][47];
+		segments[k][2].len = 1;
+	}
+
+	EXPECT_EQ(sender_transmit_segments(segments[0], 0, transmit_complete_handler, NULL), NRF_ERROR_INVALID_PARAM);
+	EXPECT_EQ(sender_transmit_segments(segments[0], SENDER_MAX_SEGMENTS + 1, transmit_complete_handler, NULL), NRF_ERROR_INVALID_PARAM);
+
+	completed_transmits = 0;
+	EXPECT_EQ(sender_transmit_segments(segments[0], 3, transmit_complete_handler, NULL), NRF_SUCCESS);
+	EXPECT_EQ(sender_transmit_segments(segments[1], 3, transmit_complete_handler, NULL), NRF_SUCCESS);
+	EXPECT_EQ(sender_get_transmit_fifo_size(), 2*sizeof(data[0]));
+	// The transmit queue is full
+	EXPECT_EQ(sender_transmit_segments(segments[0], 3, transmit_complete_handler, NULL), NRF_ERROR_NO_MEM);
+
+	timer_virtual_run_for(100*1000, app_sched_execute);
+	EXPECT_EQ(completed_transmits, 2);
+	EXPECT_EQ(completed_status, NRF_SUCCESS);
+	EXPECT_EQ(sender_get_transmit_fifo_size(), 0);
+	check_transmitted_bytes();
+	EXPECT_EQ(received_bytes, 2*sizeof(data[0]));
+
+	// A disconnect aborts the queued transmits
+	completed_transmits = 0;
+	EXPECT_EQ(sender_transmit_segments(segments[0], 3, transmit_complete_handler, NULL), NRF_SUCCESS);
+	sender_disconnect();
+	timer_virtual_run_for(100*1000, app_sched_execute);
+	EXPECT_EQ(completed_transmits, 1);
+	EXPECT_EQ(completed_status, NRF_ERROR_INVALID_STATE);
+	EXPECT_EQ(sender_transmit_segments(segments[0], 3, transmit_complete_handler, NULL), NRF_ERROR_INVALID_STATE);
+}
+
+TEST_F(SenderTest, TransmitTimeoutTest) {
+	APP_SCHED_INIT(4, 100);
+	APP_TIMER_INIT(0, 60, NULL);
+
+	EXPECT_EQ(systick_init(0), NRF_SUCCESS);
+	EXPECT_EQ(timeout_init(), NRF_SUCCESS);
+
+	uint32_t timepoint_connect = 10;
+	callback_generator_ble_on_connect_reset();
+	callback_generator_ble_on_connect_add_trigger_timepoints(&timepoint_connect, 1);
+
+	EXPECT_EQ(ble_init(), NRF_SUCCESS);
+	EXPECT_EQ(sender_init(), NRF_SUCCESS);
+
+	timer_virtual_run_for(100*1000, app_sched_execute);
+	ASSERT_EQ(ble_get_state(), BLE_STATE_CONNECTED);
+	received_bytes = 0;
+	check_transmitted_bytes();
+
+	// Nobody reads the transmit-fifo of the simulated ble-interface, so it is full after 1024 bytes and the transmit stalls
+	uint8_t data[2048];
+	for(uint32_t i = 0; i < sizeof(data); i++)
+		data[i] = (uint8_t) (i % 251);
+
+	uint64_t start_ms = systick_get_continuous_millis();
+	EXPECT_EQ(sender_transmit(data, sizeof(data), 200), NRF_ERROR_TIMEOUT);
+	uint64_t elapsed_ms = systick_get_continuous_millis() - start_ms;
+	EXPECT_GE(elapsed_ms, 200);
+	EXPECT_LE(elapsed_ms, 300);
+
+	// The aborted transmit must not access the data anymore, even if the ble-interface is free again
+	EXPECT_EQ(sender_get_transmit_fifo_size(), 0);
+	uint32_t stalled_bytes = ble_transmit_fifo_get_size();
+	check_transmitted_bytes();
+	memset(data, 0xFF, sizeof(data));
+	timer_virtual_run_for(100*1000, app_sched_execute);
+	EXPECT_EQ(ble_transmit_fifo_get_size(), 0);
+
+	// The next transmit works again
+	received_bytes = 0;
+	uint8_t next_data[45];
+	for(uint32_t i = 0; i < sizeof(next_data); i++)
+		next_data[i] = (uint8_t) (i % 251);
+	EXPECT_EQ(sender_transmit(next_data, sizeof(next_data), 200), NRF_SUCCESS);
+	timer_virtual_run_for(100*1000, app_sched_execute);
+	check_transmitted_bytes();
+	EXPECT_EQ(received_bytes, sizeof(next_data));
+	EXPECT_GT(stalled_bytes, 0);
+}
+
+
+};
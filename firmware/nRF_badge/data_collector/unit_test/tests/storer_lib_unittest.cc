@@ -0,0 +1,150 @@
+// Don't forget gtest.h, which declares the testing framework.
+#include "gtest/gtest.h"
+
+#include "storer_lib.h"
+#include "chunk_messages.h"
+#include "filesystem_lib.h"
+
+/** Include some (private) functions only for testing purposes */
+extern ret_code_t storer_register_partitions(void);
+
+
+
+namespace {
+
+class StorerTest : public ::testing::Test {
+	virtual void SetUp() {
+		storer_init();
+		storer_clear();
+	}
+};
+
+
+static void store_battery_chunks(uint32_t number, uint32_t first_seconds) {
+	BatteryChunk battery_chunk;
+	memset(&battery_chunk, 0, sizeof(battery_chunk));
+	for(uint32_t i = 0; i < number; i++) {
+		battery_chunk.timestamp.seconds = first_seconds + i;
+		battery_chunk.battery_data.voltage = 3.0;
+		ASSERT_EQ(storer_store_battery_chunk(&battery_chunk), NRF_SUCCESS);
+	}
+}
+
+
+TEST_F(StorerTest, RecordIdTest) {
+	uint16_t record_id = 0;
+	// No data in the partition
+	EXPECT_EQ(storer_find_oldest_chunk(STORER_CHUNK_PARTITION_BATTERY, &record_id), NRF_ERROR_INVALID_STATE);
+	EXPECT_EQ(storer_find_chunk_from_record_id((storer_chunk_partition_t) STORER_NUMBER_OF_CHUNK_PARTITIONS, &record_id), NRF_ERROR_INVALID_PARAM);
+	
+	store_battery_chunks(10, 1000);
+	
+	// The record-ids of the oldest to the latest chunk are consecutive
+	uint16_t oldest_record_id;
+	ASSERT_EQ(storer_find_oldest_chunk(STORER_CHUNK_PARTITION_BATTERY, &oldest_record_id), NRF_SUCCESS);
+	BatteryChunk battery_chunk;
+	for(uint32_t i = 0; i < 10; i++) {
+		ASSERT_EQ(storer_decode_next_chunk(STORER_CHUNK_PARTITION_BATTERY, BatteryChunk_fields, &battery_chunk, &record_id), NRF_SUCCESS);
+		EXPECT_EQ(record_id, (uint16_t) (oldest_record_id + i));
+		EXPECT_EQ(battery_chunk.timestamp.seconds, 1000 + i);
+	}
+	EXPECT_EQ(storer_decode_next_chunk(STORER_CHUNK_PARTITION_BATTERY, BatteryChunk_fields, &battery_chunk, &record_id), NRF_ERROR_NOT_FOUND);
+	
+	// Resume at a record-id in the middle
+	record_id = oldest_record_id + 4;
+	ASSERT_EQ(storer_find_chunk_from_record_id(STORER_CHUNK_PARTITION_BATTERY, &record_id), NRF_SUCCESS);
+	EXPECT_EQ(record_id, (uint16_t) (oldest_record_id + 4));
+	ASSERT_EQ(storer_decode_next_chunk(STORER_CHUNK_PARTITION_BATTERY, BatteryChunk_fields, &battery_chunk, &record_id), NRF_SUCCESS);
+	EXPECT_EQ(record_id, (uint16_t) (oldest_record_id + 4));
+	EXPECT_EQ(battery_chunk.timestamp.seconds, 1004);
+	storer_invalidate_iterators();
+	
+	// Everything was already exported --> only new chunks will be returned
+	record_id = oldest_record_id + 10;
+	ASSERT_EQ(storer_find_chunk_from_record_id(STORER_CHUNK_PARTITION_BATTERY, &record_id), NRF_SUCCESS);
+	EXPECT_EQ(record_id, (uint16_t) (oldest_record_id + 10));
+	EXPECT_EQ(storer_decode_next_chunk(STORER_CHUNK_PARTITION_BATTERY, BatteryChunk_fields, &battery_chunk, &record_id), NRF_ERROR_NOT_FOUND);
+	
+	record_id = oldest_record_id + 10;
+	ASSERT_EQ(storer_find_chunk_from_record_id(STORER_CHUNK_PARTITION_BATTERY, &record_id), NRF_SUCCESS);
+	storer_invalidate_iterators();
+	store_battery_chunks(1, 2000);
+	record_id = oldest_record_id + 10;
+	ASSERT_EQ(storer_find_chunk_from_record_id(STORER_CHUNK_PARTITION_BATTERY, &record_id), NRF_SUCCESS);
+	ASSERT_EQ(storer_decode_next_chunk(STORER_CHUNK_PARTITION_BATTERY, BatteryChunk_fields, &battery_chunk, &record_id), NRF_SUCCESS);
+	EXPECT_EQ(record_id, (uint16_t) (oldest_record_id + 10));
+	EXPECT_EQ(battery_chunk.timestamp.seconds, 2000);
+	storer_invalidate_iterators();
+}
+
+TEST_F(StorerTest, OverwrittenRecordIdTest) {
+	store_battery_chunks(1, 0);
+	uint16_t first_record_id;
+	ASSERT_EQ(storer_find_oldest_chunk(STORER_CHUNK_PARTITION_BATTERY, &first_record_id), NRF_SUCCESS);
+	storer_invalidate_iterators();
+	
+	// The partition wraps around, so the first chunk is overwritten
+	store_battery_chunks(2*STORER_BATTERY_DATA_NUMBER, 1);
+	
+	uint16_t oldest_record_id;
+	ASSERT_EQ(storer_find_oldest_chunk(STORER_CHUNK_PARTITION_BATTERY, &oldest_record_id), NRF_SUCCESS);
+	EXPECT_GT((uint16_t) (oldest_record_id - first_record_id), 0);
+	
+	// Resuming from an overwritten record starts at the oldest chunk
+	uint16_t record_id = first_record_id;
+	ASSERT_EQ(storer_find_chunk_from_record_id(STORER_CHUNK_PARTITION_BATTERY, &record_id), NRF_SUCCESS);
+	EXPECT_EQ(record_id, oldest_record_id);
+	
+	BatteryChunk battery_chunk;
+	uint16_t read_record_id;
+	uint32_t number_of_chunks = 0;
+	while(storer_decode_next_chunk(STORER_CHUNK_PARTITION_BATTERY, BatteryChunk_fields, &battery_chunk, &read_record_id) == NRF_SUCCESS) {
+		EXPECT_EQ(read_record_id, (uint16_t) (oldest_record_id + number_of_chunks));
+		number_of_chunks++;
+	}
+	EXPECT_EQ((uint16_t) (read_record_id - first_record_id), 2*STORER_BATTERY_DATA_NUMBER);
+	EXPECT_GE(number_of_chunks, STORER_BATTERY_DATA_NUMBER);
+}
+
+TEST_F(StorerTest, DownloadCursorTest) {
+	uint16_t record_ids[STORER_NUMBER_OF_CHUNK_PARTITIONS];
+	EXPECT_EQ(storer_get_download_cursor(1, record_ids), NRF_ERROR_NOT_FOUND);
+	
+	// Store the cursors of more hubs than fit into the table
+	for(uint16_t hub_id = 1; hub_id <= DOWNLOAD_CURSOR_TABLE_SIZE + 1; hub_id++) {
+		for(uint8_t i = 0; i < STORER_NUMBER_OF_CHUNK_PARTITIONS; i++)
+			record_ids[i] = hub_id*100 + i;
+		ASSERT_EQ(storer_store_download_cursor(hub_id, record_ids), NRF_SUCCESS);
+	}
+	// The least recently stored hub was replaced
+	EXPECT_EQ(storer_get_download_cursor(1, record_ids), NRF_ERROR_NOT_FOUND);
+	
+	// Update the cursor of a hub (moves it to the front, so that hub 3 will be replaced next)
+	for(uint8_t i = 0; i < STORER_NUMBER_OF_CHUNK_PARTITIONS; i++)
+		record_ids[i] = 1000 + i;
+	ASSERT_EQ(storer_store_download_cursor(2, record_ids), NRF_SUCCESS);
+	ASSERT_EQ(storer_store_download_cursor(DOWNLOAD_CURSOR_TABLE_SIZE + 2, record_ids), NRF_SUCCESS);
+	EXPECT_EQ(storer_get_download_cursor(3, record_ids), NRF_ERROR_NOT_FOUND);
+	
+	// The table is read back from the storage after a restart (storer_init() would erase the simulated flash and EEPROM)
+	filesystem_reset();
+	storer_register_partitions();
+	ASSERT_EQ(storer_get_download_cursor(2, record_ids), NRF_SUCCESS);
+	for(uint8_t i = 0; i < STORER_NUMBER_OF_CHUNK_PARTITIONS; i++)
+		EXPECT_EQ(record_ids[i], 1000 + i);
+	for(uint16_t hub_id = 4; hub_id <= DOWNLOAD_CURSOR_TABLE_SIZE + 1; hub_id++) {
+		ASSERT_EQ(storer_get_download_cursor(hub_id, record_ids), NRF_SUCCESS);
+		for(uint8_t i = 0; i < STORER_NUMBER_OF_CHUNK_PARTITIONS; i++)
+			EXPECT_EQ(record_ids[i], hub_id*100 + i);
+	}
+	
+	// Clearing the storer removes all cursors
+	storer_clear();
+	EXPECT_EQ(storer_get_download_cursor(2, record_ids), NRF_ERROR_NOT_FOUND);
+	filesystem_reset();
+	storer_register_partitions();
+	EXPECT_EQ(storer_get_download_cursor(2, record_ids), NRF_ERROR_NOT_FOUND);
+}
+
+
+};
@@ -7,10 +7,29 @@
 #include "timeout_lib.h"
 #include "app_timer.h"
 #include "systick_lib.h"
+#include "timer_lib.h"
 
 
 extern volatile uint8_t timeout_timer_running;
 
+/** The state of the app-timer mock, to check when the timeout timer is armed */
+extern volatile timer_node_t timer_nodes[];
+extern uint32_t timer_ids[];
+extern uint32_t number_of_app_timers;
+
+/**@brief Function to retrieve the endpoint of the running timeout timer (the only single-shot app-timer, the systick-timer is repeated).
+ *
+ * @retval	The endpoint in microseconds, or 0 if it is not running.
+ */
+static uint64_t get_timeout_timer_microseconds_at_end(void) {
+	for(uint32_t i = 0; i < number_of_app_timers; i++) {
+		volatile timer_node_t* timer_node = &timer_nodes[timer_ids[i]];
+		if(timer_node->mode == TIMER_MODE_SINGLE_SHOT && timer_node->is_running)
+			return timer_node->microseconds_at_end;
+	}
+	return 0;
+}
+
 namespace {
 
 TEST(TimeoutTest, InitTest) {
@@ -168,4 +187,90 @@ TEST(TimeoutTest, ResetTwo) {
 }
 
 
+
+#define ORDER_NUMBER_OF_TIMEOUTS	3
+uint32_t order_timeout_ids[ORDER_NUMBER_OF_TIMEOUTS];
+uint32_t order_sequence[ORDER_NUMBER_OF_TIMEOUTS];
+volatile uint32_t order_sequence_len = 0;
+void order_handler_0(void) { order_sequence[order_sequence_len++] = 0; }
+void order_handler_1(void) { order_sequence[order_sequence_len++] = 1; }
+void order_handler_2(void) { order_sequence[order_sequence_len++] = 2; }
+
+TEST(TimeoutTest, HeapOrderTest) {
+	ret_code_t ret;
+	ret = timeout_register(&order_timeout_ids[0], order_handler_0);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	ret = timeout_register(&order_timeout_ids[1], order_handler_1);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	ret = timeout_register(&order_timeout_ids[2], order_handler_2);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	
+	order_sequence_len = 0;
+	// Start in "wrong" order, then move timeout 0 behind timeout 2 by restarting it.
+	timeout_start(order_timeout_ids[2], 150);
+	timeout_start(order_timeout_ids[0], 50);
+	timeout_start(order_timeout_ids[1], 100);
+	timeout_start(order_timeout_ids[0], 200);
+	
+	systick_delay_millis(250);
+	
+	EXPECT_EQ(order_sequence_len, 3);
+	EXPECT_EQ(order_sequence[0], 1);
+	EXPECT_EQ(order_sequence[1], 2);
+	EXPECT_EQ(order_sequence[2], 0);
+	EXPECT_EQ(timeout_timer_running, 0);
+	
+	
+	// Stopping the earliest timeout must not trigger its handler, but the others.
+	order_sequence_len = 0;
+	timeout_start(order_timeout_ids[0], 50);
+	timeout_start(order_timeout_ids[1], 100);
+	timeout_start(order_timeout_ids[2], 150);
+	timeout_stop(order_timeout_ids[0]);
+	
+	systick_delay_millis(200);
+	
+	EXPECT_EQ(order_sequence_len, 2);
+	EXPECT_EQ(order_sequence[0], 1);
+	EXPECT_EQ(order_sequence[1], 2);
+	EXPECT_EQ(timeout_timer_running, 0);
+}
+
+volatile uint32_t lazy_reset_handler_count = 0;
+void lazy_reset_handler(void) {
+	lazy_reset_handler_count++;
+}
+
+TEST(TimeoutTest, LazyResetTest) {
+	// Register all remaining timeouts (like the sampling-module does for every sensor)
+	uint32_t timeout_ids[MAX_NUMBER_OF_TIMEOUTS];
+	uint32_t number_of_timeout_ids = 0;
+	while(timeout_register(&timeout_ids[number_of_timeout_ids], lazy_reset_handler) == NRF_SUCCESS)
+		number_of_timeout_ids++;
+	ASSERT_GT(number_of_timeout_ids, 0);
+	
+	lazy_reset_handler_count = 0;
+	for(uint32_t i = 0; i < number_of_timeout_ids; i++)
+		timeout_start(timeout_ids[i], 10000 + i*1000);
+	
+	EXPECT_EQ(timeout_timer_running, 1);
+	uint64_t armed_microseconds_at_end = get_timeout_timer_microseconds_at_end();
+	EXPECT_GT(armed_microseconds_at_end, 0);
+	
+	systick_delay_millis(5);	// So that a re-armed timer would have another endpoint
+	for(uint32_t i = 0; i < 4*number_of_timeout_ids; i++) {
+		timeout_reset(timeout_ids[i % number_of_timeout_ids]);
+	}
+	
+	// The reset is lazy, so the timer must not have been re-armed.
+	EXPECT_EQ(get_timeout_timer_microseconds_at_end(), armed_microseconds_at_end);
+	EXPECT_EQ(timeout_timer_running, 1);
+	
+	for(uint32_t i = 0; i < number_of_timeout_ids; i++)
+		timeout_stop(timeout_ids[i]);
+	
+	EXPECT_EQ(timeout_timer_running, 0);
+	EXPECT_EQ(lazy_reset_handler_count, 0);
+}
+
 };  
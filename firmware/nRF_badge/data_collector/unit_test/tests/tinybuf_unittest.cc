@@ -0,0 +1,452 @@
+// Don't forget gtest.h, which declares the testing framework.
+#include <stdlib.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "tinybuf.h"
+#include "chunk_messages.h"
+#include "protocol_messages_02v1.h"
+
+
+static uint8_t buf_table[1024];
+static uint8_t buf_straight_line[1024];
+
+
+typedef uint8_t (*straight_line_encode_t)(tb_ostream_t* ostream, const void* src, tb_endian_t endianness);
+typedef uint8_t (*straight_line_decode_t)(tb_istream_t* istream, void* dst, tb_endian_t endianness);
+
+
+/**@brief Function to encode a message with the table interpreter and with the straight-line function,
+ *			and to check that both produce the same bytes and decode to the same message.
+ *
+ * @retval	The encoded length.
+ */
+static uint32_t check_round_trip(const tb_field_t* fields, straight_line_encode_t encode, straight_line_decode_t decode, void* message, uint32_t message_size) {
+	tb_ostream_t ostream_table = tb_ostream_from_buffer(buf_table, sizeof(buf_table));
+	tb_ostream_t ostream_straight_line = tb_ostream_from_buffer(buf_straight_line, sizeof(buf_straight_line));
+	EXPECT_EQ(tb_encode(&ostream_table, fields, message, TB_BIG_ENDIAN), 1);
+	EXPECT_EQ(encode(&ostream_straight_line, message, TB_BIG_ENDIAN), 1);
+	EXPECT_EQ(ostream_table.bytes_written, ostream_straight_line.bytes_written);
+	EXPECT_EQ(memcmp(buf_table, buf_straight_line, ostream_table.bytes_written), 0);
+	uint32_t len = ostream_table.bytes_written;
+
+	uint8_t decoded_table[message_size];
+	uint8_t decoded_straight_line[message_size];
+	memset(decoded_table, 0, message_size);
+	memset(decoded_straight_line, 0, message_size);
+	tb_istream_t istream_table = tb_istream_from_buffer(buf_table, len);
+	tb_istream_t istream_straight_line = tb_istream_from_buffer(buf_straight_line, len);
+	EXPECT_EQ(tb_decode(&istream_table, fields, decoded_table, TB_BIG_ENDIAN), 1);
+	EXPECT_EQ(decode(&istream_straight_line, decoded_straight_line, TB_BIG_ENDIAN), 1);
+	EXPECT_EQ(istream_table.bytes_read, len);
+	EXPECT_EQ(istream_straight_line.bytes_read, len);
+	EXPECT_EQ(memcmp(decoded_table, decoded_straight_line, message_size), 0);
+
+	// A truncated buffer has to be rejected by both
+	for(uint32_t i = 0; i < len; i++) {
+		tb_istream_t istream_truncated = tb_istream_from_buffer(buf_straight_line, i);
+		EXPECT_EQ(decode(&istream_truncated, decoded_straight_line, TB_BIG_ENDIAN), 0);
+		tb_ostream_t ostream_truncated = tb_ostream_from_buffer(buf_straight_line, i);
+		EXPECT_EQ(encode(&ostream_truncated, message, TB_BIG_ENDIAN), 0);
+	}
+	return len;
+}
+
+/**< The sink of a callback output-stream (like a transmit-queue), and the source of a callback input-stream */
+typedef struct {
+	uint8_t data[1024];
+	uint32_t len;
+	uint32_t max_len;				/**< The sink fails, if more bytes are written */
+	uint32_t pos;					/**< The read position of the source */
+	uint32_t chunk_len;				/**< The maximal number of bytes the source provides per callback */
+	uint32_t number_of_callbacks;
+} stream_sink_t;
+
+static uint8_t sink_callback(tb_ostream_t* ostream, const uint8_t* data, uint32_t len) {
+	stream_sink_t* sink = (stream_sink_t*) ostream->state;
+	sink->number_of_callbacks++;
+	if(sink->len + len > sink->max_len)
+		return 0;
+	memcpy(&(sink->data[sink->len]), data, len);
+	sink->len += len;
+	return 1;
+}
+
+static uint32_t source_callback(tb_istream_t* istream, uint8_t* buf, uint32_t max_len) {
+	stream_sink_t* source = (stream_sink_t*) istream->state;
+	source->number_of_callbacks++;
+	uint32_t len = source->len - source->pos;
+	if(len > max_len)
+		len = max_len;
+	if(len > source->chunk_len)
+		len = source->chunk_len;
+	memcpy(buf, &(source->data[source->pos]), len);
+	source->pos += len;
+	return len;
+}
+
+static void reset_sink(stream_sink_t* sink, uint32_t max_len, uint32_t chunk_len) {
+	memset(sink, 0, sizeof(stream_sink_t));
+	sink->max_len = max_len;
+	sink->chunk_len = chunk_len;
+}
+
+/**@brief Function to check that callback-streams with different window sizes produce/consume the same bytes as buffer-streams,
+ *			with the table interpreter and with the straight-line functions.
+ */
+static void check_callback_streams(const tb_field_t* fields, straight_line_encode_t encode, straight_line_decode_t decode, void* message, uint32_t message_size) {
+	tb_ostream_t ostream = tb_ostream_from_buffer(buf_table, sizeof(buf_table));
+	ASSERT_EQ(tb_encode(&ostream, fields, message, TB_BIG_ENDIAN), 1);
+	uint32_t len = ostream.bytes_written;
+	uint8_t decoded[message_size];
+
+	static stream_sink_t sink;
+	uint8_t window[64];
+	uint32_t window_sizes[] = {TB_STREAM_MIN_WINDOW_SIZE, 13, sizeof(window)};
+	for(uint32_t w = 0; w < sizeof(window_sizes)/sizeof(window_sizes[0]); w++) {
+		for(uint8_t straight_line = 0; straight_line <= 1; straight_line++) {
+			reset_sink(&sink, sizeof(sink.data), 0);
+			ostream = tb_ostream_from_callback(sink_callback, &sink, window, window_sizes[w]);
+			if(straight_line)
+				ASSERT_EQ(encode(&ostream, message, TB_BIG_ENDIAN), 1);
+			else
+				ASSERT_EQ(tb_encode(&ostream, fields, message, TB_BIG_ENDIAN), 1);
+			EXPECT_EQ(ostream.bytes_written, len);
+			ASSERT_EQ(sink.len, len);
+			EXPECT_EQ(memcmp(sink.data, buf_table, len), 0);
+
+			// The source provides the bytes in small and in large pieces
+			for(uint32_t chunk_len = 1; chunk_len <= sizeof(sink.data); chunk_len *= 7) {
+				sink.pos = 0;
+				sink.chunk_len = chunk_len;
+				memset(decoded, 0, message_size);
+				tb_istream_t istream = tb_istream_from_callback(source_callback, &sink, window, window_sizes[w]);
+				if(straight_line)
+					ASSERT_EQ(decode(&istream, decoded, TB_BIG_ENDIAN), 1);
+				else
+					ASSERT_EQ(tb_decode(&istream, fields, decoded, TB_BIG_ENDIAN), 1);
+				EXPECT_EQ(istream.bytes_read, len);
+				EXPECT_EQ(memcmp(decoded, message, message_size), 0);
+			}
+
+			// A truncated source and a failing sink have to be detected
+			sink.pos = 0;
+			sink.len = len - 1;
+			tb_istream_t istream = tb_istream_from_callback(source_callback, &sink, window, window_sizes[w]);
+			EXPECT_EQ(tb_decode(&istream, fields, decoded, TB_BIG_ENDIAN), 0);
+			reset_sink(&sink, len - 1, 0);
+			ostream = tb_ostream_from_callback(sink_callback, &sink, window, window_sizes[w]);
+			EXPECT_EQ(tb_encode(&ostream, fields, message, TB_BIG_ENDIAN), 0);
+		}
+	}
+}
+
+
+/**< A message with a packed uint3-array, as the generator would create it for "packed uint3 values[20];" */
+typedef struct {
+	uint8_t values_count;
+	uint8_t values[20];
+} PackedTestMessage;
+
+static const tb_field_t PackedTestMessage_fields[2] = {
+	{DATA_TYPE_PACKED | (3 << TB_PACKED_BITS_POS) | FIELD_TYPE_REPEATED, tb_offsetof(PackedTestMessage, values), tb_delta(PackedTestMessage, values_count, values), 1, tb_membersize(PackedTestMessage, values[0]), 20, 0, 0, NULL},
+	TB_LAST_FIELD,
+};
+
+static void create_microphone_data_response(Response* response) {
+	memset(response, 0, sizeof(Response));
+	response->which_type = Response_microphone_data_response_tag;
+	response->type.microphone_data_response.timestamp.seconds = 1500000000;
+	response->type.microphone_data_response.timestamp.ms = 123;
+	response->type.microphone_data_response.sample_period_ms = 50;
+	response->type.microphone_data_response.microphone_data_count = PROTOCOL_MICROPHONE_DATA_SIZE;
+	for(uint32_t i = 0; i < PROTOCOL_MICROPHONE_DATA_SIZE; i++)
+		response->type.microphone_data_response.microphone_data[i].value = (uint8_t) (i*7);
+}
+
+static void create_microphone_chunk(MicrophoneChunk* chunk) {
+	memset(chunk, 0, sizeof(MicrophoneChunk));
+	chunk->timestamp.seconds = 1500000000;
+	chunk->timestamp.ms = 456;
+	chunk->sample_period_ms = 50;
+	chunk->microphone_data_count = MICROPHONE_CHUNK_DATA_SIZE;
+	for(uint32_t i = 0; i < MICROPHONE_CHUNK_DATA_SIZE; i++)
+		chunk->microphone_data[i].value = (uint8_t) (i*3);
+}
+
+static void create_scan_chunk(ScanChunk* chunk) {
+	memset(chunk, 0, sizeof(ScanChunk));
+	chunk->timestamp.seconds = 1500000000;
+	chunk->timestamp.ms = 789;
+	chunk->scan_result_data_count = SCAN_CHUNK_DATA_SIZE;
+	for(uint32_t i = 0; i < SCAN_CHUNK_DATA_SIZE; i++) {
+		chunk->scan_result_data[i].scan_device.ID = (uint16_t) (1000 + i);
+		chunk->scan_result_data[i].scan_device.rssi = (int8_t) (-40 - (int8_t) i);
+		chunk->scan_result_data[i].count = (uint8_t) (i % 4);
+	}
+}
+static void create_accelerometer_data_response(Response* response) {
+	memset(response, 0, sizeof(Response));
+	response->which_type = Response_accelerometer_data_response_tag;
+	response->type.accelerometer_data_response.timestamp.seconds = 1500000000;
+	response->type.accelerometer_data_response.accelerometer_data_count = PROTOCOL_ACCELEROMETER_DATA_SIZE;
+	for(uint32_t i = 0; i < PROTOCOL_ACCELEROMETER_DATA_SIZE; i++)
+		response->type.accelerometer_data_response.accelerometer_data[i].acceleration = (uint16_t) (0x0102 + i*0x0101);
+}
+
+static void create_stream_response(Response* response) {
+	memset(response, 0, sizeof(Response));
+	response->which_type = Response_stream_response_tag;
+	response->type.stream_response.timestamp.seconds = 1500000000;
+	response->type.stream_response.accelerometer_stream_count = PROTOCOL_ACCELEROMETER_STREAM_SIZE;
+	for(uint32_t i = 0; i < PROTOCOL_ACCELEROMETER_STREAM_SIZE; i++)
+		for(uint32_t k = 0; k < 3; k++)
+			response->type.stream_response.accelerometer_stream[i].accelerometer_raw_data.raw_acceleration[k] = (int16_t) (-1000 + i*100 + k);
+}
+
+
+namespace {
+
+TEST(TinybufTest, StraightLineResponseTest) {
+	Response response;
+	create_microphone_data_response(&response);
+	EXPECT_EQ(check_round_trip(Response_fields, (straight_line_encode_t) Response_encode, (straight_line_decode_t) Response_decode, &response, sizeof(response)),
+			1 + 1 + 6 + 2 + 1 + PROTOCOL_MICROPHONE_DATA_SIZE);
+
+	// Invalid which-field and a too large count
+	response.which_type = 0xFF;
+	tb_ostream_t ostream = tb_ostream_from_buffer(buf_straight_line, sizeof(buf_straight_line));
+	EXPECT_EQ(Response_encode(&ostream, &response, TB_BIG_ENDIAN), 0);
+	create_microphone_data_response(&response);
+	response.type.microphone_data_response.microphone_data_count = PROTOCOL_MICROPHONE_DATA_SIZE + 1;
+	ostream = tb_ostream_from_buffer(buf_straight_line, sizeof(buf_straight_line));
+	EXPECT_EQ(Response_encode(&ostream, &response, TB_BIG_ENDIAN), 0);
+}
+
+TEST(TinybufTest, StraightLineChunkTest) {
+	MicrophoneChunk microphone_chunk;
+	create_microphone_chunk(&microphone_chunk);
+	EXPECT_EQ(check_round_trip(MicrophoneChunk_fields, (straight_line_encode_t) MicrophoneChunk_encode, (straight_line_decode_t) MicrophoneChunk_decode, &microphone_chunk, sizeof(microphone_chunk)),
+			6 + 2 + 1 + MICROPHONE_CHUNK_DATA_SIZE);
+
+	ScanChunk scan_chunk;
+	create_scan_chunk(&scan_chunk);
+	EXPECT_EQ(check_round_trip(ScanChunk_fields, (straight_line_encode_t) ScanChunk_encode, (straight_line_decode_t) ScanChunk_decode, &scan_chunk, sizeof(scan_chunk)),
+			6 + 1 + SCAN_CHUNK_DATA_SIZE*(2 + 1 + 1));
+
+	// The little endian representation has to be the same as well
+	tb_ostream_t ostream_table = tb_ostream_from_buffer(buf_table, sizeof(buf_table));
+	tb_ostream_t ostream_straight_line = tb_ostream_from_buffer(buf_straight_line, sizeof(buf_straight_line));
+	EXPECT_EQ(tb_encode(&ostream_table, ScanChunk_fields, &scan_chunk, TB_LITTLE_ENDIAN), 1);
+	EXPECT_EQ(ScanChunk_encode(&ostream_straight_line, &scan_chunk, TB_LITTLE_ENDIAN), 1);
+	ASSERT_EQ(ostream_table.bytes_written, ostream_straight_line.bytes_written);
+	EXPECT_EQ(memcmp(buf_table, buf_straight_line, ostream_table.bytes_written), 0);
+
+	// A malformed count has to be rejected
+	buf_straight_line[6] = SCAN_CHUNK_DATA_SIZE + 1;
+	tb_istream_t istream = tb_istream_from_buffer(buf_straight_line, sizeof(buf_straight_line));
+	EXPECT_EQ(ScanChunk_decode(&istream, &scan_chunk, TB_LITTLE_ENDIAN), 0);
+}
+
+TEST(TinybufTest, BulkEndiannessTest) {
+	Response response;
+	Response decoded;
+	create_accelerometer_data_response(&response);
+	for(uint8_t endianness = 0; endianness < 2; endianness++) {
+		tb_endian_t e = endianness ? TB_LITTLE_ENDIAN : TB_BIG_ENDIAN;
+		tb_ostream_t ostream = tb_ostream_from_buffer(buf_table, sizeof(buf_table));
+		ASSERT_EQ(tb_encode(&ostream, Response_fields, &response, e), 1);
+		EXPECT_EQ(ostream.bytes_written, 1 + 1 + 6 + 1 + 2*PROTOCOL_ACCELEROMETER_DATA_SIZE);
+		// which_type, last_response, timestamp, count and then the accelerometer data
+		for(uint32_t i = 0; i < PROTOCOL_ACCELEROMETER_DATA_SIZE; i++) {
+			uint16_t acceleration = response.type.accelerometer_data_response.accelerometer_data[i].acceleration;
+			EXPECT_EQ(buf_table[9 + 2*i], (e == TB_BIG_ENDIAN) ? (acceleration >> 8) : (acceleration & 0xFF));
+			EXPECT_EQ(buf_table[9 + 2*i + 1], (e == TB_BIG_ENDIAN) ? (acceleration & 0xFF) : (acceleration >> 8));
+		}
+		memset(&decoded, 0, sizeof(decoded));
+		tb_istream_t istream = tb_istream_from_buffer(buf_table, ostream.bytes_written);
+		ASSERT_EQ(tb_decode(&istream, Response_fields, &decoded, e), 1);
+		EXPECT_EQ(memcmp(&response, &decoded, sizeof(response)), 0);
+
+		// Truncated data have to be rejected
+		istream = tb_istream_from_buffer(buf_table, ostream.bytes_written - 1);
+		EXPECT_EQ(tb_decode(&istream, Response_fields, &decoded, e), 0);
+		ostream = tb_ostream_from_buffer(buf_table, ostream.bytes_written - 1);
+		EXPECT_EQ(tb_encode(&ostream, Response_fields, &response, e), 0);
+	}
+
+	// Nested fixed arrays (AccelerometerStream --> AccelerometerRawData --> raw_acceleration[3]) have to match the straight-line functions
+	create_stream_response(&response);
+	for(uint8_t endianness = 0; endianness < 2; endianness++) {
+		tb_endian_t e = endianness ? TB_LITTLE_ENDIAN : TB_BIG_ENDIAN;
+		tb_ostream_t ostream_table = tb_ostream_from_buffer(buf_table, sizeof(buf_table));
+		tb_ostream_t ostream_straight_line = tb_ostream_from_buffer(buf_straight_line, sizeof(buf_straight_line));
+		ASSERT_EQ(tb_encode(&ostream_table, Response_fields, &response, e), 1);
+		ASSERT_EQ(Response_encode(&ostream_straight_line, &response, e), 1);
+		ASSERT_EQ(ostream_table.bytes_written, ostream_straight_line.bytes_written);
+		EXPECT_EQ(memcmp(buf_table, buf_straight_line, ostream_table.bytes_written), 0);
+		memset(&decoded, 0, sizeof(decoded));
+		tb_istream_t istream = tb_istream_from_buffer(buf_table, ostream_table.bytes_written);
+		ASSERT_EQ(tb_decode(&istream, Response_fields, &decoded, e), 1);
+		EXPECT_EQ(memcmp(&response, &decoded, sizeof(response)), 0);
+	}
+}
+
+TEST(TinybufTest, VarintTest) {
+	uint64_t values[] = {0, 1, 127, 128, 300, 16383, 16384, 65535, 0xFFFFFFFF, UINT64_MAX};
+	uint32_t lens[] = {1, 1, 1, 2, 2, 2, 3, 3, 5, 10};
+	for(uint32_t i = 0; i < sizeof(values)/sizeof(values[0]); i++) {
+		tb_ostream_t ostream = tb_ostream_from_buffer(buf_table, sizeof(buf_table));
+		ASSERT_EQ(tb_encode_varuint(&ostream, values[i]), 1);
+		EXPECT_EQ(ostream.bytes_written, lens[i]);
+		EXPECT_LE(ostream.bytes_written, TB_VARINT_MAX_LEN(8));
+		uint64_t value = 0;
+		tb_istream_t istream = tb_istream_from_buffer(buf_table, ostream.bytes_written);
+		ASSERT_EQ(tb_decode_varuint(&istream, &value, 8), 1);
+		EXPECT_EQ(value, values[i]);
+		EXPECT_EQ(istream.bytes_read, ostream.bytes_written);
+
+		// Truncated
+		istream = tb_istream_from_buffer(buf_table, ostream.bytes_written - 1);
+		EXPECT_EQ(tb_decode_varuint(&istream, &value, 8), 0);
+		ostream = tb_ostream_from_buffer(buf_table, lens[i] - 1);
+		EXPECT_EQ(tb_encode_varuint(&ostream, values[i]), 0);
+	}
+	// 300 = 0b10_0101100
+	tb_ostream_t ostream = tb_ostream_from_buffer(buf_table, sizeof(buf_table));
+	ASSERT_EQ(tb_encode_varuint(&ostream, 300), 1);
+	EXPECT_EQ(buf_table[0], 0xAC);
+	EXPECT_EQ(buf_table[1], 0x02);
+
+	// Values that don't fit into the data size and too long encodings have to be rejected
+	uint64_t value = 0;
+	uint8_t too_large_16[] = {0x80, 0x80, 0x04};
+	tb_istream_t istream = tb_istream_from_buffer(too_large_16, sizeof(too_large_16));
+	EXPECT_EQ(tb_decode_varuint(&istream, &value, 2), 0);
+	istream = tb_istream_from_buffer(too_large_16, sizeof(too_large_16));
+	EXPECT_EQ(tb_decode_varuint(&istream, &value, 4), 1);
+	EXPECT_EQ(value, 65536);
+	uint8_t too_long_32[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+	istream = tb_istream_from_buffer(too_long_32, sizeof(too_long_32));
+	EXPECT_EQ(tb_decode_varuint(&istream, &value, 4), 0);
+	uint8_t too_large_64[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02};
+	istream = tb_istream_from_buffer(too_large_64, sizeof(too_large_64));
+	EXPECT_EQ(tb_decode_varuint(&istream, &value, 8), 0);
+
+	// Zigzag
+	EXPECT_EQ(tb_zigzag_encode(0), 0);
+	EXPECT_EQ(tb_zigzag_encode(-1), 1);
+	EXPECT_EQ(tb_zigzag_encode(1), 2);
+	EXPECT_EQ(tb_zigzag_encode(-2), 3);
+	EXPECT_EQ(tb_zigzag_encode(INT64_MAX), UINT64_MAX - 1);
+	EXPECT_EQ(tb_zigzag_encode(INT64_MIN), UINT64_MAX);
+	int64_t signed_values[] = {0, -1, 1, -64, 64, -32768, 32767, INT64_MIN, INT64_MAX};
+	for(uint32_t i = 0; i < sizeof(signed_values)/sizeof(signed_values[0]); i++)
+		EXPECT_EQ(tb_zigzag_decode(tb_zigzag_encode(signed_values[i])), signed_values[i]);
+}
+
+TEST(TinybufTest, PackedBitsTest) {
+	// Value i starts at bit i*bits, LSB first: 3-bit values 0b101, 0b011, 0b110 = 0b110_011_101
+	uint8_t values[] = {5, 3, 6};
+	uint8_t packed[2];
+	ASSERT_EQ(tb_pack_bits(packed, values, 3, 3), 1);
+	EXPECT_EQ(packed[0], 0x9D);
+	EXPECT_EQ(packed[1], 0x01);
+	uint8_t too_large[] = {1, 8};
+	EXPECT_EQ(tb_pack_bits(packed, too_large, 2, 3), 0);
+
+	// Round trip of all widths, with values that straddle byte boundaries
+	uint8_t data[50];
+	uint8_t unpacked[50];
+	for(uint8_t bits = 1; bits <= 7; bits++) {
+		for(uint32_t i = 0; i < sizeof(data); i++)
+			data[i] = (uint8_t) ((i*37 + 11) & ((1 << bits) - 1));
+		ASSERT_EQ(tb_pack_bits(buf_table, data, sizeof(data), bits), 1);
+		tb_unpack_bits(buf_table, unpacked, sizeof(data), bits);
+		EXPECT_EQ(memcmp(data, unpacked, sizeof(data)), 0);
+	}
+
+	// The table-driven encoding: the count, then the packed values
+	PackedTestMessage message, decoded;
+	memset(&message, 0, sizeof(message));
+	memset(&decoded, 0, sizeof(decoded));
+	message.values_count = 3;
+	memcpy(message.values, values, sizeof(values));
+	EXPECT_EQ(tb_get_max_encoded_len(PackedTestMessage_fields), 1 + TB_PACKED_LEN(20, 3));
+	tb_ostream_t ostream = tb_ostream_from_buffer(buf_table, sizeof(buf_table));
+	ASSERT_EQ(tb_encode(&ostream, PackedTestMessage_fields, &message, TB_BIG_ENDIAN), 1);
+	ASSERT_EQ(ostream.bytes_written, 3);
+	EXPECT_EQ(buf_table[0], 3);
+	EXPECT_EQ(buf_table[1], 0x9D);
+	EXPECT_EQ(buf_table[2], 0x01);
+	tb_istream_t istream = tb_istream_from_buffer(buf_table, ostream.bytes_written);
+	ASSERT_EQ(tb_decode(&istream, PackedTestMessage_fields, &decoded, TB_BIG_ENDIAN), 1);
+	EXPECT_EQ(memcmp(&message, &decoded, sizeof(message)), 0);
+
+	// Truncated input and values that don't fit have to be rejected
+	istream = tb_istream_from_buffer(buf_table, ostream.bytes_written - 1);
+	EXPECT_EQ(tb_decode(&istream, PackedTestMessage_fields, &decoded, TB_BIG_ENDIAN), 0);
+	message.values[1] = 8;
+	ostream = tb_ostream_from_buffer(buf_table, sizeof(buf_table));
+	EXPECT_EQ(tb_encode(&ostream, PackedTestMessage_fields, &message, TB_BIG_ENDIAN), 0);
+}
+
+TEST(TinybufTest, CallbackStreamTest) {
+	Response response;
+	create_microphone_data_response(&response);
+	check_callback_streams(Response_fields, (straight_line_encode_t) Response_encode, (straight_line_decode_t) Response_decode, &response, sizeof(response));
+	create_accelerometer_data_response(&response);
+	check_callback_streams(Response_fields, (straight_line_encode_t) Response_encode, (straight_line_decode_t) Response_decode, &response, sizeof(response));
+	create_stream_response(&response);
+	check_callback_streams(Response_fields, (straight_line_encode_t) Response_encode, (straight_line_decode_t) Response_decode, &response, sizeof(response));
+	ScanChunk scan_chunk;
+	create_scan_chunk(&scan_chunk);
+	check_callback_streams(ScanChunk_fields, (straight_line_encode_t) ScanChunk_encode, (straight_line_decode_t) ScanChunk_decode, &scan_chunk, sizeof(scan_chunk));
+
+	// Packed values and varints that don't fit into the rest of the window (or not at all)
+	static stream_sink_t sink;
+	uint8_t window[TB_STREAM_MIN_WINDOW_SIZE];
+	PackedTestMessage message, decoded;
+	memset(&message, 0, sizeof(message));
+	message.values_count = 20;
+	for(uint8_t i = 0; i < 20; i++)
+		message.values[i] = (uint8_t) (i % 8);
+	reset_sink(&sink, sizeof(sink.data), 0);
+	tb_ostream_t ostream = tb_ostream_from_callback(sink_callback, &sink, window, sizeof(window));
+	ASSERT_EQ(tb_encode_varuint(&ostream, UINT64_MAX), 1);
+	ASSERT_EQ(tb_encode(&ostream, PackedTestMessage_fields, &message, TB_BIG_ENDIAN), 1);
+	ASSERT_EQ(sink.len, TB_VARINT_MAX_LEN(8) + 1 + TB_PACKED_LEN(20, 3));
+	sink.chunk_len = 3;
+	tb_istream_t istream = tb_istream_from_callback(source_callback, &sink, window, sizeof(window));
+	uint64_t value = 0;
+	memset(&decoded, 0, sizeof(decoded));
+	ASSERT_EQ(tb_decode_varuint(&istream, &value, 8), 1);
+	EXPECT_EQ(value, UINT64_MAX);
+	ASSERT_EQ(tb_decode(&istream, PackedTestMessage_fields, &decoded, TB_BIG_ENDIAN), 1);
+	EXPECT_EQ(memcmp(&message, &decoded, sizeof(message)), 0);
+	EXPECT_EQ(istream.bytes_read, sink.len);
+}
+
+TEST(TinybufTest, MaxEncodedLenTest) {
+	// The oneof of the Response starts with a message, the maximum has to consider all messages of the oneof
+	Response response;
+	create_accelerometer_data_response(&response);
+	tb_ostream_t ostream = tb_ostream_from_buffer(buf_table, sizeof(buf_table));
+	ASSERT_EQ(tb_encode(&ostream, Response_fields, &response, TB_BIG_ENDIAN), 1);
+	EXPECT_GE(tb_get_max_encoded_len(Response_fields), ostream.bytes_written);
+	create_microphone_data_response(&response);
+	ostream = tb_ostream_from_buffer(buf_table, sizeof(buf_table));
+	ASSERT_EQ(tb_encode(&ostream, Response_fields, &response, TB_BIG_ENDIAN), 1);
+	EXPECT_GE(tb_get_max_encoded_len(Response_fields), ostream.bytes_written);
+}
+
+TEST(TinybufTest, StraightLineAccelerometerResponseTest) {
+	// A repeated nested message in a oneof member
+	Response response;
+	create_accelerometer_data_response(&response);
+	EXPECT_EQ(check_round_trip(Response_fields, (straight_line_encode_t) Response_encode, (straight_line_decode_t) Response_decode, &response, sizeof(response)),
+			1 + 1 + 6 + 1 + PROTOCOL_ACCELEROMETER_DATA_SIZE*2);
+}
+
+
+};
@@ -0,0 +1,129 @@
+// Don't forget gtest.h, which declares the testing framework.
+
+#include "trace_lib.h"
+#include "scheduler_lib.h"
+#include "app_scheduler.h"
+#include "tinybuf.h"
+#include "chunk_messages.h"
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <string>
+
+#define SCHED_MAX_EVENT_DATA_SIZE sizeof(uint32_t)
+#define SCHED_QUEUE_SIZE 100
+
+
+namespace {
+
+class TraceTest : public ::testing::Test {
+	virtual void SetUp() {
+		trace_init();
+	}
+};
+
+TEST_F(TraceTest, RecordReadTest) {
+	trace_record_t records[4];
+	EXPECT_EQ(trace_read(records, 4), 0);
+	
+	TRACE_BEGIN(TRACE_EVENT_SENDER_TRANSMIT, 20);
+	TRACE_END(TRACE_EVENT_SENDER_TRANSMIT, 0);
+	TRACE_INSTANT(TRACE_EVENT_SCHEDULER_PUT, 2);
+	
+	ASSERT_EQ(trace_read(records, 2), 2);
+	EXPECT_EQ(records[0].event, TRACE_EVENT_SENDER_TRANSMIT);
+	EXPECT_EQ(records[0].phase, TRACE_PHASE_BEGIN);
+	EXPECT_EQ(records[0].arg, 20);
+	EXPECT_EQ(records[1].phase, TRACE_PHASE_END);
+	EXPECT_LE(records[0].timestamp, records[1].timestamp);
+	
+	ASSERT_EQ(trace_read(records, 4), 1);
+	EXPECT_EQ(records[0].event, TRACE_EVENT_SCHEDULER_PUT);
+	EXPECT_EQ(records[0].phase, TRACE_PHASE_INSTANT);
+	EXPECT_EQ(records[0].arg, 2);
+	
+	EXPECT_EQ(trace_read(records, 4), 0);
+	EXPECT_EQ(trace_get_overwritten_records(), 0);
+	EXPECT_STREQ(trace_get_event_name(TRACE_EVENT_TB_ENCODE), "tb_encode");
+}
+
+TEST_F(TraceTest, OverwriteTest) {
+	for(uint32_t i = 0; i < TRACE_BUFFER_SIZE + 10; i++)
+		TRACE_INSTANT(TRACE_EVENT_SCHEDULER_PUT, (uint16_t) i);
+	
+	EXPECT_EQ(trace_get_overwritten_records(), 10);
+	
+	// The oldest records were overwritten
+	trace_record_t record;
+	ASSERT_EQ(trace_read(&record, 1), 1);
+	EXPECT_EQ(record.arg, 10);
+	
+	uint32_t n = 1;
+	while(trace_read(&record, 1) == 1)
+		n++;
+	EXPECT_EQ(n, TRACE_BUFFER_SIZE);
+	EXPECT_EQ(record.arg, TRACE_BUFFER_SIZE + 9);
+	EXPECT_EQ(trace_get_overwritten_records(), 10);
+}
+
+void encode_handler(void * p_event_data, uint16_t event_size) {
+	uint8_t buf[64];
+	BatteryChunk battery_chunk;
+	memset(&battery_chunk, 0, sizeof(battery_chunk));
+	tb_ostream_t ostream = tb_ostream_from_buffer(buf, sizeof(buf));
+	tb_encode(&ostream, BatteryChunk_fields, &battery_chunk, TB_LITTLE_ENDIAN);
+}
+
+TEST_F(TraceTest, HooksTest) {
+	APP_SCHED_INIT(SCHED_MAX_EVENT_DATA_SIZE, SCHED_QUEUE_SIZE);
+	scheduler_init();
+	
+	scheduler_event_put(SCHEDULER_PRIORITY_PROCESSING, encode_handler);
+	app_sched_execute();
+	
+	trace_record_t records[8];
+	ASSERT_EQ(trace_read(records, 8), 5);
+	EXPECT_EQ(records[0].event, TRACE_EVENT_SCHEDULER_PUT);
+	EXPECT_EQ(records[0].arg, SCHEDULER_PRIORITY_PROCESSING);
+	EXPECT_EQ(records[1].event, TRACE_EVENT_SCHEDULER_EXECUTE);
+	EXPECT_EQ(records[1].phase, TRACE_PHASE_BEGIN);
+	EXPECT_EQ(records[2].event, TRACE_EVENT_TB_ENCODE);
+	EXPECT_EQ(records[2].phase, TRACE_PHASE_BEGIN);
+	EXPECT_EQ(records[3].event, TRACE_EVENT_TB_ENCODE);
+	EXPECT_EQ(records[3].phase, TRACE_PHASE_END);
+	EXPECT_EQ(records[3].arg, tb_get_max_encoded_len(BatteryChunk_fields));
+	EXPECT_EQ(records[4].event, TRACE_EVENT_SCHEDULER_EXECUTE);
+	EXPECT_EQ(records[4].phase, TRACE_PHASE_END);
+}
+
+TEST_F(TraceTest, ChromeJsonTest) {
+	TRACE_BEGIN(TRACE_EVENT_FILESYSTEM_STORE, 1);
+	TRACE_END(TRACE_EVENT_FILESYSTEM_STORE, 12);
+	TRACE_INSTANT(TRACE_EVENT_SCHEDULER_PUT, 0);
+	
+	ret_code_t ret = trace_dump_chrome_json("trace_lib_unittest.json");
+	EXPECT_EQ(ret, NRF_SUCCESS);
+	
+	// The ring-buffer is drained
+	trace_record_t record;
+	EXPECT_EQ(trace_read(&record, 1), 0);
+	
+	FILE* file = fopen("trace_lib_unittest.json", "r");
+	ASSERT_TRUE(file != NULL);
+	char buf[2048];
+	size_t len = fread(buf, 1, sizeof(buf) - 1, file);
+	fclose(file);
+	buf[len] = 0;
+	std::string json(buf);
+	
+	EXPECT_EQ(json.find("{\"traceEvents\":["), 0);
+	EXPECT_NE(json.find("\"name\":\"filesystem_store_element\",\"ph\":\"B\""), std::string::npos);
+	EXPECT_NE(json.find("\"name\":\"filesystem_store_element\",\"ph\":\"E\""), std::string::npos);
+	EXPECT_NE(json.find("\"args\":{\"arg\":12}"), std::string::npos);
+	EXPECT_NE(json.find("\"ph\":\"i\""), std::string::npos);
+	EXPECT_NE(json.find("\"overwritten_records\":0"), std::string::npos);
+	
+	EXPECT_EQ(trace_dump_chrome_json("/nonexistent_directory/trace.json"), NRF_ERROR_INTERNAL);
+}
+
+
+};
@@ -0,0 +1,193 @@
+// Don't forget gtest.h, which declares the testing framework.
+
+#include "gtest/gtest.h"
+#include "timer_lib.h"
+#include "app_timer.h"
+#include "app_scheduler.h"
+#include "scheduler_lib.h"
+#include "systick_lib.h"
+#include "timeout_lib.h"
+#include "storer_lib.h"
+#include "sampling_lib.h"
+#include "debug_lib.h"
+#include "chunk_messages.h"
+
+#include "callback_generator_lib.h"
+#include "storage_model_lib.h"
+
+
+#define SECONDS_TO_MICROSECONDS(s)	(((uint64_t) (s)) * 1000 * 1000)
+
+#define SCENARIO_HOURS				8
+#define BATTERY_PERIOD_MS			(60*1000)
+
+
+namespace {
+
+class VirtualTimeTest : public ::testing::Test {
+public:
+	// The virtual-time mode has to be enabled before anything initializes the timer-module
+	static void SetUpTestCase() {
+		timer_enable_virtual_time(1);
+		timer_init();
+		timer_set_start();
+	}
+};
+
+
+uint32_t fast_timer_count = 0;
+uint64_t fast_timer_last_microseconds = 0;
+void fast_timer_handler(void* p_context) {
+	fast_timer_count++;
+	fast_timer_last_microseconds = timer_get_microseconds_since_start();
+}
+
+uint32_t slow_timer_count = 0;
+uint64_t slow_timer_last_microseconds = 0;
+void slow_timer_handler(void* p_context) {
+	slow_timer_count++;
+	slow_timer_last_microseconds = timer_get_microseconds_since_start();
+}
+
+uint32_t single_shot_timer_count = 0;
+void single_shot_timer_handler(void* p_context) {
+	single_shot_timer_count++;
+}
+
+TEST_F(VirtualTimeTest, TimerJumpTest) {
+	ASSERT_TRUE(timer_is_virtual_time());
+
+	uint32_t fast_timer_id, slow_timer_id, single_shot_timer_id;
+	ASSERT_EQ(timer_create_timer(&fast_timer_id, TIMER_MODE_REPEATED, fast_timer_handler, 0), 1);
+	ASSERT_EQ(timer_create_timer(&slow_timer_id, TIMER_MODE_REPEATED, slow_timer_handler, 0), 1);
+	ASSERT_EQ(timer_create_timer(&single_shot_timer_id, TIMER_MODE_SINGLE_SHOT, single_shot_timer_handler, 0), 1);
+
+	uint64_t start_microseconds = timer_get_microseconds_since_start();
+
+	timer_start_timer(fast_timer_id, SECONDS_TO_MICROSECONDS(1), NULL);
+	timer_start_timer(slow_timer_id, SECONDS_TO_MICROSECONDS(7), NULL);
+	timer_start_timer(single_shot_timer_id, SECONDS_TO_MICROSECONDS(3600), NULL);
+
+	// Nothing happens without advancing the time
+	EXPECT_EQ(fast_timer_count, 0);
+	EXPECT_EQ(timer_get_microseconds_since_start(), start_microseconds);
+
+	// A stopped timer must not be called
+	timer_stop_timer(single_shot_timer_id);
+
+	timer_sleep_microseconds(SECONDS_TO_MICROSECONDS(10*3600));
+
+	EXPECT_EQ(timer_get_microseconds_since_start(), start_microseconds + SECONDS_TO_MICROSECONDS(10*3600));
+	EXPECT_EQ(fast_timer_count, 10*3600);
+	EXPECT_EQ(fast_timer_last_microseconds, start_microseconds + SECONDS_TO_MICROSECONDS(10*3600));
+	EXPECT_EQ(slow_timer_count, (10*3600)/7);
+	EXPECT_EQ(slow_timer_last_microseconds, start_microseconds + SECONDS_TO_MICROSECONDS(((10*3600)/7)*7));
+	EXPECT_EQ(single_shot_timer_count, 0);
+
+	timer_stop_timer(fast_timer_id);
+	timer_stop_timer(slow_timer_id);
+
+	// No timer is running anymore --> jump directly to the end
+	EXPECT_EQ(timer_virtual_advance_to_next_event(start_microseconds + SECONDS_TO_MICROSECONDS(11*3600)), 0);
+	EXPECT_EQ(timer_get_microseconds_since_start(), start_microseconds + SECONDS_TO_MICROSECONDS(11*3600));
+}
+
+
+uint8_t busy_wait_timer_called = 0;
+void busy_wait_timer_handler(void* p_context) {
+	busy_wait_timer_called = 1;
+}
+
+TEST_F(VirtualTimeTest, BusyWaitTest) {
+	APP_SCHED_INIT(4, 100);
+	APP_TIMER_INIT(0, 60, NULL);
+
+	EXPECT_EQ(systick_init(0), NRF_SUCCESS);
+
+	uint32_t timer_id;
+	ASSERT_EQ(timer_create_timer(&timer_id, TIMER_MODE_SINGLE_SHOT, busy_wait_timer_handler, 0), 1);
+	timer_start_timer(timer_id, SECONDS_TO_MICROSECONDS(1), NULL);
+
+	uint64_t start_ms = systick_get_continuous_millis();
+	systick_delay_millis(1500);
+	uint64_t end_ms = systick_get_continuous_millis();
+
+	// The busy-wait terminates, and the timer expired during the busy-wait
+	EXPECT_GE(end_ms - start_ms, 1500);
+	EXPECT_LE(end_ms - start_ms, 1500 + 2*TIMER_VIRTUAL_BUSY_WAIT_STEP_MICROSECONDS/1000);
+	EXPECT_EQ(busy_wait_timer_called, 1);
+}
+
+
+TEST_F(VirtualTimeTest, BatterySamplingScenarioTest) {
+	ret_code_t ret;
+
+	debug_init();
+
+	ret = scheduler_init();
+	EXPECT_EQ(ret, NRF_SUCCESS);
+
+	ret = timeout_init();
+	EXPECT_EQ(ret, NRF_SUCCESS);
+
+	ret = sampling_init();
+	EXPECT_EQ(ret, NRF_SUCCESS);
+
+	ret = storer_init();
+	//EXPECT_EQ(ret, NRF_SUCCESS);
+
+	ret = storer_clear();
+	EXPECT_EQ(ret, NRF_SUCCESS);
+
+	uint32_t start_seconds = 0;
+	uint16_t start_ms = 0;
+	systick_get_timestamp(&start_seconds, &start_ms);
+
+	// The storage operations take the modeled time of the badge
+	storage_model_enable_latency(1);
+	storage_model_reset_statistics();
+
+	ret = sampling_start_battery(0, BATTERY_PERIOD_MS, 0);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+
+	// Run the main-loop for SCENARIO_HOURS of virtual time
+	timer_virtual_run_for(SECONDS_TO_MICROSECONDS(SCENARIO_HOURS*3600), app_sched_execute);
+
+	sampling_stop_battery(0);
+	timer_virtual_run_for(SECONDS_TO_MICROSECONDS(1), app_sched_execute);
+
+	storage_model_statistics_t storage_statistics;
+	storage_model_get_statistics(&storage_statistics);
+	storage_model_enable_latency(0);
+	EXPECT_GT(storage_statistics.flash_page_erases + storage_statistics.eeprom_write_cycles, 0);
+
+	uint32_t end_seconds = 0;
+	uint16_t end_ms = 0;
+	systick_get_timestamp(&end_seconds, &end_ms);
+	EXPECT_GE(end_seconds - start_seconds, SCENARIO_HOURS*3600);
+
+	// Pull all the stored battery chunks (the partition wrapped around several times)
+	Timestamp timestamp;
+	timestamp.seconds = 0;
+	timestamp.ms = 0;
+	ret = storer_find_battery_chunk_from_timestamp(timestamp);
+	EXPECT_EQ(ret, NRF_SUCCESS);
+
+	BatteryChunk battery_chunk;
+	uint32_t number_of_chunks = 0;
+	uint32_t former_seconds = 0;
+	while(storer_get_next_battery_chunk(&battery_chunk) == NRF_SUCCESS) {
+		if(number_of_chunks > 0) {
+			EXPECT_EQ(battery_chunk.timestamp.seconds - former_seconds, BATTERY_PERIOD_MS/1000);
+		}
+		former_seconds = battery_chunk.timestamp.seconds;
+		number_of_chunks++;
+	}
+	EXPECT_GE(number_of_chunks, STORER_BATTERY_DATA_NUMBER);
+	EXPECT_LT(number_of_chunks, (SCENARIO_HOURS*3600*1000)/BATTERY_PERIOD_MS);
+	// The newest chunk is from the end of the scenario
+	EXPECT_GE(former_seconds + BATTERY_PERIOD_MS/1000, end_seconds - 1);
+}
+
+
+};